@@ -0,0 +1,156 @@
+// Block-compressed atlas pages on the software path: the memory a
+// 2048 x 2048 page takes per format, BC1 / BC3 / BC7 decode throughput
+// over the whole page, and the decoded-tile cache sweeping the page
+// cold (every tile decoded) against warm (every tile a hit).
+
+#include "BenchHarness.h"
+
+#include "core/renderer/BlockCompression.h"
+#include "core/renderer/DecodedTileCache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace dmme;
+using namespace dmme::bench;
+using namespace dmme::core::renderer;
+
+namespace {
+
+constexpr int kPageSize = 2048;
+
+constexpr TextureFormat kFormats[] = {TextureFormat::BC1_UNORM, TextureFormat::BC3_UNORM,
+                                      TextureFormat::BC7_UNORM};
+
+const char* FormatName(TextureFormat f) {
+    return f == TextureFormat::BC1_UNORM ? "BC1" : f == TextureFormat::BC3_UNORM ? "BC3" : "BC7";
+}
+
+// Noise blocks; BC7 blocks get one of the eight modes, evenly
+std::vector<uint8_t> BuildPage(TextureFormat format, int size) {
+    std::vector<uint8_t> blocks(GetTextureBytes(format, size, size));
+    uint32_t state = 0x9E3779B9u;
+    for (uint8_t& b : blocks) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        b = static_cast<uint8_t>(state);
+    }
+    if (format == TextureFormat::BC7_UNORM) {
+        for (size_t i = 0; i < blocks.size(); i += 16) {
+            const uint32_t mode = (i / 16) % 8;
+            blocks[i] = static_cast<uint8_t>(((blocks[i] << (mode + 1)) | (1u << mode)) & 0xFF);
+        }
+    }
+    return blocks;
+}
+
+} // anonymous namespace
+
+// ===================================================================
+// Memory
+// ===================================================================
+
+DMME_BENCH(PageMemory) {
+    const uint64_t rgba = GetTextureBytes(TextureFormat::RGBA8_UNORM, kPageSize, kPageSize);
+    std::printf("  2048x2048 page: RGBA8 %.1f MiB", rgba / 1048576.0);
+    for (TextureFormat format : kFormats) {
+        const uint64_t bytes = GetTextureBytes(format, kPageSize, kPageSize);
+        std::printf(", %s %.1f MiB", FormatName(format), bytes / 1048576.0);
+        DMME_BENCH_CHECK(bytes * (format == TextureFormat::BC1_UNORM ? 8 : 4) == rgba);
+    }
+    std::printf("\n  software path adds at most the tile cache budget (%.1f MiB by default)\n",
+                kDefaultTileCacheBudget / 1048576.0);
+}
+
+// ===================================================================
+// Decoding
+// ===================================================================
+
+DMME_BENCH(DecodePage) {
+    const int size = IsQuick() ? 256 : kPageSize;
+    const double texels = static_cast<double>(size) * size;
+    std::vector<uint8_t> out(static_cast<size_t>(size) * size * 4);
+
+    for (TextureFormat format : kFormats) {
+        const std::vector<uint8_t> blocks = BuildPage(format, size);
+        const size_t pitch = static_cast<size_t>(size / kBlockSize) * GetBlockBytes(format);
+        char label[48];
+        std::snprintf(label, sizeof(label), "%s, whole page", FormatName(format));
+        Measure(label, Runs(20), [&] {
+            DMME_BENCH_CHECK(DecodeBlocks(format, blocks.data(), pitch, size / kBlockSize,
+                                          size / kBlockSize, out.data(), static_cast<size_t>(size) * 4));
+            KeepAlive(out[0]);
+        }, texels, "texels");
+    }
+}
+
+// Every tile of a page through the cache: first sweep decodes, the
+// second only looks tiles up. Tiles must match a whole-page decode.
+DMME_BENCH(TileCacheSweep) {
+    const int size = IsQuick() ? 256 : kPageSize;
+    const int tiles = size / kDecodedTileSize;
+    constexpr TextureHandle kTexture = 1;
+    const TextureFormat format = TextureFormat::BC7_UNORM;
+    const std::vector<uint8_t> blocks = BuildPage(format, size);
+
+    std::vector<uint8_t> full(static_cast<size_t>(size) * size * 4);
+    DecodeBlocks(format, blocks.data(), static_cast<size_t>(size / kBlockSize) * 16,
+                 size / kBlockSize, size / kBlockSize, full.data(), static_cast<size_t>(size) * 4);
+
+    DecodedTileCache cache;
+    cache.SetBudget(static_cast<uint64_t>(tiles) * tiles * kDecodedTileBytes);
+
+    const auto sweep = [&] {
+        for (int ty = 0; ty < tiles; ++ty) {
+            for (int tx = 0; tx < tiles; ++tx) {
+                KeepAlive(*cache.GetTile(kTexture, format, blocks.data(), size, size, tx, ty));
+            }
+        }
+    };
+
+    const auto matchesFull = [&] {
+        int wrong = 0;
+        for (int ty = 0; ty < tiles; ++ty) {
+            for (int tx = 0; tx < tiles; ++tx) {
+                const uint8_t* tile = cache.GetTile(kTexture, format, blocks.data(), size, size, tx, ty);
+                for (int y = 0; y < kDecodedTileSize; ++y) {
+                    const size_t origin = ((static_cast<size_t>(ty) * kDecodedTileSize + y) * size +
+                                           static_cast<size_t>(tx) * kDecodedTileSize) * 4;
+                    wrong += std::memcmp(tile + static_cast<size_t>(y) * kDecodedTileSize * 4,
+                                         &full[origin], kDecodedTileSize * 4) != 0;
+                }
+            }
+        }
+        return wrong == 0;
+    };
+
+    // Measure warms up with one call, so clear before every cold sweep
+    std::vector<double> coldTimes;
+    for (uint32_t run = 0; run < Runs(10); ++run) {
+        cache.Clear();
+        const double start = NowUs();
+        sweep();
+        coldTimes.push_back(NowUs() - start);
+    }
+    std::sort(coldTimes.begin(), coldTimes.end());
+    const double coldUs = coldTimes[coldTimes.size() / 2];
+    std::printf("  %-40s median %10.2f us\n", "BC7 tiles, cold", coldUs);
+
+    DMME_BENCH_CHECK(matchesFull());
+
+    const BenchResult warm = Measure("BC7 tiles, warm", Runs(50), [&] {
+        sweep();
+    }, static_cast<double>(tiles) * tiles, "tiles");
+
+    const DecodedTileStats stats = cache.GetStats();
+    std::printf("  %u tiles resident, %.1f MiB; %.2f us per tile decode, %.3f us per hit\n",
+                stats.residentTiles, stats.residentBytes / 1048576.0,
+                coldUs / (tiles * tiles), warm.medianUs / (tiles * tiles));
+    DMME_BENCH_CHECK(stats.evictions == 0);
+    DMME_BENCH_CHECK(!BudgetsApply() || warm.medianUs * 10 < coldUs);
+}
+
+DMME_BENCH_MAIN()
\ No newline at end of file
@@ -0,0 +1,290 @@
+// Derived-data cache, cold against warm: a one-minute dance (120 bone
+// tracks keyed every third frame, 40 morph tracks) loaded through
+// MotionClip::LoadVmdCached with an empty cache (parse, bake, store),
+// with a warm one (map and copy the baked form), and straight from the
+// VMD without a cache for reference. Hit and miss counts come from the
+// cache's own stats; a damaged entry must be rejected and rebuilt, and
+// two cache versions sharing a directory must keep each other's entries.
+
+#include "BenchHarness.h"
+
+#include "core/animation/MotionClip.h"
+#include "core/assets/DerivedDataCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace dmme;
+using namespace dmme::bench;
+using namespace dmme::core;
+using namespace dmme::core::animation;
+
+namespace {
+
+constexpr uint32_t kBones        = 120;
+constexpr uint32_t kMorphs       = 40;
+constexpr uint32_t kFrames       = 1800;    // one minute at 30 fps
+constexpr uint32_t kKeyStride    = 3;
+constexpr uint32_t kCacheVersion = 1;
+
+// ===================================================================
+// Synthetic VMD
+// ===================================================================
+
+class VmdWriter {
+public:
+    VmdWriter() {
+        Fixed("Vocaloid Motion Data 0002", 30);
+        Fixed("bench", 20);
+    }
+
+    void U32(uint32_t v) { Raw(&v, 4); }
+    void F32(float v)    { Raw(&v, 4); }
+
+    void Fixed(const char* text, size_t bytes) {
+        std::vector<uint8_t> field(bytes, 0);
+        std::memcpy(field.data(), text, std::min(bytes, std::strlen(text)));
+        m_bytes.insert(m_bytes.end(), field.begin(), field.end());
+    }
+
+    // The same curve on every channel and row
+    void Curves(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2) {
+        for (int row = 0; row < 4; ++row) {
+            for (uint8_t v : {x1, y1, x2, y2}) {
+                for (int channel = 0; channel < 4; ++channel) m_bytes.push_back(v);
+            }
+        }
+    }
+
+    const std::vector<uint8_t>& Bytes() const { return m_bytes; }
+
+private:
+    void Raw(const void* p, size_t n) {
+        const auto* b = static_cast<const uint8_t*>(p);
+        m_bytes.insert(m_bytes.end(), b, b + n);
+    }
+
+    std::vector<uint8_t> m_bytes;
+};
+
+std::vector<uint8_t> BuildVmd() {
+    VmdWriter w;
+    char name[16];
+
+    w.U32(kBones * (kFrames / kKeyStride + 1));
+    for (uint32_t b = 0; b < kBones; ++b) {
+        std::snprintf(name, sizeof(name), "bone%03u", b);
+        for (uint32_t f = 0; f <= kFrames; f += kKeyStride) {
+            const float angle = 0.3f * std::sin(0.05f * static_cast<float>(f + b));
+            w.Fixed(name, 15);
+            w.U32(f);
+            w.F32(0.0f);
+            w.F32(0.01f * static_cast<float>(f % 30));
+            w.F32(0.0f);
+            w.F32(b % 3 == 0 ? std::sin(angle * 0.5f) : 0.0f);
+            w.F32(b % 3 == 1 ? std::sin(angle * 0.5f) : 0.0f);
+            w.F32(b % 3 == 2 ? std::sin(angle * 0.5f) : 0.0f);
+            w.F32(std::cos(angle * 0.5f));
+            // A handful of distinct curves, as real motions have
+            const uint8_t ease = static_cast<uint8_t>(20 + (f / kKeyStride + b) % 5 * 10);
+            w.Curves(ease, 10, 107, static_cast<uint8_t>(127 - ease / 2));
+        }
+    }
+
+    w.U32(kMorphs * (kFrames / 10 + 1));
+    for (uint32_t m = 0; m < kMorphs; ++m) {
+        std::snprintf(name, sizeof(name), "morph%02u", m);
+        for (uint32_t f = 0; f <= kFrames; f += 10) {
+            w.Fixed(name, 15);
+            w.U32(f);
+            w.F32(0.5f + 0.5f * std::sin(0.1f * static_cast<float>(f + m)));
+        }
+    }
+    return w.Bytes();
+}
+
+// The motion file and a cache directory, removed afterwards
+class TempFiles {
+public:
+    TempFiles() {
+        const std::string stamp = std::to_string(static_cast<uint64_t>(NowUs()));
+        const std::filesystem::path root = std::filesystem::temp_directory_path();
+        m_motion = (root / ("dmme_ddc_bench_" + stamp + ".vmd")).string();
+        m_cache  = (root / ("dmme_ddc_bench_" + stamp)).string();
+
+        const std::vector<uint8_t> bytes = BuildVmd();
+        std::ofstream out(m_motion, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(bytes.data()),
+                  static_cast<std::streamsize>(bytes.size()));
+        m_bytes = bytes.size();
+    }
+    ~TempFiles() {
+        std::error_code ec;
+        std::filesystem::remove(m_motion, ec);
+        std::filesystem::remove_all(m_cache, ec);
+    }
+
+    // Start from an empty cache
+    void ClearCache() const {
+        std::error_code ec;
+        std::filesystem::remove_all(m_cache, ec);
+    }
+
+    const std::string& Motion() const { return m_motion; }
+    const std::string& Cache() const  { return m_cache; }
+    size_t             Bytes() const  { return m_bytes; }
+
+private:
+    std::string m_motion;
+    std::string m_cache;
+    size_t      m_bytes = 0;
+};
+
+// Both clips bake to the same bytes
+bool SameClip(const MotionClip& a, const MotionClip& b) {
+    std::vector<uint8_t> bakedA, bakedB;
+    a.SaveBaked(bakedA);
+    b.SaveBaked(bakedB);
+    return !bakedA.empty() && bakedA == bakedB;
+}
+
+} // anonymous namespace
+
+// ===================================================================
+// Cold vs warm
+// ===================================================================
+
+DMME_BENCH(ColdVsWarm) {
+    const TempFiles files;
+    std::printf("  motion: %.1f MiB\n", files.Bytes() / (1024.0 * 1024.0));
+
+    MotionClip parsed;
+    const BenchResult direct = Measure("parse VMD, no cache", Runs(20), [&] {
+        DMME_BENCH_CHECK(parsed.LoadVmd(files.Motion()));
+    }, static_cast<double>(files.Bytes()), "B");
+
+    // Every cold run starts from an empty directory
+    assets::DerivedDataCache cold;
+    MotionClip coldClip;
+    uint32_t coldRuns = 0;
+    const BenchResult coldLoad = Measure("cold: parse, bake, store", Runs(20), [&] {
+        files.ClearCache();
+        DMME_BENCH_CHECK(cold.Open(files.Cache(), kCacheVersion));
+        DMME_BENCH_CHECK(coldClip.LoadVmdCached(files.Motion(), cold));
+        ++coldRuns;
+    }, static_cast<double>(files.Bytes()), "B");
+    const assets::DerivedDataStats coldStats = cold.GetStats();
+    DMME_BENCH_CHECK(coldStats.hits == 0);
+    DMME_BENCH_CHECK(coldStats.misses == coldRuns);
+    DMME_BENCH_CHECK(coldStats.stores == coldRuns);
+    DMME_BENCH_CHECK(SameClip(coldClip, parsed));
+
+    // The last cold run left the entry behind
+    assets::DerivedDataCache warm;
+    DMME_BENCH_CHECK(warm.Open(files.Cache(), kCacheVersion));
+    MotionClip warmClip;
+    uint32_t warmRuns = 0;
+    const BenchResult warmLoad = Measure("warm: map baked form", Runs(200), [&] {
+        DMME_BENCH_CHECK(warmClip.LoadVmdCached(files.Motion(), warm));
+        ++warmRuns;
+    }, static_cast<double>(files.Bytes()), "B");
+    const assets::DerivedDataStats warmStats = warm.GetStats();
+    DMME_BENCH_CHECK(warmStats.hits == warmRuns);
+    DMME_BENCH_CHECK(warmStats.misses == 0 && warmStats.stores == 0);
+    DMME_BENCH_CHECK(SameClip(warmClip, parsed));
+
+    warm.SetVerifyChecksums(false);
+    Measure("warm, checksums off", Runs(200), [&] {
+        DMME_BENCH_CHECK(warmClip.LoadVmdCached(files.Motion(), warm));
+    }, static_cast<double>(files.Bytes()), "B");
+
+    std::printf("  cold %.2f ms, warm %.2f ms (%.1fx), no cache %.2f ms\n",
+                coldLoad.medianUs / 1000.0, warmLoad.medianUs / 1000.0,
+                coldLoad.medianUs / warmLoad.medianUs, direct.medianUs / 1000.0);
+    std::printf("  hits / misses: cold %llu / %llu, warm %llu / %llu; baked entry %.1f KiB, "
+                "%.3f ms in Find per hit\n",
+                static_cast<unsigned long long>(coldStats.hits),
+                static_cast<unsigned long long>(coldStats.misses),
+                static_cast<unsigned long long>(warmStats.hits),
+                static_cast<unsigned long long>(warmStats.misses),
+                coldStats.bytesStored / (1024.0 * coldRuns), warmStats.findMs / warmRuns);
+    DMME_BENCH_CHECK(!BudgetsApply() || warmLoad.medianUs * 2.0 < coldLoad.medianUs);
+    DMME_BENCH_CHECK(!BudgetsApply() || warmLoad.medianUs < direct.medianUs);
+}
+
+// ===================================================================
+// Damaged entries
+// ===================================================================
+
+// A flipped payload byte fails the checksum: the entry is dropped, the
+// clip reparsed and stored again, and the next start is warm
+DMME_BENCH(DamagedEntryIsRebuilt) {
+    const TempFiles files;
+    assets::DerivedDataCache cache;
+    DMME_BENCH_CHECK(cache.Open(files.Cache(), kCacheVersion));
+
+    MotionClip parsed, clip;
+    DMME_BENCH_CHECK(parsed.LoadVmd(files.Motion()));
+    DMME_BENCH_CHECK(clip.LoadVmdCached(files.Motion(), cache));
+
+    std::string entry;
+    for (const auto& file : std::filesystem::recursive_directory_iterator(files.Cache())) {
+        if (file.path().extension() == ".ddc") {
+            entry = file.path().string();
+        }
+    }
+    DMME_BENCH_CHECK(!entry.empty());
+    {
+        std::fstream f(entry, std::ios::binary | std::ios::in | std::ios::out);
+        f.seekp(200);
+        const char flipped = static_cast<char>(0x5A);
+        f.write(&flipped, 1);
+    }
+
+    const double start = NowUs();
+    DMME_BENCH_CHECK(clip.LoadVmdCached(files.Motion(), cache));
+    const double rebuildUs = NowUs() - start;
+    DMME_BENCH_CHECK(SameClip(clip, parsed));
+    DMME_BENCH_CHECK(clip.LoadVmdCached(files.Motion(), cache));
+    std::printf("  damaged entry rejected and rebuilt in %.2f ms\n", rebuildUs / 1000.0);
+
+    const assets::DerivedDataStats stats = cache.GetStats();
+    // Store, then the damaged find (rejected, rebuilt), then a hit
+    DMME_BENCH_CHECK(stats.rejected == 1);
+    DMME_BENCH_CHECK(stats.stores == 2);
+    DMME_BENCH_CHECK(stats.hits == 1);
+}
+
+// ===================================================================
+// Shared directory
+// ===================================================================
+
+// Builds with different cache versions alternating on one directory:
+// each keeps its own entry, so both stay warm after the first start
+DMME_BENCH(VersionsShareDirectory) {
+    const TempFiles files;
+    assets::DerivedDataCache older, newer;
+    DMME_BENCH_CHECK(older.Open(files.Cache(), kCacheVersion));
+    DMME_BENCH_CHECK(newer.Open(files.Cache(), kCacheVersion + 1));
+
+    MotionClip clip;
+    for (int launch = 0; launch < 3; ++launch) {
+        DMME_BENCH_CHECK(clip.LoadVmdCached(files.Motion(), older));
+        DMME_BENCH_CHECK(clip.LoadVmdCached(files.Motion(), newer));
+    }
+
+    for (const assets::DerivedDataCache* cache : {&older, &newer}) {
+        const assets::DerivedDataStats stats = cache->GetStats();
+        DMME_BENCH_CHECK(stats.rejected == 0);
+        DMME_BENCH_CHECK(stats.stores == 1);
+        DMME_BENCH_CHECK(stats.hits == 2);
+    }
+}
+
+DMME_BENCH_MAIN()
\ No newline at end of file
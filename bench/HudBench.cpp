@@ -0,0 +1,76 @@
+// PerfHud draw cost: the full HUD drawn into a memory back buffer, the
+// way the window's overlay callback sees it after conversion. The
+// budget is 0.1 ms per frame; the HUD should take well under that.
+
+#include "BenchHarness.h"
+
+#include "core/profiling/PerfHud.h"
+
+#include <vector>
+
+using namespace dmme;
+using namespace dmme::bench;
+using namespace dmme::core::profiling;
+
+namespace {
+
+constexpr double kBudgetUs = 100.0;
+
+// A HUD with a full graph and every line populated
+void FillHud(PerfHud& hud) {
+    hud.SetEnabled(true);
+    hud.SetDriverName("Software (headless)");
+    HudFrameData data;
+    data.cpuTimeMs        = 2.4f;
+    data.gpuTimeMs        = 1.1f;
+    data.presentsPerFrame = 1.0f;
+    data.surfaceWidth     = 512;
+    data.surfaceHeight    = 512;
+    data.cpuMemoryBytes   = 48ull << 20;
+    data.gpuMemoryBytes   = 12ull << 20;
+    for (size_t i = 0; i < kFrameStageCount; ++i) {
+        data.stageMs[i] = 0.3f * static_cast<float>(i + 1);
+    }
+    for (int i = 0; i < PerfHud::kGraphFrames; ++i) {
+        data.frameTimeMs = 12.0f + static_cast<float>(i % 17);
+        hud.PushFrame(data);
+    }
+}
+
+BenchResult DrawInto(const PerfHud& hud, int width, int height, const char* label) {
+    std::vector<uint8_t> frame(static_cast<size_t>(width) * height * 4, 0x80);
+    const BenchResult result = Measure(label, Runs(5000), [&] {
+        hud.Draw(frame.data(), width, height);
+        KeepAlive(frame);
+    });
+    // The panel darkened the top-left corner
+    DMME_BENCH_CHECK(frame[(static_cast<size_t>(10) * width + 10) * 4] < 0x80);
+    return result;
+}
+
+} // anonymous namespace
+
+DMME_BENCH(HudDraw) {
+    PerfHud hud;
+    FillHud(hud);
+
+    const BenchResult mascot = DrawInto(hud, 512, 512, "hud into 512x512");
+    const BenchResult screen = DrawInto(hud, 1920, 1080, "hud into 1920x1080");
+    DMME_BENCH_CHECK(!BudgetsApply() || mascot.medianUs < kBudgetUs);
+    DMME_BENCH_CHECK(!BudgetsApply() || screen.medianUs < kBudgetUs);
+}
+
+DMME_BENCH(HudDisabled) {
+    PerfHud hud;
+    FillHud(hud);
+    hud.SetEnabled(false);
+
+    std::vector<uint8_t> frame(static_cast<size_t>(512) * 512 * 4, 0x80);
+    Measure("disabled hud", Runs(5000), [&] {
+        hud.Draw(frame.data(), 512, 512);
+        KeepAlive(frame);
+    });
+    DMME_BENCH_CHECK(frame[0] == 0x80);
+}
+
+DMME_BENCH_MAIN()
\ No newline at end of file
@@ -0,0 +1,459 @@
+// IkSolver against a scalar reference: MMD-style legs (leg IK with a
+// hinged knee, toe IK on the ankle) on one character and on a stage of
+// eight, the hips bobbing and the feet stepping so every chain has to
+// solve each frame. The reference is the textbook CCD port, one chain
+// at a time with acos / sin / cos per step and xyz-interleaved
+// transforms; it applies the same limits in the same order, so the two
+// must end up with the same pose.
+
+#include "BenchHarness.h"
+
+#include "core/animation/IkSolver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace dmme;
+using namespace dmme::bench;
+using namespace dmme::core;
+using namespace dmme::core::animation;
+
+namespace {
+
+constexpr uint32_t kFrames    = 60;         // per run
+constexpr float    kTolerance = 1e-3f;      // IkSolver's default
+constexpr float    kPi        = 3.14159265f;
+
+// Bones of one character, relative to its first
+enum CharacterBone : uint32_t {
+    kRoot, kCenter,
+    kLegL, kKneeL, kAnkleL, kToeL,
+    kLegR, kKneeR, kAnkleR, kToeR,
+    kLegIkL, kLegIkR, kToeIkL, kToeIkR,
+    kCharacterBones
+};
+
+// ===================================================================
+// Synthetic skeleton
+// ===================================================================
+
+// Characters stand two units apart along x. IK bones come after the
+// legs and leg IK before toe IK, as in most MMD models.
+class SyntheticStage {
+public:
+    explicit SyntheticStage(uint32_t characters)
+        : m_bones(characters * kCharacterBones), m_links(characters * 6) {
+        for (uint32_t c = 0; c < characters; ++c) {
+            AddCharacter(c, 4.0f * static_cast<float>(c));
+        }
+    }
+
+    assets::PmxArray<assets::PmxBone> Bones() const {
+        return {m_bones.data(), static_cast<uint32_t>(m_bones.size())};
+    }
+    assets::PmxArray<assets::PmxIkLink> Links() const {
+        return {m_links.data(), static_cast<uint32_t>(m_links.size())};
+    }
+
+private:
+    void AddCharacter(uint32_t c, float x) {
+        const uint32_t base = c * kCharacterBones;
+        Bone(base, kRoot, -1, x, 0.0f, 0.0f);
+        Bone(base, kCenter, kRoot, x, 10.0f, 0.0f);
+        for (float side : {1.0f, -1.0f}) {
+            const uint32_t leg = side > 0.0f ? kLegL : kLegR;
+            Bone(base, leg,     kCenter, x + side, 10.0f, 0.0f);
+            Bone(base, leg + 1, leg,     x + side, 5.5f, -0.2f);     // knee, bent forward
+            Bone(base, leg + 2, leg + 1, x + side, 1.0f, 0.0f);      // ankle
+            Bone(base, leg + 3, leg + 2, x + side, 0.0f, -1.5f);     // toe
+        }
+
+        const uint32_t link = c * 6;
+        for (uint32_t side = 0; side < 2; ++side) {
+            const uint32_t leg   = side == 0 ? kLegL : kLegR;
+            const uint32_t legIk = side == 0 ? kLegIkL : kLegIkR;
+            const uint32_t toeIk = side == 0 ? kToeIkL : kToeIkR;
+            const float*   ankle = m_bones[base + leg + 2].position;
+            const float*   toe   = m_bones[base + leg + 3].position;
+
+            Bone(base, legIk, kRoot, ankle[0], ankle[1], ankle[2]);
+            Chain(base + legIk, base + leg + 2, 40, 1.0f, link + side * 3, 2);
+            assets::PmxIkLink& knee = m_links[link + side * 3];
+            knee.bone        = static_cast<int32_t>(base + leg + 1);
+            knee.hasLimits   = true;
+            knee.minAngle[0] = -kPi;
+            knee.maxAngle[0] = -0.008f;
+            m_links[link + side * 3 + 1].bone = static_cast<int32_t>(base + leg);
+
+            Bone(base, toeIk, legIk, toe[0], toe[1], toe[2]);
+            Chain(base + toeIk, base + leg + 3, 3, 4.0f, link + side * 3 + 2, 1);
+            m_links[link + side * 3 + 2].bone = static_cast<int32_t>(base + leg + 2);
+        }
+    }
+
+    void Bone(uint32_t base, uint32_t bone, int32_t parent, float x, float y, float z) {
+        assets::PmxBone& b = m_bones[base + bone];
+        b.parent      = parent < 0 ? -1 : static_cast<int32_t>(base) + parent;
+        b.position[0] = x;
+        b.position[1] = y;
+        b.position[2] = z;
+    }
+
+    void Chain(uint32_t bone, uint32_t target, int32_t loops, float limit, uint32_t firstLink,
+               uint32_t linkCount) {
+        assets::PmxBone& b = m_bones[bone];
+        b.flags        = assets::kPmxBoneIK;
+        b.ikTarget     = static_cast<int32_t>(target);
+        b.ikLoopCount  = loops;
+        b.ikLimitAngle = limit;
+        b.ikLinkOffset = firstLink;
+        b.ikLinkCount  = linkCount;
+    }
+
+    std::vector<assets::PmxBone>   m_bones;
+    std::vector<assets::PmxIkLink> m_links;
+};
+
+// The sampled pose at a frame: hips bobbing, feet stepping in
+// opposite phase, characters out of step with each other
+void AnimateFrame(MotionPose& pose, uint32_t characters, uint32_t frame) {
+    pose.SetIdentity();
+    for (uint32_t c = 0; c < characters; ++c) {
+        const uint32_t base = c * kCharacterBones;
+        const float    t    = 0.15f * static_cast<float>(frame) + 0.7f * static_cast<float>(c);
+        pose.ty[base + kCenter] = -0.8f - 0.4f * std::sin(2.0f * t);
+        for (uint32_t side = 0; side < 2; ++side) {
+            const uint32_t legIk = base + (side == 0 ? kLegIkL : kLegIkR);
+            const float    phase = t + (side == 0 ? 0.0f : kPi);
+            pose.tz[legIk] = 1.2f * std::sin(phase);
+            pose.ty[legIk] = std::max(0.0f, 0.8f * std::cos(phase));
+        }
+    }
+}
+
+// ===================================================================
+// Reference solver
+// ===================================================================
+
+void MultiplyQuat(const float a[4], const float b[4], float out[4]) {
+    const float r[4] = {a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1],
+                        a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0],
+                        a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3],
+                        a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2]};
+    std::copy(r, r + 4, out);
+}
+
+void RotateVector(const float q[4], const float v[3], float out[3]) {
+    const float tx = 2.0f * (q[1] * v[2] - q[2] * v[1]);
+    const float ty = 2.0f * (q[2] * v[0] - q[0] * v[2]);
+    const float tz = 2.0f * (q[0] * v[1] - q[1] * v[0]);
+    const float r[3] = {v[0] + q[3] * tx + (q[1] * tz - q[2] * ty),
+                        v[1] + q[3] * ty + (q[2] * tx - q[0] * tz),
+                        v[2] + q[3] * tz + (q[0] * ty - q[1] * tx)};
+    std::copy(r, r + 3, out);
+}
+
+// Scalar CCD, one chain at a time. World transforms are xyz / xyzw per
+// bone; the whole skeleton is re-posed after every chain.
+class ReferenceIk {
+public:
+    void Init(assets::PmxArray<assets::PmxBone> bones, assets::PmxArray<assets::PmxIkLink> links) {
+        m_bones = bones;
+        m_links = links;
+        m_world.assign(bones.count, Transform());
+        // Bones are laid out parents first
+        for (uint32_t b = 0; b < bones.count; ++b) {
+            if (bones[b].flags & assets::kPmxBoneIK) {
+                m_chains.push_back(b);
+            }
+        }
+    }
+
+    void Solve(MotionPose& pose) {
+        ForwardKinematics(pose);
+        for (uint32_t ik : m_chains) {
+            SolveChain(m_bones[ik], ik, pose);
+            ForwardKinematics(pose);
+        }
+    }
+
+    const float* Position(uint32_t bone) const { return m_world[bone].p; }
+
+private:
+    struct Transform {
+        float p[3] = {};
+        float q[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+    };
+
+    void Pose(uint32_t b, const MotionPose& pose) {
+        const int32_t parent = m_bones[b].parent;
+        const float* origin = parent >= 0 ? m_bones[parent].position : nullptr;
+        const float local[3] = {m_bones[b].position[0] - (origin ? origin[0] : 0.0f) + pose.tx[b],
+                                m_bones[b].position[1] - (origin ? origin[1] : 0.0f) + pose.ty[b],
+                                m_bones[b].position[2] - (origin ? origin[2] : 0.0f) + pose.tz[b]};
+        const float q[4] = {pose.qx[b], pose.qy[b], pose.qz[b], pose.qw[b]};
+        Transform& w = m_world[b];
+        if (parent < 0) {
+            std::copy(local, local + 3, w.p);
+            std::copy(q, q + 4, w.q);
+            return;
+        }
+        const Transform& p = m_world[parent];
+        float offset[3];
+        RotateVector(p.q, local, offset);
+        for (int c = 0; c < 3; ++c) {
+            w.p[c] = p.p[c] + offset[c];
+        }
+        MultiplyQuat(p.q, q, w.q);
+    }
+
+    void ForwardKinematics(const MotionPose& pose) {
+        for (uint32_t b = 0; b < m_bones.count; ++b) {
+            Pose(b, pose);
+        }
+    }
+
+    float DistanceSq(uint32_t a, uint32_t b) const {
+        const float d[3] = {m_world[a].p[0] - m_world[b].p[0], m_world[a].p[1] - m_world[b].p[1],
+                            m_world[a].p[2] - m_world[b].p[2]};
+        return d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+    }
+
+    void SolveChain(const assets::PmxBone& ik, uint32_t ikBone, MotionPose& pose) {
+        const uint32_t effector = static_cast<uint32_t>(ik.ikTarget);
+        const float    limit    = ik.ikLimitAngle > 0.0f ? std::min(ik.ikLimitAngle, kPi) : kPi;
+        for (int32_t iteration = 0; iteration < std::max(ik.ikLoopCount, 1); ++iteration) {
+            if (DistanceSq(effector, ikBone) < kTolerance * kTolerance) {
+                return;
+            }
+            for (uint32_t i = 0; i < ik.ikLinkCount; ++i) {
+                const assets::PmxIkLink& link = m_links[ik.ikLinkOffset + i];
+                const uint32_t bone = static_cast<uint32_t>(link.bone);
+                Step(link, bone, effector, ikBone, limit, pose);
+
+                // Re-pose from the link down to the effector
+                uint32_t path[8];
+                uint32_t count = 0;
+                for (int32_t b = static_cast<int32_t>(effector); b != link.bone; b = m_bones[b].parent) {
+                    path[count++] = static_cast<uint32_t>(b);
+                }
+                Pose(bone, pose);
+                while (count > 0) {
+                    Pose(path[--count], pose);
+                }
+            }
+        }
+    }
+
+    void Step(const assets::PmxIkLink& link, uint32_t bone, uint32_t effector, uint32_t target,
+              float limit, MotionPose& pose) {
+        const Transform& w = m_world[bone];
+        const float inverse[4] = {-w.q[0], -w.q[1], -w.q[2], w.q[3]};
+        float e[3], t[3];
+        const float toEffector[3] = {m_world[effector].p[0] - w.p[0], m_world[effector].p[1] - w.p[1],
+                                     m_world[effector].p[2] - w.p[2]};
+        const float toTarget[3]   = {m_world[target].p[0] - w.p[0], m_world[target].p[1] - w.p[1],
+                                     m_world[target].p[2] - w.p[2]};
+        RotateVector(inverse, toEffector, e);
+        RotateVector(inverse, toTarget, t);
+
+        const bool hinge = link.hasLimits && link.minAngle[1] == 0.0f && link.maxAngle[1] == 0.0f &&
+                           link.minAngle[2] == 0.0f && link.maxAngle[2] == 0.0f;
+        if (hinge) {
+            e[0] = 0.0f;
+            t[0] = 0.0f;
+        }
+
+        const float axis[3] = {e[1] * t[2] - e[2] * t[1], e[2] * t[0] - e[0] * t[2],
+                               e[0] * t[1] - e[1] * t[0]};
+        const float axisLength = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+        const float length = std::sqrt((e[0] * e[0] + e[1] * e[1] + e[2] * e[2]) *
+                                       (t[0] * t[0] + t[1] * t[1] + t[2] * t[2]));
+        if (axisLength <= length * 1e-6f) {
+            return;
+        }
+        const float cosine = std::clamp((e[0] * t[0] + e[1] * t[1] + e[2] * t[2]) / length, -1.0f, 1.0f);
+        const float angle  = std::min(std::acos(cosine), limit);
+        const float s      = std::sin(angle * 0.5f) / axisLength;
+        const float delta[4] = {axis[0] * s, axis[1] * s, axis[2] * s, std::cos(angle * 0.5f)};
+
+        const float local[4] = {pose.qx[bone], pose.qy[bone], pose.qz[bone], pose.qw[bone]};
+        float q[4];
+        MultiplyQuat(local, delta, q);
+        const float norm = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+        for (float& c : q) {
+            c /= norm;
+        }
+        if (link.hasLimits) {
+            Clamp(link, q);
+        }
+        pose.qx[bone] = q[0];
+        pose.qy[bone] = q[1];
+        pose.qz[bone] = q[2];
+        pose.qw[bone] = q[3];
+    }
+
+    // Limits on Rx * Ry * Rz Euler angles
+    static void Clamp(const assets::PmxIkLink& link, float q[4]) {
+        const float sy = std::clamp(2.0f * (q[0] * q[2] + q[1] * q[3]), -1.0f, 1.0f);
+        float angle[3] = {0.0f, std::asin(sy), 0.0f};
+        if (std::fabs(sy) < 0.9999f) {
+            angle[0] = std::atan2(-2.0f * (q[1] * q[2] - q[0] * q[3]), 1.0f - 2.0f * (q[0] * q[0] + q[1] * q[1]));
+            angle[2] = std::atan2(-2.0f * (q[0] * q[1] - q[2] * q[3]), 1.0f - 2.0f * (q[1] * q[1] + q[2] * q[2]));
+        } else {
+            angle[0] = std::atan2(2.0f * (q[1] * q[2] + q[0] * q[3]), 1.0f - 2.0f * (q[0] * q[0] + q[2] * q[2]));
+        }
+        float rotation[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+        for (int c = 0; c < 3; ++c) {
+            const float a = std::clamp(angle[c], std::min(link.minAngle[c], link.maxAngle[c]),
+                                       std::max(link.minAngle[c], link.maxAngle[c]));
+            float axis[4] = {0.0f, 0.0f, 0.0f, std::cos(a * 0.5f)};
+            axis[c] = std::sin(a * 0.5f);
+            MultiplyQuat(rotation, axis, rotation);
+        }
+        std::copy(rotation, rotation + 4, q);
+    }
+
+    assets::PmxArray<assets::PmxBone>   m_bones;
+    assets::PmxArray<assets::PmxIkLink> m_links;
+    std::vector<uint32_t>  m_chains;
+    std::vector<Transform> m_world;
+};
+
+// Largest difference in ankle and toe positions after a solve
+float MaxDeviation(const IkSolver& ik, const ReferenceIk& reference, uint32_t characters) {
+    float worst = 0.0f;
+    for (uint32_t c = 0; c < characters; ++c) {
+        for (uint32_t bone : {kAnkleL, kToeL, kAnkleR, kToeR}) {
+            const uint32_t b = c * kCharacterBones + bone;
+            float position[3], rotation[4];
+            ik.GetWorld(b, position, rotation);
+            for (int k = 0; k < 3; ++k) {
+                worst = std::max(worst, std::fabs(position[k] - reference.Position(b)[k]));
+            }
+        }
+    }
+    return worst;
+}
+
+// Farthest any effector ends up from its IK bone. CCD with MMD's
+// per-step limits rarely gets within the tolerance near a straight
+// knee; a few hundredths of a unit (a few millimetres) is typical.
+float MaxResidual(const IkSolver& ik, uint32_t characters) {
+    float worst = 0.0f;
+    for (uint32_t c = 0; c < characters; ++c) {
+        const uint32_t ends[4][2] = {{kAnkleL, kLegIkL}, {kAnkleR, kLegIkR},
+                                     {kToeL, kToeIkL}, {kToeR, kToeIkR}};
+        for (const auto& end : ends) {
+            float effector[3], target[3], rotation[4];
+            ik.GetWorld(c * kCharacterBones + end[0], effector, rotation);
+            ik.GetWorld(c * kCharacterBones + end[1], target, rotation);
+            const float d[3] = {effector[0] - target[0], effector[1] - target[1], effector[2] - target[2]};
+            worst = std::max(worst, std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]));
+        }
+    }
+    return worst;
+}
+
+} // anonymous namespace
+
+// ===================================================================
+// Solve
+// ===================================================================
+
+DMME_BENCH(SolveAgainstReference) {
+    for (uint32_t characters : {1u, 8u}) {
+        const SyntheticStage stage(characters);
+        const uint32_t boneCount = stage.Bones().count;
+        IkSolver ik;
+        DMME_BENCH_CHECK(ik.Init(stage.Bones(), stage.Links()));
+        DMME_BENCH_CHECK(ik.GetChainCount() == characters * 4);
+        ReferenceIk reference;
+        reference.Init(stage.Bones(), stage.Links());
+
+        MotionPose pose, referencePose;
+        pose.Resize(boneCount, 0);
+        referencePose.Resize(boneCount, 0);
+
+        // Same feet over two seconds of stepping
+        float deviation = 0.0f;
+        float residual  = 0.0f;
+        uint32_t converged = 0;
+        for (uint32_t frame = 0; frame < 2 * kFrames; ++frame) {
+            AnimateFrame(pose, characters, frame);
+            AnimateFrame(referencePose, characters, frame);
+            ik.Solve(pose);
+            reference.Solve(referencePose);
+            deviation = std::max(deviation, MaxDeviation(ik, reference, characters));
+            residual  = std::max(residual, MaxResidual(ik, characters));
+            converged += ik.GetStats().converged;
+        }
+        std::printf("  %u characters: %u batches, max deviation %.2e, max residual %.3f, "
+                    "%.1f%% of chains within tolerance\n", characters, ik.GetStats().batches,
+                    deviation, residual, 100.0 * converged / (2.0 * kFrames * ik.GetChainCount()));
+        DMME_BENCH_CHECK(deviation < 1e-2f);
+        DMME_BENCH_CHECK(residual < 0.1f);
+
+        uint32_t frame = 0;
+        uint32_t iterations = 0;
+        char label[48];
+        std::snprintf(label, sizeof(label), "%u characters, IkSolver", characters);
+        const BenchResult fast = Measure(label, Runs(300), [&] {
+            for (uint32_t f = 0; f < kFrames; ++f, ++frame) {
+                AnimateFrame(pose, characters, frame);
+                ik.Solve(pose);
+                iterations += ik.GetStats().iterations;
+            }
+        }, kFrames, "frames");
+        std::snprintf(label, sizeof(label), "%u characters, reference", characters);
+        const BenchResult slow = Measure(label, Runs(300), [&] {
+            for (uint32_t f = 0; f < kFrames; ++f, ++frame) {
+                AnimateFrame(referencePose, characters, frame);
+                reference.Solve(referencePose);
+            }
+            KeepAlive(reference.Position(0)[0]);
+        }, kFrames, "frames");
+
+        std::printf("  %u characters: %.2f us/frame (reference %.2f), %.2fx; last frame %u sweeps, "
+                    "%.4f ms\n", characters, fast.medianUs / kFrames, slow.medianUs / kFrames,
+                    slow.medianUs / fast.medianUs, ik.GetStats().iterations, ik.GetStats().solveMs);
+        KeepAlive(iterations);
+        DMME_BENCH_CHECK(!BudgetsApply() || fast.medianUs < slow.medianUs);
+    }
+}
+
+// A capped loop count trades accuracy for time (the timings include
+// MaxResidual, the same for every cap)
+DMME_BENCH(IterationCap) {
+    const SyntheticStage stage(8);
+    IkSolver ik;
+    DMME_BENCH_CHECK(ik.Init(stage.Bones(), stage.Links()));
+    MotionPose pose;
+    pose.Resize(stage.Bones().count, 0);
+
+    double previous = 0.0;
+    for (uint32_t cap : {4u, 10u, 0u}) {
+        ik.SetIterationCap(cap);
+        uint32_t frame = 0;
+        uint64_t iterations = 0;
+        float    residual   = 0.0f;
+        char label[48];
+        std::snprintf(label, sizeof(label), cap ? "cap %u loops" : "model loop counts", cap);
+        const BenchResult r = Measure(label, Runs(300), [&] {
+            for (uint32_t f = 0; f < kFrames; ++f, ++frame) {
+                AnimateFrame(pose, 8, frame);
+                ik.Solve(pose);
+                iterations += ik.GetStats().iterations;
+                residual    = std::max(residual, MaxResidual(ik, 8));
+            }
+        }, kFrames, "frames");
+        std::printf("  %.1f sweeps/frame, max residual %.3f\n",
+                    static_cast<double>(iterations) / frame, residual);
+        DMME_BENCH_CHECK(!BudgetsApply() || r.medianUs > previous);
+        previous = r.medianUs;
+    }
+}
+
+DMME_BENCH_MAIN()
\ No newline at end of file
@@ -0,0 +1,259 @@
+// MorphDeformer cost on a typical MMD face: 60 vertex morphs of 300
+// offsets over a 60k-vertex model, plus group morphs (expressions).
+// The baseline is the dense approach, copying the rest pose and adding
+// every morph at its weight each frame. Cases cover two animated
+// morphs (blink and lip sync), unchanged weights, and a growing
+// active set.
+
+#include "BenchHarness.h"
+
+#include "core/animation/MorphDeformer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace dmme;
+using namespace dmme::bench;
+using namespace dmme::core;
+using namespace dmme::core::animation;
+
+namespace {
+
+constexpr uint32_t kVertices     = 60'000;
+constexpr uint32_t kVertexMorphs = 60;
+constexpr uint32_t kOffsets      = 300;
+constexpr uint32_t kGroupMorphs  = 4;
+constexpr uint32_t kFaceVertices = 8'000;   // morphs stay within the face
+constexpr uint32_t kFrames       = 60;      // per run
+
+// ===================================================================
+// Synthetic model
+// ===================================================================
+
+// Positions and morph tables as PmxModel would serve them. Vertex
+// morph m offsets a run of face vertices starting at a stride that
+// makes neighbouring morphs overlap, as eye and brow morphs do.
+class SyntheticFace {
+public:
+    SyntheticFace()
+        : m_positions(kVertices * 3), m_offsets(kVertexMorphs * kOffsets),
+          m_members(kGroupMorphs * 3), m_morphs(kVertexMorphs + kGroupMorphs) {
+        for (uint32_t v = 0; v < kVertices; ++v) {
+            const float f = static_cast<float>(v);
+            m_positions[v * 3 + 0] = std::sin(f * 0.01f);
+            m_positions[v * 3 + 1] = f * 1e-4f;
+            m_positions[v * 3 + 2] = std::cos(f * 0.01f);
+        }
+        m_vertices.count     = kVertices;
+        m_vertices.positions = m_positions.data();
+
+        for (uint32_t m = 0; m < kVertexMorphs; ++m) {
+            assets::PmxVertexMorphOffset* offsets = &m_offsets[m * kOffsets];
+            const uint32_t first = (m * 131) % (kFaceVertices - kOffsets * 2);
+            for (uint32_t i = 0; i < kOffsets; ++i) {
+                offsets[i].vertex = static_cast<int32_t>(first + i * 2);
+                offsets[i].translation[0] = 0.001f * static_cast<float>(m % 7);
+                offsets[i].translation[1] = -0.002f;
+                offsets[i].translation[2] = 0.0005f * static_cast<float>(i % 5);
+            }
+            assets::PmxMorph& morph = m_morphs[m];
+            morph.type        = assets::PmxMorphType::Vertex;
+            morph.offsetCount = kOffsets;
+            morph.vertex      = offsets;
+        }
+
+        // Expressions: three vertex morphs each
+        for (uint32_t g = 0; g < kGroupMorphs; ++g) {
+            assets::PmxGroupMorphOffset* members = &m_members[g * 3];
+            for (uint32_t i = 0; i < 3; ++i) {
+                members[i].morph  = static_cast<int32_t>(g * 10 + i * 3);
+                members[i].weight = 0.5f + 0.25f * static_cast<float>(i);
+            }
+            assets::PmxMorph& morph = m_morphs[kVertexMorphs + g];
+            morph.type        = assets::PmxMorphType::Group;
+            morph.offsetCount = 3;
+            morph.group       = members;
+        }
+    }
+
+    const assets::PmxVertexTable&      Vertices() const { return m_vertices; }
+    assets::PmxArray<assets::PmxMorph> Morphs() const {
+        return {m_morphs.data(), static_cast<uint32_t>(m_morphs.size())};
+    }
+
+private:
+    std::vector<float>                        m_positions;
+    std::vector<assets::PmxVertexMorphOffset> m_offsets;
+    std::vector<assets::PmxGroupMorphOffset>  m_members;
+    std::vector<assets::PmxMorph>             m_morphs;
+    assets::PmxVertexTable                    m_vertices;
+};
+
+// ===================================================================
+// Dense reference
+// ===================================================================
+
+// Rest pose copied, then every morph added at its effective weight,
+// zero or not, every frame
+class DenseMorphs {
+public:
+    explicit DenseMorphs(const SyntheticFace& face)
+        : m_face(face), m_weights(face.Morphs().count, 0.0f),
+          m_effective(face.Morphs().count, 0.0f), m_positions(kVertices * 3) {}
+
+    void SetWeight(uint32_t morph, float weight) { m_weights[morph] = weight; }
+
+    void Apply() {
+        const assets::PmxArray<assets::PmxMorph> morphs = m_face.Morphs();
+        std::copy(m_face.Vertices().positions, m_face.Vertices().positions + kVertices * 3,
+                  m_positions.begin());
+        m_effective = m_weights;
+        for (uint32_t m = 0; m < morphs.count; ++m) {
+            if (morphs[m].type == assets::PmxMorphType::Group) {
+                for (uint32_t i = 0; i < morphs[m].offsetCount; ++i) {
+                    m_effective[morphs[m].group[i].morph] += m_weights[m] * morphs[m].group[i].weight;
+                }
+            }
+        }
+        for (uint32_t m = 0; m < morphs.count; ++m) {
+            if (morphs[m].type != assets::PmxMorphType::Vertex) {
+                continue;
+            }
+            for (uint32_t i = 0; i < morphs[m].offsetCount; ++i) {
+                const assets::PmxVertexMorphOffset& o = morphs[m].vertex[i];
+                float* p = &m_positions[static_cast<size_t>(o.vertex) * 3];
+                p[0] += o.translation[0] * m_effective[m];
+                p[1] += o.translation[1] * m_effective[m];
+                p[2] += o.translation[2] * m_effective[m];
+            }
+        }
+    }
+
+    const float* Position(uint32_t vertex) const { return &m_positions[vertex * 3]; }
+
+private:
+    const SyntheticFace& m_face;
+    std::vector<float>   m_weights;
+    std::vector<float>   m_effective;
+    std::vector<float>   m_positions;
+};
+
+float MaxDeviation(const MorphDeformer& morphs, const DenseMorphs& dense) {
+    const float* positions = morphs.GetVertices().positions;
+    float worst = 0.0f;
+    for (uint32_t v = 0; v < kFaceVertices; ++v) {
+        for (int c = 0; c < 3; ++c) {
+            worst = std::max(worst, std::fabs(positions[v * 3 + c] - dense.Position(v)[c]));
+        }
+    }
+    return worst;
+}
+
+// Blink on morph 2, lip sync on morph 40, expression group 1 held
+template <typename Morphs>
+void AnimateFrame(Morphs& morphs, uint32_t frame) {
+    const float t = static_cast<float>(frame);
+    morphs.SetWeight(2, 0.5f + 0.5f * std::sin(t * 0.3f));
+    morphs.SetWeight(40, 0.5f + 0.5f * std::sin(t * 0.7f));
+    morphs.SetWeight(kVertexMorphs + 1, 1.0f);
+}
+
+} // anonymous namespace
+
+// ===================================================================
+// Animated morphs
+// ===================================================================
+
+DMME_BENCH(AnimatedFace) {
+    const SyntheticFace face;
+    MorphDeformer morphs;
+    DMME_BENCH_CHECK(morphs.Init(face.Vertices(), face.Morphs()));
+    DenseMorphs dense(face);
+
+    // Same positions after a second of animation
+    for (uint32_t frame = 0; frame < kFrames; ++frame) {
+        AnimateFrame(morphs, frame);
+        AnimateFrame(dense, frame);
+        morphs.Apply();
+        dense.Apply();
+    }
+    const float deviation = MaxDeviation(morphs, dense);
+    std::printf("  max deviation from dense: %.2e\n", deviation);
+    DMME_BENCH_CHECK(deviation < 1e-5f);
+    // Two animated morphs plus the group's three members
+    DMME_BENCH_CHECK(morphs.GetStats().activeMorphs == 5);
+
+    uint32_t frame = 0;
+    const BenchResult sparse = Measure("sparse, 5 active", Runs(200), [&] {
+        for (uint32_t f = 0; f < kFrames; ++f, ++frame) {
+            AnimateFrame(morphs, frame);
+            morphs.Apply();
+        }
+        KeepAlive(morphs.GetPositions()[0]);
+    }, kFrames, "frames");
+    const BenchResult full = Measure("dense, every morph", Runs(200), [&] {
+        for (uint32_t f = 0; f < kFrames; ++f, ++frame) {
+            AnimateFrame(dense, frame);
+            dense.Apply();
+        }
+        KeepAlive(dense.Position(0)[0]);
+    }, kFrames, "frames");
+
+    std::printf("  per frame: %.2f us sparse, %.2f us dense (%.1fx); last applyMs %.4f\n",
+                sparse.medianUs / kFrames, full.medianUs / kFrames,
+                full.medianUs / sparse.medianUs, morphs.GetStats().applyMs);
+    DMME_BENCH_CHECK(!BudgetsApply() || sparse.medianUs * 4.0 < full.medianUs);
+}
+
+// Held weights cost a comparison per morph and no writes
+DMME_BENCH(UnchangedWeights) {
+    const SyntheticFace face;
+    MorphDeformer morphs;
+    DMME_BENCH_CHECK(morphs.Init(face.Vertices(), face.Morphs()));
+    AnimateFrame(morphs, 0);
+    DMME_BENCH_CHECK(morphs.Apply());
+
+    const uint64_t skippedBefore = morphs.GetStats().skippedApplies;
+    bool rewrote = false;
+    const BenchResult held = Measure("held weights", Runs(200), [&] {
+        for (uint32_t f = 0; f < kFrames; ++f) {
+            rewrote |= morphs.Apply();
+        }
+    }, kFrames, "frames");
+    DMME_BENCH_CHECK(!rewrote);
+    DMME_BENCH_CHECK(morphs.GetStats().skippedApplies - skippedBefore ==
+                     static_cast<uint64_t>(kFrames) * (held.runs + 1));
+    std::printf("  per frame: %.3f us\n", held.medianUs / kFrames);
+}
+
+// ===================================================================
+// Active set
+// ===================================================================
+
+// Cost follows the number of active morphs, not the model
+DMME_BENCH(ActiveSetSize) {
+    const SyntheticFace face;
+    for (uint32_t active : {1u, 4u, 16u, kVertexMorphs}) {
+        MorphDeformer morphs;
+        DMME_BENCH_CHECK(morphs.Init(face.Vertices(), face.Morphs()));
+
+        uint32_t frame = 0;
+        char label[48];
+        std::snprintf(label, sizeof(label), "%u active", active);
+        Measure(label, Runs(200), [&] {
+            for (uint32_t f = 0; f < kFrames; ++f, ++frame) {
+                const float weight = 0.5f + 0.5f * std::sin(static_cast<float>(frame) * 0.3f);
+                for (uint32_t m = 0; m < active; ++m) {
+                    morphs.SetWeight(m, weight);
+                }
+                morphs.Apply();
+            }
+            KeepAlive(morphs.GetPositions()[0]);
+        }, static_cast<double>(kFrames) * active * kOffsets, "offsets");
+        DMME_BENCH_CHECK(morphs.GetStats().activeOffsets == active * kOffsets);
+    }
+}
+
+DMME_BENCH_MAIN()
\ No newline at end of file
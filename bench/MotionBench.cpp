@@ -0,0 +1,195 @@
+// MotionSampler cost for a 300-bone clip: sequential playback (cursor
+// hits, the steady state), playback that seeks every frame (binary
+// search per track), and two clips sampled and blended. The clip is a
+// synthetic VMD built in memory: 300 bone tracks with a key every five
+// frames for ten seconds, Bezier curves on every channel, and 40 morph
+// tracks.
+
+#include "BenchHarness.h"
+
+#include "core/animation/MotionClip.h"
+#include "core/animation/MotionSampler.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace dmme;
+using namespace dmme::bench;
+using namespace dmme::core::animation;
+
+namespace {
+
+constexpr uint32_t kBones      = 300;
+constexpr uint32_t kMorphs     = 40;
+constexpr uint32_t kFrames     = 300;      // ten seconds
+constexpr uint32_t kKeyStride  = 5;
+constexpr uint32_t kPlayFrames = 600;      // two loops per run
+
+// ===================================================================
+// Synthetic VMD
+// ===================================================================
+
+class VmdWriter {
+public:
+    VmdWriter() {
+        Fixed("Vocaloid Motion Data 0002", 30);
+        Fixed("bench", 20);
+    }
+
+    void U32(uint32_t v) { Raw(&v, 4); }
+    void F32(float v)    { Raw(&v, 4); }
+
+    void Fixed(const char* text, size_t bytes) {
+        std::vector<uint8_t> field(bytes, 0);
+        std::memcpy(field.data(), text, std::min(bytes, std::strlen(text)));
+        m_bytes.insert(m_bytes.end(), field.begin(), field.end());
+    }
+
+    // x1 y1 x2 y2 per channel, laid out as VMD stores them (the first
+    // 16 bytes; the other rows are copies)
+    void Curves(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2) {
+        for (int row = 0; row < 4; ++row) {
+            for (uint8_t v : {x1, y1, x2, y2}) {
+                for (int channel = 0; channel < 4; ++channel) m_bytes.push_back(v);
+            }
+        }
+    }
+
+    const std::vector<uint8_t>& Bytes() const { return m_bytes; }
+
+private:
+    void Raw(const void* p, size_t n) {
+        const auto* b = static_cast<const uint8_t*>(p);
+        m_bytes.insert(m_bytes.end(), b, b + n);
+    }
+
+    std::vector<uint8_t> m_bytes;
+};
+
+// phase varies the motion so two clips differ
+std::vector<uint8_t> BuildVmd(float phase) {
+    VmdWriter w;
+    char name[16];
+
+    w.U32(kBones * (kFrames / kKeyStride + 1));
+    for (uint32_t b = 0; b < kBones; ++b) {
+        std::snprintf(name, sizeof(name), "bone%03u", b);
+        for (uint32_t f = 0; f <= kFrames; f += kKeyStride) {
+            const float angle = 0.3f * std::sin(phase + 0.05f * static_cast<float>(f + b));
+            w.Fixed(name, 15);
+            w.U32(f);
+            w.F32(0.0f);
+            w.F32(0.01f * static_cast<float>(f % 30));
+            w.F32(0.0f);
+            // rotation about a per-bone axis
+            const float s = std::sin(angle * 0.5f);
+            const float ax = static_cast<float>(b % 3 == 0), ay = static_cast<float>(b % 3 == 1);
+            const float az = static_cast<float>(b % 3 == 2);
+            w.F32(ax * s);
+            w.F32(ay * s);
+            w.F32(az * s);
+            w.F32(std::cos(angle * 0.5f));
+            w.Curves(20, 10, 107, 117);
+        }
+    }
+
+    w.U32(kMorphs * (kFrames / 10 + 1));
+    for (uint32_t m = 0; m < kMorphs; ++m) {
+        std::snprintf(name, sizeof(name), "morph%02u", m);
+        for (uint32_t f = 0; f <= kFrames; f += 10) {
+            w.Fixed(name, 15);
+            w.U32(f);
+            w.F32(0.5f + 0.5f * std::sin(phase + 0.1f * static_cast<float>(f + m)));
+        }
+    }
+    return w.Bytes();
+}
+
+bool LoadClip(MotionClip& clip, float phase) {
+    const std::vector<uint8_t> vmd = BuildVmd(phase);
+    return clip.LoadVmdFromMemory(vmd.data(), vmd.size()) &&
+           clip.GetBoneTrackCount() == kBones && clip.GetMorphTrackCount() == kMorphs;
+}
+
+// Every rotation in the pose is a unit quaternion
+bool PoseIsNormalized(const MotionPose& pose) {
+    for (uint32_t i = 0; i < pose.boneCount; ++i) {
+        const float n = pose.qx[i] * pose.qx[i] + pose.qy[i] * pose.qy[i] +
+                        pose.qz[i] * pose.qz[i] + pose.qw[i] * pose.qw[i];
+        if (std::fabs(n - 1.0f) > 1e-4f) return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+// ===================================================================
+// Sampling
+// ===================================================================
+
+DMME_BENCH(Sample300Bones) {
+    MotionClip clip;
+    DMME_BENCH_CHECK(LoadClip(clip, 0.0f));
+
+    MotionSampler sampler;
+    sampler.Bind(&clip);
+    MotionPose pose;
+    pose.Resize(kBones, kMorphs);
+
+    // Sequential playback, looping: cursors advance by at most a key
+    const BenchResult sequential = Measure("sequential, 600 frames", Runs(200), [&] {
+        for (uint32_t f = 0; f < kPlayFrames; ++f) {
+            sampler.Sample(static_cast<float>(f % kFrames) + 0.5f, pose);
+        }
+        KeepAlive(pose.qw[0]);
+    }, kPlayFrames * kBones, "bones");
+    DMME_BENCH_CHECK(PoseIsNormalized(pose));
+    const double hitRate = static_cast<double>(sampler.GetCursorHits()) /
+                           static_cast<double>(sampler.GetCursorHits() + sampler.GetSeeks());
+    std::printf("  cursor hit rate %.3f, %.2f us per 300-bone frame\n", hitRate,
+                sequential.medianUs / kPlayFrames);
+    DMME_BENCH_CHECK(hitRate > 0.99);
+
+    // Scattered frames: every sample is a seek
+    sampler.Bind(&clip);
+    const BenchResult seeking = Measure("seeking, 600 frames", Runs(200), [&] {
+        for (uint32_t f = 0; f < kPlayFrames; ++f) {
+            sampler.Sample(static_cast<float>((f * 131) % kFrames) + 0.5f, pose);
+        }
+        KeepAlive(pose.qw[0]);
+    }, kPlayFrames * kBones, "bones");
+    DMME_BENCH_CHECK(sampler.GetSeeks() > sampler.GetCursorHits());
+
+    DMME_BENCH_CHECK(!BudgetsApply() || sequential.medianUs < seeking.medianUs);
+    // One frame of one character should be a small slice of 16 ms
+    DMME_BENCH_CHECK(!BudgetsApply() || sequential.medianUs / kPlayFrames < 50.0);
+}
+
+// Two clips sampled and cross-faded, as a motion transition does
+DMME_BENCH(BlendTwoClips) {
+    MotionClip walk, wave;
+    DMME_BENCH_CHECK(LoadClip(walk, 0.0f));
+    DMME_BENCH_CHECK(LoadClip(wave, 1.7f));
+
+    MotionSampler walkSampler, waveSampler;
+    walkSampler.Bind(&walk);
+    waveSampler.Bind(&wave);
+    MotionPose pose, layer;
+    pose.Resize(kBones, kMorphs);
+    layer.Resize(kBones, kMorphs);
+
+    Measure("sample + sample + blend, 600 frames", Runs(200), [&] {
+        for (uint32_t f = 0; f < kPlayFrames; ++f) {
+            const float frame = static_cast<float>(f % kFrames) + 0.5f;
+            walkSampler.Sample(frame, pose);
+            waveSampler.Sample(frame, layer);
+            BlendPose(pose, layer, static_cast<float>(f % kFrames) / kFrames);
+        }
+        KeepAlive(pose.qw[0]);
+    }, kPlayFrames * kBones, "bones");
+    DMME_BENCH_CHECK(PoseIsNormalized(pose));
+}
+
+DMME_BENCH_MAIN()
\ No newline at end of file
@@ -0,0 +1,672 @@
+// PmxModel load time and heap use against a naive stream-parsing
+// reader (std::ifstream, field by field, into std::vector and
+// std::string). The model is written to a temporary file first: a
+// 100k-vertex, 300-bone UTF-16 model with mixed BDEF1/2/4/SDEF
+// weights, IK chains and vertex morphs. The warm-up run leaves the
+// file in the page cache, so both sides measure parsing, not the disk.
+
+#include "BenchHarness.h"
+
+#include "core/assets/PmxModel.h"
+#include "core/jobs/JobSystem.h"
+#include "core/memory/AllocationTracker.h"
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace dmme;
+using namespace dmme::bench;
+using namespace dmme::core;
+using namespace dmme::core::assets;
+
+namespace {
+
+constexpr uint32_t kVertices  = 100'001;
+constexpr uint32_t kBones     = 300;
+constexpr uint32_t kTextures  = 8;
+constexpr uint32_t kMaterials = 11;       // divides kVertices
+constexpr uint32_t kMorphs    = 60;
+constexpr uint32_t kMorphSize = 300;
+constexpr uint32_t kIndices   = kVertices * 3;
+
+// ===================================================================
+// Synthetic model writer
+// ===================================================================
+
+class PmxWriter {
+public:
+    void U8(uint8_t v)   { m_bytes.push_back(v); }
+    void U16(uint16_t v) { Raw(&v, 2); }
+    void I32(int32_t v)  { Raw(&v, 4); }
+    void F32(float v)    { Raw(&v, 4); }
+    void Floats(std::initializer_list<float> values) {
+        for (float v : values) F32(v);
+    }
+    void Index(int32_t v, uint8_t size) {
+        if (size == 1)      U8(static_cast<uint8_t>(v));
+        else if (size == 2) U16(static_cast<uint16_t>(v));
+        else                I32(v);
+    }
+
+    // UTF-16LE text with a non-ASCII character, as MMD writes it
+    void Text(const std::string& ascii, bool japanese = true) {
+        std::vector<uint16_t> units(ascii.begin(), ascii.end());
+        if (japanese) {
+            units.push_back(0x9AEA);   // 髪
+        }
+        I32(static_cast<int32_t>(units.size() * 2));
+        for (uint16_t u : units) U16(u);
+    }
+
+    const std::vector<uint8_t>& Bytes() const { return m_bytes; }
+
+private:
+    void Raw(const void* p, size_t n) {
+        const auto* b = static_cast<const uint8_t*>(p);
+        m_bytes.insert(m_bytes.end(), b, b + n);
+    }
+
+    std::vector<uint8_t> m_bytes;
+};
+
+constexpr uint8_t kVertexIndexSize = 4;
+constexpr uint8_t kTextureIndexSize = 1;
+constexpr uint8_t kMaterialIndexSize = 1;
+constexpr uint8_t kBoneIndexSize = 2;
+constexpr uint8_t kMorphIndexSize = 1;
+
+bool IsIkBone(uint32_t i) {
+    return i % 50 == 49;
+}
+
+// commentPad extra comment characters shift everything after the
+// header by two bytes each
+std::vector<uint8_t> BuildModel(uint32_t commentPad, size_t& indexOffset) {
+    PmxWriter w;
+    w.U8('P'); w.U8('M'); w.U8('X'); w.U8(' ');
+    w.F32(2.0f);
+    w.U8(8);
+    for (uint8_t g : {uint8_t(0), uint8_t(0), kVertexIndexSize, kTextureIndexSize,
+                      kMaterialIndexSize, kBoneIndexSize, kMorphIndexSize, uint8_t(1)}) {
+        w.U8(g);
+    }
+    w.Text("bench mascot");
+    w.Text("bench mascot", false);
+    w.Text("synthetic model for the loader benchmark" + std::string(commentPad, '.'));
+    w.Text("", false);
+
+    // --- Vertices ---
+    w.I32(kVertices);
+    for (uint32_t v = 0; v < kVertices; ++v) {
+        const float f = static_cast<float>(v);
+        w.Floats({std::sin(f), std::cos(f), f * 1e-4f});
+        w.Floats({0.0f, 1.0f, 0.0f});
+        w.Floats({f / kVertices, 1.0f - f / kVertices});
+        const uint8_t type = static_cast<uint8_t>(v % 4);   // BDEF1, BDEF2, BDEF4, SDEF
+        const int32_t b = static_cast<int32_t>(v % kBones);
+        const int32_t c = static_cast<int32_t>((v + 1) % kBones);
+        w.U8(type);
+        switch (type) {
+            case 0:
+                w.Index(b, kBoneIndexSize);
+                break;
+            case 1:
+                w.Index(b, kBoneIndexSize);
+                w.Index(c, kBoneIndexSize);
+                w.F32(0.75f);
+                break;
+            case 2:
+                for (int k = 0; k < 4; ++k) w.Index((b + k) % kBones, kBoneIndexSize);
+                w.Floats({0.4f, 0.3f, 0.2f, 0.1f});
+                break;
+            default:
+                w.Index(b, kBoneIndexSize);
+                w.Index(c, kBoneIndexSize);
+                w.F32(0.5f);
+                w.Floats({0.0f, 1.0f, 0.0f, 0.0f, 1.1f, 0.0f, 0.0f, 0.9f, 0.0f});
+                break;
+        }
+        w.F32(1.0f);
+    }
+
+    // --- Faces ---
+    w.I32(kIndices);
+    indexOffset = w.Bytes().size();
+    for (uint32_t i = 0; i < kIndices; ++i) {
+        w.Index(static_cast<int32_t>((static_cast<uint64_t>(i) * 7) % kVertices), kVertexIndexSize);
+    }
+
+    // --- Textures ---
+    w.I32(kTextures);
+    for (uint32_t t = 0; t < kTextures; ++t) {
+        w.Text("tex/part" + std::to_string(t) + ".png");
+    }
+
+    // --- Materials ---
+    w.I32(kMaterials);
+    for (uint32_t m = 0; m < kMaterials; ++m) {
+        w.Text("material" + std::to_string(m));
+        w.Text("material" + std::to_string(m), false);
+        w.Floats({1.0f, 0.9f, 0.8f, 1.0f});
+        w.Floats({0.1f, 0.1f, 0.1f});
+        w.F32(5.0f);
+        w.Floats({0.5f, 0.5f, 0.5f});
+        w.U8(kPmxMaterialEdge);
+        w.Floats({0.0f, 0.0f, 0.0f, 1.0f});
+        w.F32(1.0f);
+        w.Index(static_cast<int32_t>(m % kTextures), kTextureIndexSize);
+        w.Index(-1, kTextureIndexSize);
+        w.U8(0);
+        w.U8(1);
+        w.U8(static_cast<uint8_t>(m % 10));
+        w.Text("", false);
+        w.I32(static_cast<int32_t>(kIndices / kMaterials));
+    }
+
+    // --- Bones (a chain; every 50th is an IK bone) ---
+    w.I32(kBones);
+    for (uint32_t i = 0; i < kBones; ++i) {
+        uint16_t flags = kPmxBoneRotatable | kPmxBoneVisible | kPmxBoneEnabled;
+        if (IsIkBone(i)) flags |= kPmxBoneIK;
+        w.Text("bone" + std::to_string(i));
+        w.Text("bone" + std::to_string(i), false);
+        w.Floats({0.0f, static_cast<float>(i) * 0.1f, 0.0f});
+        w.Index(static_cast<int32_t>(i) - 1, kBoneIndexSize);
+        w.I32(0);
+        w.U16(flags);
+        w.Floats({0.0f, 0.1f, 0.0f});
+        if (IsIkBone(i)) {
+            w.Index(static_cast<int32_t>(i) - 1, kBoneIndexSize);
+            w.I32(40);
+            w.F32(0.5f);
+            w.I32(2);
+            w.Index(static_cast<int32_t>(i) - 2, kBoneIndexSize);
+            w.U8(1);
+            w.Floats({-3.14f, 0.0f, 0.0f, -0.01f, 0.0f, 0.0f});
+            w.Index(static_cast<int32_t>(i) - 3, kBoneIndexSize);
+            w.U8(0);
+        }
+    }
+
+    // --- Vertex morphs ---
+    w.I32(kMorphs);
+    for (uint32_t m = 0; m < kMorphs; ++m) {
+        w.Text("morph" + std::to_string(m));
+        w.Text("morph" + std::to_string(m), false);
+        w.U8(static_cast<uint8_t>(1 + m % 4));
+        w.U8(static_cast<uint8_t>(PmxMorphType::Vertex));
+        w.I32(kMorphSize);
+        for (uint32_t k = 0; k < kMorphSize; ++k) {
+            w.Index(static_cast<int32_t>((m * 997 + k * 13) % kVertices), kVertexIndexSize);
+            w.Floats({0.01f, 0.0f, -0.01f});
+        }
+    }
+
+    // Display frames, rigid bodies, joints: none
+    w.I32(0);
+    w.I32(0);
+    w.I32(0);
+    return w.Bytes();
+}
+
+// Records are packed back to back, so whether the face indices can be
+// served from the mapping depends on where they land. Lay the model
+// out so they can; an odd vertex count makes their offset even.
+std::vector<uint8_t> BuildAlignedModel() {
+    size_t indexOffset = 0;
+    std::vector<uint8_t> bytes = BuildModel(0, indexOffset);
+    if (indexOffset % 4 != 0) {
+        bytes = BuildModel(1, indexOffset);
+    }
+    return bytes;
+}
+
+// ===================================================================
+// Naive reader: std::ifstream, one read per field
+// ===================================================================
+
+struct NaiveVertex {
+    float   position[3];
+    float   normal[3];
+    float   uv[2];
+    int32_t bones[4];
+    float   weights[4];
+    uint8_t type;
+    float   sdef[9];
+    float   edge;
+};
+
+struct NaiveMaterial {
+    std::string name, nameEn, memo;
+    float   diffuse[4], specular[3], specularPower, ambient[3], edgeColor[4], edgeSize;
+    uint8_t flags, sphereMode, sharedToon;
+    int32_t texture, sphereTexture, toon, faceCount;
+};
+
+struct NaiveIkLink {
+    int32_t bone;
+    uint8_t hasLimits;
+    float   minAngle[3], maxAngle[3];
+};
+
+struct NaiveBone {
+    std::string name, nameEn;
+    float    position[3], tail[3];
+    int32_t  parent, layer, tailBone = -1, ikTarget = -1, ikLoops = 0;
+    uint16_t flags;
+    float    ikLimit = 0.0f;
+    std::vector<NaiveIkLink> links;
+};
+
+struct NaiveMorph {
+    std::string name, nameEn;
+    uint8_t panel, type;
+    std::vector<int32_t> vertices;
+    std::vector<float>   translations;
+    std::vector<uint8_t> otherRecords;   // non-vertex morphs, kept raw
+};
+
+struct NaiveModel {
+    std::string name, nameEn, comment, commentEn;
+    std::vector<NaiveVertex>   vertices;
+    std::vector<uint32_t>      indices;
+    std::vector<std::string>   textures;
+    std::vector<NaiveMaterial> materials;
+    std::vector<NaiveBone>     bones;
+    std::vector<NaiveMorph>    morphs;
+
+    // Heap held by the loaded model
+    size_t HeapBytes() const {
+        size_t bytes = vertices.capacity() * sizeof(NaiveVertex) +
+                       indices.capacity() * sizeof(uint32_t) +
+                       textures.capacity() * sizeof(std::string) +
+                       materials.capacity() * sizeof(NaiveMaterial) +
+                       bones.capacity() * sizeof(NaiveBone) +
+                       morphs.capacity() * sizeof(NaiveMorph);
+        auto str = [&bytes](const std::string& s) {
+            if (s.capacity() > 15) bytes += s.capacity() + 1;   // beyond SSO
+        };
+        for (const auto& t : textures) str(t);
+        for (const auto& m : materials) { str(m.name); str(m.nameEn); str(m.memo); }
+        for (const auto& b : bones) {
+            str(b.name); str(b.nameEn);
+            bytes += b.links.capacity() * sizeof(NaiveIkLink);
+        }
+        for (const auto& m : morphs) {
+            str(m.name); str(m.nameEn);
+            bytes += m.vertices.capacity() * 4 + m.translations.capacity() * 4 +
+                     m.otherRecords.capacity();
+        }
+        return bytes;
+    }
+};
+
+class NaiveReader {
+public:
+    bool Load(const std::string& path, NaiveModel& model) {
+        m_in.open(path, std::ios::binary);
+        if (!m_in) return false;
+
+        char magic[4];
+        m_in.read(magic, 4);
+        if (std::string(magic, 4) != "PMX ") return false;
+        Read<float>();
+        const uint8_t globalCount = Read<uint8_t>();
+        std::vector<uint8_t> globals(globalCount);
+        m_in.read(reinterpret_cast<char*>(globals.data()), globalCount);
+        if (globalCount < 8) return false;
+        m_utf8        = globals[0] == 1;
+        m_additionalUvs = globals[1];
+        m_vertexIndex = globals[2];
+        m_textureIndex = globals[3];
+        m_materialIndex = globals[4];
+        m_boneIndex   = globals[5];
+        m_morphIndex  = globals[6];
+        m_rigidIndex  = globals[7];
+
+        model.name      = Text();
+        model.nameEn    = Text();
+        model.comment   = Text();
+        model.commentEn = Text();
+
+        model.vertices.resize(Read<int32_t>());
+        for (NaiveVertex& v : model.vertices) {
+            ReadFloats(v.position, 3);
+            ReadFloats(v.normal, 3);
+            ReadFloats(v.uv, 2);
+            for (uint8_t k = 0; k < m_additionalUvs; ++k) {
+                float unused[4];
+                ReadFloats(unused, 4);
+            }
+            std::fill(v.bones, v.bones + 4, 0);
+            std::fill(v.weights, v.weights + 4, 0.0f);
+            std::fill(v.sdef, v.sdef + 9, 0.0f);
+            v.type = Read<uint8_t>();
+            switch (v.type) {
+                case 0:
+                    v.bones[0] = Index(m_boneIndex);
+                    v.weights[0] = 1.0f;
+                    break;
+                case 1:
+                case 3:
+                    v.bones[0] = Index(m_boneIndex);
+                    v.bones[1] = Index(m_boneIndex);
+                    v.weights[0] = Read<float>();
+                    v.weights[1] = 1.0f - v.weights[0];
+                    if (v.type == 3) ReadFloats(v.sdef, 9);
+                    break;
+                default:
+                    for (int k = 0; k < 4; ++k) v.bones[k] = Index(m_boneIndex);
+                    ReadFloats(v.weights, 4);
+                    break;
+            }
+            v.edge = Read<float>();
+        }
+
+        model.indices.resize(Read<int32_t>());
+        for (uint32_t& i : model.indices) {
+            i = static_cast<uint32_t>(VertexIndex());
+            if (i >= model.vertices.size()) return false;
+        }
+
+        model.textures.resize(Read<int32_t>());
+        for (std::string& t : model.textures) {
+            t = Text();
+        }
+
+        model.materials.resize(Read<int32_t>());
+        for (NaiveMaterial& m : model.materials) {
+            m.name   = Text();
+            m.nameEn = Text();
+            ReadFloats(m.diffuse, 4);
+            ReadFloats(m.specular, 3);
+            m.specularPower = Read<float>();
+            ReadFloats(m.ambient, 3);
+            m.flags = Read<uint8_t>();
+            ReadFloats(m.edgeColor, 4);
+            m.edgeSize      = Read<float>();
+            m.texture       = Index(m_textureIndex);
+            m.sphereTexture = Index(m_textureIndex);
+            m.sphereMode    = Read<uint8_t>();
+            m.sharedToon    = Read<uint8_t>();
+            m.toon          = m.sharedToon ? Read<uint8_t>() : Index(m_textureIndex);
+            m.memo          = Text();
+            m.faceCount     = Read<int32_t>();
+        }
+
+        model.bones.resize(Read<int32_t>());
+        for (NaiveBone& b : model.bones) {
+            b.name   = Text();
+            b.nameEn = Text();
+            ReadFloats(b.position, 3);
+            b.parent = Index(m_boneIndex);
+            b.layer  = Read<int32_t>();
+            b.flags  = Read<uint16_t>();
+            if (b.flags & kPmxBoneTailIsBone) b.tailBone = Index(m_boneIndex);
+            else                              ReadFloats(b.tail, 3);
+            if (b.flags & (kPmxBoneInheritRotation | kPmxBoneInheritTranslation)) {
+                Index(m_boneIndex);
+                Read<float>();
+            }
+            float axes[6];
+            if (b.flags & kPmxBoneFixedAxis)      ReadFloats(axes, 3);
+            if (b.flags & kPmxBoneLocalAxes)      ReadFloats(axes, 6);
+            if (b.flags & kPmxBoneExternalParent) Read<int32_t>();
+            if (b.flags & kPmxBoneIK) {
+                b.ikTarget = Index(m_boneIndex);
+                b.ikLoops  = Read<int32_t>();
+                b.ikLimit  = Read<float>();
+                b.links.resize(Read<int32_t>());
+                for (NaiveIkLink& link : b.links) {
+                    link.bone      = Index(m_boneIndex);
+                    link.hasLimits = Read<uint8_t>();
+                    if (link.hasLimits) {
+                        ReadFloats(link.minAngle, 3);
+                        ReadFloats(link.maxAngle, 3);
+                    }
+                }
+            }
+            if (b.parent >= static_cast<int32_t>(model.bones.size())) return false;
+        }
+
+        model.morphs.resize(Read<int32_t>());
+        for (NaiveMorph& m : model.morphs) {
+            m.name   = Text();
+            m.nameEn = Text();
+            m.panel  = Read<uint8_t>();
+            m.type   = Read<uint8_t>();
+            const int32_t count = Read<int32_t>();
+            if (m.type == static_cast<uint8_t>(PmxMorphType::Vertex)) {
+                m.vertices.resize(count);
+                m.translations.resize(static_cast<size_t>(count) * 3);
+                for (int32_t k = 0; k < count; ++k) {
+                    m.vertices[k] = VertexIndex();
+                    ReadFloats(&m.translations[static_cast<size_t>(k) * 3], 3);
+                    if (m.vertices[k] < 0 ||
+                        static_cast<size_t>(m.vertices[k]) >= model.vertices.size()) {
+                        return false;
+                    }
+                }
+            } else {
+                m.otherRecords.resize(static_cast<size_t>(count) * RecordBytes(m.type));
+                m_in.read(reinterpret_cast<char*>(m.otherRecords.data()),
+                          static_cast<std::streamsize>(m.otherRecords.size()));
+            }
+        }
+        return static_cast<bool>(m_in);
+    }
+
+private:
+    template <typename T>
+    T Read() {
+        T value{};
+        m_in.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return value;
+    }
+
+    void ReadFloats(float* out, int n) {
+        for (int i = 0; i < n; ++i) out[i] = Read<float>();
+    }
+
+    int32_t Index(uint8_t size) {
+        return size == 1 ? Read<int8_t>() : size == 2 ? Read<int16_t>() : Read<int32_t>();
+    }
+
+    int32_t VertexIndex() {
+        return m_vertexIndex == 1 ? Read<uint8_t>()
+             : m_vertexIndex == 2 ? Read<uint16_t>() : Read<int32_t>();
+    }
+
+    size_t RecordBytes(uint8_t type) const {
+        switch (static_cast<PmxMorphType>(type)) {
+            case PmxMorphType::Group:
+            case PmxMorphType::Flip:     return m_morphIndex + 4u;
+            case PmxMorphType::Bone:     return m_boneIndex + 28u;
+            case PmxMorphType::Material: return m_materialIndex + 1u + 28 * 4;
+            case PmxMorphType::Impulse:  return m_rigidIndex + 1u + 24;
+            default:                     return m_vertexIndex + 16u;
+        }
+    }
+
+    std::string Text() {
+        const int32_t length = Read<int32_t>();
+        std::string raw(static_cast<size_t>(std::max(length, 0)), '\0');
+        m_in.read(raw.data(), static_cast<std::streamsize>(raw.size()));
+        if (m_utf8) return raw;
+
+        // UTF-16LE -> UTF-8, BMP only
+        std::string out;
+        for (size_t i = 0; i + 1 < raw.size(); i += 2) {
+            const uint32_t c = static_cast<uint8_t>(raw[i]) |
+                               (static_cast<uint32_t>(static_cast<uint8_t>(raw[i + 1])) << 8);
+            if (c < 0x80) {
+                out += static_cast<char>(c);
+            } else if (c < 0x800) {
+                out += static_cast<char>(0xC0 | (c >> 6));
+                out += static_cast<char>(0x80 | (c & 0x3F));
+            } else {
+                out += static_cast<char>(0xE0 | (c >> 12));
+                out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (c & 0x3F));
+            }
+        }
+        return out;
+    }
+
+    std::ifstream m_in;
+    bool    m_utf8 = false;
+    uint8_t m_additionalUvs = 0;
+    uint8_t m_vertexIndex = 4, m_textureIndex = 1, m_materialIndex = 1;
+    uint8_t m_boneIndex = 2, m_morphIndex = 1, m_rigidIndex = 1;
+};
+
+// ===================================================================
+// Temporary model file
+// ===================================================================
+
+class TempModel {
+public:
+    TempModel() {
+        m_path = (std::filesystem::temp_directory_path() /
+                  ("dmme_pmx_bench_" + std::to_string(static_cast<uint64_t>(NowUs())) + ".pmx")).string();
+        const std::vector<uint8_t> bytes = BuildAlignedModel();
+        std::ofstream out(m_path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(bytes.data()),
+                  static_cast<std::streamsize>(bytes.size()));
+        m_bytes = bytes.size();
+    }
+    ~TempModel() {
+        std::error_code ec;
+        std::filesystem::remove(m_path, ec);
+    }
+
+    const std::string& Path() const { return m_path; }
+    size_t Bytes() const { return m_bytes; }
+
+private:
+    std::string m_path;
+    size_t      m_bytes = 0;
+};
+
+// Heap allocations made by fn on this thread (0 unless the
+// allocation hooks are built in: -DDMME_ALLOC_TRACKING=ON)
+template <typename Fn>
+memory::AllocationCounters CountAllocations(Fn&& fn) {
+    const memory::AllocationCounters before = memory::AllocationTracker::GetThreadCounters();
+    fn();
+    return memory::AllocationTracker::GetThreadCounters().Since(before);
+}
+
+// Both readers produced the same model
+bool SameModel(const PmxModel& model, const NaiveModel& naive) {
+    const PmxVertexTable& v = model.GetVertices();
+    if (v.count != naive.vertices.size() || model.GetIndices().count != naive.indices.size() ||
+        model.GetBones().count != naive.bones.size() ||
+        model.GetMorphs().count != naive.morphs.size()) {
+        return false;
+    }
+    for (uint32_t i = 0; i < v.count; i += 997) {
+        const NaiveVertex& n = naive.vertices[i];
+        for (int k = 0; k < 3; ++k) {
+            if (v.positions[i * 3 + k] != n.position[k]) return false;
+        }
+        for (int k = 0; k < 4; ++k) {
+            if (v.boneIndices[i * 4 + k] != n.bones[k] ||
+                std::fabs(v.boneWeights[i * 4 + k] - n.weights[k]) > 1e-6f) {
+                return false;
+            }
+        }
+    }
+    for (uint32_t i = 0; i < naive.indices.size(); i += 101) {
+        if (model.GetIndices().Get(i) != naive.indices[i]) return false;
+    }
+    for (uint32_t i = 0; i < naive.bones.size(); ++i) {
+        if (model.GetBones()[i].name != naive.bones[i].name ||
+            model.GetBones()[i].ikLinkCount != naive.bones[i].links.size()) {
+            return false;
+        }
+    }
+    const PmxMorph& morph = model.GetMorphs()[kMorphs - 1];
+    return morph.vertex && morph.vertex[kMorphSize - 1].vertex ==
+                           naive.morphs[kMorphs - 1].vertices[kMorphSize - 1];
+}
+
+} // anonymous namespace
+
+// ===================================================================
+// Load time
+// ===================================================================
+
+DMME_BENCH(LoadTime) {
+    const TempModel file;
+    jobs::JobSystem jobs;
+    const uint32_t runs = Runs(20);
+    std::printf("  model: %.1f MiB, %u vertices, %u bones\n",
+                static_cast<double>(file.Bytes()) / (1 << 20), kVertices, kBones);
+
+    const BenchResult mapped = Measure("mapped, job system", runs, [&] {
+        PmxModel model;
+        DMME_BENCH_CHECK(model.Load(file.Path(), &jobs));
+        KeepAlive(model.GetVertices().positions);
+    }, static_cast<double>(file.Bytes()), "B");
+
+    const BenchResult serial = Measure("mapped, one thread", runs, [&] {
+        PmxModel model;
+        DMME_BENCH_CHECK(model.Load(file.Path()));
+        KeepAlive(model.GetVertices().positions);
+    }, static_cast<double>(file.Bytes()), "B");
+
+    const BenchResult naive = Measure("naive ifstream reader", runs, [&] {
+        NaiveModel model;
+        NaiveReader reader;
+        DMME_BENCH_CHECK(reader.Load(file.Path(), model));
+        KeepAlive(model.vertices.data());
+    }, static_cast<double>(file.Bytes()), "B");
+
+    std::printf("  speedup %.1fx (one thread %.1fx)\n",
+                naive.medianUs / mapped.medianUs, naive.medianUs / serial.medianUs);
+    DMME_BENCH_CHECK(!BudgetsApply() || serial.medianUs < naive.medianUs);
+    DMME_BENCH_CHECK(!BudgetsApply() || mapped.medianUs < naive.medianUs);
+}
+
+// ===================================================================
+// Memory
+// ===================================================================
+
+DMME_BENCH(HeapUse) {
+    const TempModel file;
+
+    PmxModel model;
+    const memory::AllocationCounters mappedAllocs = CountAllocations([&] {
+        DMME_BENCH_CHECK(model.Load(file.Path()));
+    });
+
+    NaiveModel naive;
+    const memory::AllocationCounters naiveAllocs = CountAllocations([&] {
+        NaiveReader reader;
+        DMME_BENCH_CHECK(reader.Load(file.Path(), naive));
+    });
+    DMME_BENCH_CHECK(SameModel(model, naive));
+
+    const PmxLoadStats& stats = model.GetLoadStats();
+    std::printf("  mapped: %.2f MiB heap (arena), %.2f MiB served from the mapping\n",
+                static_cast<double>(stats.arenaBytes) / (1 << 20),
+                static_cast<double>(stats.mappedViewBytes) / (1 << 20));
+    std::printf("  naive:  %.2f MiB heap\n", static_cast<double>(naive.HeapBytes()) / (1 << 20));
+    if (memory::AllocationTracker::IsEnabled()) {
+        std::printf("  allocations: mapped %llu (%.2f MiB), naive %llu (%.2f MiB)\n",
+                    static_cast<unsigned long long>(mappedAllocs.allocations),
+                    static_cast<double>(mappedAllocs.bytes) / (1 << 20),
+                    static_cast<unsigned long long>(naiveAllocs.allocations),
+                    static_cast<double>(naiveAllocs.bytes) / (1 << 20));
+        DMME_BENCH_CHECK(mappedAllocs.allocations < naiveAllocs.allocations);
+    }
+    DMME_BENCH_CHECK(stats.mappedViewBytes >= kIndices * sizeof(uint32_t));
+    DMME_BENCH_CHECK(stats.arenaBytes < naive.HeapBytes());
+}
+
+DMME_BENCH_MAIN()
\ No newline at end of file
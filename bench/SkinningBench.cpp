@@ -0,0 +1,194 @@
+// Skinner throughput and its scaling across cores: a 200k-vertex
+// table (a typical mascot is 20k - 100k) skinned inline and on job
+// systems of growing size, plus the cost per influence class. The
+// scaling check only applies where the machine has the cores for it.
+
+#include "BenchHarness.h"
+
+#include "core/animation/Skinning.h"
+#include "core/jobs/JobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace dmme;
+using namespace dmme::bench;
+using namespace dmme::core;
+using namespace dmme::core::animation;
+
+namespace {
+
+using PmxWeight = assets::PmxWeightType;
+
+constexpr uint32_t kVertices = 200'000;
+constexpr uint32_t kBones    = 300;
+
+// Attribute arrays behind a PmxVertexTable, as PmxModel would serve
+// them. weightMix picks the weight type of vertex v.
+class SyntheticMesh {
+public:
+    template <typename WeightMix>
+    SyntheticMesh(uint32_t count, WeightMix weightMix)
+        : m_positions(count * 3), m_normals(count * 3), m_uvs(count * 2),
+          m_bones(count * 4, 0), m_weights(count * 4, 0.0f), m_types(count),
+          m_edges(count, 1.0f) {
+        for (uint32_t v = 0; v < count; ++v) {
+            const float f = static_cast<float>(v);
+            m_positions[v * 3 + 0] = std::sin(f * 0.01f);
+            m_positions[v * 3 + 1] = f * 1e-5f;
+            m_positions[v * 3 + 2] = std::cos(f * 0.01f);
+            m_normals[v * 3 + 0]   = std::sin(f * 0.01f);
+            m_normals[v * 3 + 2]   = std::cos(f * 0.01f);
+
+            // Neighbouring vertices share bones, as in a real mesh
+            const int32_t bone = static_cast<int32_t>((v / 64) % kBones);
+            const PmxWeight type = weightMix(v);
+            m_types[v] = static_cast<uint8_t>(type);
+            int32_t* b = &m_bones[v * 4];
+            float*   w = &m_weights[v * 4];
+            switch (type) {
+                case PmxWeight::BDEF1:
+                    b[0] = bone;
+                    w[0] = 1.0f;
+                    break;
+                case PmxWeight::BDEF2:
+                    b[0] = bone;
+                    b[1] = (bone + 1) % kBones;
+                    w[0] = 0.7f;
+                    w[1] = 0.3f;
+                    break;
+                default:
+                    for (int k = 0; k < 4; ++k) b[k] = (bone + k) % kBones;
+                    w[0] = 0.4f; w[1] = 0.3f; w[2] = 0.2f; w[3] = 0.1f;
+                    break;
+            }
+        }
+
+        m_table.count       = count;
+        m_table.positions   = m_positions.data();
+        m_table.normals     = m_normals.data();
+        m_table.uvs         = m_uvs.data();
+        m_table.boneIndices = m_bones.data();
+        m_table.boneWeights = m_weights.data();
+        m_table.weightTypes = m_types.data();
+        m_table.edgeScales  = m_edges.data();
+    }
+
+    const assets::PmxVertexTable& Table() const { return m_table; }
+
+private:
+    std::vector<float>   m_positions, m_normals, m_uvs;
+    std::vector<int32_t> m_bones;
+    std::vector<float>   m_weights;
+    std::vector<uint8_t> m_types;
+    std::vector<float>   m_edges;
+    assets::PmxVertexTable m_table;
+};
+
+// Typical body mix: mostly BDEF2, rigid parts BDEF1, joints BDEF4
+PmxWeight TypicalMix(uint32_t v) {
+    const uint32_t region = (v / 2048) % 8;
+    return region < 2 ? PmxWeight::BDEF1 : region < 7 ? PmxWeight::BDEF2 : PmxWeight::BDEF4;
+}
+
+// A posed skeleton: every bone turned a little about a different axis
+void PosePalette(SkinningPalette& palette) {
+    palette.Resize(kBones);
+    for (uint32_t b = 0; b < kBones; ++b) {
+        const float half = 0.002f * static_cast<float>(b);
+        const float s = std::sin(half);
+        const float rotation[4] = {b % 3 == 0 ? s : 0.0f, b % 3 == 1 ? s : 0.0f,
+                                   b % 3 == 2 ? s : 0.0f, std::cos(half)};
+        const float rest[3]     = {0.0f, 0.01f * static_cast<float>(b), 0.0f};
+        const float position[3] = {0.001f * static_cast<float>(b), rest[1], 0.0f};
+        palette.SetBone(b, rotation, position, rest);
+    }
+}
+
+bool SameOutput(const std::vector<SkinnedVertex>& a, const std::vector<SkinnedVertex>& b) {
+    return a.size() == b.size() &&
+           std::memcmp(a.data(), b.data(), a.size() * sizeof(SkinnedVertex)) == 0;
+}
+
+} // anonymous namespace
+
+// ===================================================================
+// Core scaling
+// ===================================================================
+
+DMME_BENCH(CoreScaling) {
+    const SyntheticMesh mesh(kVertices, TypicalMix);
+    Skinner skinner;
+    DMME_BENCH_CHECK(skinner.Init(mesh.Table(), kBones));
+    SkinningPalette palette;
+    PosePalette(palette);
+
+    std::vector<SkinnedVertex> reference(kVertices);
+    const BenchResult inline1 = Measure("inline (1 thread)", Runs(100), [&] {
+        skinner.Skin(palette, reference.data());
+        KeepAlive(reference[0].position[0]);
+    }, kVertices, "verts");
+
+    const uint32_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("  hardware threads: %u\n", hardware);
+
+    // 2, 4, 8 ... and the whole machine
+    std::vector<uint32_t> threadCounts;
+    for (uint32_t threads = 2; threads < std::max(hardware, 8u); threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(std::max(hardware, 8u));
+
+    std::vector<SkinnedVertex> out(kVertices);
+    for (uint32_t threads : threadCounts) {
+        jobs::JobSystem jobs(static_cast<int>(threads) - 1);   // the caller is a thread too
+        char label[48];
+        std::snprintf(label, sizeof(label), "job system, %u threads", threads);
+        const BenchResult r = Measure(label, Runs(100), [&] {
+            skinner.Skin(palette, out.data(), &jobs);
+            KeepAlive(out[0].position[0]);
+        }, kVertices, "verts");
+        DMME_BENCH_CHECK(SameOutput(out, reference));
+
+        const double speedup = inline1.medianUs / r.medianUs;
+        std::printf("  %u threads: %.2fx\n", threads, speedup);
+        // Chunks are independent: expect at least half of linear
+        // scaling where the cores exist
+        if (threads <= hardware) {
+            DMME_BENCH_CHECK(!BudgetsApply() || speedup > 0.5 * threads);
+        }
+    }
+}
+
+// ===================================================================
+// Influence classes
+// ===================================================================
+
+// Blocks blend only the influences they use
+DMME_BENCH(InfluenceClasses) {
+    SkinningPalette palette;
+    PosePalette(palette);
+    std::vector<SkinnedVertex> out(kVertices);
+
+    double previous = 0.0;
+    for (PmxWeight type : {PmxWeight::BDEF1, PmxWeight::BDEF2, PmxWeight::BDEF4}) {
+        const SyntheticMesh mesh(kVertices, [type](uint32_t) { return type; });
+        Skinner skinner;
+        DMME_BENCH_CHECK(skinner.Init(mesh.Table(), kBones));
+
+        const char* label = type == PmxWeight::BDEF1 ? "BDEF1 only"
+                          : type == PmxWeight::BDEF2 ? "BDEF2 only" : "BDEF4 only";
+        const BenchResult r = Measure(label, Runs(100), [&] {
+            skinner.Skin(palette, out.data());
+            KeepAlive(out[0].position[0]);
+        }, kVertices, "verts");
+        DMME_BENCH_CHECK(!BudgetsApply() || r.medianUs > previous);
+        previous = r.medianUs;
+    }
+}
+
+DMME_BENCH_MAIN()
\ No newline at end of file
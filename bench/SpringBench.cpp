@@ -0,0 +1,306 @@
+// SpringBoneSolver cost per chain: 16-joint hair strands against a
+// head sphere and a body capsule, one 60 Hz substep per frame, for
+// growing chain counts. The baseline is the same solver written the
+// obvious way (one chain at a time, xyz interleaved); both must agree.
+// Budget mode is timed before and after it has stepped iterations down.
+
+#include "BenchHarness.h"
+
+#include "core/animation/SpringBones.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace dmme;
+using namespace dmme::bench;
+using namespace dmme::core::animation;
+
+namespace {
+
+constexpr uint32_t kJoints     = 16;
+constexpr float    kSpacing    = 0.03f;
+constexpr float    kSubstep    = SpringBoneSolver::kDefaultSubstep;
+constexpr uint32_t kIterations = 4;         // the solver's default
+
+// ===================================================================
+// Scene
+// ===================================================================
+
+// Roots spread around the head, strands hanging straight down
+void RestPose(uint32_t chain, uint32_t chains, float* out) {
+    const float angle = 6.2831853f * static_cast<float>(chain) / static_cast<float>(chains);
+    for (uint32_t j = 0; j < kJoints; ++j) {
+        out[j * 3 + 0] = 0.12f * std::cos(angle);
+        out[j * 3 + 1] = 1.6f - kSpacing * static_cast<float>(j);
+        out[j * 3 + 2] = 0.12f * std::sin(angle);
+    }
+}
+
+// The animated pose at a frame: the head sways side to side
+void AnimatedPose(uint32_t chain, uint32_t chains, uint32_t frame, float* out) {
+    RestPose(chain, chains, out);
+    const float sway = 0.05f * std::sin(0.1f * static_cast<float>(frame));
+    for (uint32_t j = 0; j < kJoints; ++j) {
+        out[j * 3 + 0] += sway;
+    }
+}
+
+struct Capsule {
+    float a[3];
+    float b[3];
+    float radius;
+};
+
+constexpr Capsule kHead = {{0.0f, 1.5f, 0.0f}, {0.0f, 1.5f, 0.0f}, 0.1f};
+constexpr Capsule kBody = {{0.0f, 1.0f, 0.0f}, {0.0f, 1.35f, 0.0f}, 0.14f};
+
+SpringChainDesc ChainDesc(const float* rest) {
+    SpringChainDesc desc;
+    desc.jointCount    = kJoints;
+    desc.restPositions = rest;
+    desc.stiffness     = 0.1f;
+    desc.damping       = 0.05f;
+    desc.radius        = 0.02f;
+    return desc;
+}
+
+class SolverScene {
+public:
+    explicit SolverScene(uint32_t chains)
+        : m_chains(chains), m_pose(kJoints * 3) {
+        for (uint32_t c = 0; c < chains; ++c) {
+            RestPose(c, chains, m_pose.data());
+            m_solver.AddChain(ChainDesc(m_pose.data()));
+        }
+        const uint32_t head = m_solver.AddSphere(kHead.radius);
+        const uint32_t body = m_solver.AddCapsule(kBody.radius);
+        m_solver.SetSphere(head, kHead.a);
+        m_solver.SetCapsule(body, kBody.a, kBody.b);
+    }
+
+    void Frame() {
+        for (uint32_t c = 0; c < m_chains; ++c) {
+            AnimatedPose(c, m_chains, m_frame, m_pose.data());
+            m_solver.SetTargets(c, m_pose.data());
+        }
+        m_solver.Update(kSubstep);
+        ++m_frame;
+    }
+
+    SpringBoneSolver& Solver() { return m_solver; }
+
+private:
+    SpringBoneSolver   m_solver;
+    uint32_t           m_chains;
+    uint32_t           m_frame = 0;
+    std::vector<float> m_pose;
+};
+
+// ===================================================================
+// Reference solver
+// ===================================================================
+
+// One chain at a time with xyz interleaved per joint, the layout a
+// first port would use. Same integration, constraint and collision
+// order as SpringBoneSolver.
+class ReferenceSprings {
+public:
+    explicit ReferenceSprings(uint32_t chains)
+        : m_chains(chains) {
+        const size_t floats = static_cast<size_t>(chains) * kJoints * 3;
+        m_x.resize(floats);
+        m_rest.resize(static_cast<size_t>(chains) * kJoints, 0.0f);
+        for (uint32_t c = 0; c < chains; ++c) {
+            RestPose(c, chains, &m_x[static_cast<size_t>(c) * kJoints * 3]);
+        }
+        for (uint32_t c = 0; c < chains; ++c) {
+            const float* p = &m_x[static_cast<size_t>(c) * kJoints * 3];
+            for (uint32_t j = 1; j < kJoints; ++j) {
+                const float dx = p[j * 3 + 0] - p[j * 3 - 3];
+                const float dy = p[j * 3 + 1] - p[j * 3 - 2];
+                const float dz = p[j * 3 + 2] - p[j * 3 - 1];
+                m_rest[static_cast<size_t>(c) * kJoints + j] = std::sqrt(dx * dx + dy * dy + dz * dz);
+            }
+        }
+        m_prev = m_target = m_lastTarget = m_x;
+    }
+
+    void Frame() {
+        for (uint32_t c = 0; c < m_chains; ++c) {
+            AnimatedPose(c, m_chains, m_frame, &m_target[static_cast<size_t>(c) * kJoints * 3]);
+        }
+        for (uint32_t c = 0; c < m_chains; ++c) {
+            StepChain(c);
+        }
+        m_lastTarget = m_target;
+        ++m_frame;
+    }
+
+    // Where SpringBoneSolver::GetJoint reports a joint with no time
+    // left over: the start of the last substep
+    const float* Joint(uint32_t chain, uint32_t joint) const {
+        return &m_prev[(static_cast<size_t>(chain) * kJoints + joint) * 3];
+    }
+
+private:
+    void StepChain(uint32_t chain) {
+        const size_t base = static_cast<size_t>(chain) * kJoints * 3;
+        float* x = &m_x[base];
+        float* p = &m_prev[base];
+        const float* t0 = &m_lastTarget[base];
+        const float* t1 = &m_target[base];
+        const float* rest = &m_rest[static_cast<size_t>(chain) * kJoints];
+        const float gravity[3] = {0.0f, -9.8f * kSubstep * kSubstep, 0.0f};
+        const float keep = 0.95f;
+        const float stiffness = 0.1f;
+
+        for (int c = 0; c < 3; ++c) {
+            p[c] = t0[c];
+            x[c] = t1[c];
+        }
+        for (uint32_t j = 1; j < kJoints; ++j) {
+            for (int c = 0; c < 3; ++c) {
+                const float cur = x[j * 3 + c];
+                const float next = cur + (cur - p[j * 3 + c]) * keep
+                                 + (t1[j * 3 + c] - cur) * stiffness + gravity[c];
+                p[j * 3 + c] = cur;
+                x[j * 3 + c] = next;
+            }
+        }
+        for (uint32_t iteration = 0; iteration < kIterations; ++iteration) {
+            for (uint32_t j = 1; j < kJoints; ++j) {
+                float* joint = x + j * 3;
+                const float dx = joint[0] - joint[-3];
+                const float dy = joint[1] - joint[-2];
+                const float dz = joint[2] - joint[-1];
+                const float lengthSq = dx * dx + dy * dy + dz * dz;
+                if (lengthSq > 1e-12f) {
+                    const float scale = rest[j] / std::sqrt(lengthSq);
+                    joint[0] = joint[-3] + dx * scale;
+                    joint[1] = joint[-2] + dy * scale;
+                    joint[2] = joint[-1] + dz * scale;
+                }
+                Collide(kHead, joint);
+                Collide(kBody, joint);
+            }
+        }
+    }
+
+    static void Collide(const Capsule& capsule, float* joint) {
+        const float ab[3] = {capsule.b[0] - capsule.a[0], capsule.b[1] - capsule.a[1],
+                             capsule.b[2] - capsule.a[2]};
+        const float abSq = ab[0] * ab[0] + ab[1] * ab[1] + ab[2] * ab[2];
+        const float r[3] = {joint[0] - capsule.a[0], joint[1] - capsule.a[1],
+                            joint[2] - capsule.a[2]};
+        const float t = abSq > 1e-12f
+            ? std::clamp((r[0] * ab[0] + r[1] * ab[1] + r[2] * ab[2]) / abSq, 0.0f, 1.0f)
+            : 0.0f;
+        const float d[3] = {r[0] - t * ab[0], r[1] - t * ab[1], r[2] - t * ab[2]};
+        const float distSq  = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+        const float minDist = capsule.radius + 0.02f;
+        if (distSq < minDist * minDist && distSq > 1e-12f) {
+            const float scale = minDist / std::sqrt(distSq) - 1.0f;
+            for (int c = 0; c < 3; ++c) {
+                joint[c] += d[c] * scale;
+            }
+        }
+    }
+
+    uint32_t           m_chains;
+    uint32_t           m_frame = 0;
+    std::vector<float> m_x, m_prev, m_target, m_lastTarget;
+    std::vector<float> m_rest;
+};
+
+} // anonymous namespace
+
+// ===================================================================
+// Cost per chain
+// ===================================================================
+
+DMME_BENCH(CostPerChain) {
+    // Both solvers agree over four seconds of swaying
+    {
+        constexpr uint32_t kChains = 24;
+        SolverScene      scene(kChains);
+        ReferenceSprings reference(kChains);
+        float maxError = 0.0f;
+        for (uint32_t frame = 0; frame < 240; ++frame) {
+            scene.Frame();
+            reference.Frame();
+        }
+        for (uint32_t c = 0; c < kChains; ++c) {
+            for (uint32_t j = 0; j < kJoints; ++j) {
+                float joint[3];
+                scene.Solver().GetJoint(c, j, joint);
+                const float* expected = reference.Joint(c, j);
+                for (int k = 0; k < 3; ++k) {
+                    maxError = std::max(maxError, std::fabs(joint[k] - expected[k]));
+                }
+            }
+        }
+        std::printf("  max deviation from reference: %.2e m\n", maxError);
+        DMME_BENCH_CHECK(maxError < 1e-4f);
+    }
+
+    for (uint32_t chains : {4u, 16u, 64u, 256u}) {
+        SolverScene      scene(chains);
+        ReferenceSprings reference(chains);
+        DMME_BENCH_CHECK(scene.Solver().GetStats().joints == chains * kJoints);
+
+        char label[48];
+        std::snprintf(label, sizeof(label), "%u chains, solver", chains);
+        const BenchResult fast = Measure(label, Runs(2000), [&] {
+            scene.Frame();
+        }, chains, "chains");
+        std::snprintf(label, sizeof(label), "%u chains, reference", chains);
+        const BenchResult slow = Measure(label, Runs(2000), [&] {
+            reference.Frame();
+            KeepAlive(*reference.Joint(0, kJoints - 1));
+        }, chains, "chains");
+
+        DMME_BENCH_CHECK(scene.Solver().GetStats().substeps == 1);
+        std::printf("  %u chains: %.3f us/chain (reference %.3f), %.2fx\n", chains,
+                    fast.medianUs / chains, slow.medianUs / chains, slow.medianUs / fast.medianUs);
+        // Four chains per SIMD group; too few to measure reliably below 64
+        if (chains >= 64) {
+            DMME_BENCH_CHECK(!BudgetsApply() || fast.medianUs < slow.medianUs);
+        }
+    }
+}
+
+// ===================================================================
+// Budget mode
+// ===================================================================
+
+// An unreachable budget steps iterations down to the minimum, and the
+// frame gets cheaper for it
+DMME_BENCH(BudgetMode) {
+    constexpr uint32_t kChains = 256;
+    SolverScene scene(kChains);
+
+    const BenchResult full = Measure("full iterations", Runs(1000), [&] {
+        scene.Frame();
+    }, kChains, "chains");
+    DMME_BENCH_CHECK(scene.Solver().GetStats().iterations == kIterations);
+
+    SpringBudget budget;
+    budget.budgetMs      = 1e-6f;
+    budget.maxIterations = kIterations;
+    budget.minIterations = 1;
+    scene.Solver().SetBudget(budget);
+    for (uint32_t frame = 0; frame < 64; ++frame) {
+        scene.Frame();
+    }
+    DMME_BENCH_CHECK(scene.Solver().GetStats().iterations == 1);
+
+    const BenchResult reduced = Measure("budget mode, 1 iteration", Runs(1000), [&] {
+        scene.Frame();
+    }, kChains, "chains");
+    std::printf("  budget mode: %.2fx cheaper\n", full.medianUs / reduced.medianUs);
+    DMME_BENCH_CHECK(!BudgetsApply() || reduced.medianUs < full.medianUs);
+}
+
+DMME_BENCH_MAIN()
\ No newline at end of file
@@ -0,0 +1,205 @@
+#pragma once
+
+#include "utils/Logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace dmme {
+namespace bench {
+
+// Minimal harness for the headless benchmarks; no framework dependency.
+//
+// Cases register themselves with DMME_BENCH and run in registration
+// order. Measure() runs a callable once to warm up, then times each
+// run and prints the median, the minimum and, given a work size, the
+// throughput. DMME_BENCH_CHECK records a failure (wrong result, or a
+// budget missed) and the exit code is 0 only if every check passed.
+//
+// `<exe> --quick` cuts every case down to a few runs; CTest runs the
+// benchmarks that way (label "bench") so they keep building and
+// working. Numbers, and so timing budgets (BudgetsApply), are only
+// meaningful in full runs of an optimised build:
+//   cmake -B build -DCMAKE_BUILD_TYPE=Release && build/bench/dmme_hud_bench
+// `<exe> [--quick] <case>` runs one case, `<exe> --list` prints them.
+//
+// Usage:
+//   DMME_BENCH(HudDraw) {
+//       const BenchResult r = Measure("hud 1080p", Runs(2000), [&] {
+//           hud.Draw(pixels, width, height);
+//       });
+//       DMME_BENCH_CHECK(!BudgetsApply() || r.medianUs < 100.0);
+//   }
+//   DMME_BENCH_MAIN()
+
+using BenchFn = void (*)();
+
+struct BenchCase {
+    const char* name;
+    BenchFn     fn;
+};
+
+struct BenchResult {
+    double   medianUs = 0.0;
+    double   minUs    = 0.0;
+    double   meanUs   = 0.0;
+    uint32_t runs     = 0;
+};
+
+inline std::vector<BenchCase>& Registry() {
+    static std::vector<BenchCase> cases;
+    return cases;
+}
+
+inline int& FailureCount() {
+    static int failures = 0;
+    return failures;
+}
+
+inline bool& QuickMode() {
+    static bool quick = false;
+    return quick;
+}
+
+inline bool IsQuick() {
+    return QuickMode();
+}
+
+// Timing budgets are checked in full runs of NDEBUG builds only
+inline bool BudgetsApply() {
+#if defined(NDEBUG)
+    return !IsQuick();
+#else
+    return false;
+#endif
+}
+
+// The full run count, or a handful in quick mode
+inline uint32_t Runs(uint32_t full) {
+    return IsQuick() ? std::min(full, 3u) : full;
+}
+
+inline double NowUs() {
+    return std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Keeps a result alive so the optimiser cannot drop the work behind it
+template <typename T>
+inline void KeepAlive(const T& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+// Time `runs` calls of fn. itemsPerRun > 0 adds a throughput column
+// (millions of `unit` per second).
+template <typename Fn>
+BenchResult Measure(const char* label, uint32_t runs, Fn&& fn,
+                    double itemsPerRun = 0.0, const char* unit = "items") {
+    runs = std::max(runs, 1u);
+    fn();
+
+    std::vector<double> times(runs);
+    for (uint32_t i = 0; i < runs; ++i) {
+        const double start = NowUs();
+        fn();
+        times[i] = NowUs() - start;
+    }
+
+    BenchResult result;
+    result.runs = runs;
+    for (double t : times) {
+        result.meanUs += t;
+    }
+    result.meanUs /= runs;
+    std::sort(times.begin(), times.end());
+    result.minUs    = times.front();
+    result.medianUs = times[runs / 2];
+
+    std::printf("  %-40s median %10.2f us  min %10.2f us", label, result.medianUs,
+                result.minUs);
+    if (itemsPerRun > 0.0 && result.medianUs > 0.0) {
+        std::printf("  %9.2f M%s/s", itemsPerRun / result.medianUs, unit);
+    }
+    std::printf("\n");
+    std::fflush(stdout);
+    return result;
+}
+
+struct BenchRegistrar {
+    BenchRegistrar(const char* name, BenchFn fn) {
+        Registry().push_back({name, fn});
+    }
+};
+
+inline bool Check(bool ok, const char* expr, const char* file, int line) {
+    if (!ok) {
+        ++FailureCount();
+        std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+    }
+    return ok;
+}
+
+inline int RunBenchmarks(int argc, char** argv) {
+    const char* only = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--quick") == 0) {
+            QuickMode() = true;
+        } else if (std::strcmp(argv[i], "--list") == 0) {
+            for (const BenchCase& bc : Registry()) {
+                std::printf("%s\n", bc.name);
+            }
+            return 0;
+        } else {
+            only = argv[i];
+        }
+    }
+
+    auto& logger = utils::Logger::Get();
+    if (!logger) {
+        logger = spdlog::stderr_color_mt("dmme-bench");
+        logger->set_level(spdlog::level::err);
+    }
+
+    int run = 0;
+    for (const BenchCase& bc : Registry()) {
+        if (only && std::strcmp(only, bc.name) != 0) {
+            continue;
+        }
+        std::printf("%s%s\n", bc.name, IsQuick() ? " (quick)" : "");
+        const int before = FailureCount();
+        bc.fn();
+        if (FailureCount() != before) {
+            std::printf("  FAILED\n");
+        }
+        std::fflush(stdout);
+        ++run;
+    }
+
+    if (run == 0) {
+        std::fprintf(stderr, "no benchmark named '%s'\n", only ? only : "");
+        return 1;
+    }
+    return FailureCount() == 0 ? 0 : 1;
+}
+
+} // namespace bench
+} // namespace dmme
+
+#define DMME_BENCH(name)                                                      \
+    static void name();                                                       \
+    static const ::dmme::bench::BenchRegistrar name##Registrar(#name, &name); \
+    static void name()
+
+#define DMME_BENCH_MAIN() \
+    int main(int argc, char** argv) { return ::dmme::bench::RunBenchmarks(argc, argv); }
+
+#define DMME_BENCH_CHECK(expr) ::dmme::bench::Check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
\ No newline at end of file
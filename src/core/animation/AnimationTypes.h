@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+namespace dmme {
+namespace core {
+namespace animation {
+
+// ------------------------------------------------------------------
+// Animation detail level (consumed by SpringBoneSolver::SetDetail;
+// the power governor picks one per tier)
+// ------------------------------------------------------------------
+
+enum class AnimationDetail : uint8_t {
+    Full    = 0,
+    Reduced = 1,   // half the spring solver iterations
+    Minimal = 2    // no secondary motion, joints follow the pose
+};
+
+} // namespace animation
+} // namespace core
+} // namespace dmme
\ No newline at end of file
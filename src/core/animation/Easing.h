@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace dmme {
+namespace core {
+namespace animation {
+
+// ------------------------------------------------------------------
+// Easing curves
+// ------------------------------------------------------------------
+
+// All curves are polynomials in t (no trig), so the tween engine can
+// evaluate them four lanes at a time. Every curve maps 0 -> 0 and
+// 1 -> 1; OutBack overshoots in between.
+enum class Ease : uint8_t {
+    Linear     = 0,
+    InQuad     = 1,
+    OutQuad    = 2,
+    InOutQuad  = 3,
+    InCubic    = 4,
+    OutCubic   = 5,
+    InOutCubic = 6,
+    SmoothStep = 7,
+    OutBack    = 8,
+    Count      = 9
+};
+
+constexpr size_t kEaseCount = static_cast<size_t>(Ease::Count);
+
+// OutBack overshoot (~10%)
+constexpr float kEaseBackC1 = 1.70158f;
+constexpr float kEaseBackC3 = kEaseBackC1 + 1.0f;
+
+inline const char* EaseName(Ease ease) {
+    switch (ease) {
+        case Ease::Linear:     return "linear";
+        case Ease::InQuad:     return "inQuad";
+        case Ease::OutQuad:    return "outQuad";
+        case Ease::InOutQuad:  return "inOutQuad";
+        case Ease::InCubic:    return "inCubic";
+        case Ease::OutCubic:   return "outCubic";
+        case Ease::InOutCubic: return "inOutCubic";
+        case Ease::SmoothStep: return "smoothStep";
+        case Ease::OutBack:    return "outBack";
+        default:               return "unknown";
+    }
+}
+
+// Scalar reference. t must already be clamped to [0, 1].
+inline float EvaluateEase(Ease ease, float t) {
+    const float u = 1.0f - t;
+    switch (ease) {
+        case Ease::InQuad:     return t * t;
+        case Ease::OutQuad:    return 1.0f - u * u;
+        case Ease::InOutQuad:  return t < 0.5f ? 2.0f * t * t : 1.0f - 2.0f * u * u;
+        case Ease::InCubic:    return t * t * t;
+        case Ease::OutCubic:   return 1.0f - u * u * u;
+        case Ease::InOutCubic: return t < 0.5f ? 4.0f * t * t * t : 1.0f - 4.0f * u * u * u;
+        case Ease::SmoothStep: return t * t * (3.0f - 2.0f * t);
+        case Ease::OutBack:    return 1.0f - kEaseBackC3 * u * u * u + kEaseBackC1 * u * u;
+        default:               return t;
+    }
+}
+
+} // namespace animation
+} // namespace core
+} // namespace dmme
\ No newline at end of file
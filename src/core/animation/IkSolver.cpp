@@ -0,0 +1,631 @@
+#include "IkSolver.h"
+#include "Skinning.h"
+#include "utils/Clock.h"
+#include "utils/Logger.h"
+#include "utils/Simd.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace dmme {
+namespace core {
+namespace animation {
+
+namespace {
+
+// ===================================================================
+// Four-lane math
+// ===================================================================
+
+// One float per chain of a batch; the kernel below is written once
+// against these and runs on SSE2 or as plain loops.
+#if defined(DMME_SIMD_SSE2)
+struct F4 { __m128 v; };
+
+inline F4 Splat(float x)                             { return {_mm_set1_ps(x)}; }
+inline F4 Lanes(float a, float b, float c, float d) { return {_mm_setr_ps(a, b, c, d)}; }
+inline F4 operator+(F4 a, F4 b) { return {_mm_add_ps(a.v, b.v)}; }
+inline F4 operator-(F4 a, F4 b) { return {_mm_sub_ps(a.v, b.v)}; }
+inline F4 operator*(F4 a, F4 b) { return {_mm_mul_ps(a.v, b.v)}; }
+inline F4 operator/(F4 a, F4 b) { return {_mm_div_ps(a.v, b.v)}; }
+inline F4 Sqrt(F4 a)            { return {_mm_sqrt_ps(a.v)}; }
+inline F4 Min(F4 a, F4 b)       { return {_mm_min_ps(a.v, b.v)}; }
+inline F4 Max(F4 a, F4 b)       { return {_mm_max_ps(a.v, b.v)}; }
+inline F4 Less(F4 a, F4 b)      { return {_mm_cmplt_ps(a.v, b.v)}; }
+inline F4 Select(F4 mask, F4 a, F4 b) {
+    return {_mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v))};
+}
+inline void Store(F4 a, float out[4]) { _mm_storeu_ps(out, a.v); }
+#else
+struct F4 { float v[4]; };
+
+template <typename Op>
+inline F4 Map(F4 a, F4 b, Op op) {
+    return {{op(a.v[0], b.v[0]), op(a.v[1], b.v[1]), op(a.v[2], b.v[2]), op(a.v[3], b.v[3])}};
+}
+
+inline F4 Splat(float x)                             { return {{x, x, x, x}}; }
+inline F4 Lanes(float a, float b, float c, float d) { return {{a, b, c, d}}; }
+inline F4 operator+(F4 a, F4 b) { return Map(a, b, [](float x, float y) { return x + y; }); }
+inline F4 operator-(F4 a, F4 b) { return Map(a, b, [](float x, float y) { return x - y; }); }
+inline F4 operator*(F4 a, F4 b) { return Map(a, b, [](float x, float y) { return x * y; }); }
+inline F4 operator/(F4 a, F4 b) { return Map(a, b, [](float x, float y) { return x / y; }); }
+inline F4 Sqrt(F4 a)            { return Map(a, a, [](float x, float) { return std::sqrt(x); }); }
+inline F4 Min(F4 a, F4 b)       { return Map(a, b, [](float x, float y) { return std::min(x, y); }); }
+inline F4 Max(F4 a, F4 b)       { return Map(a, b, [](float x, float y) { return std::max(x, y); }); }
+inline F4 Less(F4 a, F4 b)      { return Map(a, b, [](float x, float y) { return x < y ? 1.0f : 0.0f; }); }
+inline F4 Select(F4 mask, F4 a, F4 b) {
+    return {{mask.v[0] != 0.0f ? a.v[0] : b.v[0], mask.v[1] != 0.0f ? a.v[1] : b.v[1],
+             mask.v[2] != 0.0f ? a.v[2] : b.v[2], mask.v[3] != 0.0f ? a.v[3] : b.v[3]}};
+}
+inline void Store(F4 a, float out[4]) {
+    for (int i = 0; i < 4; ++i) {
+        out[i] = a.v[i];
+    }
+}
+#endif
+
+struct Vec4x3 { F4 x, y, z; };
+struct Quat4  { F4 x, y, z, w; };
+
+inline Vec4x3 operator-(const Vec4x3& a, const Vec4x3& b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+inline Vec4x3 operator+(const Vec4x3& a, const Vec4x3& b) { return {a.x + b.x, a.y + b.y, a.z + b.z}; }
+
+inline F4 Dot(const Vec4x3& a, const Vec4x3& b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+inline Vec4x3 Cross(const Vec4x3& a, const Vec4x3& b) {
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+inline Quat4 Multiply(const Quat4& a, const Quat4& b) {
+    return {a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+            a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+            a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+            a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z};
+}
+
+// v + 2w (u x v) + 2 u x (u x v), with u = +-(x, y, z)
+inline Vec4x3 Rotate(const Quat4& q, const Vec4x3& v, F4 sign) {
+    const Vec4x3 u   = {q.x * sign, q.y * sign, q.z * sign};
+    const F4     two = Splat(2.0f);
+    const Vec4x3 uv  = Cross(u, v);
+    const Vec4x3 t   = {uv.x * two, uv.y * two, uv.z * two};
+    const Vec4x3 ut  = Cross(u, t);
+    return {v.x + q.w * t.x + ut.x, v.y + q.w * t.y + ut.y, v.z + q.w * t.z + ut.z};
+}
+
+inline Quat4 Normalize(const Quat4& q) {
+    const F4 inv = Splat(1.0f) / Sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    return {q.x * inv, q.y * inv, q.z * inv, q.w * inv};
+}
+
+inline F4 Gather(const std::vector<float>& a, const uint32_t i[4]) {
+    return Lanes(a[i[0]], a[i[1]], a[i[2]], a[i[3]]);
+}
+
+// ===================================================================
+// Scalar helpers
+// ===================================================================
+
+inline void MultiplyQuat(const float a[4], const float b[4], float out[4]) {
+    const float x = a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1];
+    const float y = a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0];
+    const float z = a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3];
+    const float w = a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2];
+    out[0] = x;
+    out[1] = y;
+    out[2] = z;
+    out[3] = w;
+}
+
+inline void RotateVector(const float q[4], const float v[3], float out[3]) {
+    const float tx = 2.0f * (q[1] * v[2] - q[2] * v[1]);
+    const float ty = 2.0f * (q[2] * v[0] - q[0] * v[2]);
+    const float tz = 2.0f * (q[0] * v[1] - q[1] * v[0]);
+    out[0] = v[0] + q[3] * tx + (q[1] * tz - q[2] * ty);
+    out[1] = v[1] + q[3] * ty + (q[2] * tx - q[0] * tz);
+    out[2] = v[2] + q[3] * tz + (q[0] * ty - q[1] * tx);
+}
+
+// Quaternion of Rx(x) * Ry(y) * Rz(z)
+void EulerToQuat(float x, float y, float z, float out[4]) {
+    const float qx[4] = {std::sin(x * 0.5f), 0.0f, 0.0f, std::cos(x * 0.5f)};
+    const float qy[4] = {0.0f, std::sin(y * 0.5f), 0.0f, std::cos(y * 0.5f)};
+    const float qz[4] = {0.0f, 0.0f, std::sin(z * 0.5f), std::cos(z * 0.5f)};
+    float xy[4];
+    MultiplyQuat(qx, qy, xy);
+    MultiplyQuat(xy, qz, out);
+}
+
+// Inverse of EulerToQuat
+void QuatToEuler(const float q[4], float& x, float& y, float& z) {
+    const float r02 = 2.0f * (q[0] * q[2] + q[1] * q[3]);
+    const float sy  = std::clamp(r02, -1.0f, 1.0f);
+    y = std::asin(sy);
+    if (std::fabs(sy) < 0.9999f) {
+        x = std::atan2(-2.0f * (q[1] * q[2] - q[0] * q[3]), 1.0f - 2.0f * (q[0] * q[0] + q[1] * q[1]));
+        z = std::atan2(-2.0f * (q[0] * q[1] - q[2] * q[3]), 1.0f - 2.0f * (q[1] * q[1] + q[2] * q[2]));
+    } else {
+        // Gimbal lock: fold z into x
+        x = std::atan2(2.0f * (q[1] * q[2] + q[0] * q[3]), 1.0f - 2.0f * (q[0] * q[0] + q[2] * q[2]));
+        z = 0.0f;
+    }
+}
+
+} // namespace
+
+// ===================================================================
+// Setup
+// ===================================================================
+
+bool IkSolver::Init(assets::PmxArray<assets::PmxBone> bones, assets::PmxArray<assets::PmxIkLink> links) {
+    Reset();
+    const uint32_t count = bones.count;
+
+    // Hierarchy, ordered by depth so parents are posed first
+    m_parent.resize(count);
+    m_offset.resize(static_cast<size_t>(count) * 3);
+    std::vector<uint32_t> depth(count, 0);
+    for (uint32_t b = 0; b < count; ++b) {
+        const int32_t parent = bones[b].parent;
+        m_parent[b] = (parent >= 0 && static_cast<uint32_t>(parent) < count) ? parent : -1;
+        for (int c = 0; c < 3; ++c) {
+            m_offset[b * 3 + c] = bones[b].position[c] - (m_parent[b] >= 0 ? bones[m_parent[b]].position[c] : 0.0f);
+        }
+    }
+    for (uint32_t b = 0; b < count; ++b) {
+        for (int32_t p = m_parent[b]; p >= 0; p = m_parent[p]) {
+            if (++depth[b] > count) {
+                DMME_LOG_ERROR("IkSolver: bone {} is part of a parent cycle", b);
+                Reset();
+                return false;
+            }
+        }
+    }
+    m_order.resize(count);
+    for (uint32_t b = 0; b < count; ++b) {
+        m_order[b] = b;
+    }
+    std::stable_sort(m_order.begin(), m_order.end(),
+                     [&](uint32_t a, uint32_t b) { return depth[a] < depth[b]; });
+
+    // Chains: each link must sit on the effector's parent path
+    for (uint32_t b = 0; b < count; ++b) {
+        const assets::PmxBone& bone = bones[b];
+        if (!(bone.flags & assets::kPmxBoneIK) || bone.ikLinkCount == 0) {
+            continue;
+        }
+        if (bone.ikTarget < 0 || static_cast<uint32_t>(bone.ikTarget) >= count ||
+            bone.ikLinkOffset + bone.ikLinkCount > links.count) {
+            DMME_LOG_WARN("IkSolver: IK bone {} has an invalid target or links, skipped", b);
+            continue;
+        }
+
+        Chain chain;
+        chain.ikBone    = b;
+        chain.effector  = static_cast<uint32_t>(bone.ikTarget);
+        chain.loopCount = static_cast<uint32_t>(std::max(bone.ikLoopCount, 1));
+        chain.cosLimit  = bone.ikLimitAngle > 0.0f ? std::cos(std::min(bone.ikLimitAngle, 3.14159265f)) : -1.0f;
+        chain.firstLink = static_cast<uint32_t>(m_links.size());
+        chain.firstPath = static_cast<uint32_t>(m_path.size());
+
+        for (int32_t p = static_cast<int32_t>(chain.effector); p >= 0 && chain.pathCount < kMaxPathBones;
+             p = m_parent[p]) {
+            m_path.push_back(static_cast<uint32_t>(p));
+            ++chain.pathCount;
+        }
+
+        bool valid = true;
+        uint32_t top = 0;
+        for (uint32_t i = 0; i < bone.ikLinkCount && valid; ++i) {
+            const assets::PmxIkLink& src = links[bone.ikLinkOffset + i];
+            const uint32_t* path = m_path.data() + chain.firstPath;
+            const uint32_t* hit  = std::find(path + 1, path + chain.pathCount, static_cast<uint32_t>(src.bone));
+            if (src.bone < 0 || hit == path + chain.pathCount) {
+                valid = false;
+                break;
+            }
+            Link link;
+            link.bone      = static_cast<uint32_t>(src.bone);
+            link.pathIndex = static_cast<uint32_t>(hit - path);
+            link.hasLimits = src.hasLimits;
+            for (int c = 0; c < 3; ++c) {
+                link.minAngle[c] = std::min(src.minAngle[c], src.maxAngle[c]);
+                link.maxAngle[c] = std::max(src.minAngle[c], src.maxAngle[c]);
+            }
+            link.hinge = link.hasLimits && link.minAngle[1] == 0.0f && link.maxAngle[1] == 0.0f &&
+                         link.minAngle[2] == 0.0f && link.maxAngle[2] == 0.0f;
+            top = std::max(top, link.pathIndex);
+            m_links.push_back(link);
+        }
+        if (!valid) {
+            DMME_LOG_WARN("IkSolver: IK bone {} has a link off the effector's parent path, skipped", b);
+            m_links.resize(chain.firstLink);
+            m_path.resize(chain.firstPath);
+            continue;
+        }
+        chain.linkCount = bone.ikLinkCount;
+        chain.pathCount = top + 1;
+        m_path.resize(chain.firstPath + chain.pathCount);
+        m_chains.push_back(chain);
+    }
+
+    m_px.assign(count, 0.0f);
+    m_py.assign(count, 0.0f);
+    m_pz.assign(count, 0.0f);
+    m_qx.assign(count, 0.0f);
+    m_qy.assign(count, 0.0f);
+    m_qz.assign(count, 0.0f);
+    m_qw.assign(count, 1.0f);
+
+    m_bones = bones;
+    BuildBatches();
+    m_stats.chains  = static_cast<uint32_t>(m_chains.size());
+    m_stats.batches = static_cast<uint32_t>(m_batches.size());
+    return true;
+}
+
+// Consecutive chains share a batch while neither moves a bone the
+// other's effector or target hangs from. Chains keep the model's order.
+void IkSolver::BuildBatches() {
+    const uint32_t count = static_cast<uint32_t>(m_parent.size());
+    std::vector<uint8_t> batchLinks(count, 0);
+    std::vector<uint32_t> batchEnds;    // effectors and targets in the batch
+
+    auto hangsFrom = [&](uint32_t bone, const std::vector<uint8_t>& marks) {
+        for (int32_t p = static_cast<int32_t>(bone); p >= 0; p = m_parent[p]) {
+            if (marks[p]) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    Batch batch;
+    for (uint32_t c = 0; c < m_chains.size(); ++c) {
+        const Chain& chain = m_chains[c];
+        bool conflict = batch.chainCount == 4 ||
+                        hangsFrom(chain.effector, batchLinks) || hangsFrom(chain.ikBone, batchLinks);
+        if (!conflict && batch.chainCount > 0) {
+            std::vector<uint8_t> links(count, 0);
+            for (uint32_t i = 0; i < chain.linkCount; ++i) {
+                links[m_links[chain.firstLink + i].bone] = 1;
+            }
+            for (uint32_t end : batchEnds) {
+                conflict = conflict || hangsFrom(end, links);
+            }
+        }
+        if (conflict) {
+            m_batches.push_back(batch);
+            batch = Batch();
+            batch.firstChain = c;
+            std::fill(batchLinks.begin(), batchLinks.end(), 0);
+            batchEnds.clear();
+        }
+        if (batch.chainCount == 0) {
+            batch.firstChain = c;
+        }
+        ++batch.chainCount;
+        batch.maxLinks = std::max(batch.maxLinks, chain.linkCount);
+        batch.maxLoops = std::max(batch.maxLoops, chain.loopCount);
+        batch.maxPath  = std::max(batch.maxPath, chain.pathCount);
+        for (uint32_t i = 0; i < chain.linkCount; ++i) {
+            batchLinks[m_links[chain.firstLink + i].bone] = 1;
+        }
+        batchEnds.push_back(chain.effector);
+        batchEnds.push_back(chain.ikBone);
+    }
+    if (batch.chainCount > 0) {
+        m_batches.push_back(batch);
+    }
+}
+
+void IkSolver::Reset() {
+    m_bones = {};
+    m_parent.clear();
+    m_order.clear();
+    m_offset.clear();
+    m_px.clear();
+    m_py.clear();
+    m_pz.clear();
+    m_qx.clear();
+    m_qy.clear();
+    m_qz.clear();
+    m_qw.clear();
+    m_chains.clear();
+    m_links.clear();
+    m_path.clear();
+    m_batches.clear();
+    m_stats = IkStats();
+}
+
+// ===================================================================
+// Solve
+// ===================================================================
+
+void IkSolver::Solve(MotionPose& pose) {
+    if (pose.boneCount != m_bones.count) {
+        DMME_LOG_ERROR("IkSolver: pose has {} bones, skeleton {}", pose.boneCount, m_bones.count);
+        return;
+    }
+    const uint64_t start = utils::MonotonicMicros();
+
+    ForwardKinematics(pose);
+    uint32_t iterations = 0;
+    uint32_t converged  = 0;
+    for (const Batch& batch : m_batches) {
+        iterations += SolveBatch(batch, pose, converged);
+        // Bones below the chains (toes, twist bones) follow the new links
+        ForwardKinematics(pose);
+    }
+
+    m_stats.iterations = iterations;
+    m_stats.converged  = converged;
+    m_stats.solveMs    = utils::MicrosToMs(utils::MonotonicMicros() - start);
+}
+
+void IkSolver::ForwardKinematics(const MotionPose& pose) {
+    for (uint32_t b : m_order) {
+        const float local[3] = {m_offset[b * 3] + pose.tx[b],
+                                m_offset[b * 3 + 1] + pose.ty[b],
+                                m_offset[b * 3 + 2] + pose.tz[b]};
+        const float q[4] = {pose.qx[b], pose.qy[b], pose.qz[b], pose.qw[b]};
+        const int32_t p = m_parent[b];
+        if (p < 0) {
+            m_px[b] = local[0];
+            m_py[b] = local[1];
+            m_pz[b] = local[2];
+            m_qx[b] = q[0];
+            m_qy[b] = q[1];
+            m_qz[b] = q[2];
+            m_qw[b] = q[3];
+            continue;
+        }
+        const float parent[4] = {m_qx[p], m_qy[p], m_qz[p], m_qw[p]};
+        float offset[3];
+        float world[4];
+        RotateVector(parent, local, offset);
+        MultiplyQuat(parent, q, world);
+        m_px[b] = m_px[p] + offset[0];
+        m_py[b] = m_py[p] + offset[1];
+        m_pz[b] = m_pz[p] + offset[2];
+        m_qx[b] = world[0];
+        m_qy[b] = world[1];
+        m_qz[b] = world[2];
+        m_qw[b] = world[3];
+    }
+}
+
+// CCD over up to four chains, one lane each. Returns the sweeps run.
+uint32_t IkSolver::SolveBatch(const Batch& batch, MotionPose& pose, uint32_t& converged) {
+    const Chain* chains[4];
+    bool     used[4];
+    bool     done[4];
+    uint32_t loops[4];
+    uint32_t effector[4];
+    uint32_t target[4];
+    for (uint32_t l = 0; l < 4; ++l) {
+        chains[l]   = &m_chains[batch.firstChain + std::min(l, batch.chainCount - 1)];
+        used[l]     = l < batch.chainCount;
+        done[l]     = !used[l];
+        loops[l]    = m_iterationCap ? std::min(m_iterationCap, chains[l]->loopCount) : chains[l]->loopCount;
+        effector[l] = chains[l]->effector;
+        target[l]   = chains[l]->ikBone;
+    }
+
+    const F4    cosLimit = Lanes(chains[0]->cosLimit, chains[1]->cosLimit,
+                                 chains[2]->cosLimit, chains[3]->cosLimit);
+    const F4    zero     = Splat(0.0f);
+    const F4    one      = Splat(1.0f);
+    const F4    half     = Splat(0.5f);
+    const F4    tiny     = Splat(1e-20f);
+    const float tolerance = m_tolerance * m_tolerance;
+
+    auto distanceSq = [&](uint32_t l) {
+        const float dx = m_px[effector[l]] - m_px[target[l]];
+        const float dy = m_py[effector[l]] - m_py[target[l]];
+        const float dz = m_pz[effector[l]] - m_pz[target[l]];
+        return dx * dx + dy * dy + dz * dz;
+    };
+
+    uint32_t sweeps = 0;
+    for (uint32_t iteration = 0; iteration < batch.maxLoops; ++iteration) {
+        bool any = false;
+        for (uint32_t l = 0; l < 4; ++l) {
+            if (done[l]) {
+                continue;
+            }
+            if (distanceSq(l) < tolerance) {
+                done[l] = true;
+                ++converged;
+            } else if (iteration >= loops[l]) {
+                done[l] = true;
+            } else {
+                any = true;
+                ++sweeps;
+            }
+        }
+        if (!any) {
+            return sweeps;
+        }
+
+        for (uint32_t j = 0; j < batch.maxLinks; ++j) {
+            uint32_t    bone[4];
+            const Link* links[4];
+            bool        active[4];
+            bool        anyActive = false;
+            uint32_t    top = 0;
+            for (uint32_t l = 0; l < 4; ++l) {
+                const Chain& chain = *chains[l];
+                links[l]  = &m_links[chain.firstLink + std::min(j, chain.linkCount - 1)];
+                bone[l]   = links[l]->bone;
+                active[l] = !done[l] && j < chain.linkCount;
+                if (active[l]) {
+                    anyActive = true;
+                    top = std::max(top, links[l]->pathIndex);
+                }
+            }
+            if (!anyActive) {
+                continue;
+            }
+
+            // Effector and target in the link's frame
+            const Vec4x3 p = {Gather(m_px, bone), Gather(m_py, bone), Gather(m_pz, bone)};
+            const Quat4  q = {Gather(m_qx, bone), Gather(m_qy, bone), Gather(m_qz, bone), Gather(m_qw, bone)};
+            Vec4x3 e = Rotate(q, Vec4x3{Gather(m_px, effector), Gather(m_py, effector),
+                                        Gather(m_pz, effector)} - p, Splat(-1.0f));
+            Vec4x3 t = Rotate(q, Vec4x3{Gather(m_px, target), Gather(m_py, target),
+                                        Gather(m_pz, target)} - p, Splat(-1.0f));
+
+            // Hinges: project onto the YZ plane so the step is about X
+            const F4 free = Lanes(links[0]->hinge ? 0.0f : 1.0f, links[1]->hinge ? 0.0f : 1.0f,
+                                  links[2]->hinge ? 0.0f : 1.0f, links[3]->hinge ? 0.0f : 1.0f);
+            e.x = e.x * free;
+            t.x = t.x * free;
+
+            // Rotation taking e towards t, capped at the step limit;
+            // half-angle identities give the quaternion without trig
+            const Vec4x3 axis   = Cross(e, t);
+            const F4     axisSq = Dot(axis, axis);
+            const F4     lenSq  = Dot(e, e) * Dot(t, t);
+            const F4     cosine = Min(Max(Dot(e, t) / Sqrt(Max(lenSq, tiny)), cosLimit), one);
+            const F4     valid  = Less(lenSq * Splat(1e-12f), axisSq);
+            const F4     s      = Sqrt(Max((one - cosine) * half, zero)) / Sqrt(Max(axisSq, tiny));
+            const Quat4  delta  = {Select(valid, axis.x * s, zero), Select(valid, axis.y * s, zero),
+                                   Select(valid, axis.z * s, zero), Select(valid, Sqrt((one + cosine) * half), one)};
+
+            const Quat4 local  = {Gather(pose.qx, bone), Gather(pose.qy, bone),
+                                  Gather(pose.qz, bone), Gather(pose.qw, bone)};
+            const Quat4 solved = Normalize(Multiply(local, delta));
+            alignas(16) float out[4][4];
+            Store(solved.x, out[0]);
+            Store(solved.y, out[1]);
+            Store(solved.z, out[2]);
+            Store(solved.w, out[3]);
+            for (uint32_t l = 0; l < 4; ++l) {
+                if (!active[l]) {
+                    continue;
+                }
+                pose.qx[bone[l]] = out[0][l];
+                pose.qy[bone[l]] = out[1][l];
+                pose.qz[bone[l]] = out[2][l];
+                pose.qw[bone[l]] = out[3][l];
+                if (links[l]->hasLimits) {
+                    ClampLink(*links[l], pose);
+                }
+            }
+
+            // Re-pose the paths from the highest moved link down to the
+            // effectors. Bones above a lane's own link and padding
+            // entries (the effector again) are recomputed unchanged.
+            for (uint32_t k = top + 1; k-- > 0;) {
+                uint32_t node[4];
+                uint32_t parent[4];
+                bool     root[4];
+                for (uint32_t l = 0; l < 4; ++l) {
+                    const Chain& chain = *chains[l];
+                    node[l]   = m_path[chain.firstPath + (k < chain.pathCount ? k : 0)];
+                    root[l]   = m_parent[node[l]] < 0;
+                    parent[l] = root[l] ? node[l] : static_cast<uint32_t>(m_parent[node[l]]);
+                }
+                Quat4  pq = {Gather(m_qx, parent), Gather(m_qy, parent), Gather(m_qz, parent), Gather(m_qw, parent)};
+                Vec4x3 pp = {Gather(m_px, parent), Gather(m_py, parent), Gather(m_pz, parent)};
+                if (root[0] || root[1] || root[2] || root[3]) {
+                    const F4 isRoot = Lanes(root[0] ? 1.0f : 0.0f, root[1] ? 1.0f : 0.0f,
+                                            root[2] ? 1.0f : 0.0f, root[3] ? 1.0f : 0.0f);
+                    const F4 mask = Less(half, isRoot);
+                    pq = {Select(mask, zero, pq.x), Select(mask, zero, pq.y),
+                          Select(mask, zero, pq.z), Select(mask, one, pq.w)};
+                    pp = {Select(mask, zero, pp.x), Select(mask, zero, pp.y), Select(mask, zero, pp.z)};
+                }
+                const uint32_t o[4] = {node[0] * 3, node[1] * 3, node[2] * 3, node[3] * 3};
+                const Vec4x3 offset = {Lanes(m_offset[o[0]], m_offset[o[1]], m_offset[o[2]], m_offset[o[3]]) +
+                                           Gather(pose.tx, node),
+                                       Lanes(m_offset[o[0] + 1], m_offset[o[1] + 1], m_offset[o[2] + 1],
+                                             m_offset[o[3] + 1]) + Gather(pose.ty, node),
+                                       Lanes(m_offset[o[0] + 2], m_offset[o[1] + 2], m_offset[o[2] + 2],
+                                             m_offset[o[3] + 2]) + Gather(pose.tz, node)};
+                const Quat4  nq = {Gather(pose.qx, node), Gather(pose.qy, node),
+                                   Gather(pose.qz, node), Gather(pose.qw, node)};
+                const Vec4x3 wp = pp + Rotate(pq, offset, one);
+                const Quat4  wq = Multiply(pq, nq);
+
+                alignas(16) float w[7][4];
+                Store(wp.x, w[0]);
+                Store(wp.y, w[1]);
+                Store(wp.z, w[2]);
+                Store(wq.x, w[3]);
+                Store(wq.y, w[4]);
+                Store(wq.z, w[5]);
+                Store(wq.w, w[6]);
+                for (uint32_t l = 0; l < batch.chainCount; ++l) {
+                    const uint32_t b = node[l];
+                    m_px[b] = w[0][l];
+                    m_py[b] = w[1][l];
+                    m_pz[b] = w[2][l];
+                    m_qx[b] = w[3][l];
+                    m_qy[b] = w[4][l];
+                    m_qz[b] = w[5][l];
+                    m_qw[b] = w[6][l];
+                }
+            }
+        }
+    }
+
+    // Lanes that used their last sweep
+    for (uint32_t l = 0; l < 4; ++l) {
+        if (!done[l] && distanceSq(l) < tolerance) {
+            ++converged;
+        }
+    }
+    return sweeps;
+}
+
+// Clamp the link's local rotation to its limits on Rx * Ry * Rz Euler
+// angles
+void IkSolver::ClampLink(const Link& link, MotionPose& pose) const {
+    const uint32_t b = link.bone;
+    const float q[4] = {pose.qx[b], pose.qy[b], pose.qz[b], pose.qw[b]};
+    float angle[3];
+    QuatToEuler(q, angle[0], angle[1], angle[2]);
+    for (int c = 0; c < 3; ++c) {
+        angle[c] = std::clamp(angle[c], link.minAngle[c], link.maxAngle[c]);
+    }
+    float clamped[4];
+    EulerToQuat(angle[0], angle[1], angle[2], clamped);
+    pose.qx[b] = clamped[0];
+    pose.qy[b] = clamped[1];
+    pose.qz[b] = clamped[2];
+    pose.qw[b] = clamped[3];
+}
+
+// ===================================================================
+// Output
+// ===================================================================
+
+void IkSolver::BuildPalette(SkinningPalette& palette) const {
+    if (palette.GetBoneCount() != m_bones.count) {
+        palette.Resize(m_bones.count);
+    }
+    for (uint32_t b = 0; b < m_bones.count; ++b) {
+        const float rotation[4] = {m_qx[b], m_qy[b], m_qz[b], m_qw[b]};
+        const float position[3] = {m_px[b], m_py[b], m_pz[b]};
+        palette.SetBone(b, rotation, position, m_bones[b].position);
+    }
+}
+
+void IkSolver::GetWorld(uint32_t bone, float position[3], float rotation[4]) const {
+    position[0] = m_px[bone];
+    position[1] = m_py[bone];
+    position[2] = m_pz[bone];
+    rotation[0] = m_qx[bone];
+    rotation[1] = m_qy[bone];
+    rotation[2] = m_qz[bone];
+    rotation[3] = m_qw[bone];
+}
+
+} // namespace animation
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "core/assets/PmxModel.h"
+#include "MotionSampler.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace dmme {
+namespace core {
+namespace animation {
+
+class SkinningPalette;
+
+// ------------------------------------------------------------------
+// Stats
+// ------------------------------------------------------------------
+
+struct IkStats {
+    uint32_t chains     = 0;
+    uint32_t batches    = 0;        // groups of up to four independent chains
+    uint32_t iterations = 0;        // CCD sweeps run by the last Solve, all chains
+    uint32_t converged  = 0;        // chains within tolerance after the last Solve
+    float    solveMs    = 0.0f;     // last Solve, including forward kinematics
+};
+
+// ------------------------------------------------------------------
+// IkSolver
+// ------------------------------------------------------------------
+
+// IkSolver poses a PMX skeleton and solves its IK chains (legs, toes,
+// look-at) with cyclic coordinate descent, the method MMD itself uses.
+//
+// It sits between animation sampling and skinning: Solve takes the
+// sampled local pose (a MotionPose sized for the skeleton, indexed by
+// bone), runs forward kinematics, rotates each chain's link bones so
+// the effector reaches the IK bone, writes the solved local rotations
+// back into the pose and leaves world transforms for BuildPalette.
+//
+// Chains are solved four at a time, one SIMD lane per chain (SSE2;
+// scalar elsewhere): consecutive chains that do not depend on each
+// other (both legs, then both toes) share a batch, and every CCD step
+// gathers the four links' world transforms into SoA quaternions and
+// vectors. Each step's rotation is capped at the chain's per-iteration
+// limit angle, a lane stops once its effector is within tolerance or
+// its loop count (optionally capped) runs out, and the batch stops when
+// all lanes have. Links with angle limits are clamped on the XYZ Euler
+// angles of their local rotation (scalar); hinges (limits on X only,
+// like knees) take their step about X directly, which converges in far
+// fewer sweeps than rotating freely and clamping.
+//
+// Inherited (grant) transforms, physics and external parents are not
+// applied here.
+//
+// Usage:
+//   IkSolver ik;
+//   ik.Init(model.GetBones(), model.GetIkLinks());
+//   MotionPose pose;
+//   pose.Resize(model.GetBones().count, 0);
+//   // each frame, after sampling the motion into pose:
+//   ik.Solve(pose);
+//   ik.BuildPalette(palette);
+//   skinner.Skin(palette, vertices, &jobs);
+
+class IkSolver {
+public:
+    static constexpr uint32_t kMaxPathBones = 32;   // effector up to the top link
+
+    IkSolver() = default;
+    ~IkSolver() = default;
+
+    IkSolver(const IkSolver&) = delete;
+    IkSolver& operator=(const IkSolver&) = delete;
+
+    // Bind a skeleton (the model must outlive the solver). Returns false
+    // if the hierarchy is malformed; chains whose links are not on the
+    // effector's parent path are skipped with a warning.
+    bool Init(assets::PmxArray<assets::PmxBone> bones, assets::PmxArray<assets::PmxIkLink> links);
+    void Reset();
+
+    // Cap CCD loops per chain (0 = the model's loop counts)
+    void SetIterationCap(uint32_t cap) { m_iterationCap = cap; }
+
+    // Effector distance that counts as solved (model units)
+    void SetTolerance(float distance) { m_tolerance = distance; }
+
+    // Solve every chain against pose (boneCount entries) and update its
+    // link rotations in place.
+    void Solve(MotionPose& pose);
+
+    // Skinning transforms of the last Solve
+    void BuildPalette(SkinningPalette& palette) const;
+
+    // World transform of the last Solve
+    void GetWorld(uint32_t bone, float position[3], float rotation[4]) const;
+
+    uint32_t       GetBoneCount() const  { return m_bones.count; }
+    uint32_t       GetChainCount() const { return static_cast<uint32_t>(m_chains.size()); }
+    const IkStats& GetStats() const      { return m_stats; }
+
+private:
+    struct Chain {
+        uint32_t ikBone    = 0;     // target position
+        uint32_t effector  = 0;
+        uint32_t loopCount = 0;
+        float    cosLimit  = -1.0f; // cos of the per-step angle limit
+        uint32_t firstLink = 0;     // into m_links
+        uint32_t linkCount = 0;
+        uint32_t firstPath = 0;     // into m_path, effector first
+        uint32_t pathCount = 0;
+    };
+
+    struct Link {
+        uint32_t bone      = 0;
+        uint32_t pathIndex = 0;     // position on the chain's path
+        bool     hasLimits = false;
+        bool     hinge     = false; // limits allow X rotation only (knees)
+        float    minAngle[3] = {};
+        float    maxAngle[3] = {};
+    };
+
+    struct Batch {
+        uint32_t firstChain = 0;
+        uint32_t chainCount = 0;
+        uint32_t maxLinks   = 0;
+        uint32_t maxLoops   = 0;
+        uint32_t maxPath    = 0;
+    };
+
+    void BuildBatches();
+    void ForwardKinematics(const MotionPose& pose);
+    uint32_t SolveBatch(const Batch& batch, MotionPose& pose, uint32_t& converged);
+    void ClampLink(const Link& link, MotionPose& pose) const;
+
+    assets::PmxArray<assets::PmxBone> m_bones;
+
+    std::vector<int32_t>  m_parent;
+    std::vector<uint32_t> m_order;          // parents before children
+    std::vector<float>    m_offset;         // xyz rest offset from the parent
+
+    // --- World transforms (SoA) ---
+    std::vector<float> m_px, m_py, m_pz;
+    std::vector<float> m_qx, m_qy, m_qz, m_qw;
+
+    std::vector<Chain>    m_chains;
+    std::vector<Link>     m_links;
+    std::vector<uint32_t> m_path;
+    std::vector<Batch>    m_batches;
+
+    uint32_t m_iterationCap = 0;
+    float    m_tolerance    = 1e-3f;
+    IkStats  m_stats;
+};
+
+} // namespace animation
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,268 @@
+#include "MorphDeformer.h"
+#include "utils/Clock.h"
+#include "utils/Logger.h"
+#include "utils/Simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace dmme {
+namespace core {
+namespace animation {
+
+namespace {
+
+// Weights closer to zero than this leave a morph inactive
+constexpr float kWeightEpsilon = 1e-6f;
+
+} // namespace
+
+// ===================================================================
+// Setup
+// ===================================================================
+
+bool MorphDeformer::Init(const assets::PmxVertexTable& vertices,
+                         assets::PmxArray<assets::PmxMorph> morphs) {
+    Reset();
+
+    // Slots for vertex morphs, validated and counted first so the SoA
+    // arrays are sized once
+    std::vector<int32_t> slotOf(morphs.count, -1);
+    uint32_t total = 0;
+    for (uint32_t m = 0; m < morphs.count; ++m) {
+        const assets::PmxMorph& morph = morphs[m];
+        if (morph.type != assets::PmxMorphType::Vertex || morph.offsetCount == 0) {
+            continue;
+        }
+        for (uint32_t i = 0; i < morph.offsetCount; ++i) {
+            const int32_t v = morph.vertex[i].vertex;
+            if (v < 0 || static_cast<uint32_t>(v) >= vertices.count) {
+                DMME_LOG_ERROR("MorphDeformer: morph {} offsets vertex {} of {}", m, v, vertices.count);
+                Reset();
+                return false;
+            }
+        }
+        Slot slot;
+        slot.morph   = m;
+        slot.first   = total;
+        slot.offsets = morph.offsetCount;
+        slot.count   = (morph.offsetCount + 3u) & ~3u;
+        total += slot.count;
+        slotOf[m] = static_cast<int32_t>(m_slots.size());
+        m_slots.push_back(slot);
+    }
+
+    m_offsetVertex.resize(total);
+    m_dx.resize(total);
+    m_dy.resize(total);
+    m_dz.resize(total);
+    for (const Slot& slot : m_slots) {
+        const assets::PmxMorph& morph = morphs[slot.morph];
+        for (uint32_t i = 0; i < slot.count; ++i) {
+            // Padding repeats the last vertex with a zero offset
+            const assets::PmxVertexMorphOffset& o = morph.vertex[std::min(i, slot.offsets - 1)];
+            const bool pad = i >= slot.offsets;
+            m_offsetVertex[slot.first + i] = static_cast<uint32_t>(o.vertex);
+            m_dx[slot.first + i] = pad ? 0.0f : o.translation[0];
+            m_dy[slot.first + i] = pad ? 0.0f : o.translation[1];
+            m_dz[slot.first + i] = pad ? 0.0f : o.translation[2];
+        }
+    }
+
+    // Group morphs reach vertex morphs one level deep (PMX does not
+    // allow groups of groups)
+    for (uint32_t m = 0; m < morphs.count; ++m) {
+        const assets::PmxMorph& morph = morphs[m];
+        if (morph.type != assets::PmxMorphType::Group) {
+            continue;
+        }
+        for (uint32_t i = 0; i < morph.offsetCount; ++i) {
+            const int32_t member = morph.group[i].morph;
+            if (member >= 0 && static_cast<uint32_t>(member) < morphs.count && slotOf[member] >= 0) {
+                m_links.push_back({m, static_cast<uint32_t>(slotOf[member]), morph.group[i].weight});
+            }
+        }
+    }
+
+    const size_t floats = static_cast<size_t>(vertices.count) * 3;
+    m_base.assign(floats + 1, 0.0f);
+    if (floats > 0) {
+        std::memcpy(m_base.data(), vertices.positions, floats * sizeof(float));
+    }
+    m_positions = m_base;
+
+    m_morphs   = morphs;
+    m_vertices = vertices;
+    m_vertices.positions = m_positions.data();
+
+    m_weights.assign(morphs.count, 0.0f);
+    m_effective.assign(m_slots.size(), 0.0f);
+    m_applied.assign(m_slots.size(), 0.0f);
+    m_active.reserve(m_slots.size());
+
+    m_stats.vertexMorphs = static_cast<uint32_t>(m_slots.size());
+    for (const Slot& slot : m_slots) {
+        m_stats.offsets += slot.offsets;
+    }
+    m_memory.Set(GetMemoryBytes());
+    return true;
+}
+
+void MorphDeformer::Reset() {
+    m_morphs   = {};
+    m_vertices = {};
+    m_weights.clear();
+    m_slots.clear();
+    m_links.clear();
+    m_effective.clear();
+    m_applied.clear();
+    m_active.clear();
+    m_offsetVertex.clear();
+    m_dx.clear();
+    m_dy.clear();
+    m_dz.clear();
+    m_base.clear();
+    m_positions.clear();
+    m_stats = MorphStats();
+    m_memory.Reset();
+}
+
+int32_t MorphDeformer::FindMorph(std::string_view name) const {
+    for (uint32_t m = 0; m < m_morphs.count; ++m) {
+        if (m_morphs[m].name == name) {
+            return static_cast<int32_t>(m);
+        }
+    }
+    return -1;
+}
+
+void MorphDeformer::SetWeight(uint32_t morph, float weight) {
+    if (morph < m_weights.size()) {
+        m_weights[morph] = weight;
+    }
+}
+
+void MorphDeformer::ClearWeights() {
+    std::fill(m_weights.begin(), m_weights.end(), 0.0f);
+}
+
+size_t MorphDeformer::GetMemoryBytes() const {
+    return m_slots.capacity() * sizeof(Slot) + m_links.capacity() * sizeof(GroupLink) +
+           (m_weights.capacity() + m_effective.capacity() + m_applied.capacity() +
+            m_dx.capacity() + m_dy.capacity() + m_dz.capacity() +
+            m_base.capacity() + m_positions.capacity()) * sizeof(float) +
+           (m_active.capacity() + m_offsetVertex.capacity()) * sizeof(uint32_t);
+}
+
+// ===================================================================
+// Apply
+// ===================================================================
+
+bool MorphDeformer::Apply() {
+    const uint64_t start = utils::MonotonicMicros();
+
+    // Effective weight per vertex morph: its own plus its groups'
+    bool changed = false;
+    for (size_t s = 0; s < m_slots.size(); ++s) {
+        m_effective[s] = m_weights[m_slots[s].morph];
+    }
+    for (const GroupLink& link : m_links) {
+        m_effective[link.slot] += m_weights[link.group] * link.weight;
+    }
+    for (size_t s = 0; s < m_slots.size(); ++s) {
+        if (std::fabs(m_effective[s]) < kWeightEpsilon) {
+            m_effective[s] = 0.0f;
+        }
+        changed |= m_effective[s] != m_applied[s];
+    }
+
+    if (!changed) {
+        ++m_stats.skippedApplies;
+        m_stats.applyMs = utils::MicrosToMs(utils::MonotonicMicros() - start);
+        return false;
+    }
+
+    // Only vertices of active morphs differ from the rest pose, so
+    // restoring those and adding the new active set is exact.
+    for (uint32_t s : m_active) {
+        Restore(m_slots[s]);
+    }
+    m_active.clear();
+    m_stats.activeOffsets = 0;
+    for (size_t s = 0; s < m_slots.size(); ++s) {
+        m_applied[s] = m_effective[s];
+        if (m_effective[s] != 0.0f) {
+            Accumulate(m_slots[s], m_effective[s]);
+            m_active.push_back(static_cast<uint32_t>(s));
+            m_stats.activeOffsets += m_slots[s].offsets;
+        }
+    }
+
+    m_stats.activeMorphs = static_cast<uint32_t>(m_active.size());
+    ++m_stats.applies;
+    m_stats.applyMs = utils::MicrosToMs(utils::MonotonicMicros() - start);
+    return true;
+}
+
+// Copy the rest position back. The 16-byte copy also rewrites the next
+// vertex's x with its rest value, which is harmless: any vertex that is
+// not at rest belongs to an active morph and is restored as well.
+void MorphDeformer::Restore(const Slot& slot) {
+    const uint32_t* vertex = m_offsetVertex.data() + slot.first;
+    const float*    base   = m_base.data();
+    float*          out    = m_positions.data();
+
+    for (uint32_t i = 0; i < slot.count; ++i) {
+        const size_t p = static_cast<size_t>(vertex[i]) * 3;
+#if defined(DMME_SIMD_SSE2)
+        _mm_storeu_ps(out + p, _mm_loadu_ps(base + p));
+#else
+        out[p]     = base[p];
+        out[p + 1] = base[p + 1];
+        out[p + 2] = base[p + 2];
+#endif
+    }
+}
+
+void MorphDeformer::Accumulate(const Slot& slot, float weight) {
+    const uint32_t* vertex = m_offsetVertex.data() + slot.first;
+    const float*    dx     = m_dx.data() + slot.first;
+    const float*    dy     = m_dy.data() + slot.first;
+    const float*    dz     = m_dz.data() + slot.first;
+    float*          out    = m_positions.data();
+
+#if defined(DMME_SIMD_SSE2)
+    // Scale four offsets at once, transpose to one xyz0 vector per
+    // offset and scatter with a 16-byte add (w adds zero to the next
+    // vertex's x). Offsets are applied in order, so a vertex listed
+    // twice still accumulates both.
+    const __m128 w = _mm_set1_ps(weight);
+    for (uint32_t i = 0; i < slot.count; i += 4) {
+        __m128 r0 = _mm_mul_ps(_mm_loadu_ps(dx + i), w);
+        __m128 r1 = _mm_mul_ps(_mm_loadu_ps(dy + i), w);
+        __m128 r2 = _mm_mul_ps(_mm_loadu_ps(dz + i), w);
+        __m128 r3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        float* p0 = out + static_cast<size_t>(vertex[i]) * 3;
+        _mm_storeu_ps(p0, _mm_add_ps(_mm_loadu_ps(p0), r0));
+        float* p1 = out + static_cast<size_t>(vertex[i + 1]) * 3;
+        _mm_storeu_ps(p1, _mm_add_ps(_mm_loadu_ps(p1), r1));
+        float* p2 = out + static_cast<size_t>(vertex[i + 2]) * 3;
+        _mm_storeu_ps(p2, _mm_add_ps(_mm_loadu_ps(p2), r2));
+        float* p3 = out + static_cast<size_t>(vertex[i + 3]) * 3;
+        _mm_storeu_ps(p3, _mm_add_ps(_mm_loadu_ps(p3), r3));
+    }
+#else
+    for (uint32_t i = 0; i < slot.count; ++i) {
+        float* p = out + static_cast<size_t>(vertex[i]) * 3;
+        p[0] += dx[i] * weight;
+        p[1] += dy[i] * weight;
+        p[2] += dz[i] * weight;
+    }
+#endif
+}
+
+} // namespace animation
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "core/assets/PmxModel.h"
+#include "core/memory/MemoryAccountant.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace dmme {
+namespace core {
+namespace animation {
+
+// ------------------------------------------------------------------
+// Stats
+// ------------------------------------------------------------------
+
+struct MorphStats {
+    uint32_t vertexMorphs   = 0;
+    uint32_t offsets        = 0;        // vertex offsets over all vertex morphs
+    uint32_t activeMorphs   = 0;        // non-zero after the last Apply
+    uint32_t activeOffsets  = 0;
+    uint64_t applies        = 0;        // Apply calls that rewrote positions
+    uint64_t skippedApplies = 0;        // Apply calls with no weight change
+    float    applyMs        = 0.0f;     // last Apply
+};
+
+// ------------------------------------------------------------------
+// MorphDeformer
+// ------------------------------------------------------------------
+
+// MorphDeformer applies PMX vertex morphs (blend shapes) to a copy of
+// a model's rest positions. Group morphs are expanded into weights on
+// their vertex-morph members; other morph types are left to their own
+// systems and their weights are ignored here.
+//
+// Init repacks every vertex morph's offsets as sparse SoA (vertex
+// index, dx, dy, dz), padded to whole batches of four. Apply resolves
+// the effective weight of each vertex morph and returns at once if
+// none changed since the last call; otherwise it restores the vertices
+// of the previously active morphs from the rest copy and adds the
+// offsets of the morphs that are non-zero now. The cost follows the
+// active set, not the model: a face with two expressions on touches a
+// few hundred vertices. Offsets are scaled four at a time (SSE2;
+// scalar elsewhere) and scattered as 16-byte adds, so the position
+// buffer carries one float of padding.
+//
+// GetVertices returns the model's vertex table with positions pointing
+// at the morphed copy; a Skinner initialised from it sees the morphs
+// without further copying.
+//
+// Usage:
+//   MorphDeformer morphs;
+//   morphs.Init(model.GetVertices(), model.GetMorphs());
+//   skinner.Init(morphs.GetVertices(), model.GetBones().count);
+//   int32_t blink = morphs.FindMorph("まばたき");
+//   // each frame, before skinning:
+//   morphs.SetWeight(blink, pose.morphWeights[track]);
+//   morphs.Apply();
+
+class MorphDeformer {
+public:
+    MorphDeformer() = default;
+    ~MorphDeformer() = default;
+
+    MorphDeformer(const MorphDeformer&) = delete;
+    MorphDeformer& operator=(const MorphDeformer&) = delete;
+
+    // Bind a model's vertices and morphs (the model must outlive the
+    // deformer). Returns false if a vertex offset is out of range.
+    bool Init(const assets::PmxVertexTable& vertices, assets::PmxArray<assets::PmxMorph> morphs);
+    void Reset();
+
+    // Morph index by name, or -1
+    int32_t FindMorph(std::string_view name) const;
+
+    // Requested weight of any morph (usually 0 - 1)
+    void  SetWeight(uint32_t morph, float weight);
+    float GetWeight(uint32_t morph) const { return m_weights[morph]; }
+    void  ClearWeights();
+
+    // Bring the positions up to date with the weights. Returns true if
+    // they were rewritten.
+    bool Apply();
+
+    // The bound vertex table, positions replaced by the morphed copy
+    const assets::PmxVertexTable& GetVertices() const { return m_vertices; }
+    const float*                  GetPositions() const { return m_positions.data(); }
+
+    uint32_t          GetMorphCount() const { return m_morphs.count; }
+    const MorphStats& GetStats() const      { return m_stats; }
+    size_t            GetMemoryBytes() const;
+
+private:
+    // One vertex morph's offsets, [first, first + count) in the SoA
+    // arrays; count is a multiple of four
+    struct Slot {
+        uint32_t morph = 0;
+        uint32_t first = 0;
+        uint32_t count = 0;
+        uint32_t offsets = 0;       // before padding
+    };
+
+    // Group morph member that is a vertex morph
+    struct GroupLink {
+        uint32_t group = 0;
+        uint32_t slot  = 0;
+        float    weight = 0.0f;
+    };
+
+    void Restore(const Slot& slot);
+    void Accumulate(const Slot& slot, float weight);
+
+    assets::PmxArray<assets::PmxMorph> m_morphs;
+    assets::PmxVertexTable m_vertices;
+
+    std::vector<float>     m_weights;       // requested, per morph
+    std::vector<Slot>      m_slots;
+    std::vector<GroupLink> m_links;
+    std::vector<float>     m_effective;     // per slot, scratch
+    std::vector<float>     m_applied;       // per slot, in m_positions
+    std::vector<uint32_t>  m_active;        // slots with non-zero applied weight
+
+    // --- Offsets (SoA) ---
+    std::vector<uint32_t> m_offsetVertex;
+    std::vector<float>    m_dx, m_dy, m_dz;
+
+    // xyz per vertex plus one float of padding for the 16-byte scatter
+    std::vector<float> m_base;
+    std::vector<float> m_positions;
+
+    MorphStats            m_stats;
+    memory::TrackedMemory m_memory{memory::MemoryCategory::Asset};
+};
+
+} // namespace animation
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,518 @@
+#include "MotionClip.h"
+#include "core/assets/DerivedDataCache.h"
+#include "core/assets/MappedFile.h"
+#include "utils/Logger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace dmme {
+namespace core {
+namespace animation {
+
+namespace {
+
+// --- VMD layout ---
+constexpr size_t kVmdSignatureBytes = 30;
+constexpr size_t kVmdNameBytes      = 15;
+constexpr size_t kVmdBoneKeyBytes   = 111;
+constexpr size_t kVmdMorphKeyBytes  = 23;
+
+// "Vocaloid Motion Data 0002" files carry a 20-byte model name,
+// the older "Vocaloid Motion Data file" a 10-byte one.
+constexpr char kVmdSignature2[] = "Vocaloid Motion Data 0002";
+constexpr char kVmdSignature1[] = "Vocaloid Motion Data file";
+
+// Names are NUL-terminated within their fixed field
+std::string ReadName(const uint8_t* p) {
+    size_t length = 0;
+    while (length < kVmdNameBytes && p[length] != 0) {
+        ++length;
+    }
+    return std::string(reinterpret_cast<const char*>(p), length);
+}
+
+template <typename T>
+T ReadValue(const uint8_t* p) {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+// Bezier x(t) or y(t) with end points 0 and 1
+inline float BezierAxis(float p1, float p2, float t) {
+    const float u = 1.0f - t;
+    return 3.0f * u * u * t * p1 + 3.0f * u * t * t * p2 + t * t * t;
+}
+
+// Stable key order per track; the last of several keys on one frame wins
+template <typename Key>
+void GroupKeys(const std::vector<Key>& keys,
+               std::vector<std::string>& names,
+               std::vector<std::vector<uint32_t>>& trackKeys) {
+    std::unordered_map<std::string, uint32_t> lookup;
+    for (uint32_t i = 0; i < keys.size(); ++i) {
+        auto it = lookup.find(keys[i].name);
+        if (it == lookup.end()) {
+            it = lookup.emplace(keys[i].name, static_cast<uint32_t>(names.size())).first;
+            names.push_back(keys[i].name);
+            trackKeys.emplace_back();
+        }
+        trackKeys[it->second].push_back(i);
+    }
+
+    for (auto& indices : trackKeys) {
+        std::stable_sort(indices.begin(), indices.end(), [&](uint32_t a, uint32_t b) {
+            return keys[a].frame < keys[b].frame;
+        });
+        size_t out = 0;
+        for (size_t i = 0; i < indices.size(); ++i) {
+            if (out > 0 && keys[indices[out - 1]].frame == keys[indices[i]].frame) {
+                indices[out - 1] = indices[i];
+            } else {
+                indices[out++] = indices[i];
+            }
+        }
+        indices.resize(out);
+    }
+}
+
+// --- Baked layout (derived-data cache payload) ---
+// Counts (bone tracks, morph tracks, bone keys, morph keys, curves) and
+// the duration, then per track its first key, key count, name length
+// and name padded to 4 bytes, then the key tables and baked curves as
+// they are held in memory. Native byte order.
+constexpr uint32_t kBakedClipKind    = assets::MakeFourCC('M', 'C', 'L', 'P');
+constexpr uint32_t kBakedClipVersion = 1;   // bump with any change to the layout or to Build
+
+template <typename T>
+void AppendArray(std::vector<uint8_t>& out, const T* data, size_t count) {
+    const size_t bytes = count * sizeof(T);
+    const size_t at = out.size();
+    out.resize(at + ((bytes + 3) & ~size_t(3)), 0);
+    if (bytes > 0) {
+        std::memcpy(out.data() + at, data, bytes);
+    }
+}
+
+// Bounds-checked cursor over a baked payload
+struct BakedReader {
+    const uint8_t* p;
+    const uint8_t* end;
+
+    template <typename T>
+    bool Read(T* out, size_t count) {
+        const size_t bytes = count * sizeof(T);
+        if (count > static_cast<size_t>(end - p) / sizeof(T)) {
+            return false;
+        }
+        if (bytes > 0) {
+            std::memcpy(out, p, bytes);
+        }
+        p += std::min<size_t>((bytes + 3) & ~size_t(3), static_cast<size_t>(end - p));
+        return true;
+    }
+
+    template <typename T>
+    bool ReadVector(std::vector<T>& out, size_t count) {
+        if (count > static_cast<size_t>(end - p) / sizeof(T)) {
+            return false;
+        }
+        out.resize(count);
+        return Read(out.data(), count);
+    }
+};
+
+} // anonymous namespace
+
+// ===================================================================
+// Curves
+// ===================================================================
+
+void BakeBezierCurve(float x1, float y1, float x2, float y2, BakedCurve& out) {
+    for (uint32_t i = 0; i <= kCurveSamples; ++i) {
+        const float t = static_cast<float>(i) / kCurveSamples;
+        out.x[i] = BezierAxis(x1, x2, t);
+        out.y[i] = BezierAxis(y1, y2, t);
+    }
+    out.x[0] = out.y[0] = 0.0f;
+    out.x[kCurveSamples] = out.y[kCurveSamples] = 1.0f;
+
+    // x(t) is monotonic for control points in [0, 1]
+    uint32_t i = 0;
+    for (uint32_t bin = 0; bin < kCurveSamples; ++bin) {
+        const float x = static_cast<float>(bin) / kCurveSamples;
+        while (i + 1 < kCurveSamples && out.x[i + 1] <= x) {
+            ++i;
+        }
+        out.start[bin] = static_cast<uint8_t>(i);
+    }
+}
+
+// ===================================================================
+// Loading
+// ===================================================================
+
+bool MotionClip::LoadVmd(const std::string& path) {
+    assets::MappedFile file;
+    if (!file.Open(path)) {
+        return false;
+    }
+    if (!LoadVmdFromMemory(file.GetData(), file.GetSize())) {
+        DMME_LOG_ERROR("MotionClip: failed to load '{}'", path);
+        return false;
+    }
+    DMME_LOG_INFO("MotionClip: loaded '{}' ({} bone tracks / {} keys, {} morph tracks / {} keys, "
+                  "{} curves, {} frames)",
+                  path, GetBoneTrackCount(), GetBoneKeyCount(), GetMorphTrackCount(),
+                  GetMorphKeyCount(), GetCurveCount(), m_duration);
+    return true;
+}
+
+bool MotionClip::LoadVmdCached(const std::string& path, assets::DerivedDataCache& cache) {
+    assets::MappedFile file;
+    if (!file.Open(path)) {
+        return false;
+    }
+
+    // Sample density changes every baked curve, so it is part of the key
+    const std::string settings = "curveSamples=" + std::to_string(kCurveSamples);
+    const assets::DerivedDataKey key = assets::DerivedDataCache::MakeKey(
+        kBakedClipKind, kBakedClipVersion, file.GetData(), file.GetSize(), settings);
+
+    assets::DerivedDataBlob blob;
+    if (cache.Find(key, blob)) {
+        if (LoadBaked(blob.GetData(), blob.GetSize())) {
+            return true;
+        }
+        DMME_LOG_WARN("MotionClip: cached form of '{}' is unusable, reparsing", path);
+    }
+
+    if (!LoadVmdFromMemory(file.GetData(), file.GetSize())) {
+        DMME_LOG_ERROR("MotionClip: failed to load '{}'", path);
+        return false;
+    }
+    std::vector<uint8_t> baked;
+    SaveBaked(baked);
+    cache.Store(key, baked.data(), baked.size());
+    return true;
+}
+
+bool MotionClip::LoadVmdFromMemory(const uint8_t* data, size_t size) {
+    Clear();
+
+    size_t offset = 0;
+    const auto remaining = [&]() { return size - offset; };
+
+    if (!data || size < kVmdSignatureBytes) {
+        DMME_LOG_ERROR("MotionClip: not a VMD file");
+        return false;
+    }
+    size_t modelNameBytes = 0;
+    if (std::memcmp(data, kVmdSignature2, sizeof(kVmdSignature2) - 1) == 0) {
+        modelNameBytes = 20;
+    } else if (std::memcmp(data, kVmdSignature1, sizeof(kVmdSignature1) - 1) == 0) {
+        modelNameBytes = 10;
+    } else {
+        DMME_LOG_ERROR("MotionClip: not a VMD file");
+        return false;
+    }
+    offset = kVmdSignatureBytes + modelNameBytes;
+
+    // --- Bone keys ---
+    if (size < offset + 4) {
+        DMME_LOG_ERROR("MotionClip: truncated VMD header");
+        return false;
+    }
+    const uint32_t boneKeyCount = ReadValue<uint32_t>(data + offset);
+    offset += 4;
+    if (boneKeyCount > remaining() / kVmdBoneKeyBytes) {
+        DMME_LOG_ERROR("MotionClip: truncated bone keys ({} declared)", boneKeyCount);
+        return false;
+    }
+
+    std::vector<VmdBoneKey> boneKeys(boneKeyCount);
+    for (VmdBoneKey& key : boneKeys) {
+        const uint8_t* p = data + offset;
+        key.name  = ReadName(p);
+        key.frame = ReadValue<uint32_t>(p + 15);
+        std::memcpy(key.translation, p + 19, sizeof(key.translation));
+        std::memcpy(key.rotation, p + 31, sizeof(key.rotation));
+
+        // 64 interpolation bytes; the first 16 hold x1 of X/Y/Z/R,
+        // then y1, x2 and y2 (the other rows are copies)
+        const uint8_t* curves = p + 47;
+        for (uint32_t channel = 0; channel < kCurveChannels; ++channel) {
+            for (uint32_t point = 0; point < 4; ++point) {
+                key.interpolation[channel][point] = curves[point * 4 + channel];
+            }
+        }
+        offset += kVmdBoneKeyBytes;
+    }
+
+    // --- Morph keys (absent in some camera-only exports) ---
+    std::vector<VmdMorphKey> morphKeys;
+    if (remaining() >= 4) {
+        const uint32_t morphKeyCount = ReadValue<uint32_t>(data + offset);
+        offset += 4;
+        if (morphKeyCount > remaining() / kVmdMorphKeyBytes) {
+            DMME_LOG_ERROR("MotionClip: truncated morph keys ({} declared)", morphKeyCount);
+            return false;
+        }
+        morphKeys.resize(morphKeyCount);
+        for (VmdMorphKey& key : morphKeys) {
+            const uint8_t* p = data + offset;
+            key.name   = ReadName(p);
+            key.frame  = ReadValue<uint32_t>(p + 15);
+            key.weight = ReadValue<float>(p + 19);
+            offset += kVmdMorphKeyBytes;
+        }
+    }
+
+    Build(boneKeys, morphKeys);
+    return true;
+}
+
+// ===================================================================
+// Build
+// ===================================================================
+
+void MotionClip::Build(const std::vector<VmdBoneKey>& boneKeys,
+                       const std::vector<VmdMorphKey>& morphKeys) {
+    Clear();
+
+    // --- Curves: linear first, then one entry per distinct shape ---
+    std::unordered_map<uint32_t, uint32_t> curveLookup;
+    m_curves.emplace_back();
+    BakeBezierCurve(0.25f, 0.25f, 0.75f, 0.75f, m_curves.back());
+    const auto internCurve = [&](const uint8_t* cp) -> uint32_t {
+        const uint8_t x1 = std::min<uint8_t>(cp[0], 127);
+        const uint8_t y1 = std::min<uint8_t>(cp[1], 127);
+        const uint8_t x2 = std::min<uint8_t>(cp[2], 127);
+        const uint8_t y2 = std::min<uint8_t>(cp[3], 127);
+        if (x1 == y1 && x2 == y2) {
+            return kLinearCurve;
+        }
+        const uint32_t packed = x1 | (y1 << 8) | (x2 << 16) | (static_cast<uint32_t>(y2) << 24);
+        auto it = curveLookup.find(packed);
+        if (it != curveLookup.end()) {
+            return it->second;
+        }
+        const uint32_t index = GetCurveCount();
+        m_curves.emplace_back();
+        BakeBezierCurve(x1 / 127.0f, y1 / 127.0f, x2 / 127.0f, y2 / 127.0f, m_curves.back());
+        curveLookup.emplace(packed, index);
+        return index;
+    };
+
+    // --- Bone tracks ---
+    std::vector<std::string> names;
+    std::vector<std::vector<uint32_t>> trackKeys;
+    GroupKeys(boneKeys, names, trackKeys);
+
+    size_t totalKeys = 0;
+    for (const auto& indices : trackKeys) {
+        totalKeys += indices.size();
+    }
+    m_boneTracks.resize(names.size());
+    m_boneFrames.reserve(totalKeys);
+    m_translations.reserve(totalKeys * 3);
+    m_rotations.reserve(totalKeys * 4);
+    m_boneCurves.reserve(totalKeys * kCurveChannels);
+
+    for (size_t t = 0; t < names.size(); ++t) {
+        Track& track   = m_boneTracks[t];
+        track.name     = std::move(names[t]);
+        track.firstKey = static_cast<uint32_t>(m_boneFrames.size());
+        track.keyCount = static_cast<uint32_t>(trackKeys[t].size());
+
+        for (uint32_t k : trackKeys[t]) {
+            const VmdBoneKey& key = boneKeys[k];
+            m_boneFrames.push_back(static_cast<float>(key.frame));
+            m_translations.insert(m_translations.end(), key.translation, key.translation + 3);
+
+            const float* q = key.rotation;
+            const float lengthSq = q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3];
+            if (lengthSq > 1e-12f) {
+                const float inv = 1.0f / std::sqrt(lengthSq);
+                m_rotations.insert(m_rotations.end(), {q[0] * inv, q[1] * inv, q[2] * inv, q[3] * inv});
+            } else {
+                m_rotations.insert(m_rotations.end(), {0.0f, 0.0f, 0.0f, 1.0f});
+            }
+
+            for (uint32_t channel = 0; channel < kCurveChannels; ++channel) {
+                m_boneCurves.push_back(internCurve(key.interpolation[channel]));
+            }
+            m_duration = std::max(m_duration, static_cast<float>(key.frame));
+        }
+    }
+
+    // --- Morph tracks ---
+    names.clear();
+    trackKeys.clear();
+    GroupKeys(morphKeys, names, trackKeys);
+
+    m_morphTracks.resize(names.size());
+    for (size_t t = 0; t < names.size(); ++t) {
+        Track& track   = m_morphTracks[t];
+        track.name     = std::move(names[t]);
+        track.firstKey = static_cast<uint32_t>(m_morphFrames.size());
+        track.keyCount = static_cast<uint32_t>(trackKeys[t].size());
+
+        for (uint32_t k : trackKeys[t]) {
+            m_morphFrames.push_back(static_cast<float>(morphKeys[k].frame));
+            m_morphWeights.push_back(morphKeys[k].weight);
+            m_duration = std::max(m_duration, static_cast<float>(morphKeys[k].frame));
+        }
+    }
+
+    UpdateMemory();
+}
+
+// ===================================================================
+// Baked form
+// ===================================================================
+
+void MotionClip::SaveBaked(std::vector<uint8_t>& out) const {
+    out.clear();
+    const uint32_t counts[5] = {GetBoneTrackCount(), GetMorphTrackCount(), GetBoneKeyCount(),
+                                GetMorphKeyCount(), GetCurveCount()};
+    AppendArray(out, counts, 5);
+    AppendArray(out, &m_duration, 1);
+
+    for (const std::vector<Track>* tracks : {&m_boneTracks, &m_morphTracks}) {
+        for (const Track& track : *tracks) {
+            const uint32_t fields[3] = {track.firstKey, track.keyCount,
+                                        static_cast<uint32_t>(track.name.size())};
+            AppendArray(out, fields, 3);
+            AppendArray(out, track.name.data(), track.name.size());
+        }
+    }
+
+    AppendArray(out, m_boneFrames.data(), m_boneFrames.size());
+    AppendArray(out, m_translations.data(), m_translations.size());
+    AppendArray(out, m_rotations.data(), m_rotations.size());
+    AppendArray(out, m_boneCurves.data(), m_boneCurves.size());
+    AppendArray(out, m_morphFrames.data(), m_morphFrames.size());
+    AppendArray(out, m_morphWeights.data(), m_morphWeights.size());
+    AppendArray(out, m_curves.data(), m_curves.size());
+}
+
+bool MotionClip::LoadBaked(const uint8_t* data, size_t size) {
+    Clear();
+    BakedReader reader{data, data + size};
+
+    uint32_t counts[5] = {};
+    bool ok = reader.Read(counts, 5) && reader.Read(&m_duration, 1);
+    const uint32_t boneKeys  = counts[2];
+    const uint32_t morphKeys = counts[3];
+
+    std::vector<Track>* trackLists[2] = {&m_boneTracks, &m_morphTracks};
+    const uint32_t keyCounts[2] = {boneKeys, morphKeys};
+    for (int list = 0; list < 2 && ok; ++list) {
+        // A track takes at least its 12-byte record
+        if (counts[list] > size / 12) {
+            ok = false;
+            break;
+        }
+        trackLists[list]->resize(counts[list]);
+        for (Track& track : *trackLists[list]) {
+            uint32_t fields[3] = {};
+            // Samplers read a track's first key unchecked: every track
+            // has at least one
+            ok = reader.Read(fields, 3) && fields[2] <= size && fields[1] > 0 &&
+                 fields[0] < keyCounts[list] && fields[1] <= keyCounts[list] - fields[0];
+            if (!ok) {
+                break;
+            }
+            track.firstKey = fields[0];
+            track.keyCount = fields[1];
+            track.name.resize(fields[2]);
+            ok = reader.Read(&track.name[0], fields[2]);
+            if (!ok) {
+                break;
+            }
+        }
+    }
+
+    ok = ok && reader.ReadVector(m_boneFrames, boneKeys) &&
+         reader.ReadVector(m_translations, static_cast<size_t>(boneKeys) * 3) &&
+         reader.ReadVector(m_rotations, static_cast<size_t>(boneKeys) * 4) &&
+         reader.ReadVector(m_boneCurves, static_cast<size_t>(boneKeys) * kCurveChannels) &&
+         reader.ReadVector(m_morphFrames, morphKeys) &&
+         reader.ReadVector(m_morphWeights, morphKeys) &&
+         reader.ReadVector(m_curves, counts[4]) && reader.p == reader.end;
+
+    // Samplers index curves unchecked, and EvaluateCurve steps up from
+    // start[bin]: starts must be sample indices and must not decrease
+    for (size_t i = 0; ok && i < m_boneCurves.size(); ++i) {
+        ok = m_boneCurves[i] < counts[4];
+    }
+    for (size_t c = 0; ok && c < m_curves.size(); ++c) {
+        const uint8_t* start = m_curves[c].start;
+        for (uint32_t bin = 0; ok && bin < kCurveSamples; ++bin) {
+            ok = start[bin] < kCurveSamples && (bin == 0 || start[bin] >= start[bin - 1]);
+        }
+    }
+
+    if (!ok) {
+        DMME_LOG_ERROR("MotionClip: malformed baked clip ({} bytes)", size);
+        Clear();
+        return false;
+    }
+    UpdateMemory();
+    return true;
+}
+
+void MotionClip::Clear() {
+    m_boneTracks.clear();
+    m_morphTracks.clear();
+    m_duration = 0.0f;
+    m_boneFrames.clear();
+    m_translations.clear();
+    m_rotations.clear();
+    m_boneCurves.clear();
+    m_morphFrames.clear();
+    m_morphWeights.clear();
+    m_curves.clear();
+    m_memory.Reset();
+}
+
+// ===================================================================
+// Queries
+// ===================================================================
+
+int32_t MotionClip::FindBoneTrack(std::string_view name) const {
+    for (size_t i = 0; i < m_boneTracks.size(); ++i) {
+        if (m_boneTracks[i].name == name) {
+            return static_cast<int32_t>(i);
+        }
+    }
+    return -1;
+}
+
+int32_t MotionClip::FindMorphTrack(std::string_view name) const {
+    for (size_t i = 0; i < m_morphTracks.size(); ++i) {
+        if (m_morphTracks[i].name == name) {
+            return static_cast<int32_t>(i);
+        }
+    }
+    return -1;
+}
+
+size_t MotionClip::GetMemoryBytes() const {
+    return (m_boneTracks.capacity() + m_morphTracks.capacity()) * sizeof(Track) +
+           (m_boneFrames.capacity() + m_translations.capacity() + m_rotations.capacity() +
+            m_morphFrames.capacity() + m_morphWeights.capacity()) * sizeof(float) +
+           m_boneCurves.capacity() * sizeof(uint32_t) + m_curves.capacity() * sizeof(BakedCurve);
+}
+
+void MotionClip::UpdateMemory() {
+    m_memory.Set(GetMemoryBytes());
+}
+
+} // namespace animation
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,199 @@
+#pragma once
+
+#include "core/memory/MemoryAccountant.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dmme {
+namespace core {
+
+namespace assets {
+class DerivedDataCache;
+}
+
+namespace animation {
+
+// ------------------------------------------------------------------
+// Source keyframes (VMD records)
+// ------------------------------------------------------------------
+
+// VMD motions are authored at 30 frames per second; clip time is in
+// frames throughout.
+constexpr float kVmdFramesPerSecond = 30.0f;
+
+// Bezier control points per channel, 0 - 127: [X, Y, Z, Rotation]
+// x [x1, y1, x2, y2]. A key's curve shapes the segment that ends on it.
+using VmdInterpolation = uint8_t[4][4];
+
+struct VmdBoneKey {
+    std::string      name;              // raw bytes (Shift-JIS in .vmd files)
+    uint32_t         frame          = 0;
+    float            translation[3] = {};
+    float            rotation[4]    = {0.0f, 0.0f, 0.0f, 1.0f};   // xyzw
+    VmdInterpolation interpolation  = {{20, 20, 107, 107}, {20, 20, 107, 107},
+                                       {20, 20, 107, 107}, {20, 20, 107, 107}};
+};
+
+struct VmdMorphKey {
+    std::string name;
+    uint32_t    frame  = 0;
+    float       weight = 0.0f;
+};
+
+// ------------------------------------------------------------------
+// Curves
+// ------------------------------------------------------------------
+
+// Baked curves store the Bezier at kCurveSamples + 1 evenly spaced
+// parameter values, which keeps the steep parts of MMD's ease curves
+// (where y changes fastest in x) densely sampled; evaluating at x
+// finds the bracketing samples through a per-bin start index and
+// lerps. 64 samples keep the error of any 0 - 127 curve below 1e-2
+// (below 1e-3 for typical ones).
+constexpr uint32_t kCurveSamples = 64;
+
+struct BakedCurve {
+    float   x[kCurveSamples + 1];   // x(t), t = i / kCurveSamples
+    float   y[kCurveSamples + 1];
+    uint8_t start[kCurveSamples];   // last sample with x <= bin / kCurveSamples
+};
+
+// Curve 0 is linear; curves with identical control points share one
+// table entry.
+constexpr uint32_t kLinearCurve = 0;
+
+// Bake the cubic Bezier (0,0) (x1,y1) (x2,y2) (1,1); control points
+// in [0, 1].
+void BakeBezierCurve(float x1, float y1, float x2, float y2, BakedCurve& out);
+
+// y at x in [0, 1]
+inline float EvaluateCurve(const BakedCurve& curve, float x) {
+    const uint32_t bin = static_cast<uint32_t>(x * kCurveSamples);
+    uint32_t i = curve.start[bin < kCurveSamples ? bin : kCurveSamples - 1];
+    while (i + 1 < kCurveSamples && curve.x[i + 1] <= x) {
+        ++i;
+    }
+    const float width = curve.x[i + 1] - curve.x[i];
+    const float f     = width > 0.0f ? (x - curve.x[i]) / width : 0.0f;
+    return curve.y[i] + (curve.y[i + 1] - curve.y[i]) * f;
+}
+
+// Channels of a bone key's curve set
+enum MotionCurveChannel : uint32_t {
+    kCurveX        = 0,
+    kCurveY        = 1,
+    kCurveZ        = 2,
+    kCurveRotation = 3,
+    kCurveChannels = 4
+};
+
+// ------------------------------------------------------------------
+// MotionClip
+// ------------------------------------------------------------------
+
+// MotionClip holds one motion's keyframes in sampling order.
+//
+// Keys of all tracks live in shared structure-of-arrays tables, each
+// track owning a contiguous, frame-sorted range, so finding the
+// segment around a time only ever touches the frame array. Bezier
+// curves are baked into lookup tables when the clip is built, so a
+// sample costs a table lookup instead of a per-sample Bezier solve.
+//
+// Clips are immutable once built and can be shared by any number of
+// MotionSampler cursors (see MotionSampler.h). Track names are kept
+// as stored in the file; VMD files use Shift-JIS, so binding to a
+// skeleton compares raw bytes.
+//
+// Usage:
+//   MotionClip clip;
+//   if (clip.LoadVmd("dance.vmd")) {
+//       int32_t head = clip.FindBoneTrack(headName);
+//   }
+
+class MotionClip {
+public:
+    MotionClip() = default;
+    ~MotionClip() = default;
+
+    MotionClip(const MotionClip&) = delete;
+    MotionClip& operator=(const MotionClip&) = delete;
+
+    // Parse a .vmd file (bone and morph keys; camera, light and IK
+    // records are skipped). Returns false and logs on failure.
+    bool LoadVmd(const std::string& path);
+    bool LoadVmdFromMemory(const uint8_t* data, size_t size);
+
+    // LoadVmd through the derived-data cache: a warm start copies the
+    // baked tables out of the mapped cache entry instead of parsing the
+    // file and baking its curves; a cold one parses and stores them.
+    bool LoadVmdCached(const std::string& path, assets::DerivedDataCache& cache);
+
+    // The built clip as one flat blob (track table, key tables, baked
+    // curves) and back. LoadBaked validates sizes and indices and
+    // returns false on a malformed blob.
+    void SaveBaked(std::vector<uint8_t>& out) const;
+    bool LoadBaked(const uint8_t* data, size_t size);
+
+    // Build from keys in any order. Keys repeating a track's frame
+    // replace the earlier one.
+    void Build(const std::vector<VmdBoneKey>& boneKeys,
+               const std::vector<VmdMorphKey>& morphKeys);
+
+    void Clear();
+
+    // --- Tracks ---
+    uint32_t GetBoneTrackCount() const  { return static_cast<uint32_t>(m_boneTracks.size()); }
+    uint32_t GetMorphTrackCount() const { return static_cast<uint32_t>(m_morphTracks.size()); }
+    std::string_view GetBoneTrackName(uint32_t track) const  { return m_boneTracks[track].name; }
+    std::string_view GetMorphTrackName(uint32_t track) const { return m_morphTracks[track].name; }
+
+    // -1 if the clip has no such track
+    int32_t FindBoneTrack(std::string_view name) const;
+    int32_t FindMorphTrack(std::string_view name) const;
+
+    // Last keyed frame over all tracks
+    float GetDuration() const { return m_duration; }
+
+    uint32_t GetBoneKeyCount() const  { return static_cast<uint32_t>(m_boneFrames.size()); }
+    uint32_t GetMorphKeyCount() const { return static_cast<uint32_t>(m_morphFrames.size()); }
+    uint32_t GetCurveCount() const    { return static_cast<uint32_t>(m_curves.size()); }
+    size_t   GetMemoryBytes() const;
+
+private:
+    friend class MotionSampler;
+
+    struct Track {
+        std::string name;
+        uint32_t    firstKey = 0;
+        uint32_t    keyCount = 0;
+    };
+
+    void UpdateMemory();
+
+    std::vector<Track> m_boneTracks;
+    std::vector<Track> m_morphTracks;
+    float              m_duration = 0.0f;
+
+    // --- Bone keys (SoA, indexed by key) ---
+    std::vector<float>    m_boneFrames;
+    std::vector<float>    m_translations;   // xyz per key
+    std::vector<float>    m_rotations;      // xyzw per key, unit length
+    std::vector<uint32_t> m_boneCurves;     // kCurveChannels curve indices per key
+
+    // --- Morph keys ---
+    std::vector<float>    m_morphFrames;
+    std::vector<float>    m_morphWeights;
+
+    // --- Baked curves ---
+    std::vector<BakedCurve> m_curves;
+
+    memory::TrackedMemory m_memory{memory::MemoryCategory::Asset};
+};
+
+} // namespace animation
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,348 @@
+#include "MotionSampler.h"
+#include "utils/Simd.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace dmme {
+namespace core {
+namespace animation {
+
+namespace {
+
+inline uint32_t PadToLanes(uint32_t count) {
+    return (count + 3u) & ~3u;
+}
+
+// Corrected nlerp parameter: remaps t so that a normalized lerp
+// between unit quaternions with |dot| = d follows slerp's angle to
+// ~1e-3 rad (polynomial fit, no trig).
+inline float SlerpCorrection(float t, float d) {
+    const float a = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+    const float b = 0.848013f + d * (-1.06021f + d * 0.215638f);
+    const float h = t - 0.5f;
+    const float k = a * h * h + b;
+    return t + t * h * (t - 1.0f) * k;
+}
+
+#if defined(DMME_SIMD_SSE2)
+inline __m128 Lerp4(__m128 a, __m128 b, __m128 t) {
+    return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t));
+}
+
+inline __m128 SlerpCorrection4(__m128 t, __m128 d) {
+    __m128 a = _mm_sub_ps(_mm_set1_ps(3.55645f), _mm_mul_ps(d, _mm_set1_ps(1.43519f)));
+    a = _mm_add_ps(_mm_set1_ps(-3.2452f), _mm_mul_ps(d, a));
+    a = _mm_add_ps(_mm_set1_ps(1.0904f), _mm_mul_ps(d, a));
+    __m128 b = _mm_add_ps(_mm_set1_ps(-1.06021f), _mm_mul_ps(d, _mm_set1_ps(0.215638f)));
+    b = _mm_add_ps(_mm_set1_ps(0.848013f), _mm_mul_ps(d, b));
+    const __m128 h = _mm_sub_ps(t, _mm_set1_ps(0.5f));
+    const __m128 k = _mm_add_ps(_mm_mul_ps(a, _mm_mul_ps(h, h)), b);
+    const __m128 w = _mm_mul_ps(_mm_mul_ps(t, h), _mm_sub_ps(t, _mm_set1_ps(1.0f)));
+    return _mm_add_ps(t, _mm_mul_ps(w, k));
+}
+
+inline __m128 InvLength4(__m128 x, __m128 y, __m128 z, __m128 w) {
+    const __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)),
+                                       _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w)));
+    return _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lengthSq));
+}
+#endif
+
+} // anonymous namespace
+
+// ===================================================================
+// MotionPose
+// ===================================================================
+
+void MotionPose::Resize(uint32_t bones, uint32_t morphs) {
+    boneCount  = bones;
+    morphCount = morphs;
+    const size_t paddedBones  = PadToLanes(bones);
+    const size_t paddedMorphs = PadToLanes(morphs);
+    for (auto* v : {&tx, &ty, &tz, &qx, &qy, &qz, &qw}) {
+        v->resize(paddedBones);
+    }
+    morphWeights.resize(paddedMorphs);
+    SetIdentity();
+}
+
+void MotionPose::SetIdentity() {
+    for (auto* v : {&tx, &ty, &tz, &qx, &qy, &qz, &morphWeights}) {
+        std::fill(v->begin(), v->end(), 0.0f);
+    }
+    std::fill(qw.begin(), qw.end(), 1.0f);
+}
+
+void BlendPose(MotionPose& pose, const MotionPose& layer, float weight) {
+    if (pose.boneCount != layer.boneCount || pose.morphCount != layer.morphCount) {
+        return;
+    }
+    if (weight <= 0.0f) {
+        return;
+    }
+    if (weight >= 1.0f) {
+        pose = layer;       // same sizes: copies without allocating
+        return;
+    }
+
+    const uint32_t paddedBones = PadToLanes(pose.boneCount);
+    uint32_t i = 0;
+
+#if defined(DMME_SIMD_SSE2)
+    const __m128 w     = _mm_set1_ps(weight);
+    const __m128 zero  = _mm_setzero_ps();
+    const __m128 sign  = _mm_set1_ps(-0.0f);
+    for (; i < paddedBones; i += 4) {
+        _mm_storeu_ps(&pose.tx[i], Lerp4(_mm_loadu_ps(&pose.tx[i]), _mm_loadu_ps(&layer.tx[i]), w));
+        _mm_storeu_ps(&pose.ty[i], Lerp4(_mm_loadu_ps(&pose.ty[i]), _mm_loadu_ps(&layer.ty[i]), w));
+        _mm_storeu_ps(&pose.tz[i], Lerp4(_mm_loadu_ps(&pose.tz[i]), _mm_loadu_ps(&layer.tz[i]), w));
+
+        const __m128 ax = _mm_loadu_ps(&pose.qx[i]);
+        const __m128 ay = _mm_loadu_ps(&pose.qy[i]);
+        const __m128 az = _mm_loadu_ps(&pose.qz[i]);
+        const __m128 aw = _mm_loadu_ps(&pose.qw[i]);
+        __m128 bx = _mm_loadu_ps(&layer.qx[i]);
+        __m128 by = _mm_loadu_ps(&layer.qy[i]);
+        __m128 bz = _mm_loadu_ps(&layer.qz[i]);
+        __m128 bw = _mm_loadu_ps(&layer.qw[i]);
+
+        // Shortest arc: flip the layer's sign where the dot is negative
+        const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)),
+                                      _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+        const __m128 flip = _mm_and_ps(_mm_cmplt_ps(dot, zero), sign);
+        bx = _mm_xor_ps(bx, flip);
+        by = _mm_xor_ps(by, flip);
+        bz = _mm_xor_ps(bz, flip);
+        bw = _mm_xor_ps(bw, flip);
+
+        const __m128 t  = SlerpCorrection4(w, _mm_andnot_ps(sign, dot));
+        const __m128 x  = Lerp4(ax, bx, t);
+        const __m128 y  = Lerp4(ay, by, t);
+        const __m128 z  = Lerp4(az, bz, t);
+        const __m128 qw = Lerp4(aw, bw, t);
+        const __m128 inv = InvLength4(x, y, z, qw);
+        _mm_storeu_ps(&pose.qx[i], _mm_mul_ps(x, inv));
+        _mm_storeu_ps(&pose.qy[i], _mm_mul_ps(y, inv));
+        _mm_storeu_ps(&pose.qz[i], _mm_mul_ps(z, inv));
+        _mm_storeu_ps(&pose.qw[i], _mm_mul_ps(qw, inv));
+    }
+#endif
+
+    for (; i < paddedBones; ++i) {
+        pose.tx[i] += (layer.tx[i] - pose.tx[i]) * weight;
+        pose.ty[i] += (layer.ty[i] - pose.ty[i]) * weight;
+        pose.tz[i] += (layer.tz[i] - pose.tz[i]) * weight;
+
+        float bx = layer.qx[i], by = layer.qy[i], bz = layer.qz[i], bw = layer.qw[i];
+        float dot = pose.qx[i] * bx + pose.qy[i] * by + pose.qz[i] * bz + pose.qw[i] * bw;
+        if (dot < 0.0f) {
+            bx = -bx; by = -by; bz = -bz; bw = -bw;
+            dot = -dot;
+        }
+        const float t = SlerpCorrection(weight, dot);
+        const float x = pose.qx[i] + (bx - pose.qx[i]) * t;
+        const float y = pose.qy[i] + (by - pose.qy[i]) * t;
+        const float z = pose.qz[i] + (bz - pose.qz[i]) * t;
+        const float qw = pose.qw[i] + (bw - pose.qw[i]) * t;
+        const float inv = 1.0f / std::sqrt(x * x + y * y + z * z + qw * qw);
+        pose.qx[i] = x * inv;
+        pose.qy[i] = y * inv;
+        pose.qz[i] = z * inv;
+        pose.qw[i] = qw * inv;
+    }
+
+    for (uint32_t m = 0; m < pose.morphCount; ++m) {
+        pose.morphWeights[m] += (layer.morphWeights[m] - pose.morphWeights[m]) * weight;
+    }
+}
+
+// ===================================================================
+// Binding
+// ===================================================================
+
+void MotionSampler::Bind(const MotionClip* clip) {
+    m_clip = clip;
+    m_cursorHits = 0;
+    m_seeks      = 0;
+
+    const uint32_t bones  = clip ? clip->GetBoneTrackCount() : 0;
+    const uint32_t morphs = clip ? clip->GetMorphTrackCount() : 0;
+    m_boneCursors.assign(bones, 0);
+    m_morphCursors.assign(morphs, 0);
+
+    // Padding lanes stay at identity and are never written
+    const size_t padded = PadToLanes(bones);
+    for (auto& v : m_s)  v.assign(padded, 0.0f);
+    for (auto& v : m_t0) v.assign(padded, 0.0f);
+    for (auto& v : m_t1) v.assign(padded, 0.0f);
+    for (uint32_t c = 0; c < 4; ++c) {
+        m_q0[c].assign(padded, c == 3 ? 1.0f : 0.0f);
+        m_q1[c].assign(padded, c == 3 ? 1.0f : 0.0f);
+    }
+}
+
+// ===================================================================
+// Sampling
+// ===================================================================
+
+// Key (offset within the track) starting the segment that contains
+// frame: frames[k] <= frame < frames[k + 1], clamped to the track.
+uint32_t MotionSampler::Locate(const float* frames, uint32_t first, uint32_t count,
+                               uint32_t& cursor, float frame) {
+    const float*   f = frames + first;
+    const uint32_t c = cursor;
+
+    if (f[c] <= frame) {
+        if (c + 1 >= count || frame < f[c + 1]) {
+            ++m_cursorHits;
+            return c;
+        }
+        if (c + 2 >= count || frame < f[c + 2]) {
+            ++m_cursorHits;
+            cursor = c + 1;
+            return cursor;
+        }
+    } else if (c == 0) {
+        ++m_cursorHits;     // before the first key
+        return 0;
+    }
+
+    ++m_seeks;
+    const uint32_t upper = static_cast<uint32_t>(std::upper_bound(f, f + count, frame) - f);
+    cursor = upper > 0 ? upper - 1 : 0;
+    return cursor;
+}
+
+void MotionSampler::Sample(float frame, MotionPose& pose) {
+    if (!m_clip || pose.boneCount != m_clip->GetBoneTrackCount() ||
+        pose.morphCount != m_clip->GetMorphTrackCount()) {
+        return;
+    }
+    SampleBones(frame, pose);
+    SampleMorphs(frame, pose);
+}
+
+void MotionSampler::SampleBones(float frame, MotionPose& pose) {
+    const MotionClip& clip = *m_clip;
+    const float*    frames = clip.m_boneFrames.data();
+    const float*    trans  = clip.m_translations.data();
+    const float*    rots   = clip.m_rotations.data();
+    const uint32_t* curves = clip.m_boneCurves.data();
+    const BakedCurve* tables = clip.m_curves.data();
+    const uint32_t  count  = clip.GetBoneTrackCount();
+
+    // --- Gather: cursors, curve lookups and the two keys per bone ---
+    for (uint32_t b = 0; b < count; ++b) {
+        const MotionClip::Track& track = clip.m_boneTracks[b];
+        const uint32_t k0 = track.firstKey +
+                            Locate(frames, track.firstKey, track.keyCount, m_boneCursors[b], frame);
+        const bool     hold = k0 + 1 >= track.firstKey + track.keyCount || frame <= frames[k0];
+        const uint32_t k1   = hold ? k0 : k0 + 1;
+
+        if (hold) {
+            for (uint32_t c = 0; c < kCurveChannels; ++c) m_s[c][b] = 0.0f;
+        } else {
+            const float x = (frame - frames[k0]) / (frames[k1] - frames[k0]);
+            const uint32_t* keyCurves = curves + static_cast<size_t>(k1) * kCurveChannels;
+            for (uint32_t c = 0; c < kCurveChannels; ++c) {
+                m_s[c][b] = keyCurves[c] == kLinearCurve ? x : EvaluateCurve(tables[keyCurves[c]], x);
+            }
+        }
+
+        for (uint32_t c = 0; c < 3; ++c) {
+            m_t0[c][b] = trans[static_cast<size_t>(k0) * 3 + c];
+            m_t1[c][b] = trans[static_cast<size_t>(k1) * 3 + c];
+        }
+
+        // Shortest arc: keys on opposite hemispheres are flipped here,
+        // so the batch pass sees dot >= 0
+        const float* q0 = rots + static_cast<size_t>(k0) * 4;
+        const float* q1 = rots + static_cast<size_t>(k1) * 4;
+        const float  sign = (q0[0] * q1[0] + q0[1] * q1[1] + q0[2] * q1[2] + q0[3] * q1[3]) < 0.0f
+                          ? -1.0f : 1.0f;
+        for (uint32_t c = 0; c < 4; ++c) {
+            m_q0[c][b] = q0[c];
+            m_q1[c][b] = q1[c] * sign;
+        }
+    }
+
+    // --- Interpolate ---
+    const uint32_t padded = PadToLanes(count);
+    uint32_t b = 0;
+
+#if defined(DMME_SIMD_SSE2)
+    for (; b < padded; b += 4) {
+        _mm_storeu_ps(&pose.tx[b], Lerp4(_mm_loadu_ps(&m_t0[0][b]), _mm_loadu_ps(&m_t1[0][b]),
+                                         _mm_loadu_ps(&m_s[kCurveX][b])));
+        _mm_storeu_ps(&pose.ty[b], Lerp4(_mm_loadu_ps(&m_t0[1][b]), _mm_loadu_ps(&m_t1[1][b]),
+                                         _mm_loadu_ps(&m_s[kCurveY][b])));
+        _mm_storeu_ps(&pose.tz[b], Lerp4(_mm_loadu_ps(&m_t0[2][b]), _mm_loadu_ps(&m_t1[2][b]),
+                                         _mm_loadu_ps(&m_s[kCurveZ][b])));
+
+        const __m128 ax = _mm_loadu_ps(&m_q0[0][b]);
+        const __m128 ay = _mm_loadu_ps(&m_q0[1][b]);
+        const __m128 az = _mm_loadu_ps(&m_q0[2][b]);
+        const __m128 aw = _mm_loadu_ps(&m_q0[3][b]);
+        const __m128 bx = _mm_loadu_ps(&m_q1[0][b]);
+        const __m128 by = _mm_loadu_ps(&m_q1[1][b]);
+        const __m128 bz = _mm_loadu_ps(&m_q1[2][b]);
+        const __m128 bw = _mm_loadu_ps(&m_q1[3][b]);
+        const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)),
+                                      _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+
+        const __m128 t  = SlerpCorrection4(_mm_loadu_ps(&m_s[kCurveRotation][b]), dot);
+        const __m128 x  = Lerp4(ax, bx, t);
+        const __m128 y  = Lerp4(ay, by, t);
+        const __m128 z  = Lerp4(az, bz, t);
+        const __m128 w  = Lerp4(aw, bw, t);
+        const __m128 inv = InvLength4(x, y, z, w);
+        _mm_storeu_ps(&pose.qx[b], _mm_mul_ps(x, inv));
+        _mm_storeu_ps(&pose.qy[b], _mm_mul_ps(y, inv));
+        _mm_storeu_ps(&pose.qz[b], _mm_mul_ps(z, inv));
+        _mm_storeu_ps(&pose.qw[b], _mm_mul_ps(w, inv));
+    }
+#endif
+
+    for (; b < padded; ++b) {
+        pose.tx[b] = m_t0[0][b] + (m_t1[0][b] - m_t0[0][b]) * m_s[kCurveX][b];
+        pose.ty[b] = m_t0[1][b] + (m_t1[1][b] - m_t0[1][b]) * m_s[kCurveY][b];
+        pose.tz[b] = m_t0[2][b] + (m_t1[2][b] - m_t0[2][b]) * m_s[kCurveZ][b];
+
+        const float dot = m_q0[0][b] * m_q1[0][b] + m_q0[1][b] * m_q1[1][b] +
+                          m_q0[2][b] * m_q1[2][b] + m_q0[3][b] * m_q1[3][b];
+        const float t = SlerpCorrection(m_s[kCurveRotation][b], dot);
+        float q[4];
+        for (uint32_t c = 0; c < 4; ++c) {
+            q[c] = m_q0[c][b] + (m_q1[c][b] - m_q0[c][b]) * t;
+        }
+        const float inv = 1.0f / std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+        pose.qx[b] = q[0] * inv;
+        pose.qy[b] = q[1] * inv;
+        pose.qz[b] = q[2] * inv;
+        pose.qw[b] = q[3] * inv;
+    }
+}
+
+void MotionSampler::SampleMorphs(float frame, MotionPose& pose) {
+    const MotionClip& clip = *m_clip;
+    const float* frames  = clip.m_morphFrames.data();
+    const float* weights = clip.m_morphWeights.data();
+
+    // VMD morph keys interpolate linearly
+    for (uint32_t m = 0; m < clip.GetMorphTrackCount(); ++m) {
+        const MotionClip::Track& track = clip.m_morphTracks[m];
+        const uint32_t k0 = track.firstKey +
+                            Locate(frames, track.firstKey, track.keyCount, m_morphCursors[m], frame);
+        if (k0 + 1 >= track.firstKey + track.keyCount || frame <= frames[k0]) {
+            pose.morphWeights[m] = weights[k0];
+        } else {
+            const float x = (frame - frames[k0]) / (frames[k0 + 1] - frames[k0]);
+            pose.morphWeights[m] = weights[k0] + (weights[k0 + 1] - weights[k0]) * x;
+        }
+    }
+}
+
+} // namespace animation
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "MotionClip.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace dmme {
+namespace core {
+namespace animation {
+
+// ------------------------------------------------------------------
+// Pose
+// ------------------------------------------------------------------
+
+// Sampled local transforms, one entry per bone track, plus one weight
+// per morph track (SoA). Arrays are padded to a multiple of four so
+// SIMD loops run whole lanes; padding lanes hold the identity.
+struct MotionPose {
+    uint32_t boneCount  = 0;
+    uint32_t morphCount = 0;
+
+    std::vector<float> tx, ty, tz;          // translation
+    std::vector<float> qx, qy, qz, qw;      // rotation, unit quaternion
+    std::vector<float> morphWeights;
+
+    // Size for a clip (or a skeleton) and reset to the identity
+    void Resize(uint32_t bones, uint32_t morphs);
+    void SetIdentity();
+};
+
+// Blend layer into pose: translations and morph weights lerp, rotations
+// take the shortest-arc normalized lerp. weight 0 keeps pose, 1 takes
+// layer. Blending several clips is a chain of calls, each weight
+// relative to what has been accumulated so far. Both poses must have
+// the same counts.
+void BlendPose(MotionPose& pose, const MotionPose& layer, float weight);
+
+// ------------------------------------------------------------------
+// MotionSampler
+// ------------------------------------------------------------------
+
+// MotionSampler evaluates one playback of a MotionClip.
+//
+// It keeps a cursor (current key) per track. Playback moves forward a
+// frame or so per call, so the cursor is almost always still valid or
+// one key behind, and locating the segment is O(1); only a seek (a
+// jump, a loop or reverse playback) falls back to a binary search for
+// the tracks it invalidates.
+//
+// Sampling runs in two passes over all bones: a scalar pass advances
+// the cursors, reads the baked curves and gathers the two keys of
+// every bone into SoA scratch, then a batch pass interpolates four
+// bones at a time (SSE2; scalar elsewhere). Rotations use a corrected
+// normalized lerp (polynomial, within ~1e-3 rad of slerp), so both paths
+// give the same result.
+//
+// Not thread-safe; Sample does not allocate once Bind has sized the
+// scratch for the clip.
+//
+// Usage:
+//   MotionSampler sampler;
+//   sampler.Bind(&clip);
+//   MotionPose pose;
+//   pose.Resize(clip.GetBoneTrackCount(), clip.GetMorphTrackCount());
+//   // each frame:
+//   sampler.Sample(seconds * kVmdFramesPerSecond, pose);
+
+class MotionSampler {
+public:
+    MotionSampler() = default;
+    ~MotionSampler() = default;
+
+    MotionSampler(const MotionSampler&) = delete;
+    MotionSampler& operator=(const MotionSampler&) = delete;
+
+    // Attach to a clip (must outlive the sampler or the next Bind)
+    // and reset the cursors.
+    void Bind(const MotionClip* clip);
+    const MotionClip* GetClip() const { return m_clip; }
+
+    // Evaluate every track at frame (clamped to the clip's keys) into
+    // pose, which must be sized for the clip.
+    void Sample(float frame, MotionPose& pose);
+
+    // --- Stats (since Bind) ---
+    uint64_t GetCursorHits() const { return m_cursorHits; }   // O(1) lookups
+    uint64_t GetSeeks() const      { return m_seeks; }        // binary searches
+
+private:
+    uint32_t Locate(const float* frames, uint32_t first, uint32_t count,
+                    uint32_t& cursor, float frame);
+    void SampleBones(float frame, MotionPose& pose);
+    void SampleMorphs(float frame, MotionPose& pose);
+
+    const MotionClip*     m_clip = nullptr;
+    std::vector<uint32_t> m_boneCursors;    // key offset within the track
+    std::vector<uint32_t> m_morphCursors;
+
+    // Per-bone gather scratch (SoA, padded to four)
+    std::vector<float> m_s[kCurveChannels];    // curve-shaped fractions
+    std::vector<float> m_t0[3], m_t1[3];       // translations
+    std::vector<float> m_q0[4], m_q1[4];       // rotations
+
+    uint64_t m_cursorHits = 0;
+    uint64_t m_seeks      = 0;
+};
+
+} // namespace animation
+} // namespace core
+} // namespace dmme
\ No newline at end of file
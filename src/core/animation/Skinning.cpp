@@ -0,0 +1,331 @@
+#include "Skinning.h"
+#include "core/jobs/JobSystem.h"
+#include "utils/Logger.h"
+#include "utils/Simd.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace dmme {
+namespace core {
+namespace animation {
+
+namespace {
+
+// Rotation matrix columns of a unit quaternion
+void QuaternionColumns(const float q[4], float c0[3], float c1[3], float c2[3]) {
+    const float x = q[0], y = q[1], z = q[2], w = q[3];
+    c0[0] = 1.0f - 2.0f * (y * y + z * z);
+    c0[1] = 2.0f * (x * y + z * w);
+    c0[2] = 2.0f * (x * z - y * w);
+    c1[0] = 2.0f * (x * y - z * w);
+    c1[1] = 1.0f - 2.0f * (x * x + z * z);
+    c1[2] = 2.0f * (y * z + x * w);
+    c2[0] = 2.0f * (x * z + y * w);
+    c2[1] = 2.0f * (y * z - x * w);
+    c2[2] = 1.0f - 2.0f * (x * x + y * y);
+}
+
+inline void TransformPoint(const SkinningPalette::BoneMatrix& m, const float p[3], float out[3]) {
+    for (int i = 0; i < 3; ++i) {
+        out[i] = m.c0[i] * p[0] + m.c1[i] * p[1] + m.c2[i] * p[2] + m.c3[i];
+    }
+}
+
+inline void StoreNormal(float x, float y, float z, float out[4]) {
+    const float lengthSq = x * x + y * y + z * z;
+    const float inv = lengthSq > 1e-20f ? 1.0f / std::sqrt(lengthSq) : 0.0f;
+    out[0] = x * inv;
+    out[1] = y * inv;
+    out[2] = z * inv;
+    out[3] = 0.0f;
+}
+
+// Spherical deform (SDEF): rotate about C by the blend of the two
+// bones' rotations, and translate by the blend of the two bones'
+// motion of the R0 / R1 corrected centre points.
+void SkinSdefVertex(const SkinningPalette& palette, const assets::PmxVertexTable& t,
+                    uint32_t v, SkinnedVertex& out) {
+    const uint32_t b0 = static_cast<uint32_t>(t.boneIndices[v * 4]);
+    const uint32_t b1 = static_cast<uint32_t>(t.boneIndices[v * 4 + 1]);
+    const float    w0 = t.boneWeights[v * 4];
+    const float    w1 = 1.0f - w0;
+    const float*   c  = t.sdefC + v * 3;
+    const float*   r0 = t.sdefR0 + v * 3;
+    const float*   r1 = t.sdefR1 + v * 3;
+
+    // Rotation blend (shortest-arc nlerp)
+    const float* q0 = palette.GetRotation(b0);
+    const float* q1 = palette.GetRotation(b1);
+    const float  sign = (q0[0] * q1[0] + q0[1] * q1[1] + q0[2] * q1[2] + q0[3] * q1[3]) < 0.0f
+                      ? -1.0f : 1.0f;
+    float q[4];
+    for (int i = 0; i < 4; ++i) {
+        q[i] = q0[i] * w0 + q1[i] * sign * w1;
+    }
+    const float qLength = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for (float& f : q) {
+        f /= qLength;
+    }
+    float rc0[3], rc1[3], rc2[3];
+    QuaternionColumns(q, rc0, rc1, rc2);
+
+    // Corrected centres
+    float cr0[3], cr1[3];
+    for (int i = 0; i < 3; ++i) {
+        const float rw = r0[i] * w0 + r1[i] * w1;
+        cr0[i] = (c[i] + (c[i] + r0[i] - rw)) * 0.5f;
+        cr1[i] = (c[i] + (c[i] + r1[i] - rw)) * 0.5f;
+    }
+    float m0[3], m1[3];
+    TransformPoint(palette.GetMatrix(b0), cr0, m0);
+    TransformPoint(palette.GetMatrix(b1), cr1, m1);
+
+    const float* p = t.positions + v * 3;
+    const float* n = t.normals + v * 3;
+    const float  d[3] = {p[0] - c[0], p[1] - c[1], p[2] - c[2]};
+    for (int i = 0; i < 3; ++i) {
+        out.position[i] = rc0[i] * d[0] + rc1[i] * d[1] + rc2[i] * d[2] + m0[i] * w0 + m1[i] * w1;
+    }
+    out.position[3] = 1.0f;
+    StoreNormal(rc0[0] * n[0] + rc1[0] * n[1] + rc2[0] * n[2],
+                rc0[1] * n[0] + rc1[1] * n[1] + rc2[1] * n[2],
+                rc0[2] * n[0] + rc1[2] * n[1] + rc2[2] * n[2], out.normal);
+}
+
+// Linear blend of N influences
+template <uint32_t N>
+inline void SkinLinearVertex(const SkinningPalette::BoneMatrix* matrices, const float* p,
+                             const float* n, const uint16_t* bones, const float* weights,
+                             SkinnedVertex& out) {
+#if defined(DMME_SIMD_SSE2)
+    const SkinningPalette::BoneMatrix& m = matrices[bones[0]];
+    __m128 w  = _mm_set1_ps(weights[0]);
+    __m128 c0 = _mm_mul_ps(_mm_load_ps(m.c0), w);
+    __m128 c1 = _mm_mul_ps(_mm_load_ps(m.c1), w);
+    __m128 c2 = _mm_mul_ps(_mm_load_ps(m.c2), w);
+    __m128 c3 = _mm_mul_ps(_mm_load_ps(m.c3), w);
+    for (uint32_t k = 1; k < N; ++k) {
+        const SkinningPalette::BoneMatrix& mk = matrices[bones[k]];
+        w  = _mm_set1_ps(weights[k]);
+        c0 = _mm_add_ps(c0, _mm_mul_ps(_mm_load_ps(mk.c0), w));
+        c1 = _mm_add_ps(c1, _mm_mul_ps(_mm_load_ps(mk.c1), w));
+        c2 = _mm_add_ps(c2, _mm_mul_ps(_mm_load_ps(mk.c2), w));
+        c3 = _mm_add_ps(c3, _mm_mul_ps(_mm_load_ps(mk.c3), w));
+    }
+
+    const __m128 position = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(p[0])), _mm_mul_ps(c1, _mm_set1_ps(p[1]))),
+        _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(p[2])), c3));
+    const __m128 normal = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(n[0])), _mm_mul_ps(c1, _mm_set1_ps(n[1]))),
+        _mm_mul_ps(c2, _mm_set1_ps(n[2])));
+
+    // |normal|^2 in every lane (w is 0)
+    __m128 sq = _mm_mul_ps(normal, normal);
+    sq = _mm_add_ps(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2, 3, 0, 1)));
+    sq = _mm_add_ps(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(1, 0, 3, 2)));
+    const __m128 nonZero = _mm_cmpgt_ps(sq, _mm_set1_ps(1e-20f));
+    const __m128 inv = _mm_and_ps(nonZero, _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(sq)));
+
+    _mm_storeu_ps(out.position, position);
+    _mm_storeu_ps(out.normal, _mm_mul_ps(normal, inv));
+#else
+    float c[4][4] = {};
+    for (uint32_t k = 0; k < N; ++k) {
+        const SkinningPalette::BoneMatrix& mk = matrices[bones[k]];
+        const float w = weights[k];
+        for (int i = 0; i < 4; ++i) {
+            c[0][i] += mk.c0[i] * w;
+            c[1][i] += mk.c1[i] * w;
+            c[2][i] += mk.c2[i] * w;
+            c[3][i] += mk.c3[i] * w;
+        }
+    }
+    for (int i = 0; i < 4; ++i) {
+        out.position[i] = c[0][i] * p[0] + c[1][i] * p[1] + c[2][i] * p[2] + c[3][i];
+    }
+    StoreNormal(c[0][0] * n[0] + c[1][0] * n[1] + c[2][0] * n[2],
+                c[0][1] * n[0] + c[1][1] * n[1] + c[2][1] * n[2],
+                c[0][2] * n[0] + c[1][2] * n[1] + c[2][2] * n[2], out.normal);
+#endif
+}
+
+} // anonymous namespace
+
+// ===================================================================
+// SkinningPalette
+// ===================================================================
+
+void SkinningPalette::Resize(uint32_t boneCount) {
+    m_matrices.resize(boneCount);
+    m_rotations.resize(static_cast<size_t>(boneCount) * 4);
+    SetIdentity();
+}
+
+void SkinningPalette::SetIdentity() {
+    for (BoneMatrix& m : m_matrices) {
+        m = BoneMatrix{{1.0f, 0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f, 0.0f},
+                       {0.0f, 0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 0.0f, 1.0f}};
+    }
+    for (size_t i = 0; i < m_rotations.size(); ++i) {
+        m_rotations[i] = (i % 4 == 3) ? 1.0f : 0.0f;
+    }
+}
+
+void SkinningPalette::SetBone(uint32_t bone, const float rotation[4], const float position[3],
+                              const float restPosition[3]) {
+    BoneMatrix& m = m_matrices[bone];
+    QuaternionColumns(rotation, m.c0, m.c1, m.c2);
+    m.c0[3] = m.c1[3] = m.c2[3] = 0.0f;
+
+    // x' = R (x - rest) + position
+    for (int i = 0; i < 3; ++i) {
+        m.c3[i] = position[i] - (m.c0[i] * restPosition[0] + m.c1[i] * restPosition[1] +
+                                 m.c2[i] * restPosition[2]);
+    }
+    m.c3[3] = 1.0f;
+
+    std::copy(rotation, rotation + 4, &m_rotations[static_cast<size_t>(bone) * 4]);
+}
+
+// ===================================================================
+// Skinner
+// ===================================================================
+
+bool Skinner::Init(const assets::PmxVertexTable& vertices, uint32_t boneCount) {
+    Reset();
+    if (boneCount > 0x10000u) {
+        DMME_LOG_ERROR("Skinner: {} bones exceed the 16-bit bone index", boneCount);
+        return false;
+    }
+
+    const uint32_t count = vertices.count;
+    m_influences.resize(count);
+    m_blocks.assign((count + kBlockVertices - 1) / kBlockVertices, 1);
+
+    for (uint32_t v = 0; v < count; ++v) {
+        const int32_t* bones   = vertices.boneIndices + static_cast<size_t>(v) * 4;
+        const float*   weights = vertices.boneWeights + static_cast<size_t>(v) * 4;
+
+        // Heaviest first, so a block's influence count covers every
+        // non-zero weight
+        uint32_t order[4] = {0, 1, 2, 3};
+        std::sort(order, order + 4, [&](uint32_t a, uint32_t b) { return weights[a] > weights[b]; });
+
+        float total = 0.0f;
+        uint32_t used = 0;
+        Influences& inf = m_influences[v];
+        for (uint32_t k = 0; k < 4; ++k) {
+            const uint32_t src = order[k];
+            if (bones[src] < 0 || static_cast<uint32_t>(bones[src]) >= boneCount) {
+                DMME_LOG_ERROR("Skinner: vertex {} references bone {} of {}", v, bones[src], boneCount);
+                Reset();
+                return false;
+            }
+            inf.bone[k]   = static_cast<uint16_t>(bones[src]);
+            inf.weight[k] = std::max(weights[src], 0.0f);
+            total += inf.weight[k];
+            if (inf.weight[k] > 0.0f) {
+                used = k + 1;
+            }
+        }
+        if (total > 0.0f) {
+            for (float& w : inf.weight) w /= total;
+        } else {
+            inf.weight[0] = 1.0f;       // unweighted: follow the first bone
+            used = 1;
+        }
+
+        uint8_t& block = m_blocks[v / kBlockVertices];
+        const uint8_t influences = used <= 1 ? 1 : (used == 2 ? 2 : 4);
+        block = static_cast<uint8_t>((block & kBlockHasSdef) |
+                                     std::max<uint8_t>(block & ~kBlockHasSdef, influences));
+
+        if (vertices.sdefC &&
+            vertices.weightTypes[v] == static_cast<uint8_t>(assets::PmxWeightType::SDEF)) {
+            block |= kBlockHasSdef;
+            ++m_sdefCount;
+        }
+    }
+
+    m_vertices  = vertices;
+    m_boneCount = boneCount;
+    return true;
+}
+
+void Skinner::Reset() {
+    m_vertices  = {};
+    m_boneCount = 0;
+    m_sdefCount = 0;
+    m_influences.clear();
+    m_blocks.clear();
+}
+
+uint32_t Skinner::GetBlockedVertexCount(uint32_t influences) const {
+    uint32_t total = 0;
+    for (size_t b = 0; b < m_blocks.size(); ++b) {
+        if ((m_blocks[b] & ~kBlockHasSdef) == influences) {
+            total += std::min<uint32_t>(kBlockVertices, m_vertices.count - static_cast<uint32_t>(b) * kBlockVertices);
+        }
+    }
+    return total;
+}
+
+void Skinner::Skin(const SkinningPalette& palette, SkinnedVertex* out,
+                   jobs::JobSystem* jobs) const {
+    if (!out || m_vertices.count == 0 || palette.GetBoneCount() < m_boneCount) {
+        return;
+    }
+
+    const uint32_t chunks = (m_vertices.count + kChunkVertices - 1) / kChunkVertices;
+    const auto skinChunk = [&](uint32_t chunk) {
+        const uint32_t first = chunk * kChunkVertices;
+        SkinRange(palette, out, first, std::min(kChunkVertices, m_vertices.count - first));
+    };
+
+    if (jobs && chunks > 1) {
+        jobs->ParallelFor(chunks, skinChunk);
+    } else {
+        for (uint32_t chunk = 0; chunk < chunks; ++chunk) {
+            skinChunk(chunk);
+        }
+    }
+}
+
+// first is a multiple of kBlockVertices (chunks are)
+void Skinner::SkinRange(const SkinningPalette& palette, SkinnedVertex* out,
+                        uint32_t first, uint32_t count) const {
+    const SkinningPalette::BoneMatrix* matrices = &palette.GetMatrix(0);
+    const float* positions = m_vertices.positions;
+    const float* normals   = m_vertices.normals;
+
+    for (uint32_t blockStart = first; blockStart < first + count; blockStart += kBlockVertices) {
+        const uint32_t blockEnd = std::min(blockStart + kBlockVertices, first + count);
+        const uint8_t  block    = m_blocks[blockStart / kBlockVertices];
+        const uint32_t influences = block & ~kBlockHasSdef;
+
+        for (uint32_t v = blockStart; v < blockEnd; ++v) {
+            const Influences& inf = m_influences[v];
+            const float* p = positions + static_cast<size_t>(v) * 3;
+            const float* n = normals + static_cast<size_t>(v) * 3;
+            switch (influences) {
+                case 1:  SkinLinearVertex<1>(matrices, p, n, inf.bone, inf.weight, out[v]); break;
+                case 2:  SkinLinearVertex<2>(matrices, p, n, inf.bone, inf.weight, out[v]); break;
+                default: SkinLinearVertex<4>(matrices, p, n, inf.bone, inf.weight, out[v]); break;
+            }
+        }
+
+        if (block & kBlockHasSdef) {
+            for (uint32_t v = blockStart; v < blockEnd; ++v) {
+                if (m_vertices.weightTypes[v] == static_cast<uint8_t>(assets::PmxWeightType::SDEF)) {
+                    SkinSdefVertex(palette, m_vertices, v, out[v]);
+                }
+            }
+        }
+    }
+}
+
+} // namespace animation
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,482 @@
+#include "SpringBones.h"
+#include "utils/Clock.h"
+#include "utils/Logger.h"
+#include "utils/Simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace dmme {
+namespace core {
+namespace animation {
+
+namespace {
+
+constexpr float kEpsilonSq     = 1e-12f;
+constexpr float kAverageWeight = 0.1f;      // EMA of the solve time
+constexpr uint32_t kBudgetCooldown = 8;     // Updates between iteration changes
+
+#if defined(DMME_SIMD_SSE2)
+inline __m128 Lerp4(__m128 a, __m128 b, __m128 t) {
+    return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t));
+}
+
+inline __m128 Select4(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+#endif
+
+} // namespace
+
+// ============================================================================
+// Setup
+// ============================================================================
+
+uint32_t SpringBoneSolver::AddChain(const SpringChainDesc& desc) {
+    if (desc.jointCount < 2 || desc.jointCount > kSpringMaxJoints || !desc.restPositions) {
+        DMME_LOG_ERROR("SpringBoneSolver: chain needs 2 - {} joints and rest positions ({} given)",
+                       kSpringMaxJoints, desc.jointCount);
+        return UINT32_MAX;
+    }
+
+    // Only the last group is open, so its rows are at the end of the
+    // arrays and can grow in place.
+    if (m_groups.empty() || m_groups.back().chains == 4) {
+        Group group;
+        group.offset = static_cast<uint32_t>(m_mask.size() / 4);
+        m_groups.push_back(group);
+    }
+    Group& group = m_groups.back();
+    Grow(group, desc.jointCount);
+
+    Chain chain;
+    chain.group      = static_cast<uint32_t>(m_groups.size() - 1);
+    chain.lane       = group.chains++;
+    chain.jointCount = desc.jointCount;
+
+    const uint32_t lane = chain.lane;
+    group.stiffness[lane] = std::clamp(desc.stiffness, 0.0f, 1.0f);
+    group.keep[lane]      = 1.0f - std::clamp(desc.damping, 0.0f, 1.0f);
+    group.radius[lane]    = std::max(desc.radius, 0.0f);
+    for (int c = 0; c < 3; ++c) {
+        group.gravity[c][lane] = desc.gravity[c];
+    }
+
+    for (uint32_t j = 0; j < desc.jointCount; ++j) {
+        const size_t i = Index(chain, j);
+        const float* p = desc.restPositions + j * 3;
+        for (int c = 0; c < 3; ++c) {
+            m_x[c][i] = m_prev[c][i] = m_target[c][i] = m_lastTarget[c][i] = p[c];
+        }
+        m_mask[i] = 1.0f;
+        if (j > 0) {
+            const float dx = p[0] - p[-3];
+            const float dy = p[1] - p[-2];
+            const float dz = p[2] - p[-1];
+            m_restLength[i] = std::sqrt(dx * dx + dy * dy + dz * dz);
+        }
+    }
+
+    m_chains.push_back(chain);
+    m_stats.chains = static_cast<uint32_t>(m_chains.size());
+    m_stats.joints += desc.jointCount;
+    return static_cast<uint32_t>(m_chains.size() - 1);
+}
+
+void SpringBoneSolver::Grow(Group& group, uint32_t depth) {
+    if (depth <= group.depth) {
+        return;
+    }
+    group.depth = depth;
+    const size_t size = (static_cast<size_t>(group.offset) + depth) * 4;
+    for (int c = 0; c < 3; ++c) {
+        m_x[c].resize(size, 0.0f);
+        m_prev[c].resize(size, 0.0f);
+        m_target[c].resize(size, 0.0f);
+        m_lastTarget[c].resize(size, 0.0f);
+    }
+    m_restLength.resize(size, 0.0f);
+    m_mask.resize(size, 0.0f);
+}
+
+uint32_t SpringBoneSolver::AddSphere(float radius) {
+    Collider collider;
+    collider.radius = std::max(radius, 0.0f);
+    m_colliders.push_back(collider);
+    m_stats.colliders = static_cast<uint32_t>(m_colliders.size());
+    return static_cast<uint32_t>(m_colliders.size() - 1);
+}
+
+uint32_t SpringBoneSolver::AddCapsule(float radius) {
+    return AddSphere(radius);
+}
+
+void SpringBoneSolver::SetSphere(uint32_t collider, const float center[3]) {
+    SetCapsule(collider, center, center);
+}
+
+void SpringBoneSolver::SetCapsule(uint32_t collider, const float a[3], const float b[3]) {
+    if (collider >= m_colliders.size()) {
+        return;
+    }
+    Collider& c = m_colliders[collider];
+    for (int i = 0; i < 3; ++i) {
+        c.a[i] = a[i];
+        c.b[i] = b[i];
+    }
+}
+
+void SpringBoneSolver::Clear() {
+    m_chains.clear();
+    m_groups.clear();
+    m_colliders.clear();
+    for (int c = 0; c < 3; ++c) {
+        m_x[c].clear();
+        m_prev[c].clear();
+        m_target[c].clear();
+        m_lastTarget[c].clear();
+    }
+    m_restLength.clear();
+    m_mask.clear();
+    m_accumulator = 0.0f;
+    m_stats = SpringStats();
+}
+
+void SpringBoneSolver::SetSubstep(float seconds) {
+    m_substep = std::max(seconds, 1.0f / 1000.0f);
+    m_accumulator = 0.0f;
+}
+
+void SpringBoneSolver::SetBudget(const SpringBudget& budget) {
+    m_budget = budget;
+    m_budget.minIterations = std::max(m_budget.minIterations, 1u);
+    m_budget.maxIterations = std::max(m_budget.maxIterations, m_budget.minIterations);
+    m_iterations     = MaxIterations();
+    m_budgetCooldown = 0;
+}
+
+void SpringBoneSolver::SetDetail(AnimationDetail detail) {
+    if (detail == m_detail) {
+        return;
+    }
+    // Coming back from Minimal the joints start where the pose left them
+    if (m_detail == AnimationDetail::Minimal) {
+        ResetToTargets();
+    }
+    m_detail         = detail;
+    m_iterations     = MaxIterations();
+    m_budgetCooldown = 0;
+    m_stats.iterations = m_detail == AnimationDetail::Minimal ? 0 : m_iterations;
+}
+
+uint32_t SpringBoneSolver::MaxIterations() const {
+    if (m_detail == AnimationDetail::Full) {
+        return m_budget.maxIterations;
+    }
+    return std::max(m_budget.maxIterations / 2, m_budget.minIterations);
+}
+
+// ============================================================================
+// Per frame
+// ============================================================================
+
+void SpringBoneSolver::SetTargets(uint32_t chain, const float* positions) {
+    if (chain >= m_chains.size()) {
+        return;
+    }
+    const Chain& c = m_chains[chain];
+    for (uint32_t j = 0; j < c.jointCount; ++j) {
+        const size_t i = Index(c, j);
+        for (int k = 0; k < 3; ++k) {
+            m_target[k][i] = positions[j * 3 + k];
+        }
+    }
+}
+
+void SpringBoneSolver::ResetToTargets() {
+    for (int c = 0; c < 3; ++c) {
+        m_x[c]          = m_target[c];
+        m_prev[c]       = m_target[c];
+        m_lastTarget[c] = m_target[c];
+    }
+    m_accumulator = 0.0f;
+}
+
+void SpringBoneSolver::Update(float deltaSeconds) {
+    m_stats.substeps = 0;
+    if (deltaSeconds <= 0.0f || m_chains.empty()) {
+        return;
+    }
+
+    if (m_detail == AnimationDetail::Minimal) {
+        ResetToTargets();
+        m_stats.iterations = 0;
+        return;
+    }
+
+    const uint64_t start = utils::MonotonicMicros();
+
+    m_accumulator += deltaSeconds;
+    uint32_t steps = static_cast<uint32_t>(m_accumulator / m_substep);
+    if (steps > kMaxSubsteps) {
+        m_stats.droppedSteps += steps - kMaxSubsteps;
+        m_accumulator -= static_cast<float>(steps - kMaxSubsteps) * m_substep;
+        steps = kMaxSubsteps;
+    }
+
+    // Substep k ends (m_accumulator - k * substep) before the end of the
+    // frame; the targets are lerped to that point between last frame's
+    // pose and this one's.
+    float targetFrom = 0.0f;
+    for (uint32_t k = 1; k <= steps; ++k) {
+        const float remaining = m_accumulator - static_cast<float>(k) * m_substep;
+        const float targetTo  = std::clamp(1.0f - remaining / deltaSeconds, 0.0f, 1.0f);
+        Step(targetFrom, targetTo, m_substep);
+        targetFrom = targetTo;
+    }
+    m_accumulator -= static_cast<float>(steps) * m_substep;
+    m_accumulator = std::max(m_accumulator, 0.0f);
+
+    for (int c = 0; c < 3; ++c) {
+        m_lastTarget[c] = m_target[c];
+    }
+
+    m_stats.substeps = steps;
+    UpdateBudget(utils::MicrosToMs(utils::MonotonicMicros() - start));
+}
+
+void SpringBoneSolver::UpdateBudget(float solveMs) {
+    m_stats.solveMs   = solveMs;
+    m_stats.averageMs = m_stats.averageMs + (solveMs - m_stats.averageMs) * kAverageWeight;
+
+    if (m_budget.budgetMs > 0.0f) {
+        if (m_budgetCooldown > 0) {
+            --m_budgetCooldown;
+        } else if (m_stats.averageMs > m_budget.budgetMs && m_iterations > m_budget.minIterations) {
+            --m_iterations;
+            m_budgetCooldown = kBudgetCooldown;
+        } else if (m_stats.averageMs < m_budget.budgetMs * 0.5f && m_iterations < MaxIterations()) {
+            ++m_iterations;
+            m_budgetCooldown = kBudgetCooldown;
+        }
+    }
+    m_stats.iterations = m_iterations;
+}
+
+void SpringBoneSolver::GetJoint(uint32_t chain, uint32_t joint, float out[3]) const {
+    const Chain& c = m_chains[chain];
+    const size_t i = Index(c, std::min(joint, c.jointCount - 1));
+    const float alpha = std::clamp(m_accumulator / m_substep, 0.0f, 1.0f);
+    for (int k = 0; k < 3; ++k) {
+        out[k] = m_prev[k][i] + (m_x[k][i] - m_prev[k][i]) * alpha;
+    }
+}
+
+// ============================================================================
+// Solver
+// ============================================================================
+
+void SpringBoneSolver::Step(float targetFrom, float targetTo, float substep) {
+    const float substepSq = substep * substep;
+    for (const Group& group : m_groups) {
+        StepGroup(group, targetFrom, targetTo, substepSq);
+    }
+}
+
+void SpringBoneSolver::StepGroup(const Group& group, float targetFrom, float targetTo, float substepSq) {
+    float* x[3]  = {m_x[0].data(), m_x[1].data(), m_x[2].data()};
+    float* p[3]  = {m_prev[0].data(), m_prev[1].data(), m_prev[2].data()};
+    const float* t1[3] = {m_target[0].data(), m_target[1].data(), m_target[2].data()};
+    const float* t0[3] = {m_lastTarget[0].data(), m_lastTarget[1].data(), m_lastTarget[2].data()};
+    const float* rest = m_restLength.data();
+    const float* mask = m_mask.data();
+
+    const size_t first = static_cast<size_t>(group.offset) * 4;
+    const size_t end   = first + static_cast<size_t>(group.depth) * 4;
+
+#if defined(DMME_SIMD_SSE2)
+    const __m128 zero  = _mm_setzero_ps();
+    const __m128 from  = _mm_set1_ps(targetFrom);
+    const __m128 to    = _mm_set1_ps(targetTo);
+    const __m128 stiff = _mm_loadu_ps(group.stiffness);
+    const __m128 keep  = _mm_loadu_ps(group.keep);
+    const __m128 gravity[3] = {
+        _mm_mul_ps(_mm_loadu_ps(group.gravity[0]), _mm_set1_ps(substepSq)),
+        _mm_mul_ps(_mm_loadu_ps(group.gravity[1]), _mm_set1_ps(substepSq)),
+        _mm_mul_ps(_mm_loadu_ps(group.gravity[2]), _mm_set1_ps(substepSq)),
+    };
+
+    // Roots follow the animation
+    for (int c = 0; c < 3; ++c) {
+        const __m128 a = _mm_loadu_ps(t0[c] + first);
+        const __m128 b = _mm_loadu_ps(t1[c] + first);
+        const __m128 last = Lerp4(a, b, from);
+        _mm_storeu_ps(p[c] + first, last);
+        _mm_storeu_ps(x[c] + first, Lerp4(a, b, to));
+    }
+
+    // Verlet: inertia with damping, pull towards the animated pose, gravity
+    for (size_t i = first + 4; i < end; i += 4) {
+        const __m128 live = _mm_loadu_ps(mask + i);
+        for (int c = 0; c < 3; ++c) {
+            const __m128 cur    = _mm_loadu_ps(x[c] + i);
+            const __m128 prev   = _mm_loadu_ps(p[c] + i);
+            const __m128 target = Lerp4(_mm_loadu_ps(t0[c] + i), _mm_loadu_ps(t1[c] + i), to);
+            __m128 next = _mm_add_ps(cur, _mm_mul_ps(_mm_sub_ps(cur, prev), keep));
+            next = _mm_add_ps(next, _mm_mul_ps(_mm_sub_ps(target, cur), stiff));
+            next = _mm_add_ps(next, gravity[c]);
+            _mm_storeu_ps(p[c] + i, cur);
+            _mm_storeu_ps(x[c] + i, Lerp4(cur, next, live));
+        }
+    }
+
+    // Constraints, root outwards: each joint goes back to its rest
+    // distance from its (already solved) parent, then out of colliders
+    const __m128 epsilon = _mm_set1_ps(kEpsilonSq);
+    for (uint32_t iteration = 0; iteration < m_iterations; ++iteration) {
+        for (size_t i = first + 4; i < end; i += 4) {
+            const __m128 dx = _mm_sub_ps(_mm_loadu_ps(x[0] + i), _mm_loadu_ps(x[0] + i - 4));
+            const __m128 dy = _mm_sub_ps(_mm_loadu_ps(x[1] + i), _mm_loadu_ps(x[1] + i - 4));
+            const __m128 dz = _mm_sub_ps(_mm_loadu_ps(x[2] + i), _mm_loadu_ps(x[2] + i - 4));
+            const __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)),
+                                               _mm_mul_ps(dz, dz));
+            const __m128 ok = _mm_and_ps(_mm_cmpgt_ps(lengthSq, epsilon),
+                                         _mm_cmpgt_ps(_mm_loadu_ps(mask + i), zero));
+            const __m128 scale = _mm_div_ps(_mm_loadu_ps(rest + i),
+                                            _mm_sqrt_ps(_mm_max_ps(lengthSq, epsilon)));
+            const __m128 d[3] = {dx, dy, dz};
+            for (int c = 0; c < 3; ++c) {
+                const __m128 parent = _mm_loadu_ps(x[c] + i - 4);
+                const __m128 solved = _mm_add_ps(parent, _mm_mul_ps(d[c], scale));
+                _mm_storeu_ps(x[c] + i, Select4(ok, solved, _mm_loadu_ps(x[c] + i)));
+            }
+            Collide(group, static_cast<uint32_t>(i / 4));
+        }
+    }
+#else
+    // Roots follow the animation
+    for (size_t i = first; i < first + 4; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            p[c][i] = t0[c][i] + (t1[c][i] - t0[c][i]) * targetFrom;
+            x[c][i] = t0[c][i] + (t1[c][i] - t0[c][i]) * targetTo;
+        }
+    }
+
+    // Verlet: inertia with damping, pull towards the animated pose, gravity
+    for (size_t i = first + 4; i < end; ++i) {
+        const uint32_t lane = static_cast<uint32_t>(i & 3);
+        if (mask[i] == 0.0f) {
+            continue;
+        }
+        for (int c = 0; c < 3; ++c) {
+            const float cur    = x[c][i];
+            const float target = t0[c][i] + (t1[c][i] - t0[c][i]) * targetTo;
+            const float next   = cur + (cur - p[c][i]) * group.keep[lane]
+                               + (target - cur) * group.stiffness[lane]
+                               + group.gravity[c][lane] * substepSq;
+            p[c][i] = cur;
+            x[c][i] = next;
+        }
+    }
+
+    // Constraints, root outwards: each joint goes back to its rest
+    // distance from its (already solved) parent, then out of colliders
+    for (uint32_t iteration = 0; iteration < m_iterations; ++iteration) {
+        for (size_t i = first + 4; i < end; ++i) {
+            if (mask[i] != 0.0f) {
+                const float dx = x[0][i] - x[0][i - 4];
+                const float dy = x[1][i] - x[1][i - 4];
+                const float dz = x[2][i] - x[2][i - 4];
+                const float lengthSq = dx * dx + dy * dy + dz * dz;
+                if (lengthSq > kEpsilonSq) {
+                    const float scale = rest[i] / std::sqrt(lengthSq);
+                    x[0][i] = x[0][i - 4] + dx * scale;
+                    x[1][i] = x[1][i - 4] + dy * scale;
+                    x[2][i] = x[2][i - 4] + dz * scale;
+                }
+            }
+            if ((i & 3) == 3) {
+                Collide(group, static_cast<uint32_t>(i / 4));
+            }
+        }
+    }
+#endif
+}
+
+// Push the four joints of one row out of every collider: the closest
+// point on the capsule's segment (a sphere's is its centre) must be at
+// least the collider radius plus the joint radius away.
+void SpringBoneSolver::Collide(const Group& group, uint32_t row) {
+    const size_t i = static_cast<size_t>(row) * 4;
+    float* x = m_x[0].data() + i;
+    float* y = m_x[1].data() + i;
+    float* z = m_x[2].data() + i;
+    const float* mask = m_mask.data() + i;
+
+    for (const Collider& collider : m_colliders) {
+        const float ab[3] = {collider.b[0] - collider.a[0],
+                             collider.b[1] - collider.a[1],
+                             collider.b[2] - collider.a[2]};
+        const float abSq = ab[0] * ab[0] + ab[1] * ab[1] + ab[2] * ab[2];
+        const float invAbSq = abSq > kEpsilonSq ? 1.0f / abSq : 0.0f;
+
+#if defined(DMME_SIMD_SSE2)
+        const __m128 px = _mm_loadu_ps(x);
+        const __m128 py = _mm_loadu_ps(y);
+        const __m128 pz = _mm_loadu_ps(z);
+        const __m128 rx = _mm_sub_ps(px, _mm_set1_ps(collider.a[0]));
+        const __m128 ry = _mm_sub_ps(py, _mm_set1_ps(collider.a[1]));
+        const __m128 rz = _mm_sub_ps(pz, _mm_set1_ps(collider.a[2]));
+        __m128 t = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, _mm_set1_ps(ab[0])),
+                                         _mm_mul_ps(ry, _mm_set1_ps(ab[1]))),
+                              _mm_mul_ps(rz, _mm_set1_ps(ab[2])));
+        t = _mm_min_ps(_mm_max_ps(_mm_mul_ps(t, _mm_set1_ps(invAbSq)), _mm_setzero_ps()),
+                       _mm_set1_ps(1.0f));
+        const __m128 dx = _mm_sub_ps(rx, _mm_mul_ps(t, _mm_set1_ps(ab[0])));
+        const __m128 dy = _mm_sub_ps(ry, _mm_mul_ps(t, _mm_set1_ps(ab[1])));
+        const __m128 dz = _mm_sub_ps(rz, _mm_mul_ps(t, _mm_set1_ps(ab[2])));
+        const __m128 distSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)),
+                                         _mm_mul_ps(dz, dz));
+        const __m128 minDist = _mm_add_ps(_mm_loadu_ps(group.radius), _mm_set1_ps(collider.radius));
+        const __m128 hit = _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(distSq, _mm_mul_ps(minDist, minDist)),
+                                                 _mm_cmpgt_ps(distSq, _mm_set1_ps(kEpsilonSq))),
+                                      _mm_cmpgt_ps(_mm_loadu_ps(mask), _mm_setzero_ps()));
+        if (_mm_movemask_ps(hit) == 0) {
+            continue;
+        }
+        // Push along the offset from the closest point: p + d * (minDist / |d|)
+        const __m128 scale = _mm_sub_ps(_mm_div_ps(minDist, _mm_sqrt_ps(_mm_max_ps(distSq,
+                                                   _mm_set1_ps(kEpsilonSq)))), _mm_set1_ps(1.0f));
+        _mm_storeu_ps(x, Select4(hit, _mm_add_ps(px, _mm_mul_ps(dx, scale)), px));
+        _mm_storeu_ps(y, Select4(hit, _mm_add_ps(py, _mm_mul_ps(dy, scale)), py));
+        _mm_storeu_ps(z, Select4(hit, _mm_add_ps(pz, _mm_mul_ps(dz, scale)), pz));
+#else
+        for (uint32_t lane = 0; lane < 4; ++lane) {
+            if (mask[lane] == 0.0f) {
+                continue;
+            }
+            const float rx = x[lane] - collider.a[0];
+            const float ry = y[lane] - collider.a[1];
+            const float rz = z[lane] - collider.a[2];
+            const float t = std::clamp((rx * ab[0] + ry * ab[1] + rz * ab[2]) * invAbSq, 0.0f, 1.0f);
+            const float dx = rx - t * ab[0];
+            const float dy = ry - t * ab[1];
+            const float dz = rz - t * ab[2];
+            const float distSq  = dx * dx + dy * dy + dz * dz;
+            const float minDist = group.radius[lane] + collider.radius;
+            if (distSq < minDist * minDist && distSq > kEpsilonSq) {
+                // Push along the offset from the closest point: p + d * (minDist / |d|)
+                const float scale = minDist / std::sqrt(distSq) - 1.0f;
+                x[lane] += dx * scale;
+                y[lane] += dy * scale;
+                z[lane] += dz * scale;
+            }
+        }
+#endif
+    }
+}
+
+} // namespace animation
+} // namespace core
+} // namespace dmme
\ No newline at end of file
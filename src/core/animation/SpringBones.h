@@ -0,0 +1,199 @@
+#pragma once
+
+#include "AnimationTypes.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace dmme {
+namespace core {
+namespace animation {
+
+// ------------------------------------------------------------------
+// Descriptions
+// ------------------------------------------------------------------
+
+// One hair strand / skirt strip: joints from the anchored root outwards.
+struct SpringChainDesc {
+    uint32_t     jointCount    = 0;         // including the root, <= kSpringMaxJoints
+    const float* restPositions = nullptr;   // xyz per joint, sets segment lengths
+    float        stiffness     = 0.1f;      // pull towards the animated pose per substep, 0 - 1
+    float        damping       = 0.05f;     // velocity lost per substep, 0 - 1
+    float        gravity[3]    = {0.0f, -9.8f, 0.0f};
+    float        radius        = 0.02f;     // joint collision radius
+};
+
+constexpr uint32_t kSpringMaxJoints = 64;
+
+// Budget mode: how the solver trades accuracy for time
+struct SpringBudget {
+    float    budgetMs      = 0.0f;      // 0 = fixed quality
+    uint32_t maxIterations = 4;         // constraint passes per substep
+    uint32_t minIterations = 1;
+};
+
+struct SpringStats {
+    uint32_t chains        = 0;
+    uint32_t joints        = 0;
+    uint32_t colliders     = 0;
+    uint32_t substeps      = 0;         // last Update
+    uint32_t iterations    = 0;         // current constraint passes per substep
+    uint32_t droppedSteps  = 0;         // total substeps skipped to stay real-time
+    float    solveMs       = 0.0f;      // last Update
+    float    averageMs     = 0.0f;      // smoothed, drives budget mode
+};
+
+// ------------------------------------------------------------------
+// SpringBoneSolver
+// ------------------------------------------------------------------
+
+// SpringBoneSolver gives hair and clothing chains secondary motion with
+// Verlet integration and segment-length constraints; it is not a
+// general rigid-body engine.
+//
+// Chains are stored four to a group, one SIMD lane per chain, and a
+// group's joints depth-major: the joints at depth d of all four chains
+// sit in one 16-byte vector. Integration, the length constraint (each
+// joint is pulled back to its rest distance from its parent one depth
+// up) and collision run on whole groups (SSE2; scalar elsewhere), so
+// the per-joint cost is a quarter of a scalar solver's. Lanes past the
+// end of a shorter chain are masked out.
+//
+// The simulation runs at a fixed substep; Update consumes frame time in
+// substeps, lerping the animated targets across them, and outputs the
+// joints interpolated between the last two substeps so motion stays
+// smooth at any frame rate. At most kMaxSubsteps run per frame; any
+// backlog beyond that is dropped rather than caught up.
+//
+// Budget mode: with SpringBudget::budgetMs set, the solver tracks its
+// smoothed cost and steps the constraint iterations down towards
+// minIterations while over budget, and back up once well under.
+//
+// Detail level: the power governor's PowerPolicy::animationDetail goes
+// to SetDetail. Reduced halves the constraint iterations (budget mode
+// then works below that cap); Minimal stops the simulation and joints
+// follow the animated pose, so an idle mascot pays nothing for hair.
+//
+// Not thread-safe: configure and update on one thread.
+//
+// Usage:
+//   SpringBoneSolver springs;
+//   uint32_t hair = springs.AddChain(desc);
+//   uint32_t head = springs.AddSphere(0.1f);
+//   // each frame, after sampling the animation:
+//   springs.SetTargets(hair, animatedJointPositions);
+//   springs.SetSphere(head, headCenter);
+//   springs.Update(deltaSeconds);
+//   springs.GetJoint(hair, 3, position);
+
+class SpringBoneSolver {
+public:
+    static constexpr float    kDefaultSubstep = 1.0f / 60.0f;
+    static constexpr uint32_t kMaxSubsteps    = 4;
+
+    SpringBoneSolver() = default;
+    ~SpringBoneSolver() = default;
+
+    SpringBoneSolver(const SpringBoneSolver&) = delete;
+    SpringBoneSolver& operator=(const SpringBoneSolver&) = delete;
+
+    // --- Setup ---
+
+    // Returns the chain index, or UINT32_MAX if desc is invalid. Joints
+    // start at their rest positions.
+    uint32_t AddChain(const SpringChainDesc& desc);
+
+    // Colliders (world space; move them with SetSphere / SetCapsule)
+    uint32_t AddSphere(float radius);
+    uint32_t AddCapsule(float radius);
+    void     SetSphere(uint32_t collider, const float center[3]);
+    void     SetCapsule(uint32_t collider, const float a[3], const float b[3]);
+
+    void Clear();
+
+    void  SetSubstep(float seconds);
+    float GetSubstep() const { return m_substep; }
+
+    void SetBudget(const SpringBudget& budget);
+    const SpringBudget& GetBudget() const { return m_budget; }
+
+    void SetDetail(AnimationDetail detail);
+    AnimationDetail GetDetail() const { return m_detail; }
+
+    // --- Per frame ---
+
+    // Animated joint positions for this frame (xyz per joint). The root
+    // follows them exactly; other joints are pulled towards them by
+    // the chain's stiffness.
+    void SetTargets(uint32_t chain, const float* positions);
+
+    // Jump every joint to its target (after a teleport or on first use)
+    void ResetToTargets();
+
+    void Update(float deltaSeconds);
+
+    // Interpolated joint position after the last Update
+    void GetJoint(uint32_t chain, uint32_t joint, float out[3]) const;
+
+    const SpringStats& GetStats() const { return m_stats; }
+
+private:
+    struct Chain {
+        uint32_t group      = 0;
+        uint32_t lane       = 0;
+        uint32_t jointCount = 0;
+    };
+
+    // Four chains, joints depth-major (index (offset + depth) * 4 + lane)
+    struct Group {
+        uint32_t offset = 0;        // first depth row
+        uint32_t depth  = 0;        // rows (longest chain in the group)
+        uint32_t chains = 0;        // lanes in use
+        float    stiffness[4] = {};
+        float    keep[4]      = {}; // 1 - damping
+        float    gravity[3][4] = {};
+        float    radius[4]    = {};
+    };
+
+    struct Collider {
+        float a[3]     = {};
+        float b[3]     = {};        // == a for spheres
+        float radius   = 0.0f;
+    };
+
+    size_t Index(const Chain& chain, uint32_t joint) const {
+        return (static_cast<size_t>(m_groups[chain.group].offset) + joint) * 4 + chain.lane;
+    }
+
+    void Grow(Group& group, uint32_t depth);
+    void Step(float targetFrom, float targetTo, float substep);
+    void StepGroup(const Group& group, float targetFrom, float targetTo, float substepSq);
+    void Collide(const Group& group, uint32_t row);
+    void UpdateBudget(float solveMs);
+    uint32_t MaxIterations() const;
+
+    std::vector<Chain>    m_chains;
+    std::vector<Group>    m_groups;
+    std::vector<Collider> m_colliders;
+
+    // --- Joint state, depth-major rows of four lanes ---
+    std::vector<float> m_x[3];          // current
+    std::vector<float> m_prev[3];       // previous substep
+    std::vector<float> m_target[3];     // animated pose this frame
+    std::vector<float> m_lastTarget[3]; // animated pose last frame
+    std::vector<float> m_restLength;    // to the parent joint
+    std::vector<float> m_mask;          // 1 = live joint, 0 = padding
+
+    float        m_substep     = kDefaultSubstep;
+    float        m_accumulator = 0.0f;
+    SpringBudget m_budget;
+    AnimationDetail m_detail = AnimationDetail::Full;
+    uint32_t     m_iterations  = 4;
+    uint32_t     m_budgetCooldown = 0;
+    SpringStats  m_stats;
+};
+
+} // namespace animation
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,494 @@
+#include "TweenEngine.h"
+#include "utils/Simd.h"
+
+#include <algorithm>
+
+namespace dmme {
+namespace core {
+namespace animation {
+
+namespace {
+
+// duration <= 0 still runs through the pools (completes next Update)
+constexpr float kMinDuration = 1e-6f;
+
+template <Ease E>
+inline float EaseScalar(float t) {
+    return EvaluateEase(E, t);
+}
+
+#if defined(DMME_SIMD_SSE2)
+inline __m128 Select(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// Four lanes of EvaluateEase(E, t); t in [0, 1]
+template <Ease E>
+inline __m128 EaseLanes(__m128 t) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 u   = _mm_sub_ps(one, t);
+
+    if constexpr (E == Ease::InQuad) {
+        return _mm_mul_ps(t, t);
+    } else if constexpr (E == Ease::OutQuad) {
+        return _mm_sub_ps(one, _mm_mul_ps(u, u));
+    } else if constexpr (E == Ease::InOutQuad) {
+        const __m128 two = _mm_set1_ps(2.0f);
+        const __m128 lo  = _mm_mul_ps(two, _mm_mul_ps(t, t));
+        const __m128 hi  = _mm_sub_ps(one, _mm_mul_ps(two, _mm_mul_ps(u, u)));
+        return Select(_mm_cmplt_ps(t, _mm_set1_ps(0.5f)), lo, hi);
+    } else if constexpr (E == Ease::InCubic) {
+        return _mm_mul_ps(t, _mm_mul_ps(t, t));
+    } else if constexpr (E == Ease::OutCubic) {
+        return _mm_sub_ps(one, _mm_mul_ps(u, _mm_mul_ps(u, u)));
+    } else if constexpr (E == Ease::InOutCubic) {
+        const __m128 four = _mm_set1_ps(4.0f);
+        const __m128 lo   = _mm_mul_ps(four, _mm_mul_ps(t, _mm_mul_ps(t, t)));
+        const __m128 hi   = _mm_sub_ps(one, _mm_mul_ps(four, _mm_mul_ps(u, _mm_mul_ps(u, u))));
+        return Select(_mm_cmplt_ps(t, _mm_set1_ps(0.5f)), lo, hi);
+    } else if constexpr (E == Ease::SmoothStep) {
+        const __m128 k = _mm_sub_ps(_mm_set1_ps(3.0f), _mm_add_ps(t, t));
+        return _mm_mul_ps(_mm_mul_ps(t, t), k);
+    } else if constexpr (E == Ease::OutBack) {
+        const __m128 u2 = _mm_mul_ps(u, u);
+        const __m128 u3 = _mm_mul_ps(u2, u);
+        return _mm_add_ps(_mm_sub_ps(one, _mm_mul_ps(_mm_set1_ps(kEaseBackC3), u3)),
+                          _mm_mul_ps(_mm_set1_ps(kEaseBackC1), u2));
+    } else {
+        return t;
+    }
+}
+#endif
+
+} // anonymous namespace
+
+// ===================================================================
+// Setup
+// ===================================================================
+
+void TweenEngine::Reserve(size_t channels, size_t tweensPerEase) {
+    m_values.reserve(channels);
+    m_channels.reserve(channels);
+    for (auto& pool : m_pools) {
+        pool.elapsed.reserve(tweensPerEase);
+        pool.invDuration.reserve(tweensPerEase);
+        pool.from.reserve(tweensPerEase);
+        pool.to.reserve(tweensPerEase);
+        pool.channel.reserve(tweensPerEase);
+        pool.tag.reserve(tweensPerEase);
+    }
+    m_finished.reserve(tweensPerEase);
+    m_events.reserve(tweensPerEase);
+}
+
+// ===================================================================
+// Channels
+// ===================================================================
+
+TweenChannel TweenEngine::CreateChannel(float initialValue) {
+    uint32_t index = 0;
+    if (!m_freeChannels.empty()) {
+        index = m_freeChannels.back();
+        m_freeChannels.pop_back();
+    } else {
+        index = static_cast<uint32_t>(m_channels.size());
+        m_channels.emplace_back();
+        m_values.push_back(0.0f);
+        m_callbacks.emplace_back();
+    }
+
+    ChannelState& state = m_channels[index];
+    state.alive     = true;
+    state.dense     = kNone;
+    state.queueHead = kNone;
+    state.queueTail = kNone;
+    m_values[index] = initialValue;
+
+    TweenChannel channel;
+    channel.index      = index;
+    channel.generation = state.generation;
+    return channel;
+}
+
+void TweenEngine::DestroyChannel(TweenChannel channel) {
+    uint32_t index = 0;
+    if (!ResolveChannel(channel, index)) {
+        return;
+    }
+
+    RemoveTween(index);
+    ClearQueue(index);
+    m_callbacks[index] = nullptr;
+
+    ChannelState& state = m_channels[index];
+    state.alive = false;
+    state.generation++;     // invalidates outstanding handles and events
+    m_freeChannels.push_back(index);
+}
+
+bool TweenEngine::IsAlive(TweenChannel channel) const {
+    uint32_t index = 0;
+    return ResolveChannel(channel, index);
+}
+
+void TweenEngine::SetValue(TweenChannel channel, float value) {
+    uint32_t index = 0;
+    if (!ResolveChannel(channel, index)) {
+        return;
+    }
+    RemoveTween(index);
+    ClearQueue(index);
+    m_values[index] = value;
+}
+
+float TweenEngine::GetValue(TweenChannel channel) const {
+    uint32_t index = 0;
+    return ResolveChannel(channel, index) ? m_values[index] : 0.0f;
+}
+
+float TweenEngine::GetFinalValue(TweenChannel channel) const {
+    uint32_t index = 0;
+    if (!ResolveChannel(channel, index)) {
+        return 0.0f;
+    }
+
+    const ChannelState& state = m_channels[index];
+    if (state.queueTail != kNone) {
+        return m_segments[state.queueTail].target;
+    }
+    if (state.dense != kNone) {
+        return m_pools[state.pool].to[state.dense];
+    }
+    return m_values[index];
+}
+
+// ===================================================================
+// Tweens
+// ===================================================================
+
+bool TweenEngine::TweenTo(TweenChannel channel, float target, float duration,
+                          Ease ease, float delay, uint32_t tag) {
+    uint32_t index = 0;
+    if (!ResolveChannel(channel, index) || ease >= Ease::Count) {
+        return false;
+    }
+
+    RemoveTween(index);
+    ClearQueue(index);
+    StartTween(index, target, duration, ease, -std::max(delay, 0.0f), tag);
+    return true;
+}
+
+bool TweenEngine::Then(TweenChannel channel, float target, float duration,
+                       Ease ease, float delay, uint32_t tag) {
+    uint32_t index = 0;
+    if (!ResolveChannel(channel, index) || ease >= Ease::Count) {
+        return false;
+    }
+
+    ChannelState& state = m_channels[index];
+    if (state.dense == kNone) {
+        StartTween(index, target, duration, ease, -std::max(delay, 0.0f), tag);
+        return true;
+    }
+
+    const uint32_t segIndex = AllocateSegment();
+    Segment& seg = m_segments[segIndex];
+    seg.target   = target;
+    seg.duration = duration;
+    seg.delay    = std::max(delay, 0.0f);
+    seg.tag      = tag;
+    seg.ease     = ease;
+    seg.next     = kNone;
+
+    if (state.queueTail == kNone) {
+        state.queueHead = segIndex;
+    } else {
+        m_segments[state.queueTail].next = segIndex;
+    }
+    state.queueTail = segIndex;
+    return true;
+}
+
+void TweenEngine::Stop(TweenChannel channel) {
+    uint32_t index = 0;
+    if (!ResolveChannel(channel, index)) {
+        return;
+    }
+    RemoveTween(index);
+    ClearQueue(index);
+}
+
+bool TweenEngine::IsAnimating(TweenChannel channel) const {
+    uint32_t index = 0;
+    return ResolveChannel(channel, index) && m_channels[index].dense != kNone;
+}
+
+// ===================================================================
+// Completion
+// ===================================================================
+
+void TweenEngine::SetCompletionCallback(TweenChannel channel, TweenCallback callback) {
+    uint32_t index = 0;
+    if (ResolveChannel(channel, index)) {
+        m_callbacks[index] = std::move(callback);
+    }
+}
+
+const std::vector<TweenEvent>& TweenEngine::GetEvents() const {
+    return m_events;
+}
+
+void TweenEngine::DispatchEvents() {
+    // Index loop: the list is not modified by callbacks, but a
+    // callback may create channels (m_callbacks is a deque, so the
+    // running callback stays put).
+    for (size_t i = 0; i < m_events.size(); ++i) {
+        const TweenEvent& event = m_events[i];
+        uint32_t index;
+        if (ResolveChannel(event.channel, index) && m_callbacks[index]) {
+            m_callbacks[index](event);
+        }
+    }
+}
+
+// ===================================================================
+// Frame Update
+// ===================================================================
+
+template <Ease E>
+void TweenEngine::UpdatePool(TweenPool& pool, float deltaSeconds, uint8_t poolIndex) {
+    const size_t n = pool.Size();
+    float*          elapsed = pool.elapsed.data();
+    const float*    invDur  = pool.invDuration.data();
+    const float*    from    = pool.from.data();
+    const float*    to      = pool.to.data();
+    const uint32_t* channel = pool.channel.data();
+    float*          values  = m_values.data();
+
+    size_t i = 0;
+
+#if defined(DMME_SIMD_SSE2)
+    const __m128 dt   = _mm_set1_ps(deltaSeconds);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one  = _mm_set1_ps(1.0f);
+
+    for (; i + 4 <= n; i += 4) {
+        const __m128 el = _mm_add_ps(_mm_loadu_ps(elapsed + i), dt);
+        _mm_storeu_ps(elapsed + i, el);
+
+        const __m128 raw = _mm_mul_ps(el, _mm_loadu_ps(invDur + i));
+        const __m128 t   = _mm_min_ps(_mm_max_ps(raw, zero), one);
+        const __m128 e   = EaseLanes<E>(t);
+
+        const __m128 f = _mm_loadu_ps(from + i);
+        const __m128 v = _mm_add_ps(f, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(to + i), f), e));
+
+        alignas(16) float out[4];
+        _mm_store_ps(out, v);
+        values[channel[i + 0]] = out[0];
+        values[channel[i + 1]] = out[1];
+        values[channel[i + 2]] = out[2];
+        values[channel[i + 3]] = out[3];
+
+        const int done = _mm_movemask_ps(_mm_cmpge_ps(raw, one));
+        if (done) {
+            for (size_t lane = 0; lane < 4; ++lane) {
+                if (done & (1 << lane)) {
+                    const size_t k = i + lane;
+                    m_finished.push_back({poolIndex, static_cast<uint32_t>(k),
+                                          elapsed[k] - 1.0f / invDur[k]});
+                }
+            }
+        }
+    }
+#endif
+
+    for (; i < n; ++i) {
+        elapsed[i] += deltaSeconds;
+        const float raw = elapsed[i] * invDur[i];
+        const float t   = std::min(std::max(raw, 0.0f), 1.0f);
+        values[channel[i]] = from[i] + (to[i] - from[i]) * EaseScalar<E>(t);
+
+        if (raw >= 1.0f) {
+            m_finished.push_back({poolIndex, static_cast<uint32_t>(i),
+                                  elapsed[i] - 1.0f / invDur[i]});
+        }
+    }
+}
+
+void TweenEngine::Update(float deltaSeconds) {
+    m_events.clear();
+    m_finished.clear();
+
+    using PoolUpdater = void (TweenEngine::*)(TweenPool&, float, uint8_t);
+    static constexpr PoolUpdater kUpdaters[kEaseCount] = {
+        &TweenEngine::UpdatePool<Ease::Linear>,
+        &TweenEngine::UpdatePool<Ease::InQuad>,
+        &TweenEngine::UpdatePool<Ease::OutQuad>,
+        &TweenEngine::UpdatePool<Ease::InOutQuad>,
+        &TweenEngine::UpdatePool<Ease::InCubic>,
+        &TweenEngine::UpdatePool<Ease::OutCubic>,
+        &TweenEngine::UpdatePool<Ease::InOutCubic>,
+        &TweenEngine::UpdatePool<Ease::SmoothStep>,
+        &TweenEngine::UpdatePool<Ease::OutBack>,
+    };
+
+    // --- SIMD pass over each pool ---
+    for (size_t p = 0; p < kEaseCount; ++p) {
+        if (m_pools[p].Size() > 0) {
+            (this->*kUpdaters[p])(m_pools[p], deltaSeconds, static_cast<uint8_t>(p));
+        }
+    }
+
+    if (m_finished.empty()) {
+        return;
+    }
+
+    // --- Retire finished tweens ---
+    // Reverse order keeps the remaining indices of each pool valid
+    // across swap-removal. Tweens started here (next segment) are
+    // appended past every recorded index, so they are not disturbed.
+    for (auto it = m_finished.rbegin(); it != m_finished.rend(); ++it) {
+        TweenPool& pool = m_pools[it->pool];
+        const uint32_t index = pool.channel[it->dense];
+        const float    value = pool.to[it->dense];
+        const uint32_t tag   = pool.tag[it->dense];
+
+        RemoveTween(index);
+        m_values[index] = value;   // exact target, no rounding residue
+
+        ChannelState& state = m_channels[index];
+
+        TweenEvent event;
+        event.channel.index      = index;
+        event.channel.generation = state.generation;
+        event.value              = value;
+        event.tag                = tag;
+        event.sequenceDone       = (state.queueHead == kNone);
+        m_events.push_back(event);
+
+        // --- Next segment of the sequence ---
+        if (state.queueHead != kNone) {
+            const uint32_t segIndex = state.queueHead;
+            const Segment  seg      = m_segments[segIndex];
+
+            state.queueHead = seg.next;
+            if (state.queueHead == kNone) {
+                state.queueTail = kNone;
+            }
+            m_segments[segIndex].next = m_freeSegment;
+            m_freeSegment = segIndex;
+
+            // Carry the overshoot so sequences do not drift per frame
+            StartTween(index, seg.target, seg.duration, seg.ease,
+                       it->overshoot - seg.delay, seg.tag);
+        }
+    }
+}
+
+// ===================================================================
+// Stats
+// ===================================================================
+
+size_t TweenEngine::GetActiveTweenCount() const {
+    size_t total = 0;
+    for (const auto& pool : m_pools) {
+        total += pool.Size();
+    }
+    return total;
+}
+
+size_t TweenEngine::GetChannelCount() const {
+    return m_channels.size() - m_freeChannels.size();
+}
+
+// ===================================================================
+// Internal
+// ===================================================================
+
+bool TweenEngine::ResolveChannel(TweenChannel channel, uint32_t& index) const {
+    if (channel.index >= m_channels.size()) {
+        return false;
+    }
+    const ChannelState& state = m_channels[channel.index];
+    if (!state.alive || state.generation != channel.generation) {
+        return false;
+    }
+    index = channel.index;
+    return true;
+}
+
+void TweenEngine::StartTween(uint32_t channelIndex, float target, float duration,
+                             Ease ease, float elapsed, uint32_t tag) {
+    const uint8_t poolIndex = static_cast<uint8_t>(ease);
+    TweenPool& pool = m_pools[poolIndex];
+
+    ChannelState& state = m_channels[channelIndex];
+    state.pool  = poolIndex;
+    state.dense = static_cast<uint32_t>(pool.Size());
+
+    pool.elapsed.push_back(elapsed);
+    pool.invDuration.push_back(1.0f / std::max(duration, kMinDuration));
+    pool.from.push_back(m_values[channelIndex]);
+    pool.to.push_back(target);
+    pool.channel.push_back(channelIndex);
+    pool.tag.push_back(tag);
+}
+
+void TweenEngine::RemoveTween(uint32_t channelIndex) {
+    ChannelState& state = m_channels[channelIndex];
+    if (state.dense == kNone) {
+        return;
+    }
+
+    TweenPool& pool = m_pools[state.pool];
+    const uint32_t dense = state.dense;
+    const uint32_t last  = static_cast<uint32_t>(pool.Size() - 1);
+
+    if (dense != last) {
+        pool.elapsed[dense]     = pool.elapsed[last];
+        pool.invDuration[dense] = pool.invDuration[last];
+        pool.from[dense]        = pool.from[last];
+        pool.to[dense]          = pool.to[last];
+        pool.channel[dense]     = pool.channel[last];
+        pool.tag[dense]         = pool.tag[last];
+        m_channels[pool.channel[dense]].dense = dense;
+    }
+
+    pool.elapsed.pop_back();
+    pool.invDuration.pop_back();
+    pool.from.pop_back();
+    pool.to.pop_back();
+    pool.channel.pop_back();
+    pool.tag.pop_back();
+
+    state.dense = kNone;
+}
+
+void TweenEngine::ClearQueue(uint32_t channelIndex) {
+    ChannelState& state = m_channels[channelIndex];
+    uint32_t seg = state.queueHead;
+    while (seg != kNone) {
+        const uint32_t next = m_segments[seg].next;
+        m_segments[seg].next = m_freeSegment;
+        m_freeSegment = seg;
+        seg = next;
+    }
+    state.queueHead = kNone;
+    state.queueTail = kNone;
+}
+
+uint32_t TweenEngine::AllocateSegment() {
+    if (m_freeSegment != kNone) {
+        const uint32_t index = m_freeSegment;
+        m_freeSegment = m_segments[index].next;
+        return index;
+    }
+    m_segments.emplace_back();
+    return static_cast<uint32_t>(m_segments.size() - 1);
+}
+
+} // namespace animation
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "Easing.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace dmme {
+namespace core {
+namespace animation {
+
+// ------------------------------------------------------------------
+// Handles and events
+// ------------------------------------------------------------------
+
+// A channel is one animated float (opacity, position.x, colour.g...).
+// Multi-component properties use one channel per component; tweens
+// started with the same timing and easing run in lockstep.
+struct TweenChannel {
+    static constexpr uint32_t kInvalidIndex = 0xFFFFFFFFu;
+
+    uint32_t index      = kInvalidIndex;
+    uint32_t generation = 0;
+
+    bool IsValid() const { return index != kInvalidIndex; }
+};
+
+// One finished tween segment, collected during Update
+struct TweenEvent {
+    TweenChannel channel;
+    float        value        = 0.0f;   // channel value at completion
+    uint32_t     tag          = 0;      // caller's tag from TweenTo/Then
+    bool         sequenceDone = false;  // no queued segment followed
+};
+
+using TweenCallback = std::function<void(const TweenEvent& event)>;
+
+// TweenEngine animates many float channels with easing curves.
+//
+// Running tweens are kept in structure-of-arrays form, one pool per
+// easing curve, so Update walks flat float arrays and evaluates the
+// curve four tweens at a time (SSE2; scalar elsewhere) without any
+// per-tween branching on the curve type. Finished tweens are swap-
+// removed, so pools stay dense.
+//
+// Sequences: Then() queues a segment that starts from wherever the
+// channel ends up when the running tween (or previous segment)
+// finishes. A delay holds the start value, which is also how
+// staggered starts across channels are expressed.
+//
+// Completion never calls out of Update. Finished segments are appended
+// to an event list instead; DispatchEvents() runs the per-channel
+// callbacks over that batch afterwards, and GetEvents() exposes it for
+// callers that prefer to poll.
+//
+// Not thread-safe: create, tween and update on one thread (the main
+// loop). Update and DispatchEvents do not allocate once the pools and
+// event list have grown to their working size (see Reserve).
+//
+// Usage:
+//   TweenEngine tweens;
+//   TweenChannel alpha = tweens.CreateChannel(0.0f);
+//   tweens.TweenTo(alpha, 1.0f, 0.3f, Ease::OutCubic);
+//   tweens.Then(alpha, 0.0f, 0.3f, Ease::InCubic, /*delay*/ 2.0f);
+//   // each frame:
+//   tweens.Update(dt);
+//   tweens.DispatchEvents();
+//   float a = tweens.GetValue(alpha);
+
+class TweenEngine {
+public:
+    TweenEngine() = default;
+    ~TweenEngine() = default;
+
+    TweenEngine(const TweenEngine&) = delete;
+    TweenEngine& operator=(const TweenEngine&) = delete;
+
+    // Pre-size channel storage and each easing pool
+    void Reserve(size_t channels, size_t tweensPerEase);
+
+    // --- Channels ---
+    TweenChannel CreateChannel(float initialValue = 0.0f);
+    void  DestroyChannel(TweenChannel channel);
+    bool  IsAlive(TweenChannel channel) const;
+
+    // Jump to value, cancelling the running tween and queued segments
+    // (no event is emitted).
+    void  SetValue(TweenChannel channel, float value);
+    float GetValue(TweenChannel channel) const;
+
+    // Value the channel will settle at once its sequence finishes
+    float GetFinalValue(TweenChannel channel) const;
+
+    // --- Tweens ---
+
+    // Replace whatever the channel is doing with a tween from its
+    // current value to target. duration <= 0 completes on the next
+    // Update.
+    bool TweenTo(TweenChannel channel, float target, float duration,
+                 Ease ease = Ease::Linear, float delay = 0.0f, uint32_t tag = 0);
+
+    // Queue a segment after the running tween / last queued segment.
+    // Starts immediately if the channel is idle.
+    bool Then(TweenChannel channel, float target, float duration,
+              Ease ease = Ease::Linear, float delay = 0.0f, uint32_t tag = 0);
+
+    // Stop at the current value and drop queued segments (no event)
+    void Stop(TweenChannel channel);
+
+    bool IsAnimating(TweenChannel channel) const;
+
+    // --- Completion ---
+
+    // Invoked from DispatchEvents for each of the channel's events.
+    // The callback is stored once and never copied per event.
+    void SetCompletionCallback(TweenChannel channel, TweenCallback callback);
+
+    // --- Frame Update ---
+
+    // Advance every running tween by deltaSeconds. Clears and refills
+    // the event list.
+    void Update(float deltaSeconds);
+
+    // Segments finished by the last Update
+    const std::vector<TweenEvent>& GetEvents() const;
+
+    // Run completion callbacks for the last Update's events. Callbacks
+    // may start new tweens; those are picked up by the next Update.
+    void DispatchEvents();
+
+    // --- Stats ---
+    size_t GetActiveTweenCount() const;
+    size_t GetChannelCount() const;
+
+private:
+    static constexpr uint32_t kNone = 0xFFFFFFFFu;
+
+    // Running tweens using one easing curve (SoA)
+    struct TweenPool {
+        std::vector<float>    elapsed;      // seconds; negative while delayed
+        std::vector<float>    invDuration;
+        std::vector<float>    from;
+        std::vector<float>    to;
+        std::vector<uint32_t> channel;      // channel index
+        std::vector<uint32_t> tag;
+
+        size_t Size() const { return channel.size(); }
+    };
+
+    // Cold per-channel bookkeeping
+    struct ChannelState {
+        uint32_t generation = 0;
+        uint32_t dense      = kNone;        // index in its pool, kNone if idle
+        uint32_t queueHead  = kNone;        // pending segments
+        uint32_t queueTail  = kNone;
+        uint8_t  pool       = 0;
+        bool     alive      = false;
+    };
+
+    // Queued segment of a sequence (free-listed)
+    struct Segment {
+        float    target   = 0.0f;
+        float    duration = 0.0f;
+        float    delay    = 0.0f;
+        uint32_t tag      = 0;
+        uint32_t next     = kNone;
+        Ease     ease     = Ease::Linear;
+    };
+
+    // Tween that reached its end during this Update
+    struct Finished {
+        uint8_t  pool;
+        uint32_t dense;
+        float    overshoot;                 // seconds past the end
+    };
+
+    template <Ease E>
+    void UpdatePool(TweenPool& pool, float deltaSeconds, uint8_t poolIndex);
+
+    bool ResolveChannel(TweenChannel channel, uint32_t& index) const;
+    void StartTween(uint32_t channelIndex, float target, float duration,
+                    Ease ease, float elapsed, uint32_t tag);
+    void RemoveTween(uint32_t channelIndex);
+    void ClearQueue(uint32_t channelIndex);
+    uint32_t AllocateSegment();
+
+    // --- Channels (values hot, state cold) ---
+    std::vector<float>        m_values;
+    std::vector<ChannelState> m_channels;
+    std::deque<TweenCallback> m_callbacks;      // stable while a callback runs
+    std::vector<uint32_t>     m_freeChannels;
+
+    // --- Running tweens, one pool per easing curve ---
+    std::array<TweenPool, kEaseCount> m_pools;
+
+    // --- Sequences ---
+    std::vector<Segment>  m_segments;
+    uint32_t              m_freeSegment = kNone;
+
+    // --- Per-update scratch ---
+    std::vector<Finished>   m_finished;
+    std::vector<TweenEvent> m_events;
+};
+
+} // namespace animation
+} // namespace core
+} // namespace dmme
\ No newline at end of file
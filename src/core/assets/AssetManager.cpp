@@ -0,0 +1,323 @@
+#include "AssetManager.h"
+#include "utils/Clock.h"
+#include "utils/Logger.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace dmme {
+namespace core {
+namespace assets {
+
+namespace {
+
+// Lower-case extension without the dot, or empty
+std::string ExtensionOf(std::string_view path) {
+    const size_t dot   = path.find_last_of('.');
+    const size_t slash = path.find_last_of("/\\");
+    if (dot == std::string_view::npos || (slash != std::string_view::npos && dot < slash)) {
+        return {};
+    }
+    std::string extension(path.substr(dot + 1));
+    for (char& c : extension) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return extension;
+}
+
+} // namespace
+
+// ===================================================================
+// Lifecycle
+// ===================================================================
+
+AssetManager::AssetManager(const AssetManagerConfig& config)
+    : m_config(config) {
+    const int workers = std::max(config.workerCount, 1);
+    m_workers.reserve(workers);
+    for (int i = 0; i < workers; ++i) {
+        m_workers.emplace_back(&AssetManager::WorkerLoop, this);
+    }
+}
+
+AssetManager::~AssetManager() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        for (auto& [handle, entry] : m_entries) {
+            entry->cancelled.store(true, std::memory_order_relaxed);
+        }
+    }
+    m_wake.notify_all();
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void AssetManager::RegisterType(std::string_view extension, AssetFactory factory) {
+    std::string key = ExtensionOf(std::string(".") + std::string(extension));
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_factories[key] = std::move(factory);
+}
+
+// ===================================================================
+// Requests
+// ===================================================================
+
+AssetHandle AssetManager::Request(const std::string& path, AssetPriority priority) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    ++m_stats.requests;
+
+    const auto existing = m_byPath.find(path);
+    if (existing != m_byPath.end()) {
+        Entry& entry = *m_entries[existing->second];
+        ++entry.refs;
+        ++m_stats.deduplicated;
+        if (priority < entry.priority) {
+            // Re-queue at the higher class; the old queue entry is skipped
+            entry.priority = priority;
+            const size_t p = static_cast<size_t>(priority);
+            if (entry.state == AssetState::Queued) {
+                m_loadQueues[p].push_back(entry.handle);
+            } else if (entry.state == AssetState::Finalizing) {
+                m_finalizeQueues[p].push_back(entry.handle);
+            }
+        }
+        return entry.handle;
+    }
+
+    const auto factory = m_factories.find(ExtensionOf(path));
+    if (factory == m_factories.end()) {
+        DMME_LOG_ERROR("AssetManager: no loader for '{}'", path);
+        return kInvalidAsset;
+    }
+
+    auto entry = std::make_unique<Entry>();
+    entry->handle    = m_nextHandle++;
+    entry->path      = path;
+    entry->factory   = &factory->second;
+    entry->priority  = priority;
+    entry->refs      = 1;
+    entry->requestUs = utils::MonotonicMicros();
+
+    const AssetHandle handle = entry->handle;
+    m_byPath[path] = handle;
+    m_loadQueues[static_cast<size_t>(priority)].push_back(handle);
+    m_entries.emplace(handle, std::move(entry));
+    lock.unlock();
+    m_wake.notify_one();
+    return handle;
+}
+
+void AssetManager::Release(AssetHandle handle) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = m_entries.find(handle);
+    if (it == m_entries.end() || it->second->refs == 0) {
+        return;
+    }
+    Entry& entry = *it->second;
+    if (--entry.refs > 0) {
+        return;
+    }
+
+    // A later Request for the path starts a fresh load
+    const auto byPath = m_byPath.find(entry.path);
+    if (byPath != m_byPath.end() && byPath->second == handle) {
+        m_byPath.erase(byPath);
+    }
+
+    switch (entry.state) {
+        case AssetState::Loading:
+            // The worker retires it when Load returns
+            entry.cancelled.store(true, std::memory_order_relaxed);
+            break;
+        case AssetState::Queued:
+        case AssetState::Finalizing:
+            entry.state = AssetState::Cancelled;
+            ++m_stats.cancelled;
+            Retire(handle);
+            break;
+        default:
+            Retire(handle);
+            break;
+    }
+}
+
+void AssetManager::Retire(AssetHandle handle) {
+    const auto it = m_entries.find(handle);
+    if (it != m_entries.end()) {
+        m_graveyard.push_back(std::move(it->second));
+        m_entries.erase(it);
+    }
+}
+
+AssetState AssetManager::GetState(AssetHandle handle) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = m_entries.find(handle);
+    return it != m_entries.end() ? it->second->state : AssetState::Cancelled;
+}
+
+IAsset* AssetManager::Get(AssetHandle handle) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = m_entries.find(handle);
+    if (it == m_entries.end() || it->second->state != AssetState::Ready) {
+        return nullptr;
+    }
+    return it->second->asset.get();
+}
+
+AssetManager::Entry* AssetManager::PopQueue(std::deque<AssetHandle>* queues, AssetState state) {
+    for (size_t p = 0; p < kAssetPriorityCount; ++p) {
+        while (!queues[p].empty()) {
+            const AssetHandle handle = queues[p].front();
+            queues[p].pop_front();
+            const auto it = m_entries.find(handle);
+            if (it != m_entries.end() && it->second->state == state &&
+                static_cast<size_t>(it->second->priority) == p) {
+                return it->second.get();
+            }
+        }
+    }
+    return nullptr;
+}
+
+// ===================================================================
+// Workers
+// ===================================================================
+
+void AssetManager::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        Entry* entry = nullptr;
+        m_wake.wait(lock, [&] {
+            return m_stop || (entry = PopQueue(m_loadQueues, AssetState::Queued)) != nullptr;
+        });
+        if (!entry) {
+            return;     // stopping
+        }
+
+        entry->state = AssetState::Loading;
+        ++m_loading;
+        const size_t p = static_cast<size_t>(entry->priority);
+        const float queueMs = utils::MicrosToMs(utils::MonotonicMicros() - entry->requestUs);
+        m_queueMsSum[p] += queueMs;
+        ++m_queueCount[p];
+        m_stats.maxQueueMs[p] = std::max(m_stats.maxQueueMs[p], queueMs);
+        lock.unlock();
+
+        // Release never erases a Loading entry, so it stays valid here
+        std::unique_ptr<IAsset> asset = (*entry->factory)();
+        const bool ok = asset && asset->Load(entry->path, entry->cancelled);
+
+        lock.lock();
+        --m_loading;
+        entry->asset = std::move(asset);
+        if (entry->cancelled.load(std::memory_order_relaxed)) {
+            entry->state = AssetState::Cancelled;
+            ++m_stats.cancelled;
+            Retire(entry->handle);
+        } else if (ok) {
+            entry->state = AssetState::Finalizing;
+            m_finalizeQueues[static_cast<size_t>(entry->priority)].push_back(entry->handle);
+        } else {
+            DMME_LOG_WARN("AssetManager: failed to load '{}'", entry->path);
+            entry->state = AssetState::Failed;
+            ++m_stats.failed;
+        }
+    }
+}
+
+// ===================================================================
+// Owner thread
+// ===================================================================
+
+void AssetManager::Update(float budgetMs) {
+    const uint64_t start = utils::MonotonicMicros();
+    const float budget = budgetMs >= 0.0f ? budgetMs : m_config.finalizeBudgetMs;
+
+    // Released assets die here, on the thread that may own their
+    // driver resources
+    std::vector<std::unique_ptr<Entry>> dead;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        dead.swap(m_graveyard);
+    }
+    dead.clear();
+
+    uint32_t steps = 0;
+    for (;;) {
+        Entry* entry = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            entry = PopQueue(m_finalizeQueues, AssetState::Finalizing);
+        }
+        if (!entry) {
+            break;
+        }
+
+        // Only this thread erases Finalizing entries (Release), so the
+        // entry outlives the call
+        const FinalizeResult result = entry->asset->Finalize();
+        ++steps;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (result == FinalizeResult::More) {
+                m_finalizeQueues[static_cast<size_t>(entry->priority)].push_front(entry->handle);
+            } else if (result == FinalizeResult::Done) {
+                entry->state = AssetState::Ready;
+                ++m_stats.completed;
+                m_loadMsSum += utils::MicrosToMs(utils::MonotonicMicros() - entry->requestUs);
+            } else {
+                DMME_LOG_WARN("AssetManager: failed to finalise '{}'", entry->path);
+                entry->state = AssetState::Failed;
+                ++m_stats.failed;
+            }
+        }
+
+        if (utils::MicrosToMs(utils::MonotonicMicros() - start) >= budget) {
+            break;
+        }
+    }
+
+    const float elapsed = utils::MicrosToMs(utils::MonotonicMicros() - start);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.finalizeMs    = elapsed;
+    m_stats.budgetMs      = budget;
+    m_stats.finalizeSteps = steps;
+    if (steps > 0 && elapsed > budget) {
+        ++m_stats.overBudgetFrames;
+    }
+}
+
+bool AssetManager::IsIdle() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& [handle, entry] : m_entries) {
+        if (entry->state == AssetState::Queued || entry->state == AssetState::Loading ||
+            entry->state == AssetState::Finalizing) {
+            return false;
+        }
+    }
+    return true;
+}
+
+AssetStats AssetManager::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    AssetStats stats = m_stats;
+    stats.queued = stats.finalizing = stats.ready = 0;
+    for (const auto& [handle, entry] : m_entries) {
+        stats.queued     += entry->state == AssetState::Queued;
+        stats.finalizing += entry->state == AssetState::Finalizing;
+        stats.ready      += entry->state == AssetState::Ready;
+    }
+    stats.loading = m_loading;
+    for (size_t p = 0; p < kAssetPriorityCount; ++p) {
+        stats.meanQueueMs[p] = m_queueCount[p] ? static_cast<float>(m_queueMsSum[p] / m_queueCount[p]) : 0.0f;
+    }
+    stats.meanLoadMs = m_stats.completed ? static_cast<float>(m_loadMsSum / m_stats.completed) : 0.0f;
+    return stats;
+}
+
+} // namespace assets
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace dmme {
+namespace core {
+namespace assets {
+
+// ------------------------------------------------------------------
+// Types
+// ------------------------------------------------------------------
+
+using AssetHandle = uint32_t;
+constexpr AssetHandle kInvalidAsset = 0;
+
+// Queue classes, most urgent first. A request for an asset that is
+// already queued raises its class, never lowers it.
+enum class AssetPriority : uint8_t {
+    Visible    = 0,     // needed for what is on screen now
+    Prefetch   = 1,     // likely needed soon (next expression, next motion)
+    Background = 2,     // warm-up, caches
+    Count      = 3
+};
+
+constexpr size_t kAssetPriorityCount = static_cast<size_t>(AssetPriority::Count);
+
+enum class AssetState : uint8_t {
+    Queued     = 0,     // waiting for a worker
+    Loading    = 1,     // worker is reading / decoding
+    Finalizing = 2,     // decoded, waiting for (or in) owner-thread finalisation
+    Ready      = 3,
+    Failed     = 4,
+    Cancelled  = 5      // also returned for unknown handles
+};
+
+enum class FinalizeResult : uint8_t {
+    Done   = 0,
+    More   = 1,         // call again (next slice, possibly next frame)
+    Failed = 2
+};
+
+// One loaded asset. Load runs on a worker thread; Finalize and the
+// destructor run on the owner thread, so they may touch the driver.
+class IAsset {
+public:
+    virtual ~IAsset() = default;
+
+    // Read and decode path (UTF-8). Long loads should poll cancelled
+    // and return false once it is set.
+    virtual bool Load(const std::string& path, const std::atomic<bool>& cancelled) = 0;
+
+    // Driver-side work (texture creation, uploads, pipeline creation)
+    // in slices: do a bounded amount and return More until finished.
+    virtual FinalizeResult Finalize() { return FinalizeResult::Done; }
+};
+
+using AssetFactory = std::function<std::unique_ptr<IAsset>()>;
+
+struct AssetManagerConfig {
+    int   workerCount = 2;          // I/O + decode threads
+    float finalizeBudgetMs = 2.0f;  // owner-thread time per Update
+};
+
+struct AssetStats {
+    // --- Current ---
+    uint32_t queued     = 0;
+    uint32_t loading    = 0;
+    uint32_t finalizing = 0;
+    uint32_t ready      = 0;
+
+    // --- Totals ---
+    uint64_t requests     = 0;
+    uint64_t deduplicated = 0;      // requests served by an existing entry
+    uint64_t completed    = 0;
+    uint64_t failed       = 0;
+    uint64_t cancelled    = 0;
+
+    // Request -> worker pickup, per priority class
+    float    meanQueueMs[kAssetPriorityCount] = {};
+    float    maxQueueMs[kAssetPriorityCount]  = {};
+    float    meanLoadMs = 0.0f;     // request -> Ready
+
+    // --- Last Update ---
+    float    finalizeMs    = 0.0f;  // owner-thread time spent
+    float    budgetMs      = 0.0f;
+    uint32_t finalizeSteps = 0;     // Finalize calls
+    uint64_t overBudgetFrames = 0;  // Updates that overran (one slice ran long)
+};
+
+// ------------------------------------------------------------------
+// AssetManager
+// ------------------------------------------------------------------
+
+// AssetManager loads assets without blocking the render thread.
+//
+// Request returns a handle at once and queues the path by priority
+// class; worker threads (owned here: loads block on I/O, so they do
+// not belong on the JobSystem's fork-join workers) take the most
+// urgent queued asset, create it with the factory registered for its
+// extension and run IAsset::Load. Decoded assets wait for Update, which
+// the owner thread calls once a frame: it runs Finalize slices, most
+// urgent first, until the frame's budget is spent, so a burst of loads
+// costs a few milliseconds per frame instead of a hitch.
+//
+// Requests are deduplicated by path: a second Request for the same
+// path returns the same handle with its reference count raised (and
+// its priority raised if needed). Release drops a reference; dropping
+// the last one cancels a pending load (a running Load sees its
+// cancelled flag, a decoded asset is discarded without finalising) or
+// unloads a ready asset. Assets are destroyed on the owner thread
+// during Update.
+//
+// Request, Release, Get, GetState and Update belong to the owner
+// thread; GetStats may be called from any thread.
+//
+// Usage:
+//   AssetManager assets;
+//   assets.RegisterType("pmx", [] { return std::make_unique<ModelAsset>(); });
+//   AssetHandle model = assets.Request("miku.pmx", AssetPriority::Visible);
+//   // each frame:
+//   assets.Update();
+//   if (auto* m = assets.Get<ModelAsset>(model)) { ... }
+//   // when done:
+//   assets.Release(model);
+
+class AssetManager {
+public:
+    explicit AssetManager(const AssetManagerConfig& config = {});
+    ~AssetManager();
+
+    AssetManager(const AssetManager&) = delete;
+    AssetManager& operator=(const AssetManager&) = delete;
+
+    // Factory for paths ending in .extension (case-insensitive, no dot)
+    void RegisterType(std::string_view extension, AssetFactory factory);
+
+    // Queue path, or take another reference to it. Returns
+    // kInvalidAsset if no factory matches the extension.
+    AssetHandle Request(const std::string& path, AssetPriority priority);
+
+    void Release(AssetHandle handle);
+
+    AssetState GetState(AssetHandle handle) const;
+
+    // The asset once Ready, else nullptr
+    IAsset* Get(AssetHandle handle) const;
+    template <typename T>
+    T* Get(AssetHandle handle) const { return static_cast<T*>(Get(handle)); }
+
+    // Finalise decoded assets within budgetMs (< 0 = the configured
+    // budget) and destroy released ones. At least one Finalize slice
+    // runs per call when any is waiting, so a tiny budget still makes
+    // progress.
+    void Update(float budgetMs = -1.0f);
+
+    void SetFinalizeBudget(float budgetMs) { m_config.finalizeBudgetMs = budgetMs; }
+
+    // Nothing queued, loading or waiting for finalisation
+    bool IsIdle() const;
+
+    AssetStats GetStats() const;
+
+private:
+    struct Entry {
+        AssetHandle             handle   = kInvalidAsset;
+        std::string             path;
+        const AssetFactory*     factory  = nullptr;
+        std::unique_ptr<IAsset> asset;
+        AssetPriority           priority = AssetPriority::Background;
+        AssetState              state    = AssetState::Queued;
+        uint32_t                refs     = 0;
+        std::atomic<bool>       cancelled{false};
+        uint64_t                requestUs = 0;
+    };
+
+    void WorkerLoop();
+
+    // Pops the most urgent live handle from queues (m_mutex held)
+    Entry* PopQueue(std::deque<AssetHandle>* queues, AssetState state);
+    void   Retire(AssetHandle handle);     // m_mutex held
+
+    AssetManagerConfig m_config;
+
+    std::unordered_map<std::string, AssetFactory> m_factories;
+
+    mutable std::mutex      m_mutex;
+    std::condition_variable m_wake;
+    std::vector<std::thread> m_workers;
+    bool                    m_stop = false;
+
+    std::unordered_map<AssetHandle, std::unique_ptr<Entry>> m_entries;
+    std::unordered_map<std::string, AssetHandle>            m_byPath;   // live (unreleased) entries
+    AssetHandle m_nextHandle = 1;
+
+    // Queues hold handles; entries that were re-queued at a higher
+    // class or released are skipped when popped.
+    std::deque<AssetHandle> m_loadQueues[kAssetPriorityCount];
+    std::deque<AssetHandle> m_finalizeQueues[kAssetPriorityCount];
+    std::vector<std::unique_ptr<Entry>> m_graveyard;    // destroyed in Update
+    uint32_t m_loading = 0;
+
+    AssetStats m_stats;
+    double     m_queueMsSum[kAssetPriorityCount] = {};
+    uint64_t   m_queueCount[kAssetPriorityCount] = {};
+    double     m_loadMsSum = 0.0;
+};
+
+} // namespace assets
+} // namespace core
+} // namespace dmme
\ No newline at end of file
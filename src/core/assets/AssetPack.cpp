@@ -0,0 +1,486 @@
+#include "AssetPack.h"
+#include "Lz.h"
+#include "core/jobs/JobSystem.h"
+#include "utils/Hash.h"
+#include "utils/Logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+
+namespace dmme {
+namespace core {
+namespace assets {
+
+// --- On-disk records (the index is 8-byte aligned in the file) ---
+
+struct PackEntryRecord {
+    uint32_t nameOffset = 0;    // into the name bytes
+    uint32_t nameLength = 0;
+    uint64_t size       = 0;
+    uint64_t offset     = 0;    // stored entries: file offset of the data
+    uint32_t firstChunk = 0;
+    uint32_t chunkCount = 0;    // 0 = stored
+};
+
+struct PackChunkRecord {
+    uint64_t offset     = 0;
+    uint32_t packedSize = 0;    // == rawSize: kept raw
+    uint32_t rawSize    = 0;
+};
+
+static_assert(sizeof(PackEntryRecord) == 32, "pack entry record layout");
+static_assert(sizeof(PackChunkRecord) == 16, "pack chunk record layout");
+
+namespace {
+
+constexpr uint32_t kPackMagic   = 0x4B415044;     // "DPAK"
+constexpr uint32_t kPackVersion = 1;
+
+struct PackHeader {
+    uint32_t magic       = kPackMagic;
+    uint32_t version     = kPackVersion;
+    uint32_t chunkSize   = 0;
+    uint32_t entryCount  = 0;
+    uint32_t chunkCount  = 0;
+    uint32_t reserved0   = 0;
+    uint64_t indexOffset = 0;
+    uint64_t indexSize   = 0;
+    uint64_t indexHash   = 0;
+    uint8_t  reserved[16] = {};
+};
+static_assert(sizeof(PackHeader) == 64, "pack header must stay 64 bytes");
+
+inline uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+// ===================================================================
+// AssetPack
+// ===================================================================
+
+bool AssetPack::Open(const std::string& path) {
+    Close();
+    if (!m_file.Open(path)) {
+        return false;
+    }
+
+    const uint8_t* data = m_file.GetData();
+    const uint64_t size = m_file.GetSize();
+    PackHeader header;
+    bool ok = size >= sizeof(PackHeader);
+    if (ok) {
+        std::memcpy(&header, data, sizeof(header));
+        const uint64_t tables = static_cast<uint64_t>(header.entryCount) * sizeof(PackEntryRecord) +
+                                static_cast<uint64_t>(header.chunkCount) * sizeof(PackChunkRecord);
+        ok = header.magic == kPackMagic && header.version == kPackVersion && header.chunkSize > 0 &&
+             header.indexOffset % 8 == 0 && header.indexOffset >= sizeof(PackHeader) &&
+             header.indexOffset <= size && header.indexSize <= size - header.indexOffset &&
+             tables <= header.indexSize;
+    }
+    if (ok) {
+        const uint8_t* index = data + header.indexOffset;
+        ok = utils::HashBytes64(index, static_cast<size_t>(header.indexSize)) == header.indexHash;
+        if (ok) {
+            m_entries    = reinterpret_cast<const PackEntryRecord*>(index);
+            m_chunks     = reinterpret_cast<const PackChunkRecord*>(index + header.entryCount * sizeof(PackEntryRecord));
+            m_entryCount = header.entryCount;
+            m_chunkCount = header.chunkCount;
+            m_chunkSize  = header.chunkSize;
+            m_names      = reinterpret_cast<const char*>(m_chunks + header.chunkCount);
+            m_namesSize  = static_cast<size_t>(header.indexSize -
+                                               header.entryCount * sizeof(PackEntryRecord) -
+                                               header.chunkCount * sizeof(PackChunkRecord));
+            ok = Validate(header.indexOffset);
+        }
+    }
+
+    if (!ok) {
+        DMME_LOG_ERROR("AssetPack: '{}' is not a valid pack", path);
+        Close();
+        return false;
+    }
+    DMME_LOG_INFO("AssetPack: opened '{}' ({} entries, {} chunks of {} KiB)",
+                  path, m_entryCount, m_chunkCount, m_chunkSize / 1024);
+    return true;
+}
+
+// Every range the readers trust: names inside the name bytes and
+// strictly sorted, data before the index, chunk runs that add up.
+bool AssetPack::Validate(uint64_t dataEnd) const {
+    for (uint32_t i = 0; i < m_entryCount; ++i) {
+        const PackEntryRecord& e = m_entries[i];
+        if (e.nameOffset > m_namesSize || e.nameLength > m_namesSize - e.nameOffset) {
+            return false;
+        }
+        if (i > 0) {
+            const PackEntryRecord& prev = m_entries[i - 1];
+            if (std::string_view(m_names + prev.nameOffset, prev.nameLength) >=
+                std::string_view(m_names + e.nameOffset, e.nameLength)) {
+                return false;
+            }
+        }
+
+        if (e.chunkCount == 0) {
+            if (e.offset > dataEnd || e.size > dataEnd - e.offset) {
+                return false;
+            }
+            continue;
+        }
+        if (e.firstChunk > m_chunkCount || e.chunkCount > m_chunkCount - e.firstChunk ||
+            e.size > static_cast<uint64_t>(e.chunkCount) * m_chunkSize) {
+            return false;
+        }
+        uint64_t total = 0;
+        for (uint32_t c = 0; c < e.chunkCount; ++c) {
+            const PackChunkRecord& chunk = m_chunks[e.firstChunk + c];
+            const bool last = c + 1 == e.chunkCount;
+            if (chunk.rawSize > m_chunkSize || (!last && chunk.rawSize != m_chunkSize) ||
+                chunk.packedSize > chunk.rawSize || chunk.offset > dataEnd ||
+                chunk.packedSize > dataEnd - chunk.offset) {
+                return false;
+            }
+            total += chunk.rawSize;
+        }
+        if (total != e.size) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void AssetPack::Close() {
+    m_file.Close();
+    m_entries    = nullptr;
+    m_chunks     = nullptr;
+    m_entryCount = 0;
+    m_chunkCount = 0;
+    m_chunkSize  = 0;
+    m_names      = nullptr;
+    m_namesSize  = 0;
+}
+
+int32_t AssetPack::Find(std::string_view name) const {
+    uint32_t lo = 0;
+    uint32_t hi = m_entryCount;
+    while (lo < hi) {
+        const uint32_t mid = lo + (hi - lo) / 2;
+        const PackEntryRecord& e = m_entries[mid];
+        const int order = std::string_view(m_names + e.nameOffset, e.nameLength).compare(name);
+        if (order == 0) {
+            return static_cast<int32_t>(mid);
+        }
+        if (order < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return -1;
+}
+
+PackEntryInfo AssetPack::GetInfo(uint32_t entry) const {
+    PackEntryInfo info;
+    if (entry >= m_entryCount) {
+        return info;
+    }
+    const PackEntryRecord& e = m_entries[entry];
+    info.name       = std::string_view(m_names + e.nameOffset, e.nameLength);
+    info.size       = e.size;
+    info.chunkCount = e.chunkCount;
+    info.stored     = e.chunkCount == 0;
+    info.packedSize = info.stored ? e.size : 0;
+    for (uint32_t c = 0; c < e.chunkCount; ++c) {
+        info.packedSize += m_chunks[e.firstChunk + c].packedSize;
+    }
+    return info;
+}
+
+const uint8_t* AssetPack::GetStoredData(uint32_t entry) const {
+    if (entry >= m_entryCount || m_entries[entry].chunkCount != 0) {
+        return nullptr;
+    }
+    return m_file.GetData() + m_entries[entry].offset;
+}
+
+bool AssetPack::DecodeChunk(uint32_t chunk, uint8_t* out) const {
+    const PackChunkRecord& c = m_chunks[chunk];
+    const uint8_t* src = m_file.GetData() + c.offset;
+    if (c.packedSize == c.rawSize) {
+        std::memcpy(out, src, c.rawSize);
+        return true;
+    }
+    return LzDecompress(src, c.packedSize, out, c.rawSize);
+}
+
+bool AssetPack::Read(uint32_t entry, uint8_t* out, jobs::JobSystem* jobs) const {
+    if (entry >= m_entryCount) {
+        return false;
+    }
+    const PackEntryRecord& e = m_entries[entry];
+    if (e.chunkCount == 0) {
+        if (e.size > 0) {
+            std::memcpy(out, m_file.GetData() + e.offset, static_cast<size_t>(e.size));
+        }
+        return true;
+    }
+
+    if (!jobs || e.chunkCount == 1) {
+        bool ok = true;
+        for (uint32_t c = 0; c < e.chunkCount && ok; ++c) {
+            ok = DecodeChunk(e.firstChunk + c, out + static_cast<size_t>(c) * m_chunkSize);
+        }
+        return ok;
+    }
+
+    std::atomic<bool> ok{true};
+    jobs->ParallelFor(e.chunkCount, [&](uint32_t c) {
+        if (!DecodeChunk(e.firstChunk + c, out + static_cast<size_t>(c) * m_chunkSize)) {
+            ok.store(false, std::memory_order_relaxed);
+        }
+    });
+    return ok.load();
+}
+
+bool AssetPack::ReadMany(const ReadRequest* requests, size_t count, jobs::JobSystem* jobs) const {
+    // One work item per chunk (or per stored entry), so a batch of small
+    // files spreads as well as one large file
+    struct Item {
+        uint32_t entry;
+        uint32_t chunk;     // index within the entry; ignored for stored
+        uint8_t* out;
+    };
+    std::vector<Item> items;
+    items.reserve(count);
+    for (size_t r = 0; r < count; ++r) {
+        const uint32_t entry = requests[r].entry;
+        if (entry >= m_entryCount) {
+            return false;
+        }
+        const uint32_t chunks = std::max<uint32_t>(m_entries[entry].chunkCount, 1);
+        for (uint32_t c = 0; c < chunks; ++c) {
+            items.push_back({entry, c, requests[r].out + static_cast<size_t>(c) * m_chunkSize});
+        }
+    }
+
+    std::atomic<bool> ok{true};
+    const auto run = [&](uint32_t i) {
+        const Item& item = items[i];
+        const PackEntryRecord& e = m_entries[item.entry];
+        if (e.chunkCount == 0) {
+            if (e.size > 0) {
+                std::memcpy(item.out, m_file.GetData() + e.offset, static_cast<size_t>(e.size));
+            }
+        } else if (!DecodeChunk(e.firstChunk + item.chunk, item.out)) {
+            ok.store(false, std::memory_order_relaxed);
+        }
+    };
+    if (jobs) {
+        jobs->ParallelFor(static_cast<uint32_t>(items.size()), run);
+    } else {
+        for (uint32_t i = 0; i < items.size(); ++i) {
+            run(i);
+        }
+    }
+    return ok.load();
+}
+
+// ===================================================================
+// AssetPackWriter
+// ===================================================================
+
+AssetPackWriter::AssetPackWriter(uint32_t chunkSize, uint32_t storedAlignment)
+    : m_chunkSize(std::max<uint32_t>(chunkSize, 4096))
+    , m_alignment(std::max<uint32_t>(storedAlignment, 8)) {
+}
+
+void AssetPackWriter::Add(std::string name, const uint8_t* data, size_t size, PackStoreMode mode) {
+    Pending pending;
+    pending.name = std::move(name);
+    pending.data.assign(data, data + size);
+    pending.mode = mode;
+    m_pending.push_back(std::move(pending));
+    m_rawBytes += size;
+}
+
+bool AssetPackWriter::Write(const std::string& path, jobs::JobSystem* jobs) {
+    std::sort(m_pending.begin(), m_pending.end(),
+              [](const Pending& a, const Pending& b) { return a.name < b.name; });
+    for (size_t i = 1; i < m_pending.size(); ++i) {
+        if (m_pending[i].name == m_pending[i - 1].name) {
+            DMME_LOG_ERROR("AssetPackWriter: duplicate entry '{}'", m_pending[i].name);
+            return false;
+        }
+    }
+    if (m_pending.size() > UINT32_MAX) {
+        DMME_LOG_ERROR("AssetPackWriter: too many entries ({})", m_pending.size());
+        return false;
+    }
+
+    // --- Compress every chunk of every candidate entry in parallel ---
+    struct Job {
+        uint32_t entry;
+        uint32_t chunk;
+    };
+    std::vector<Job> work;
+    std::vector<uint32_t> firstJob(m_pending.size() + 1, 0);
+    for (size_t e = 0; e < m_pending.size(); ++e) {
+        firstJob[e] = static_cast<uint32_t>(work.size());
+        const Pending& p = m_pending[e];
+        if (p.mode == PackStoreMode::Store || p.data.empty()) {
+            continue;
+        }
+        const size_t chunks = (p.data.size() + m_chunkSize - 1) / m_chunkSize;
+        for (size_t c = 0; c < chunks; ++c) {
+            work.push_back({static_cast<uint32_t>(e), static_cast<uint32_t>(c)});
+        }
+    }
+    firstJob[m_pending.size()] = static_cast<uint32_t>(work.size());
+
+    const auto rawSize = [&](uint32_t j) {
+        const size_t offset = static_cast<size_t>(work[j].chunk) * m_chunkSize;
+        return static_cast<uint32_t>(std::min<size_t>(m_chunkSize, m_pending[work[j].entry].data.size() - offset));
+    };
+
+    std::vector<std::vector<uint8_t>> packed(work.size());     // empty: keep raw
+    const auto compress = [&](uint32_t j) {
+        const Pending& p = m_pending[work[j].entry];
+        const size_t offset = static_cast<size_t>(work[j].chunk) * m_chunkSize;
+        const size_t raw    = rawSize(j);
+        std::vector<uint8_t>& out = packed[j];
+        // One byte short of raw: a chunk that does not shrink stops early
+        out.resize(raw - 1);
+        const size_t size = LzCompress(p.data.data() + offset, raw, out.data(), out.size());
+        if (size == 0) {
+            out.clear();
+        } else {
+            out.resize(size);
+        }
+        out.shrink_to_fit();
+    };
+    if (jobs) {
+        jobs->ParallelFor(static_cast<uint32_t>(work.size()), compress);
+    } else {
+        for (uint32_t j = 0; j < work.size(); ++j) {
+            compress(j);
+        }
+    }
+
+    // --- Lay out data and build the index ---
+    std::vector<PackEntryRecord> entries(m_pending.size());
+    std::vector<PackChunkRecord> chunks;
+    std::vector<uint8_t>         stored(m_pending.size(), 0);
+    std::string                  names;
+    uint64_t offset = sizeof(PackHeader);
+
+    for (size_t e = 0; e < m_pending.size(); ++e) {
+        const Pending& p = m_pending[e];
+        PackEntryRecord& record = entries[e];
+        record.nameOffset = static_cast<uint32_t>(names.size());
+        record.nameLength = static_cast<uint32_t>(p.name.size());
+        record.size       = p.data.size();
+        names += p.name;
+
+        uint64_t packedBytes = 0;
+        for (uint32_t j = firstJob[e]; j < firstJob[e + 1]; ++j) {
+            packedBytes += packed[j].empty() ? rawSize(j) : packed[j].size();
+        }
+        const bool store = firstJob[e] == firstJob[e + 1] ||
+                           (p.mode == PackStoreMode::Auto && packedBytes > record.size - record.size / 16);
+        if (store) {
+            stored[e] = 1;
+            offset = AlignUp(offset, m_alignment);
+            record.offset = offset;
+            offset += record.size;
+            continue;
+        }
+
+        record.firstChunk = static_cast<uint32_t>(chunks.size());
+        record.chunkCount = firstJob[e + 1] - firstJob[e];
+        for (uint32_t j = firstJob[e]; j < firstJob[e + 1]; ++j) {
+            PackChunkRecord chunk;
+            chunk.offset  = offset;
+            chunk.rawSize = rawSize(j);
+            chunk.packedSize = packed[j].empty() ? chunk.rawSize : static_cast<uint32_t>(packed[j].size());
+            offset += chunk.packedSize;
+            chunks.push_back(chunk);
+        }
+    }
+
+    PackHeader header;
+    header.chunkSize   = m_chunkSize;
+    header.entryCount  = static_cast<uint32_t>(entries.size());
+    header.chunkCount  = static_cast<uint32_t>(chunks.size());
+    header.indexOffset = AlignUp(offset, 8);
+
+    std::vector<uint8_t> index(entries.size() * sizeof(PackEntryRecord) +
+                               chunks.size() * sizeof(PackChunkRecord) + names.size());
+    uint8_t* cursor = index.data();
+    if (!entries.empty()) {
+        std::memcpy(cursor, entries.data(), entries.size() * sizeof(PackEntryRecord));
+        cursor += entries.size() * sizeof(PackEntryRecord);
+    }
+    if (!chunks.empty()) {
+        std::memcpy(cursor, chunks.data(), chunks.size() * sizeof(PackChunkRecord));
+        cursor += chunks.size() * sizeof(PackChunkRecord);
+    }
+    if (!names.empty()) {
+        std::memcpy(cursor, names.data(), names.size());
+    }
+    header.indexSize = index.size();
+    header.indexHash = utils::HashBytes64(index.data(), index.size());
+
+    // --- Write in layout order ---
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        DMME_LOG_ERROR("AssetPackWriter: cannot open {}", path);
+        return false;
+    }
+    uint64_t written = 0;
+    const auto put = [&](const void* data, uint64_t size) {
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        written += size;
+    };
+    const auto padTo = [&](uint64_t target) {
+        static const char zeros[4096] = {};
+        while (written < target) {
+            put(zeros, std::min<uint64_t>(sizeof(zeros), target - written));
+        }
+    };
+
+    put(&header, sizeof(header));
+    for (size_t e = 0; e < m_pending.size(); ++e) {
+        const Pending& p = m_pending[e];
+        if (stored[e]) {
+            padTo(entries[e].offset);
+            put(p.data.data(), p.data.size());
+            continue;
+        }
+        for (uint32_t j = firstJob[e]; j < firstJob[e + 1]; ++j) {
+            const PackChunkRecord& chunk = chunks[entries[e].firstChunk + (j - firstJob[e])];
+            if (packed[j].empty()) {
+                put(p.data.data() + static_cast<size_t>(work[j].chunk) * m_chunkSize, chunk.rawSize);
+            } else {
+                put(packed[j].data(), packed[j].size());
+            }
+        }
+    }
+    padTo(header.indexOffset);
+    put(index.data(), index.size());
+
+    if (!file) {
+        DMME_LOG_ERROR("AssetPackWriter: write failed for {}", path);
+        return false;
+    }
+    m_packBytes = written;
+    DMME_LOG_INFO("AssetPackWriter: wrote '{}' ({} entries, {} chunks, {:.1f} MiB -> {:.1f} MiB)",
+                  path, entries.size(), chunks.size(), m_rawBytes / 1048576.0, m_packBytes / 1048576.0);
+    return true;
+}
+
+} // namespace assets
+} // namespace core
+} // namespace dmme
\ No newline at end of file
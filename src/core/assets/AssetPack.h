@@ -0,0 +1,174 @@
+#pragma once
+
+#include "MappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dmme {
+namespace core {
+
+namespace jobs {
+class JobSystem;
+}
+
+namespace assets {
+
+struct PackEntryRecord;
+struct PackChunkRecord;
+
+// ------------------------------------------------------------------
+// Pack layout
+// ------------------------------------------------------------------
+
+// File: a 64-byte header, entry data, then the index (entries sorted by
+// name, the chunk table and the name bytes) whose hash the header
+// carries. All fields little-endian.
+//
+// An entry is either compressed, split into chunks of the pack's chunk
+// size that are LZ-compressed independently (a chunk that does not
+// shrink is kept raw), or stored: one contiguous uncompressed range
+// aligned to the writer's stored alignment (a page by default), usable
+// in place from the mapped pack.
+
+constexpr uint32_t kPackDefaultChunkSize = 64 * 1024;
+constexpr uint32_t kPackDefaultAlignment = 4096;
+
+struct PackEntryInfo {
+    std::string_view name;
+    uint64_t size        = 0;
+    uint64_t packedSize  = 0;   // bytes in the pack (chunks or stored range)
+    uint32_t chunkCount  = 0;   // 0 for stored entries
+    bool     stored      = false;
+};
+
+enum class PackStoreMode : uint8_t {
+    Auto     = 0,   // compress unless the entry saves under 1/16 of its size
+    Compress = 1,
+    Store    = 2    // keep uncompressed and aligned (mapped in place)
+};
+
+// ------------------------------------------------------------------
+// AssetPack
+// ------------------------------------------------------------------
+
+// AssetPack reads a pack file: one open and one mapping instead of a
+// file open per asset.
+//
+// Open maps the file and checks the header and index; lookups binary
+// search the sorted name table without allocating. Stored entries are
+// returned in place by GetStoredData; Read copies or decompresses an
+// entry into caller memory, spreading its chunks over the JobSystem
+// when it has several, and ReadMany does the same for a batch of
+// entries in one dispatch so many small assets still fill the workers.
+//
+// Reads are const and may run on several threads at once.
+//
+// Usage:
+//   AssetPack pack;
+//   if (pack.Open("assets.pak")) {
+//       int32_t entry = pack.Find("models/mascot.pmx");
+//       std::vector<uint8_t> data(pack.GetInfo(entry).size);
+//       pack.Read(entry, data.data(), &jobs);
+//   }
+
+class AssetPack {
+public:
+    AssetPack() = default;
+    ~AssetPack() = default;
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return m_file.IsOpen(); }
+
+    uint32_t GetEntryCount() const { return m_entryCount; }
+    uint32_t GetChunkSize() const  { return m_chunkSize; }
+
+    // Entry index, or -1. Names use '/' separators.
+    int32_t       Find(std::string_view name) const;
+    PackEntryInfo GetInfo(uint32_t entry) const;
+
+    // In-place bytes of a stored entry, else nullptr
+    const uint8_t* GetStoredData(uint32_t entry) const;
+
+    // Copy / decompress the whole entry into out (GetInfo(entry).size
+    // bytes). jobs may be null. Returns false on damaged data.
+    bool Read(uint32_t entry, uint8_t* out, jobs::JobSystem* jobs) const;
+
+    struct ReadRequest {
+        uint32_t entry = 0;
+        uint8_t* out   = nullptr;
+    };
+    // Read several entries in one parallel pass; false if any failed
+    bool ReadMany(const ReadRequest* requests, size_t count, jobs::JobSystem* jobs) const;
+
+private:
+    bool Validate(uint64_t dataEnd) const;
+    bool DecodeChunk(uint32_t chunk, uint8_t* out) const;
+
+    MappedFile             m_file;
+    const PackEntryRecord* m_entries    = nullptr;
+    const PackChunkRecord* m_chunks     = nullptr;
+    uint32_t               m_entryCount = 0;
+    uint32_t               m_chunkCount = 0;
+    uint32_t               m_chunkSize  = 0;
+    const char*            m_names      = nullptr;
+    size_t                 m_namesSize  = 0;
+};
+
+// ------------------------------------------------------------------
+// AssetPackWriter
+// ------------------------------------------------------------------
+
+// Builds a pack in memory and writes it in one go; chunks are
+// compressed in parallel on the JobSystem. Used by the dmme_packer
+// tool.
+//
+// Usage:
+//   AssetPackWriter writer;
+//   writer.Add("textures/face.png", bytes, PackStoreMode::Store);
+//   writer.Add("models/mascot.pmx", pmxBytes);
+//   writer.Write("assets.pak", &jobs);
+
+class AssetPackWriter {
+public:
+    explicit AssetPackWriter(uint32_t chunkSize = kPackDefaultChunkSize,
+                             uint32_t storedAlignment = kPackDefaultAlignment);
+
+    AssetPackWriter(const AssetPackWriter&) = delete;
+    AssetPackWriter& operator=(const AssetPackWriter&) = delete;
+
+    // Queue an entry (the data is copied). Names use '/' separators.
+    void Add(std::string name, const uint8_t* data, size_t size,
+             PackStoreMode mode = PackStoreMode::Auto);
+
+    // Compress and write everything added. Fails on duplicate names.
+    bool Write(const std::string& path, jobs::JobSystem* jobs);
+
+    size_t   GetEntryCount() const { return m_pending.size(); }
+    uint64_t GetRawBytes() const   { return m_rawBytes; }
+    uint64_t GetPackBytes() const  { return m_packBytes; }    // after Write
+
+private:
+    struct Pending {
+        std::string          name;
+        std::vector<uint8_t> data;
+        PackStoreMode        mode = PackStoreMode::Auto;
+    };
+
+    uint32_t             m_chunkSize;
+    uint32_t             m_alignment;
+    std::vector<Pending> m_pending;
+    uint64_t             m_rawBytes  = 0;
+    uint64_t             m_packBytes = 0;
+};
+
+} // namespace assets
+} // namespace core
+} // namespace dmme
\ No newline at end of file
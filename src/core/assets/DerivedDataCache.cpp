@@ -0,0 +1,231 @@
+#include "DerivedDataCache.h"
+#include "utils/Clock.h"
+#include "utils/Hash.h"
+#include "utils/Logger.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+namespace dmme {
+namespace core {
+namespace assets {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr uint32_t kEntryMagic   = MakeFourCC('D', 'D', 'C', '0');
+constexpr uint32_t kEntryLayout  = 1;
+constexpr size_t   kHeaderBytes  = 64;      // payload starts here, cache-line aligned
+
+struct EntryHeader {
+    uint32_t magic       = kEntryMagic;
+    uint32_t layout      = kEntryLayout;
+    uint32_t version     = 0;
+    uint32_t kind        = 0;
+    uint64_t key         = 0;
+    uint64_t payloadSize = 0;
+    uint64_t payloadHash = 0;
+    uint8_t  reserved[24] = {};
+};
+static_assert(sizeof(EntryHeader) == kHeaderBytes, "cache entry header must stay 64 bytes");
+
+// Kind as a directory name: the four characters when printable
+std::string KindName(uint32_t kind) {
+    char name[9];
+    bool printable = true;
+    for (int i = 0; i < 4; ++i) {
+        const char c = static_cast<char>((kind >> (i * 8)) & 0xFF);
+        if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'))) {
+            printable = false;
+        }
+        name[i] = c;
+    }
+    if (!printable) {
+        std::snprintf(name, sizeof(name), "%08x", kind);
+        return name;
+    }
+    return std::string(name, 4);
+}
+
+} // namespace
+
+// ===================================================================
+// Setup
+// ===================================================================
+
+bool DerivedDataCache::Open(const std::string& directory, uint32_t version) {
+    std::error_code ec;
+    fs::create_directories(fs::u8path(directory), ec);
+    if (ec) {
+        DMME_LOG_ERROR("DerivedDataCache: cannot create '{}': {}", directory, ec.message());
+        m_directory.clear();
+        return false;
+    }
+    m_directory = directory;
+    m_version   = version;
+    DMME_LOG_INFO("DerivedDataCache: using '{}' (version {})", directory, version);
+    return true;
+}
+
+DerivedDataKey DerivedDataCache::MakeKey(uint32_t kind, uint32_t kindVersion,
+                                         const void* source, size_t sourceSize,
+                                         std::string_view settings) {
+    // Chain the parts through the seed so no concatenation is needed
+    const uint32_t prefix[2] = {kind, kindVersion};
+    uint64_t h = utils::HashBytes64(prefix, sizeof(prefix));
+    h = utils::HashBytes64(settings.data(), settings.size(), h);
+    h = utils::HashBytes64(source, sourceSize, h);
+
+    DerivedDataKey key;
+    key.kind = kind;
+    key.hash = h;
+    return key;
+}
+
+std::string DerivedDataCache::GetEntryPath(const DerivedDataKey& key) const {
+    char version[16], name[24];
+    std::snprintf(version, sizeof(version), "v%u", m_version);
+    std::snprintf(name, sizeof(name), "%016llx.ddc", static_cast<unsigned long long>(key.hash));
+    return (fs::u8path(m_directory) / version / KindName(key.kind) / name).u8string();
+}
+
+DerivedDataStats DerivedDataCache::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    return m_stats;
+}
+
+void DerivedDataCache::ResetStats() {
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    m_stats = DerivedDataStats();
+}
+
+// ===================================================================
+// Find
+// ===================================================================
+
+bool DerivedDataCache::Find(const DerivedDataKey& key, DerivedDataBlob& out) {
+    const uint64_t start = utils::MonotonicMicros();
+    out.Reset();
+    if (!IsOpen() || !key.IsValid()) {
+        return false;
+    }
+
+    const std::string path = GetEntryPath(key);
+    DerivedDataBlob blob;
+    bool damaged = false;
+    bool valid = false;
+
+    std::error_code ec;
+    if (fs::is_regular_file(fs::u8path(path), ec) && blob.m_file.Open(path)) {
+        const size_t size = blob.m_file.GetSize();
+        EntryHeader header;
+        damaged = size < kHeaderBytes;
+        if (!damaged) {
+            std::memcpy(&header, blob.m_file.GetData(), kHeaderBytes);
+            damaged = header.magic != kEntryMagic || header.payloadSize != size - kHeaderBytes;
+        }
+        // A well-formed header for another layout, version or key is
+        // some other build's entry, not damage: miss and leave it
+        valid = !damaged && header.layout == kEntryLayout && header.version == m_version &&
+                header.kind == key.kind && header.key == key.hash;
+        if (valid && m_verifyChecksums) {
+            damaged = utils::HashBytes64(blob.m_file.GetData() + kHeaderBytes,
+                                         static_cast<size_t>(header.payloadSize)) != header.payloadHash;
+            valid = !damaged;
+        }
+        if (valid) {
+            blob.m_offset = kHeaderBytes;
+            blob.m_size   = static_cast<size_t>(header.payloadSize);
+        }
+    }
+
+    if (damaged) {
+        // Drop it so the producer rewrites it
+        DMME_LOG_WARN("DerivedDataCache: discarding damaged entry '{}'", path);
+        blob.Reset();
+        fs::remove(fs::u8path(path), ec);
+    }
+
+    const float elapsed = utils::MicrosToMs(utils::MonotonicMicros() - start);
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    m_stats.findMs += elapsed;
+    if (!valid) {
+        ++m_stats.misses;
+        if (damaged) {
+            ++m_stats.rejected;
+        }
+        return false;
+    }
+    ++m_stats.hits;
+    m_stats.bytesMapped += blob.m_size;
+    out = std::move(blob);
+    return true;
+}
+
+// ===================================================================
+// Store
+// ===================================================================
+
+bool DerivedDataCache::Store(const DerivedDataKey& key, const void* data, size_t size) {
+    const uint64_t start = utils::MonotonicMicros();
+    if (!IsOpen() || !key.IsValid()) {
+        return false;
+    }
+
+    const fs::path path = fs::u8path(GetEntryPath(key));
+
+    // Unique within the process; concurrent processes differ by thread
+    // id often enough, and a lost rename race only loses a cache write
+    static std::atomic<uint32_t> s_serial{0};
+    const size_t tag = std::hash<std::thread::id>()(std::this_thread::get_id()) ^ s_serial.fetch_add(1);
+    fs::path temp = path;
+    temp += ".tmp" + std::to_string(tag);
+
+    EntryHeader header;
+    header.version     = m_version;
+    header.kind        = key.kind;
+    header.key         = key.hash;
+    header.payloadSize = size;
+    header.payloadHash = utils::HashBytes64(data, size);
+
+    std::error_code ec;
+    fs::create_directories(path.parent_path(), ec);
+    bool ok = !ec;
+    if (ok) {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        file.close();
+        ok = !file.fail();
+    }
+    if (ok) {
+        fs::rename(temp, path, ec);
+        ok = !ec;
+    }
+    if (!ok) {
+        DMME_LOG_WARN("DerivedDataCache: cannot write '{}'{}", path.u8string(),
+                      ec ? ": " + ec.message() : std::string());
+        fs::remove(temp, ec);
+    }
+
+    const float elapsed = utils::MicrosToMs(utils::MonotonicMicros() - start);
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    m_stats.storeMs += elapsed;
+    if (!ok) {
+        ++m_stats.storeFailures;
+        return false;
+    }
+    ++m_stats.stores;
+    m_stats.bytesStored += size;
+    return true;
+}
+
+} // namespace assets
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "MappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace dmme {
+namespace core {
+namespace assets {
+
+// ------------------------------------------------------------------
+// Keys
+// ------------------------------------------------------------------
+
+constexpr uint32_t MakeFourCC(char a, char b, char c, char d) {
+    return static_cast<uint32_t>(static_cast<uint8_t>(a)) |
+           static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8 |
+           static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16 |
+           static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24;
+}
+
+// Identifies one processed form: what produced it (kind) and a hash of
+// everything it was produced from.
+struct DerivedDataKey {
+    uint32_t kind = 0;
+    uint64_t hash = 0;
+
+    bool IsValid() const { return kind != 0; }
+};
+
+struct DerivedDataStats {
+    uint64_t hits     = 0;
+    uint64_t misses   = 0;      // no entry
+    uint64_t rejected = 0;      // entry damaged: bad magic, size or checksum (also a miss)
+    uint64_t stores   = 0;
+    uint64_t storeFailures = 0;
+
+    uint64_t bytesMapped = 0;   // payload bytes handed out by hits
+    uint64_t bytesStored = 0;
+
+    float    findMs  = 0.0f;    // total time in Find, including checksums
+    float    storeMs = 0.0f;
+};
+
+// ------------------------------------------------------------------
+// DerivedDataBlob
+// ------------------------------------------------------------------
+
+// A cache hit: the processed payload, mapped straight from the cache
+// file. The pointer is 64-byte aligned and valid while the blob lives.
+class DerivedDataBlob {
+public:
+    DerivedDataBlob() = default;
+
+    DerivedDataBlob(const DerivedDataBlob&) = delete;
+    DerivedDataBlob& operator=(const DerivedDataBlob&) = delete;
+    DerivedDataBlob(DerivedDataBlob&&) noexcept = default;
+    DerivedDataBlob& operator=(DerivedDataBlob&&) noexcept = default;
+
+    bool           IsValid() const { return m_file.IsOpen(); }
+    const uint8_t* GetData() const { return m_file.IsOpen() ? m_file.GetData() + m_offset : nullptr; }
+    size_t         GetSize() const { return m_size; }
+
+    void Reset() { m_file.Close(); m_offset = 0; m_size = 0; }
+
+private:
+    friend class DerivedDataCache;
+
+    MappedFile m_file;
+    size_t     m_offset = 0;
+    size_t     m_size   = 0;
+};
+
+// ------------------------------------------------------------------
+// DerivedDataCache
+// ------------------------------------------------------------------
+
+// DerivedDataCache keeps the processed runtime form of source assets
+// on disk so warm starts skip parsing and baking.
+//
+// A producer builds a key from its kind, its own format version, the
+// source bytes and the import settings (MakeKey), asks Find for it and
+// on a miss processes the source and Stores the result. Because the key
+// covers the source content, edited sources simply miss; nothing is
+// invalidated by timestamps.
+//
+// Each entry is one file, <directory>/v<version>/<kind>/<hash>.ddc: a
+// 64-byte header (magic, layout and cache version, kind, key, payload
+// size and payload hash) followed by the payload. Find maps the file
+// and hands out the payload in place after checking the header and,
+// unless disabled, the payload hash. Damaged entries (bad magic, size
+// or checksum) are deleted and count as misses. Keeping the version in
+// the path lets builds with different versions share one directory
+// without dropping each other's entries. Store writes to a temporary
+// file and renames it over the entry, so readers never see a partial
+// file.
+//
+// Find and Store may be called from any thread (asset workers).
+//
+// Usage:
+//   DerivedDataCache cache;
+//   cache.Open(cacheDir, kEngineCacheVersion);
+//   DerivedDataKey key = DerivedDataCache::MakeKey(kind, kindVersion, src, srcSize, settings);
+//   DerivedDataBlob blob;
+//   if (!cache.Find(key, blob)) {
+//       std::vector<uint8_t> processed = Process(src, srcSize);
+//       cache.Store(key, processed.data(), processed.size());
+//   }
+
+class DerivedDataCache {
+public:
+    DerivedDataCache() = default;
+    ~DerivedDataCache() = default;
+
+    DerivedDataCache(const DerivedDataCache&) = delete;
+    DerivedDataCache& operator=(const DerivedDataCache&) = delete;
+
+    // Use directory (UTF-8, created if missing). Entries are kept per
+    // version, so bumping it starts an empty cache beside the old one.
+    bool Open(const std::string& directory, uint32_t version);
+    bool IsOpen() const { return !m_directory.empty(); }
+
+    // Hash of kind, kindVersion, settings and source bytes
+    static DerivedDataKey MakeKey(uint32_t kind, uint32_t kindVersion,
+                                  const void* source, size_t sourceSize,
+                                  std::string_view settings = {});
+
+    // Map the entry for key into out. False on a miss.
+    bool Find(const DerivedDataKey& key, DerivedDataBlob& out);
+
+    bool Store(const DerivedDataKey& key, const void* data, size_t size);
+
+    // Skip payload hashing on Find (header checks still apply)
+    void SetVerifyChecksums(bool verify) { m_verifyChecksums = verify; }
+
+    std::string      GetEntryPath(const DerivedDataKey& key) const;
+    DerivedDataStats GetStats() const;
+    void             ResetStats();
+
+private:
+    std::string m_directory;
+    uint32_t    m_version = 0;
+    bool        m_verifyChecksums = true;
+
+    mutable std::mutex m_statsMutex;
+    DerivedDataStats   m_stats;
+};
+
+} // namespace assets
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,246 @@
+#include "Lz.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace dmme {
+namespace core {
+namespace assets {
+
+namespace {
+
+constexpr size_t   kMinMatch     = 4;
+constexpr size_t   kLastLiterals = 5;       // a block ends with at least this many literals
+constexpr size_t   kSearchMargin = 12;      // no match starts this close to the end
+constexpr size_t   kMaxOffset    = 65535;
+constexpr uint32_t kHashBits     = 14;      // 64 KiB table, fits in L2 beside the chunk
+constexpr uint32_t kSkipTrigger  = 6;       // after 2^6 misses, step 2 bytes, then 3...
+
+inline uint32_t Read32(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint64_t Read64(const uint8_t* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint32_t HashSequence(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - kHashBits);
+}
+
+// Remainder of a length whose nibble was 15
+inline uint8_t* WriteLength(uint8_t* op, size_t length) {
+    while (length >= 255) {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = static_cast<uint8_t>(length);
+    return op;
+}
+
+inline bool ReadLength(const uint8_t*& ip, const uint8_t* end, size_t& length) {
+    uint8_t byte;
+    do {
+        if (ip >= end) {
+            return false;
+        }
+        byte = *ip++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+// Bytes WriteLength emits after a nibble for length
+inline size_t LengthBytes(size_t length) {
+    return length >= 15 ? (length - 15) / 255 + 1 : 0;
+}
+
+} // namespace
+
+// ===================================================================
+// Compression
+// ===================================================================
+
+size_t LzCompressBound(size_t size) {
+    return size + size / 255 + 16;
+}
+
+size_t LzCompress(const uint8_t* src, size_t size, uint8_t* dst, size_t capacity) {
+    const uint8_t* const end = src + size;
+    const uint8_t*       ip     = src;
+    const uint8_t*       anchor = src;
+    uint8_t*             op     = dst;
+    uint8_t* const       oend   = dst + capacity;
+
+    if (size > kSearchMargin) {
+        // Positions relative to src; a stale or zero entry is rejected
+        // by the compare below
+        uint32_t table[1u << kHashBits] = {};
+        const uint8_t* const matchLimit = end - kLastLiterals;
+        const uint8_t* const searchEnd  = end - kSearchMargin;
+
+        while (ip < searchEnd) {
+            // Find a 4-byte match, skipping faster through data that
+            // keeps missing
+            const uint8_t* match = nullptr;
+            uint32_t attempts = 1u << kSkipTrigger;
+            for (;;) {
+                const uint32_t sequence = Read32(ip);
+                const uint32_t h = HashSequence(sequence);
+                match = src + table[h];
+                table[h] = static_cast<uint32_t>(ip - src);
+                if (match < ip && static_cast<size_t>(ip - match) <= kMaxOffset &&
+                    Read32(match) == sequence) {
+                    break;
+                }
+                ip += attempts++ >> kSkipTrigger;
+                if (ip >= searchEnd) {
+                    match = nullptr;
+                    break;
+                }
+            }
+            if (!match) {
+                break;
+            }
+
+            while (ip > anchor && match > src && ip[-1] == match[-1]) {
+                --ip;
+                --match;
+            }
+            const uint8_t* p = ip + kMinMatch;
+            const uint8_t* m = match + kMinMatch;
+            while (p + 8 <= matchLimit && Read64(p) == Read64(m)) {
+                p += 8;
+                m += 8;
+            }
+            while (p < matchLimit && *p == *m) {
+                ++p;
+                ++m;
+            }
+
+            const size_t literals   = static_cast<size_t>(ip - anchor);
+            const size_t matchExtra = static_cast<size_t>(p - ip) - kMinMatch;
+            const size_t sequenceBytes = 1 + LengthBytes(literals) + literals + 2 + LengthBytes(matchExtra);
+            if (sequenceBytes > static_cast<size_t>(oend - op)) {
+                return 0;
+            }
+
+            uint8_t* token = op++;
+            *token = static_cast<uint8_t>((std::min<size_t>(literals, 15) << 4) |
+                                          std::min<size_t>(matchExtra, 15));
+            if (literals >= 15) {
+                op = WriteLength(op, literals - 15);
+            }
+            std::memcpy(op, anchor, literals);
+            op += literals;
+            const size_t offset = static_cast<size_t>(ip - match);
+            *op++ = static_cast<uint8_t>(offset & 0xFF);
+            *op++ = static_cast<uint8_t>(offset >> 8);
+            if (matchExtra >= 15) {
+                op = WriteLength(op, matchExtra - 15);
+            }
+
+            ip = anchor = p;
+            if (ip < searchEnd) {
+                // Index inside the match too, so the next one can start there
+                table[HashSequence(Read32(ip - 2))] = static_cast<uint32_t>(ip - 2 - src);
+            }
+        }
+    }
+
+    // Trailing literals
+    const size_t literals = static_cast<size_t>(end - anchor);
+    if (1 + LengthBytes(literals) + literals > static_cast<size_t>(oend - op)) {
+        return 0;
+    }
+    *op++ = static_cast<uint8_t>(std::min<size_t>(literals, 15) << 4);
+    if (literals >= 15) {
+        op = WriteLength(op, literals - 15);
+    }
+    if (literals > 0) {
+        std::memcpy(op, anchor, literals);
+    }
+    op += literals;
+    return static_cast<size_t>(op - dst);
+}
+
+// ===================================================================
+// Decompression
+// ===================================================================
+
+bool LzDecompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) {
+    const uint8_t*       ip   = src;
+    const uint8_t* const iend = src + srcSize;
+    uint8_t*             op   = dst;
+    uint8_t* const       oend = dst + dstSize;
+
+    for (;;) {
+        if (ip >= iend) {
+            return false;
+        }
+        const uint8_t token = *ip++;
+
+        size_t literals = token >> 4;
+        if (literals == 15 && !ReadLength(ip, iend, literals)) {
+            return false;
+        }
+        if (literals > static_cast<size_t>(iend - ip) || literals > static_cast<size_t>(oend - op)) {
+            return false;
+        }
+        if (literals > 0) {
+            std::memcpy(op, ip, literals);
+        }
+        ip += literals;
+        op += literals;
+
+        if (ip == iend) {
+            return op == oend;      // last sequence: literals only
+        }
+
+        if (iend - ip < 2) {
+            return false;
+        }
+        const size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - dst)) {
+            return false;
+        }
+
+        size_t length = token & 15;
+        if (length == 15 && !ReadLength(ip, iend, length)) {
+            return false;
+        }
+        length += kMinMatch;
+        if (length > static_cast<size_t>(oend - op)) {
+            return false;
+        }
+
+        const uint8_t* match = op - offset;
+        if (offset >= 8 && length + 8 <= static_cast<size_t>(oend - op)) {
+            // 8-byte steps never read bytes this copy has yet to write;
+            // the last step may write up to 7 bytes past the match
+            uint8_t* const copyEnd = op + length;
+            do {
+                std::memcpy(op, match, 8);
+                op    += 8;
+                match += 8;
+            } while (op < copyEnd);
+            op = copyEnd;
+        } else {
+            // Overlapping (run-length style) or near the end: byte order
+            // matters
+            for (size_t i = 0; i < length; ++i) {
+                op[i] = match[i];
+            }
+            op += length;
+        }
+    }
+}
+
+} // namespace assets
+} // namespace core
+} // namespace dmme
\ No newline at end of file
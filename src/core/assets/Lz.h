@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dmme {
+namespace core {
+namespace assets {
+
+// Built-in LZ codec for asset packs: byte-oriented LZ77 in the LZ4
+// block style, favouring decode speed over ratio.
+//
+// A block is a run of sequences. Each starts with a token byte (high
+// nibble: literal count, low nibble: match length - 4; 15 means more
+// length bytes follow, each adding up to 255), then the literals, then
+// a 16-bit little-endian match offset and any match length bytes. The
+// last sequence has literals only. Blocks are independent, so a pack
+// can decompress its chunks in any order and on any thread.
+//
+// The decoder checks every length and offset against both buffers;
+// damaged input fails instead of reading or writing out of bounds.
+
+// Worst-case compressed size of size input bytes
+size_t LzCompressBound(size_t size);
+
+// Compress src into dst. Returns the compressed size, or 0 when it
+// would not fit in capacity. Capacity is checked against the exact
+// bytes written, so a capacity of size - 1 compresses only what
+// shrinks; LzCompressBound always succeeds.
+size_t LzCompress(const uint8_t* src, size_t size, uint8_t* dst, size_t capacity);
+
+// Decompress exactly dstSize bytes. Returns false on malformed input
+// or a size mismatch.
+bool LzDecompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+
+} // namespace assets
+} // namespace core
+} // namespace dmme
\ No newline at end of file
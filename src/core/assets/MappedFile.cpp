@@ -0,0 +1,199 @@
+#include "MappedFile.h"
+#include "utils/Logger.h"
+
+#include <algorithm>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dmme {
+namespace core {
+namespace assets {
+
+// ===================================================================
+// Construction / Move
+// ===================================================================
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    MoveFrom(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        MoveFrom(other);
+    }
+    return *this;
+}
+
+void MappedFile::MoveFrom(MappedFile& other) noexcept {
+    m_data = other.m_data;
+    m_size = other.m_size;
+    other.m_data = nullptr;
+    other.m_size = 0;
+#if defined(_WIN32)
+    m_file    = other.m_file;
+    m_mapping = other.m_mapping;
+    other.m_file    = nullptr;
+    other.m_mapping = nullptr;
+#else
+    m_fd = other.m_fd;
+    other.m_fd = -1;
+#endif
+}
+
+#if defined(_WIN32)
+
+// ===================================================================
+// Win32
+// ===================================================================
+
+bool MappedFile::Open(const std::string& path) {
+    Close();
+
+    const int wideLength = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+    if (wideLength <= 0) {
+        DMME_LOG_ERROR("MappedFile: invalid UTF-8 path '{}'", path);
+        return false;
+    }
+    std::wstring widePath(static_cast<size_t>(wideLength - 1), L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &widePath[0], wideLength);
+
+    HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        DMME_LOG_ERROR("MappedFile: cannot open '{}' (error {})", path, GetLastError());
+        return false;
+    }
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0) {
+        DMME_LOG_ERROR("MappedFile: '{}' is empty or unreadable", path);
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        DMME_LOG_ERROR("MappedFile: CreateFileMapping failed for '{}' (error {})",
+                       path, GetLastError());
+        CloseHandle(file);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        DMME_LOG_ERROR("MappedFile: MapViewOfFile failed for '{}' (error {})",
+                       path, GetLastError());
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_file    = file;
+    m_mapping = mapping;
+    m_data    = static_cast<const uint8_t*>(view);
+    m_size    = static_cast<size_t>(size.QuadPart);
+    return true;
+}
+
+void MappedFile::Close() {
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping) {
+        CloseHandle(static_cast<HANDLE>(m_mapping));
+    }
+    if (m_file) {
+        CloseHandle(static_cast<HANDLE>(m_file));
+    }
+    m_data    = nullptr;
+    m_size    = 0;
+    m_mapping = nullptr;
+    m_file    = nullptr;
+}
+
+void MappedFile::Prefetch(size_t offset, size_t size) const {
+    if (!m_data || offset >= m_size) return;
+
+    WIN32_MEMORY_RANGE_ENTRY range;
+    range.VirtualAddress = const_cast<uint8_t*>(m_data) + offset;
+    range.NumberOfBytes  = std::min(size, m_size - offset);
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+
+#else
+
+// ===================================================================
+// POSIX
+// ===================================================================
+
+bool MappedFile::Open(const std::string& path) {
+    Close();
+
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        DMME_LOG_ERROR("MappedFile: cannot open '{}': {}", path, std::strerror(errno));
+        return false;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        DMME_LOG_ERROR("MappedFile: '{}' is empty or unreadable", path);
+        close(fd);
+        return false;
+    }
+
+    const size_t size = static_cast<size_t>(st.st_size);
+    void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (view == MAP_FAILED) {
+        DMME_LOG_ERROR("MappedFile: mmap failed for '{}': {}", path, std::strerror(errno));
+        close(fd);
+        return false;
+    }
+
+    m_fd   = fd;
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = size;
+    return true;
+}
+
+void MappedFile::Close() {
+    if (m_data) {
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+    if (m_fd >= 0) {
+        close(m_fd);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_fd   = -1;
+}
+
+void MappedFile::Prefetch(size_t offset, size_t size) const {
+    if (!m_data || offset >= m_size) return;
+
+    // madvise wants a page-aligned start
+    const size_t page  = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t start = offset & ~(page - 1);
+    const size_t end   = std::min(m_size, offset + size);
+    madvise(const_cast<uint8_t*>(m_data) + start, end - start, MADV_WILLNEED);
+}
+
+#endif
+
+} // namespace assets
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace dmme {
+namespace core {
+namespace assets {
+
+// MappedFile maps a whole file read-only into the address space.
+//
+// Pages are loaded by the OS on first touch and shared with the file
+// cache, so parsers can hand out pointers into GetData() instead of
+// copying. Those pointers stay valid until Close() or destruction.
+//
+// Usage:
+//   MappedFile file;
+//   if (file.Open("model.pmx")) {
+//       Parse(file.GetData(), file.GetSize());
+//   }
+
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // Map path (UTF-8). Empty files cannot be mapped and fail.
+    bool Open(const std::string& path);
+    void Close();
+
+    bool           IsOpen() const  { return m_data != nullptr; }
+    const uint8_t* GetData() const { return m_data; }
+    size_t         GetSize() const { return m_size; }
+
+    // Ask the OS to start reading the range in (parsers that walk
+    // the file front to back call this once up front)
+    void Prefetch(size_t offset, size_t size) const;
+
+private:
+    void MoveFrom(MappedFile& other) noexcept;
+
+    const uint8_t* m_data = nullptr;
+    size_t         m_size = 0;
+
+#if defined(_WIN32)
+    void* m_file    = nullptr;   // HANDLE
+    void* m_mapping = nullptr;   // HANDLE
+#else
+    int   m_fd      = -1;
+#endif
+};
+
+} // namespace assets
+} // namespace core
+} // namespace dmme
\ No newline at end of file
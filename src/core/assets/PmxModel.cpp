@@ -0,0 +1,1121 @@
+#include "PmxModel.h"
+#include "core/jobs/JobSystem.h"
+#include "utils/Clock.h"
+#include "utils/Logger.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace dmme {
+namespace core {
+namespace assets {
+
+static_assert(sizeof(PmxGroupMorphOffset)  == 8,  "must match the PMX record");
+static_assert(sizeof(PmxVertexMorphOffset) == 16, "must match the PMX record");
+static_assert(sizeof(PmxBoneMorphOffset)   == 32, "must match the PMX record");
+static_assert(sizeof(PmxUvMorphOffset)     == 20, "must match the PMX record");
+
+namespace {
+
+// Vertices per transcode job
+constexpr uint32_t kVertexChunk = 16384;
+
+// Sanity cap on table counts (a corrupt count must not size the arena)
+constexpr uint32_t kMaxTableCount = 1u << 26;
+
+// Fixed section jobs; vertex chunk jobs follow
+enum SectionJob : uint32_t {
+    kJobMaterials = 0,    // model info, textures, materials
+    kJobBones     = 1,
+    kJobMorphs    = 2,
+    kJobIndices   = 3,
+    kJobVertices  = 4
+};
+
+// ===================================================================
+// Reader -- bounds-checked little-endian cursor
+// ===================================================================
+
+// Out-of-range reads set the failed flag and return zeros, so parse
+// loops only need to check Failed() at the end of a record.
+class Reader {
+public:
+    Reader(const uint8_t* data, size_t size, size_t offset = 0)
+        : m_data(data), m_size(size), m_offset(offset) {}
+
+    size_t         GetOffset() const  { return m_offset; }
+    const uint8_t* GetCurrent() const { return m_data + m_offset; }
+    bool           Failed() const     { return m_failed; }
+
+    const uint8_t* Take(size_t n) {
+        if (m_failed || n > m_size - m_offset) {
+            m_failed = true;
+            return nullptr;
+        }
+        const uint8_t* p = m_data + m_offset;
+        m_offset += n;
+        return p;
+    }
+
+    void Skip(size_t n) { Take(n); }
+
+    template <typename T>
+    T Read() {
+        T value{};
+        if (const uint8_t* p = Take(sizeof(T))) {
+            std::memcpy(&value, p, sizeof(T));
+        }
+        return value;
+    }
+
+    void ReadFloats(float* out, size_t n) {
+        if (const uint8_t* p = Take(n * sizeof(float))) {
+            std::memcpy(out, p, n * sizeof(float));
+        } else {
+            std::fill(out, out + n, 0.0f);
+        }
+    }
+
+    // Bone / texture / material / morph / rigid body index: signed
+    int32_t ReadIndex(uint8_t size) {
+        switch (size) {
+            case 1:  return Read<int8_t>();
+            case 2:  return Read<int16_t>();
+            default: return Read<int32_t>();
+        }
+    }
+
+    // Vertex index: unsigned when 1 or 2 bytes wide
+    int32_t ReadVertexIndex(uint8_t size) {
+        switch (size) {
+            case 1:  return Read<uint8_t>();
+            case 2:  return Read<uint16_t>();
+            default: return Read<int32_t>();
+        }
+    }
+
+    // Table count: non-negative int32, capped
+    uint32_t ReadCount() {
+        const int32_t count = Read<int32_t>();
+        if (count < 0 || static_cast<uint32_t>(count) > kMaxTableCount) {
+            m_failed = true;
+            return 0;
+        }
+        return static_cast<uint32_t>(count);
+    }
+
+    void Fail() { m_failed = true; }
+
+private:
+    const uint8_t* m_data;
+    size_t         m_size;
+    size_t         m_offset;
+    bool           m_failed = false;
+};
+
+// ===================================================================
+// BlockAllocator -- one job's share of the model arena
+// ===================================================================
+
+class BlockAllocator {
+public:
+    BlockAllocator() = default;
+    BlockAllocator(void* block, size_t size)
+        : m_cursor(static_cast<uint8_t*>(block)),
+          m_end(static_cast<uint8_t*>(block) + size) {}
+
+    template <typename T>
+    T* Allocate(size_t count) {
+        return static_cast<T*>(AllocateBytes(count * sizeof(T), alignof(T)));
+    }
+
+    void* AllocateBytes(size_t bytes, size_t alignment) {
+        const uintptr_t cur = reinterpret_cast<uintptr_t>(m_cursor);
+        const uintptr_t aligned = (cur + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+        if (!m_cursor || aligned + bytes > reinterpret_cast<uintptr_t>(m_end)) {
+            m_failed = true;
+            return nullptr;
+        }
+        m_cursor = reinterpret_cast<uint8_t*>(aligned + bytes);
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    bool Failed() const { return m_failed; }
+
+private:
+    uint8_t* m_cursor = nullptr;
+    uint8_t* m_end    = nullptr;
+    bool     m_failed = false;
+};
+
+// Worst-case padding a BlockAllocator adds per allocation
+constexpr size_t kBlockSlack = alignof(std::max_align_t);
+
+// ===================================================================
+// Text
+// ===================================================================
+
+// UTF-16LE -> UTF-8. out must hold bytes * 3 / 2. Unpaired surrogates
+// become U+FFFD. Returns the UTF-8 length.
+size_t Utf16ToUtf8(const uint8_t* src, size_t bytes, char* out) {
+    char* o = out;
+    const size_t units = bytes / 2;
+    for (size_t i = 0; i < units; ++i) {
+        uint32_t c = static_cast<uint32_t>(src[i * 2]) | (static_cast<uint32_t>(src[i * 2 + 1]) << 8);
+        if (c >= 0xD800 && c <= 0xDBFF && i + 1 < units) {
+            const uint32_t lo = static_cast<uint32_t>(src[i * 2 + 2]) |
+                                (static_cast<uint32_t>(src[i * 2 + 3]) << 8);
+            if (lo >= 0xDC00 && lo <= 0xDFFF) {
+                c = 0x10000 + ((c - 0xD800) << 10) + (lo - 0xDC00);
+                ++i;
+            } else {
+                c = 0xFFFD;
+            }
+        } else if (c >= 0xD800 && c <= 0xDFFF) {
+            c = 0xFFFD;
+        }
+
+        if (c < 0x80) {
+            *o++ = static_cast<char>(c);
+        } else if (c < 0x800) {
+            *o++ = static_cast<char>(0xC0 | (c >> 6));
+            *o++ = static_cast<char>(0x80 | (c & 0x3F));
+        } else if (c < 0x10000) {
+            *o++ = static_cast<char>(0xE0 | (c >> 12));
+            *o++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            *o++ = static_cast<char>(0x80 | (c & 0x3F));
+        } else {
+            *o++ = static_cast<char>(0xF0 | (c >> 18));
+            *o++ = static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+            *o++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            *o++ = static_cast<char>(0x80 | (c & 0x3F));
+        }
+    }
+    return static_cast<size_t>(o - out);
+}
+
+// Reads PMX text fields. Without a block (scan pass) it only sizes the
+// UTF-8 output; with one it returns the string. UTF-8 files need no
+// conversion and are returned as views into the file.
+class TextDecoder {
+public:
+    TextDecoder(uint8_t encoding, BlockAllocator* block)
+        : m_utf8(encoding == 1), m_block(block) {}
+
+    std::string_view Read(Reader& r) {
+        const int32_t length = r.Read<int32_t>();
+        if (length < 0 || (!m_utf8 && (length & 1))) {
+            r.Fail();
+            return {};
+        }
+        const uint8_t* bytes = r.Take(static_cast<size_t>(length));
+        if (!bytes || length == 0) {
+            return {};
+        }
+        if (m_utf8) {
+            return {reinterpret_cast<const char*>(bytes), static_cast<size_t>(length)};
+        }
+
+        const size_t bound = static_cast<size_t>(length) / 2 * 3;
+        if (!m_block) {
+            m_bound += bound;
+            return {};
+        }
+        char* out = static_cast<char*>(m_block->AllocateBytes(bound, 1));
+        if (!out) {
+            r.Fail();
+            return {};
+        }
+        return {out, Utf16ToUtf8(bytes, static_cast<size_t>(length), out)};
+    }
+
+    size_t GetBound() const { return m_bound; }
+
+private:
+    bool            m_utf8;
+    BlockAllocator* m_block;
+    size_t          m_bound = 0;
+};
+
+bool InRange(int32_t index, uint32_t count) {
+    return index >= 0 && static_cast<uint32_t>(index) < count;
+}
+
+bool InRangeOrNone(int32_t index, uint32_t count) {
+    return index == -1 || InRange(index, count);
+}
+
+bool IsAligned4(const void* p) {
+    return (reinterpret_cast<uintptr_t>(p) & 3u) == 0;
+}
+
+size_t WeightBytes(uint8_t type, const PmxHeader& h) {
+    const size_t b = h.boneIndexSize;
+    switch (static_cast<PmxWeightType>(type)) {
+        case PmxWeightType::BDEF1: return b;
+        case PmxWeightType::BDEF2: return b * 2 + 4;
+        case PmxWeightType::BDEF4:
+        case PmxWeightType::QDEF:  return b * 4 + 16;
+        case PmxWeightType::SDEF:  return b * 2 + 4 + 36;
+        default:                   return 0;
+    }
+}
+
+// ===================================================================
+// Scan results -- section offsets and exact arena sizes
+// ===================================================================
+
+struct ScanResult {
+    size_t   infoOffset     = 0;
+    size_t   vertexOffset   = 0;
+    uint32_t vertexCount    = 0;
+    bool     hasSdef        = false;
+    std::vector<size_t> vertexChunkOffsets;
+
+    size_t   indexOffset    = 0;
+    uint32_t indexCount     = 0;
+    bool     indexMapped    = false;
+
+    size_t   textureOffset  = 0;
+    uint32_t textureCount   = 0;
+    uint32_t materialCount  = 0;
+    size_t   materialBlock  = 0;     // bytes for job kJobMaterials
+
+    size_t   boneOffset     = 0;
+    uint32_t boneCount      = 0;
+    uint32_t ikLinkCount    = 0;
+    size_t   boneBlock      = 0;
+
+    size_t   morphOffset    = 0;
+    uint32_t morphCount     = 0;
+    size_t   morphBlock     = 0;
+    size_t   morphViewBytes = 0;
+};
+
+// Morph offset record size in the file, and whether it can be viewed
+size_t MorphRecordBytes(PmxMorphType type, const PmxHeader& h) {
+    switch (type) {
+        case PmxMorphType::Group:
+        case PmxMorphType::Flip:     return h.morphIndexSize + 4;
+        case PmxMorphType::Vertex:   return h.vertexIndexSize + 12;
+        case PmxMorphType::Bone:     return h.boneIndexSize + 28;
+        case PmxMorphType::Uv:
+        case PmxMorphType::Uv1:
+        case PmxMorphType::Uv2:
+        case PmxMorphType::Uv3:
+        case PmxMorphType::Uv4:      return h.vertexIndexSize + 16;
+        case PmxMorphType::Material: return h.materialIndexSize + 1 + 28 * 4;
+        case PmxMorphType::Impulse:  return h.rigidBodyIndexSize + 1 + 24;
+        default:                     return 0;
+    }
+}
+
+size_t MorphOutputBytes(PmxMorphType type) {
+    switch (type) {
+        case PmxMorphType::Group:
+        case PmxMorphType::Flip:     return sizeof(PmxGroupMorphOffset);
+        case PmxMorphType::Vertex:   return sizeof(PmxVertexMorphOffset);
+        case PmxMorphType::Bone:     return sizeof(PmxBoneMorphOffset);
+        case PmxMorphType::Material: return sizeof(PmxMaterialMorphOffset);
+        case PmxMorphType::Impulse:  return sizeof(PmxImpulseMorphOffset);
+        default:                     return sizeof(PmxUvMorphOffset);
+    }
+}
+
+bool MorphViewable(PmxMorphType type, const PmxHeader& h, const uint8_t* records) {
+    if (!IsAligned4(records)) return false;
+    switch (type) {
+        case PmxMorphType::Group:
+        case PmxMorphType::Flip:     return h.morphIndexSize == 4;
+        case PmxMorphType::Vertex:   return h.vertexIndexSize == 4;
+        case PmxMorphType::Bone:     return h.boneIndexSize == 4;
+        case PmxMorphType::Uv:
+        case PmxMorphType::Uv1:
+        case PmxMorphType::Uv2:
+        case PmxMorphType::Uv3:
+        case PmxMorphType::Uv4:      return h.vertexIndexSize == 4;
+        default:                     return false;
+    }
+}
+
+// ===================================================================
+// Header
+// ===================================================================
+
+bool ParseHeader(Reader& r, PmxHeader& h, std::string& error) {
+    const uint8_t* magic = r.Take(4);
+    if (!magic || std::memcmp(magic, "PMX ", 4) != 0) {
+        error = "not a PMX file";
+        return false;
+    }
+    h.version = r.Read<float>();
+    if (h.version < 2.0f || h.version > 2.1f + 1e-4f) {
+        error = "unsupported PMX version";
+        return false;
+    }
+
+    const uint8_t globalCount = r.Read<uint8_t>();
+    const uint8_t* globals = r.Take(globalCount);
+    if (!globals || globalCount < 8) {
+        error = "truncated header";
+        return false;
+    }
+    h.encoding           = globals[0];
+    h.additionalUvCount  = globals[1];
+    h.vertexIndexSize    = globals[2];
+    h.textureIndexSize   = globals[3];
+    h.materialIndexSize  = globals[4];
+    h.boneIndexSize      = globals[5];
+    h.morphIndexSize     = globals[6];
+    h.rigidBodyIndexSize = globals[7];
+
+    const auto validSize = [](uint8_t s) { return s == 1 || s == 2 || s == 4; };
+    if (h.encoding > 1 || h.additionalUvCount > 4 ||
+        !validSize(h.vertexIndexSize) || !validSize(h.textureIndexSize) ||
+        !validSize(h.materialIndexSize) || !validSize(h.boneIndexSize) ||
+        !validSize(h.morphIndexSize) || !validSize(h.rigidBodyIndexSize)) {
+        error = "invalid header globals";
+        return false;
+    }
+    return true;
+}
+
+// ===================================================================
+// Sections. Each parser runs twice: in the scan pass without output
+// (out == nullptr) to find the section's end and size its output,
+// and in a job with output to transcode and validate.
+// ===================================================================
+
+void ParseInfo(Reader& r, TextDecoder& text, PmxModelInfo* out) {
+    PmxModelInfo info;
+    info.name      = text.Read(r);
+    info.nameEn    = text.Read(r);
+    info.comment   = text.Read(r);
+    info.commentEn = text.Read(r);
+    if (out) *out = info;
+}
+
+void ParseTextures(Reader& r, uint32_t count, TextDecoder& text, std::string_view* out) {
+    for (uint32_t i = 0; i < count && !r.Failed(); ++i) {
+        const std::string_view path = text.Read(r);
+        if (out) out[i] = path;
+    }
+}
+
+// Returns false (with error) on an out-of-range reference
+bool ParseMaterials(Reader& r, const PmxHeader& h, uint32_t count, TextDecoder& text,
+                    PmxMaterial* out, uint32_t textureCount, uint32_t indexCount,
+                    std::string& error) {
+    uint32_t indexOffset = 0;
+    for (uint32_t i = 0; i < count && !r.Failed(); ++i) {
+        PmxMaterial m;
+        m.name   = text.Read(r);
+        m.nameEn = text.Read(r);
+        r.ReadFloats(m.diffuse, 4);
+        r.ReadFloats(m.specular, 3);
+        m.specularPower = r.Read<float>();
+        r.ReadFloats(m.ambient, 3);
+        m.drawFlags = r.Read<uint8_t>();
+        r.ReadFloats(m.edgeColor, 4);
+        m.edgeSize      = r.Read<float>();
+        m.texture       = r.ReadIndex(h.textureIndexSize);
+        m.sphereTexture = r.ReadIndex(h.textureIndexSize);
+        m.sphereMode    = r.Read<uint8_t>();
+        m.sharedToon    = r.Read<uint8_t>() != 0;
+        m.toon          = m.sharedToon ? r.Read<uint8_t>() : r.ReadIndex(h.textureIndexSize);
+        m.memo          = text.Read(r);
+        const int32_t faceIndices = r.Read<int32_t>();
+
+        if (!out || r.Failed()) continue;
+
+        if (!InRangeOrNone(m.texture, textureCount) ||
+            !InRangeOrNone(m.sphereTexture, textureCount) ||
+            (!m.sharedToon && !InRangeOrNone(m.toon, textureCount))) {
+            error = "material " + std::to_string(i) + " references a missing texture";
+            return false;
+        }
+        if (faceIndices < 0 || faceIndices % 3 != 0 ||
+            static_cast<uint32_t>(faceIndices) > indexCount - indexOffset) {
+            error = "material " + std::to_string(i) + " has an invalid face count";
+            return false;
+        }
+        m.indexOffset = indexOffset;
+        m.indexCount  = static_cast<uint32_t>(faceIndices);
+        indexOffset  += m.indexCount;
+        out[i] = m;
+    }
+    return true;
+}
+
+bool ParseBones(Reader& r, const PmxHeader& h, uint32_t count, TextDecoder& text,
+                PmxBone* out, PmxIkLink* links, uint32_t& linkTotal, std::string& error) {
+    const uint8_t bi = h.boneIndexSize;
+    linkTotal = 0;
+
+    for (uint32_t i = 0; i < count && !r.Failed(); ++i) {
+        PmxBone b;
+        b.name   = text.Read(r);
+        b.nameEn = text.Read(r);
+        r.ReadFloats(b.position, 3);
+        b.parent = r.ReadIndex(bi);
+        b.layer  = r.Read<int32_t>();
+        b.flags  = r.Read<uint16_t>();
+
+        if (b.flags & kPmxBoneTailIsBone) {
+            b.tailBone = r.ReadIndex(bi);
+        } else {
+            r.ReadFloats(b.tailOffset, 3);
+        }
+        if (b.flags & (kPmxBoneInheritRotation | kPmxBoneInheritTranslation)) {
+            b.inheritParent = r.ReadIndex(bi);
+            b.inheritWeight = r.Read<float>();
+        }
+        if (b.flags & kPmxBoneFixedAxis) {
+            r.ReadFloats(b.fixedAxis, 3);
+        }
+        if (b.flags & kPmxBoneLocalAxes) {
+            r.ReadFloats(b.localX, 3);
+            r.ReadFloats(b.localZ, 3);
+        }
+        if (b.flags & kPmxBoneExternalParent) {
+            b.externalKey = r.Read<int32_t>();
+        }
+        if (b.flags & kPmxBoneIK) {
+            b.ikTarget     = r.ReadIndex(bi);
+            b.ikLoopCount  = r.Read<int32_t>();
+            b.ikLimitAngle = r.Read<float>();
+            const uint32_t n = r.ReadCount();
+            b.ikLinkOffset = linkTotal;
+            b.ikLinkCount  = n;
+            for (uint32_t k = 0; k < n && !r.Failed(); ++k) {
+                PmxIkLink link;
+                link.bone      = r.ReadIndex(bi);
+                link.hasLimits = r.Read<uint8_t>() != 0;
+                if (link.hasLimits) {
+                    r.ReadFloats(link.minAngle, 3);
+                    r.ReadFloats(link.maxAngle, 3);
+                }
+                if (links) {
+                    if (!InRange(link.bone, count)) {
+                        error = "IK link of bone " + std::to_string(i) + " is out of range";
+                        return false;
+                    }
+                    links[linkTotal + k] = link;
+                }
+            }
+            linkTotal += n;
+        }
+
+        if (!out || r.Failed()) continue;
+
+        if (!InRangeOrNone(b.parent, count) || !InRangeOrNone(b.tailBone, count) ||
+            !InRangeOrNone(b.inheritParent, count) ||
+            ((b.flags & kPmxBoneIK) && !InRange(b.ikTarget, count))) {
+            error = "bone " + std::to_string(i) + " references a missing bone";
+            return false;
+        }
+        out[i] = b;
+    }
+    return true;
+}
+
+struct MorphContext {
+    uint32_t vertexCount   = 0;
+    uint32_t boneCount     = 0;
+    uint32_t materialCount = 0;
+    uint32_t morphCount    = 0;
+};
+
+// Transcodes one morph's offsets from records into out
+bool TranscodeMorphOffsets(Reader& r, const PmxHeader& h, PmxMorph& m, void* out,
+                           const MorphContext& ctx) {
+    const uint32_t n = m.offsetCount;
+    switch (m.type) {
+        case PmxMorphType::Group:
+        case PmxMorphType::Flip: {
+            auto* o = static_cast<PmxGroupMorphOffset*>(out);
+            for (uint32_t k = 0; k < n; ++k) {
+                o[k].morph  = r.ReadIndex(h.morphIndexSize);
+                o[k].weight = r.Read<float>();
+                if (!InRange(o[k].morph, ctx.morphCount)) return false;
+            }
+            m.group = o;
+            break;
+        }
+        case PmxMorphType::Vertex: {
+            auto* o = static_cast<PmxVertexMorphOffset*>(out);
+            for (uint32_t k = 0; k < n; ++k) {
+                o[k].vertex = r.ReadVertexIndex(h.vertexIndexSize);
+                r.ReadFloats(o[k].translation, 3);
+                if (!InRange(o[k].vertex, ctx.vertexCount)) return false;
+            }
+            m.vertex = o;
+            break;
+        }
+        case PmxMorphType::Bone: {
+            auto* o = static_cast<PmxBoneMorphOffset*>(out);
+            for (uint32_t k = 0; k < n; ++k) {
+                o[k].bone = r.ReadIndex(h.boneIndexSize);
+                r.ReadFloats(o[k].translation, 3);
+                r.ReadFloats(o[k].rotation, 4);
+                if (!InRange(o[k].bone, ctx.boneCount)) return false;
+            }
+            m.bone = o;
+            break;
+        }
+        case PmxMorphType::Material: {
+            auto* o = static_cast<PmxMaterialMorphOffset*>(out);
+            for (uint32_t k = 0; k < n; ++k) {
+                o[k].material  = r.ReadIndex(h.materialIndexSize);
+                o[k].operation = r.Read<uint8_t>();
+                r.ReadFloats(o[k].diffuse, 4);
+                r.ReadFloats(o[k].specular, 3);
+                o[k].specularPower = r.Read<float>();
+                r.ReadFloats(o[k].ambient, 3);
+                r.ReadFloats(o[k].edgeColor, 4);
+                o[k].edgeSize = r.Read<float>();
+                r.ReadFloats(o[k].textureTint, 4);
+                r.ReadFloats(o[k].sphereTint, 4);
+                r.ReadFloats(o[k].toonTint, 4);
+                if (!InRangeOrNone(o[k].material, ctx.materialCount)) return false;
+            }
+            m.material = o;
+            break;
+        }
+        case PmxMorphType::Impulse: {
+            // Rigid bodies are not loaded, so their indices are kept
+            // as-is for a physics loader to check
+            auto* o = static_cast<PmxImpulseMorphOffset*>(out);
+            for (uint32_t k = 0; k < n; ++k) {
+                o[k].rigidBody = r.ReadIndex(h.rigidBodyIndexSize);
+                o[k].local     = r.Read<uint8_t>() != 0;
+                r.ReadFloats(o[k].velocity, 3);
+                r.ReadFloats(o[k].torque, 3);
+            }
+            m.impulse = o;
+            break;
+        }
+        default: {
+            auto* o = static_cast<PmxUvMorphOffset*>(out);
+            for (uint32_t k = 0; k < n; ++k) {
+                o[k].vertex = r.ReadVertexIndex(h.vertexIndexSize);
+                r.ReadFloats(o[k].value, 4);
+                if (!InRange(o[k].vertex, ctx.vertexCount)) return false;
+            }
+            m.uv = o;
+            break;
+        }
+    }
+    return !r.Failed();
+}
+
+// Points the morph at its records in the mapping (after checking them)
+bool ViewMorphOffsets(const uint8_t* records, PmxMorph& m, const MorphContext& ctx) {
+    const uint32_t n = m.offsetCount;
+    switch (m.type) {
+        case PmxMorphType::Group:
+        case PmxMorphType::Flip:
+            m.group = reinterpret_cast<const PmxGroupMorphOffset*>(records);
+            for (uint32_t k = 0; k < n; ++k) {
+                if (!InRange(m.group[k].morph, ctx.morphCount)) return false;
+            }
+            break;
+        case PmxMorphType::Vertex:
+            m.vertex = reinterpret_cast<const PmxVertexMorphOffset*>(records);
+            for (uint32_t k = 0; k < n; ++k) {
+                if (!InRange(m.vertex[k].vertex, ctx.vertexCount)) return false;
+            }
+            break;
+        case PmxMorphType::Bone:
+            m.bone = reinterpret_cast<const PmxBoneMorphOffset*>(records);
+            for (uint32_t k = 0; k < n; ++k) {
+                if (!InRange(m.bone[k].bone, ctx.boneCount)) return false;
+            }
+            break;
+        default:
+            m.uv = reinterpret_cast<const PmxUvMorphOffset*>(records);
+            for (uint32_t k = 0; k < n; ++k) {
+                if (!InRange(m.uv[k].vertex, ctx.vertexCount)) return false;
+            }
+            break;
+    }
+    m.mapped = true;
+    return true;
+}
+
+// Scan pass: out == nullptr, sizes transcoded offsets into *outBytes.
+// Decode pass: fills out using block for transcoded offsets.
+bool ParseMorphs(Reader& r, const PmxHeader& h, uint32_t count, TextDecoder& text,
+                 PmxMorph* out, BlockAllocator* block, const MorphContext& ctx,
+                 size_t* outBytes, size_t* viewBytes, std::string& error) {
+    for (uint32_t i = 0; i < count && !r.Failed(); ++i) {
+        PmxMorph m;
+        m.name   = text.Read(r);
+        m.nameEn = text.Read(r);
+        m.panel  = r.Read<uint8_t>();
+        const uint8_t type = r.Read<uint8_t>();
+        m.offsetCount = r.ReadCount();
+        if (type > static_cast<uint8_t>(PmxMorphType::Impulse)) {
+            r.Fail();
+            break;
+        }
+        m.type = static_cast<PmxMorphType>(type);
+
+        const size_t recordBytes = MorphRecordBytes(m.type, h);
+        const uint8_t* records = r.GetCurrent();
+        const bool viewable = MorphViewable(m.type, h, records);
+
+        if (!out) {
+            r.Skip(recordBytes * m.offsetCount);
+            if (viewable) {
+                *viewBytes += recordBytes * m.offsetCount;
+            } else {
+                *outBytes += MorphOutputBytes(m.type) * m.offsetCount + kBlockSlack;
+            }
+            continue;
+        }
+
+        bool valid = true;
+        if (viewable) {
+            if (!r.Take(recordBytes * m.offsetCount)) break;
+            valid = ViewMorphOffsets(records, m, ctx);
+        } else {
+            void* dst = block->AllocateBytes(MorphOutputBytes(m.type) * m.offsetCount,
+                                             alignof(PmxMaterialMorphOffset));
+            if (!dst && m.offsetCount > 0) {
+                r.Fail();
+                break;
+            }
+            valid = TranscodeMorphOffsets(r, h, m, dst, ctx);
+        }
+        if (!valid) {
+            error = r.Failed() ? "truncated morph data"
+                               : "morph " + std::to_string(i) + " references a missing element";
+            return false;
+        }
+        out[i] = m;
+    }
+    return true;
+}
+
+// Scan a vertex range, recording chunk starts
+void ScanVertices(Reader& r, const PmxHeader& h, ScanResult& scan) {
+    const size_t fixedBytes = 32 + 16 * static_cast<size_t>(h.additionalUvCount);
+    scan.vertexChunkOffsets.reserve(scan.vertexCount / kVertexChunk + 1);
+
+    for (uint32_t i = 0; i < scan.vertexCount && !r.Failed(); ++i) {
+        if (i % kVertexChunk == 0) {
+            scan.vertexChunkOffsets.push_back(r.GetOffset());
+        }
+        r.Skip(fixedBytes);
+        const uint8_t type = r.Read<uint8_t>();
+        const size_t weightBytes = WeightBytes(type, h);
+        if (weightBytes == 0) {
+            r.Fail();
+            break;
+        }
+        scan.hasSdef |= type == static_cast<uint8_t>(PmxWeightType::SDEF);
+        r.Skip(weightBytes + 4);
+    }
+}
+
+// Decode vertices [first, first + count) starting at r
+bool DecodeVertices(Reader& r, const PmxHeader& h, uint32_t first, uint32_t count,
+                    uint32_t vertexCount, uint32_t boneCount, const PmxVertexTable& t,
+                    std::string& error) {
+    float*   positions = const_cast<float*>(t.positions);
+    float*   normals   = const_cast<float*>(t.normals);
+    float*   uvs       = const_cast<float*>(t.uvs);
+    float*   addUvs    = const_cast<float*>(t.additionalUvs);
+    int32_t* indices   = const_cast<int32_t*>(t.boneIndices);
+    float*   weights   = const_cast<float*>(t.boneWeights);
+    uint8_t* types     = const_cast<uint8_t*>(t.weightTypes);
+    float*   edges     = const_cast<float*>(t.edgeScales);
+    float*   sdefC     = const_cast<float*>(t.sdefC);
+    float*   sdefR0    = const_cast<float*>(t.sdefR0);
+    float*   sdefR1    = const_cast<float*>(t.sdefR1);
+    const uint8_t bi = h.boneIndexSize;
+
+    for (uint32_t v = first; v < first + count; ++v) {
+        r.ReadFloats(positions + v * 3, 3);
+        r.ReadFloats(normals + v * 3, 3);
+        r.ReadFloats(uvs + v * 2, 2);
+        for (uint32_t k = 0; k < h.additionalUvCount; ++k) {
+            r.ReadFloats(addUvs + (static_cast<size_t>(k) * vertexCount + v) * 4, 4);
+        }
+
+        int32_t* bone   = indices + static_cast<size_t>(v) * 4;
+        float*   weight = weights + static_cast<size_t>(v) * 4;
+        std::fill(bone, bone + 4, 0);
+        std::fill(weight, weight + 4, 0.0f);
+
+        const uint8_t type = r.Read<uint8_t>();
+        types[v] = type;
+        switch (static_cast<PmxWeightType>(type)) {
+            case PmxWeightType::BDEF1:
+                bone[0]   = r.ReadIndex(bi);
+                weight[0] = 1.0f;
+                break;
+            case PmxWeightType::BDEF2:
+            case PmxWeightType::SDEF:
+                bone[0]   = r.ReadIndex(bi);
+                bone[1]   = r.ReadIndex(bi);
+                weight[0] = r.Read<float>();
+                weight[1] = 1.0f - weight[0];
+                break;
+            default:   // BDEF4, QDEF
+                for (int k = 0; k < 4; ++k) bone[k] = r.ReadIndex(bi);
+                r.ReadFloats(weight, 4);
+                break;
+        }
+        if (sdefC) {
+            if (type == static_cast<uint8_t>(PmxWeightType::SDEF)) {
+                r.ReadFloats(sdefC  + v * 3, 3);
+                r.ReadFloats(sdefR0 + v * 3, 3);
+                r.ReadFloats(sdefR1 + v * 3, 3);
+            } else {
+                std::fill(sdefC  + v * 3, sdefC  + v * 3 + 3, 0.0f);
+                std::fill(sdefR0 + v * 3, sdefR0 + v * 3 + 3, 0.0f);
+                std::fill(sdefR1 + v * 3, sdefR1 + v * 3 + 3, 0.0f);
+            }
+        }
+        edges[v] = r.Read<float>();
+
+        // -1 is "no bone": drop the influence
+        for (int k = 0; k < 4; ++k) {
+            if (bone[k] == -1) {
+                bone[k]   = 0;
+                weight[k] = 0.0f;
+            } else if (!InRange(bone[k], boneCount)) {
+                error = "vertex " + std::to_string(v) + " references a missing bone";
+                return false;
+            }
+        }
+    }
+    if (r.Failed()) {
+        error = "truncated vertex data";
+        return false;
+    }
+    return true;
+}
+
+// Size of an arena array including LinearArena alignment padding
+size_t ArenaBytes(size_t bytes) {
+    return bytes + memory::LinearArena::kBlockAlignment;
+}
+
+template <typename T>
+T* ArenaArray(memory::LinearArena& arena, size_t count) {
+    return static_cast<T*>(arena.Allocate(count * sizeof(T), memory::LinearArena::kBlockAlignment));
+}
+
+} // anonymous namespace
+
+// ===================================================================
+// Load / Unload
+// ===================================================================
+
+bool PmxModel::Load(const std::string& path, jobs::JobSystem* jobs) {
+    Unload();
+
+    const uint64_t startUs = utils::MonotonicMicros();
+    if (!m_file.Open(path)) {
+        return false;
+    }
+    m_file.Prefetch(0, m_file.GetSize());
+    const float mapMs = utils::MicrosToMs(utils::MonotonicMicros() - startUs);
+
+    if (!Parse(m_file.GetData(), m_file.GetSize(), jobs)) {
+        DMME_LOG_ERROR("PmxModel: failed to load '{}'", path);
+        Unload();
+        return false;
+    }
+    m_stats.mapMs = mapMs;
+
+    DMME_LOG_INFO("PmxModel: loaded '{}' ({} vertices, {} bones, {} morphs) in {:.2f} ms",
+                  path, m_vertices.count, m_bones.count, m_morphs.count,
+                  m_stats.mapMs + m_stats.scanMs + m_stats.transcodeMs);
+    return true;
+}
+
+bool PmxModel::LoadFromMemory(const uint8_t* data, size_t size, jobs::JobSystem* jobs) {
+    Unload();
+    if (!data || !Parse(data, size, jobs)) {
+        Unload();
+        return false;
+    }
+    return true;
+}
+
+void PmxModel::Unload() {
+    m_file.Close();
+    m_arena.Release();
+    m_arenaMemory.Reset();
+    m_loaded    = false;
+    m_header    = {};
+    m_info      = {};
+    m_vertices  = {};
+    m_indices   = {};
+    m_textures  = {};
+    m_materials = {};
+    m_bones     = {};
+    m_ikLinks   = {};
+    m_morphs    = {};
+    m_stats     = {};
+}
+
+// ===================================================================
+// Parse
+// ===================================================================
+
+bool PmxModel::Parse(const uint8_t* data, size_t size, jobs::JobSystem* jobs) {
+    std::string error;
+    const uint64_t scanStartUs = utils::MonotonicMicros();
+
+    // --- Scan: section offsets, counts and output sizes ---
+    Reader r(data, size);
+    if (!ParseHeader(r, m_header, error)) {
+        DMME_LOG_ERROR("PmxModel: {}", error);
+        return false;
+    }
+    const PmxHeader& h = m_header;
+
+    ScanResult scan;
+    TextDecoder scanInfoText(h.encoding, nullptr);
+    scan.infoOffset = r.GetOffset();
+    ParseInfo(r, scanInfoText, nullptr);
+
+    scan.vertexCount  = r.ReadCount();
+    scan.vertexOffset = r.GetOffset();
+    ScanVertices(r, h, scan);
+
+    scan.indexCount  = r.ReadCount();
+    scan.indexOffset = r.GetOffset();
+    r.Skip(static_cast<size_t>(scan.indexCount) * h.vertexIndexSize);
+    scan.indexMapped = h.vertexIndexSize != 1 &&
+                       (reinterpret_cast<uintptr_t>(data + scan.indexOffset) % h.vertexIndexSize) == 0;
+
+    TextDecoder scanMaterialText(h.encoding, nullptr);
+    scan.textureCount  = r.ReadCount();
+    scan.textureOffset = r.GetOffset();
+    ParseTextures(r, scan.textureCount, scanMaterialText, nullptr);
+    scan.materialCount = r.ReadCount();
+    ParseMaterials(r, h, scan.materialCount, scanMaterialText, nullptr, 0, 0, error);
+
+    TextDecoder scanBoneText(h.encoding, nullptr);
+    scan.boneCount  = r.ReadCount();
+    scan.boneOffset = r.GetOffset();
+    ParseBones(r, h, scan.boneCount, scanBoneText, nullptr, nullptr, scan.ikLinkCount, error);
+
+    TextDecoder scanMorphText(h.encoding, nullptr);
+    size_t morphOffsetBytes = 0;
+    scan.morphCount  = r.ReadCount();
+    scan.morphOffset = r.GetOffset();
+    ParseMorphs(r, h, scan.morphCount, scanMorphText, nullptr, nullptr, MorphContext{},
+                &morphOffsetBytes, &scan.morphViewBytes, error);
+
+    if (r.Failed()) {
+        DMME_LOG_ERROR("PmxModel: truncated or corrupt data near offset {}", r.GetOffset());
+        return false;
+    }
+    if (scan.indexCount % 3 != 0) {
+        DMME_LOG_ERROR("PmxModel: face index count {} is not a triangle list", scan.indexCount);
+        return false;
+    }
+
+    scan.materialBlock = scanInfoText.GetBound() + scanMaterialText.GetBound() +
+                         scan.textureCount * sizeof(std::string_view) +
+                         scan.materialCount * sizeof(PmxMaterial) +
+                         (8 + scan.textureCount + scan.materialCount * 3) * kBlockSlack;
+    scan.boneBlock  = scanBoneText.GetBound() + scan.boneCount * sizeof(PmxBone) +
+                      scan.ikLinkCount * sizeof(PmxIkLink) +
+                      (2 + scan.boneCount * 2) * kBlockSlack;
+    scan.morphBlock = scanMorphText.GetBound() + morphOffsetBytes +
+                      scan.morphCount * sizeof(PmxMorph) +
+                      (1 + scan.morphCount * 2) * kBlockSlack;
+
+    // --- Arena: one allocation for everything transcoded ---
+    const size_t n = scan.vertexCount;
+    const size_t sdefCount = scan.hasSdef ? n : 0;
+    const size_t indexBytes = scan.indexMapped ? 0
+        : static_cast<size_t>(scan.indexCount) * (h.vertexIndexSize == 1 ? 2 : h.vertexIndexSize);
+    const size_t arenaBytes =
+        ArenaBytes(n * 3 * sizeof(float)) * 2 +                         // positions, normals
+        ArenaBytes(n * 2 * sizeof(float)) +                             // uvs
+        ArenaBytes(n * 4 * sizeof(float) * h.additionalUvCount) +
+        ArenaBytes(n * 4 * sizeof(int32_t)) + ArenaBytes(n * 4 * sizeof(float)) +
+        ArenaBytes(n) + ArenaBytes(n * sizeof(float)) +                 // types, edges
+        ArenaBytes(sdefCount * 3 * sizeof(float)) * 3 +
+        ArenaBytes(indexBytes) +
+        ArenaBytes(scan.materialBlock) + ArenaBytes(scan.boneBlock) + ArenaBytes(scan.morphBlock);
+
+    if (!m_arena.Init(arenaBytes)) {
+        return false;
+    }
+    m_arenaMemory.Set(arenaBytes);
+
+    PmxVertexTable& vt = m_vertices;
+    vt.count         = scan.vertexCount;
+    vt.positions     = ArenaArray<float>(m_arena, n * 3);
+    vt.normals       = ArenaArray<float>(m_arena, n * 3);
+    vt.uvs           = ArenaArray<float>(m_arena, n * 2);
+    vt.additionalUvs = h.additionalUvCount ? ArenaArray<float>(m_arena, n * 4 * h.additionalUvCount) : nullptr;
+    vt.boneIndices   = ArenaArray<int32_t>(m_arena, n * 4);
+    vt.boneWeights   = ArenaArray<float>(m_arena, n * 4);
+    vt.weightTypes   = ArenaArray<uint8_t>(m_arena, n);
+    vt.edgeScales    = ArenaArray<float>(m_arena, n);
+    if (scan.hasSdef) {
+        vt.sdefC  = ArenaArray<float>(m_arena, n * 3);
+        vt.sdefR0 = ArenaArray<float>(m_arena, n * 3);
+        vt.sdefR1 = ArenaArray<float>(m_arena, n * 3);
+    }
+
+    m_indices.count  = scan.indexCount;
+    m_indices.mapped = scan.indexMapped;
+    m_indices.indexSize = h.vertexIndexSize == 1 ? 2 : h.vertexIndexSize;
+    m_indices.data   = scan.indexMapped ? static_cast<const void*>(data + scan.indexOffset)
+                                        : m_arena.Allocate(indexBytes, memory::LinearArena::kBlockAlignment);
+
+    BlockAllocator materialBlock(m_arena.Allocate(scan.materialBlock, kBlockSlack), scan.materialBlock);
+    BlockAllocator boneBlock(m_arena.Allocate(scan.boneBlock, kBlockSlack), scan.boneBlock);
+    BlockAllocator morphBlock(m_arena.Allocate(scan.morphBlock, kBlockSlack), scan.morphBlock);
+
+    if (m_arena.GetOverflowCount() > 0) {
+        DMME_LOG_ERROR("PmxModel: arena sizing error ({} bytes short)", m_arena.GetOverflowBytes());
+        return false;
+    }
+
+    m_stats.scanMs = utils::MicrosToMs(utils::MonotonicMicros() - scanStartUs);
+    const uint64_t transcodeStartUs = utils::MonotonicMicros();
+
+    // --- Transcode jobs ---
+    const uint32_t chunkCount = static_cast<uint32_t>(scan.vertexChunkOffsets.size());
+    const uint32_t jobCount   = kJobVertices + chunkCount;
+    std::vector<std::string> errors(jobCount);
+
+    MorphContext morphCtx;
+    morphCtx.vertexCount   = scan.vertexCount;
+    morphCtx.boneCount     = scan.boneCount;
+    morphCtx.materialCount = scan.materialCount;
+    morphCtx.morphCount    = scan.morphCount;
+
+    const auto runJob = [&](uint32_t job) {
+        std::string& err = errors[job];
+        switch (job) {
+            case kJobMaterials: {
+                TextDecoder text(h.encoding, &materialBlock);
+                Reader jr(data, size, scan.infoOffset);
+                ParseInfo(jr, text, &m_info);
+
+                std::string_view* textures = materialBlock.Allocate<std::string_view>(scan.textureCount);
+                PmxMaterial*      materials = materialBlock.Allocate<PmxMaterial>(scan.materialCount);
+                jr = Reader(data, size, scan.textureOffset);
+                ParseTextures(jr, scan.textureCount, text, textures);
+                jr.ReadCount();
+                if (ParseMaterials(jr, h, scan.materialCount, text, materials,
+                                   scan.textureCount, scan.indexCount, err) &&
+                    (jr.Failed() || materialBlock.Failed())) {
+                    err = "material section could not be decoded";
+                }
+                m_textures  = {textures, scan.textureCount};
+                m_materials = {materials, scan.materialCount};
+                break;
+            }
+            case kJobBones: {
+                TextDecoder text(h.encoding, &boneBlock);
+                Reader jr(data, size, scan.boneOffset);
+                PmxBone*   bones = boneBlock.Allocate<PmxBone>(scan.boneCount);
+                PmxIkLink* links = boneBlock.Allocate<PmxIkLink>(scan.ikLinkCount);
+                uint32_t linkTotal = 0;
+                if (ParseBones(jr, h, scan.boneCount, text, bones, links, linkTotal, err) &&
+                    (jr.Failed() || boneBlock.Failed())) {
+                    err = "bone section could not be decoded";
+                }
+                m_bones   = {bones, scan.boneCount};
+                m_ikLinks = {links, scan.ikLinkCount};
+                break;
+            }
+            case kJobMorphs: {
+                TextDecoder text(h.encoding, &morphBlock);
+                Reader jr(data, size, scan.morphOffset);
+                PmxMorph* morphs = morphBlock.Allocate<PmxMorph>(scan.morphCount);
+                if (ParseMorphs(jr, h, scan.morphCount, text, morphs, &morphBlock, morphCtx,
+                                nullptr, nullptr, err) &&
+                    (jr.Failed() || morphBlock.Failed())) {
+                    err = "morph section could not be decoded";
+                }
+                m_morphs = {morphs, scan.morphCount};
+                break;
+            }
+            case kJobIndices: {
+                const uint8_t* src = data + scan.indexOffset;
+                const uint32_t count = scan.indexCount;
+                uint32_t maxIndex = 0;
+                if (h.vertexIndexSize == 1) {
+                    auto* dst = static_cast<uint16_t*>(const_cast<void*>(m_indices.data));
+                    for (uint32_t i = 0; i < count; ++i) {
+                        dst[i] = src[i];
+                        maxIndex = std::max<uint32_t>(maxIndex, src[i]);
+                    }
+                } else if (h.vertexIndexSize == 2) {
+                    if (!scan.indexMapped) {
+                        std::memcpy(const_cast<void*>(m_indices.data), src, count * size_t{2});
+                    }
+                    const auto* idx = static_cast<const uint16_t*>(m_indices.data);
+                    for (uint32_t i = 0; i < count; ++i) {
+                        maxIndex = std::max<uint32_t>(maxIndex, idx[i]);
+                    }
+                } else {
+                    if (!scan.indexMapped) {
+                        std::memcpy(const_cast<void*>(m_indices.data), src, count * size_t{4});
+                    }
+                    const auto* idx = static_cast<const uint32_t*>(m_indices.data);
+                    for (uint32_t i = 0; i < count; ++i) {
+                        maxIndex = std::max(maxIndex, idx[i]);
+                    }
+                }
+                if (count > 0 && maxIndex >= scan.vertexCount) {
+                    err = "face index " + std::to_string(maxIndex) + " is out of range";
+                }
+                break;
+            }
+            default: {
+                const uint32_t chunk = job - kJobVertices;
+                const uint32_t first = chunk * kVertexChunk;
+                const uint32_t count = std::min(kVertexChunk, scan.vertexCount - first);
+                Reader jr(data, size, scan.vertexChunkOffsets[chunk]);
+                DecodeVertices(jr, h, first, count, scan.vertexCount, scan.boneCount, vt, err);
+                break;
+            }
+        }
+    };
+
+    if (jobs) {
+        jobs->ParallelFor(jobCount, runJob);
+    } else {
+        for (uint32_t job = 0; job < jobCount; ++job) {
+            runJob(job);
+        }
+    }
+
+    for (const std::string& err : errors) {
+        if (!err.empty()) {
+            DMME_LOG_ERROR("PmxModel: {}", err);
+            return false;
+        }
+    }
+
+    m_stats.transcodeMs     = utils::MicrosToMs(utils::MonotonicMicros() - transcodeStartUs);
+    m_stats.transcodeJobs   = jobCount;
+    m_stats.fileBytes       = size;
+    m_stats.arenaBytes      = m_arena.GetUsed();
+    m_stats.mappedViewBytes = scan.morphViewBytes +
+        (scan.indexMapped ? static_cast<size_t>(scan.indexCount) * h.vertexIndexSize : 0);
+    m_loaded = true;
+    return true;
+}
+
+} // namespace assets
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,352 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "core/memory/LinearArena.h"
+#include "core/memory/MemoryAccountant.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace dmme {
+namespace core {
+namespace jobs { class JobSystem; }
+namespace assets {
+
+// ------------------------------------------------------------------
+// Tables
+// ------------------------------------------------------------------
+
+// Read-only table (a view into the file mapping or the model arena).
+// Valid while the PmxModel stays loaded.
+template <typename T>
+struct PmxArray {
+    const T* data  = nullptr;
+    uint32_t count = 0;
+
+    const T& operator[](uint32_t i) const { return data[i]; }
+    const T* begin() const { return data; }
+    const T* end() const   { return data + count; }
+    bool     empty() const { return count == 0; }
+};
+
+struct PmxHeader {
+    float   version            = 0.0f;   // 2.0 or 2.1
+    uint8_t encoding           = 0;      // 0 = UTF-16LE, 1 = UTF-8 (strings are always exposed as UTF-8)
+    uint8_t additionalUvCount  = 0;      // 0 - 4
+    uint8_t vertexIndexSize    = 0;      // 1, 2 or 4 bytes
+    uint8_t textureIndexSize   = 0;
+    uint8_t materialIndexSize  = 0;
+    uint8_t boneIndexSize      = 0;
+    uint8_t morphIndexSize     = 0;
+    uint8_t rigidBodyIndexSize = 0;
+};
+
+struct PmxModelInfo {
+    std::string_view name;
+    std::string_view nameEn;
+    std::string_view comment;
+    std::string_view commentEn;
+};
+
+// ------------------------------------------------------------------
+// Vertices (transcoded: the file's records are variable-size)
+// ------------------------------------------------------------------
+
+enum class PmxWeightType : uint8_t {
+    BDEF1 = 0,
+    BDEF2 = 1,
+    BDEF4 = 2,
+    SDEF  = 3,
+    QDEF  = 4    // 2.1; loaded as BDEF4 weights
+};
+
+constexpr uint32_t kPmxMaxBoneInfluences = 4;
+
+// One array per attribute. Unused influences have bone 0 and
+// weight 0, so skinning can always read four.
+struct PmxVertexTable {
+    uint32_t       count         = 0;
+    const float*   positions     = nullptr;   // xyz per vertex
+    const float*   normals       = nullptr;   // xyz
+    const float*   uvs           = nullptr;   // uv
+    const float*   additionalUvs = nullptr;   // [additionalUvCount][count] xyzw
+    const int32_t* boneIndices   = nullptr;   // 4 per vertex
+    const float*   boneWeights   = nullptr;   // 4 per vertex
+    const uint8_t* weightTypes   = nullptr;   // PmxWeightType
+    const float*   edgeScales    = nullptr;
+
+    // SDEF parameters, xyz per vertex (zero for other weight types);
+    // nullptr when the model has no SDEF vertices
+    const float*   sdefC         = nullptr;
+    const float*   sdefR0        = nullptr;
+    const float*   sdefR1        = nullptr;
+};
+
+// Triangle list indices in the file's width where possible (2- and
+// 4-byte indices are views into the mapping; 1-byte indices are
+// widened to 2 bytes)
+struct PmxIndexBuffer {
+    const void* data      = nullptr;
+    uint32_t    count     = 0;
+    uint8_t     indexSize = 0;        // 2 or 4
+    bool        mapped    = false;    // points into the file mapping
+
+    uint32_t Get(uint32_t i) const {
+        return indexSize == 2 ? static_cast<const uint16_t*>(data)[i]
+                              : static_cast<const uint32_t*>(data)[i];
+    }
+};
+
+// ------------------------------------------------------------------
+// Materials
+// ------------------------------------------------------------------
+
+enum PmxMaterialFlags : uint8_t {
+    kPmxMaterialDoubleSided  = 0x01,
+    kPmxMaterialGroundShadow = 0x02,
+    kPmxMaterialSelfShadowMap = 0x04,
+    kPmxMaterialSelfShadow   = 0x08,
+    kPmxMaterialEdge         = 0x10
+};
+
+struct PmxMaterial {
+    std::string_view name;
+    std::string_view nameEn;
+    float    diffuse[4]      = {};
+    float    specular[3]     = {};
+    float    specularPower   = 0.0f;
+    float    ambient[3]      = {};
+    uint8_t  drawFlags       = 0;      // PmxMaterialFlags
+    float    edgeColor[4]    = {};
+    float    edgeSize        = 0.0f;
+    int32_t  texture         = -1;     // index into GetTextures()
+    int32_t  sphereTexture   = -1;
+    uint8_t  sphereMode      = 0;      // 0 off, 1 multiply, 2 add, 3 sub-texture
+    bool     sharedToon      = false;  // toon is a shared toon01-10 index
+    int32_t  toon            = -1;     // texture index, or 0-9 if sharedToon
+    std::string_view memo;
+    uint32_t indexOffset     = 0;      // first index in GetIndices()
+    uint32_t indexCount      = 0;
+};
+
+// ------------------------------------------------------------------
+// Bones
+// ------------------------------------------------------------------
+
+enum PmxBoneFlags : uint16_t {
+    kPmxBoneTailIsBone          = 0x0001,
+    kPmxBoneRotatable           = 0x0002,
+    kPmxBoneTranslatable        = 0x0004,
+    kPmxBoneVisible             = 0x0008,
+    kPmxBoneEnabled             = 0x0010,
+    kPmxBoneIK                  = 0x0020,
+    kPmxBoneInheritRotation     = 0x0100,
+    kPmxBoneInheritTranslation  = 0x0200,
+    kPmxBoneFixedAxis           = 0x0400,
+    kPmxBoneLocalAxes           = 0x0800,
+    kPmxBonePhysicsAfterDeform  = 0x1000,
+    kPmxBoneExternalParent      = 0x2000
+};
+
+struct PmxIkLink {
+    int32_t bone         = -1;
+    bool    hasLimits    = false;
+    float   minAngle[3]  = {};     // radians
+    float   maxAngle[3]  = {};
+};
+
+struct PmxBone {
+    std::string_view name;
+    std::string_view nameEn;
+    float    position[3]    = {};
+    int32_t  parent         = -1;
+    int32_t  layer          = 0;
+    uint16_t flags          = 0;   // PmxBoneFlags
+    int32_t  tailBone       = -1;  // kPmxBoneTailIsBone
+    float    tailOffset[3]  = {};  // otherwise
+    int32_t  inheritParent  = -1;
+    float    inheritWeight  = 0.0f;
+    float    fixedAxis[3]   = {};
+    float    localX[3]      = {};
+    float    localZ[3]      = {};
+    int32_t  externalKey    = 0;
+    int32_t  ikTarget       = -1;
+    int32_t  ikLoopCount    = 0;
+    float    ikLimitAngle   = 0.0f;
+    uint32_t ikLinkOffset   = 0;   // into GetIkLinks()
+    uint32_t ikLinkCount    = 0;
+};
+
+// ------------------------------------------------------------------
+// Morphs
+// ------------------------------------------------------------------
+
+enum class PmxMorphType : uint8_t {
+    Group    = 0,
+    Vertex   = 1,
+    Bone     = 2,
+    Uv       = 3,
+    Uv1      = 4,
+    Uv2      = 5,
+    Uv3      = 6,
+    Uv4      = 7,
+    Material = 8,
+    Flip     = 9,     // 2.1
+    Impulse  = 10     // 2.1
+};
+
+// Offset records. The first four match the file layout when the
+// referenced index is 4 bytes wide, and are then views into the
+// mapping.
+struct PmxGroupMorphOffset {      // also Flip
+    int32_t morph;
+    float   weight;
+};
+
+struct PmxVertexMorphOffset {
+    int32_t vertex;
+    float   translation[3];
+};
+
+struct PmxBoneMorphOffset {
+    int32_t bone;
+    float   translation[3];
+    float   rotation[4];          // quaternion xyzw
+};
+
+struct PmxUvMorphOffset {
+    int32_t vertex;
+    float   value[4];
+};
+
+struct PmxMaterialMorphOffset {
+    int32_t material;             // -1 = all materials
+    uint8_t operation;            // 0 multiply, 1 add
+    float   diffuse[4];
+    float   specular[3];
+    float   specularPower;
+    float   ambient[3];
+    float   edgeColor[4];
+    float   edgeSize;
+    float   textureTint[4];
+    float   sphereTint[4];
+    float   toonTint[4];
+};
+
+struct PmxImpulseMorphOffset {
+    int32_t rigidBody;
+    bool    local;
+    float   velocity[3];
+    float   torque[3];
+};
+
+// Exactly one offset table is set, matching type
+struct PmxMorph {
+    std::string_view name;
+    std::string_view nameEn;
+    uint8_t      panel       = 0;   // 1 eyebrow, 2 eye, 3 mouth, 4 other
+    PmxMorphType type        = PmxMorphType::Group;
+    uint32_t     offsetCount = 0;
+    bool         mapped      = false;   // offsets point into the mapping
+
+    const PmxGroupMorphOffset*    group    = nullptr;   // Group, Flip
+    const PmxVertexMorphOffset*   vertex   = nullptr;
+    const PmxBoneMorphOffset*     bone     = nullptr;
+    const PmxUvMorphOffset*       uv       = nullptr;   // Uv .. Uv4
+    const PmxMaterialMorphOffset* material = nullptr;
+    const PmxImpulseMorphOffset*  impulse  = nullptr;
+};
+
+// ------------------------------------------------------------------
+// Load statistics
+// ------------------------------------------------------------------
+
+struct PmxLoadStats {
+    size_t fileBytes        = 0;
+    size_t arenaBytes       = 0;   // transcoded tables + strings
+    size_t mappedViewBytes  = 0;   // tables served straight from the file
+    float  mapMs            = 0.0f;
+    float  scanMs           = 0.0f;
+    float  transcodeMs      = 0.0f;
+    uint32_t transcodeJobs  = 0;
+};
+
+// PmxModel loads a PMX 2.0 / 2.1 model by mapping the file and
+// validating every section in place.
+//
+// Tables are served straight from the mapping where the file layout
+// is already what the engine wants (face indices, and morph offsets
+// whose index fields are 4 bytes wide). Everything else -- vertex
+// records, which are variable-size, narrow indices and UTF-16 strings
+// -- is transcoded into one LinearArena sized exactly by a first scan
+// pass, so a load makes one allocation. The transcode runs as
+// independent jobs (vertex chunks, faces, materials, bones, morphs)
+// on the JobSystem when one is given.
+//
+// Every index is range-checked, so a model that loads can be indexed
+// without further validation. Display frames, rigid bodies and joints
+// follow the morphs in the file and are not loaded; impulse morphs
+// keep their rigid body indices unchecked for a physics loader.
+//
+// Usage:
+//   PmxModel model;
+//   if (model.Load("mascot.pmx", &jobs)) {
+//       const PmxVertexTable& v = model.GetVertices();
+//       for (const PmxMaterial& m : model.GetMaterials()) { ... }
+//   }
+
+class PmxModel {
+public:
+    PmxModel() = default;
+    ~PmxModel() = default;
+
+    PmxModel(const PmxModel&) = delete;
+    PmxModel& operator=(const PmxModel&) = delete;
+
+    // Map and parse path (UTF-8). Returns false (and logs why) if the
+    // file cannot be mapped or is not a valid PMX model.
+    bool Load(const std::string& path, jobs::JobSystem* jobs = nullptr);
+
+    // Parse an in-memory image. data must outlive the model.
+    bool LoadFromMemory(const uint8_t* data, size_t size, jobs::JobSystem* jobs = nullptr);
+
+    void Unload();
+    bool IsLoaded() const { return m_loaded; }
+
+    const PmxHeader&        GetHeader() const   { return m_header; }
+    const PmxModelInfo&     GetInfo() const     { return m_info; }
+    const PmxVertexTable&   GetVertices() const { return m_vertices; }
+    const PmxIndexBuffer&   GetIndices() const  { return m_indices; }
+    PmxArray<std::string_view> GetTextures() const  { return m_textures; }
+    PmxArray<PmxMaterial>      GetMaterials() const { return m_materials; }
+    PmxArray<PmxBone>          GetBones() const     { return m_bones; }
+    PmxArray<PmxIkLink>        GetIkLinks() const   { return m_ikLinks; }
+    PmxArray<PmxMorph>         GetMorphs() const    { return m_morphs; }
+
+    const PmxLoadStats& GetLoadStats() const { return m_stats; }
+
+private:
+    bool Parse(const uint8_t* data, size_t size, jobs::JobSystem* jobs);
+
+    MappedFile          m_file;
+    memory::LinearArena m_arena;
+    memory::TrackedMemory m_arenaMemory{memory::MemoryCategory::Asset};
+    bool                m_loaded = false;
+
+    PmxHeader                  m_header;
+    PmxModelInfo               m_info;
+    PmxVertexTable             m_vertices;
+    PmxIndexBuffer             m_indices;
+    PmxArray<std::string_view> m_textures;
+    PmxArray<PmxMaterial>      m_materials;
+    PmxArray<PmxBone>          m_bones;
+    PmxArray<PmxIkLink>        m_ikLinks;
+    PmxArray<PmxMorph>         m_morphs;
+    PmxLoadStats               m_stats;
+};
+
+} // namespace assets
+} // namespace core
+} // namespace dmme
\ No newline at end of file
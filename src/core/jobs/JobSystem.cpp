@@ -0,0 +1,137 @@
+#include "JobSystem.h"
+#include "utils/Logger.h"
+
+#include <algorithm>
+
+namespace dmme {
+namespace core {
+namespace jobs {
+
+// ===================================================================
+// Lifecycle
+// ===================================================================
+
+JobSystem::JobSystem(int workerCount) {
+    if (workerCount < 0) {
+        const unsigned hw = std::thread::hardware_concurrency();
+        workerCount = hw > 1 ? static_cast<int>(hw) - 1 : 0;
+    }
+
+    m_workers.reserve(static_cast<size_t>(workerCount));
+    for (int i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back(&JobSystem::WorkerLoop, this);
+    }
+
+    DMME_LOG_INFO("JobSystem started with {} worker thread(s)", workerCount);
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+uint32_t JobSystem::GetWorkerCount() const {
+    return static_cast<uint32_t>(m_workers.size());
+}
+
+uint32_t JobSystem::GetConcurrency() const {
+    return GetWorkerCount() + 1;
+}
+
+// ===================================================================
+// Dispatch
+// ===================================================================
+
+void JobSystem::Dispatch(uint32_t count, IndexFn fn, void* context) {
+    if (count == 0) {
+        return;
+    }
+
+    // Nothing to share: skip the handshake entirely
+    if (m_workers.empty() || count == 1) {
+        for (uint32_t i = 0; i < count; ++i) {
+            fn(context, i);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> dispatchLock(m_dispatchMutex);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_fn      = fn;
+        m_context = context;
+        m_count   = count;
+        m_next.store(0, std::memory_order_relaxed);
+        m_completed.store(0, std::memory_order_relaxed);
+        m_generation++;
+    }
+    m_wake.notify_all();
+
+    RunIndices();
+
+    // Wait for the last index, and for every worker to leave this
+    // dispatch so none of them can claim from the next one.
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] {
+        return m_completed.load(std::memory_order_acquire) == m_count && m_busyWorkers == 0;
+    });
+    m_fn      = nullptr;
+    m_context = nullptr;
+}
+
+void JobSystem::RunIndices() {
+    const uint32_t count = m_count;
+    for (;;) {
+        const uint32_t index = m_next.fetch_add(1, std::memory_order_relaxed);
+        if (index >= count) {
+            return;
+        }
+        m_fn(m_context, index);
+        m_completed.fetch_add(1, std::memory_order_release);
+    }
+}
+
+// ===================================================================
+// Workers
+// ===================================================================
+
+void JobSystem::WorkerLoop() {
+    uint64_t seenGeneration = 0;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this, seenGeneration] {
+                return m_stop || m_generation != seenGeneration;
+            });
+            if (m_stop) {
+                return;
+            }
+            seenGeneration = m_generation;
+            if (!m_fn) {
+                continue;   // dispatch already finished without us
+            }
+            m_busyWorkers++;
+        }
+
+        RunIndices();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_busyWorkers--;
+        }
+        m_done.notify_one();
+    }
+}
+
+} // namespace jobs
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace dmme {
+namespace core {
+namespace jobs {
+
+// JobSystem runs data-parallel work on a fixed set of worker threads.
+//
+// ParallelFor(count, fn) calls fn(index) once for every index in
+// [0, count) and returns when all of them have finished. The calling
+// thread claims indices too, so a JobSystem with zero workers simply
+// runs the loop inline. Indices are claimed one at a time from a
+// shared counter, so uneven items (e.g. tiles that are mostly empty)
+// balance themselves.
+//
+// Dispatch does not allocate: the callable is passed by reference
+// through a plain function pointer, so ParallelFor is safe inside
+// steady-state frames watched by FrameAllocationGuard. One dispatch
+// runs at a time; concurrent callers are serialised.
+//
+// fn must not call ParallelFor on the same JobSystem.
+//
+// Usage:
+//   JobSystem jobs;                       // hardware threads - 1 workers
+//   jobs.ParallelFor(tileCount, [&](uint32_t tile) { ShadeTile(tile); });
+
+class JobSystem {
+public:
+    // workerCount < 0 picks hardware_concurrency - 1 (the caller is the
+    // last thread); 0 runs everything on the calling thread.
+    explicit JobSystem(int workerCount = -1);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    template <typename Fn>
+    void ParallelFor(uint32_t count, Fn&& fn) {
+        using Callable = std::remove_reference_t<Fn>;
+        Dispatch(count,
+                 [](void* context, uint32_t index) { (*static_cast<Callable*>(context))(index); },
+                 const_cast<void*>(static_cast<const void*>(&fn)));
+    }
+
+    // Worker threads (not counting the caller)
+    uint32_t GetWorkerCount() const;
+
+    // Threads that take part in a ParallelFor (workers + caller)
+    uint32_t GetConcurrency() const;
+
+private:
+    using IndexFn = void (*)(void* context, uint32_t index);
+
+    void Dispatch(uint32_t count, IndexFn fn, void* context);
+    void RunIndices();
+    void WorkerLoop();
+
+    std::vector<std::thread> m_workers;
+    std::mutex               m_dispatchMutex;    // one ParallelFor at a time
+
+    // --- Current dispatch (written under m_mutex) ---
+    std::mutex               m_mutex;
+    std::condition_variable  m_wake;
+    std::condition_variable  m_done;
+    IndexFn                  m_fn       = nullptr;
+    void*                    m_context  = nullptr;
+    uint32_t                 m_count    = 0;
+    uint64_t                 m_generation = 0;
+    uint32_t                 m_busyWorkers = 0;   // workers inside RunIndices
+    bool                     m_stop     = false;
+
+    std::atomic<uint32_t>    m_next{0};
+    std::atomic<uint32_t>    m_completed{0};
+};
+
+} // namespace jobs
+} // namespace core
+} // namespace dmme
\ No newline at end of file
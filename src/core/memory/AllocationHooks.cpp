@@ -0,0 +1,113 @@
+// Replacement global operator new / delete that feed AllocationTracker.
+//
+// Linked straight into the executable (object library) so the
+// replacements are always picked up: the engine when configured with
+// -DDMME_ALLOC_TRACKING=ON, the allocation guard test in every build.
+
+#include "AllocationTracker.h"
+
+#include <cstdlib>
+#include <new>
+
+using dmme::core::memory::AllocationTracker;
+
+namespace {
+
+void* TrackedAlloc(std::size_t size) noexcept {
+    AllocationTracker::OnAllocate(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* TrackedAlignedAlloc(std::size_t size, std::align_val_t align) noexcept {
+    AllocationTracker::OnAllocate(size);
+    const std::size_t alignment = static_cast<std::size_t>(align);
+#if defined(_MSC_VER)
+    return _aligned_malloc(size ? size : 1, alignment);
+#else
+    void* p = nullptr;
+    const std::size_t a = alignment < sizeof(void*) ? sizeof(void*) : alignment;
+    return posix_memalign(&p, a, size ? size : 1) == 0 ? p : nullptr;
+#endif
+}
+
+void TrackedFree(void* p) noexcept {
+    if (p) {
+        AllocationTracker::OnFree();
+        std::free(p);
+    }
+}
+
+void TrackedAlignedFree(void* p) noexcept {
+    if (p) {
+        AllocationTracker::OnFree();
+#if defined(_MSC_VER)
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+}
+
+} // anonymous namespace
+
+// ===================================================================
+// Plain
+// ===================================================================
+
+void* operator new(std::size_t size) {
+    void* p = TrackedAlloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t size) {
+    void* p = TrackedAlloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return TrackedAlloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return TrackedAlloc(size);
+}
+
+void operator delete(void* p) noexcept                                { TrackedFree(p); }
+void operator delete[](void* p) noexcept                              { TrackedFree(p); }
+void operator delete(void* p, std::size_t) noexcept                   { TrackedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept                 { TrackedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept         { TrackedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept       { TrackedFree(p); }
+
+// ===================================================================
+// Over-aligned (C++17)
+// ===================================================================
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    void* p = TrackedAlignedAlloc(size, align);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t size, std::align_val_t align) {
+    void* p = TrackedAlignedAlloc(size, align);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return TrackedAlignedAlloc(size, align);
+}
+
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return TrackedAlignedAlloc(size, align);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept                          { TrackedAlignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept                        { TrackedAlignedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept             { TrackedAlignedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept           { TrackedAlignedFree(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept   { TrackedAlignedFree(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { TrackedAlignedFree(p); }
\ No newline at end of file
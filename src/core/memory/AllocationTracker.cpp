@@ -0,0 +1,68 @@
+#include "AllocationTracker.h"
+
+#include <atomic>
+
+namespace dmme {
+namespace core {
+namespace memory {
+
+namespace {
+
+// Constant-initialized and trivially destructible, so touching it from
+// inside operator new never triggers TLS construction or allocation.
+struct ThreadAllocationState {
+    AllocationCounters counters;
+    AllocSubsystem     current = AllocSubsystem::Unattributed;
+};
+
+thread_local ThreadAllocationState t_state;
+
+std::atomic<uint64_t> g_processAllocations{0};
+
+} // anonymous namespace
+
+// ===================================================================
+// Hook Entry Points
+// ===================================================================
+
+void AllocationTracker::OnAllocate(size_t bytes) noexcept {
+    ThreadAllocationState& s = t_state;
+    s.counters.allocations++;
+    s.counters.bytes += bytes;
+    s.counters.bySubsystem[static_cast<size_t>(s.current)]++;
+    g_processAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AllocationTracker::OnFree() noexcept {
+    t_state.counters.frees++;
+}
+
+// ===================================================================
+// Queries
+// ===================================================================
+
+AllocationCounters AllocationTracker::GetThreadCounters() noexcept {
+    return t_state.counters;
+}
+
+uint64_t AllocationTracker::GetProcessAllocations() noexcept {
+    return g_processAllocations.load(std::memory_order_relaxed);
+}
+
+// ===================================================================
+// Attribution
+// ===================================================================
+
+AllocSubsystem AllocationTracker::GetCurrentSubsystem() noexcept {
+    return t_state.current;
+}
+
+AllocSubsystem AllocationTracker::SetCurrentSubsystem(AllocSubsystem subsystem) noexcept {
+    const AllocSubsystem previous = t_state.current;
+    t_state.current = subsystem;
+    return previous;
+}
+
+} // namespace memory
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace dmme {
+namespace core {
+namespace memory {
+
+// ------------------------------------------------------------------
+// Subsystems that heap allocations are attributed to
+// ------------------------------------------------------------------
+
+enum class AllocSubsystem : uint8_t {
+    Unattributed = 0,   // no AllocationScope active
+    Renderer     = 1,
+    Window       = 2,
+    Runtime      = 3,
+    Profiling    = 4,
+    Count        = 5
+};
+
+constexpr size_t kAllocSubsystemCount = static_cast<size_t>(AllocSubsystem::Count);
+
+inline const char* AllocSubsystemName(AllocSubsystem subsystem) {
+    switch (subsystem) {
+        case AllocSubsystem::Unattributed: return "unattributed";
+        case AllocSubsystem::Renderer:     return "renderer";
+        case AllocSubsystem::Window:       return "window";
+        case AllocSubsystem::Runtime:      return "runtime";
+        case AllocSubsystem::Profiling:    return "profiling";
+        default:                           return "unknown";
+    }
+}
+
+// ------------------------------------------------------------------
+// Running allocation totals (monotonic; diff two samples for a span)
+// ------------------------------------------------------------------
+
+struct AllocationCounters {
+    uint64_t allocations = 0;
+    uint64_t bytes       = 0;
+    uint64_t frees       = 0;
+    std::array<uint64_t, kAllocSubsystemCount> bySubsystem{};  // allocations
+
+    // Counts accumulated between earlier and this sample
+    AllocationCounters Since(const AllocationCounters& earlier) const {
+        AllocationCounters d;
+        d.allocations = allocations - earlier.allocations;
+        d.bytes       = bytes - earlier.bytes;
+        d.frees       = frees - earlier.frees;
+        for (size_t i = 0; i < kAllocSubsystemCount; ++i) {
+            d.bySubsystem[i] = bySubsystem[i] - earlier.bySubsystem[i];
+        }
+        return d;
+    }
+};
+
+// AllocationTracker counts heap allocations made through the global
+// operator new / delete.
+//
+// Counting only happens in executables that link the replacement
+// operators (AllocationHooks.cpp): the engine in builds configured with
+// -DDMME_ALLOC_TRACKING=ON, and the allocation guard test always. In
+// other executables every counter stays zero and the scopes cost one
+// thread-local store.
+//
+// Counters are per thread. Frame budgets are about the render thread,
+// and background threads (metrics endpoint, log flusher) may allocate
+// freely. A process-wide total is kept as well.
+//
+// Attribution uses AllocationScope:
+//   {
+//       AllocationScope scope(AllocSubsystem::Renderer);
+//       ...allocations here count toward "renderer"...
+//   }
+
+class AllocationTracker {
+public:
+    // True in DMME_ALLOC_TRACKING builds, where the engine links the
+    // operator new hooks
+    static constexpr bool IsEnabled() {
+#if defined(DMME_ALLOC_TRACKING)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // --- Hook entry points (must not allocate) ---
+    static void OnAllocate(size_t bytes) noexcept;
+    static void OnFree() noexcept;
+
+    // --- Queries ---
+    static AllocationCounters GetThreadCounters() noexcept;
+    static uint64_t           GetProcessAllocations() noexcept;
+
+    // --- Attribution ---
+    static AllocSubsystem GetCurrentSubsystem() noexcept;
+    static AllocSubsystem SetCurrentSubsystem(AllocSubsystem subsystem) noexcept;  // returns previous
+};
+
+// RAII attribution of the calling thread's allocations. Scopes nest;
+// the innermost wins.
+class AllocationScope {
+public:
+    explicit AllocationScope(AllocSubsystem subsystem) noexcept
+        : m_previous(AllocationTracker::SetCurrentSubsystem(subsystem)) {}
+
+    ~AllocationScope() {
+        AllocationTracker::SetCurrentSubsystem(m_previous);
+    }
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+private:
+    AllocSubsystem m_previous;
+};
+
+} // namespace memory
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "FrameAllocationGuard.h"
+#include "utils/Logger.h"
+
+#include <cstdlib>
+
+namespace dmme {
+namespace core {
+namespace memory {
+
+// ===================================================================
+// Construction
+// ===================================================================
+
+FrameAllocationGuard::FrameAllocationGuard(const FrameAllocationGuardConfig& config)
+    : m_config(config)
+    , m_warmupEndFrame(config.warmupFrames) {
+    if constexpr (AllocationTracker::IsEnabled()) {
+        DMME_LOG_INFO("FrameAllocationGuard active (warmup={} frames, fatal={})",
+                      m_config.warmupFrames, m_config.failOnAllocation);
+    }
+}
+
+// ===================================================================
+// Frame Bracket
+// ===================================================================
+
+void FrameAllocationGuard::BeginFrame() {
+    m_frameStart = AllocationTracker::GetThreadCounters();
+    m_inFrame    = true;
+}
+
+const AllocationCounters& FrameAllocationGuard::EndFrame() {
+    if (!m_inFrame) {
+        return m_lastFrame;
+    }
+    m_inFrame   = false;
+    m_lastFrame = AllocationTracker::GetThreadCounters().Since(m_frameStart);
+    m_frameCount++;
+
+    if (m_lastFrame.allocations > 0 && IsSteadyState()) {
+        m_violations++;
+        ReportViolation();
+    }
+    return m_lastFrame;
+}
+
+void FrameAllocationGuard::ResetWarmup() {
+    m_warmupEndFrame = m_frameCount + m_config.warmupFrames;
+}
+
+// ===================================================================
+// Configuration / Queries
+// ===================================================================
+
+void FrameAllocationGuard::SetFailOnAllocation(bool fail) {
+    m_config.failOnAllocation = fail;
+}
+
+bool FrameAllocationGuard::IsSteadyState() const {
+    return m_frameCount > m_warmupEndFrame;
+}
+
+const AllocationCounters& FrameAllocationGuard::GetLastFrame() const {
+    return m_lastFrame;
+}
+
+uint64_t FrameAllocationGuard::GetFrameCount() const {
+    return m_frameCount;
+}
+
+uint64_t FrameAllocationGuard::GetViolationCount() const {
+    return m_violations;
+}
+
+// ===================================================================
+// Internal
+// ===================================================================
+
+void FrameAllocationGuard::ReportViolation() {
+    const bool fatal = m_config.failOnAllocation;
+    const bool log   = fatal || m_violations <= m_config.maxLoggedViolations ||
+                       m_violations % 1000 == 0;
+
+    if (log) {
+        const auto& by = m_lastFrame.bySubsystem;
+        DMME_LOG_WARN("Steady-state frame {} allocated {} times ({} bytes): "
+                      "renderer={} window={} runtime={} profiling={} unattributed={} "
+                      "[violation #{}]",
+                      m_frameCount, m_lastFrame.allocations, m_lastFrame.bytes,
+                      by[static_cast<size_t>(AllocSubsystem::Renderer)],
+                      by[static_cast<size_t>(AllocSubsystem::Window)],
+                      by[static_cast<size_t>(AllocSubsystem::Runtime)],
+                      by[static_cast<size_t>(AllocSubsystem::Profiling)],
+                      by[static_cast<size_t>(AllocSubsystem::Unattributed)],
+                      m_violations);
+    }
+
+    if (fatal) {
+        DMME_LOG_CRITICAL("FrameAllocationGuard: steady-state allocation with failOnAllocation set, aborting");
+        if (utils::Logger::Get()) {
+            utils::Logger::Get()->flush();
+        }
+        std::abort();
+    }
+}
+
+} // namespace memory
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "AllocationTracker.h"
+
+#include <cstdint>
+
+namespace dmme {
+namespace core {
+namespace memory {
+
+struct FrameAllocationGuardConfig {
+    // Frames allowed to allocate after startup (or ResetWarmup) while
+    // caches, buffers and driver resources settle.
+    uint64_t warmupFrames     = 120;
+
+    // Abort the process on the first steady-state allocation, so a
+    // bench or CI run fails loudly instead of logging.
+    bool     failOnAllocation = false;
+
+    // Log at most this many violations (then every 1000th)
+    uint64_t maxLoggedViolations = 10;
+};
+
+// FrameAllocationGuard brackets each main-loop frame and checks that
+// steady-state frames make no heap allocations on the render thread.
+//
+// Violations are logged with a per-subsystem breakdown (see
+// AllocationScope). Allocations made by the guard's own logging fall
+// outside the bracket. Builds without DMME_ALLOC_TRACKING always report
+// zero, so the guard costs nothing there.
+//
+// Usage:
+//   FrameAllocationGuard guard;
+//   // per frame:
+//   guard.BeginFrame();
+//   ...update, render, present...
+//   const AllocationCounters& frame = guard.EndFrame();
+//   // after a deliberate reallocation (resize, asset load):
+//   guard.ResetWarmup();
+
+class FrameAllocationGuard {
+public:
+    explicit FrameAllocationGuard(const FrameAllocationGuardConfig& config = {});
+    ~FrameAllocationGuard() = default;
+
+    FrameAllocationGuard(const FrameAllocationGuard&) = delete;
+    FrameAllocationGuard& operator=(const FrameAllocationGuard&) = delete;
+
+    void BeginFrame();
+
+    // Close the frame, check it, and return its allocation counts.
+    const AllocationCounters& EndFrame();
+
+    // Restart the warm-up period.
+    void ResetWarmup();
+
+    // --- Configuration ---
+    void SetFailOnAllocation(bool fail);
+
+    // --- Queries ---
+    bool                      IsSteadyState() const;
+    const AllocationCounters& GetLastFrame() const;
+    uint64_t                  GetFrameCount() const;
+    uint64_t                  GetViolationCount() const;
+
+private:
+    void ReportViolation();
+
+    FrameAllocationGuardConfig m_config;
+    AllocationCounters m_frameStart;
+    AllocationCounters m_lastFrame;
+    uint64_t           m_frameCount      = 0;
+    uint64_t           m_warmupEndFrame  = 0;
+    uint64_t           m_violations      = 0;
+    bool               m_inFrame         = false;
+};
+
+} // namespace memory
+} // namespace core
+} // namespace dmme
\ No newline at end of file
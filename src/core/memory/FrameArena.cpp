@@ -0,0 +1,191 @@
+#include "FrameArena.h"
+#include "utils/Logger.h"
+
+#include <algorithm>
+
+namespace dmme {
+namespace core {
+namespace memory {
+
+namespace {
+
+// Distinguishes FrameArena instances in the per-thread slot cache, so
+// a new arena at a recycled address is never mistaken for the old one.
+std::atomic<uint64_t> g_nextInstanceId{1};
+
+struct WorkerSlot {
+    uint64_t arenaId = 0;
+    uint32_t slot    = 0;
+};
+
+thread_local WorkerSlot t_workerSlot;
+
+constexpr uint32_t kNoSlot = 0xFFFFFFFFu;
+
+} // anonymous namespace
+
+// ===================================================================
+// Lifecycle
+// ===================================================================
+
+bool FrameArena::Initialize(const FrameArenaConfig& config) {
+    Shutdown();
+
+    m_config = config;
+    m_config.maxWorkers = std::min(m_config.maxWorkers, kMaxWorkers);
+
+    for (size_t gen = 0; gen < 2; ++gen) {
+        if (!m_main[gen].Init(m_config.mainBytes)) {
+            Shutdown();
+            return false;
+        }
+        m_workers[gen].resize(m_config.maxWorkers);
+        for (auto& worker : m_workers[gen]) {
+            if (!worker.Init(m_config.workerBytes)) {
+                Shutdown();
+                return false;
+            }
+        }
+    }
+
+    m_instanceId  = g_nextInstanceId.fetch_add(1, std::memory_order_relaxed);
+    m_current     = 0;
+    m_frameIndex  = 0;
+    m_highWater   = 0;
+    m_lastStats   = {};
+    m_workersClaimed.store(0, std::memory_order_relaxed);
+    m_initialized = true;
+    m_trackedMemory.Set(2 * (m_config.mainBytes +
+                             static_cast<uint64_t>(m_config.maxWorkers) * m_config.workerBytes));
+
+    DMME_LOG_INFO("FrameArena initialized: main={} KB, {} workers x {} KB (double-buffered)",
+                  m_config.mainBytes / 1024, m_config.maxWorkers,
+                  m_config.workerBytes / 1024);
+    return true;
+}
+
+void FrameArena::Shutdown() {
+    for (size_t gen = 0; gen < 2; ++gen) {
+        m_main[gen].Release();
+        m_workers[gen].clear();
+    }
+    m_trackedMemory.Reset();
+    m_initialized = false;
+}
+
+bool FrameArena::IsInitialized() const {
+    return m_initialized;
+}
+
+// ===================================================================
+// Frame Boundary
+// ===================================================================
+
+void FrameArena::BeginFrame() {
+    if (!m_initialized) {
+        return;
+    }
+
+    // --- Close the frame that just ended ---
+    m_lastStats = CollectStats();
+    m_highWater = std::max(m_highWater, m_lastStats.usedBytes);
+    m_lastStats.highWaterBytes = m_highWater;
+
+    if (m_lastStats.overflowCount > 0) {
+        DMME_LOG_WARN("FrameArena overflow in frame {}: {} allocations ({} bytes) "
+                      "fell back to the heap (used {} of {} bytes)",
+                      m_lastStats.frameIndex, m_lastStats.overflowCount,
+                      m_lastStats.overflowBytes, m_lastStats.usedBytes,
+                      m_lastStats.capacityBytes);
+    }
+
+    // --- Flip and reset: O(1) per arena ---
+    m_current ^= 1u;
+    m_frameIndex++;
+
+    m_main[m_current].Reset();
+    m_main[m_current].ResetOverflow();
+
+    const uint32_t claimed = std::min(m_workersClaimed.load(std::memory_order_acquire),
+                                      m_config.maxWorkers);
+    for (uint32_t i = 0; i < claimed; ++i) {
+        m_workers[m_current][i].Reset();
+        m_workers[m_current][i].ResetOverflow();
+    }
+}
+
+// ===================================================================
+// Arenas
+// ===================================================================
+
+LinearArena& FrameArena::MainArena() {
+    return m_main[m_current];
+}
+
+LinearArena& FrameArena::PreviousMainArena() {
+    return m_main[m_current ^ 1u];
+}
+
+LinearArena* FrameArena::WorkerArena() {
+    if (!m_initialized) {
+        return nullptr;
+    }
+
+    WorkerSlot& cached = t_workerSlot;
+    if (cached.arenaId != m_instanceId) {
+        const uint32_t slot = m_workersClaimed.fetch_add(1, std::memory_order_acq_rel);
+        cached.arenaId = m_instanceId;
+        cached.slot    = (slot < m_config.maxWorkers) ? slot : kNoSlot;
+        if (cached.slot == kNoSlot) {
+            DMME_LOG_WARN("FrameArena: no worker sub-arena left ({} max)", m_config.maxWorkers);
+        }
+    }
+
+    if (cached.slot == kNoSlot) {
+        return nullptr;
+    }
+    return &m_workers[m_current][cached.slot];
+}
+
+// ===================================================================
+// Stats
+// ===================================================================
+
+const FrameArenaStats& FrameArena::GetLastFrameStats() const {
+    return m_lastStats;
+}
+
+size_t FrameArena::GetUsedBytes() const {
+    return CollectStats().usedBytes;
+}
+
+uint64_t FrameArena::GetFrameIndex() const {
+    return m_frameIndex;
+}
+
+FrameArenaStats FrameArena::CollectStats() const {
+    FrameArenaStats stats;
+    stats.frameIndex = m_frameIndex;
+
+    const LinearArena& main = m_main[m_current];
+    stats.capacityBytes = main.GetCapacity();
+    stats.usedBytes     = main.GetUsed();
+    stats.overflowCount = main.GetOverflowCount();
+    stats.overflowBytes = main.GetOverflowBytes();
+
+    const uint32_t claimed = std::min(m_workersClaimed.load(std::memory_order_acquire),
+                                      m_config.maxWorkers);
+    stats.workersInUse = claimed;
+    for (uint32_t i = 0; i < claimed; ++i) {
+        const LinearArena& worker = m_workers[m_current][i];
+        stats.capacityBytes += worker.GetCapacity();
+        stats.usedBytes     += worker.GetUsed();
+        stats.overflowCount += worker.GetOverflowCount();
+        stats.overflowBytes += worker.GetOverflowBytes();
+    }
+    return stats;
+}
+
+} // namespace memory
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "LinearArena.h"
+#include "MemoryAccountant.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace dmme {
+namespace core {
+namespace memory {
+
+struct FrameArenaConfig {
+    size_t   mainBytes   = 1 << 20;   // owner (render) thread, per generation
+    size_t   workerBytes = 256 << 10; // each worker sub-arena, per generation
+    uint32_t maxWorkers  = 8;         // worker threads that may claim a sub-arena
+};
+
+struct FrameArenaStats {
+    uint64_t frameIndex      = 0;
+    size_t   capacityBytes   = 0;     // main + claimed workers, one generation
+    size_t   usedBytes       = 0;     // used by the reported frame
+    size_t   highWaterBytes  = 0;     // peak of usedBytes over all frames
+    uint64_t overflowCount   = 0;     // failed allocations in the frame
+    size_t   overflowBytes   = 0;
+    uint32_t workersInUse    = 0;
+};
+
+// FrameArena is the home for per-frame transient data (damage rects,
+// input event lists, command buffers, dirty spans, stats scratch)
+// that would otherwise go through std::vector and the heap.
+//
+// - Double-buffered: BeginFrame flips generations and resets the new
+//   one, so data allocated in frame N stays valid through frame N+1.
+// - Worker threads get their own sub-arena (WorkerArena()) so they
+//   never contend with the render thread or each other.
+// - Overflowing allocations return nullptr (FrameAllocator falls back
+//   to the heap). Overflow and the high-water mark are reported at
+//   the next BeginFrame so the arena can be sized up.
+// - BeginFrame is O(1) per arena: offsets are rewound, memory is not
+//   touched.
+//
+// RenderPipeline owns one and calls BeginFrame from its own
+// BeginFrame. Worker threads must be idle across that call.
+
+class FrameArena {
+public:
+    static constexpr uint32_t kMaxWorkers = 32;
+
+    FrameArena() = default;
+    ~FrameArena() = default;
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // Allocate all blocks up front (2 x main, 2 x maxWorkers workers).
+    bool Initialize(const FrameArenaConfig& config = {});
+    void Shutdown();
+    bool IsInitialized() const;
+
+    // Close the current frame (collect stats, report overflow), then
+    // flip to the other generation and reset it.
+    void BeginFrame();
+
+    // --- Arenas for the current frame ---
+    LinearArena& MainArena();              // owner thread only
+    LinearArena& PreviousMainArena();      // last frame's data, read-only use
+    LinearArena* WorkerArena();            // calling worker's sub-arena, or nullptr
+
+    // --- Stats ---
+    const FrameArenaStats& GetLastFrameStats() const;   // frame closed by BeginFrame
+    size_t   GetUsedBytes() const;                      // current frame so far
+    uint64_t GetFrameIndex() const;
+
+private:
+    FrameArenaStats CollectStats() const;
+
+    FrameArenaConfig m_config;
+    bool             m_initialized = false;
+    uint64_t         m_instanceId  = 0;
+    uint32_t         m_current     = 0;     // generation index (0/1)
+    uint64_t         m_frameIndex  = 0;
+
+    std::array<LinearArena, 2>              m_main;
+    std::array<std::vector<LinearArena>, 2> m_workers;
+    std::atomic<uint32_t>                   m_workersClaimed{0};
+
+    FrameArenaStats  m_lastStats;
+    size_t           m_highWater = 0;
+    TrackedMemory    m_trackedMemory{MemoryCategory::FrameArena};
+};
+
+// ------------------------------------------------------------------
+// std-compatible allocator over a LinearArena
+// ------------------------------------------------------------------
+
+// Lets standard containers use frame memory:
+//
+//   FrameVector<DamageRect> rects{FrameAllocator<DamageRect>(arena.MainArena())};
+//   rects.reserve(64);
+//
+// deallocate is a no-op for arena memory; everything is reclaimed by
+// the arena reset, so containers must not outlive their frame (two
+// frames for the double-buffered FrameArena). If the arena is full,
+// allocate falls back to the heap and deallocate frees that block.
+// Reserve up front: growth leaves the old block behind in the arena.
+
+template <typename T>
+class FrameAllocator {
+public:
+    using value_type = T;
+
+    explicit FrameAllocator(LinearArena& arena) noexcept : m_arena(&arena) {}
+
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U>& other) noexcept : m_arena(other.GetArena()) {}
+
+    T* allocate(size_t n) {
+        void* p = m_arena->Allocate(n * sizeof(T), alignof(T));
+        if (!p) {
+            if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+                p = ::operator new(n * sizeof(T), std::align_val_t(alignof(T)));
+            } else {
+                p = ::operator new(n * sizeof(T));
+            }
+        }
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_t /*n*/) noexcept {
+        if (m_arena->Owns(p)) {
+            return;
+        }
+        if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(p, std::align_val_t(alignof(T)));
+        } else {
+            ::operator delete(p);
+        }
+    }
+
+    LinearArena* GetArena() const noexcept { return m_arena; }
+
+    template <typename U>
+    bool operator==(const FrameAllocator<U>& other) const noexcept {
+        return m_arena == other.GetArena();
+    }
+
+    template <typename U>
+    bool operator!=(const FrameAllocator<U>& other) const noexcept {
+        return m_arena != other.GetArena();
+    }
+
+private:
+    LinearArena* m_arena;
+};
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+} // namespace memory
+} // namespace core
+} // namespace dmme
\ No newline at end of file
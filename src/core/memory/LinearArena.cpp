@@ -0,0 +1,53 @@
+#include "LinearArena.h"
+#include "utils/Logger.h"
+
+#include <new>
+
+namespace dmme {
+namespace core {
+namespace memory {
+
+// ===================================================================
+// Construction
+// ===================================================================
+
+LinearArena::LinearArena(size_t capacity) {
+    Init(capacity);
+}
+
+bool LinearArena::Init(size_t capacity) {
+    Release();
+    if (capacity == 0) {
+        return true;
+    }
+
+    m_storage.reset(new (std::nothrow) uint8_t[capacity + kBlockAlignment]);
+    if (!m_storage) {
+        DMME_LOG_ERROR("LinearArena: failed to allocate {} bytes", capacity);
+        return false;
+    }
+
+    const uintptr_t raw = reinterpret_cast<uintptr_t>(m_storage.get());
+    const uintptr_t aligned = (raw + kBlockAlignment - 1) & ~static_cast<uintptr_t>(kBlockAlignment - 1);
+    m_base     = reinterpret_cast<uint8_t*>(aligned);
+    m_capacity = capacity;
+    return true;
+}
+
+void LinearArena::Release() {
+    m_storage.reset();
+    m_base      = nullptr;
+    m_capacity  = 0;
+    m_offset    = 0;
+    m_highWater = 0;
+    ResetOverflow();
+}
+
+void LinearArena::ResetOverflow() {
+    m_overflowCount = 0;
+    m_overflowBytes = 0;
+}
+
+} // namespace memory
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+namespace dmme {
+namespace core {
+namespace memory {
+
+// LinearArena is a fixed-capacity bump allocator.
+//
+// The backing block is allocated once (Init); Allocate bumps an
+// offset and Reset rewinds it in O(1). Individual frees are not
+// supported. Requests that do not fit return nullptr and are counted
+// as overflow so the owner can report them and size the arena up.
+//
+// Not thread-safe: one thread allocates from a given arena.
+
+class LinearArena {
+public:
+    // Alignment of the backing block (cache line)
+    static constexpr size_t kBlockAlignment = 64;
+
+    LinearArena() = default;
+    explicit LinearArena(size_t capacity);
+    ~LinearArena() = default;
+
+    LinearArena(const LinearArena&) = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+    LinearArena(LinearArena&&) noexcept = default;
+    LinearArena& operator=(LinearArena&&) noexcept = default;
+
+    // Allocate the backing block. Discards any previous block.
+    bool Init(size_t capacity);
+    void Release();
+
+    // Returns nullptr (and records overflow) if the request does not
+    // fit. alignment must be a power of two.
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    // Uninitialized storage for count objects of T
+    template <typename T>
+    T* AllocateArray(size_t count) {
+        return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    // Rewind to empty. Overflow counters are kept (see ResetOverflow).
+    void Reset();
+    void ResetOverflow();
+
+    bool Owns(const void* p) const;
+
+    // --- Queries ---
+    size_t   GetCapacity() const      { return m_capacity; }
+    size_t   GetUsed() const          { return m_offset; }
+    size_t   GetHighWater() const     { return m_highWater; }
+    uint64_t GetOverflowCount() const { return m_overflowCount; }
+    size_t   GetOverflowBytes() const { return m_overflowBytes; }
+
+private:
+    std::unique_ptr<uint8_t[]> m_storage;
+    uint8_t*  m_base          = nullptr;   // m_storage aligned up
+    size_t    m_capacity      = 0;
+    size_t    m_offset        = 0;
+    size_t    m_highWater     = 0;
+    uint64_t  m_overflowCount = 0;
+    size_t    m_overflowBytes = 0;
+};
+
+// ------------------------------------------------------------------
+// Inline hot path
+// ------------------------------------------------------------------
+
+inline void* LinearArena::Allocate(size_t size, size_t alignment) {
+    const uintptr_t base    = reinterpret_cast<uintptr_t>(m_base);
+    const uintptr_t current = base + m_offset;
+    const uintptr_t aligned = (current + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+    const size_t    end     = static_cast<size_t>(aligned - base) + size;
+
+    if (!m_base || end > m_capacity) {
+        m_overflowCount++;
+        m_overflowBytes += size;
+        return nullptr;
+    }
+
+    m_offset = end;
+    if (m_offset > m_highWater) {
+        m_highWater = m_offset;
+    }
+    return reinterpret_cast<void*>(aligned);
+}
+
+inline void LinearArena::Reset() {
+    m_offset = 0;
+}
+
+inline bool LinearArena::Owns(const void* p) const {
+    const uint8_t* b = static_cast<const uint8_t*>(p);
+    return m_base && b >= m_base && b < m_base + m_capacity;
+}
+
+} // namespace memory
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include "MemoryAccountant.h"
+#include "utils/Logger.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace dmme {
+namespace core {
+namespace memory {
+
+namespace {
+
+// Plain atomics: constant-initialized, so TrackedMemory members of
+// static objects can report before main and after it returns.
+std::array<std::atomic<uint64_t>, kMemoryCategoryCount> g_current{};
+std::array<std::atomic<uint64_t>, kMemoryCategoryCount> g_peak{};
+std::array<std::atomic<uint64_t>, kMemoryCategoryCount> g_budget{};
+std::array<std::atomic<bool>,     kMemoryCategoryCount> g_overBudget{};   // warned, still over
+
+struct TrimHandlerEntry {
+    MemoryAccountant::TrimHandlerId id = 0;
+    MemoryCategory    category = MemoryCategory::Cache;
+    MemoryTrimHandler handler;
+};
+
+struct TrimRegistry {
+    std::mutex                    mutex;
+    std::vector<TrimHandlerEntry> handlers;
+    MemoryAccountant::TrimHandlerId nextId = 1;
+};
+
+TrimRegistry& Registry() {
+    static TrimRegistry registry;
+    return registry;
+}
+
+constexpr double kMiB = 1024.0 * 1024.0;
+
+} // anonymous namespace
+
+// ===================================================================
+// Counting
+// ===================================================================
+
+void MemoryAccountant::Add(MemoryCategory category, uint64_t bytes) noexcept {
+    const size_t i = static_cast<size_t>(category);
+    const uint64_t now = g_current[i].fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+    uint64_t peak = g_peak[i].load(std::memory_order_relaxed);
+    while (now > peak &&
+           !g_peak[i].compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+    }
+}
+
+void MemoryAccountant::Release(MemoryCategory category, uint64_t bytes) noexcept {
+    g_current[static_cast<size_t>(category)].fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+// ===================================================================
+// Queries
+// ===================================================================
+
+MemoryCategoryUsage MemoryAccountant::GetUsage(MemoryCategory category) noexcept {
+    const size_t i = static_cast<size_t>(category);
+    MemoryCategoryUsage usage;
+    usage.currentBytes = g_current[i].load(std::memory_order_relaxed);
+    usage.peakBytes    = g_peak[i].load(std::memory_order_relaxed);
+    usage.budgetBytes  = g_budget[i].load(std::memory_order_relaxed);
+    return usage;
+}
+
+MemoryReport MemoryAccountant::GetReport() noexcept {
+    MemoryReport report;
+    for (size_t i = 0; i < kMemoryCategoryCount; ++i) {
+        const MemoryCategory category = static_cast<MemoryCategory>(i);
+        report.categories[i] = GetUsage(category);
+        if (MemoryCategoryDomain(category) == MemoryDomain::Gpu) {
+            report.gpuBytes += report.categories[i].currentBytes;
+        } else {
+            report.cpuBytes += report.categories[i].currentBytes;
+        }
+    }
+    return report;
+}
+
+uint64_t MemoryAccountant::GetDomainBytes(MemoryDomain domain) noexcept {
+    uint64_t total = 0;
+    for (size_t i = 0; i < kMemoryCategoryCount; ++i) {
+        if (MemoryCategoryDomain(static_cast<MemoryCategory>(i)) == domain) {
+            total += g_current[i].load(std::memory_order_relaxed);
+        }
+    }
+    return total;
+}
+
+// ===================================================================
+// Budgets
+// ===================================================================
+
+void MemoryAccountant::SetBudget(MemoryCategory category, uint64_t bytes) noexcept {
+    g_budget[static_cast<size_t>(category)].store(bytes, std::memory_order_relaxed);
+    if (bytes > 0) {
+        DMME_LOG_INFO("Memory budget for '{}': {:.1f} MB",
+                      MemoryCategoryName(category), static_cast<double>(bytes) / kMiB);
+    }
+}
+
+MemoryAccountant::TrimHandlerId MemoryAccountant::RegisterTrimHandler(
+    MemoryCategory category, MemoryTrimHandler handler) {
+    if (!handler) {
+        return 0;
+    }
+
+    TrimRegistry& registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    TrimHandlerEntry entry;
+    entry.id       = registry.nextId++;
+    entry.category = category;
+    entry.handler  = std::move(handler);
+    registry.handlers.push_back(std::move(entry));
+    return registry.handlers.back().id;
+}
+
+void MemoryAccountant::UnregisterTrimHandler(TrimHandlerId id) {
+    if (id == 0) {
+        return;
+    }
+
+    TrimRegistry& registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    auto& handlers = registry.handlers;
+    for (auto it = handlers.begin(); it != handlers.end(); ++it) {
+        if (it->id == id) {
+            handlers.erase(it);
+            return;
+        }
+    }
+}
+
+size_t MemoryAccountant::EnforceBudgets() {
+    // Fast path: nothing over budget, no lock taken
+    bool anyOver = false;
+    for (size_t i = 0; i < kMemoryCategoryCount; ++i) {
+        const uint64_t budget = g_budget[i].load(std::memory_order_relaxed);
+        if (budget > 0 && g_current[i].load(std::memory_order_relaxed) > budget) {
+            anyOver = true;
+            break;
+        }
+    }
+    if (!anyOver) {
+        for (auto& flag : g_overBudget) {
+            flag.store(false, std::memory_order_relaxed);
+        }
+        return 0;
+    }
+
+    TrimRegistry& registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    size_t released = 0;
+    for (size_t i = 0; i < kMemoryCategoryCount; ++i) {
+        const MemoryCategory category = static_cast<MemoryCategory>(i);
+        const uint64_t budget = g_budget[i].load(std::memory_order_relaxed);
+
+        uint64_t current = g_current[i].load(std::memory_order_relaxed);
+        if (budget == 0 || current <= budget) {
+            g_overBudget[i].store(false, std::memory_order_relaxed);
+            continue;
+        }
+
+        for (auto& entry : registry.handlers) {
+            if (entry.category != category) {
+                continue;
+            }
+            released += entry.handler(static_cast<size_t>(current - budget));
+            current = g_current[i].load(std::memory_order_relaxed);
+            if (current <= budget) {
+                break;
+            }
+        }
+
+        // Warn once per excursion, not every frame
+        const bool stillOver = current > budget;
+        if (stillOver && !g_overBudget[i].load(std::memory_order_relaxed)) {
+            DMME_LOG_WARN("Memory category '{}' over budget: {:.1f} MB of {:.1f} MB",
+                          MemoryCategoryName(category),
+                          static_cast<double>(current) / kMiB,
+                          static_cast<double>(budget) / kMiB);
+        }
+        g_overBudget[i].store(stillOver, std::memory_order_relaxed);
+    }
+    return released;
+}
+
+} // namespace memory
+} // namespace core
+} // namespace dmme
\ No newline at end of file
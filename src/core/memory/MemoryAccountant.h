@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <functional>
+
+namespace dmme {
+namespace core {
+namespace memory {
+
+// ------------------------------------------------------------------
+// Long-lived memory categories
+// ------------------------------------------------------------------
+
+enum class MemoryDomain : uint8_t {
+    Cpu = 0,
+    Gpu = 1
+};
+
+enum class MemoryCategory : uint8_t {
+    RenderTarget   = 0,   // GPU colour targets (x MSAA samples)
+    DepthStencil   = 1,   // GPU depth/stencil buffers
+    Staging        = 2,   // GPU -> CPU staging textures
+    Readback       = 3,   // CPU copies of rendered frames
+    WindowSurface  = 4,   // DIB sections behind the layered window
+    DriverInternal = 5,   // driver-owned CPU buffers (software targets)
+    FrameArena     = 6,   // per-frame arena blocks
+    Cache          = 7,   // trimmable caches
+    Texture        = 8,   // GPU sampled textures (atlas pages, content)
+    Asset          = 9,   // loaded asset tables (model arenas)
+    Count          = 10
+};
+
+constexpr size_t kMemoryCategoryCount = static_cast<size_t>(MemoryCategory::Count);
+
+inline const char* MemoryCategoryName(MemoryCategory category) {
+    switch (category) {
+        case MemoryCategory::RenderTarget:   return "renderTarget";
+        case MemoryCategory::DepthStencil:   return "depthStencil";
+        case MemoryCategory::Staging:        return "staging";
+        case MemoryCategory::Readback:       return "readback";
+        case MemoryCategory::WindowSurface:  return "windowSurface";
+        case MemoryCategory::DriverInternal: return "driverInternal";
+        case MemoryCategory::FrameArena:     return "frameArena";
+        case MemoryCategory::Cache:          return "cache";
+        case MemoryCategory::Texture:        return "texture";
+        case MemoryCategory::Asset:          return "asset";
+        default:                             return "unknown";
+    }
+}
+
+inline MemoryDomain MemoryCategoryDomain(MemoryCategory category) {
+    switch (category) {
+        case MemoryCategory::RenderTarget:
+        case MemoryCategory::DepthStencil:
+        case MemoryCategory::Staging:
+        case MemoryCategory::Texture:
+            return MemoryDomain::Gpu;
+        default:
+            return MemoryDomain::Cpu;
+    }
+}
+
+// ------------------------------------------------------------------
+// Usage snapshot (POD, safe to memcpy / publish)
+// ------------------------------------------------------------------
+
+struct MemoryCategoryUsage {
+    uint64_t currentBytes = 0;
+    uint64_t peakBytes    = 0;
+    uint64_t budgetBytes  = 0;     // 0 = no budget
+};
+
+struct MemoryReport {
+    std::array<MemoryCategoryUsage, kMemoryCategoryCount> categories{};
+    uint64_t cpuBytes = 0;         // sum of current CPU categories
+    uint64_t gpuBytes = 0;         // sum of current GPU categories
+};
+
+// Called when its category is over budget. bytesOver is how much
+// needs to go; returns the bytes actually released.
+using MemoryTrimHandler = std::function<size_t(size_t bytesOver)>;
+
+// MemoryAccountant keeps current and peak byte counts for the
+// engine's long-lived buffers, per category.
+//
+// This is separate from AllocationTracker: that counts heap
+// allocations per frame, this counts what stays resident (GPU
+// textures, DIB sections, readback buffers, caches) regardless of
+// where it was allocated. Subsystems report their buffers through a
+// TrackedMemory member, so the numbers follow object lifetime:
+//
+//   memory::TrackedMemory m_readbackMemory{MemoryCategory::Readback};
+//   ...
+//   m_readbackMemory.Set(width * height * 4);   // on (re)allocate
+//   m_readbackMemory.Reset();                   // on release
+//
+// Counting is lock-free and may happen on any thread.
+//
+// Budgets are optional, per category. EnforceBudgets() (called once
+// per frame by the main loop) runs the category's trim handlers when
+// it is over budget. Handlers run on the calling thread under the
+// handler lock; they must not register or unregister handlers.
+
+class MemoryAccountant {
+public:
+    using TrimHandlerId = uint32_t;
+
+    // --- Counting ---
+    static void Add(MemoryCategory category, uint64_t bytes) noexcept;
+    static void Release(MemoryCategory category, uint64_t bytes) noexcept;
+
+    // --- Queries ---
+    static MemoryCategoryUsage GetUsage(MemoryCategory category) noexcept;
+    static MemoryReport        GetReport() noexcept;
+    static uint64_t            GetDomainBytes(MemoryDomain domain) noexcept;
+
+    // --- Budgets ---
+    static void SetBudget(MemoryCategory category, uint64_t bytes) noexcept;   // 0 clears
+    static TrimHandlerId RegisterTrimHandler(MemoryCategory category, MemoryTrimHandler handler);
+    static void UnregisterTrimHandler(TrimHandlerId id);
+
+    // Trim every category that is over budget. Returns bytes released.
+    static size_t EnforceBudgets();
+};
+
+// ------------------------------------------------------------------
+// RAII registration of one buffer's size
+// ------------------------------------------------------------------
+
+class TrackedMemory {
+public:
+    explicit TrackedMemory(MemoryCategory category) noexcept
+        : m_category(category) {}
+
+    ~TrackedMemory() {
+        Reset();
+    }
+
+    TrackedMemory(const TrackedMemory&) = delete;
+    TrackedMemory& operator=(const TrackedMemory&) = delete;
+
+    // Report the buffer's current size (adjusts by the difference)
+    void Set(uint64_t bytes) noexcept {
+        if (bytes > m_bytes) {
+            MemoryAccountant::Add(m_category, bytes - m_bytes);
+        } else if (bytes < m_bytes) {
+            MemoryAccountant::Release(m_category, m_bytes - bytes);
+        }
+        m_bytes = bytes;
+    }
+
+    void Reset() noexcept { Set(0); }
+
+    uint64_t       GetBytes() const    { return m_bytes; }
+    MemoryCategory GetCategory() const { return m_category; }
+
+private:
+    MemoryCategory m_category;
+    uint64_t       m_bytes = 0;
+};
+
+} // namespace memory
+} // namespace core
+} // namespace dmme
\ No newline at end of file
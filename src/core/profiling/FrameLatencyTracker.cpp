@@ -0,0 +1,138 @@
+#include "FrameLatencyTracker.h"
+#include "utils/Logger.h"
+
+namespace dmme {
+namespace core {
+namespace profiling {
+
+// ===================================================================
+// Construction
+// ===================================================================
+
+FrameLatencyTracker::FrameLatencyTracker() {
+    DMME_LOG_DEBUG("FrameLatencyTracker created ({} frames in flight)",
+                   kMaxFramesInFlight);
+}
+
+// ===================================================================
+// Input
+// ===================================================================
+
+uint64_t FrameLatencyTracker::RecordInput(uint64_t timestampUs) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Keep the oldest pending input: latency is measured from the
+    // first event the user produced, not the last one coalesced.
+    if (!m_hasPendingInput || timestampUs < m_pendingOldestUs) {
+        m_pendingOldestUs = timestampUs;
+    }
+    m_hasPendingInput = true;
+
+    return m_nextInputId++;
+}
+
+// ===================================================================
+// Frame Lifecycle
+// ===================================================================
+
+uint64_t FrameLatencyTracker::BeginFrame(uint64_t timestampUs) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const uint64_t frameId = m_nextFrameId++;
+    FrameSlot& slot = m_slots[frameId % kMaxFramesInFlight];
+
+    if (slot.frameId != 0) {
+        // Slot still occupied: that frame never reached Present
+        m_droppedFrames++;
+    }
+
+    slot = {};
+    slot.frameId = frameId;
+
+    if (m_hasPendingInput) {
+        slot.hasInput      = true;
+        slot.oldestInputUs = m_pendingOldestUs;
+        m_hasPendingInput  = false;
+        m_framesWithInput++;
+
+        // Input -> frame start is the queueing delay before any work
+        uint64_t waitUs = timestampUs > slot.oldestInputUs
+            ? timestampUs - slot.oldestInputUs : 0;
+        m_histograms[static_cast<size_t>(FrameStage::Input)].Record(waitUs);
+    }
+
+    return frameId;
+}
+
+void FrameLatencyTracker::MarkStage(uint64_t frameId, FrameStage stage,
+                                    uint64_t timestampUs) {
+    if (stage == FrameStage::Input || stage >= FrameStage::Count) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    FrameSlot* slot = FindSlot(frameId);
+    if (!slot) {
+        return;  // already retired or evicted
+    }
+
+    const uint8_t bit = static_cast<uint8_t>(1u << static_cast<uint8_t>(stage));
+    if ((slot->stagesMarked & bit) == 0) {
+        slot->stagesMarked |= bit;
+
+        if (slot->hasInput) {
+            uint64_t latencyUs = timestampUs > slot->oldestInputUs
+                ? timestampUs - slot->oldestInputUs : 0;
+            m_histograms[static_cast<size_t>(stage)].Record(latencyUs);
+        }
+    }
+
+    if (stage == FrameStage::Present) {
+        *slot = {};
+    }
+}
+
+// ===================================================================
+// Reporting
+// ===================================================================
+
+LatencyReport FrameLatencyTracker::GetReport() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    LatencyReport report;
+    for (size_t i = 0; i < kFrameStageCount; ++i) {
+        report.stages[i] = m_histograms[i].Summarize();
+    }
+    report.framesWithInput = m_framesWithInput;
+    report.droppedFrames   = m_droppedFrames;
+    return report;
+}
+
+void FrameLatencyTracker::ResetHistograms() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& h : m_histograms) {
+        h.Reset();
+    }
+    m_framesWithInput = 0;
+    m_droppedFrames   = 0;
+}
+
+uint64_t FrameLatencyTracker::GetCurrentFrameId() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_nextFrameId - 1;
+}
+
+// ===================================================================
+// Internal
+// ===================================================================
+
+FrameLatencyTracker::FrameSlot* FrameLatencyTracker::FindSlot(uint64_t frameId) {
+    if (frameId == 0) return nullptr;
+    FrameSlot& slot = m_slots[frameId % kMaxFramesInFlight];
+    return (slot.frameId == frameId) ? &slot : nullptr;
+}
+
+} // namespace profiling
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "ProfilingTypes.h"
+#include "LatencyHistogram.h"
+
+#include <cstdint>
+#include <array>
+#include <mutex>
+
+namespace dmme {
+namespace core {
+namespace profiling {
+
+// FrameLatencyTracker links input events to the frame that finally
+// shows their effect on screen ("input-to-photon" latency).
+//
+// Every input is stamped with a monotonic timestamp when it arrives.
+// When a frame begins, it claims all inputs received since the
+// previous frame began and remembers the OLDEST one. As the frame
+// moves through the pipeline, each stage is stamped with the frame
+// ID; the tracker records (stage time - oldest input time) into that
+// stage's histogram. Present retires the frame.
+//
+// Frames are kept in a small ring so several frames can be in flight
+// at once (e.g. a delayed readback ring that returns frame N while
+// frame N+2 is rendering). A frame that is evicted from the ring
+// before Present is counted as dropped.
+//
+// Frames that consumed no input are not measured -- their latency is
+// undefined.
+//
+// Thread safety: all methods lock an internal mutex. Inputs may be
+// recorded from any thread (window proc, synthetic injector).
+//
+// Usage:
+//   tracker.RecordInput(evt.timestampUs);          // on each input
+//   uint64_t id = tracker.BeginFrame(MonotonicMicros());
+//   ...update...      tracker.MarkStage(id, FrameStage::Update, t);
+//   ...EndFrame...    tracker.MarkStage(id, FrameStage::Render, t);
+//   ...readback...    tracker.MarkStage(pixels->frameId, FrameStage::Readback, t);
+//   ...UpdateFrame... tracker.MarkStage(id, FrameStage::Convert, t);
+//                     tracker.MarkStage(id, FrameStage::Present, t);
+//   auto report = tracker.GetReport();
+
+class FrameLatencyTracker {
+public:
+    // Number of frames that may be in flight simultaneously.
+    static constexpr size_t kMaxFramesInFlight = 8;
+
+    FrameLatencyTracker();
+    ~FrameLatencyTracker() = default;
+
+    FrameLatencyTracker(const FrameLatencyTracker&) = delete;
+    FrameLatencyTracker& operator=(const FrameLatencyTracker&) = delete;
+
+    // --- Input ---
+
+    // Record an input event that happened at timestampUs
+    // (utils::MonotonicMicros() clock). Returns a sequential input ID.
+    uint64_t RecordInput(uint64_t timestampUs);
+
+    // --- Frame Lifecycle ---
+
+    // Start a new frame. Claims all inputs recorded since the previous
+    // BeginFrame. Returns the frame ID to carry through the pipeline.
+    uint64_t BeginFrame(uint64_t timestampUs);
+
+    // Stamp the end of a pipeline stage for frameId.
+    // Stamping Present retires the frame. Unknown IDs are ignored.
+    void MarkStage(uint64_t frameId, FrameStage stage, uint64_t timestampUs);
+
+    // --- Reporting ---
+
+    LatencyReport GetReport() const;
+
+    // Clear all histograms (e.g. after logging a report window).
+    void ResetHistograms();
+
+    // Frame ID of the most recent BeginFrame (0 before the first frame).
+    uint64_t GetCurrentFrameId() const;
+
+private:
+    struct FrameSlot {
+        uint64_t frameId        = 0;     // 0 = free
+        uint64_t oldestInputUs  = 0;
+        bool     hasInput       = false;
+        uint8_t  stagesMarked   = 0;     // bitmask of FrameStage
+    };
+
+    FrameSlot* FindSlot(uint64_t frameId);
+
+    std::array<FrameSlot, kMaxFramesInFlight>         m_slots{};
+    std::array<LatencyHistogram, kFrameStageCount>    m_histograms;
+
+    uint64_t m_nextFrameId      = 1;
+    uint64_t m_nextInputId      = 1;
+    uint64_t m_pendingOldestUs  = 0;
+    bool     m_hasPendingInput  = false;
+
+    uint64_t m_framesWithInput  = 0;
+    uint64_t m_droppedFrames    = 0;
+
+    mutable std::mutex m_mutex;
+};
+
+} // namespace profiling
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace dmme {
+namespace core {
+namespace profiling {
+
+// ===================================================================
+// Construction
+// ===================================================================
+
+LatencyHistogram::LatencyHistogram() {
+    Reset();
+}
+
+// ===================================================================
+// Recording
+// ===================================================================
+
+void LatencyHistogram::Record(uint64_t micros) {
+    size_t bucket = static_cast<size_t>(micros / kBucketWidthUs);
+    if (bucket > kBucketCount) {
+        bucket = kBucketCount;  // overflow bucket
+    }
+
+    m_buckets[bucket]++;
+    m_count++;
+    m_sumUs += micros;
+    m_maxUs  = std::max(m_maxUs, micros);
+}
+
+void LatencyHistogram::Reset() {
+    m_buckets.fill(0);
+    m_count = 0;
+    m_sumUs = 0;
+    m_maxUs = 0;
+}
+
+// ===================================================================
+// Queries
+// ===================================================================
+
+uint64_t LatencyHistogram::Count() const {
+    return m_count;
+}
+
+float LatencyHistogram::MeanMs() const {
+    if (m_count == 0) return 0.0f;
+    return static_cast<float>(m_sumUs) / static_cast<float>(m_count) / 1000.0f;
+}
+
+float LatencyHistogram::MaxMs() const {
+    return static_cast<float>(m_maxUs) / 1000.0f;
+}
+
+float LatencyHistogram::PercentileMs(float percentile) const {
+    if (m_count == 0) return 0.0f;
+
+    percentile = std::clamp(percentile, 0.0f, 1.0f);
+    uint64_t rank = static_cast<uint64_t>(
+        std::ceil(percentile * static_cast<float>(m_count)));
+    if (rank == 0) rank = 1;
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i <= kBucketCount; ++i) {
+        seen += m_buckets[i];
+        if (seen >= rank) {
+            if (i == kBucketCount) {
+                // Overflow bucket: best we can say is the observed max
+                return MaxMs();
+            }
+            uint64_t upperUs = (i + 1) * kBucketWidthUs;
+            return static_cast<float>(std::min(upperUs, m_maxUs)) / 1000.0f;
+        }
+    }
+
+    return MaxMs();
+}
+
+StageLatency LatencyHistogram::Summarize() const {
+    StageLatency s;
+    s.samples = m_count;
+    s.meanMs  = MeanMs();
+    s.p50Ms   = PercentileMs(0.50f);
+    s.p95Ms   = PercentileMs(0.95f);
+    s.p99Ms   = PercentileMs(0.99f);
+    s.maxMs   = MaxMs();
+    return s;
+}
+
+} // namespace profiling
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "ProfilingTypes.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace dmme {
+namespace core {
+namespace profiling {
+
+// LatencyHistogram is a fixed-size, allocation-free histogram of
+// microsecond latencies. Buckets are linear (100 us wide) up to
+// 100 ms, plus one overflow bucket. Percentiles are resolved to the
+// upper edge of the bucket they fall in, so they are accurate to
+// 0.1 ms -- well below the frame period we care about.
+//
+// Not thread-safe. The owner (FrameLatencyTracker) serializes access.
+
+class LatencyHistogram {
+public:
+    static constexpr uint64_t kBucketWidthUs = 100;
+    static constexpr size_t   kBucketCount   = 1000;  // 0 .. 100 ms
+
+    LatencyHistogram();
+
+    void Record(uint64_t micros);
+    void Reset();
+
+    uint64_t Count() const;
+    float    MeanMs() const;
+    float    MaxMs() const;
+
+    // percentile: 0.0 .. 1.0 (e.g. 0.95 for p95)
+    float    PercentileMs(float percentile) const;
+
+    // Summarize into a StageLatency record.
+    StageLatency Summarize() const;
+
+private:
+    std::array<uint32_t, kBucketCount + 1> m_buckets{};  // last = overflow
+    uint64_t m_count   = 0;
+    uint64_t m_sumUs   = 0;
+    uint64_t m_maxUs   = 0;
+};
+
+} // namespace profiling
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,544 @@
+#include "MetricsEndpoint.h"
+#include "utils/Clock.h"
+#include "utils/Logger.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace dmme {
+namespace core {
+namespace profiling {
+
+namespace {
+
+// Longest request line accepted before the client is dropped
+constexpr size_t kMaxRequestBytes = 256;
+
+// Poll interval for the endpoint thread to notice Stop() (Unix)
+constexpr int kPollTimeoutMs = 100;
+
+void AppendFormat(std::string& out, const char* fmt, ...) {
+    char buf[256];
+    va_list args;
+    va_start(args, fmt);
+    const int n = std::vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    if (n > 0) {
+        out.append(buf, std::min(static_cast<size_t>(n), sizeof(buf) - 1));
+    }
+}
+
+void AppendJsonString(std::string& out, const char* text) {
+    out += '"';
+    for (const char* p = text; *p; ++p) {
+        const unsigned char c = static_cast<unsigned char>(*p);
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += static_cast<char>(c);
+        } else if (c < 0x20) {
+            AppendFormat(out, "\\u%04x", c);
+        } else {
+            out += static_cast<char>(c);
+        }
+    }
+    out += '"';
+}
+
+// Returns the next complete request line (without "\r\n") from
+// pending, or false if no full line is buffered yet.
+bool PopRequestLine(std::string& pending, std::string& line) {
+    const size_t pos = pending.find('\n');
+    if (pos == std::string::npos) {
+        return false;
+    }
+    line.assign(pending, 0, pos);
+    pending.erase(0, pos + 1);
+    while (!line.empty() && (line.back() == '\r' || line.back() == ' ')) {
+        line.pop_back();
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+// ===================================================================
+// Construction
+// ===================================================================
+
+MetricsEndpoint::MetricsEndpoint(const MetricsEndpointConfig& config)
+    : m_config(config) {
+}
+
+MetricsEndpoint::~MetricsEndpoint() {
+    Stop();
+}
+
+bool MetricsEndpoint::IsRunning() const {
+    return m_running.load(std::memory_order_acquire);
+}
+
+const std::string& MetricsEndpoint::GetAddress() const {
+    return m_address;
+}
+
+// ===================================================================
+// Snapshots
+// ===================================================================
+
+void MetricsEndpoint::Publish(const MetricsSnapshot& snapshot) {
+    MetricsSnapshot copy = snapshot;
+    copy.publishCount = ++m_publishCount;
+    if (copy.timestampUs == 0) {
+        copy.timestampUs = utils::MonotonicMicros();
+    }
+    m_snapshot.Store(copy);
+}
+
+bool MetricsEndpoint::GetLatest(MetricsSnapshot& out) const {
+    return m_snapshot.Load(out);
+}
+
+uint64_t MetricsEndpoint::GetRequestCount() const {
+    return m_requestCount.load(std::memory_order_relaxed);
+}
+
+// ===================================================================
+// Request Handling
+// ===================================================================
+
+std::string MetricsEndpoint::HandleRequest(const std::string& request) const {
+    if (request.empty()) {
+        return {};
+    }
+
+    m_requestCount.fetch_add(1, std::memory_order_relaxed);
+
+    const bool wantsJson   = (request == "json");
+    const bool wantsBinary = (request == "binary" || request == "bin");
+    if (!wantsJson && !wantsBinary) {
+        return "{\"error\":\"unknown request\"}\n";
+    }
+
+    MetricsSnapshot snapshot;
+    if (!GetLatest(snapshot)) {
+        return "{\"error\":\"snapshot busy\"}\n";
+    }
+
+    if (wantsJson) {
+        return FormatJson(snapshot) + "\n";
+    }
+
+    MetricsBinaryHeader header;
+    std::string reply(sizeof(header) + sizeof(snapshot), '\0');
+    std::memcpy(&reply[0], &header, sizeof(header));
+    std::memcpy(&reply[sizeof(header)], &snapshot, sizeof(snapshot));
+    return reply;
+}
+
+std::string MetricsEndpoint::FormatJson(const MetricsSnapshot& s) {
+    std::string out;
+    out.reserve(2560);
+
+    AppendFormat(out, "{\"publishCount\":%llu,\"timestampUs\":%llu,",
+                 static_cast<unsigned long long>(s.publishCount),
+                 static_cast<unsigned long long>(s.timestampUs));
+
+    AppendFormat(out, "\"frame\":{\"number\":%llu,\"frameTimeMs\":%.3f,\"gpuTimeMs\":%.3f,"
+                      "\"drawCalls\":%d,\"triangles\":%d,\"vramUsedBytes\":%llu},",
+                 static_cast<unsigned long long>(s.frameNumber),
+                 s.frameTimeMs, s.gpuTimeMs, s.drawCalls, s.trianglesRendered,
+                 static_cast<unsigned long long>(s.vramUsedBytes));
+
+    AppendFormat(out, "\"present\":{\"count\":%llu,\"width\":%d,\"height\":%d,"
+                      "\"renderScale\":%.2f,\"targetFps\":%.1f},",
+                 static_cast<unsigned long long>(s.presentCount),
+                 s.surfaceWidth, s.surfaceHeight, s.renderScale, s.targetFps);
+
+    AppendFormat(out, "\"memory\":{\"readbackBytes\":%llu,\"backBufferBytes\":%llu,"
+                      "\"cpuBytes\":%llu,\"gpuBytes\":%llu,\"categories\":{",
+                 static_cast<unsigned long long>(s.readbackBytes),
+                 static_cast<unsigned long long>(s.backBufferBytes),
+                 static_cast<unsigned long long>(s.memory.cpuBytes),
+                 static_cast<unsigned long long>(s.memory.gpuBytes));
+    for (size_t i = 0; i < memory::kMemoryCategoryCount; ++i) {
+        const memory::MemoryCategoryUsage& mu = s.memory.categories[i];
+        AppendFormat(out, "%s\"%s\":{\"currentBytes\":%llu,\"peakBytes\":%llu,\"budgetBytes\":%llu}",
+                     i ? "," : "", memory::MemoryCategoryName(static_cast<memory::MemoryCategory>(i)),
+                     static_cast<unsigned long long>(mu.currentBytes),
+                     static_cast<unsigned long long>(mu.peakBytes),
+                     static_cast<unsigned long long>(mu.budgetBytes));
+    }
+    out += "}},";
+
+    AppendFormat(out, "\"upload\":{\"frameBytes\":%llu,\"budgetBytes\":%llu,\"pendingBytes\":%llu},",
+                 static_cast<unsigned long long>(s.uploadBytes),
+                 static_cast<unsigned long long>(s.uploadBudgetBytes),
+                 static_cast<unsigned long long>(s.uploadPendingBytes));
+
+    AppendFormat(out, "\"latency\":{\"framesWithInput\":%llu,\"droppedFrames\":%llu,\"stages\":{",
+                 static_cast<unsigned long long>(s.latency.framesWithInput),
+                 static_cast<unsigned long long>(s.latency.droppedFrames));
+    for (size_t i = 0; i < kFrameStageCount; ++i) {
+        const StageLatency& sl = s.latency.stages[i];
+        AppendFormat(out, "%s\"%s\":{\"samples\":%llu,\"meanMs\":%.3f,\"p50Ms\":%.3f,"
+                          "\"p95Ms\":%.3f,\"p99Ms\":%.3f,\"maxMs\":%.3f}",
+                     i ? "," : "", FrameStageName(static_cast<FrameStage>(i)),
+                     static_cast<unsigned long long>(sl.samples),
+                     sl.meanMs, sl.p50Ms, sl.p95Ms, sl.p99Ms, sl.maxMs);
+    }
+    out += "}},";
+
+    // Identity strings may be unterminated if a caller filled them badly
+    char driver[sizeof(s.driverName) + 1]   = {};
+    char adapter[sizeof(s.adapterName) + 1] = {};
+    std::memcpy(driver, s.driverName, sizeof(s.driverName));
+    std::memcpy(adapter, s.adapterName, sizeof(s.adapterName));
+
+    out += "\"driver\":";
+    AppendJsonString(out, driver);
+    out += ",\"adapter\":";
+    AppendJsonString(out, adapter);
+    out += '}';
+    return out;
+}
+
+bool MetricsEndpoint::DrainRequests(std::string& pending, std::string& replies) const {
+    std::string line;
+    while (PopRequestLine(pending, line)) {
+        replies += HandleRequest(line);
+    }
+    return pending.size() <= kMaxRequestBytes;
+}
+
+// ===================================================================
+// Win32 Named Pipe
+// ===================================================================
+
+#if defined(_WIN32)
+
+namespace {
+
+// Wait for an overlapped pipe operation or the stop event.
+// Returns false if stopped or the operation failed.
+bool WaitOverlapped(HANDLE pipe, OVERLAPPED& ov, HANDLE stopEvent, DWORD& bytes) {
+    HANDLE handles[2] = {ov.hEvent, stopEvent};
+    const DWORD r = WaitForMultipleObjects(2, handles, FALSE, INFINITE);
+    if (r != WAIT_OBJECT_0) {
+        CancelIoEx(pipe, &ov);
+        GetOverlappedResult(pipe, &ov, &bytes, TRUE);
+        return false;
+    }
+    return GetOverlappedResult(pipe, &ov, &bytes, FALSE) != FALSE;
+}
+
+bool WriteAll(HANDLE pipe, OVERLAPPED& ov, HANDLE stopEvent, const std::string& data) {
+    size_t offset = 0;
+    while (offset < data.size()) {
+        ResetEvent(ov.hEvent);
+        DWORD written = 0;
+        const DWORD chunk = static_cast<DWORD>(data.size() - offset);
+        if (!WriteFile(pipe, data.data() + offset, chunk, nullptr, &ov) &&
+            GetLastError() != ERROR_IO_PENDING) {
+            return false;
+        }
+        if (!WaitOverlapped(pipe, ov, stopEvent, written) || written == 0) {
+            return false;
+        }
+        offset += written;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+bool MetricsEndpoint::Start() {
+    if (IsRunning()) {
+        return true;
+    }
+
+    m_address = "\\\\.\\pipe\\" + m_config.name;
+
+    HANDLE stopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if (!stopEvent) {
+        DMME_LOG_ERROR("MetricsEndpoint: CreateEvent failed ({})", GetLastError());
+        return false;
+    }
+    m_listenHandle = reinterpret_cast<intptr_t>(stopEvent);
+
+    m_running.store(true, std::memory_order_release);
+    m_thread = std::thread(&MetricsEndpoint::ServeLoop, this);
+
+    DMME_LOG_INFO("Metrics endpoint listening on {}", m_address);
+    return true;
+}
+
+void MetricsEndpoint::Stop() {
+    if (!m_running.exchange(false)) {
+        return;
+    }
+
+    HANDLE stopEvent = reinterpret_cast<HANDLE>(m_listenHandle);
+    SetEvent(stopEvent);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    CloseHandle(stopEvent);
+    m_listenHandle = -1;
+
+    DMME_LOG_INFO("Metrics endpoint stopped ({} requests served)", GetRequestCount());
+}
+
+void MetricsEndpoint::ServeLoop() {
+    HANDLE stopEvent = reinterpret_cast<HANDLE>(m_listenHandle);
+    const std::wstring pipeName(m_address.begin(), m_address.end());
+
+    OVERLAPPED ov{};
+    ov.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if (!ov.hEvent) {
+        DMME_LOG_ERROR("MetricsEndpoint: CreateEvent failed ({})", GetLastError());
+        return;
+    }
+
+    std::string pending;
+    std::string replies;
+    char buffer[512];
+
+    while (IsRunning()) {
+        HANDLE pipe = CreateNamedPipeW(
+            pipeName.c_str(),
+            PIPE_ACCESS_DUPLEX | FILE_FLAG_OVERLAPPED,
+            PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+            1,          // one client at a time
+            4096, 4096, 0, nullptr);
+
+        if (pipe == INVALID_HANDLE_VALUE) {
+            DMME_LOG_ERROR("MetricsEndpoint: CreateNamedPipe failed ({})", GetLastError());
+            break;
+        }
+
+        // --- Wait for a client ---
+        ResetEvent(ov.hEvent);
+        DWORD bytes = 0;
+        bool connected = ConnectNamedPipe(pipe, &ov) != FALSE;
+        if (!connected) {
+            const DWORD err = GetLastError();
+            if (err == ERROR_PIPE_CONNECTED) {
+                connected = true;
+            } else if (err == ERROR_IO_PENDING) {
+                connected = WaitOverlapped(pipe, ov, stopEvent, bytes);
+            }
+        }
+
+        // --- Serve requests until the client disconnects ---
+        pending.clear();
+        while (connected && IsRunning()) {
+            ResetEvent(ov.hEvent);
+            if (!ReadFile(pipe, buffer, sizeof(buffer), nullptr, &ov) &&
+                GetLastError() != ERROR_IO_PENDING) {
+                break;
+            }
+            if (!WaitOverlapped(pipe, ov, stopEvent, bytes) || bytes == 0) {
+                break;
+            }
+
+            pending.append(buffer, bytes);
+            replies.clear();
+            const bool ok = DrainRequests(pending, replies);
+            if (!replies.empty() && !WriteAll(pipe, ov, stopEvent, replies)) {
+                break;
+            }
+            if (!ok) {
+                DMME_LOG_WARN("MetricsEndpoint: request too long, dropping client");
+                break;
+            }
+        }
+
+        DisconnectNamedPipe(pipe);
+        CloseHandle(pipe);
+    }
+
+    CloseHandle(ov.hEvent);
+}
+
+// ===================================================================
+// Unix Domain Socket
+// ===================================================================
+
+#else
+
+namespace {
+
+std::string ResolveSocketPath(const std::string& name) {
+    if (!name.empty() && name[0] == '/') {
+        return name;
+    }
+    const char* runtimeDir = std::getenv("XDG_RUNTIME_DIR");
+    const std::string dir = (runtimeDir && *runtimeDir) ? runtimeDir : "/tmp";
+    return dir + "/" + name + ".sock";
+}
+
+bool SendAll(int fd, const std::string& data) {
+    size_t offset = 0;
+    while (offset < data.size()) {
+        const ssize_t n = send(fd, data.data() + offset, data.size() - offset, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        offset += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Whether a process is listening on the socket at addr. A socket file
+// nobody answers on was left by a crashed process.
+bool IsSocketServed(const sockaddr_un& addr) {
+    const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return false;
+    }
+    const bool served = connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0;
+    close(fd);
+    return served;
+}
+
+} // anonymous namespace
+
+bool MetricsEndpoint::Start() {
+    if (IsRunning()) {
+        return true;
+    }
+
+    m_address = ResolveSocketPath(m_config.name);
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (m_address.size() >= sizeof(addr.sun_path)) {
+        DMME_LOG_ERROR("MetricsEndpoint: socket path too long: {}", m_address);
+        return false;
+    }
+    std::memcpy(addr.sun_path, m_address.c_str(), m_address.size() + 1);
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        DMME_LOG_ERROR("MetricsEndpoint: socket() failed: {}", std::strerror(errno));
+        return false;
+    }
+
+    // Another instance serving this path keeps it; only a stale socket
+    // left by a crashed process is removed
+    if (IsSocketServed(addr)) {
+        DMME_LOG_ERROR("MetricsEndpoint: {} is already served by another endpoint", m_address);
+        close(fd);
+        return false;
+    }
+    unlink(m_address.c_str());
+
+    // The socket file is created owner-only (0600) by bind itself, so
+    // it is never reachable with wider permissions. umask is process
+    // wide; Start runs during startup, before other threads create files.
+    const mode_t previousMask = umask(S_IRWXG | S_IRWXO | S_IXUSR);
+    const bool bound = bind(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0;
+    umask(previousMask);
+
+    if (!bound || listen(fd, 4) != 0) {
+        DMME_LOG_ERROR("MetricsEndpoint: cannot listen on {}: {}",
+                       m_address, std::strerror(errno));
+        close(fd);
+        if (bound) {
+            unlink(m_address.c_str());
+        }
+        return false;
+    }
+
+    m_listenHandle = fd;
+    m_running.store(true, std::memory_order_release);
+    m_thread = std::thread(&MetricsEndpoint::ServeLoop, this);
+
+    DMME_LOG_INFO("Metrics endpoint listening on {}", m_address);
+    return true;
+}
+
+void MetricsEndpoint::Stop() {
+    if (!m_running.exchange(false)) {
+        return;
+    }
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    close(static_cast<int>(m_listenHandle));
+    unlink(m_address.c_str());
+    m_listenHandle = -1;
+
+    DMME_LOG_INFO("Metrics endpoint stopped ({} requests served)", GetRequestCount());
+}
+
+void MetricsEndpoint::ServeLoop() {
+    const int listenFd = static_cast<int>(m_listenHandle);
+
+    std::string pending;
+    std::string replies;
+    char buffer[512];
+
+    while (IsRunning()) {
+        // --- Wait for a client ---
+        pollfd lp{listenFd, POLLIN, 0};
+        if (poll(&lp, 1, kPollTimeoutMs) <= 0) {
+            continue;
+        }
+
+        const int client = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0) {
+            continue;
+        }
+
+        // --- Serve requests until the client disconnects ---
+        pending.clear();
+        while (IsRunning()) {
+            pollfd cp{client, POLLIN, 0};
+            const int ready = poll(&cp, 1, kPollTimeoutMs);
+            if (ready == 0 || (ready < 0 && errno == EINTR)) {
+                continue;
+            }
+            if (ready < 0) {
+                break;
+            }
+
+            const ssize_t n = recv(client, buffer, sizeof(buffer), 0);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;
+
+            pending.append(buffer, static_cast<size_t>(n));
+            replies.clear();
+            const bool ok = DrainRequests(pending, replies);
+            if (!replies.empty() && !SendAll(client, replies)) {
+                break;
+            }
+            if (!ok) {
+                DMME_LOG_WARN("MetricsEndpoint: request too long, dropping client");
+                break;
+            }
+        }
+
+        close(client);
+    }
+}
+
+#endif
+
+} // namespace profiling
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "ProfilingTypes.h"
+#include "SeqLock.h"
+#include "core/memory/MemoryAccountant.h"
+
+#include <cstdint>
+#include <atomic>
+#include <string>
+#include <thread>
+
+namespace dmme {
+namespace core {
+namespace profiling {
+
+// ------------------------------------------------------------------
+// Telemetry snapshot
+// ------------------------------------------------------------------
+
+// Everything the endpoint serves, as one fixed-size POD so it can be
+// published through a SeqLock and sent verbatim in binary responses.
+// Append new fields at the end and bump kMetricsBinaryVersion.
+struct MetricsSnapshot {
+    uint64_t publishCount     = 0;     // filled in by Publish()
+    uint64_t timestampUs      = 0;     // MonotonicMicros at publish
+
+    // --- FrameStats ---
+    uint64_t frameNumber      = 0;
+    float    frameTimeMs      = 0.0f;
+    float    gpuTimeMs        = 0.0f;
+    int32_t  drawCalls        = 0;
+    int32_t  trianglesRendered = 0;
+    uint64_t vramUsedBytes    = 0;
+
+    // --- Presentation ---
+    uint64_t presentCount     = 0;
+    int32_t  surfaceWidth     = 0;
+    int32_t  surfaceHeight    = 0;
+    float    renderScale      = 1.0f;
+    float    targetFps        = 0.0f;
+
+    // --- Memory ---
+    uint64_t readbackBytes    = 0;
+    uint64_t backBufferBytes  = 0;
+
+    // --- Input-to-photon latency ---
+    LatencyReport latency;
+
+    // --- Identity (NUL-terminated) ---
+    char     driverName[48]   = {};
+    char     adapterName[128] = {};
+
+    // --- Tracked memory per category (v2; v3 adds "texture", v4 "asset") ---
+    memory::MemoryReport memory;
+
+    // --- Texture uploads (v3) ---
+    uint64_t uploadBytes        = 0;   // copied to the GPU last frame
+    uint64_t uploadBudgetBytes  = 0;   // per frame
+    uint64_t uploadPendingBytes = 0;
+};
+
+constexpr uint32_t kMetricsBinaryMagic   = 0x534D4D44;  // "DMMS"
+constexpr uint16_t kMetricsBinaryVersion = 4;
+
+// Header preceding a binary response; payload is a MetricsSnapshot
+// in the engine's native layout (same-architecture consumers only).
+struct MetricsBinaryHeader {
+    uint32_t magic       = kMetricsBinaryMagic;
+    uint16_t version     = kMetricsBinaryVersion;
+    uint16_t reserved    = 0;
+    uint32_t payloadSize = sizeof(MetricsSnapshot);
+    uint32_t reserved2   = 0;
+};
+
+struct MetricsEndpointConfig {
+    // Windows: \\.\pipe\<name>
+    // Other:   <name> if it is an absolute path, otherwise
+    //          $XDG_RUNTIME_DIR/<name>.sock (falls back to /tmp)
+    std::string name = "dmme-metrics";
+};
+
+// MetricsEndpoint exposes live telemetry to local tools (fleet agents,
+// dashboards) over a named pipe on Windows or a Unix domain socket
+// elsewhere. Only local clients can connect.
+//
+// The render thread calls Publish() once per frame; this is a
+// wait-free SeqLock store and never touches the endpoint thread. A
+// background thread accepts one client at a time and answers
+// newline-terminated requests until the client disconnects:
+//
+//   "json\n"    -> one line of compact JSON
+//   "binary\n"  -> MetricsBinaryHeader + MetricsSnapshot
+//
+// Usage:
+//   MetricsEndpoint metrics;
+//   metrics.Start();
+//   // per frame:
+//   metrics.Publish(snapshot);
+//   // shutdown:
+//   metrics.Stop();
+
+class MetricsEndpoint {
+public:
+    explicit MetricsEndpoint(const MetricsEndpointConfig& config = {});
+    ~MetricsEndpoint();
+
+    MetricsEndpoint(const MetricsEndpoint&) = delete;
+    MetricsEndpoint& operator=(const MetricsEndpoint&) = delete;
+
+    // --- Lifecycle ---
+    // Fails (and logs) if another endpoint already serves the address;
+    // a stale socket file left by a crashed process is replaced.
+    bool Start();
+    void Stop();
+    bool IsRunning() const;
+
+    // Platform path of the endpoint (valid after Start()).
+    const std::string& GetAddress() const;
+
+    // --- Render thread ---
+    void Publish(const MetricsSnapshot& snapshot);
+
+    // --- Any thread ---
+    bool GetLatest(MetricsSnapshot& out) const;
+    uint64_t GetRequestCount() const;
+
+    // Compact single-line JSON for a snapshot (no trailing newline).
+    static std::string FormatJson(const MetricsSnapshot& snapshot);
+
+private:
+    void ServeLoop();
+
+    // Answer one request line; returns the bytes to send back.
+    std::string HandleRequest(const std::string& request) const;
+
+    // Answer every complete line buffered in pending, appending the
+    // responses to replies. Returns false if pending grew too long.
+    bool DrainRequests(std::string& pending, std::string& replies) const;
+
+    MetricsEndpointConfig     m_config;
+    std::string               m_address;
+    SeqLock<MetricsSnapshot>  m_snapshot;
+    uint64_t                  m_publishCount = 0;   // render thread only
+
+    std::thread               m_thread;
+    std::atomic<bool>         m_running{false};
+    mutable std::atomic<uint64_t> m_requestCount{0};
+
+    // Platform listener: Unix socket fd, or Win32 stop event handle
+    intptr_t                  m_listenHandle = -1;
+};
+
+} // namespace profiling
+} // namespace core
+} // namespace dmme
\ No newline at end of file
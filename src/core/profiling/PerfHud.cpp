@@ -0,0 +1,216 @@
+#include "PerfHud.h"
+#include "HudFont.h"
+#include "utils/Logger.h"
+#include "utils/Simd.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace dmme {
+namespace core {
+namespace profiling {
+
+namespace {
+
+// Panel geometry (pixels)
+constexpr int kOriginX     = 4;
+constexpr int kOriginY     = 4;
+constexpr int kPadding     = 4;
+constexpr int kTextLines   = 6;
+constexpr int kTextColumns = 30;
+constexpr int kPanelWidth  = kPadding * 2 + kTextColumns * kHudGlyphAdvance;
+constexpr int kPanelHeight = kPadding * 3 + kTextLines * kHudLineHeight
+                           + PerfHud::kGraphHeight;
+
+constexpr float kGraphMaxMs    = 33.3f;   // top of the graph
+constexpr float kGraphTargetMs = 16.7f;   // reference line
+
+// Premultiplied BGRA packed as little-endian uint32 (A R G B)
+constexpr uint32_t kPanelColor  = 0xAA000000u;   // black, alpha 170
+constexpr uint8_t  kPanelAlpha  = 0xAA;
+constexpr uint32_t kTextColor   = 0xFFFFFFFFu;
+constexpr uint32_t kGoodColor   = 0xFF40E040u;
+constexpr uint32_t kWarnColor   = 0xFFE0C040u;
+constexpr uint32_t kBadColor    = 0xFFE04040u;
+constexpr uint32_t kTargetColor = 0xFF808080u;
+
+inline void StorePixel(uint8_t* p, uint32_t color) {
+    std::memcpy(p, &color, sizeof(color));
+}
+
+// dst = color + dst * (255 - alpha) / 255 over one row span
+// (premultiplied "over" with a constant source)
+void BlendSpan(uint8_t* dst, int count, uint32_t color, uint8_t alpha) {
+    const uint32_t inv = 255u - alpha;
+    int i = 0;
+
+#if defined(DMME_SIMD_SSE2)
+    const __m128i zero  = _mm_setzero_si128();
+    const __m128i invv  = _mm_set1_epi16(static_cast<short>(inv));
+    const __m128i src   = _mm_set1_epi32(static_cast<int>(color));
+
+    for (; i + 4 <= count; i += 4) {
+        uint8_t* p = dst + static_cast<size_t>(i) * 4;
+        __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i lo = _mm_unpacklo_epi8(px, zero);
+        __m128i hi = _mm_unpackhi_epi8(px, zero);
+        lo = utils::Div255RoundU16(_mm_mullo_epi16(lo, invv));
+        hi = utils::Div255RoundU16(_mm_mullo_epi16(hi, invv));
+        px = _mm_adds_epu8(_mm_packus_epi16(lo, hi), src);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), px);
+    }
+#endif
+
+    for (; i < count; ++i) {
+        uint8_t* p = dst + static_cast<size_t>(i) * 4;
+        for (int c = 0; c < 4; ++c) {
+            const uint32_t s = (color >> (c * 8)) & 0xFFu;
+            const uint32_t v = s + utils::Div255Round(p[c] * inv);
+            p[c] = static_cast<uint8_t>(std::min<uint32_t>(v, 255u));
+        }
+    }
+}
+
+void DrawText(uint8_t* bgra, int width, int x, int y, const char* text, uint32_t color) {
+    for (; *text; ++text, x += kHudGlyphAdvance) {
+        if (x + kHudGlyphWidth > width) {
+            break;
+        }
+        const uint8_t* glyph = HudGlyph(*text);
+        for (int row = 0; row < kHudGlyphHeight; ++row) {
+            const uint8_t bits = glyph[row];
+            if (!bits) continue;
+            uint8_t* dst = bgra + (static_cast<size_t>(y + row) * width + x) * 4;
+            for (int col = 0; col < kHudGlyphWidth; ++col) {
+                if (bits & (0x10 >> col)) {
+                    StorePixel(dst + col * 4, color);
+                }
+            }
+        }
+    }
+}
+
+int GraphBarHeight(float ms) {
+    const float t = std::min(std::max(ms / kGraphMaxMs, 0.0f), 1.0f);
+    return std::max(1, static_cast<int>(t * PerfHud::kGraphHeight + 0.5f));
+}
+
+} // anonymous namespace
+
+// ===================================================================
+// Construction
+// ===================================================================
+
+PerfHud::PerfHud() {
+    std::snprintf(m_driverName, sizeof(m_driverName), "-");
+}
+
+// ===================================================================
+// Toggle
+// ===================================================================
+
+void PerfHud::SetEnabled(bool enabled) {
+    if (m_enabled != enabled) {
+        DMME_LOG_INFO("Performance HUD {}", enabled ? "enabled" : "disabled");
+    }
+    m_enabled = enabled;
+}
+
+bool PerfHud::IsEnabled() const {
+    return m_enabled;
+}
+
+void PerfHud::Toggle() {
+    SetEnabled(!m_enabled);
+}
+
+// ===================================================================
+// Data
+// ===================================================================
+
+void PerfHud::SetDriverName(const std::string& name) {
+    std::snprintf(m_driverName, sizeof(m_driverName), "%s", name.c_str());
+}
+
+void PerfHud::PushFrame(const HudFrameData& data) {
+    m_latest = data;
+    m_frameTimes[m_head] = data.frameTimeMs;
+    m_head = (m_head + 1) % kGraphFrames;
+    m_count = std::min(m_count + 1, static_cast<size_t>(kGraphFrames));
+}
+
+// ===================================================================
+// Drawing
+// ===================================================================
+
+void PerfHud::Draw(uint8_t* bgra, int width, int height) const {
+    if (!m_enabled || !bgra ||
+        width < kOriginX + kPanelWidth || height < kOriginY + kPanelHeight) {
+        return;
+    }
+
+    // --- Panel ---
+    for (int y = 0; y < kPanelHeight; ++y) {
+        uint8_t* row = bgra + (static_cast<size_t>(kOriginY + y) * width + kOriginX) * 4;
+        BlendSpan(row, kPanelWidth, kPanelColor, kPanelAlpha);
+    }
+
+    // --- Text ---
+    const HudFrameData& d = m_latest;
+    const float fps = d.frameTimeMs > 0.0f ? 1000.0f / d.frameTimeMs : 0.0f;
+    const auto stage = [&d](FrameStage s) {
+        return static_cast<double>(d.stageMs[static_cast<size_t>(s)]);
+    };
+
+    char lines[kTextLines][kTextColumns + 1];
+    std::snprintf(lines[0], sizeof(lines[0]), "FRAME %5.2f MS %5.1f FPS",
+                  d.frameTimeMs, fps);
+    std::snprintf(lines[1], sizeof(lines[1]), "CPU %5.2f GPU %5.2f MS",
+                  d.cpuTimeMs, d.gpuTimeMs);
+    std::snprintf(lines[2], sizeof(lines[2]), "UPD %4.2f RND %4.2f RB %4.2f",
+                  stage(FrameStage::Update), stage(FrameStage::Render),
+                  stage(FrameStage::Readback));
+    std::snprintf(lines[3], sizeof(lines[3]), "CNV %4.2f PRS %4.2f P/F %.1f",
+                  stage(FrameStage::Convert), stage(FrameStage::Present),
+                  d.presentsPerFrame);
+    std::snprintf(lines[4], sizeof(lines[4]), "%.*s", kTextColumns, m_driverName);
+    std::snprintf(lines[5], sizeof(lines[5]), "%dX%d C %.1f G %.1f MB",
+                  d.surfaceWidth, d.surfaceHeight,
+                  static_cast<double>(d.cpuMemoryBytes) / (1024.0 * 1024.0),
+                  static_cast<double>(d.gpuMemoryBytes) / (1024.0 * 1024.0));
+
+    const int textX = kOriginX + kPadding;
+    int textY = kOriginY + kPadding;
+    for (int i = 0; i < kTextLines; ++i, textY += kHudLineHeight) {
+        DrawText(bgra, width, textX, textY, lines[i], kTextColor);
+    }
+
+    // --- Frame time graph (oldest on the left) ---
+    const int graphX      = textX;
+    const int graphBottom = textY + kPadding + kGraphHeight - 1;
+
+    const int targetY = graphBottom - GraphBarHeight(kGraphTargetMs) + 1;
+    for (int x = 0; x < kGraphFrames; x += 2) {
+        StorePixel(bgra + (static_cast<size_t>(targetY) * width + graphX + x) * 4,
+                   kTargetColor);
+    }
+
+    const size_t first = (m_head + kGraphFrames - m_count) % kGraphFrames;
+    const int    startX = graphX + kGraphFrames - static_cast<int>(m_count);
+    for (size_t i = 0; i < m_count; ++i) {
+        const float ms = m_frameTimes[(first + i) % kGraphFrames];
+        const uint32_t color = ms <= kGraphTargetMs * 1.1f ? kGoodColor
+                             : ms <= kGraphMaxMs           ? kWarnColor
+                                                           : kBadColor;
+        const int barHeight = GraphBarHeight(ms);
+        const int x = startX + static_cast<int>(i);
+        for (int y = graphBottom - barHeight + 1; y <= graphBottom; ++y) {
+            StorePixel(bgra + (static_cast<size_t>(y) * width + x) * 4, color);
+        }
+    }
+}
+
+} // namespace profiling
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace dmme {
+namespace core {
+namespace profiling {
+
+// ------------------------------------------------------------------
+// Frame pipeline stages
+//
+// A frame travels through these stages in order. Input is the moment
+// an input event was received; every later stage is measured as
+// "time since the oldest input that this frame consumed".
+// ------------------------------------------------------------------
+
+enum class FrameStage : uint8_t {
+    Input    = 0,   // input event received (InstanceWndProc / injector)
+    Update   = 1,   // simulation / opacity update done
+    Render   = 2,   // RenderPipeline::EndFrame returned
+    Readback = 3,   // pixels available on the CPU
+    Convert  = 4,   // RGBA -> BGRA premultiplied conversion done
+    Present  = 5,   // UpdateLayeredWindow returned
+    Count    = 6
+};
+
+constexpr size_t kFrameStageCount = static_cast<size_t>(FrameStage::Count);
+
+inline const char* FrameStageName(FrameStage stage) {
+    switch (stage) {
+        case FrameStage::Input:    return "input";
+        case FrameStage::Update:   return "update";
+        case FrameStage::Render:   return "render";
+        case FrameStage::Readback: return "readback";
+        case FrameStage::Convert:  return "convert";
+        case FrameStage::Present:  return "present";
+        default:                   return "unknown";
+    }
+}
+
+// ------------------------------------------------------------------
+// Latency summary for one stage (input -> end of stage)
+// ------------------------------------------------------------------
+
+struct StageLatency {
+    uint64_t samples = 0;
+    float    meanMs  = 0.0f;
+    float    p50Ms   = 0.0f;
+    float    p95Ms   = 0.0f;
+    float    p99Ms   = 0.0f;
+    float    maxMs   = 0.0f;
+};
+
+struct LatencyReport {
+    std::array<StageLatency, kFrameStageCount> stages{};
+    uint64_t framesWithInput = 0;
+    uint64_t droppedFrames   = 0;  // frames evicted before Present
+
+    const StageLatency& operator[](FrameStage stage) const {
+        return stages[static_cast<size_t>(stage)];
+    }
+};
+
+} // namespace profiling
+} // namespace core
+} // namespace dmme
\ No newline at end of file
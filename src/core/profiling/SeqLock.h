@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace dmme {
+namespace core {
+namespace profiling {
+
+// SeqLock<T> publishes a trivially copyable value from one writer
+// thread to any number of reader threads without ever blocking the
+// writer.
+//
+// The writer bumps the sequence to odd, stores the payload, then bumps
+// it to even. Readers copy the payload and retry if the sequence was
+// odd or changed while copying. The payload is kept as relaxed atomic
+// words, so a torn read is detected rather than being a data race.
+//
+// Intended for telemetry: the render thread calls Store() once per
+// frame; a background thread calls TryLoad()/Load() on demand.
+
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "SeqLock payload must be trivially copyable");
+
+public:
+    SeqLock() {
+        // Readers before the first Store() see a default T
+        std::array<uint64_t, kWords> words{};
+        const T initial{};
+        std::memcpy(words.data(), &initial, sizeof(T));
+        for (size_t i = 0; i < kWords; ++i) {
+            m_words[i].store(words[i], std::memory_order_relaxed);
+        }
+    }
+
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    // Single writer only. Wait-free.
+    void Store(const T& value) {
+        std::array<uint64_t, kWords> words{};
+        std::memcpy(words.data(), &value, sizeof(T));
+
+        const uint64_t seq = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < kWords; ++i) {
+            m_words[i].store(words[i], std::memory_order_relaxed);
+        }
+
+        m_sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    // Single attempt. Returns false if a write was in progress.
+    bool TryLoad(T& out) const {
+        const uint64_t before = m_sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+
+        std::array<uint64_t, kWords> words{};
+        for (size_t i = 0; i < kWords; ++i) {
+            words[i] = m_words[i].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_sequence.load(std::memory_order_relaxed) != before) {
+            return false;
+        }
+
+        std::memcpy(static_cast<void*>(&out), words.data(), sizeof(T));
+        return true;
+    }
+
+    // Retry until a consistent copy is read or maxAttempts is reached.
+    // Yields between attempts so a busy writer can finish its store.
+    bool Load(T& out, int maxAttempts = 64) const {
+        for (int i = 0; i < maxAttempts; ++i) {
+            if (TryLoad(out)) {
+                return true;
+            }
+            std::this_thread::yield();
+        }
+        return false;
+    }
+
+    // Number of completed Store() calls.
+    uint64_t GetVersion() const {
+        return m_sequence.load(std::memory_order_acquire) / 2;
+    }
+
+private:
+    static constexpr size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint64_t>                      m_sequence{0};
+    std::array<std::atomic<uint64_t>, kWords>  m_words{};
+};
+
+} // namespace profiling
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include "SyntheticInputInjector.h"
+#include "utils/Logger.h"
+
+#include <algorithm>
+
+namespace dmme {
+namespace core {
+namespace profiling {
+
+// ===================================================================
+// Scripting
+// ===================================================================
+
+void SyntheticInputInjector::Schedule(uint64_t offsetUs, const window::MouseEvent& evt) {
+    ScriptedEvent se;
+    se.offsetUs = offsetUs;
+    se.event    = evt;
+
+    // Keep the script sorted; stable so same-time events keep order
+    auto it = std::upper_bound(m_script.begin(), m_script.end(), offsetUs,
+        [](uint64_t t, const ScriptedEvent& e) { return t < e.offsetUs; });
+    size_t index = static_cast<size_t>(it - m_script.begin());
+    m_script.insert(it, se);
+
+    // Inserting behind the playback cursor would skip the cursor past it
+    if (m_started && index < m_cursor) {
+        m_cursor++;
+    }
+}
+
+void SyntheticInputInjector::ScheduleClicks(int count, uint64_t startOffsetUs,
+                                            uint64_t intervalUs, int x, int y) {
+    for (int i = 0; i < count; ++i) {
+        uint64_t t = startOffsetUs + static_cast<uint64_t>(i) * intervalUs;
+
+        window::MouseEvent down;
+        down.clientX = x;
+        down.clientY = y;
+        down.screenX = x;
+        down.screenY = y;
+        down.button  = window::MouseButton::Left;
+        down.isDown  = true;
+        Schedule(t, down);
+
+        window::MouseEvent up = down;
+        up.isDown = false;
+        Schedule(t + intervalUs / 2, up);
+    }
+}
+
+void SyntheticInputInjector::ScheduleDrag(uint64_t startOffsetUs, uint64_t stepUs,
+                                          int steps, int x0, int y0, int x1, int y1) {
+    if (steps <= 0) return;
+
+    window::MouseEvent down;
+    down.clientX = x0;
+    down.clientY = y0;
+    down.screenX = x0;
+    down.screenY = y0;
+    down.button  = window::MouseButton::Left;
+    down.isDown  = true;
+    Schedule(startOffsetUs, down);
+
+    for (int i = 1; i <= steps; ++i) {
+        window::MouseEvent move;
+        move.clientX = x0 + (x1 - x0) * i / steps;
+        move.clientY = y0 + (y1 - y0) * i / steps;
+        move.screenX = move.clientX;
+        move.screenY = move.clientY;
+        move.isMove  = true;
+        Schedule(startOffsetUs + static_cast<uint64_t>(i) * stepUs, move);
+    }
+
+    window::MouseEvent up = down;
+    up.clientX = x1;
+    up.clientY = y1;
+    up.screenX = x1;
+    up.screenY = y1;
+    up.isDown  = false;
+    Schedule(startOffsetUs + static_cast<uint64_t>(steps + 1) * stepUs, up);
+}
+
+void SyntheticInputInjector::Clear() {
+    m_script.clear();
+    m_cursor   = 0;
+    m_injected = 0;
+    m_started  = false;
+}
+
+// ===================================================================
+// Playback
+// ===================================================================
+
+void SyntheticInputInjector::SetMouseEventCallback(window::MouseEventCallback cb) {
+    m_callback = std::move(cb);
+}
+
+void SyntheticInputInjector::Start(uint64_t nowUs) {
+    m_startUs  = nowUs;
+    m_cursor   = 0;
+    m_injected = 0;
+    m_started  = true;
+    DMME_LOG_INFO("SyntheticInputInjector started ({} scripted events)", m_script.size());
+}
+
+int SyntheticInputInjector::Pump(uint64_t nowUs) {
+    if (!m_started) return 0;
+
+    int dispatched = 0;
+    while (m_cursor < m_script.size() &&
+           m_startUs + m_script[m_cursor].offsetUs <= nowUs) {
+        window::MouseEvent evt = m_script[m_cursor].event;
+        evt.timestampUs = nowUs;  // stamped at dispatch, like the window proc
+        m_cursor++;
+        m_injected++;
+        dispatched++;
+
+        if (m_callback) {
+            m_callback(evt);
+        }
+    }
+
+    return dispatched;
+}
+
+bool SyntheticInputInjector::IsFinished() const {
+    return m_started && m_cursor >= m_script.size();
+}
+
+size_t SyntheticInputInjector::GetInjectedCount() const {
+    return m_injected;
+}
+
+} // namespace profiling
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "core/window/WindowTypes.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace dmme {
+namespace core {
+namespace profiling {
+
+// SyntheticInputInjector replays a scripted sequence of mouse events
+// without a real window or message pump. It exists so input-to-photon
+// latency can be measured end-to-end in a headless run: the injector
+// stands in for TransparentWindow::InstanceWndProc, stamping each
+// event with a monotonic timestamp at the moment it is dispatched.
+//
+// Events are scheduled relative to Start(). Pump() is called from the
+// main loop where ProcessMessages() would normally be called and
+// dispatches every event whose time has come.
+//
+// Usage (headless):
+//   SyntheticInputInjector injector;
+//   injector.SetMouseEventCallback([&](const MouseEvent& e) {
+//       tracker.RecordInput(e.timestampUs);
+//   });
+//   injector.ScheduleClicks(100, 0, 50'000, 200, 200);
+//   injector.Start(MonotonicMicros());
+//   while (!injector.IsFinished()) {
+//       injector.Pump(MonotonicMicros());
+//       ...render a frame...
+//   }
+
+class SyntheticInputInjector {
+public:
+    SyntheticInputInjector() = default;
+    ~SyntheticInputInjector() = default;
+
+    SyntheticInputInjector(const SyntheticInputInjector&) = delete;
+    SyntheticInputInjector& operator=(const SyntheticInputInjector&) = delete;
+
+    // --- Scripting ---
+
+    // Schedule one event at offsetUs after Start().
+    void Schedule(uint64_t offsetUs, const window::MouseEvent& evt);
+
+    // Schedule `count` left clicks (down + up) at client (x, y),
+    // the first at startOffsetUs, one every intervalUs.
+    void ScheduleClicks(int count, uint64_t startOffsetUs, uint64_t intervalUs,
+                        int x, int y);
+
+    // Schedule a left-button drag from (x0, y0) to (x1, y1) made of
+    // `steps` move events spaced stepUs apart.
+    void ScheduleDrag(uint64_t startOffsetUs, uint64_t stepUs, int steps,
+                      int x0, int y0, int x1, int y1);
+
+    // Remove all scheduled events.
+    void Clear();
+
+    // --- Playback ---
+
+    void SetMouseEventCallback(window::MouseEventCallback cb);
+
+    // Begin playback; offsets are relative to nowUs.
+    void Start(uint64_t nowUs);
+
+    // Dispatch every event due at nowUs. Returns number dispatched.
+    int Pump(uint64_t nowUs);
+
+    bool   IsFinished() const;
+    size_t GetInjectedCount() const;
+
+private:
+    struct ScriptedEvent {
+        uint64_t           offsetUs = 0;
+        window::MouseEvent event;
+    };
+
+    std::vector<ScriptedEvent>  m_script;
+    window::MouseEventCallback  m_callback;
+    uint64_t                    m_startUs   = 0;
+    size_t                      m_cursor    = 0;
+    size_t                      m_injected  = 0;
+    bool                        m_started   = false;
+};
+
+} // namespace profiling
+} // namespace core
+} // namespace dmme
\ No newline at end of file
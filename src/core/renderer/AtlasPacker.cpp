@@ -0,0 +1,190 @@
+#include "AtlasPacker.h"
+#include "utils/Logger.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace dmme {
+namespace core {
+namespace renderer {
+
+namespace {
+
+// A shelf may be up to this much taller than the request (x/2 extra)
+// before a new, tighter shelf is preferred.
+constexpr int kShelfSlackDivisor = 2;
+
+} // anonymous namespace
+
+// ===================================================================
+// Lifecycle
+// ===================================================================
+
+void AtlasPacker::Reset(int width, int height) {
+    m_shelves.clear();
+    m_width           = std::max(width, 0);
+    m_height          = std::max(height, 0);
+    m_nextShelfY      = 0;
+    m_allocatedArea   = 0;
+    m_allocationCount = 0;
+}
+
+// ===================================================================
+// Allocate
+// ===================================================================
+
+bool AtlasPacker::Allocate(int width, int height, AtlasRect& out) {
+    if (width <= 0 || height <= 0 || width > m_width || height > m_height) {
+        return false;
+    }
+
+    // --- Best existing shelf: shortest one the request fits on ---
+    // Shelves much taller than the request are only used once they
+    // are completely empty, so one small character cannot pin a tall
+    // shelf's height.
+    Shelf* best = nullptr;
+    for (auto& shelf : m_shelves) {
+        if (shelf.height < height) {
+            continue;
+        }
+        const bool tight = shelf.height <= height + height / kShelfSlackDivisor;
+        if (!tight && shelf.used > 0) {
+            continue;
+        }
+        if (best && shelf.height >= best->height) {
+            continue;
+        }
+        for (const Span& span : shelf.free) {
+            if (span.width >= width) {
+                best = &shelf;
+                break;
+            }
+        }
+    }
+
+    if (best) {
+        return AllocateOnShelf(*best, width, out);
+    }
+
+    // --- New shelf at the bottom ---
+    if (m_nextShelfY + height > m_height) {
+        return false;
+    }
+
+    Shelf shelf;
+    shelf.y      = m_nextShelfY;
+    shelf.height = height;
+    shelf.free.push_back({0, m_width});
+    m_shelves.push_back(std::move(shelf));
+    m_nextShelfY += height;
+
+    return AllocateOnShelf(m_shelves.back(), width, out);
+}
+
+bool AtlasPacker::AllocateOnShelf(Shelf& shelf, int width, AtlasRect& out) {
+    for (size_t i = 0; i < shelf.free.size(); ++i) {
+        Span& span = shelf.free[i];
+        if (span.width < width) {
+            continue;
+        }
+
+        out.x      = span.x;
+        out.y      = shelf.y;
+        out.width  = width;
+        out.height = shelf.height;
+
+        span.x     += width;
+        span.width -= width;
+        if (span.width == 0) {
+            shelf.free.erase(shelf.free.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+
+        shelf.used++;
+        m_allocationCount++;
+        m_allocatedArea += static_cast<uint64_t>(out.width) * out.height;
+        return true;
+    }
+    return false;
+}
+
+// ===================================================================
+// Free
+// ===================================================================
+
+void AtlasPacker::Free(const AtlasRect& rect) {
+    if (rect.IsEmpty()) {
+        return;
+    }
+
+    auto shelfIt = std::find_if(m_shelves.begin(), m_shelves.end(),
+                                [&rect](const Shelf& s) { return s.y == rect.y; });
+    if (shelfIt == m_shelves.end() || shelfIt->used == 0) {
+        DMME_LOG_WARN("AtlasPacker::Free: rect ({},{} {}x{}) is not allocated",
+                      rect.x, rect.y, rect.width, rect.height);
+        return;
+    }
+
+    Shelf& shelf = *shelfIt;
+    auto& spans = shelf.free;
+
+    // Insert sorted, then merge with the neighbours
+    auto it = std::lower_bound(spans.begin(), spans.end(), rect.x,
+                               [](const Span& s, int x) { return s.x < x; });
+    it = spans.insert(it, Span{rect.x, rect.width});
+
+    auto next = it + 1;
+    if (next != spans.end() && it->x + it->width == next->x) {
+        it->width += next->width;
+        spans.erase(next);
+    }
+    if (it != spans.begin()) {
+        auto prev = it - 1;
+        if (prev->x + prev->width == it->x) {
+            prev->width += it->width;
+            spans.erase(it);
+        }
+    }
+
+    shelf.used--;
+    m_allocationCount--;
+    m_allocatedArea -= static_cast<uint64_t>(rect.width) * shelf.height;
+
+    ReleaseTrailingShelves();
+}
+
+void AtlasPacker::ReleaseTrailingShelves() {
+    while (!m_shelves.empty() && m_shelves.back().used == 0) {
+        m_nextShelfY = m_shelves.back().y;
+        m_shelves.pop_back();
+    }
+}
+
+// ===================================================================
+// Grow
+// ===================================================================
+
+bool AtlasPacker::Grow(int newWidth, int newHeight) {
+    if (newWidth < m_width || newHeight < m_height) {
+        return false;
+    }
+
+    // Extend every shelf's free space to the new right edge
+    if (newWidth > m_width) {
+        for (auto& shelf : m_shelves) {
+            if (!shelf.free.empty() &&
+                shelf.free.back().x + shelf.free.back().width == m_width) {
+                shelf.free.back().width += newWidth - m_width;
+            } else {
+                shelf.free.push_back({m_width, newWidth - m_width});
+            }
+        }
+    }
+
+    m_width  = newWidth;
+    m_height = newHeight;
+    return true;
+}
+
+} // namespace renderer
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace dmme {
+namespace core {
+namespace renderer {
+
+// ------------------------------------------------------------------
+// Atlas Rect (pixels, top-left origin)
+// ------------------------------------------------------------------
+
+struct AtlasRect {
+    int x      = 0;
+    int y      = 0;
+    int width  = 0;
+    int height = 0;
+
+    bool IsEmpty() const { return width <= 0 || height <= 0; }
+    bool Contains(int w, int h) const { return w <= width && h <= height; }
+};
+
+// AtlasPacker hands out sub-rects of a fixed-size atlas using shelf
+// packing: the atlas is cut into horizontal shelves, and each shelf
+// keeps a sorted list of free horizontal spans.
+//
+// Rects are allocated and freed individually, so one character can
+// move to a bigger rect without disturbing any other. Freed spans are
+// merged with their neighbours, and trailing empty shelves are given
+// back so a later, taller request can use the height.
+//
+// Grow() enlarges the atlas in place; existing rects stay valid.
+// Everything is O(shelves + spans), which is tiny for the handful of
+// characters an atlas holds.
+
+class AtlasPacker {
+public:
+    AtlasPacker() = default;
+    ~AtlasPacker() = default;
+
+    AtlasPacker(const AtlasPacker&) = delete;
+    AtlasPacker& operator=(const AtlasPacker&) = delete;
+
+    // Drop every allocation and start over with a width x height atlas
+    void Reset(int width, int height);
+
+    // Allocate width x height. The rect is exactly width wide and as
+    // tall as the shelf it lands on (at least height); Free
+    // expects it back unchanged. Returns false if it does not fit.
+    bool Allocate(int width, int height, AtlasRect& out);
+
+    // Return a rect obtained from Allocate
+    void Free(const AtlasRect& rect);
+
+    // Enlarge the atlas; existing allocations are unaffected.
+    // Shrinking is not supported (Reset and re-allocate instead).
+    bool Grow(int newWidth, int newHeight);
+
+    // --- Queries ---
+    int      GetWidth() const         { return m_width; }
+    int      GetHeight() const        { return m_height; }
+    int      GetUsedHeight() const    { return m_nextShelfY; }   // shelves in use
+    uint64_t GetAllocatedArea() const { return m_allocatedArea; }
+    uint32_t GetAllocationCount() const { return m_allocationCount; }
+
+private:
+    struct Span {
+        int x;
+        int width;
+    };
+
+    struct Shelf {
+        int y      = 0;
+        int height = 0;
+        int used   = 0;                  // allocations on this shelf
+        std::vector<Span> free;          // sorted by x, never adjacent
+    };
+
+    bool AllocateOnShelf(Shelf& shelf, int width, AtlasRect& out);
+    void ReleaseTrailingShelves();
+
+    std::vector<Shelf> m_shelves;        // sorted by y
+    int      m_width           = 0;
+    int      m_height          = 0;
+    int      m_nextShelfY      = 0;
+    uint64_t m_allocatedArea   = 0;
+    uint32_t m_allocationCount = 0;
+};
+
+} // namespace renderer
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,443 @@
+#include "BlockCompression.h"
+#include "utils/Simd.h"
+
+#include <cstring>
+
+namespace dmme {
+namespace core {
+namespace renderer {
+
+namespace {
+
+// ===================================================================
+// BC1 / BC3
+// ===================================================================
+
+inline uint32_t PackRGBA(uint32_t r, uint32_t g, uint32_t b, uint32_t a) {
+    return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+// 565 endpoints and their interpolated entries. BC3 colour blocks are
+// always in four-colour mode; BC1 switches to three colours plus
+// transparent black when c0 <= c1.
+void BuildColorPalette(const uint8_t* block, bool punchThrough, uint32_t palette[4]) {
+    const uint32_t c0 = block[0] | (block[1] << 8);
+    const uint32_t c1 = block[2] | (block[3] << 8);
+
+    const uint32_t r0 = ((c0 >> 11) << 3) | (c0 >> 13);
+    const uint32_t g0 = (((c0 >> 5) & 0x3F) << 2) | ((c0 >> 9) & 0x3);
+    const uint32_t b0 = ((c0 & 0x1F) << 3) | ((c0 >> 2) & 0x7);
+    const uint32_t r1 = ((c1 >> 11) << 3) | (c1 >> 13);
+    const uint32_t g1 = (((c1 >> 5) & 0x3F) << 2) | ((c1 >> 9) & 0x3);
+    const uint32_t b1 = ((c1 & 0x1F) << 3) | ((c1 >> 2) & 0x7);
+
+    palette[0] = PackRGBA(r0, g0, b0, 255);
+    palette[1] = PackRGBA(r1, g1, b1, 255);
+    if (c0 > c1 || !punchThrough) {
+        palette[2] = PackRGBA((2 * r0 + r1 + 1) / 3, (2 * g0 + g1 + 1) / 3, (2 * b0 + b1 + 1) / 3, 255);
+        palette[3] = PackRGBA((r0 + 2 * r1 + 1) / 3, (g0 + 2 * g1 + 1) / 3, (b0 + 2 * b1 + 1) / 3, 255);
+    } else {
+        palette[2] = PackRGBA((r0 + r1 + 1) / 2, (g0 + g1 + 1) / 2, (b0 + b1 + 1) / 2, 255);
+        palette[3] = 0;
+    }
+}
+
+// BC3 alpha: two endpoints and six interpolated (or four plus 0 / 255)
+void BuildAlphaPalette(const uint8_t* block, uint32_t palette[8]) {
+    const uint32_t a0 = block[0];
+    const uint32_t a1 = block[1];
+    palette[0] = a0;
+    palette[1] = a1;
+    if (a0 > a1) {
+        for (uint32_t i = 1; i < 7; ++i) {
+            palette[i + 1] = ((7 - i) * a0 + i * a1 + 3) / 7;
+        }
+    } else {
+        for (uint32_t i = 1; i < 5; ++i) {
+            palette[i + 1] = ((5 - i) * a0 + i * a1 + 2) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+// 16 two-bit colour indices (texel 0 in the low bits), and for BC3 the
+// alpha of each texel; alpha == nullptr keeps the palette's alpha
+void WriteColorBlock(const uint32_t palette[4], uint32_t indices, const uint32_t* alpha,
+                     uint8_t* out, size_t outStride) {
+#if defined(DMME_SIMD_SSE2)
+    // Compare-and-select: each row's four indices sit in one byte;
+    // mask them in place and match against k shifted the same way
+    const __m128i fields = _mm_setr_epi32(0x03, 0x0C, 0x30, 0xC0);
+    const __m128i entry[4] = {
+        _mm_set1_epi32(static_cast<int>(palette[0])), _mm_set1_epi32(static_cast<int>(palette[1])),
+        _mm_set1_epi32(static_cast<int>(palette[2])), _mm_set1_epi32(static_cast<int>(palette[3]))};
+    for (int row = 0; row < 4; ++row) {
+        const __m128i idx = _mm_and_si128(_mm_set1_epi32(static_cast<int>((indices >> (row * 8)) & 0xFF)), fields);
+        __m128i texels = _mm_and_si128(_mm_cmpeq_epi32(idx, _mm_setzero_si128()), entry[0]);
+        texels = _mm_or_si128(texels, _mm_and_si128(_mm_cmpeq_epi32(idx, _mm_setr_epi32(0x01, 0x04, 0x10, 0x40)), entry[1]));
+        texels = _mm_or_si128(texels, _mm_and_si128(_mm_cmpeq_epi32(idx, _mm_setr_epi32(0x02, 0x08, 0x20, 0x80)), entry[2]));
+        texels = _mm_or_si128(texels, _mm_and_si128(_mm_cmpeq_epi32(idx, fields), entry[3]));
+        if (alpha) {
+            const __m128i a = _mm_setr_epi32(static_cast<int>(alpha[row * 4 + 0] << 24),
+                                             static_cast<int>(alpha[row * 4 + 1] << 24),
+                                             static_cast<int>(alpha[row * 4 + 2] << 24),
+                                             static_cast<int>(alpha[row * 4 + 3] << 24));
+            texels = _mm_or_si128(_mm_and_si128(texels, _mm_set1_epi32(0x00FFFFFF)), a);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + row * outStride), texels);
+    }
+#else
+    for (int row = 0; row < 4; ++row) {
+        uint32_t texels[4];
+        for (int x = 0; x < 4; ++x) {
+            const int i = row * 4 + x;
+            texels[x] = palette[(indices >> (2 * i)) & 3];
+            if (alpha) {
+                texels[x] = (texels[x] & 0x00FFFFFFu) | (alpha[i] << 24);
+            }
+        }
+        std::memcpy(out + row * outStride, texels, sizeof(texels));
+    }
+#endif
+}
+
+inline uint32_t ReadU32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// ===================================================================
+// BC7 tables
+// ===================================================================
+
+struct Bc7Mode {
+    uint8_t subsets;
+    uint8_t partitionBits;
+    uint8_t rotationBits;
+    uint8_t indexSelectionBits;
+    uint8_t colorBits;
+    uint8_t alphaBits;
+    uint8_t endpointPBits;      // one p-bit per endpoint
+    uint8_t sharedPBits;        // one p-bit per subset
+    uint8_t indexBits;
+    uint8_t secondaryIndexBits;
+};
+
+constexpr Bc7Mode kBc7Modes[8] = {
+    {3, 4, 0, 0, 4, 0, 1, 0, 3, 0},
+    {2, 6, 0, 0, 6, 0, 0, 1, 3, 0},
+    {3, 6, 0, 0, 5, 0, 0, 0, 2, 0},
+    {2, 6, 0, 0, 7, 0, 1, 0, 2, 0},
+    {1, 0, 2, 1, 5, 6, 0, 0, 2, 3},
+    {1, 0, 2, 0, 7, 8, 0, 0, 2, 2},
+    {1, 0, 0, 0, 7, 7, 1, 0, 4, 0},
+    {2, 6, 0, 0, 5, 5, 1, 0, 2, 0},
+};
+
+// Two-subset partitions: bit i set = texel i in subset 1
+constexpr uint16_t kBc7Partitions2[64] = {
+    0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+    0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+    0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+    0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+    0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+    0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+    0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+    0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+};
+
+// Three-subset partitions: bits 2i..2i+1 = subset of texel i
+constexpr uint32_t kBc7Partitions3[64] = {
+    0xAA685050, 0x6A5A5040, 0x5A5A4200, 0x5450A0A8, 0xA5A50000, 0xA0A05050, 0x5555A0A0, 0x5A5A5050,
+    0xAA550000, 0xAA555500, 0xAAAA5500, 0x90909090, 0x94949494, 0xA4A4A4A4, 0xA9A59450, 0x2A0A4250,
+    0xA5945040, 0x0A425054, 0xA5A5A500, 0x55A0A0A0, 0xA8A85454, 0x6A6A4040, 0xA4A45000, 0x1A1A0500,
+    0x0050A4A4, 0xAAA59090, 0x14696914, 0x69691400, 0xA08585A0, 0xAA821414, 0x50A4A450, 0x6A5A0200,
+    0xA9A58000, 0x5090A0A8, 0xA8A09050, 0x24242424, 0x00AA5500, 0x24924924, 0x24499224, 0x50A50A50,
+    0x500AA550, 0xAAAA4444, 0x66660000, 0xA5A0A5A0, 0x50A050A0, 0x69286928, 0x44AAAA44, 0x66666600,
+    0xAA444444, 0x54A854A8, 0x95809580, 0x96969600, 0xA85454A8, 0x80959580, 0xAA141414, 0x96960000,
+    0xAAAA1414, 0xA05050A0, 0xA0A5A5A0, 0x96000000, 0x40804080, 0xA9A8A9A8, 0xAAAAAA44, 0x2A4A5254,
+};
+
+// Anchor texels (index stored with one bit less) of subsets 1 and 2
+constexpr uint8_t kBc7Anchor2[64] = {
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15,  2,  8,  2,  2,  8,  8, 15,  2,  8,  2,  2,  8,  8,  2,  2,
+    15, 15,  6,  8,  2,  8, 15, 15,  2,  8,  2,  2,  2, 15, 15,  6,
+     6,  2,  6,  8, 15, 15,  2,  2, 15, 15, 15, 15, 15,  2,  2, 15,
+};
+
+constexpr uint8_t kBc7Anchor3Second[64] = {
+     3,  3, 15, 15,  8,  3, 15, 15,  8,  8,  6,  6,  6,  5,  3,  3,
+     3,  3,  8, 15,  3,  3,  6, 10,  5,  8,  8,  6,  8,  5, 15, 15,
+     8, 15,  3,  5,  6, 10,  8, 15, 15,  3, 15,  5, 15, 15, 15, 15,
+     3, 15,  5,  5,  5,  8,  5, 10,  5, 10,  8, 13, 15, 12,  3,  3,
+};
+
+constexpr uint8_t kBc7Anchor3Third[64] = {
+    15,  8,  8,  3, 15, 15,  3,  8, 15, 15, 15, 15, 15, 15, 15,  8,
+    15,  8, 15,  3, 15,  8, 15,  8,  3, 15,  6, 10, 15, 15, 10,  8,
+    15,  3, 15, 10, 10,  8,  9, 10,  6, 15,  8, 15,  3,  6,  6,  8,
+    15,  3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  3, 15, 15,  8,
+};
+
+constexpr uint8_t kBc7Weights2[4]  = {0, 21, 43, 64};
+constexpr uint8_t kBc7Weights3[8]  = {0, 9, 18, 27, 37, 46, 55, 64};
+constexpr uint8_t kBc7Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+inline const uint8_t* GetBc7Weights(uint32_t bits) {
+    return bits == 2 ? kBc7Weights2 : bits == 3 ? kBc7Weights3 : kBc7Weights4;
+}
+
+// Little-endian bit stream over one 128-bit block
+class BlockBits {
+public:
+    explicit BlockBits(const uint8_t* block) {
+        std::memcpy(&m_lo, block, 8);
+        std::memcpy(&m_hi, block + 8, 8);
+    }
+
+    // count <= 8
+    uint32_t Read(uint32_t count) {
+        uint64_t v;
+        if (m_pos >= 64) {
+            v = m_hi >> (m_pos - 64);
+        } else if (m_pos + count <= 64) {
+            v = m_lo >> m_pos;
+        } else {
+            v = (m_lo >> m_pos) | (m_hi << (64 - m_pos));
+        }
+        m_pos += count;
+        return static_cast<uint32_t>(v & ((1u << count) - 1));
+    }
+
+    void Skip(uint32_t count) { m_pos += count; }
+
+    // The next 64 bits (zero past the end), without advancing
+    uint64_t Peek64() const {
+        if (m_pos >= 128) return 0;
+        if (m_pos >= 64)  return m_hi >> (m_pos - 64);
+        if (m_pos == 0)   return m_lo;
+        return (m_lo >> m_pos) | (m_hi << (64 - m_pos));
+    }
+
+private:
+    uint64_t m_lo  = 0;
+    uint64_t m_hi  = 0;
+    uint32_t m_pos = 0;
+};
+
+inline uint16_t ExpandBits(uint32_t v, uint32_t bits) {
+    return static_cast<uint16_t>(((v << (8 - bits)) | (v >> (2 * bits - 8))) & 0xFF);
+}
+
+} // anonymous namespace
+
+// ===================================================================
+// Block decoders
+// ===================================================================
+
+void DecodeBC1Block(const uint8_t* block, uint8_t* out, size_t outStride) {
+    uint32_t palette[4];
+    BuildColorPalette(block, true, palette);
+    WriteColorBlock(palette, ReadU32(block + 4), nullptr, out, outStride);
+}
+
+void DecodeBC3Block(const uint8_t* block, uint8_t* out, size_t outStride) {
+    uint32_t alphaPalette[8];
+    BuildAlphaPalette(block, alphaPalette);
+
+    uint64_t alphaIndices = 0;
+    for (int i = 0; i < 6; ++i) {
+        alphaIndices |= static_cast<uint64_t>(block[2 + i]) << (8 * i);
+    }
+    uint32_t alpha[16];
+    for (int i = 0; i < 16; ++i) {
+        alpha[i] = alphaPalette[(alphaIndices >> (3 * i)) & 7];
+    }
+
+    uint32_t palette[4];
+    BuildColorPalette(block + 8, false, palette);
+    WriteColorBlock(palette, ReadU32(block + 12), alpha, out, outStride);
+}
+
+void DecodeBC7Block(const uint8_t* block, uint8_t* out, size_t outStride) {
+    uint32_t mode = 0;
+    while (mode < 8 && (block[0] & (1u << mode)) == 0) {
+        ++mode;
+    }
+    if (mode == 8) {
+        for (int row = 0; row < 4; ++row) {
+            std::memset(out + row * outStride, 0, 16);
+        }
+        return;
+    }
+
+    const Bc7Mode& m = kBc7Modes[mode];
+    BlockBits bits(block);
+    bits.Skip(mode + 1);
+    const uint32_t partition = bits.Read(m.partitionBits);
+    const uint32_t rotation  = bits.Read(m.rotationBits);
+    const uint32_t selection = bits.Read(m.indexSelectionBits);
+
+    // --- Endpoints: [subset * 2 + endpoint][channel] ---
+    uint32_t endpoints[6][4] = {};
+    const uint32_t endpointCount = m.subsets * 2u;
+    for (uint32_t c = 0; c < 3; ++c) {
+        for (uint32_t e = 0; e < endpointCount; ++e) {
+            endpoints[e][c] = bits.Read(m.colorBits);
+        }
+    }
+    for (uint32_t e = 0; m.alphaBits && e < endpointCount; ++e) {
+        endpoints[e][3] = bits.Read(m.alphaBits);
+    }
+
+    uint32_t colorBits = m.colorBits;
+    uint32_t alphaBits = m.alphaBits;
+    if (m.endpointPBits || m.sharedPBits) {
+        uint32_t pbits[6];
+        for (uint32_t e = 0; e < endpointCount; ++e) {
+            pbits[e] = (m.sharedPBits && (e & 1)) ? pbits[e - 1] : bits.Read(1);
+        }
+        for (uint32_t e = 0; e < endpointCount; ++e) {
+            for (uint32_t c = 0; c < 4; ++c) {
+                endpoints[e][c] = (endpoints[e][c] << 1) | pbits[e];
+            }
+        }
+        ++colorBits;
+        if (alphaBits) ++alphaBits;
+    }
+
+    // Expanded to 8 bits, rotation applied to the endpoints (and below
+    // to the weights) so the interpolation writes final channels
+    const uint32_t alphaChannel = rotation ? rotation - 1 : 3;
+    alignas(16) uint16_t lo[3][4];
+    alignas(16) uint16_t hi[3][4];
+    for (uint32_t s = 0; s < m.subsets; ++s) {
+        for (uint32_t c = 0; c < 4; ++c) {
+            uint16_t v0 = 255;
+            uint16_t v1 = 255;
+            if (c < 3) {
+                v0 = ExpandBits(endpoints[s * 2][c], colorBits);
+                v1 = ExpandBits(endpoints[s * 2 + 1][c], colorBits);
+            } else if (alphaBits) {
+                v0 = ExpandBits(endpoints[s * 2][c], alphaBits);
+                v1 = ExpandBits(endpoints[s * 2 + 1][c], alphaBits);
+            }
+            const uint32_t dst = c == 3 ? alphaChannel : c == alphaChannel ? 3 : c;
+            lo[s][dst] = v0;
+            hi[s][dst] = v1;
+        }
+    }
+
+    // --- Subsets and anchors ---
+    uint32_t subsetOf[16] = {};
+    uint32_t anchor1 = 16;
+    uint32_t anchor2 = 16;
+    if (m.subsets == 2) {
+        for (uint32_t i = 0; i < 16; ++i) subsetOf[i] = (kBc7Partitions2[partition] >> i) & 1;
+        anchor1 = kBc7Anchor2[partition];
+    } else if (m.subsets == 3) {
+        for (uint32_t i = 0; i < 16; ++i) subsetOf[i] = (kBc7Partitions3[partition] >> (2 * i)) & 3;
+        anchor1 = kBc7Anchor3Second[partition];
+        anchor2 = kBc7Anchor3Third[partition];
+    }
+
+    // --- Indices -> per-channel weights ---
+    // Each index set fits in 64 bits: shift it out of one window
+    uint32_t primary[16];
+    uint64_t window = bits.Peek64();
+    uint32_t used   = 0;
+    for (uint32_t i = 0; i < 16; ++i) {
+        const bool     anchor = i == 0 || i == anchor1 || i == anchor2;
+        const uint32_t count  = m.indexBits - (anchor ? 1u : 0u);
+        primary[i] = static_cast<uint32_t>(window & ((1u << count) - 1));
+        window >>= count;
+        used    += count;
+    }
+    bits.Skip(used);
+    const uint8_t* primaryWeights = GetBc7Weights(m.indexBits);
+    alignas(16) uint16_t weights[16][4];
+    if (m.secondaryIndexBits) {
+        const uint8_t* secondaryWeights = GetBc7Weights(m.secondaryIndexBits);
+        window = bits.Peek64();
+        for (uint32_t i = 0; i < 16; ++i) {
+            const uint32_t count     = m.secondaryIndexBits - (i == 0 ? 1u : 0u);
+            const uint32_t secondary = static_cast<uint32_t>(window & ((1u << count) - 1));
+            window >>= count;
+            const uint16_t wp = primaryWeights[primary[i]];
+            const uint16_t ws = secondaryWeights[secondary];
+            const uint16_t wc = selection ? ws : wp;
+            const uint16_t wa = selection ? wp : ws;
+            for (uint32_t c = 0; c < 4; ++c) {
+                weights[i][c] = c == alphaChannel ? wa : wc;
+            }
+        }
+    } else {
+        for (uint32_t i = 0; i < 16; ++i) {
+            const uint16_t w = primaryWeights[primary[i]];
+            weights[i][0] = weights[i][1] = weights[i][2] = weights[i][3] = w;
+        }
+    }
+
+    // --- Interpolate: ((64 - w) * e0 + w * e1 + 32) >> 6 ---
+#if defined(DMME_SIMD_SSE2)
+    const __m128i w64   = _mm_set1_epi16(64);
+    const __m128i round = _mm_set1_epi16(32);
+    for (int row = 0; row < 4; ++row) {
+        __m128i pair[2];
+        for (int p = 0; p < 2; ++p) {
+            const uint32_t i0 = row * 4 + p * 2;
+            const uint32_t i1 = i0 + 1;
+            const __m128i e0 = _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(lo[subsetOf[i0]])),
+                                                  _mm_loadl_epi64(reinterpret_cast<const __m128i*>(lo[subsetOf[i1]])));
+            const __m128i e1 = _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(hi[subsetOf[i0]])),
+                                                  _mm_loadl_epi64(reinterpret_cast<const __m128i*>(hi[subsetOf[i1]])));
+            const __m128i w  = _mm_load_si128(reinterpret_cast<const __m128i*>(weights[i0]));
+            const __m128i sum = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(e0, _mm_sub_epi16(w64, w)),
+                                                            _mm_mullo_epi16(e1, w)), round);
+            pair[p] = _mm_srli_epi16(sum, 6);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + row * outStride), _mm_packus_epi16(pair[0], pair[1]));
+    }
+#else
+    for (uint32_t i = 0; i < 16; ++i) {
+        uint8_t* texel = out + (i / 4) * outStride + (i % 4) * 4;
+        const uint32_t s = subsetOf[i];
+        for (uint32_t c = 0; c < 4; ++c) {
+            const uint32_t w = weights[i][c];
+            texel[c] = static_cast<uint8_t>(((64 - w) * lo[s][c] + w * hi[s][c] + 32) >> 6);
+        }
+    }
+#endif
+}
+
+// ===================================================================
+// Regions
+// ===================================================================
+
+bool DecodeBlocks(TextureFormat format, const uint8_t* blocks, size_t blockPitch,
+                  int blocksWide, int blocksHigh, uint8_t* out, size_t outStride) {
+    void (*decode)(const uint8_t*, uint8_t*, size_t) = nullptr;
+    switch (format) {
+        case TextureFormat::BC1_UNORM: decode = &DecodeBC1Block; break;
+        case TextureFormat::BC3_UNORM: decode = &DecodeBC3Block; break;
+        case TextureFormat::BC7_UNORM: decode = &DecodeBC7Block; break;
+        default: return false;
+    }
+
+    const size_t blockBytes = GetBlockBytes(format);
+    for (int by = 0; by < blocksHigh; ++by) {
+        const uint8_t* src = blocks + static_cast<size_t>(by) * blockPitch;
+        uint8_t*       dst = out + static_cast<size_t>(by) * kBlockSize * outStride;
+        for (int bx = 0; bx < blocksWide; ++bx) {
+            decode(src, dst, outStride);
+            src += blockBytes;
+            dst += kBlockSize * 4;
+        }
+    }
+    return true;
+}
+
+} // namespace renderer
+} // namespace core
+} // namespace dmme
\ No newline at end of file
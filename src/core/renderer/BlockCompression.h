@@ -0,0 +1,69 @@
+#pragma once
+
+#include "RenderTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dmme {
+namespace core {
+namespace renderer {
+
+// ------------------------------------------------------------------
+// Block-compressed formats
+// ------------------------------------------------------------------
+
+// BC1 / BC3 / BC7 store 4x4 texel blocks (8 or 16 bytes each), rows of
+// blocks top to bottom. Block-compressed textures must have dimensions
+// that are multiples of 4, and their updates must cover whole blocks;
+// the pixels of an update are then block rows, strideBytes apart.
+
+constexpr int kBlockSize = 4;   // texels per block edge
+
+constexpr bool IsBlockCompressed(TextureFormat f) {
+    return f == TextureFormat::BC1_UNORM || f == TextureFormat::BC3_UNORM ||
+           f == TextureFormat::BC7_UNORM;
+}
+
+// Bytes per 4x4 block, 0 for uncompressed formats
+constexpr uint32_t GetBlockBytes(TextureFormat f) {
+    return f == TextureFormat::BC1_UNORM ? 8u : IsBlockCompressed(f) ? 16u : 0u;
+}
+
+// Storage of a width x height image (whole blocks for BC formats)
+constexpr uint64_t GetTextureBytes(TextureFormat f, int width, int height) {
+    if (IsBlockCompressed(f)) {
+        const uint64_t blocksX = static_cast<uint64_t>(width  + kBlockSize - 1) / kBlockSize;
+        const uint64_t blocksY = static_cast<uint64_t>(height + kBlockSize - 1) / kBlockSize;
+        return blocksX * blocksY * GetBlockBytes(f);
+    }
+    const uint64_t texelBytes = f == TextureFormat::RGBA16_FLOAT ? 8 : 4;
+    return static_cast<uint64_t>(width) * static_cast<uint64_t>(height) * texelBytes;
+}
+
+// ------------------------------------------------------------------
+// Decoding
+// ------------------------------------------------------------------
+
+// CPU decoders to RGBA8 for the software path (GPUs sample BC natively).
+//
+// BC1 and BC3 interpolate palette entries with rounding to nearest
+// (the D3D reference behaviour; hardware may differ by 1). BC7 follows
+// the specification exactly; reserved mode blocks decode to zero.
+// The SSE2 paths select palette entries and interpolate BC7 endpoints
+// several texels at a time.
+
+// One 4x4 block; out rows are outStride bytes apart
+void DecodeBC1Block(const uint8_t* block, uint8_t* out, size_t outStride);
+void DecodeBC3Block(const uint8_t* block, uint8_t* out, size_t outStride);
+void DecodeBC7Block(const uint8_t* block, uint8_t* out, size_t outStride);
+
+// blocksWide x blocksHigh blocks starting at blocks (rows blockPitch
+// bytes apart) into RGBA8 at out (rows outStride bytes apart). Returns
+// false for a format that is not block-compressed.
+bool DecodeBlocks(TextureFormat format, const uint8_t* blocks, size_t blockPitch,
+                  int blocksWide, int blocksHigh, uint8_t* out, size_t outStride);
+
+} // namespace renderer
+} // namespace core
+} // namespace dmme
\ No newline at end of file
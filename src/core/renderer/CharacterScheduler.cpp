@@ -0,0 +1,444 @@
+#include "CharacterScheduler.h"
+#include "utils/Logger.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace dmme {
+namespace core {
+namespace renderer {
+
+namespace {
+
+// A slot more than this many times the (rounded) area it needs is
+// handed back so a shrunken character does not hold a big hole.
+constexpr uint64_t kMaxSlotWaste = 4;
+
+// Below this occupancy the atlas counts as mostly empty
+constexpr float kShrinkOccupancy = 0.25f;
+
+} // anonymous namespace
+
+// ===================================================================
+// Lifecycle
+// ===================================================================
+
+CharacterScheduler::CharacterScheduler(const CharacterSchedulerConfig& config)
+    : m_config(config)
+{
+    m_config.maxAtlasSize     = std::max(m_config.maxAtlasSize, 1);
+    m_config.initialAtlasSize = std::clamp(m_config.initialAtlasSize, 1, m_config.maxAtlasSize);
+    m_config.slotGranularity  = std::max(m_config.slotGranularity, 1);
+
+    m_packer.Reset(m_config.initialAtlasSize, m_config.initialAtlasSize);
+}
+
+// ===================================================================
+// Characters
+// ===================================================================
+
+CharacterId CharacterScheduler::AddCharacter(int outputWidth, int outputHeight) {
+    CharacterId id = kInvalidCharacterId;
+    if (!m_freeIds.empty()) {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+    } else {
+        id = static_cast<CharacterId>(m_characters.size());
+        m_characters.emplace_back();
+    }
+
+    Character& c = m_characters[id];
+    c = Character{};
+    c.alive        = true;
+    c.outputWidth  = std::max(outputWidth, 1);
+    c.outputHeight = std::max(outputHeight, 1);
+    UpdateRenderSize(c);
+
+    DMME_LOG_INFO("CharacterScheduler: added character {} ({}x{})",
+                  id, c.outputWidth, c.outputHeight);
+    return id;
+}
+
+void CharacterScheduler::RemoveCharacter(CharacterId id) {
+    if (!IsValid(id)) {
+        return;
+    }
+    Character& c = m_characters[id];
+    ReleaseSlot(c);
+    c.alive = false;
+    m_freeIds.push_back(id);
+}
+
+void CharacterScheduler::SetCharacterSize(CharacterId id, int outputWidth, int outputHeight) {
+    if (!IsValid(id)) {
+        return;
+    }
+    Character& c = m_characters[id];
+    c.outputWidth    = std::max(outputWidth, 1);
+    c.outputHeight   = std::max(outputHeight, 1);
+    c.overflowed     = false;
+    c.warnedUnplaced = false;
+    UpdateRenderSize(c);
+}
+
+void CharacterScheduler::SetCharacterVisible(CharacterId id, bool visible) {
+    if (!IsValid(id)) {
+        return;
+    }
+    m_characters[id].visible = visible;
+}
+
+void CharacterScheduler::SetRenderScale(float scale) {
+    scale = std::clamp(scale, 0.25f, 1.0f);
+    if (scale == m_renderScale) {
+        return;
+    }
+    m_renderScale = scale;
+    for (auto& c : m_characters) {
+        if (c.alive) {
+            c.overflowed     = false;
+            c.warnedUnplaced = false;
+            UpdateRenderSize(c);
+        }
+    }
+}
+
+float CharacterScheduler::GetRenderScale() const {
+    return m_renderScale;
+}
+
+// ===================================================================
+// Frame
+// ===================================================================
+
+bool CharacterScheduler::BeginFrame() {
+    if (m_repackPending) {
+        m_repackPending = false;
+        Repack(m_packer.GetWidth(), m_packer.GetHeight());
+    }
+
+    // --- Keep, release or queue each character's slot ---
+    m_pending.clear();
+    for (CharacterId id = 0; id < m_characters.size(); ++id) {
+        Character& c = m_characters[id];
+        if (!c.alive) {
+            continue;
+        }
+
+        if (!c.visible) {
+            c.hiddenFrames++;
+            if (c.hasSlot && c.hiddenFrames > m_config.releaseHiddenAfterFrames) {
+                ReleaseSlot(c);
+            }
+            continue;
+        }
+        c.hiddenFrames = 0;
+
+        if (c.hasSlot) {
+            const uint64_t need = static_cast<uint64_t>(RoundToGranularity(c.renderWidth)) *
+                                  RoundToGranularity(c.renderHeight);
+            const uint64_t have = static_cast<uint64_t>(c.slot.width) * c.slot.height;
+            if (c.slot.Contains(c.renderWidth, c.renderHeight) && have <= need * kMaxSlotWaste) {
+                continue;
+            }
+            ReleaseSlot(c);
+            m_stats.slotMoves++;
+        }
+        m_pending.push_back(id);
+    }
+
+    // --- Place newcomers, tallest first (better shelf fill) ---
+    std::sort(m_pending.begin(), m_pending.end(), [this](CharacterId a, CharacterId b) {
+        return m_characters[a].renderHeight > m_characters[b].renderHeight;
+    });
+
+    for (size_t i = 0; i < m_pending.size(); ++i) {
+        Character& c = m_characters[m_pending[i]];
+        if (PlaceWithGrowth(c)) {
+            c.overflowed = false;
+            continue;
+        }
+        if (c.overflowed) {
+            // Already failed a repack at this size; retry cheaply each
+            // frame instead of repacking every frame.
+            continue;
+        }
+
+        // Fragmented or full at max size: one full repack places
+        // everyone who still fits, then stop. The character that did
+        // not fit goes last, so it cannot evict the others.
+        c.overflowed = true;
+        Repack(m_packer.GetWidth(), m_packer.GetHeight());
+        break;
+    }
+
+    // --- Compact an atlas that has been mostly empty for a while ---
+    const uint64_t atlasArea = static_cast<uint64_t>(m_packer.GetWidth()) * m_packer.GetHeight();
+    const float occupancy = atlasArea > 0
+        ? static_cast<float>(m_packer.GetAllocatedArea()) / static_cast<float>(atlasArea)
+        : 0.0f;
+    const bool aboveInitial = m_packer.GetWidth()  > m_config.initialAtlasSize ||
+                              m_packer.GetHeight() > m_config.initialAtlasSize;
+
+    if (aboveInitial && occupancy < kShrinkOccupancy) {
+        if (++m_lowOccupancyFrames >= m_config.shrinkCheckFrames) {
+            m_lowOccupancyFrames = 0;
+            Repack(m_config.initialAtlasSize, m_config.initialAtlasSize);
+        }
+    } else {
+        m_lowOccupancyFrames = 0;
+    }
+
+    BuildSchedule();
+    return !m_scheduled.empty();
+}
+
+void CharacterScheduler::BuildSchedule() {
+    m_scheduled.clear();
+    uint32_t characters = 0;
+    uint32_t unplaced   = 0;
+
+    for (CharacterId id = 0; id < m_characters.size(); ++id) {
+        Character& c = m_characters[id];
+        c.scheduled = false;
+        if (!c.alive) {
+            continue;
+        }
+        characters++;
+        if (!c.visible) {
+            continue;
+        }
+        if (!c.hasSlot) {
+            unplaced++;
+            if (!c.warnedUnplaced) {
+                c.warnedUnplaced = true;
+                DMME_LOG_WARN("CharacterScheduler: character {} ({}x{}) does not fit "
+                              "in a {}x{} atlas, skipping",
+                              id, c.renderWidth, c.renderHeight,
+                              m_config.maxAtlasSize, m_config.maxAtlasSize);
+            }
+            continue;
+        }
+        c.scheduled = true;
+        m_scheduled.push_back(id);
+    }
+
+    // Atlas order (top to bottom, left to right) keeps the draw and
+    // the resolve walking memory forwards.
+    std::sort(m_scheduled.begin(), m_scheduled.end(), [this](CharacterId a, CharacterId b) {
+        const AtlasRect& ra = m_characters[a].slot;
+        const AtlasRect& rb = m_characters[b].slot;
+        return ra.y != rb.y ? ra.y < rb.y : ra.x < rb.x;
+    });
+
+    const uint64_t atlasArea = static_cast<uint64_t>(m_packer.GetWidth()) * m_packer.GetHeight();
+    m_stats.atlasWidth  = m_packer.GetWidth();
+    m_stats.atlasHeight = m_packer.GetHeight();
+    m_stats.characters  = characters;
+    m_stats.scheduled   = static_cast<uint32_t>(m_scheduled.size());
+    m_stats.unplaced    = unplaced;
+    m_stats.occupancy   = atlasArea > 0
+        ? static_cast<float>(m_packer.GetAllocatedArea()) / static_cast<float>(atlasArea)
+        : 0.0f;
+}
+
+const std::vector<CharacterId>& CharacterScheduler::GetScheduled() const {
+    return m_scheduled;
+}
+
+Viewport CharacterScheduler::GetViewport(CharacterId id) const {
+    Viewport vp;
+    const AtlasRect rect = GetRenderRect(id);
+    vp.x      = static_cast<float>(rect.x);
+    vp.y      = static_cast<float>(rect.y);
+    vp.width  = static_cast<float>(rect.width);
+    vp.height = static_cast<float>(rect.height);
+    return vp;
+}
+
+AtlasRect CharacterScheduler::GetRenderRect(CharacterId id) const {
+    AtlasRect rect;
+    if (!IsValid(id) || !m_characters[id].scheduled) {
+        return rect;
+    }
+    const Character& c = m_characters[id];
+    rect.x      = c.slot.x;
+    rect.y      = c.slot.y;
+    rect.width  = c.renderWidth;
+    rect.height = c.renderHeight;
+    return rect;
+}
+
+// ===================================================================
+// Readback Fan-out
+// ===================================================================
+
+const std::vector<CharacterView>& CharacterScheduler::ResolveViews(const PixelReadback& atlas) {
+    m_views.clear();
+
+    if (!atlas.IsValid() ||
+        atlas.width != m_packer.GetWidth() || atlas.height != m_packer.GetHeight()) {
+        DMME_LOG_WARN("CharacterScheduler::ResolveViews: readback {}x{} does not match atlas {}x{}",
+                      atlas.width, atlas.height, m_packer.GetWidth(), m_packer.GetHeight());
+        return m_views;
+    }
+
+    const int stride = atlas.width * 4;
+    for (CharacterId id : m_scheduled) {
+        const Character& c = m_characters[id];
+        CharacterView view;
+        view.id          = id;
+        view.pixels      = atlas.data.data() +
+                           static_cast<size_t>(c.slot.y) * stride +
+                           static_cast<size_t>(c.slot.x) * 4;
+        view.width       = c.renderWidth;
+        view.height      = c.renderHeight;
+        view.strideBytes = stride;
+        view.frameId     = atlas.frameId;
+        m_views.push_back(view);
+    }
+    return m_views;
+}
+
+// ===================================================================
+// Atlas
+// ===================================================================
+
+int CharacterScheduler::GetAtlasWidth() const {
+    return m_packer.GetWidth();
+}
+
+int CharacterScheduler::GetAtlasHeight() const {
+    return m_packer.GetHeight();
+}
+
+void CharacterScheduler::RequestRepack() {
+    m_repackPending = true;
+}
+
+CharacterSchedulerStats CharacterScheduler::GetStats() const {
+    return m_stats;
+}
+
+// ===================================================================
+// Internal
+// ===================================================================
+
+void CharacterScheduler::UpdateRenderSize(Character& c) const {
+    c.renderWidth  = std::max(1, static_cast<int>(std::lround(c.outputWidth  * m_renderScale)));
+    c.renderHeight = std::max(1, static_cast<int>(std::lround(c.outputHeight * m_renderScale)));
+}
+
+int CharacterScheduler::RoundToGranularity(int v) const {
+    const int g = m_config.slotGranularity;
+    return ((v + g - 1) / g) * g;
+}
+
+bool CharacterScheduler::PlaceCharacter(Character& c) {
+    // Rounded slots give resizes room to breathe; fall back to the
+    // exact size when the rounding alone is what does not fit.
+    const int w = std::min(RoundToGranularity(c.renderWidth),  m_config.maxAtlasSize);
+    const int h = std::min(RoundToGranularity(c.renderHeight), m_config.maxAtlasSize);
+
+    AtlasRect rect;
+    if (!m_packer.Allocate(w, h, rect) &&
+        !m_packer.Allocate(c.renderWidth, c.renderHeight, rect)) {
+        return false;
+    }
+    c.slot    = rect;
+    c.hasSlot = true;
+    return true;
+}
+
+bool CharacterScheduler::PlaceWithGrowth(Character& c) {
+    while (!PlaceCharacter(c)) {
+        if (!GrowAtlas()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CharacterScheduler::GrowAtlas() {
+    const int width  = m_packer.GetWidth();
+    const int height = m_packer.GetHeight();
+    if (width >= m_config.maxAtlasSize && height >= m_config.maxAtlasSize) {
+        return false;
+    }
+
+    // Double the shorter side (height on ties: new shelves go there)
+    int newWidth  = width;
+    int newHeight = height;
+    if (height <= width && height < m_config.maxAtlasSize) {
+        newHeight = std::min(height * 2, m_config.maxAtlasSize);
+    } else {
+        newWidth = std::min(width * 2, m_config.maxAtlasSize);
+    }
+
+    if (!m_packer.Grow(newWidth, newHeight)) {
+        return false;
+    }
+    m_stats.atlasResizes++;
+    DMME_LOG_INFO("CharacterScheduler: atlas grown to {}x{}", newWidth, newHeight);
+    return true;
+}
+
+void CharacterScheduler::Repack(int width, int height) {
+    const int      oldWidth  = m_packer.GetWidth();
+    const int      oldHeight = m_packer.GetHeight();
+    const uint64_t resizes   = m_stats.atlasResizes;
+
+    m_packer.Reset(width, height);
+    m_stats.repacks++;
+
+    // Visible characters only; hidden ones get a slot when shown again
+    m_pending.clear();
+    for (CharacterId id = 0; id < m_characters.size(); ++id) {
+        Character& c = m_characters[id];
+        c.hasSlot = false;
+        c.slot    = AtlasRect{};
+        if (c.alive && c.visible) {
+            m_pending.push_back(id);
+        }
+    }
+
+    std::sort(m_pending.begin(), m_pending.end(), [this](CharacterId a, CharacterId b) {
+        const Character& ca = m_characters[a];
+        const Character& cb = m_characters[b];
+        if (ca.overflowed != cb.overflowed) {
+            return cb.overflowed;
+        }
+        return ca.renderHeight > cb.renderHeight;
+    });
+
+    for (CharacterId id : m_pending) {
+        Character& c = m_characters[id];
+        c.overflowed = !PlaceWithGrowth(c);
+    }
+    m_pending.clear();
+
+    // Count the repack's net size change once, not each doubling
+    m_stats.atlasResizes = resizes;
+    if (m_packer.GetWidth() != oldWidth || m_packer.GetHeight() != oldHeight) {
+        m_stats.atlasResizes++;
+    }
+    DMME_LOG_INFO("CharacterScheduler: repacked {} characters into {}x{}",
+                  m_packer.GetAllocationCount(), m_packer.GetWidth(), m_packer.GetHeight());
+}
+
+void CharacterScheduler::ReleaseSlot(Character& c) {
+    if (!c.hasSlot) {
+        return;
+    }
+    m_packer.Free(c.slot);
+    c.slot    = AtlasRect{};
+    c.hasSlot = false;
+}
+
+bool CharacterScheduler::IsValid(CharacterId id) const {
+    return id < m_characters.size() && m_characters[id].alive;
+}
+
+} // namespace renderer
+} // namespace core
+} // namespace dmme
\ No newline at end of file
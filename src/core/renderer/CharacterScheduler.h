@@ -0,0 +1,181 @@
+#pragma once
+
+#include "RenderTypes.h"
+#include "AtlasPacker.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace dmme {
+namespace core {
+namespace renderer {
+
+using CharacterId = uint32_t;
+constexpr CharacterId kInvalidCharacterId = 0xFFFFFFFFu;
+
+// ------------------------------------------------------------------
+// Configuration / results
+// ------------------------------------------------------------------
+
+struct CharacterSchedulerConfig {
+    int initialAtlasSize  = 1024;   // square, grows by doubling
+    int maxAtlasSize      = 4096;   // clamp to DriverCaps::maxTextureSize
+    int slotGranularity   = 32;     // slot sizes round up to this (hysteresis)
+    int releaseHiddenAfterFrames = 120;   // keep a hidden character's slot this long
+    int shrinkCheckFrames = 300;    // low occupancy this long -> compacting repack
+};
+
+// One character's pixels inside the atlas readback (RGBA, strided).
+// Valid until the next ReadbackFrame.
+struct CharacterView {
+    CharacterId    id          = kInvalidCharacterId;
+    const uint8_t* pixels      = nullptr;   // top-left of the character
+    int            width       = 0;
+    int            height      = 0;
+    int            strideBytes = 0;         // atlas row pitch
+    uint64_t       frameId     = 0;
+};
+
+struct CharacterSchedulerStats {
+    int      atlasWidth       = 0;
+    int      atlasHeight      = 0;
+    uint32_t characters       = 0;
+    uint32_t scheduled        = 0;     // placed in the atlas this frame
+    uint32_t unplaced         = 0;     // visible but did not fit
+    float    occupancy        = 0.0f;  // allocated slot area / atlas area
+    uint64_t slotMoves        = 0;     // single-character re-allocations
+    uint64_t repacks          = 0;     // full repacks
+    uint64_t atlasResizes     = 0;
+};
+
+// CharacterScheduler lets many mascots share one device and one
+// render target. Visible characters get sub-rects (slots) of a shared
+// atlas; the frame renders all of them in one pass with per-character
+// viewports, reads the atlas back once, and ResolveViews() cuts the
+// readback into per-character strided views for their own layered
+// windows.
+//
+// Packing is incremental. A character keeps its slot across frames
+// while its size fits: slot sizes are rounded up to slotGranularity,
+// so small resizes do not move anything. A character that outgrows
+// its slot moves alone. Hidden characters keep their slot for
+// releaseHiddenAfterFrames so blinking windows do not churn the
+// atlas. The atlas grows by doubling when a slot does not fit; a full
+// repack only happens when growth is exhausted, or to compact an
+// atlas that has stayed mostly empty for shrinkCheckFrames.
+// A character that still does not fit after a repack is skipped
+// (warned once) rather than evicting the characters already placed.
+//
+// The scheduler is platform-neutral and does not touch the driver:
+// the caller resizes the surface to GetAtlasWidth/Height and sets the
+// viewports, so it runs with any IGraphicsDriver (including the
+// software driver on headless Linux).
+//
+// Usage (one RenderPipeline at render scale 1.0):
+//   CharacterScheduler scheduler;
+//   CharacterId a = scheduler.AddCharacter(400, 600);
+//   // per frame:
+//   scheduler.BeginFrame();
+//   if (atlas size changed) pipeline.Resize(scheduler.GetAtlasWidth(), scheduler.GetAtlasHeight());
+//   pipeline.BeginFrame(frameId);
+//   for (CharacterId id : scheduler.GetScheduled()) {
+//       driver->SetViewport(scheduler.GetViewport(id));
+//       ...draw character id...
+//   }
+//   pipeline.EndFrame();
+//   for (const CharacterView& v : scheduler.ResolveViews(*pipeline.ReadbackFrame()))
+//       windows[v.id].UpdateFrameScaled(v.pixels, v.width, v.height, v.strideBytes);
+
+class CharacterScheduler {
+public:
+    explicit CharacterScheduler(const CharacterSchedulerConfig& config = {});
+    ~CharacterScheduler() = default;
+
+    CharacterScheduler(const CharacterScheduler&) = delete;
+    CharacterScheduler& operator=(const CharacterScheduler&) = delete;
+
+    // --- Characters ---
+    // Sizes are output (window) pixels; slots hold size * render scale.
+    CharacterId AddCharacter(int outputWidth, int outputHeight);
+    void RemoveCharacter(CharacterId id);
+    void SetCharacterSize(CharacterId id, int outputWidth, int outputHeight);
+    void SetCharacterVisible(CharacterId id, bool visible);
+
+    // Scale applied to every character (0.25 - 1.0). Slots follow on
+    // the next BeginFrame.
+    void  SetRenderScale(float scale);
+    float GetRenderScale() const;
+
+    // --- Frame ---
+
+    // Update slot assignments for this frame. Returns false when no
+    // character is scheduled (nothing to render).
+    bool BeginFrame();
+
+    // Characters placed this frame, in atlas order
+    const std::vector<CharacterId>& GetScheduled() const;
+
+    // Viewport of a scheduled character's render area
+    Viewport GetViewport(CharacterId id) const;
+
+    // Render area of a scheduled character (empty if not scheduled)
+    AtlasRect GetRenderRect(CharacterId id) const;
+
+    // Split one atlas readback into per-character views. The readback
+    // must be GetAtlasWidth x GetAtlasHeight.
+    const std::vector<CharacterView>& ResolveViews(const PixelReadback& atlas);
+
+    // --- Atlas ---
+    int GetAtlasWidth() const;
+    int GetAtlasHeight() const;
+
+    // Force a full repack on the next BeginFrame
+    void RequestRepack();
+
+    CharacterSchedulerStats GetStats() const;
+
+private:
+    struct Character {
+        bool      alive          = false;
+        bool      visible        = true;
+        bool      hasSlot        = false;
+        bool      scheduled      = false;
+        bool      overflowed     = false;  // triggered a failed placement
+        bool      warnedUnplaced = false;
+        int       outputWidth    = 0;
+        int       outputHeight   = 0;
+        int       renderWidth    = 0;      // output * scale
+        int       renderHeight   = 0;
+        int       hiddenFrames   = 0;
+        AtlasRect slot;                    // rounded-up allocation
+    };
+
+    void UpdateRenderSize(Character& c) const;
+    int  RoundToGranularity(int v) const;
+    bool PlaceCharacter(Character& c);
+    bool PlaceWithGrowth(Character& c);
+    bool GrowAtlas();
+    void Repack(int width, int height);
+    void BuildSchedule();
+    void ReleaseSlot(Character& c);
+    bool IsValid(CharacterId id) const;
+
+    CharacterSchedulerConfig m_config;
+    AtlasPacker              m_packer;
+    std::vector<Character>   m_characters;
+    std::vector<CharacterId> m_freeIds;
+    float                    m_renderScale   = 1.0f;
+    bool                     m_repackPending = false;
+    int                      m_lowOccupancyFrames = 0;
+
+    // --- Per-frame results (capacity reused) ---
+    std::vector<CharacterId>   m_scheduled;
+    std::vector<CharacterId>   m_pending;
+    std::vector<CharacterView> m_views;
+
+    CharacterSchedulerStats  m_stats;
+};
+
+} // namespace renderer
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,249 @@
+#include "DecodedTileCache.h"
+#include "BlockCompression.h"
+#include "utils/Clock.h"
+
+#include <algorithm>
+
+namespace dmme {
+namespace core {
+namespace renderer {
+
+// ===================================================================
+// Construction / Budget
+// ===================================================================
+
+DecodedTileCache::DecodedTileCache() {
+    SetBudget(kDefaultTileCacheBudget);
+    m_trimHandler = memory::MemoryAccountant::RegisterTrimHandler(
+        memory::MemoryCategory::Cache, [this](size_t bytesOver) { return Trim(bytesOver); });
+}
+
+DecodedTileCache::~DecodedTileCache() {
+    memory::MemoryAccountant::UnregisterTrimHandler(m_trimHandler);
+}
+
+void DecodedTileCache::SetBudget(uint64_t bytes) {
+    const uint32_t capacity = static_cast<uint32_t>(
+        std::min<uint64_t>(std::max<uint64_t>(bytes / kDecodedTileBytes, 1), kNone - 1));
+    if (capacity < m_slots.size()) {
+        Reset();
+    }
+    m_capacity = capacity;
+    m_budget   = bytes;
+}
+
+// ===================================================================
+// Lookup
+// ===================================================================
+
+uint64_t DecodedTileCache::MakeKey(TextureHandle texture, int tileX, int tileY) {
+    return (static_cast<uint64_t>(texture) << 32) |
+           (static_cast<uint64_t>(static_cast<uint16_t>(tileY)) << 16) |
+           static_cast<uint64_t>(static_cast<uint16_t>(tileX));
+}
+
+const uint8_t* DecodedTileCache::GetTile(TextureHandle texture, TextureFormat format,
+                                         const uint8_t* blocks, int width, int height,
+                                         int tileX, int tileY) {
+    const int x0 = tileX * kDecodedTileSize;
+    const int y0 = tileY * kDecodedTileSize;
+    if (!blocks || !IsBlockCompressed(format) || tileX < 0 || tileY < 0 ||
+        x0 >= width || y0 >= height) {
+        return nullptr;
+    }
+
+    const uint64_t key = MakeKey(texture, tileX, tileY);
+    const auto it = m_lookup.find(key);
+    if (it != m_lookup.end()) {
+        ++m_hits;
+        Unlink(it->second);
+        PushFront(it->second);
+        return m_slots[it->second].texels.data();
+    }
+
+    const uint32_t slot = AcquireSlot();
+    Slot& s = m_slots[slot];
+    s.key = key;
+    m_lookup.emplace(key, slot);
+    PushFront(slot);
+
+    const uint64_t start      = utils::MonotonicMicros();
+    const size_t   blockBytes = GetBlockBytes(format);
+    const size_t   blockPitch = static_cast<size_t>((width + kBlockSize - 1) / kBlockSize) * blockBytes;
+    const uint8_t* src = blocks + static_cast<size_t>(y0 / kBlockSize) * blockPitch
+                                + static_cast<size_t>(x0 / kBlockSize) * blockBytes;
+    const int blocksWide = (std::min(kDecodedTileSize, width  - x0) + kBlockSize - 1) / kBlockSize;
+    const int blocksHigh = (std::min(kDecodedTileSize, height - y0) + kBlockSize - 1) / kBlockSize;
+    DecodeBlocks(format, src, blockPitch, blocksWide, blocksHigh,
+                 s.texels.data(), static_cast<size_t>(kDecodedTileSize) * 4);
+    m_decodeMicros += utils::MonotonicMicros() - start;
+    ++m_misses;
+
+    return s.texels.data();
+}
+
+// ===================================================================
+// Invalidation
+// ===================================================================
+
+void DecodedTileCache::Invalidate(TextureHandle texture, const PixelRegion& region) {
+    if (region.IsEmpty() || m_lookup.empty()) {
+        return;
+    }
+    const int tx0 = std::max(region.x, 0) / kDecodedTileSize;
+    const int ty0 = std::max(region.y, 0) / kDecodedTileSize;
+    const int tx1 = (region.x + region.width  - 1) / kDecodedTileSize;
+    const int ty1 = (region.y + region.height - 1) / kDecodedTileSize;
+    for (int ty = ty0; ty <= ty1; ++ty) {
+        for (int tx = tx0; tx <= tx1; ++tx) {
+            const auto it = m_lookup.find(MakeKey(texture, tx, ty));
+            if (it != m_lookup.end()) {
+                Remove(it->second);
+            }
+        }
+    }
+}
+
+void DecodedTileCache::Invalidate(TextureHandle texture) {
+    for (uint32_t slot = m_head; slot != kNone;) {
+        const uint32_t next = m_slots[slot].next;
+        if ((m_slots[slot].key >> 32) == texture) {
+            Remove(slot);
+        }
+        slot = next;
+    }
+}
+
+void DecodedTileCache::Clear() {
+    while (m_head != kNone) {
+        Remove(m_head);
+    }
+}
+
+void DecodedTileCache::Reset() {
+    m_lookup.clear();
+    m_slots.clear();
+    m_slots.shrink_to_fit();
+    m_free.clear();
+    m_head = kNone;
+    m_tail = kNone;
+    m_memory.Reset();
+}
+
+// ===================================================================
+// Trimming
+// ===================================================================
+
+size_t DecodedTileCache::Trim(size_t bytes) {
+    const uint64_t before = m_memory.GetBytes();
+    if (bytes == 0 || before == 0) {
+        return 0;
+    }
+    const uint64_t tiles = (bytes + kDecodedTileBytes - 1) / kDecodedTileBytes;
+    const uint32_t keep  = static_cast<uint32_t>(
+        std::max<uint64_t>(m_slots.size() > tiles ? m_slots.size() - tiles : 0, 1));
+    if (keep >= m_slots.size()) {
+        return 0;
+    }
+
+    while (m_lookup.size() > keep) {
+        Remove(m_tail);
+        ++m_evictions;
+    }
+
+    // Compact the survivors, most recently used first, and let the
+    // storage of every other slot go
+    std::vector<Slot> kept;
+    kept.reserve(keep);
+    for (uint32_t slot = m_head; slot != kNone; slot = m_slots[slot].next) {
+        kept.push_back(std::move(m_slots[slot]));
+    }
+    m_slots = std::move(kept);
+    m_free.clear();
+    m_lookup.clear();
+    m_head = kNone;
+    m_tail = kNone;
+    for (uint32_t slot = static_cast<uint32_t>(m_slots.size()); slot-- > 0;) {
+        m_lookup.emplace(m_slots[slot].key, slot);
+        PushFront(slot);
+    }
+
+    m_capacity = keep;
+    m_memory.Set(m_slots.size() * kDecodedTileBytes);
+    return static_cast<size_t>(before - m_memory.GetBytes());
+}
+
+// ===================================================================
+// LRU list
+// ===================================================================
+
+void DecodedTileCache::Unlink(uint32_t slot) {
+    Slot& s = m_slots[slot];
+    if (s.prev != kNone) m_slots[s.prev].next = s.next; else m_head = s.next;
+    if (s.next != kNone) m_slots[s.next].prev = s.prev; else m_tail = s.prev;
+    s.prev = kNone;
+    s.next = kNone;
+}
+
+void DecodedTileCache::PushFront(uint32_t slot) {
+    Slot& s = m_slots[slot];
+    s.prev = kNone;
+    s.next = m_head;
+    if (m_head != kNone) m_slots[m_head].prev = slot; else m_tail = slot;
+    m_head = slot;
+}
+
+void DecodedTileCache::Remove(uint32_t slot) {
+    Unlink(slot);
+    m_lookup.erase(m_slots[slot].key);
+    m_free.push_back(slot);
+}
+
+uint32_t DecodedTileCache::AcquireSlot() {
+    if (!m_free.empty()) {
+        const uint32_t slot = m_free.back();
+        m_free.pop_back();
+        return slot;
+    }
+    if (m_slots.size() < m_capacity) {
+        // Moving a vector keeps its buffer, so earlier tiles stay put
+        m_slots.emplace_back();
+        m_slots.back().texels.resize(kDecodedTileBytes);
+        m_memory.Set(m_slots.size() * kDecodedTileBytes);
+        return static_cast<uint32_t>(m_slots.size() - 1);
+    }
+
+    const uint32_t victim = m_tail;
+    Unlink(victim);
+    m_lookup.erase(m_slots[victim].key);
+    ++m_evictions;
+    return victim;
+}
+
+// ===================================================================
+// Stats
+// ===================================================================
+
+DecodedTileStats DecodedTileCache::GetStats() const {
+    DecodedTileStats stats;
+    stats.hits          = m_hits;
+    stats.misses        = m_misses;
+    stats.evictions     = m_evictions;
+    stats.residentTiles = static_cast<uint32_t>(m_lookup.size());
+    stats.capacityTiles = m_capacity;
+    stats.residentBytes = m_memory.GetBytes();
+    stats.budgetBytes   = m_budget;
+    stats.decodeMs      = utils::MicrosToMs(m_decodeMicros);
+    return stats;
+}
+
+void DecodedTileCache::ResetStats() {
+    m_hits         = 0;
+    m_misses       = 0;
+    m_evictions    = 0;
+    m_decodeMicros = 0;
+}
+
+} // namespace renderer
+} // namespace core
+} // namespace dmme
\ No newline at end of file
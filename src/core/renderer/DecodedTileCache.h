@@ -0,0 +1,130 @@
+#pragma once
+
+#include "RenderTypes.h"
+#include "core/memory/MemoryAccountant.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace dmme {
+namespace core {
+namespace renderer {
+
+// Decoded tiles are kDecodedTileSize x kDecodedTileSize RGBA8 texels
+// (16 KiB), a whole number of 4x4 blocks
+constexpr int      kDecodedTileSize        = 64;
+constexpr uint64_t kDecodedTileBytes       = static_cast<uint64_t>(kDecodedTileSize) * kDecodedTileSize * 4;
+constexpr uint64_t kDefaultTileCacheBudget = 16ull * 1024 * 1024;
+
+struct DecodedTileStats {
+    uint64_t hits          = 0;
+    uint64_t misses        = 0;   // tiles decoded
+    uint64_t evictions     = 0;
+    uint32_t residentTiles = 0;
+    uint32_t capacityTiles = 0;
+    uint64_t residentBytes = 0;   // tile storage allocated
+    uint64_t budgetBytes   = 0;
+    float    decodeMs      = 0.0f;   // total time spent decoding misses
+};
+
+// DecodedTileCache keeps RGBA8 decodes of block-compressed textures
+// for the software path, one tile at a time, within a byte budget.
+//
+// A CPU rasterizer only touches the parts of an atlas it samples, so
+// tiles are decoded on first use and the least recently used tile is
+// recycled once the budget is full; the compressed blocks stay the
+// only full copy of the texture. Tiles are invalidated by texture
+// updates and dropped with their texture. Tile storage is allocated
+// once per slot and reused.
+//
+// The storage is reported as MemoryCategory::Cache, and the cache
+// registers a trim handler for that category: when the category is
+// over its MemoryAccountant budget, Trim evicts least recently used
+// tiles, frees their storage and lowers the capacity to match, so
+// the cache does not grow straight back. SetBudget restores it.
+//
+// Render thread only, like the driver that owns it; MemoryAccountant::
+// EnforceBudgets must run on that thread too (the main loop calls it
+// between frames).
+//
+// Usage:
+//   const uint8_t* texels = cache.GetTile(texture, TextureFormat::BC7_UNORM,
+//                                         blocks, width, height, x / 64, y / 64);
+//   const uint8_t* texel  = texels + ((y % 64) * kDecodedTileSize + x % 64) * 4;
+
+class DecodedTileCache {
+public:
+    DecodedTileCache();
+    ~DecodedTileCache();
+
+    DecodedTileCache(const DecodedTileCache&) = delete;
+    DecodedTileCache& operator=(const DecodedTileCache&) = delete;
+
+    // Holds at least one tile. Shrinking drops every tile.
+    void     SetBudget(uint64_t bytes);
+    uint64_t GetBudget() const { return m_budget; }
+
+    // Decoded tile (tileX, tileY) of a width x height texture whose
+    // blocks start at blocks (tightly packed block rows). Rows are
+    // kDecodedTileSize * 4 bytes apart; edge tiles only fill the part
+    // inside the texture. Valid until the next GetTile, Invalidate,
+    // Clear or SetBudget. nullptr for a tile outside the texture or a
+    // format that is not block-compressed.
+    const uint8_t* GetTile(TextureHandle texture, TextureFormat format, const uint8_t* blocks,
+                           int width, int height, int tileX, int tileY);
+
+    // Drop the tiles overlapping region (texels), or all of the texture's
+    void Invalidate(TextureHandle texture, const PixelRegion& region);
+    void Invalidate(TextureHandle texture);
+
+    void Clear();
+
+    // Clear and free the tile storage (driver shutdown)
+    void Reset();
+
+    // Free at least bytes of tile storage, least recently used tiles
+    // first, and cap the capacity at what is left (at least one tile).
+    // Returns the bytes freed. Invalidates GetTile pointers.
+    size_t Trim(size_t bytes);
+
+    DecodedTileStats GetStats() const;
+    void             ResetStats();
+
+private:
+    static constexpr uint32_t kNone = 0xFFFFFFFFu;
+
+    struct Slot {
+        uint64_t             key  = 0;
+        uint32_t             prev = kNone;   // towards most recently used
+        uint32_t             next = kNone;   // towards least recently used
+        std::vector<uint8_t> texels;
+    };
+
+    static uint64_t MakeKey(TextureHandle texture, int tileX, int tileY);
+
+    void     Unlink(uint32_t slot);
+    void     PushFront(uint32_t slot);
+    void     Remove(uint32_t slot);
+    uint32_t AcquireSlot();
+
+    std::vector<Slot>                      m_slots;
+    std::vector<uint32_t>                  m_free;
+    std::unordered_map<uint64_t, uint32_t> m_lookup;
+    uint32_t m_head     = kNone;
+    uint32_t m_tail     = kNone;
+    uint32_t m_capacity = 0;
+    uint64_t m_budget   = 0;
+
+    uint64_t m_hits         = 0;
+    uint64_t m_misses       = 0;
+    uint64_t m_evictions    = 0;
+    uint64_t m_decodeMicros = 0;
+
+    memory::TrackedMemory                   m_memory{memory::MemoryCategory::Cache};
+    memory::MemoryAccountant::TrimHandlerId m_trimHandler = 0;
+};
+
+} // namespace renderer
+} // namespace core
+} // namespace dmme
\ No newline at end of file
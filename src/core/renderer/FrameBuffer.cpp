@@ -160,7 +160,7 @@ int FrameBuffer::GetHeight() const {
     return m_height;
 }
 
-std::string FrameBuffer::GetName() const {
+const std::string& FrameBuffer::GetName() const {
     return m_name;
 }
 
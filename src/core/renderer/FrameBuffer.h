@@ -56,7 +56,7 @@ public:
     bool        IsCreated() const;
     int         GetWidth() const;
     int         GetHeight() const;
-    std::string GetName() const;
+    const std::string& GetName() const;
 
 private:
     IGraphicsDriver*  m_driver   = nullptr;
@@ -1,6 +1,9 @@
 #include "GPUSurface.h"
 #include "utils/Logger.h"
 
+#include <array>
+#include <cstdint>
+
 namespace dmme {
 namespace core {
 namespace renderer {
@@ -60,6 +63,8 @@ bool GPUSurface::Create(IGraphicsDriver* driver, const RenderTargetDesc& desc) {
 
     // Pre-allocate readback buffer
     m_readback.Allocate(m_width, m_height);
+    m_readbackMemory.Set(m_readback.data.capacity());
+    m_readbackHoldsFrame = false;
 
     m_created = true;
     DMME_LOG_INFO("GPUSurface created: {}x{} format={} samples={} depth={}",
@@ -97,6 +102,8 @@ bool GPUSurface::Resize(int width, int height) {
     m_width  = width;
     m_height = height;
     m_readback.Allocate(m_width, m_height);
+    m_readbackMemory.Set(m_readback.data.capacity());
+    m_readbackHoldsFrame = false;
 
     return true;
 }
@@ -116,8 +123,10 @@ void GPUSurface::Destroy() {
 
     m_readback.data.clear();
     m_readback.data.shrink_to_fit();
+    m_readbackMemory.Reset();
     m_readback.width  = 0;
     m_readback.height = 0;
+    m_readbackHoldsFrame = false;
     m_created  = false;
     m_driver   = nullptr;
     m_width    = 0;
@@ -128,7 +137,7 @@ void GPUSurface::Destroy() {
 // Read Pixels
 // ===================================================================
 
-const PixelReadback* GPUSurface::ReadPixels() {
+const PixelReadback* GPUSurface::ReadPixels(uint64_t frameId) {
     if (!m_created || !m_driver) {
         DMME_LOG_ERROR("GPUSurface::ReadPixels: surface not created");
         return nullptr;
@@ -136,9 +145,83 @@ const PixelReadback* GPUSurface::ReadPixels() {
 
     if (!m_driver->ReadbackPixels(m_readback)) {
         DMME_LOG_ERROR("GPUSurface::ReadPixels: driver readback failed");
+        m_readbackHoldsFrame = false;
+        return nullptr;
+    }
+    m_readbackHoldsFrame = true;
+
+    m_readback.frameId = frameId;
+
+    // The driver may have resized the buffer to its own target size
+    m_readbackMemory.Set(m_readback.data.capacity());
+
+    return &m_readback;
+}
+
+const PixelReadback* GPUSurface::ReadPixels(uint64_t frameId,
+                                            const PixelRegion* regions, uint32_t regionCount) {
+    if (!m_created || !m_driver) {
+        DMME_LOG_ERROR("GPUSurface::ReadPixels: surface not created");
         return nullptr;
     }
 
+    // Clip, then fold into at most kMaxReadbackRegions by merging the
+    // pair whose union grows the least.
+    std::array<PixelRegion, kMaxReadbackRegions + 1> merged{};
+    uint32_t count = 0;
+    uint64_t area  = 0;
+
+    for (uint32_t i = 0; i < regionCount; ++i) {
+        const PixelRegion r = ClipRegion(regions[i], m_width, m_height);
+        if (r.IsEmpty()) {
+            continue;
+        }
+        merged[count++] = r;
+        if (count <= kMaxReadbackRegions) {
+            continue;
+        }
+
+        // Overlapping pairs have negative growth and merge first
+        uint32_t bestA = 0;
+        uint32_t bestB = 1;
+        int64_t  bestGrowth = INT64_MAX;
+        for (uint32_t a = 0; a < count; ++a) {
+            for (uint32_t b = a + 1; b < count; ++b) {
+                const int64_t growth =
+                    static_cast<int64_t>(UnionRegion(merged[a], merged[b]).Area()) -
+                    static_cast<int64_t>(merged[a].Area()) -
+                    static_cast<int64_t>(merged[b].Area());
+                if (growth < bestGrowth) {
+                    bestGrowth = growth;
+                    bestA = a;
+                    bestB = b;
+                }
+            }
+        }
+        merged[bestA] = UnionRegion(merged[bestA], merged[bestB]);
+        merged[bestB] = merged[--count];
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        area += merged[i].Area();
+    }
+
+    // Nothing to patch yet, or mostly everything anyway (one full copy
+    // is cheaper than many partial rows)
+    const uint64_t surfaceArea = static_cast<uint64_t>(m_width) * static_cast<uint64_t>(m_height);
+    if (!m_readbackHoldsFrame || area * 4 >= surfaceArea * 3) {
+        return ReadPixels(frameId);
+    }
+
+    if (!m_driver->ReadbackRegions(m_readback, merged.data(), count)) {
+        DMME_LOG_ERROR("GPUSurface::ReadPixels: driver region readback failed");
+        m_readbackHoldsFrame = false;
+        return nullptr;
+    }
+
+    m_readback.frameId = frameId;
+    m_readbackMemory.Set(m_readback.data.capacity());
+
     return &m_readback;
 }
 
@@ -2,6 +2,7 @@
 
 #include "RenderTypes.h"
 #include "drivers/DriverInterface.h"
+#include "core/memory/MemoryAccountant.h"
 
 #include <memory>
 
@@ -21,6 +22,7 @@ namespace renderer {
 //   1. Create(driver, desc)   -- allocate render target via driver
 //   2. Resize(w, h)           -- resize when window changes
 //   3. ReadPixels()           -- get RGBA pixel data after render
+//                                (optionally only some regions)
 //   4. Destroy()              -- release resources
 
 class GPUSurface {
@@ -42,9 +44,21 @@ public:
     void Destroy();
 
     // Read rendered pixels from GPU to CPU.
+    // frameId is stamped on the result so the frame can be tracked
+    // through conversion and present.
     // Returns pointer to internal PixelReadback. Valid until next
     // ReadPixels() or Destroy() call.
-    const PixelReadback* ReadPixels();
+    const PixelReadback* ReadPixels(uint64_t frameId = 0);
+
+    // Read only the given regions (opaque bounds, damage rects). The
+    // rest of the returned buffer keeps the previous frame's pixels,
+    // so the caller must cover everything that changed since then.
+    // Regions are clipped; more than kMaxReadbackRegions are merged;
+    // if they cover most of the surface, or there is no previous
+    // frame of this size, a full readback is done instead (see
+    // PixelReadback::regionCount).
+    const PixelReadback* ReadPixels(uint64_t frameId,
+                                    const PixelRegion* regions, uint32_t regionCount);
 
     // --- Queries ---
     bool IsCreated() const;
@@ -62,6 +76,8 @@ private:
     int               m_samples    = 1;
     bool              m_hasDepth   = true;
     PixelReadback     m_readback;
+    bool              m_readbackHoldsFrame = false;   // region readback can patch it
+    memory::TrackedMemory m_readbackMemory{memory::MemoryCategory::Readback};
 };
 
 } // namespace renderer
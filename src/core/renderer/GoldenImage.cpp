@@ -0,0 +1,304 @@
+#include "GoldenImage.h"
+#include "utils/Logger.h"
+#include "utils/Simd.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+
+namespace dmme {
+namespace core {
+namespace renderer {
+
+namespace {
+
+constexpr size_t  kTgaHeaderSize   = 18;
+constexpr uint8_t kTgaTrueColor    = 2;       // uncompressed true-colour
+constexpr uint8_t kTgaTopLeft      = 0x20;    // image descriptor: origin bit
+constexpr uint8_t kTgaAlphaBits    = 0x08;
+
+// Largest per-channel delta between two 4-byte pixels
+inline int PixelDelta(const uint8_t* a, const uint8_t* b) {
+    int delta = 0;
+    for (int c = 0; c < 4; ++c) {
+        delta = std::max(delta, std::abs(static_cast<int>(a[c]) - static_cast<int>(b[c])));
+    }
+    return delta;
+}
+
+// Diff image pixel: red for mismatches, dimmed grey of actual otherwise
+inline void WriteDiffPixel(uint8_t* out, const uint8_t* actual, int delta, bool mismatch) {
+    if (mismatch) {
+        out[0] = static_cast<uint8_t>(std::min(255, 128 + delta / 2));
+        out[1] = 0;
+        out[2] = 0;
+    } else {
+        const uint8_t grey = static_cast<uint8_t>((actual[0] + actual[1] + actual[2]) / 12);
+        out[0] = grey;
+        out[1] = grey;
+        out[2] = grey;
+    }
+    out[3] = 255;
+}
+
+// Scalar comparison of count pixels starting at column x
+void ComparePixels(const uint8_t* a, const uint8_t* b, int x, int y, int count,
+                   int tolerance, ImageDiff& diff, uint8_t* diffRow) {
+    for (int i = 0; i < count; ++i) {
+        const int px    = x + i;
+        const int delta = PixelDelta(a + px * 4, b + px * 4);
+        const bool mismatch = delta > tolerance;
+
+        diff.maxChannelDelta = std::max(diff.maxChannelDelta, delta);
+        if (mismatch) {
+            if (diff.mismatchedPixels == 0) {
+                diff.minX = diff.maxX = px;
+                diff.minY = diff.maxY = y;
+            } else {
+                diff.minX = std::min(diff.minX, px);
+                diff.maxX = std::max(diff.maxX, px);
+                diff.maxY = y;
+            }
+            diff.mismatchedPixels++;
+        }
+        if (diffRow) {
+            WriteDiffPixel(diffRow + px * 4, a + px * 4, delta, mismatch);
+        }
+    }
+}
+
+// "dir/frame.tga" -> "dir/frame<suffix>.tga"
+std::string SiblingPath(const std::string& goldenPath, const char* suffix) {
+    const std::string ext = ".tga";
+    std::string stem = goldenPath;
+    if (stem.size() > ext.size() &&
+        stem.compare(stem.size() - ext.size(), ext.size(), ext) == 0) {
+        stem.resize(stem.size() - ext.size());
+    }
+    return stem + suffix + ext;
+}
+
+} // anonymous namespace
+
+// ===================================================================
+// Comparison
+// ===================================================================
+
+ImageDiff CompareImages(const ImageView& actual, const ImageView& expected,
+                        int tolerance, Image* diffImage) {
+    ImageDiff diff;
+    if (!actual.IsValid() || !expected.IsValid() ||
+        actual.width != expected.width || actual.height != expected.height) {
+        diff.sizeMismatch = true;
+        return diff;
+    }
+
+    const int w = actual.width;
+    const int h = actual.height;
+    tolerance = std::clamp(tolerance, 0, 255);
+
+    if (diffImage) {
+        diffImage->width  = w;
+        diffImage->height = h;
+        diffImage->order  = PixelOrder::RGBA;
+        diffImage->data.assign(static_cast<size_t>(w) * h * 4, 0);
+    }
+
+#if defined(DMME_SIMD_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i tol  = _mm_set1_epi8(static_cast<char>(tolerance));
+    __m128i maxDelta   = zero;
+#endif
+
+    for (int y = 0; y < h; ++y) {
+        const uint8_t* a = actual.pixels   + static_cast<size_t>(y) * actual.RowPitch();
+        const uint8_t* b = expected.pixels + static_cast<size_t>(y) * expected.RowPitch();
+        uint8_t* diffRow = diffImage
+            ? diffImage->data.data() + static_cast<size_t>(y) * w * 4
+            : nullptr;
+        int x = 0;
+
+#if defined(DMME_SIMD_SSE2)
+        for (; x + 4 <= w; x += 4) {
+            const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + x * 4));
+            const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + x * 4));
+            const __m128i d  = _mm_or_si128(_mm_subs_epu8(va, vb), _mm_subs_epu8(vb, va));
+            maxDelta = _mm_max_epu8(maxDelta, d);
+
+            // Bytes above tolerance are non-zero after a saturating
+            // subtract; a pixel passes when its whole dword is zero.
+            const __m128i over = _mm_subs_epu8(d, tol);
+            const int passMask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(over, zero)));
+            if (passMask == 0xF && !diffRow) {
+                continue;
+            }
+            ComparePixels(a, b, x, y, 4, tolerance, diff, diffRow);
+        }
+#endif
+
+        ComparePixels(a, b, x, y, w - x, tolerance, diff, diffRow);
+    }
+
+#if defined(DMME_SIMD_SSE2)
+    alignas(16) uint8_t lanes[16];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), maxDelta);
+    for (uint8_t lane : lanes) {
+        diff.maxChannelDelta = std::max(diff.maxChannelDelta, static_cast<int>(lane));
+    }
+#endif
+
+    diff.comparedPixels = static_cast<uint64_t>(w) * h;
+    return diff;
+}
+
+// ===================================================================
+// TGA I/O
+// ===================================================================
+
+bool WriteTGA(const std::string& path, const ImageView& image) {
+    if (!image.IsValid() || image.width > 0xFFFF || image.height > 0xFFFF) {
+        DMME_LOG_ERROR("WriteTGA: invalid image {}x{}", image.width, image.height);
+        return false;
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        DMME_LOG_ERROR("WriteTGA: cannot open {}", path);
+        return false;
+    }
+
+    uint8_t header[kTgaHeaderSize] = {};
+    header[2]  = kTgaTrueColor;
+    header[12] = static_cast<uint8_t>(image.width & 0xFF);
+    header[13] = static_cast<uint8_t>(image.width >> 8);
+    header[14] = static_cast<uint8_t>(image.height & 0xFF);
+    header[15] = static_cast<uint8_t>(image.height >> 8);
+    header[16] = 32;
+    header[17] = kTgaTopLeft | kTgaAlphaBits;
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+    // TGA stores BGRA
+    std::vector<uint8_t> row(static_cast<size_t>(image.width) * 4);
+    for (int y = 0; y < image.height; ++y) {
+        const uint8_t* src = image.pixels + static_cast<size_t>(y) * image.RowPitch();
+        if (image.order == PixelOrder::BGRA) {
+            std::copy(src, src + row.size(), row.begin());
+        } else {
+            for (int x = 0; x < image.width; ++x) {
+                row[x * 4 + 0] = src[x * 4 + 2];
+                row[x * 4 + 1] = src[x * 4 + 1];
+                row[x * 4 + 2] = src[x * 4 + 0];
+                row[x * 4 + 3] = src[x * 4 + 3];
+            }
+        }
+        file.write(reinterpret_cast<const char*>(row.data()),
+                   static_cast<std::streamsize>(row.size()));
+    }
+
+    if (!file) {
+        DMME_LOG_ERROR("WriteTGA: write failed for {}", path);
+        return false;
+    }
+    return true;
+}
+
+bool ReadTGA(const std::string& path, Image& out, PixelOrder order) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    uint8_t header[kTgaHeaderSize] = {};
+    if (!file.read(reinterpret_cast<char*>(header), sizeof(header))) {
+        DMME_LOG_ERROR("ReadTGA: {} is truncated", path);
+        return false;
+    }
+
+    const int width  = header[12] | (header[13] << 8);
+    const int height = header[14] | (header[15] << 8);
+    if (header[1] != 0 || header[2] != kTgaTrueColor || header[16] != 32 ||
+        width == 0 || height == 0) {
+        DMME_LOG_ERROR("ReadTGA: {} is not an uncompressed 32-bit TGA", path);
+        return false;
+    }
+    file.seekg(static_cast<std::streamoff>(kTgaHeaderSize + header[0]));
+
+    out.width  = width;
+    out.height = height;
+    out.order  = order;
+    out.data.resize(static_cast<size_t>(width) * height * 4);
+
+    const bool topLeft = (header[17] & kTgaTopLeft) != 0;
+    const size_t pitch = static_cast<size_t>(width) * 4;
+    for (int row = 0; row < height; ++row) {
+        const int y = topLeft ? row : height - 1 - row;
+        uint8_t* dst = out.data.data() + static_cast<size_t>(y) * pitch;
+        if (!file.read(reinterpret_cast<char*>(dst), static_cast<std::streamsize>(pitch))) {
+            DMME_LOG_ERROR("ReadTGA: {} is truncated", path);
+            return false;
+        }
+        if (order == PixelOrder::RGBA) {
+            for (int x = 0; x < width; ++x) {
+                std::swap(dst[x * 4 + 0], dst[x * 4 + 2]);
+            }
+        }
+    }
+    return true;
+}
+
+// ===================================================================
+// Golden Images
+// ===================================================================
+
+GoldenResult CheckGolden(const ImageView& actual, const std::string& goldenPath,
+                         int tolerance, uint64_t maxMismatchedPixels, GoldenMode mode) {
+    GoldenResult result;
+
+    if (mode == GoldenMode::Update) {
+        result.passed = WriteTGA(goldenPath, actual);
+        if (result.passed) {
+            DMME_LOG_INFO("Golden image updated: {}", goldenPath);
+        }
+        return result;
+    }
+
+    Image reference;
+    if (!ReadTGA(goldenPath, reference, actual.order)) {
+        result.missing = true;
+        WriteTGA(SiblingPath(goldenPath, ".actual"), actual);
+        DMME_LOG_ERROR("Golden image missing: {} (actual written next to it)", goldenPath);
+        return result;
+    }
+
+    result.diff = CompareImages(actual, reference.View(), tolerance);
+    result.passed = !result.diff.sizeMismatch &&
+                    result.diff.mismatchedPixels <= maxMismatchedPixels;
+    if (result.passed) {
+        return result;
+    }
+
+    // Failure: redo the comparison with a diff image for inspection
+    Image diffImage;
+    if (!result.diff.sizeMismatch) {
+        CompareImages(actual, reference.View(), tolerance, &diffImage);
+        WriteTGA(SiblingPath(goldenPath, ".diff"), diffImage.View());
+    }
+    WriteTGA(SiblingPath(goldenPath, ".actual"), actual);
+
+    if (result.diff.sizeMismatch) {
+        DMME_LOG_ERROR("Golden image {}: size {}x{} vs reference {}x{}", goldenPath,
+                       actual.width, actual.height, reference.width, reference.height);
+    } else {
+        DMME_LOG_ERROR("Golden image {}: {} of {} pixels differ by more than {} "
+                       "(max delta {}, bounds {},{} - {},{})",
+                       goldenPath, result.diff.mismatchedPixels, result.diff.comparedPixels,
+                       tolerance, result.diff.maxChannelDelta,
+                       result.diff.minX, result.diff.minY, result.diff.maxX, result.diff.maxY);
+    }
+    return result;
+}
+
+} // namespace renderer
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace dmme {
+namespace core {
+namespace renderer {
+
+// ------------------------------------------------------------------
+// Image views
+// ------------------------------------------------------------------
+
+// Byte order of a 4-byte pixel. Comparison does not care; it only
+// decides how a TGA file is written and read back.
+enum class PixelOrder : uint8_t {
+    RGBA,   // renderer readback
+    BGRA,   // layered window back buffer
+};
+
+// Non-owning view of 8-bit, 4-channel pixels
+struct ImageView {
+    const uint8_t* pixels      = nullptr;
+    int            width       = 0;
+    int            height      = 0;
+    int            strideBytes = 0;        // 0 = width * 4
+    PixelOrder     order       = PixelOrder::RGBA;
+
+    int RowPitch() const { return strideBytes > 0 ? strideBytes : width * 4; }
+    bool IsValid() const { return pixels && width > 0 && height > 0; }
+};
+
+// Owned, tightly packed image (TGA load result, diff image)
+struct Image {
+    std::vector<uint8_t> data;
+    int        width  = 0;
+    int        height = 0;
+    PixelOrder order  = PixelOrder::RGBA;
+
+    ImageView View() const { return {data.data(), width, height, 0, order}; }
+};
+
+// ------------------------------------------------------------------
+// Comparison
+// ------------------------------------------------------------------
+
+struct ImageDiff {
+    uint64_t comparedPixels   = 0;
+    uint64_t mismatchedPixels = 0;      // any channel off by > tolerance
+    int      maxChannelDelta  = 0;
+    // Bounding box of mismatched pixels (valid if mismatchedPixels > 0)
+    int      minX = 0, minY = 0, maxX = 0, maxY = 0;
+    bool     sizeMismatch     = false;
+};
+
+// Per-channel absolute difference against a tolerance. Runs 4 pixels
+// per step with SSE2; blocks with no mismatch never leave the vector
+// path. If diffImage is given it receives a same-size RGBA image:
+// mismatches in red (brighter = larger delta), everything else as a
+// dimmed grey of the actual image.
+ImageDiff CompareImages(const ImageView& actual, const ImageView& expected,
+                        int tolerance, Image* diffImage = nullptr);
+
+// ------------------------------------------------------------------
+// TGA I/O (uncompressed 32-bit, top-left origin)
+// ------------------------------------------------------------------
+
+bool WriteTGA(const std::string& path, const ImageView& image);
+
+// Reads uncompressed 32-bit TGA (either origin) into order
+bool ReadTGA(const std::string& path, Image& out, PixelOrder order = PixelOrder::RGBA);
+
+// ------------------------------------------------------------------
+// Golden images
+// ------------------------------------------------------------------
+
+enum class GoldenMode : uint8_t {
+    Compare,    // fail on mismatch or missing reference
+    Update,     // (re)write the reference, always passes
+};
+
+struct GoldenResult {
+    bool      passed  = false;
+    bool      missing = false;     // no reference on disk
+    ImageDiff diff;
+};
+
+// Compare actual against the reference at goldenPath. A pixel fails
+// when any channel differs by more than tolerance; the check fails
+// when more than maxMismatchedPixels fail. On failure the actual
+// image and a diff image are written next to the reference
+// ("frame.tga" -> "frame.actual.tga", "frame.diff.tga").
+GoldenResult CheckGolden(const ImageView& actual, const std::string& goldenPath,
+                         int tolerance, uint64_t maxMismatchedPixels = 0,
+                         GoldenMode mode = GoldenMode::Compare);
+
+} // namespace renderer
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,373 @@
+#include "ProceduralFace.h"
+#include "core/jobs/JobSystem.h"
+#include "utils/Simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace dmme {
+namespace core {
+namespace renderer {
+
+namespace {
+
+// Shader constants (kept in the same float form as the HLSL so the
+// CPU and GPU paths agree to the last bit where the math allows)
+constexpr float kBaseRadius   = 0.35f;
+constexpr float kSoftEdge     = 0.03f;
+constexpr float kEyeX         = 0.08f;
+constexpr float kEyeY         = -0.04f;
+constexpr float kEyeRadius    = 0.03f;
+constexpr float kPupilY       = -0.045f;
+constexpr float kPupilRadius  = 0.012f;
+constexpr float kMouthTop     = 0.04f;
+constexpr float kMouthBottom  = 0.07f;
+constexpr float kMouthHalfW   = 0.06f;
+constexpr float kMouthMix     = 0.8f;
+constexpr float kBlushX       = 0.12f;
+constexpr float kBlushY       = 0.02f;
+constexpr float kBlushRadius  = 0.035f;
+constexpr float kBlushKeep    = 0.7f;
+constexpr float kBlushMix     = 0.3f;
+
+constexpr float kSkin[3]  = {0.94f, 0.78f, 0.71f};
+constexpr float kEye[3]   = {0.15f, 0.15f, 0.25f};
+constexpr float kPupil[3] = {0.9f, 0.9f, 1.0f};
+constexpr float kMouth[3] = {0.85f, 0.35f, 0.4f};
+constexpr float kBlush[3] = {1.0f, 0.6f, 0.6f};
+
+// Per-frame shader inputs
+struct FaceFrame {
+    float texW;
+    float texH;
+    float aspect;
+    float radius;
+};
+
+FaceFrame MakeFrame(int width, int height, float elapsed) {
+    FaceFrame f;
+    f.texW   = static_cast<float>(width);
+    f.texH   = static_cast<float>(height);
+    f.aspect = f.texW / f.texH;
+    f.radius = kBaseRadius * (0.9f + 0.1f * std::sin(elapsed * 1.5f));
+    return f;
+}
+
+inline float Length(float x, float y) {
+    return std::sqrt(x * x + y * y);
+}
+
+// UNORM store of one blended channel: src + dst * (1 - a)
+inline uint8_t BlendChannel(float src, uint8_t dst, float invAlpha) {
+    const float v = std::min(std::max(src + (dst / 255.0f) * invAlpha, 0.0f), 1.0f);
+    return static_cast<uint8_t>(static_cast<int>(v * 255.0f + 0.5f));
+}
+
+// -------------------------------------------------------------------
+// Scalar shader (one pixel)
+// -------------------------------------------------------------------
+
+// Returns false when the pixel is outside the face (output zero)
+bool ShadePixel(const FaceFrame& f, int x, int y, float out[4]) {
+    const float uvx = (static_cast<float>(x) + 0.5f) / f.texW;
+    const float uvy = (static_cast<float>(y) + 0.5f) / f.texH;
+    const float dx  = (uvx - 0.5f) * f.aspect;
+    const float dy  = uvy - 0.5f;
+
+    const float dist = Length(dx, dy);
+    if (dist > f.radius) {
+        return false;
+    }
+
+    const float edge = f.radius - dist;
+    const float soft = edge < kSoftEdge ? edge / kSoftEdge : 1.0f;
+
+    float color[3] = {kSkin[0], kSkin[1], kSkin[2]};
+    float alpha = soft;
+
+    // Eyes
+    if (Length(dx + kEyeX, dy - kEyeY) < kEyeRadius ||
+        Length(dx - kEyeX, dy - kEyeY) < kEyeRadius) {
+        color[0] = kEye[0]; color[1] = kEye[1]; color[2] = kEye[2];
+        alpha = 1.0f;
+    }
+
+    // Pupils
+    if (Length(dx + kEyeX, dy - kPupilY) < kPupilRadius ||
+        Length(dx - kEyeX, dy - kPupilY) < kPupilRadius) {
+        color[0] = kPupil[0]; color[1] = kPupil[1]; color[2] = kPupil[2];
+    }
+
+    // Mouth
+    if (dy > kMouthTop && dy < kMouthBottom) {
+        const float mx = std::fabs(dx);
+        if (mx < kMouthHalfW) {
+            const float t = 1.0f - (mx / kMouthHalfW);
+            for (int c = 0; c < 3; ++c) {
+                color[c] = color[c] * (1.0f - t * kMouthMix) + kMouth[c] * (t * kMouthMix);
+            }
+        }
+    }
+
+    // Blush
+    if (Length(dx + kBlushX, dy - kBlushY) < kBlushRadius ||
+        Length(dx - kBlushX, dy - kBlushY) < kBlushRadius) {
+        for (int c = 0; c < 3; ++c) {
+            color[c] = color[c] * kBlushKeep + kBlush[c] * kBlushMix;
+        }
+    }
+
+    out[0] = color[0] * alpha;
+    out[1] = color[1] * alpha;
+    out[2] = color[2] * alpha;
+    out[3] = alpha;
+    return true;
+}
+
+void ShadeSpanScalar(const FaceFrame& f, uint8_t* row, int y, int x0, int x1) {
+    for (int x = x0; x < x1; ++x) {
+        float src[4];
+        if (!ShadePixel(f, x, y, src)) {
+            continue;
+        }
+        uint8_t* p = row + static_cast<size_t>(x) * 4;
+        const float inv = 1.0f - src[3];
+        for (int c = 0; c < 4; ++c) {
+            p[c] = BlendChannel(src[c], p[c], inv);
+        }
+    }
+}
+
+// -------------------------------------------------------------------
+// SSE2 shader (four pixels)
+// -------------------------------------------------------------------
+
+#if defined(DMME_SIMD_SSE2)
+
+inline __m128 Select(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+inline __m128 Length4(__m128 x, float y) {
+    const __m128 yy = _mm_set1_ps(y * y);
+    return _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(x, x), yy));
+}
+
+inline __m128 BlendChannel4(__m128 src, __m128i dstPixels, int shift, __m128 invAlpha) {
+    const __m128i byte = _mm_and_si128(_mm_srli_epi32(dstPixels, shift), _mm_set1_epi32(0xFF));
+    const __m128  dst  = _mm_div_ps(_mm_cvtepi32_ps(byte), _mm_set1_ps(255.0f));
+    __m128 v = _mm_add_ps(src, _mm_mul_ps(dst, invAlpha));
+    v = _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    return _mm_add_ps(_mm_mul_ps(v, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f));
+}
+
+// Shade [x0, x1) of row y; x1 - x0 is a multiple of 4
+void ShadeSpanSse2(const FaceFrame& f, uint8_t* row, int y, int x0, int x1) {
+    // Row constants (same expressions as the scalar path)
+    const float uvy = (static_cast<float>(y) + 0.5f) / f.texH;
+    const float dy  = uvy - 0.5f;
+
+    const bool inMouthRows = dy > kMouthTop && dy < kMouthBottom;
+
+    const __m128 texW   = _mm_set1_ps(f.texW);
+    const __m128 half   = _mm_set1_ps(0.5f);
+    const __m128 aspect = _mm_set1_ps(f.aspect);
+    const __m128 radius = _mm_set1_ps(f.radius);
+    const __m128 one    = _mm_set1_ps(1.0f);
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 laneOffsets = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+
+    for (int x = x0; x < x1; x += 4) {
+        const __m128 px  = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffsets);
+        const __m128 uvx = _mm_div_ps(px, texW);
+        const __m128 dx  = _mm_mul_ps(_mm_sub_ps(uvx, half), aspect);
+
+        const __m128 dist   = Length4(dx, dy);
+        const __m128 inside = _mm_cmple_ps(dist, radius);
+        if (_mm_movemask_ps(inside) == 0) {
+            continue;   // all four outside: blend leaves the target unchanged
+        }
+
+        const __m128 edge = _mm_sub_ps(radius, dist);
+        const __m128 soft = Select(_mm_cmplt_ps(edge, _mm_set1_ps(kSoftEdge)),
+                                   _mm_div_ps(edge, _mm_set1_ps(kSoftEdge)), one);
+
+        __m128 r = _mm_set1_ps(kSkin[0]);
+        __m128 g = _mm_set1_ps(kSkin[1]);
+        __m128 b = _mm_set1_ps(kSkin[2]);
+        __m128 a = soft;
+
+        // Eyes
+        const __m128 eyeRadius = _mm_set1_ps(kEyeRadius);
+        const __m128 eye = _mm_or_ps(
+            _mm_cmplt_ps(Length4(_mm_add_ps(dx, _mm_set1_ps(kEyeX)), dy - kEyeY), eyeRadius),
+            _mm_cmplt_ps(Length4(_mm_sub_ps(dx, _mm_set1_ps(kEyeX)), dy - kEyeY), eyeRadius));
+        r = Select(eye, _mm_set1_ps(kEye[0]), r);
+        g = Select(eye, _mm_set1_ps(kEye[1]), g);
+        b = Select(eye, _mm_set1_ps(kEye[2]), b);
+        a = Select(eye, one, a);
+
+        // Pupils
+        const __m128 pupilRadius = _mm_set1_ps(kPupilRadius);
+        const __m128 pupil = _mm_or_ps(
+            _mm_cmplt_ps(Length4(_mm_add_ps(dx, _mm_set1_ps(kEyeX)), dy - kPupilY), pupilRadius),
+            _mm_cmplt_ps(Length4(_mm_sub_ps(dx, _mm_set1_ps(kEyeX)), dy - kPupilY), pupilRadius));
+        r = Select(pupil, _mm_set1_ps(kPupil[0]), r);
+        g = Select(pupil, _mm_set1_ps(kPupil[1]), g);
+        b = Select(pupil, _mm_set1_ps(kPupil[2]), b);
+
+        // Mouth
+        if (inMouthRows) {
+            const __m128 mx    = _mm_and_ps(dx, absMask);
+            const __m128 mouth = _mm_cmplt_ps(mx, _mm_set1_ps(kMouthHalfW));
+            const __m128 t     = _mm_sub_ps(one, _mm_div_ps(mx, _mm_set1_ps(kMouthHalfW)));
+            const __m128 keep  = _mm_sub_ps(one, _mm_mul_ps(t, _mm_set1_ps(kMouthMix)));
+            const __m128 mix   = _mm_mul_ps(t, _mm_set1_ps(kMouthMix));
+            r = Select(mouth, _mm_add_ps(_mm_mul_ps(r, keep), _mm_mul_ps(_mm_set1_ps(kMouth[0]), mix)), r);
+            g = Select(mouth, _mm_add_ps(_mm_mul_ps(g, keep), _mm_mul_ps(_mm_set1_ps(kMouth[1]), mix)), g);
+            b = Select(mouth, _mm_add_ps(_mm_mul_ps(b, keep), _mm_mul_ps(_mm_set1_ps(kMouth[2]), mix)), b);
+        }
+
+        // Blush
+        const __m128 blushRadius = _mm_set1_ps(kBlushRadius);
+        const __m128 blush = _mm_or_ps(
+            _mm_cmplt_ps(Length4(_mm_add_ps(dx, _mm_set1_ps(kBlushX)), dy - kBlushY), blushRadius),
+            _mm_cmplt_ps(Length4(_mm_sub_ps(dx, _mm_set1_ps(kBlushX)), dy - kBlushY), blushRadius));
+        const __m128 blushKeep = _mm_set1_ps(kBlushKeep);
+        const __m128 blushMix  = _mm_set1_ps(kBlushMix);
+        r = Select(blush, _mm_add_ps(_mm_mul_ps(r, blushKeep), _mm_mul_ps(_mm_set1_ps(kBlush[0]), blushMix)), r);
+        g = Select(blush, _mm_add_ps(_mm_mul_ps(g, blushKeep), _mm_mul_ps(_mm_set1_ps(kBlush[1]), blushMix)), g);
+        b = Select(blush, _mm_add_ps(_mm_mul_ps(b, blushKeep), _mm_mul_ps(_mm_set1_ps(kBlush[2]), blushMix)), b);
+
+        // Outside lanes contribute nothing (premultiplied zero)
+        a = _mm_and_ps(inside, a);
+        r = _mm_and_ps(inside, _mm_mul_ps(r, a));
+        g = _mm_and_ps(inside, _mm_mul_ps(g, a));
+        b = _mm_and_ps(inside, _mm_mul_ps(b, a));
+
+        // Blend over the target and store UNORM
+        uint8_t* p = row + static_cast<size_t>(x) * 4;
+        const __m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128  inv = _mm_sub_ps(one, a);
+
+        const __m128i r8 = _mm_cvttps_epi32(BlendChannel4(r, dst, 0,  inv));
+        const __m128i g8 = _mm_cvttps_epi32(BlendChannel4(g, dst, 8,  inv));
+        const __m128i b8 = _mm_cvttps_epi32(BlendChannel4(b, dst, 16, inv));
+        const __m128i a8 = _mm_cvttps_epi32(BlendChannel4(a, dst, 24, inv));
+
+        const __m128i packed = _mm_or_si128(
+            _mm_or_si128(r8, _mm_slli_epi32(g8, 8)),
+            _mm_or_si128(_mm_slli_epi32(b8, 16), _mm_slli_epi32(a8, 24)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), packed);
+    }
+}
+
+#endif // DMME_SIMD_SSE2
+
+} // anonymous namespace
+
+// ===================================================================
+// Construction
+// ===================================================================
+
+ProceduralFaceRasterizer::ProceduralFaceRasterizer(jobs::JobSystem* jobs)
+    : m_jobs(jobs)
+{
+}
+
+ProceduralFaceStats ProceduralFaceRasterizer::GetStats() const {
+    return m_stats;
+}
+
+// ===================================================================
+// Draw
+// ===================================================================
+
+void ProceduralFaceRasterizer::Draw(uint8_t* rgba, int width, int height, int strideBytes,
+                                    float elapsed) {
+    m_stats = {};
+    if (!rgba || width <= 0 || height <= 0) {
+        return;
+    }
+
+    const FaceFrame f = MakeFrame(width, height, elapsed);
+    const PixelRegion bounds = ComputeBounds(width, height, elapsed);
+    if (bounds.IsEmpty()) {
+        return;
+    }
+
+    // x0 is aligned so SIMD groups start on 4 pixels
+    const int x0 = bounds.x & ~3;
+    const int y0 = bounds.y;
+    const int x1 = bounds.x + bounds.width;
+    const int y1 = bounds.y + bounds.height;
+
+    const int tilesX = (x1 - x0 + kTileSize - 1) / kTileSize;
+    const int tilesY = (y1 - y0 + kTileSize - 1) / kTileSize;
+    const uint32_t tileCount = static_cast<uint32_t>(tilesX * tilesY);
+
+    auto shadeTile = [&](uint32_t tile) {
+        const int tx0 = x0 + static_cast<int>(tile % static_cast<uint32_t>(tilesX)) * kTileSize;
+        const int ty0 = y0 + static_cast<int>(tile / static_cast<uint32_t>(tilesX)) * kTileSize;
+        const int tx1 = std::min(tx0 + kTileSize, x1);
+        const int ty1 = std::min(ty0 + kTileSize, y1);
+
+        for (int y = ty0; y < ty1; ++y) {
+            uint8_t* row = rgba + static_cast<size_t>(y) * strideBytes;
+            int x = tx0;
+#if defined(DMME_SIMD_SSE2)
+            const int simdEnd = tx0 + ((tx1 - tx0) & ~3);
+            ShadeSpanSse2(f, row, y, tx0, simdEnd);
+            x = simdEnd;
+#endif
+            ShadeSpanScalar(f, row, y, x, tx1);
+        }
+    };
+
+    if (m_jobs) {
+        m_jobs->ParallelFor(tileCount, shadeTile);
+    } else {
+        for (uint32_t tile = 0; tile < tileCount; ++tile) {
+            shadeTile(tile);
+        }
+    }
+
+    m_stats.tiles        = tileCount;
+    m_stats.pixelsShaded = static_cast<uint64_t>(x1 - x0) * (y1 - y0);
+}
+
+PixelRegion ProceduralFaceRasterizer::ComputeBounds(int width, int height, float elapsed) {
+    if (width <= 0 || height <= 0) {
+        return {};
+    }
+    const FaceFrame f = MakeFrame(width, height, elapsed);
+
+    // The circle is round in pixels: radius * texH on both axes
+    // (uv.x is scaled by the aspect ratio). Pad by a pixel for rounding.
+    const float cx = f.texW * 0.5f;
+    const float cy = f.texH * 0.5f;
+    const float r  = f.radius * f.texH + 1.0f;
+
+    PixelRegion bounds;
+    bounds.x      = static_cast<int>(std::floor(cx - r));
+    bounds.y      = static_cast<int>(std::floor(cy - r));
+    bounds.width  = static_cast<int>(std::ceil(cx + r)) + 1 - bounds.x;
+    bounds.height = static_cast<int>(std::ceil(cy + r)) + 1 - bounds.y;
+    return ClipRegion(bounds, width, height);
+}
+
+void ProceduralFaceRasterizer::DrawReference(uint8_t* rgba, int width, int height,
+                                             int strideBytes, float elapsed) {
+    if (!rgba || width <= 0 || height <= 0) {
+        return;
+    }
+    const FaceFrame f = MakeFrame(width, height, elapsed);
+    for (int y = 0; y < height; ++y) {
+        ShadeSpanScalar(f, rgba + static_cast<size_t>(y) * strideBytes, y, 0, width);
+    }
+}
+
+} // namespace renderer
+} // namespace core
+} // namespace dmme
\ No newline at end of file
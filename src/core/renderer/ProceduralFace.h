@@ -0,0 +1,76 @@
+#pragma once
+
+#include "RenderTypes.h"
+
+#include <cstdint>
+
+namespace dmme {
+namespace core {
+
+namespace jobs {
+class JobSystem;
+}
+
+namespace renderer {
+
+// ------------------------------------------------------------------
+// Procedural Face (CPU)
+// ------------------------------------------------------------------
+
+// CPU port of the procedural mascot pixel shader (circle, eyes,
+// pupils, mouth, blush, soft edge) for the software driver.
+//
+// Output matches the shader: premultiplied RGBA, composited over the
+// target with the same ONE / INV_SRC_ALPHA blend the DX11 path uses,
+// and UNORM rounding on store.
+//
+// Only the circle's bounding box is touched (everything outside the
+// circle shades to zero, which the blend leaves unchanged). The box
+// is cut into tiles that run on a JobSystem; each tile shades four
+// pixels per step with SSE2 (scalar elsewhere) and skips whole
+// groups that lie outside the circle.
+//
+// Usage:
+//   ProceduralFaceRasterizer face(&jobs);
+//   face.Draw(softwareDriver->GetTargetPixels(), width, height, width * 4, elapsed);
+
+struct ProceduralFaceStats {
+    uint32_t tiles         = 0;     // tiles dispatched by the last Draw
+    uint64_t pixelsShaded  = 0;     // pixels inside the bounding box
+};
+
+class ProceduralFaceRasterizer {
+public:
+    // jobs may be null (single-threaded)
+    explicit ProceduralFaceRasterizer(jobs::JobSystem* jobs = nullptr);
+    ~ProceduralFaceRasterizer() = default;
+
+    ProceduralFaceRasterizer(const ProceduralFaceRasterizer&) = delete;
+    ProceduralFaceRasterizer& operator=(const ProceduralFaceRasterizer&) = delete;
+
+    // Shade one frame into an RGBA8 target (strideBytes row pitch)
+    void Draw(uint8_t* rgba, int width, int height, int strideBytes, float elapsed);
+
+    // Pixels the face can touch at this time (the circle's bounding
+    // box, padded by a pixel). Everything outside stays transparent,
+    // on the GPU path too, so this doubles as the readback region.
+    static PixelRegion ComputeBounds(int width, int height, float elapsed);
+
+    // Straight scalar port of the shader over the whole target. Slow;
+    // this is the reference the fast path is checked against.
+    static void DrawReference(uint8_t* rgba, int width, int height, int strideBytes,
+                              float elapsed);
+
+    // Tile edge in pixels (multiple of 4)
+    static constexpr int kTileSize = 64;
+
+    ProceduralFaceStats GetStats() const;
+
+private:
+    jobs::JobSystem*    m_jobs = nullptr;
+    ProceduralFaceStats m_stats;
+};
+
+} // namespace renderer
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -1,10 +1,15 @@
 #include "RenderPipeline.h"
-#include "drivers/DX11Driver.h"
 #include "drivers/OpenGLDriver.h"
 #include "utils/Logger.h"
+#include "core/memory/AllocationTracker.h"
+#include "core/memory/MemoryAccountant.h"
 
 #include <algorithm>
+
+#if defined(_WIN32)
+#include "drivers/DX11Driver.h"
 #include <Windows.h>
+#endif
 
 namespace dmme {
 namespace core {
@@ -33,13 +38,16 @@ RenderPipeline::~RenderPipeline() {
 void RenderPipeline::RegisterDrivers() {
     // Priority: lower number = tried first
     // DX11 is our primary driver for Windows
-    // OpenGL is the software fallback
+    // OpenGL is the software fallback (and the only driver in
+    // headless non-Windows builds)
 
+#if defined(_WIN32)
     m_driverRegistry.push_back({
         GraphicsAPI::DX11,
         &CreateDX11Driver,
         10
     });
+#endif
 
     m_driverRegistry.push_back({
         GraphicsAPI::OpenGL,
@@ -73,23 +81,36 @@ bool RenderPipeline::Initialize(HWND hwnd, const RenderConfig& config) {
     DMME_LOG_INFO("  Target size: {}x{}", config.targetWidth, config.targetHeight);
     DMME_LOG_INFO("  Debug layer: {}", config.enableDebugLayer ? "enabled" : "disabled");
 
-    m_config = config;
+    m_config       = config;
+    m_renderScale  = std::clamp(config.renderScale, 0.25f, 1.0f);
+    m_outputWidth  = config.targetWidth;
+    m_outputHeight = config.targetHeight;
 
     if (!SelectAndInitDriver(hwnd, config)) {
         DMME_LOG_CRITICAL("RenderPipeline: no suitable GPU driver found");
         return false;
     }
 
+    memory::FrameArenaConfig arenaConfig;
+    arenaConfig.mainBytes = config.frameArenaBytes;
+    if (!m_frameArena.Initialize(arenaConfig)) {
+        DMME_LOG_CRITICAL("RenderPipeline: failed to allocate frame arena");
+        m_driver->Shutdown();
+        m_driver.reset();
+        return false;
+    }
+
     // Create primary render surface
     RenderTargetDesc surfaceDesc;
-    surfaceDesc.width    = config.targetWidth;
-    surfaceDesc.height   = config.targetHeight;
+    surfaceDesc.width    = ScaledDimension(config.targetWidth);
+    surfaceDesc.height   = ScaledDimension(config.targetHeight);
     surfaceDesc.format   = TextureFormat::RGBA8_UNORM;
     surfaceDesc.hasDepth = true;
     surfaceDesc.samples  = 1;  // No MSAA initially
 
     if (!m_surface.Create(m_driver.get(), surfaceDesc)) {
         DMME_LOG_CRITICAL("RenderPipeline: failed to create primary surface");
+        m_frameArena.Shutdown();
         m_driver->Shutdown();
         m_driver.reset();
         return false;
@@ -103,9 +124,14 @@ bool RenderPipeline::Initialize(HWND hwnd, const RenderConfig& config) {
     
     // Convert wstring to UTF-8 string for logging
     const auto& wdesc = m_driver->GetAdapterInfo().description;
+#if defined(_WIN32)
     int size_needed = WideCharToMultiByte(CP_UTF8, 0, wdesc.c_str(), -1, NULL, 0, NULL, NULL);
     std::string desc(size_needed - 1, 0);
     WideCharToMultiByte(CP_UTF8, 0, wdesc.c_str(), -1, &desc[0], size_needed, NULL, NULL);
+#else
+    // Headless builds only have the software driver (ASCII name)
+    std::string desc(wdesc.begin(), wdesc.end());
+#endif
     DMME_LOG_INFO("  GPU: {}", desc);
 
     return true;
@@ -189,6 +215,7 @@ void RenderPipeline::Shutdown() {
     }
 
     m_surface.Destroy();
+    m_frameArena.Shutdown();
 
     if (m_driver) {
         m_driver->Shutdown();
@@ -207,7 +234,7 @@ bool RenderPipeline::IsInitialized() const {
 // Frame Lifecycle
 // ===================================================================
 
-bool RenderPipeline::BeginFrame() {
+bool RenderPipeline::BeginFrame(uint64_t frameId) {
     if (!m_initialized || !m_driver) {
         return false;
     }
@@ -217,7 +244,14 @@ bool RenderPipeline::BeginFrame() {
         return false;
     }
 
+    memory::AllocationScope allocScope(memory::AllocSubsystem::Renderer);
+    m_frameAllocStart = memory::AllocationTracker::GetThreadCounters();
+
+    // O(1): flips arena generations; last frame's data stays readable
+    m_frameArena.BeginFrame();
+
     m_frameStart = std::chrono::high_resolution_clock::now();
+    m_frameId    = (frameId != 0) ? frameId : m_frameId + 1;
 
     if (!m_driver->BeginFrame()) {
         DMME_LOG_ERROR("Driver BeginFrame failed");
@@ -251,6 +285,8 @@ bool RenderPipeline::EndFrame() {
         return false;
     }
 
+    memory::AllocationScope allocScope(memory::AllocSubsystem::Renderer);
+
     if (!m_driver->EndFrame()) {
         DMME_LOG_ERROR("Driver EndFrame failed");
         m_frameActive = false;
@@ -274,6 +310,11 @@ bool RenderPipeline::EndFrame() {
 // ===================================================================
 
 const PixelReadback* RenderPipeline::ReadbackFrame() {
+    return ReadbackFrame(nullptr, 0);
+}
+
+const PixelReadback* RenderPipeline::ReadbackFrame(const PixelRegion* regions,
+                                                   uint32_t regionCount) {
     if (!m_initialized) {
         DMME_LOG_ERROR("ReadbackFrame: pipeline not initialized");
         return nullptr;
@@ -284,7 +325,31 @@ const PixelReadback* RenderPipeline::ReadbackFrame() {
         return nullptr;
     }
 
-    return m_surface.ReadPixels();
+    memory::AllocationScope allocScope(memory::AllocSubsystem::Renderer);
+    const PixelReadback* pixels = regions
+        ? m_surface.ReadPixels(m_frameId, regions, regionCount)
+        : m_surface.ReadPixels(m_frameId);
+
+    const memory::AllocationCounters allocs =
+        memory::AllocationTracker::GetThreadCounters().Since(m_frameAllocStart);
+    m_lastStats.heapAllocations = allocs.allocations;
+    m_lastStats.heapAllocBytes  = allocs.bytes;
+    m_lastStats.frameArenaBytes = m_frameArena.GetUsedBytes();
+    m_lastStats.vramUsedBytes   = memory::MemoryAccountant::GetDomainBytes(memory::MemoryDomain::Gpu);
+    m_lastStats.trackedCpuBytes = memory::MemoryAccountant::GetDomainBytes(memory::MemoryDomain::Cpu);
+
+    m_lastStats.readbackBytes = 0;
+    if (pixels) {
+        if (pixels->IsFullFrame()) {
+            m_lastStats.readbackBytes = pixels->data.size();
+        } else {
+            for (uint32_t i = 0; i < pixels->regionCount; ++i) {
+                m_lastStats.readbackBytes += pixels->regions[i].Area() * 4;
+            }
+        }
+    }
+
+    return pixels;
 }
 
 // ===================================================================
@@ -299,7 +364,63 @@ bool RenderPipeline::Resize(int width, int height) {
         return false;
     }
 
-    return m_surface.Resize(width, height);
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+
+    m_outputWidth  = width;
+    m_outputHeight = height;
+    return m_surface.Resize(ScaledDimension(width), ScaledDimension(height));
+}
+
+// ===================================================================
+// Render Scale
+// ===================================================================
+
+bool RenderPipeline::SetRenderScale(float scale) {
+    scale = std::clamp(scale, 0.25f, 1.0f);
+    if (scale == m_renderScale) return true;
+
+    if (!m_initialized) {
+        m_renderScale = scale;
+        return true;
+    }
+
+    if (m_frameActive) {
+        DMME_LOG_WARN("SetRenderScale called during active frame, ignoring");
+        return false;
+    }
+
+    const float previous = m_renderScale;
+    m_renderScale = scale;
+
+    if (!m_surface.Resize(ScaledDimension(m_outputWidth),
+                          ScaledDimension(m_outputHeight))) {
+        m_renderScale = previous;
+        return false;
+    }
+
+    DMME_LOG_INFO("Render scale {:.2f} -> {:.2f} ({}x{} for {}x{} output)",
+                  previous, scale, m_surface.GetWidth(), m_surface.GetHeight(),
+                  m_outputWidth, m_outputHeight);
+    return true;
+}
+
+float RenderPipeline::GetRenderScale() const {
+    return m_renderScale;
+}
+
+int RenderPipeline::GetOutputWidth() const {
+    return m_outputWidth;
+}
+
+int RenderPipeline::GetOutputHeight() const {
+    return m_outputHeight;
+}
+
+int RenderPipeline::ScaledDimension(int output) const {
+    int scaled = static_cast<int>(static_cast<float>(output) * m_renderScale + 0.5f);
+    return std::max(scaled, 1);
 }
 
 // ===================================================================
@@ -314,6 +435,10 @@ GPUSurface* RenderPipeline::GetSurface() {
     return &m_surface;
 }
 
+memory::FrameArena& RenderPipeline::GetFrameArena() {
+    return m_frameArena;
+}
+
 FrameStats RenderPipeline::GetFrameStats() const {
     return m_lastStats;
 }
@@ -337,6 +462,10 @@ float RenderPipeline::GetCPUFrameTimeMs() const {
     return m_cpuFrameTimeMs;
 }
 
+uint64_t RenderPipeline::GetCurrentFrameId() const {
+    return m_frameId;
+}
+
 } // namespace renderer
 } // namespace core
 } // namespace dmme
\ No newline at end of file
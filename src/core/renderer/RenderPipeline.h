@@ -4,6 +4,8 @@
 #include "GPUSurface.h"
 #include "FrameBuffer.h"
 #include "drivers/DriverInterface.h"
+#include "core/memory/AllocationTracker.h"
+#include "core/memory/FrameArena.h"
 
 #include <memory>
 #include <vector>
@@ -25,6 +27,7 @@ namespace renderer {
 //   2. Driver lifecycle: init, shutdown
 //   3. Primary render surface: create, resize
 //   4. Frame lifecycle: BeginFrame -> [render commands] -> EndFrame
+//      (BeginFrame also resets the per-frame arena)
 //   5. Pixel readback: GPU -> CPU for layered window compositing
 //   6. Frame timing and statistics
 //
@@ -37,10 +40,10 @@ namespace renderer {
 //   RenderPipeline pipeline;
 //   pipeline.Initialize(hwnd, config);
 //   // per frame:
-//   pipeline.BeginFrame();
+//   pipeline.BeginFrame(frameId);
 //   // ... issue draw calls via pipeline.GetDriver() ...
 //   pipeline.EndFrame();
-//   auto* pixels = pipeline.ReadbackFrame();
+//   auto* pixels = pipeline.ReadbackFrame();   // pixels->frameId == frameId
 //   window.UpdateFrame(pixels->data.data(), pixels->width, pixels->height);
 
 class RenderPipeline {
@@ -66,7 +69,10 @@ public:
     // --- Frame Lifecycle ---
 
     // Begin a new frame. Clears the render target.
-    bool BeginFrame();
+    // frameId identifies the frame for latency tracking; it is stamped
+    // on the PixelReadback returned by ReadbackFrame(). Pass 0 to let
+    // the pipeline number frames itself.
+    bool BeginFrame(uint64_t frameId = 0);
 
     // End the frame. Finalizes GPU work.
     bool EndFrame();
@@ -76,11 +82,31 @@ public:
     // ReadbackFrame or Shutdown call).
     const PixelReadback* ReadbackFrame();
 
+    // Read back only the given regions (e.g. the union of this and
+    // the previous frame's opaque bounds). Pixels outside them keep
+    // the previous readback's contents; see GPUSurface::ReadPixels.
+    const PixelReadback* ReadbackFrame(const PixelRegion* regions, uint32_t regionCount);
+
     // --- Resize ---
 
     // Resize the render target. Call when window size changes.
+    // width/height are the OUTPUT size; the surface itself is
+    // output size * render scale.
     bool Resize(int width, int height);
 
+    // --- Render Scale ---
+
+    // Render at a fraction of the output size (0.25 - 1.0) to save
+    // GPU time and readback bandwidth. The presenter upscales.
+    // Takes effect immediately (resizes the surface); must not be
+    // called during an active frame.
+    bool  SetRenderScale(float scale);
+    float GetRenderScale() const;
+
+    // Output (window) size the surface is scaled from.
+    int GetOutputWidth() const;
+    int GetOutputHeight() const;
+
     // --- Queries ---
 
     // Get the active driver interface for issuing draw commands.
@@ -104,10 +130,21 @@ public:
     // Get CPU-side frame time in milliseconds.
     float GetCPUFrameTimeMs() const;
 
+    // ID of the frame most recently begun.
+    uint64_t GetCurrentFrameId() const;
+
+    // Per-frame transient memory. Reset (generation flip) at the start
+    // of every BeginFrame; allocations live for the current and the
+    // next frame.
+    memory::FrameArena& GetFrameArena();
+
 private:
     // Driver selection: try drivers in priority order
     bool SelectAndInitDriver(HWND hwnd, const RenderConfig& config);
 
+    // Output size * render scale, at least 1x1
+    int ScaledDimension(int output) const;
+
     // Registered driver factories
     struct DriverEntry {
         GraphicsAPI      api;
@@ -123,6 +160,12 @@ private:
     RenderConfig                      m_config;
     bool                              m_initialized = false;
     bool                              m_frameActive = false;
+    uint64_t                          m_frameId     = 0;
+
+    // --- Render Scale ---
+    float m_renderScale  = 1.0f;
+    int   m_outputWidth  = 0;
+    int   m_outputHeight = 0;
 
     std::vector<DriverEntry>          m_driverRegistry;
 
@@ -130,6 +173,12 @@ private:
     std::chrono::high_resolution_clock::time_point m_frameStart;
     float m_cpuFrameTimeMs = 0.0f;
 
+    // --- Per-frame transient memory ---
+    memory::FrameArena m_frameArena;
+
+    // --- Allocation tracking (BeginFrame .. ReadbackFrame) ---
+    memory::AllocationCounters m_frameAllocStart;
+
     // --- Stats ---
     FrameStats m_lastStats;
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -52,7 +53,10 @@ enum class TextureFormat : uint8_t {
     RGBA8_UNORM  = 0,   // 8 bits per channel, normalized
     RGBA16_FLOAT = 1,   // 16 bits per channel, floating point
     DEPTH24_STENCIL8 = 2,
-    DEPTH32_FLOAT    = 3
+    DEPTH32_FLOAT    = 3,
+    BC1_UNORM    = 4,   // 4x4 blocks of 8 bytes: RGB + 1-bit alpha
+    BC3_UNORM    = 5,   // 4x4 blocks of 16 bytes: RGB + interpolated alpha
+    BC7_UNORM    = 6    // 4x4 blocks of 16 bytes: high-quality RGBA
 };
 
 struct RenderTargetDesc {
@@ -97,7 +101,27 @@ struct FrameStats {
     float    gpuTimeMs        = 0.0f;
     int      drawCalls        = 0;
     int      trianglesRendered = 0;
-    size_t   vramUsedBytes    = 0;
+    size_t   vramUsedBytes    = 0;    // GPU categories of the MemoryAccountant
+
+    // Render-thread heap allocations from BeginFrame through
+    // ReadbackFrame. Always 0 unless built with DMME_ALLOC_TRACKING.
+    uint64_t heapAllocations  = 0;
+    uint64_t heapAllocBytes   = 0;
+
+    // Frame arena bytes used by this frame (main + worker sub-arenas)
+    size_t   frameArenaBytes  = 0;
+
+    // Resident CPU buffers reported to the MemoryAccountant (readback,
+    // DIB sections, driver buffers, arenas, caches)
+    size_t   trackedCpuBytes  = 0;
+
+    // Pixel bytes copied by the last ReadbackFrame (less than the
+    // surface size when only regions were read back)
+    uint64_t readbackBytes    = 0;
+
+    // Texture bytes staged and copied to the GPU by this frame's
+    // upload pump (capped by the upload budget)
+    uint64_t uploadBytes      = 0;
 };
 
 // ------------------------------------------------------------------
@@ -116,24 +140,81 @@ struct DriverCaps {
     std::string  driverVersion;
 };
 
+// ------------------------------------------------------------------
+// Pixel Region (readback ROI, damage rect)
+// ------------------------------------------------------------------
+
+// Sub-rectangle of the render target in pixels, top-left origin
+struct PixelRegion {
+    int x      = 0;
+    int y      = 0;
+    int width  = 0;
+    int height = 0;
+
+    bool IsEmpty() const { return width <= 0 || height <= 0; }
+    uint64_t Area() const {
+        return IsEmpty() ? 0 : static_cast<uint64_t>(width) * static_cast<uint64_t>(height);
+    }
+};
+
+// Smallest region containing both (empty inputs are ignored)
+inline PixelRegion UnionRegion(const PixelRegion& a, const PixelRegion& b) {
+    if (a.IsEmpty()) return b;
+    if (b.IsEmpty()) return a;
+    const int x0 = std::min(a.x, b.x);
+    const int y0 = std::min(a.y, b.y);
+    const int x1 = std::max(a.x + a.width,  b.x + b.width);
+    const int y1 = std::max(a.y + a.height, b.y + b.height);
+    return {x0, y0, x1 - x0, y1 - y0};
+}
+
+// Region clipped to a width x height target (may become empty)
+inline PixelRegion ClipRegion(const PixelRegion& r, int width, int height) {
+    const int x0 = std::max(r.x, 0);
+    const int y0 = std::max(r.y, 0);
+    const int x1 = std::min(r.x + r.width,  width);
+    const int y1 = std::min(r.y + r.height, height);
+    if (x1 <= x0 || y1 <= y0) return {};
+    return {x0, y0, x1 - x0, y1 - y0};
+}
+
 // ------------------------------------------------------------------
 // Pixel Readback Buffer
 // ------------------------------------------------------------------
 
+// Regions a single readback can carry. More are merged into their
+// bounding box by GPUSurface before they reach the driver.
+constexpr uint32_t kMaxReadbackRegions = 8;
+
 struct PixelReadback {
     std::vector<uint8_t> data;   // RGBA 8-bit per channel
     int width  = 0;
     int height = 0;
+    uint64_t frameId = 0;        // pipeline frame these pixels belong to
+
+    // Region readback: data always has the full width x height layout,
+    // but only these regions were refreshed by the last readback; the
+    // rest still holds earlier frames' pixels. regionCount == 0 means
+    // the whole buffer was refreshed.
+    std::array<PixelRegion, kMaxReadbackRegions> regions{};
+    uint32_t regionCount = 0;
+
+    bool IsFullFrame() const { return regionCount == 0; }
 
     bool IsValid() const {
         return !data.empty() && width > 0 && height > 0 &&
                data.size() == static_cast<size_t>(width) * height * 4;
     }
 
+    // Sizes the buffer for w x h. Only reallocates when the size
+    // changes, so per-frame calls are allocation-free.
     void Allocate(int w, int h) {
+        const size_t bytes = static_cast<size_t>(w) * h * 4;
         width  = w;
         height = h;
-        data.resize(static_cast<size_t>(w) * h * 4, 0);
+        if (data.size() != bytes) {
+            data.assign(bytes, 0);
+        }
     }
 
     void Clear() {
@@ -141,6 +222,34 @@ struct PixelReadback {
     }
 };
 
+// ------------------------------------------------------------------
+// Textures and Uploads
+// ------------------------------------------------------------------
+
+using TextureHandle = uint32_t;
+constexpr TextureHandle kInvalidTexture = 0;
+
+struct TextureDesc {
+    int           width  = 0;
+    int           height = 0;
+    TextureFormat format = TextureFormat::RGBA8_UNORM;   // RGBA8 or BC1 / BC3 / BC7
+};
+
+// Identifies one queued texture update; 0 means the update was rejected
+using UploadTicket = uint64_t;
+constexpr UploadTicket kInvalidUploadTicket = 0;
+
+struct UploadStats {
+    uint64_t budgetBytes      = 0;   // per frame
+    uint64_t frameBytes       = 0;   // copied by the last pump
+    uint64_t pendingBytes     = 0;   // queued, not yet copied
+    uint32_t pendingUploads   = 0;
+    uint32_t slotsInFlight    = 0;   // ring slots the GPU may still be reading
+    uint64_t totalBytes       = 0;
+    uint64_t completedUploads = 0;
+    uint64_t ringStalls       = 0;   // pumps cut short because no slot was free
+};
+
 // ------------------------------------------------------------------
 // Render Pipeline Configuration
 // ------------------------------------------------------------------
@@ -151,6 +260,10 @@ struct RenderConfig {
     bool        enableVSync      = false;  // We use off-screen, no vsync needed
     int         targetWidth      = 512;
     int         targetHeight     = 512;
+    float       renderScale      = 1.0f;   // surface = target size * scale
+    size_t      frameArenaBytes  = 1 << 20; // per-frame transient memory (x2, double-buffered)
+    size_t      uploadBudgetBytes = 4 << 20; // texture upload bytes per frame; larger uploads span frames
+    size_t      tileCacheBudgetBytes = 16 << 20; // software driver: decoded BC texture tiles
     ClearColor  clearColor       = {0.0f, 0.0f, 0.0f, 0.0f};  // transparent black
 };
 
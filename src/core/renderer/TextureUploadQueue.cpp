@@ -0,0 +1,201 @@
+#include "TextureUploadQueue.h"
+#include "BlockCompression.h"
+#include "utils/Logger.h"
+
+#include <algorithm>
+
+namespace dmme {
+namespace core {
+namespace renderer {
+
+namespace {
+
+uint64_t RegionBytes(TextureFormat format, int width, int height) {
+    return GetTextureBytes(format, width, height);
+}
+
+} // anonymous namespace
+
+// ===================================================================
+// Budget
+// ===================================================================
+
+void TextureUploadQueue::SetBudget(uint64_t bytesPerFrame) {
+    m_stats.budgetBytes = bytesPerFrame;
+}
+
+uint64_t TextureUploadQueue::GetBudget() const {
+    return m_stats.budgetBytes;
+}
+
+// ===================================================================
+// Queue
+// ===================================================================
+
+UploadTicket TextureUploadQueue::Enqueue(TextureHandle texture, TextureFormat format,
+                                         const PixelRegion& rect,
+                                         const uint8_t* pixels, int strideBytes) {
+    // One row of texels, or of blocks
+    if (texture == kInvalidTexture || !pixels || rect.IsEmpty() ||
+        static_cast<uint64_t>(strideBytes) < RegionBytes(format, rect.width, 1)) {
+        DMME_LOG_ERROR("TextureUploadQueue::Enqueue: invalid update ({}x{}, stride {})",
+                       rect.width, rect.height, strideBytes);
+        return kInvalidUploadTicket;
+    }
+
+    Request req;
+    req.ticket      = m_nextTicket++;
+    req.texture     = texture;
+    req.format      = format;
+    req.rect        = rect;
+    req.pixels      = pixels;
+    req.strideBytes = strideBytes;
+    m_pending.push_back(req);
+    m_pendingBytes += RegionBytes(format, rect.width, rect.height);
+    return req.ticket;
+}
+
+void TextureUploadQueue::Cancel(TextureHandle texture) {
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (it->texture != texture) {
+            ++it;
+            continue;
+        }
+        // Bytes of the tiles not submitted yet
+        const PixelRegion& r = it->rect;
+        const uint64_t remaining =
+            RegionBytes(it->format, r.width, r.height - it->nextY) -
+            RegionBytes(it->format, it->nextX, std::min(kUploadSlotSize, r.height - it->nextY));
+        m_pendingBytes -= std::min(remaining, m_pendingBytes);
+        it = m_pending.erase(it);
+    }
+}
+
+void TextureUploadQueue::Reset() {
+    m_pending.clear();
+    m_submitted.clear();
+    m_slotFrame.fill(0);
+    m_slotUsed.fill(false);
+    m_nextSlot     = 0;
+    m_pendingBytes = 0;
+    m_lastFrame    = 0;
+    m_stats.frameBytes = 0;
+}
+
+// ===================================================================
+// Pump
+// ===================================================================
+
+bool TextureUploadQueue::IsSlotFree(uint32_t slot, uint64_t frame) const {
+    return !m_slotUsed[slot] || m_slotFrame[slot] + kUploadFramesInFlight <= frame;
+}
+
+void TextureUploadQueue::RetireSubmitted(uint64_t frame) {
+    while (!m_submitted.empty() &&
+           m_submitted.front().frame + kUploadFramesInFlight <= frame) {
+        m_submitted.pop_front();
+        ++m_stats.completedUploads;
+    }
+}
+
+void TextureUploadQueue::Pump(uint64_t frame, UploadSubmitFunc submit, void* context) {
+    RetireSubmitted(frame);
+    m_lastFrame = frame;
+    m_stats.frameBytes = 0;
+
+    while (!m_pending.empty()) {
+        Request& req = m_pending.front();
+
+        // Next tile of the request: row bands of one slot height,
+        // each cut into slot-wide columns
+        PixelRegion tile;
+        tile.x      = req.rect.x + req.nextX;
+        tile.y      = req.rect.y + req.nextY;
+        tile.width  = std::min(kUploadSlotSize, req.rect.width  - req.nextX);
+        tile.height = std::min(kUploadSlotSize, req.rect.height - req.nextY);
+        const uint64_t tileBytes = RegionBytes(req.format, tile.width, tile.height);
+
+        if (m_stats.budgetBytes > 0 && m_stats.frameBytes > 0 &&
+            m_stats.frameBytes + tileBytes > m_stats.budgetBytes) {
+            break;
+        }
+
+        // The ring is used in order, so if the next slot is busy every
+        // slot is
+        const uint32_t slot = m_nextSlot;
+        if (!IsSlotFree(slot, frame)) {
+            ++m_stats.ringStalls;
+            break;
+        }
+
+        UploadChunk chunk;
+        chunk.texture     = req.texture;
+        chunk.format      = req.format;
+        chunk.rect        = tile;
+        // Slot-sized tiles keep BC updates on block boundaries
+        if (IsBlockCompressed(req.format)) {
+            chunk.pixels = req.pixels + static_cast<size_t>(req.nextY / kBlockSize) * req.strideBytes
+                                      + static_cast<size_t>(req.nextX / kBlockSize) * GetBlockBytes(req.format);
+        } else {
+            chunk.pixels = req.pixels + static_cast<size_t>(req.nextY) * req.strideBytes
+                                      + static_cast<size_t>(req.nextX) * 4;
+        }
+        chunk.strideBytes = req.strideBytes;
+        chunk.slot        = slot;
+        if (!submit(context, chunk)) {
+            ++m_stats.ringStalls;
+            break;
+        }
+
+        m_slotUsed[slot]  = true;
+        m_slotFrame[slot] = frame;
+        m_nextSlot = (m_nextSlot + 1) % kUploadRingSlots;
+        m_stats.frameBytes += tileBytes;
+        m_stats.totalBytes += tileBytes;
+        m_pendingBytes     -= std::min(tileBytes, m_pendingBytes);
+
+        req.nextX += tile.width;
+        if (req.nextX >= req.rect.width) {
+            req.nextX  = 0;
+            req.nextY += tile.height;
+        }
+        if (req.nextY >= req.rect.height) {
+            m_submitted.push_back({req.ticket, frame});
+            m_pending.pop_front();
+        }
+    }
+}
+
+bool TextureUploadQueue::IsComplete(UploadTicket ticket) const {
+    if (ticket == kInvalidUploadTicket || ticket >= m_nextTicket) {
+        return false;
+    }
+    for (const Request& req : m_pending) {
+        if (req.ticket == ticket) return false;
+    }
+    for (const Submitted& s : m_submitted) {
+        if (s.ticket == ticket) return false;
+    }
+    return true;
+}
+
+// ===================================================================
+// Stats
+// ===================================================================
+
+UploadStats TextureUploadQueue::GetStats() const {
+    UploadStats stats = m_stats;
+    stats.pendingBytes   = m_pendingBytes;
+    stats.pendingUploads = static_cast<uint32_t>(m_pending.size());
+    stats.slotsInFlight  = 0;
+    for (uint32_t i = 0; i < kUploadRingSlots; ++i) {
+        if (!IsSlotFree(i, m_lastFrame)) {
+            ++stats.slotsInFlight;
+        }
+    }
+    return stats;
+}
+
+} // namespace renderer
+} // namespace core
+} // namespace dmme
\ No newline at end of file
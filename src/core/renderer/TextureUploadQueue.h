@@ -0,0 +1,122 @@
+#pragma once
+
+#include "RenderTypes.h"
+
+#include <array>
+#include <cstdint>
+#include <deque>
+
+namespace dmme {
+namespace core {
+namespace renderer {
+
+// Upload ring shape shared by every driver: kUploadRingSlots staging
+// buffers of kUploadSlotSize x kUploadSlotSize RGBA8 texels (1 MiB
+// each). A slot filled in frame N is reused no earlier than frame
+// N + kUploadFramesInFlight, by which time the GPU has consumed it.
+constexpr uint32_t kUploadRingSlots      = 8;
+constexpr int      kUploadSlotSize       = 512;
+constexpr uint32_t kUploadFramesInFlight = 2;
+
+// One tile of a queued update, staged through one ring slot
+struct UploadChunk {
+    TextureHandle  texture     = kInvalidTexture;
+    TextureFormat  format      = TextureFormat::RGBA8_UNORM;
+    PixelRegion    rect;                  // destination texels (<= one slot)
+    const uint8_t* pixels      = nullptr; // source texel (or block) at rect's top-left
+    int            strideBytes = 0;       // source row (or block row) pitch
+    uint32_t       slot        = 0;       // ring slot carrying the chunk
+};
+
+// Driver callback that stages one chunk into its slot and issues the
+// copy into the texture. Returns false if the slot is still busy on
+// the GPU; the pump stops and retries the chunk next frame.
+using UploadSubmitFunc = bool (*)(void* context, const UploadChunk& chunk);
+
+// TextureUploadQueue schedules texture updates for a driver. Updates
+// are queued without touching the GPU; each frame the driver calls
+// Pump(), which cuts the queue into slot-sized tiles and submits them
+// through the upload ring until the per-frame byte budget is used,
+// so a full atlas page is spread over several frames instead of
+// stalling one. An update is complete once its last tile's slot has
+// retired.
+//
+// The queue does not copy the source pixels: they must stay valid
+// until IsComplete(ticket) (or until the texture is cancelled).
+// Render thread only, like the driver that owns it.
+//
+// Usage (inside a driver):
+//   UploadTicket t = m_uploads.Enqueue(texture, rect, pixels, stride);
+//   // BeginFrame:
+//   m_uploads.Pump(m_frameCounter, &Driver::SubmitUpload, this);
+
+class TextureUploadQueue {
+public:
+    TextureUploadQueue() = default;
+    ~TextureUploadQueue() = default;
+
+    TextureUploadQueue(const TextureUploadQueue&) = delete;
+    TextureUploadQueue& operator=(const TextureUploadQueue&) = delete;
+
+    // Bytes submitted per Pump. At least one tile is always submitted
+    // so a budget smaller than a tile still makes progress.
+    void     SetBudget(uint64_t bytesPerFrame);
+    uint64_t GetBudget() const;
+
+    // Queue an update of rect (already validated against the texture,
+    // whole blocks for BC formats) from pixels in the texture's format
+    // with the given row pitch. The budget counts bytes in that format.
+    UploadTicket Enqueue(TextureHandle texture, TextureFormat format, const PixelRegion& rect,
+                         const uint8_t* pixels, int strideBytes);
+
+    // Drop the texture's pending tiles (texture destroyed). Their
+    // tickets report complete.
+    void Cancel(TextureHandle texture);
+
+    // Retire slots older than kUploadFramesInFlight and submit tiles
+    // for this frame. frame must increase by one per rendered frame.
+    void Pump(uint64_t frame, UploadSubmitFunc submit, void* context);
+
+    bool IsComplete(UploadTicket ticket) const;
+
+    // Forget everything (driver shutdown / device lost)
+    void Reset();
+
+    UploadStats GetStats() const;
+
+private:
+    struct Request {
+        UploadTicket   ticket      = kInvalidUploadTicket;
+        TextureHandle  texture     = kInvalidTexture;
+        TextureFormat  format      = TextureFormat::RGBA8_UNORM;
+        PixelRegion    rect;
+        const uint8_t* pixels      = nullptr;
+        int            strideBytes = 0;
+        int            nextX       = 0;   // next tile, relative to rect
+        int            nextY       = 0;
+    };
+
+    struct Submitted {
+        UploadTicket ticket = kInvalidUploadTicket;
+        uint64_t     frame  = 0;          // frame of the last tile
+    };
+
+    bool IsSlotFree(uint32_t slot, uint64_t frame) const;
+    void RetireSubmitted(uint64_t frame);
+
+    std::deque<Request>   m_pending;
+    std::deque<Submitted> m_submitted;
+
+    std::array<uint64_t, kUploadRingSlots> m_slotFrame{};   // frame of last use
+    std::array<bool,     kUploadRingSlots> m_slotUsed{};
+    uint32_t     m_nextSlot   = 0;
+    UploadTicket m_nextTicket = 1;
+    uint64_t     m_pendingBytes = 0;
+    uint64_t     m_lastFrame    = 0;      // frame of the last Pump
+
+    UploadStats  m_stats;
+};
+
+} // namespace renderer
+} // namespace core
+} // namespace dmme
\ No newline at end of file
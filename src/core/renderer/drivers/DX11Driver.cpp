@@ -1,4 +1,5 @@
 #include "DX11Driver.h"
+#include "core/renderer/BlockCompression.h"
 #include "utils/Logger.h"
 
 #include <d3dcompiler.h>
@@ -126,6 +127,12 @@ bool DX11Driver::Initialize(HWND hwnd, const RenderConfig& config) {
 
     QueryCapabilities();
 
+    if (!CreateUploadRing()) {
+        Shutdown();
+        return false;
+    }
+    m_uploads.SetBudget(config.uploadBudgetBytes);
+
     m_initialized = true;
     m_frameCounter = 0;
     m_frameStats = {};
@@ -155,6 +162,7 @@ void DX11Driver::Shutdown() {
     DMME_LOG_INFO("DX11 driver shutting down");
 
     DestroyTarget();
+    ReleaseTextures();
 
     m_disjointQuery.Reset();
     m_timestampBegin.Reset();
@@ -277,6 +285,9 @@ void DX11Driver::DestroyTarget() {
     m_dsv.Reset();
     m_depthTexture.Reset();
     m_stagingTexture.Reset();
+    m_renderTargetMemory.Reset();
+    m_depthMemory.Reset();
+    m_stagingMemory.Reset();
     m_targetWidth  = 0;
     m_targetHeight = 0;
 }
@@ -298,6 +309,10 @@ bool DX11Driver::BeginFrame() {
         m_context->End(m_timestampBegin.Get());
     }
 
+    // Stage queued texture updates before anything samples them
+    m_uploads.Pump(m_frameCounter, &DX11Driver::SubmitUpload, this);
+    m_frameStats.uploadBytes = m_uploads.GetStats().frameBytes;
+
     // Bind render target
     ID3D11RenderTargetView* rtvs[] = { m_rtv.Get() };
     m_context->OMSetRenderTargets(1, rtvs, m_dsv.Get());
@@ -411,10 +426,270 @@ bool DX11Driver::ReadbackPixels(PixelReadback& output) {
     }
 
     m_context->Unmap(m_stagingTexture.Get(), 0);
+    output.regionCount = 0;
+
+    return true;
+}
+
+bool DX11Driver::ReadbackRegions(PixelReadback& output,
+                                 const PixelRegion* regions, uint32_t regionCount) {
+    if (!m_initialized || !m_renderTexture || !m_stagingTexture) {
+        DMME_LOG_ERROR("ReadbackRegions: driver not ready");
+        return false;
+    }
+
+    // No earlier frame to patch: everything has to be read
+    if (!output.IsValid() || output.width != m_targetWidth || output.height != m_targetHeight) {
+        return ReadbackPixels(output);
+    }
+
+    // Copy only the regions into the staging texture, at the same
+    // offsets, so just those texels cross to the CPU-visible copy.
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < regionCount && kept < kMaxReadbackRegions; ++i) {
+        const PixelRegion r = ClipRegion(regions[i], m_targetWidth, m_targetHeight);
+        if (r.IsEmpty()) {
+            continue;
+        }
+
+        D3D11_BOX box{};
+        box.left   = static_cast<UINT>(r.x);
+        box.top    = static_cast<UINT>(r.y);
+        box.front  = 0;
+        box.right  = static_cast<UINT>(r.x + r.width);
+        box.bottom = static_cast<UINT>(r.y + r.height);
+        box.back   = 1;
+
+        m_context->CopySubresourceRegion(m_stagingTexture.Get(), 0,
+                                         box.left, box.top, 0,
+                                         m_renderTexture.Get(), 0, &box);
+        output.regions[kept++] = r;
+    }
+
+    if (kept == 0) {
+        output.regions[0]  = PixelRegion{};
+        output.regionCount = 1;
+        return true;
+    }
+
+    D3D11_MAPPED_SUBRESOURCE mapped{};
+    HRESULT hr = m_context->Map(m_stagingTexture.Get(), 0, D3D11_MAP_READ, 0, &mapped);
+    if (FAILED(hr)) {
+        DMME_LOG_ERROR("ReadbackRegions: Map failed: {}", HRToString(hr));
+        return false;
+    }
+
+    const uint8_t* srcData  = static_cast<const uint8_t*>(mapped.pData);
+    uint8_t*       dstData  = output.data.data();
+    const size_t   dstPitch = static_cast<size_t>(m_targetWidth) * 4;
+
+    for (uint32_t i = 0; i < kept; ++i) {
+        const PixelRegion& r = output.regions[i];
+        const size_t bytes = static_cast<size_t>(r.width) * 4;
+        for (int row = r.y; row < r.y + r.height; ++row) {
+            std::memcpy(dstData + row * dstPitch + static_cast<size_t>(r.x) * 4,
+                        srcData + row * static_cast<size_t>(mapped.RowPitch) +
+                            static_cast<size_t>(r.x) * 4,
+                        bytes);
+        }
+    }
+
+    m_context->Unmap(m_stagingTexture.Get(), 0);
+    output.regionCount = kept;
 
     return true;
 }
 
+// ===================================================================
+// IGraphicsDriver -- Textures
+// ===================================================================
+
+TextureHandle DX11Driver::CreateTexture(const TextureDesc& desc) {
+    if (!m_initialized) {
+        DMME_LOG_ERROR("CreateTexture called on uninitialized DX11 driver");
+        return kInvalidTexture;
+    }
+
+    // BC formats are sampled natively; the blocks go to the GPU as is
+    DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN;
+    switch (desc.format) {
+        case TextureFormat::RGBA8_UNORM: format = DXGI_FORMAT_R8G8B8A8_UNORM; break;
+        case TextureFormat::BC1_UNORM:   format = DXGI_FORMAT_BC1_UNORM;      break;
+        case TextureFormat::BC3_UNORM:   format = DXGI_FORMAT_BC3_UNORM;      break;
+        case TextureFormat::BC7_UNORM:   format = DXGI_FORMAT_BC7_UNORM;      break;
+        default: break;
+    }
+    const bool compressed = IsBlockCompressed(desc.format);
+    if (desc.width <= 0 || desc.height <= 0 ||
+        desc.width > m_caps.maxTextureSize || desc.height > m_caps.maxTextureSize ||
+        format == DXGI_FORMAT_UNKNOWN ||
+        (compressed && (desc.width % kBlockSize != 0 || desc.height % kBlockSize != 0))) {
+        DMME_LOG_ERROR("CreateTexture: unsupported texture {}x{} format={}",
+                       desc.width, desc.height, static_cast<int>(desc.format));
+        return kInvalidTexture;
+    }
+
+    D3D11_TEXTURE2D_DESC texDesc{};
+    texDesc.Width              = static_cast<UINT>(desc.width);
+    texDesc.Height             = static_cast<UINT>(desc.height);
+    texDesc.MipLevels          = 1;
+    texDesc.ArraySize          = 1;
+    texDesc.Format             = format;
+    texDesc.SampleDesc.Count   = 1;
+    texDesc.SampleDesc.Quality = 0;
+    texDesc.Usage              = D3D11_USAGE_DEFAULT;
+    texDesc.BindFlags          = D3D11_BIND_SHADER_RESOURCE;
+    texDesc.CPUAccessFlags     = 0;
+    texDesc.MiscFlags          = 0;
+
+    DX11Texture tex;
+    HRESULT hr = m_device->CreateTexture2D(&texDesc, nullptr, &tex.texture);
+    if (FAILED(hr)) {
+        DMME_LOG_ERROR("CreateTexture2D (texture) failed: {}", HRToString(hr));
+        return kInvalidTexture;
+    }
+
+    hr = m_device->CreateShaderResourceView(tex.texture.Get(), nullptr, &tex.srv);
+    if (FAILED(hr)) {
+        DMME_LOG_ERROR("CreateShaderResourceView failed: {}", HRToString(hr));
+        return kInvalidTexture;
+    }
+    tex.width  = desc.width;
+    tex.height = desc.height;
+    tex.format = desc.format;
+
+    size_t index = 0;
+    while (index < m_textures.size() && m_textures[index].texture) {
+        ++index;
+    }
+    if (index == m_textures.size()) {
+        m_textures.emplace_back();
+    }
+    m_textures[index] = std::move(tex);
+    m_textureMemory.Set(m_textureMemory.GetBytes() +
+                        GetTextureBytes(desc.format, desc.width, desc.height));
+
+    return static_cast<TextureHandle>(index + 1);
+}
+
+void DX11Driver::DestroyTexture(TextureHandle texture) {
+    if (texture == kInvalidTexture || texture > m_textures.size() ||
+        !m_textures[texture - 1].texture) {
+        return;
+    }
+
+    // Copies already issued keep the texture alive inside the runtime
+    m_uploads.Cancel(texture);
+
+    DX11Texture& tex = m_textures[texture - 1];
+    m_textureMemory.Set(m_textureMemory.GetBytes() -
+                        GetTextureBytes(tex.format, tex.width, tex.height));
+    tex = DX11Texture{};
+}
+
+UploadTicket DX11Driver::UpdateTexture(TextureHandle texture, const PixelRegion& rect,
+                                       const uint8_t* pixels, int strideBytes) {
+    if (texture == kInvalidTexture || texture > m_textures.size() ||
+        !m_textures[texture - 1].texture) {
+        DMME_LOG_ERROR("UpdateTexture: invalid texture {}", texture);
+        return kInvalidUploadTicket;
+    }
+
+    const DX11Texture& tex = m_textures[texture - 1];
+    const PixelRegion clipped = ClipRegion(rect, tex.width, tex.height);
+    if (rect.IsEmpty() || clipped.x != rect.x || clipped.y != rect.y ||
+        clipped.width != rect.width || clipped.height != rect.height) {
+        DMME_LOG_ERROR("UpdateTexture: rect {},{} {}x{} outside {}x{} texture",
+                       rect.x, rect.y, rect.width, rect.height, tex.width, tex.height);
+        return kInvalidUploadTicket;
+    }
+    if (IsBlockCompressed(tex.format) &&
+        (rect.x % kBlockSize != 0 || rect.y % kBlockSize != 0 ||
+         rect.width % kBlockSize != 0 || rect.height % kBlockSize != 0)) {
+        DMME_LOG_ERROR("UpdateTexture: rect {},{} {}x{} is not block-aligned",
+                       rect.x, rect.y, rect.width, rect.height);
+        return kInvalidUploadTicket;
+    }
+
+    return m_uploads.Enqueue(texture, tex.format, rect, pixels, strideBytes);
+}
+
+bool DX11Driver::IsUploadComplete(UploadTicket ticket) const {
+    return m_uploads.IsComplete(ticket);
+}
+
+void DX11Driver::SetUploadBudget(uint64_t bytesPerFrame) {
+    m_uploads.SetBudget(bytesPerFrame);
+}
+
+UploadStats DX11Driver::GetUploadStats() const {
+    return m_uploads.GetStats();
+}
+
+bool DX11Driver::SubmitUpload(void* context, const UploadChunk& chunk) {
+    auto* self = static_cast<DX11Driver*>(context);
+    ID3D11Texture2D* slot = self->m_uploadSlots[chunk.slot].Get();
+    if (chunk.texture > self->m_textures.size() || !slot) {
+        return true;   // destroyed meanwhile: nothing to copy
+    }
+    const DX11Texture& tex = self->m_textures[chunk.texture - 1];
+    if (!tex.texture) {
+        return true;
+    }
+
+    // Block data cannot go through the RGBA8 slots (different format
+    // class); the runtime copies it into its own upload memory instead
+    if (IsBlockCompressed(tex.format)) {
+        D3D11_BOX box{};
+        box.left   = static_cast<UINT>(chunk.rect.x);
+        box.top    = static_cast<UINT>(chunk.rect.y);
+        box.front  = 0;
+        box.right  = static_cast<UINT>(chunk.rect.x + chunk.rect.width);
+        box.bottom = static_cast<UINT>(chunk.rect.y + chunk.rect.height);
+        box.back   = 1;
+        self->m_context->UpdateSubresource(tex.texture.Get(), 0, &box, chunk.pixels,
+                                           static_cast<UINT>(chunk.strideBytes), 0);
+        return true;
+    }
+
+    // The ring normally keeps a slot idle until the GPU is done with
+    // it; DO_NOT_WAIT turns a slow GPU into a deferred chunk rather
+    // than a stall.
+    D3D11_MAPPED_SUBRESOURCE mapped{};
+    HRESULT hr = self->m_context->Map(slot, 0, D3D11_MAP_WRITE,
+                                      D3D11_MAP_FLAG_DO_NOT_WAIT, &mapped);
+    if (hr == DXGI_ERROR_WAS_STILL_DRAWING) {
+        return false;
+    }
+    if (FAILED(hr)) {
+        DMME_LOG_ERROR("SubmitUpload: Map failed: {}", HRToString(hr));
+        return false;
+    }
+
+    uint8_t*       dst   = static_cast<uint8_t*>(mapped.pData);
+    const uint8_t* src   = chunk.pixels;
+    const size_t   bytes = static_cast<size_t>(chunk.rect.width) * 4;
+    for (int row = 0; row < chunk.rect.height; ++row) {
+        std::memcpy(dst, src, bytes);
+        dst += mapped.RowPitch;
+        src += chunk.strideBytes;
+    }
+    self->m_context->Unmap(slot, 0);
+
+    D3D11_BOX box{};
+    box.left   = 0;
+    box.top    = 0;
+    box.front  = 0;
+    box.right  = static_cast<UINT>(chunk.rect.width);
+    box.bottom = static_cast<UINT>(chunk.rect.height);
+    box.back   = 1;
+    self->m_context->CopySubresourceRegion(tex.texture.Get(), 0,
+                                           static_cast<UINT>(chunk.rect.x),
+                                           static_cast<UINT>(chunk.rect.y), 0,
+                                           slot, 0, &box);
+    return true;
+}
+
 // ===================================================================
 // IGraphicsDriver -- Frame Stats
 // ===================================================================
@@ -442,6 +717,13 @@ ID3D11Device* DX11Driver::GetDevice() const {
     return m_device.Get();
 }
 
+ID3D11ShaderResourceView* DX11Driver::GetTextureView(TextureHandle texture) const {
+    if (texture == kInvalidTexture || texture > m_textures.size()) {
+        return nullptr;
+    }
+    return m_textures[texture - 1].srv.Get();
+}
+
 ID3D11DeviceContext* DX11Driver::GetContext() const {
     return m_context.Get();
 }
@@ -644,6 +926,9 @@ bool DX11Driver::CreateRenderTarget(int w, int h, TextureFormat fmt, int samples
         return false;
     }
 
+    const uint64_t bytesPerPixel = (fmt == TextureFormat::RGBA16_FLOAT) ? 8 : 4;
+    m_renderTargetMemory.Set(static_cast<uint64_t>(w) * h * bytesPerPixel * samples);
+
     m_sampleCount = samples;
     return true;
 }
@@ -679,6 +964,7 @@ bool DX11Driver::CreateDepthStencil(int w, int h, int samples) {
         return false;
     }
 
+    m_depthMemory.Set(static_cast<uint64_t>(w) * h * 4 * samples);
     return true;
 }
 
@@ -706,9 +992,55 @@ bool DX11Driver::CreateStagingTexture(int w, int h) {
         return false;
     }
 
+    m_stagingMemory.Set(static_cast<uint64_t>(w) * h * 4);
     return true;
 }
 
+// ===================================================================
+// Internal: Create Upload Ring (CPU -> GPU texture updates)
+// ===================================================================
+
+bool DX11Driver::CreateUploadRing() {
+    D3D11_TEXTURE2D_DESC slotDesc{};
+    slotDesc.Width              = static_cast<UINT>(kUploadSlotSize);
+    slotDesc.Height             = static_cast<UINT>(kUploadSlotSize);
+    slotDesc.MipLevels          = 1;
+    slotDesc.ArraySize          = 1;
+    slotDesc.Format             = DXGI_FORMAT_R8G8B8A8_UNORM;
+    slotDesc.SampleDesc.Count   = 1;
+    slotDesc.SampleDesc.Quality = 0;
+    slotDesc.Usage              = D3D11_USAGE_STAGING;
+    slotDesc.BindFlags          = 0;
+    slotDesc.CPUAccessFlags     = D3D11_CPU_ACCESS_WRITE;
+    slotDesc.MiscFlags          = 0;
+
+    for (auto& slot : m_uploadSlots) {
+        HRESULT hr = m_device->CreateTexture2D(&slotDesc, nullptr, &slot);
+        if (FAILED(hr)) {
+            DMME_LOG_CRITICAL("CreateTexture2D (upload slot) failed: {}", HRToString(hr));
+            return false;
+        }
+    }
+
+    m_uploadRingMemory.Set(static_cast<uint64_t>(kUploadRingSlots) *
+                           kUploadSlotSize * kUploadSlotSize * 4);
+    return true;
+}
+
+// ===================================================================
+// Internal: Release Textures and Upload Ring
+// ===================================================================
+
+void DX11Driver::ReleaseTextures() {
+    m_uploads.Reset();
+    m_textures.clear();
+    for (auto& slot : m_uploadSlots) {
+        slot.Reset();
+    }
+    m_textureMemory.Reset();
+    m_uploadRingMemory.Reset();
+}
+
 // ===================================================================
 // Internal: Release Render Target Resources
 // ===================================================================
@@ -722,6 +1054,9 @@ void DX11Driver::ReleaseRenderTarget() {
     m_dsv.Reset();
     m_depthTexture.Reset();
     m_stagingTexture.Reset();
+    m_renderTargetMemory.Reset();
+    m_depthMemory.Reset();
+    m_stagingMemory.Reset();
 }
 
 // ===================================================================
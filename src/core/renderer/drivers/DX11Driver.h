@@ -1,12 +1,16 @@
 #pragma once
 
 #include "DriverInterface.h"
+#include "core/renderer/TextureUploadQueue.h"
+#include "core/memory/MemoryAccountant.h"
 
 #include <Windows.h>
 #include <d3d11.h>
 #include <dxgi1_2.h>
 #include <wrl/client.h>
+#include <array>
 #include <string>
+#include <vector>
 
 namespace dmme {
 namespace core {
@@ -39,6 +43,15 @@ public:
     void SetViewport(const Viewport& vp) override;
     bool EndFrame() override;
     bool ReadbackPixels(PixelReadback& output) override;
+    bool ReadbackRegions(PixelReadback& output,
+                         const PixelRegion* regions, uint32_t regionCount) override;
+    TextureHandle CreateTexture(const TextureDesc& desc) override;
+    void DestroyTexture(TextureHandle texture) override;
+    UploadTicket UpdateTexture(TextureHandle texture, const PixelRegion& rect,
+                               const uint8_t* pixels, int strideBytes) override;
+    bool IsUploadComplete(UploadTicket ticket) const override;
+    void        SetUploadBudget(uint64_t bytesPerFrame) override;
+    UploadStats GetUploadStats() const override;
     FrameStats GetFrameStats() const override;
     void SetDebugName(const std::string& name) override;
 
@@ -46,6 +59,9 @@ public:
     ID3D11Device*        GetDevice() const;
     ID3D11DeviceContext* GetContext() const;
 
+    // Shader view of a texture (nullptr for an invalid handle)
+    ID3D11ShaderResourceView* GetTextureView(TextureHandle texture) const;
+
 private:
     bool CreateDevice(HWND hwnd, bool enableDebug);
     bool EnumerateAdapter();
@@ -53,7 +69,10 @@ private:
     bool CreateRenderTarget(int w, int h, TextureFormat fmt, int samples);
     bool CreateDepthStencil(int w, int h, int samples);
     bool CreateStagingTexture(int w, int h);
+    bool CreateUploadRing();
+    void ReleaseTextures();
     void ReleaseRenderTarget();
+    static bool SubmitUpload(void* context, const UploadChunk& chunk);
     static std::string HRToString(HRESULT hr);
 
     // --- Device ---
@@ -72,6 +91,25 @@ private:
     // --- Staging (for CPU readback) ---
     ComPtr<ID3D11Texture2D>          m_stagingTexture;
 
+    // --- Textures (handle = index + 1) and upload ring ---
+    struct DX11Texture {
+        ComPtr<ID3D11Texture2D>          texture;
+        ComPtr<ID3D11ShaderResourceView> srv;
+        int                              width  = 0;
+        int                              height = 0;
+        TextureFormat                    format = TextureFormat::RGBA8_UNORM;
+    };
+    std::vector<DX11Texture>         m_textures;
+    std::array<ComPtr<ID3D11Texture2D>, kUploadRingSlots> m_uploadSlots;   // staging, CPU write
+    TextureUploadQueue               m_uploads;
+
+    // --- Memory accounting (estimated from texture descs) ---
+    memory::TrackedMemory m_renderTargetMemory{memory::MemoryCategory::RenderTarget};
+    memory::TrackedMemory m_depthMemory{memory::MemoryCategory::DepthStencil};
+    memory::TrackedMemory m_stagingMemory{memory::MemoryCategory::Staging};
+    memory::TrackedMemory m_uploadRingMemory{memory::MemoryCategory::Staging};
+    memory::TrackedMemory m_textureMemory{memory::MemoryCategory::Texture};
+
     // --- State ---
     bool           m_initialized = false;
     int            m_targetWidth  = 0;
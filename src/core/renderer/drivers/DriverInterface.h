@@ -25,7 +25,8 @@ namespace renderer {
 //   1. Initialize()    -- create device, context, enumerate GPU
 //   2. CreateTarget()  -- create off-screen render target
 //   3. [per frame]
-//      a. BeginFrame()     -- prepare for rendering
+//      a. BeginFrame()     -- prepare for rendering, pump queued
+//                             texture uploads (UpdateTexture)
 //      b. Clear()          -- clear render target
 //      c. SetViewport()    -- set viewport dimensions
 //      d. ... draw calls ...
@@ -105,6 +106,40 @@ public:
     // via UpdateLayeredWindow, not via a swap chain.
     virtual bool ReadbackPixels(PixelReadback& output) = 0;
 
+    // Copy only the given regions (clipped, at most
+    // kMaxReadbackRegions) into output; the rest of the buffer keeps
+    // its previous contents. If output does not already hold a frame
+    // of the target's size this falls back to a full readback.
+    // output.regions / regionCount record what was refreshed.
+    virtual bool ReadbackRegions(PixelReadback& output,
+                                 const PixelRegion* regions, uint32_t regionCount) = 0;
+
+    // --- Textures ---
+
+    // Create an RGBA8 or BC1 / BC3 / BC7 texture for sampling (contents
+    // undefined until uploaded). BC textures need dimensions that are
+    // multiples of 4. Returns kInvalidTexture on failure.
+    virtual TextureHandle CreateTexture(const TextureDesc& desc) = 0;
+
+    // Destroy a texture. Its pending uploads are dropped.
+    virtual void DestroyTexture(TextureHandle texture) = 0;
+
+    // Queue an update of rect (inside the texture) from pixels in the
+    // texture's format with the given row pitch; for BC textures rect
+    // covers whole blocks and pixels are block rows. Nothing is copied
+    // here: BeginFrame stages queued updates through the driver's
+    // upload ring within the upload budget, so pixels must stay valid
+    // until IsUploadComplete(ticket). Returns kInvalidUploadTicket if
+    // the update was rejected.
+    virtual UploadTicket UpdateTexture(TextureHandle texture, const PixelRegion& rect,
+                                       const uint8_t* pixels, int strideBytes) = 0;
+
+    virtual bool IsUploadComplete(UploadTicket ticket) const = 0;
+
+    // Upload bytes per frame; large updates are spread over frames
+    virtual void        SetUploadBudget(uint64_t bytesPerFrame) = 0;
+    virtual UploadStats GetUploadStats() const = 0;
+
     // --- Frame Statistics ---
     virtual FrameStats GetFrameStats() const = 0;
 
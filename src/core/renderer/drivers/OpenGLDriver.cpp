@@ -1,4 +1,5 @@
 #include "OpenGLDriver.h"
+#include "core/renderer/BlockCompression.h"
 #include "utils/Logger.h"
 
 #include <cstring>
@@ -65,6 +66,8 @@ bool OpenGLDriver::Initialize(HWND /*hwnd*/, const RenderConfig& config) {
     DMME_LOG_INFO("Initializing OpenGL driver (software fallback mode)");
 
     m_clearColor = config.clearColor;
+    m_uploads.SetBudget(config.uploadBudgetBytes);
+    m_tileCache.SetBudget(config.tileCacheBudgetBytes);
     m_initialized = true;
     m_frameCounter = 0;
     m_frameStats = {};
@@ -84,6 +87,12 @@ void OpenGLDriver::Shutdown() {
     m_internalBuffer.data.shrink_to_fit();
     m_internalBuffer.width  = 0;
     m_internalBuffer.height = 0;
+    m_internalMemory.Reset();
+    m_uploads.Reset();
+    m_tileCache.Reset();
+    m_textures.clear();
+    m_textures.shrink_to_fit();
+    m_textureMemory.Reset();
     m_targetWidth  = 0;
     m_targetHeight = 0;
     m_initialized  = false;
@@ -144,6 +153,7 @@ bool OpenGLDriver::CreateTarget(const RenderTargetDesc& desc) {
     m_targetHeight = desc.height;
 
     m_internalBuffer.Allocate(m_targetWidth, m_targetHeight);
+    m_internalMemory.Set(m_internalBuffer.data.capacity());
 
     DMME_LOG_INFO("OpenGL render target created (software): {}x{}",
                   m_targetWidth, m_targetHeight);
@@ -161,6 +171,7 @@ bool OpenGLDriver::ResizeTarget(int width, int height) {
     m_targetWidth  = width;
     m_targetHeight = height;
     m_internalBuffer.Allocate(width, height);
+    m_internalMemory.Set(m_internalBuffer.data.capacity());
 
     return true;
 }
@@ -185,6 +196,10 @@ bool OpenGLDriver::BeginFrame() {
     m_frameStats.drawCalls = 0;
     m_frameStats.trianglesRendered = 0;
 
+    // Textures sampled this frame see everything the budget allowed
+    m_uploads.Pump(m_frameCounter, &OpenGLDriver::SubmitUpload, this);
+    m_frameStats.uploadBytes = m_uploads.GetStats().frameBytes;
+
     return true;
 }
 
@@ -237,10 +252,220 @@ bool OpenGLDriver::ReadbackPixels(PixelReadback& output) {
     output.Allocate(m_targetWidth, m_targetHeight);
     std::memcpy(output.data.data(), m_internalBuffer.data.data(),
                 m_internalBuffer.data.size());
+    output.regionCount = 0;
+
+    return true;
+}
+
+bool OpenGLDriver::ReadbackRegions(PixelReadback& output,
+                                   const PixelRegion* regions, uint32_t regionCount) {
+    if (!m_internalBuffer.IsValid()) {
+        DMME_LOG_ERROR("OpenGL ReadbackRegions: no valid internal buffer");
+        return false;
+    }
+
+    // No earlier frame to patch: everything has to be read
+    if (!output.IsValid() || output.width != m_targetWidth || output.height != m_targetHeight) {
+        return ReadbackPixels(output);
+    }
+
+    const size_t pitch = static_cast<size_t>(m_targetWidth) * 4;
+    uint32_t kept = 0;
+
+    for (uint32_t i = 0; i < regionCount && kept < kMaxReadbackRegions; ++i) {
+        const PixelRegion r = ClipRegion(regions[i], m_targetWidth, m_targetHeight);
+        if (r.IsEmpty()) {
+            continue;
+        }
+
+        // Only the region's rows, and only its columns within each row
+        const size_t offset = static_cast<size_t>(r.y) * pitch + static_cast<size_t>(r.x) * 4;
+        const size_t bytes  = static_cast<size_t>(r.width) * 4;
+        for (int row = 0; row < r.height; ++row) {
+            std::memcpy(output.data.data() + offset + row * pitch,
+                        m_internalBuffer.data.data() + offset + row * pitch, bytes);
+        }
+        output.regions[kept++] = r;
+    }
 
+    output.regionCount = kept;
+    if (kept == 0) {
+        // Nothing requested inside the target: still a valid (unchanged)
+        // frame, described by one empty region rather than "full".
+        output.regions[0]  = PixelRegion{};
+        output.regionCount = 1;
+    }
     return true;
 }
 
+// ===================================================================
+// Textures
+// ===================================================================
+
+TextureHandle OpenGLDriver::CreateTexture(const TextureDesc& desc) {
+    if (!m_initialized) {
+        DMME_LOG_ERROR("OpenGL CreateTexture: driver not initialized");
+        return kInvalidTexture;
+    }
+
+    const int maxSize = GetCapabilities().maxTextureSize;
+    const bool compressed = IsBlockCompressed(desc.format);
+    if (desc.width <= 0 || desc.height <= 0 || desc.width > maxSize || desc.height > maxSize ||
+        (desc.format != TextureFormat::RGBA8_UNORM && !compressed) ||
+        (compressed && (desc.width % kBlockSize != 0 || desc.height % kBlockSize != 0))) {
+        DMME_LOG_ERROR("OpenGL CreateTexture: unsupported texture {}x{} format={}",
+                       desc.width, desc.height, static_cast<int>(desc.format));
+        return kInvalidTexture;
+    }
+
+    size_t index = 0;
+    while (index < m_textures.size() && m_textures[index].alive) {
+        ++index;
+    }
+    if (index == m_textures.size()) {
+        m_textures.emplace_back();
+    }
+
+    SoftwareTexture& tex = m_textures[index];
+    tex.alive  = true;
+    tex.width  = desc.width;
+    tex.height = desc.height;
+    tex.format = desc.format;
+    tex.texels.assign(static_cast<size_t>(GetTextureBytes(desc.format, desc.width, desc.height)), 0);
+    m_textureMemory.Set(m_textureMemory.GetBytes() + tex.texels.size());
+
+    return static_cast<TextureHandle>(index + 1);
+}
+
+void OpenGLDriver::DestroyTexture(TextureHandle texture) {
+    SoftwareTexture* tex = FindTexture(texture);
+    if (!tex) return;
+
+    m_uploads.Cancel(texture);
+    m_tileCache.Invalidate(texture);
+    m_textureMemory.Set(m_textureMemory.GetBytes() - tex->texels.size());
+    tex->texels.clear();
+    tex->texels.shrink_to_fit();
+    tex->alive  = false;
+    tex->width  = 0;
+    tex->height = 0;
+}
+
+UploadTicket OpenGLDriver::UpdateTexture(TextureHandle texture, const PixelRegion& rect,
+                                         const uint8_t* pixels, int strideBytes) {
+    const SoftwareTexture* tex = FindTexture(texture);
+    if (!tex) {
+        DMME_LOG_ERROR("OpenGL UpdateTexture: invalid texture {}", texture);
+        return kInvalidUploadTicket;
+    }
+
+    const PixelRegion clipped = ClipRegion(rect, tex->width, tex->height);
+    if (rect.IsEmpty() || clipped.x != rect.x || clipped.y != rect.y ||
+        clipped.width != rect.width || clipped.height != rect.height) {
+        DMME_LOG_ERROR("OpenGL UpdateTexture: rect {},{} {}x{} outside {}x{} texture",
+                       rect.x, rect.y, rect.width, rect.height, tex->width, tex->height);
+        return kInvalidUploadTicket;
+    }
+    if (IsBlockCompressed(tex->format) &&
+        (rect.x % kBlockSize != 0 || rect.y % kBlockSize != 0 ||
+         rect.width % kBlockSize != 0 || rect.height % kBlockSize != 0)) {
+        DMME_LOG_ERROR("OpenGL UpdateTexture: rect {},{} {}x{} is not block-aligned",
+                       rect.x, rect.y, rect.width, rect.height);
+        return kInvalidUploadTicket;
+    }
+
+    return m_uploads.Enqueue(texture, tex->format, rect, pixels, strideBytes);
+}
+
+bool OpenGLDriver::IsUploadComplete(UploadTicket ticket) const {
+    return m_uploads.IsComplete(ticket);
+}
+
+void OpenGLDriver::SetUploadBudget(uint64_t bytesPerFrame) {
+    m_uploads.SetBudget(bytesPerFrame);
+}
+
+UploadStats OpenGLDriver::GetUploadStats() const {
+    return m_uploads.GetStats();
+}
+
+const uint8_t* OpenGLDriver::GetTexturePixels(TextureHandle texture) const {
+    const SoftwareTexture* tex = FindTexture(texture);
+    return tex && !IsBlockCompressed(tex->format) ? tex->texels.data() : nullptr;
+}
+
+const uint8_t* OpenGLDriver::GetTextureTile(TextureHandle texture, int tileX, int tileY) {
+    const SoftwareTexture* tex = FindTexture(texture);
+    if (!tex || !IsBlockCompressed(tex->format)) {
+        return nullptr;
+    }
+    return m_tileCache.GetTile(texture, tex->format, tex->texels.data(),
+                               tex->width, tex->height, tileX, tileY);
+}
+
+void OpenGLDriver::SetTileCacheBudget(uint64_t bytes) {
+    m_tileCache.SetBudget(bytes);
+}
+
+DecodedTileStats OpenGLDriver::GetTileCacheStats() const {
+    return m_tileCache.GetStats();
+}
+
+bool OpenGLDriver::SubmitUpload(void* context, const UploadChunk& chunk) {
+    auto* self = static_cast<OpenGLDriver*>(context);
+    SoftwareTexture* tex = self->FindTexture(chunk.texture);
+    if (!tex) {
+        return true;   // destroyed meanwhile: nothing to copy
+    }
+
+    // BC textures copy rows of blocks (chunks are block-aligned)
+    const bool   compressed = IsBlockCompressed(tex->format);
+    const size_t unitBytes  = compressed ? GetBlockBytes(tex->format) : 4;
+    const int    unit       = compressed ? kBlockSize : 1;
+    const size_t pitch = static_cast<size_t>(tex->width / unit) * unitBytes;
+    const size_t bytes = static_cast<size_t>(chunk.rect.width / unit) * unitBytes;
+    uint8_t* dst = tex->texels.data() + static_cast<size_t>(chunk.rect.y / unit) * pitch
+                                      + static_cast<size_t>(chunk.rect.x / unit) * unitBytes;
+    const uint8_t* src = chunk.pixels;
+    if (compressed) {
+        self->m_tileCache.Invalidate(chunk.texture, chunk.rect);
+    }
+    for (int row = 0; row < chunk.rect.height / unit; ++row) {
+        std::memcpy(dst, src, bytes);
+        dst += pitch;
+        src += chunk.strideBytes;
+    }
+    return true;
+}
+
+OpenGLDriver::SoftwareTexture* OpenGLDriver::FindTexture(TextureHandle texture) {
+    if (texture == kInvalidTexture || texture > m_textures.size()) return nullptr;
+    SoftwareTexture& tex = m_textures[texture - 1];
+    return tex.alive ? &tex : nullptr;
+}
+
+const OpenGLDriver::SoftwareTexture* OpenGLDriver::FindTexture(TextureHandle texture) const {
+    if (texture == kInvalidTexture || texture > m_textures.size()) return nullptr;
+    const SoftwareTexture& tex = m_textures[texture - 1];
+    return tex.alive ? &tex : nullptr;
+}
+
+// ===================================================================
+// Software Target Access
+// ===================================================================
+
+uint8_t* OpenGLDriver::GetTargetPixels() {
+    return m_internalBuffer.IsValid() ? m_internalBuffer.data.data() : nullptr;
+}
+
+int OpenGLDriver::GetTargetWidth() const {
+    return m_targetWidth;
+}
+
+int OpenGLDriver::GetTargetHeight() const {
+    return m_targetHeight;
+}
+
 // ===================================================================
 // Frame Stats
 // ===================================================================
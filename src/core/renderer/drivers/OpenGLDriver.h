@@ -1,7 +1,11 @@
 #pragma once
 
 #include "DriverInterface.h"
+#include "core/renderer/TextureUploadQueue.h"
+#include "core/renderer/DecodedTileCache.h"
+#include "core/memory/MemoryAccountant.h"
 #include <string>
+#include <vector>
 
 namespace dmme {
 namespace core {
@@ -42,17 +46,68 @@ public:
     void SetViewport(const Viewport& vp) override;
     bool EndFrame() override;
     bool ReadbackPixels(PixelReadback& output) override;
+    bool ReadbackRegions(PixelReadback& output,
+                         const PixelRegion* regions, uint32_t regionCount) override;
+    TextureHandle CreateTexture(const TextureDesc& desc) override;
+    void DestroyTexture(TextureHandle texture) override;
+    UploadTicket UpdateTexture(TextureHandle texture, const PixelRegion& rect,
+                               const uint8_t* pixels, int strideBytes) override;
+    bool IsUploadComplete(UploadTicket ticket) const override;
+    void        SetUploadBudget(uint64_t bytesPerFrame) override;
+    UploadStats GetUploadStats() const override;
     FrameStats GetFrameStats() const override;
     void SetDebugName(const std::string& name) override;
 
+    // --- Software texture access (for CPU rasterizers) ---
+    // RGBA8, tightly packed. nullptr for an invalid handle or a
+    // block-compressed texture (use GetTextureTile).
+    const uint8_t* GetTexturePixels(TextureHandle texture) const;
+
+    // Decoded RGBA8 tile (tileX, tileY) of a BC1 / BC3 / BC7 texture,
+    // kDecodedTileSize texels square with rows kDecodedTileSize * 4
+    // bytes apart. Valid until the next GetTextureTile, texture update
+    // or DestroyTexture. nullptr for an uncompressed texture.
+    const uint8_t*   GetTextureTile(TextureHandle texture, int tileX, int tileY);
+    void             SetTileCacheBudget(uint64_t bytes);
+    DecodedTileStats GetTileCacheStats() const;
+
+    // --- Software target access (for CPU rasterizers) ---
+    // RGBA8, tightly packed (GetTargetWidth() * 4 bytes per row).
+    // Valid until the next CreateTarget / ResizeTarget / DestroyTarget.
+    uint8_t* GetTargetPixels();
+    int      GetTargetWidth() const;
+    int      GetTargetHeight() const;
+
 private:
+    // Textures live in CPU memory, so a ring slot carries no copy of
+    // its own: staging writes straight into the texels. BC textures
+    // keep their blocks and are decoded by tile on demand.
+    struct SoftwareTexture {
+        bool                 alive  = false;
+        int                  width  = 0;
+        int                  height = 0;
+        TextureFormat        format = TextureFormat::RGBA8_UNORM;
+        std::vector<uint8_t> texels;   // RGBA8 texels or BC block rows
+    };
+
+    static bool SubmitUpload(void* context, const UploadChunk& chunk);
+    SoftwareTexture*       FindTexture(TextureHandle texture);
+    const SoftwareTexture* FindTexture(TextureHandle texture) const;
+
     bool           m_initialized = false;
     int            m_targetWidth  = 0;
     int            m_targetHeight = 0;
     ClearColor     m_clearColor;
     PixelReadback  m_internalBuffer;
+    memory::TrackedMemory m_internalMemory{memory::MemoryCategory::DriverInternal};
     FrameStats     m_frameStats;
     uint64_t       m_frameCounter = 0;
+
+    // --- Textures (handle = index + 1) ---
+    std::vector<SoftwareTexture> m_textures;
+    TextureUploadQueue    m_uploads;
+    DecodedTileCache      m_tileCache;
+    memory::TrackedMemory m_textureMemory{memory::MemoryCategory::DriverInternal};
 };
 
 // Factory function
@@ -0,0 +1,93 @@
+#include "FramePacer.h"
+#include "utils/Logger.h"
+#include "utils/Clock.h"
+
+#include <chrono>
+#include <thread>
+
+namespace dmme {
+namespace core {
+namespace runtime {
+
+// Final stretch before a deadline is spun instead of slept: OS sleep
+// granularity (~1 ms with timeBeginPeriod, 15.6 ms without) would
+// otherwise overshoot.
+static constexpr uint64_t kSpinThresholdUs = 1500;
+
+// ===================================================================
+// Construction
+// ===================================================================
+
+FramePacer::FramePacer() {
+    SetTargetFps(60.0f);
+}
+
+// ===================================================================
+// Configuration
+// ===================================================================
+
+void FramePacer::SetTargetFps(float fps) {
+    if (fps == m_targetFps) return;
+
+    m_targetFps = fps;
+    m_periodUs  = (fps > 0.0f)
+        ? static_cast<uint64_t>(1000000.0f / fps + 0.5f) : 0;
+
+    DMME_LOG_DEBUG("FramePacer target: {:.1f} fps ({} us)", fps, m_periodUs);
+}
+
+float FramePacer::GetTargetFps() const {
+    return m_targetFps;
+}
+
+// ===================================================================
+// Pacing
+// ===================================================================
+
+uint64_t FramePacer::WaitForNextFrame() {
+    const uint64_t start = utils::MonotonicMicros();
+
+    if (m_periodUs == 0) {
+        m_nextDeadline = 0;
+        return 0;
+    }
+
+    if (m_nextDeadline == 0) {
+        m_nextDeadline = start + m_periodUs;
+    }
+
+    // More than a full period behind: re-anchor, do not burst
+    if (start > m_nextDeadline + m_periodUs) {
+        m_nextDeadline = start + m_periodUs;
+    }
+
+    uint64_t now = start;
+    while (now < m_nextDeadline) {
+        const uint64_t remaining = m_nextDeadline - now;
+        if (remaining > kSpinThresholdUs) {
+            std::this_thread::sleep_for(
+                std::chrono::microseconds(remaining - kSpinThresholdUs));
+        } else {
+            std::this_thread::yield();
+        }
+        now = utils::MonotonicMicros();
+    }
+
+    m_nextDeadline += m_periodUs;
+    return now - start;
+}
+
+uint64_t FramePacer::GetTimeUntilNextFrameUs(uint64_t nowUs) const {
+    if (m_periodUs == 0 || m_nextDeadline == 0 || nowUs >= m_nextDeadline) {
+        return 0;
+    }
+    return m_nextDeadline - nowUs;
+}
+
+void FramePacer::Reset() {
+    m_nextDeadline = 0;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace dmme
\ No newline at end of file
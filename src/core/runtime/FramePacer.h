@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+
+namespace dmme {
+namespace core {
+namespace runtime {
+
+// FramePacer holds the main loop to a target frame rate.
+//
+// It schedules frames against absolute deadlines (start + N * period)
+// rather than "sleep for whatever is left of 16 ms", so rounding in
+// the OS sleep does not accumulate into drift. If the loop falls more
+// than one period behind (a hitch, a breakpoint, a suspended session)
+// the schedule is re-anchored instead of trying to catch up with a
+// burst of unpaced frames.
+//
+// The target rate can be changed at any time (PowerGovernor,
+// VisibilityMonitor); the new period applies from the next frame.
+//
+// Usage:
+//   FramePacer pacer;
+//   pacer.SetTargetFps(60.0f);
+//   while (running) {
+//       ... frame ...
+//       pacer.WaitForNextFrame();
+//   }
+
+class FramePacer {
+public:
+    FramePacer();
+    ~FramePacer() = default;
+
+    FramePacer(const FramePacer&) = delete;
+    FramePacer& operator=(const FramePacer&) = delete;
+
+    // --- Configuration ---
+
+    // fps <= 0 disables pacing (WaitForNextFrame returns immediately).
+    void  SetTargetFps(float fps);
+    float GetTargetFps() const;
+
+    // --- Pacing ---
+
+    // Block until the next frame deadline. Returns microseconds slept.
+    uint64_t WaitForNextFrame();
+
+    // Microseconds until the next deadline (0 if already due).
+    // Does not block; for callers that wait on something else
+    // (e.g. MsgWaitForMultipleObjects) with a timeout.
+    uint64_t GetTimeUntilNextFrameUs(uint64_t nowUs) const;
+
+    // Forget the current schedule; the next frame starts "now".
+    void Reset();
+
+private:
+    float    m_targetFps     = 60.0f;
+    uint64_t m_periodUs      = 16667;
+    uint64_t m_nextDeadline  = 0;     // 0 = not anchored yet
+};
+
+} // namespace runtime
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,170 @@
+#include "PowerGovernor.h"
+#include "utils/Logger.h"
+
+namespace dmme {
+namespace core {
+namespace runtime {
+
+// ===================================================================
+// Construction
+// ===================================================================
+
+PowerGovernor::PowerGovernor(std::unique_ptr<IPowerSignalSource> source,
+                             const PowerGovernorConfig& config)
+    : m_source(std::move(source))
+    , m_config(config) {
+    m_policy = m_config.tierPolicies[static_cast<size_t>(m_tier)];
+    DMME_LOG_DEBUG("PowerGovernor created (poll={} ms, idle>{} ms, dwell={} ms)",
+                   m_config.pollIntervalUs / 1000, m_config.idleEnterMs,
+                   m_config.minDwellUs / 1000);
+}
+
+// ===================================================================
+// Update
+// ===================================================================
+
+bool PowerGovernor::Update(uint64_t nowUs) {
+    const PowerTier before = m_tier;
+
+    if (m_hasOverride) {
+        if (m_tier != m_override) {
+            ApplyTier(m_override, nowUs);
+        }
+        return m_tier != before;
+    }
+
+    if (!m_source) {
+        return false;
+    }
+
+    if (m_polledOnce && nowUs - m_lastPollUs < m_config.pollIntervalUs) {
+        return false;
+    }
+    m_lastPollUs = nowUs;
+
+    PowerSignals sample;
+    if (!m_source->Poll(nowUs, sample)) {
+        return false;
+    }
+    m_signals = sample;
+
+    // --- Threshold hysteresis ---
+    if (m_idle) {
+        m_idle = m_signals.userIdleMs >= m_config.idleExitMs;
+    } else {
+        m_idle = m_signals.userIdleMs >= m_config.idleEnterMs;
+    }
+
+    if (!m_signals.onBattery) {
+        m_lowBattery = false;
+    } else if (m_lowBattery) {
+        m_lowBattery = m_signals.batteryPercent < m_config.lowBatteryExitPct;
+    } else {
+        m_lowBattery = m_signals.batteryPercent <= m_config.lowBatteryEnterPct;
+    }
+
+    const PowerTier desired = Classify(m_signals);
+
+    if (!m_polledOnce) {
+        // First sample: adopt the tier immediately, nothing to smooth
+        m_polledOnce = true;
+        ApplyTier(desired, nowUs);
+        return m_tier != before;
+    }
+
+    if (desired == m_tier) {
+        m_pendingTier    = m_tier;
+        m_pendingSinceUs = 0;
+        return false;
+    }
+
+    // Upgrade (towards Performance): immediate
+    if (static_cast<uint8_t>(desired) < static_cast<uint8_t>(m_tier)) {
+        ApplyTier(desired, nowUs);
+        return true;
+    }
+
+    // Downgrade: must persist for minDwellUs
+    if (desired != m_pendingTier || m_pendingSinceUs == 0) {
+        m_pendingTier    = desired;
+        m_pendingSinceUs = nowUs;
+        return false;
+    }
+
+    if (nowUs - m_pendingSinceUs >= m_config.minDwellUs &&
+        nowUs - m_tierSinceUs >= m_config.minDwellUs) {
+        ApplyTier(desired, nowUs);
+        return true;
+    }
+
+    return false;
+}
+
+// ===================================================================
+// Queries
+// ===================================================================
+
+const PowerPolicy& PowerGovernor::GetPolicy() const {
+    return m_policy;
+}
+
+PowerTier PowerGovernor::GetTier() const {
+    return m_tier;
+}
+
+const PowerSignals& PowerGovernor::GetLastSignals() const {
+    return m_signals;
+}
+
+// ===================================================================
+// Overrides
+// ===================================================================
+
+void PowerGovernor::SetOverride(PowerTier tier) {
+    m_hasOverride = true;
+    m_override    = tier;
+    DMME_LOG_INFO("PowerGovernor override: {}", PowerTierName(tier));
+}
+
+void PowerGovernor::ClearOverride() {
+    m_hasOverride = false;
+    m_polledOnce  = false;  // re-adopt signal-driven tier on next Update
+    DMME_LOG_INFO("PowerGovernor override cleared");
+}
+
+// ===================================================================
+// Internal
+// ===================================================================
+
+PowerTier PowerGovernor::Classify(const PowerSignals& s) const {
+    if (m_idle) {
+        return PowerTier::Idle;
+    }
+    if (s.batterySaver || s.thermalThrottled || m_lowBattery) {
+        return PowerTier::Saver;
+    }
+    if (s.onBattery) {
+        return PowerTier::Balanced;
+    }
+    return PowerTier::Performance;
+}
+
+void PowerGovernor::ApplyTier(PowerTier tier, uint64_t nowUs) {
+    if (tier != m_tier) {
+        DMME_LOG_INFO("PowerGovernor: {} -> {} (battery={} {}% saver={} idle={}ms thermal={})",
+                      PowerTierName(m_tier), PowerTierName(tier),
+                      m_signals.onBattery, m_signals.batteryPercent,
+                      m_signals.batterySaver, m_signals.userIdleMs,
+                      m_signals.thermalThrottled);
+    }
+
+    m_tier           = tier;
+    m_policy         = m_config.tierPolicies[static_cast<size_t>(tier)];
+    m_tierSinceUs    = nowUs;
+    m_pendingTier    = tier;
+    m_pendingSinceUs = 0;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "PowerTypes.h"
+#include "PowerSignalSource.h"
+
+#include <cstdint>
+#include <array>
+
+namespace dmme {
+namespace core {
+namespace runtime {
+
+// ------------------------------------------------------------------
+// Governor configuration
+// ------------------------------------------------------------------
+
+struct PowerGovernorConfig {
+    // Policy applied in each tier, indexed by PowerTier
+    std::array<PowerPolicy, 4> tierPolicies = {{
+        {60.0f, 1.00f, animation::AnimationDetail::Full},      // Performance
+        {30.0f, 1.00f, animation::AnimationDetail::Reduced},   // Balanced
+        {20.0f, 0.75f, animation::AnimationDetail::Reduced},   // Saver
+        {10.0f, 0.75f, animation::AnimationDetail::Minimal}    // Idle
+    }};
+
+    // How often the signal source is sampled
+    uint64_t pollIntervalUs    = 1000000;   // 1 s
+
+    // Idle hysteresis: enter Idle after enterMs without input,
+    // leave as soon as idle time drops below exitMs
+    uint32_t idleEnterMs       = 60000;
+    uint32_t idleExitMs        = 1000;
+
+    // Low-battery hysteresis (only while on battery)
+    int      lowBatteryEnterPct = 20;
+    int      lowBatteryExitPct  = 25;
+
+    // Minimum time in a tier before moving to a CHEAPER tier.
+    // Moving to a more expensive tier (user came back, AC plugged in)
+    // happens immediately so the mascot never feels sluggish.
+    uint64_t minDwellUs        = 5000000;   // 5 s
+};
+
+// PowerGovernor decides the frame rate, resolution scale and animation
+// detail from pluggable power signals (AC vs battery, battery saver,
+// battery level, thermal pressure, user idle time).
+//
+// Tier selection, cheapest condition wins:
+//   Idle        -- user idle past idleEnterMs
+//   Saver       -- battery saver, low battery, or thermal throttling
+//   Balanced    -- on battery
+//   Performance -- otherwise
+//
+// Hysteresis: idle and low-battery have separate enter/exit
+// thresholds, and downgrades must persist for minDwellUs before they
+// take effect. Upgrades are immediate.
+//
+// The governor owns no timers and makes no OS calls: Update() is
+// driven by the main loop and the signals come from an
+// IPowerSignalSource, so a ScriptedPowerSignalSource can drive it
+// deterministically.
+//
+// Usage:
+//   PowerGovernor governor(CreatePlatformPowerSignalSource());
+//   // per frame:
+//   if (governor.Update(MonotonicMicros())) {
+//       const PowerPolicy& p = governor.GetPolicy();
+//       pacer.SetTargetFps(p.targetFps);
+//       pipeline.SetRenderScale(p.resolutionScale);
+//       springs.SetDetail(p.animationDetail);
+//   }
+
+class PowerGovernor {
+public:
+    explicit PowerGovernor(std::unique_ptr<IPowerSignalSource> source,
+                           const PowerGovernorConfig& config = {});
+    ~PowerGovernor() = default;
+
+    PowerGovernor(const PowerGovernor&) = delete;
+    PowerGovernor& operator=(const PowerGovernor&) = delete;
+
+    // Sample signals (at most once per poll interval) and re-evaluate.
+    // Returns true if the active policy changed.
+    bool Update(uint64_t nowUs);
+
+    // --- Queries ---
+    const PowerPolicy&  GetPolicy() const;
+    PowerTier           GetTier() const;
+    const PowerSignals& GetLastSignals() const;
+
+    // --- Overrides ---
+
+    // Force a tier regardless of signals (user setting / debugging).
+    void SetOverride(PowerTier tier);
+    void ClearOverride();
+
+private:
+    PowerTier Classify(const PowerSignals& s) const;
+    void      ApplyTier(PowerTier tier, uint64_t nowUs);
+
+    std::unique_ptr<IPowerSignalSource> m_source;
+    PowerGovernorConfig m_config;
+
+    PowerSignals m_signals;
+    PowerTier    m_tier           = PowerTier::Performance;
+    PowerPolicy  m_policy;
+
+    // Hysteresis state
+    bool         m_idle           = false;
+    bool         m_lowBattery     = false;
+    PowerTier    m_pendingTier    = PowerTier::Performance;
+    uint64_t     m_pendingSinceUs = 0;
+    uint64_t     m_tierSinceUs    = 0;
+    uint64_t     m_lastPollUs     = 0;
+    bool         m_polledOnce     = false;
+
+    bool         m_hasOverride    = false;
+    PowerTier    m_override       = PowerTier::Performance;
+};
+
+} // namespace runtime
+} // namespace core
+} // namespace dmme
\ No newline at end of file
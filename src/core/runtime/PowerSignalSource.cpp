@@ -0,0 +1,121 @@
+#include "PowerSignalSource.h"
+#include "utils/Logger.h"
+
+#if defined(_WIN32)
+#include <Windows.h>
+#endif
+
+namespace dmme {
+namespace core {
+namespace runtime {
+
+// ===================================================================
+// ScriptedPowerSignalSource
+// ===================================================================
+
+void ScriptedPowerSignalSource::AddStep(uint64_t offsetUs, const PowerSignals& signals) {
+    if (!m_steps.empty() && offsetUs < m_steps.back().offsetUs) {
+        DMME_LOG_WARN("ScriptedPowerSignalSource: step at {} us out of order, ignored",
+                      offsetUs);
+        return;
+    }
+    m_steps.push_back({offsetUs, signals});
+}
+
+bool ScriptedPowerSignalSource::Poll(uint64_t nowUs, PowerSignals& out) {
+    if (m_steps.empty()) {
+        return false;
+    }
+
+    if (!m_started) {
+        m_startUs = nowUs;
+        m_started = true;
+    }
+
+    const uint64_t offset = nowUs - m_startUs;
+
+    // Latest step whose offset has passed
+    size_t index = 0;
+    for (size_t i = 0; i < m_steps.size(); ++i) {
+        if (m_steps[i].offsetUs <= offset) {
+            index = i;
+        } else {
+            break;
+        }
+    }
+
+    const Step& step = m_steps[index];
+    out = step.signals;
+
+    // Idle time keeps growing while the step holds, like a real user
+    // walking away; a step with userIdleMs == 0 models fresh input.
+    if (offset >= step.offsetUs) {
+        out.userIdleMs += static_cast<uint32_t>((offset - step.offsetUs) / 1000);
+    }
+
+    return true;
+}
+
+// ===================================================================
+// Win32 Power Signal Source
+// ===================================================================
+
+#if defined(_WIN32)
+
+class Win32PowerSignalSource final : public IPowerSignalSource {
+public:
+    bool Poll(uint64_t /*nowUs*/, PowerSignals& out) override {
+        SYSTEM_POWER_STATUS status{};
+        if (!GetSystemPowerStatus(&status)) {
+            return false;
+        }
+
+        // ACLineStatus: 0 = offline, 1 = online, 255 = unknown.
+        // Desktops without a battery report online or unknown.
+        out.onBattery      = (status.ACLineStatus == 0);
+        out.batteryPercent = (status.BatteryLifePercent <= 100)
+            ? static_cast<int>(status.BatteryLifePercent) : 100;
+
+        // SystemStatusFlag bit 0: battery saver is on (Windows 10+)
+        out.batterySaver = (status.SystemStatusFlag & 1) != 0;
+
+        LASTINPUTINFO lii{};
+        lii.cbSize = sizeof(LASTINPUTINFO);
+        if (GetLastInputInfo(&lii)) {
+            out.userIdleMs = static_cast<uint32_t>(GetTickCount() - lii.dwTime);
+        } else {
+            out.userIdleMs = 0;
+        }
+
+        // No documented user-mode thermal signal on Win32; left to
+        // other sources to report.
+        out.thermalThrottled = false;
+        return true;
+    }
+};
+
+std::unique_ptr<IPowerSignalSource> CreatePlatformPowerSignalSource() {
+    return std::make_unique<Win32PowerSignalSource>();
+}
+
+#else
+
+// Non-Windows builds have no power source; report "always on AC,
+// user active" so the governor stays in the Performance tier.
+class NullPowerSignalSource final : public IPowerSignalSource {
+public:
+    bool Poll(uint64_t /*nowUs*/, PowerSignals& out) override {
+        out = {};
+        return true;
+    }
+};
+
+std::unique_ptr<IPowerSignalSource> CreatePlatformPowerSignalSource() {
+    return std::make_unique<NullPowerSignalSource>();
+}
+
+#endif
+
+} // namespace runtime
+} // namespace core
+} // namespace dmme
\ No newline at end of file
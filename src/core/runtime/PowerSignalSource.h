@@ -0,0 +1,65 @@
+#pragma once
+
+#include "PowerTypes.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace dmme {
+namespace core {
+namespace runtime {
+
+// ------------------------------------------------------------------
+// IPowerSignalSource -- where the PowerGovernor gets its inputs
+//
+// The governor never queries the OS directly. The Win32 source reads
+// GetSystemPowerStatus / GetLastInputInfo; the scripted source plays
+// back a fixed timeline so the policy engine can be driven headlessly.
+// ------------------------------------------------------------------
+
+class IPowerSignalSource {
+public:
+    virtual ~IPowerSignalSource() = default;
+
+    // Sample current signals. nowUs is the utils::MonotonicMicros()
+    // clock. Returns false if the sample is unavailable (the governor
+    // keeps its previous decision).
+    virtual bool Poll(uint64_t nowUs, PowerSignals& out) = 0;
+};
+
+// ------------------------------------------------------------------
+// ScriptedPowerSignalSource -- timeline of signal snapshots
+//
+// Each step takes effect at its offset (relative to the first Poll)
+// and holds until the next step. userIdleMs is advanced by real
+// elapsed time within a step unless the step resets it.
+// ------------------------------------------------------------------
+
+class ScriptedPowerSignalSource final : public IPowerSignalSource {
+public:
+    // Append a step. Steps must be added in increasing offset order.
+    void AddStep(uint64_t offsetUs, const PowerSignals& signals);
+
+    bool Poll(uint64_t nowUs, PowerSignals& out) override;
+
+private:
+    struct Step {
+        uint64_t     offsetUs = 0;
+        PowerSignals signals;
+    };
+
+    std::vector<Step> m_steps;
+    uint64_t          m_startUs = 0;
+    bool              m_started = false;
+};
+
+// ------------------------------------------------------------------
+// Platform source (Win32 on Windows, always-AC elsewhere)
+// ------------------------------------------------------------------
+
+std::unique_ptr<IPowerSignalSource> CreatePlatformPowerSignalSource();
+
+} // namespace runtime
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "core/animation/AnimationTypes.h"
+
+#include <cstdint>
+
+namespace dmme {
+namespace core {
+namespace runtime {
+
+// ------------------------------------------------------------------
+// Raw power signals (sampled by an IPowerSignalSource)
+// ------------------------------------------------------------------
+
+struct PowerSignals {
+    bool     onBattery        = false;  // false = AC / unknown
+    bool     batterySaver     = false;  // OS battery/energy saver active
+    int      batteryPercent   = 100;    // 0-100, 100 if unknown
+    uint32_t userIdleMs       = 0;      // time since last user input
+    bool     thermalThrottled = false;  // platform reports thermal pressure
+};
+
+// ------------------------------------------------------------------
+// Power tiers, from most to least expensive
+// ------------------------------------------------------------------
+
+enum class PowerTier : uint8_t {
+    Performance = 0,   // on AC, user active
+    Balanced    = 1,   // on battery
+    Saver       = 2,   // battery saver, low battery or thermal pressure
+    Idle        = 3    // user away
+};
+
+inline const char* PowerTierName(PowerTier tier) {
+    switch (tier) {
+        case PowerTier::Performance: return "Performance";
+        case PowerTier::Balanced:    return "Balanced";
+        case PowerTier::Saver:       return "Saver";
+        case PowerTier::Idle:        return "Idle";
+        default:                     return "Unknown";
+    }
+}
+
+// ------------------------------------------------------------------
+// The policy the governor hands to the frame loop
+// ------------------------------------------------------------------
+
+struct PowerPolicy {
+    float                      targetFps       = 60.0f;
+    float                      resolutionScale = 1.0f;   // render target scale (0.25 - 1.0)
+    animation::AnimationDetail animationDetail = animation::AnimationDetail::Full;
+};
+
+} // namespace runtime
+} // namespace core
+} // namespace dmme
\ No newline at end of file
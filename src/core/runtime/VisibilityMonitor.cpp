@@ -0,0 +1,191 @@
+#include "VisibilityMonitor.h"
+#include "utils/Logger.h"
+
+#include <algorithm>
+
+namespace dmme {
+namespace core {
+namespace runtime {
+
+// ===================================================================
+// Construction
+// ===================================================================
+
+VisibilityMonitor::VisibilityMonitor(std::unique_ptr<IVisibilitySignalSource> source,
+                                     const VisibilityMonitorConfig& config)
+    : m_source(std::move(source))
+    , m_config(config) {
+    DMME_LOG_DEBUG("VisibilityMonitor created (heartbeat={:.1f} fps, debounce={} ms)",
+                   m_config.heartbeatFps, m_config.hideDebounceUs / 1000);
+}
+
+// ===================================================================
+// Update
+// ===================================================================
+
+bool VisibilityMonitor::Update(uint64_t nowUs) {
+    if (!m_source) {
+        return false;
+    }
+
+    if (m_polledOnce && nowUs - m_lastPollUs < m_config.pollIntervalUs) {
+        return false;
+    }
+    m_lastPollUs = nowUs;
+    m_polledOnce = true;
+
+    VisibilitySignals sample;
+    if (!m_source->Poll(nowUs, sample)) {
+        return false;
+    }
+    m_signals = sample;
+
+    const VisibilityState desired = Classify(m_signals);
+
+    if (desired == m_state) {
+        m_pendingState   = m_state;
+        m_pendingSinceUs = 0;
+        return false;
+    }
+
+    // Becoming visible (or less hidden): immediate
+    if (static_cast<uint8_t>(desired) < static_cast<uint8_t>(m_state)) {
+        Transition(desired, nowUs);
+        return true;
+    }
+
+    // Becoming hidden: debounce
+    if (desired != m_pendingState || m_pendingSinceUs == 0) {
+        m_pendingState   = desired;
+        m_pendingSinceUs = nowUs;
+        return false;
+    }
+
+    if (nowUs - m_pendingSinceUs >= m_config.hideDebounceUs) {
+        Transition(desired, nowUs);
+        return true;
+    }
+
+    return false;
+}
+
+// ===================================================================
+// Frame Gating
+// ===================================================================
+
+bool VisibilityMonitor::ShouldRenderFrame(uint64_t nowUs) {
+    bool render = false;
+
+    switch (m_state) {
+        case VisibilityState::Visible:
+            render = true;
+            break;
+
+        case VisibilityState::Heartbeat: {
+            if (m_config.heartbeatFps <= 0.0f) break;
+            const uint64_t periodUs =
+                static_cast<uint64_t>(1000000.0f / m_config.heartbeatFps);
+            render = (m_lastFrameUs == 0 || nowUs - m_lastFrameUs >= periodUs);
+            break;
+        }
+
+        case VisibilityState::Suspended:
+        default:
+            render = false;
+            break;
+    }
+
+    if (!render) {
+        m_skippedFrames++;
+    }
+    return render;
+}
+
+void VisibilityMonitor::NotifyFrameRendered(uint64_t nowUs) {
+    m_lastFrameUs = nowUs;
+
+    if (m_resumeFramePending) {
+        m_resumeFramePending = false;
+        DMME_LOG_DEBUG("VisibilityMonitor: resume frame presented");
+    }
+}
+
+float VisibilityMonitor::GetLoopFps(float visibleFps) const {
+    switch (m_state) {
+        case VisibilityState::Visible:
+            return visibleFps;
+        case VisibilityState::Heartbeat:
+            // Loop fast enough to notice a resume promptly; heartbeat
+            // frames are gated separately by ShouldRenderFrame
+            return std::max(m_config.hiddenLoopFps, m_config.heartbeatFps);
+        case VisibilityState::Suspended:
+        default:
+            return m_config.hiddenLoopFps;
+    }
+}
+
+// ===================================================================
+// Queries
+// ===================================================================
+
+VisibilityState VisibilityMonitor::GetState() const {
+    return m_state;
+}
+
+bool VisibilityMonitor::IsVisible() const {
+    return m_state == VisibilityState::Visible;
+}
+
+bool VisibilityMonitor::IsResumeFramePending() const {
+    return m_resumeFramePending;
+}
+
+const VisibilitySignals& VisibilityMonitor::GetLastSignals() const {
+    return m_signals;
+}
+
+uint64_t VisibilityMonitor::GetSuspendedFrameCount() const {
+    return m_skippedFrames;
+}
+
+// ===================================================================
+// Internal
+// ===================================================================
+
+VisibilityState VisibilityMonitor::Classify(const VisibilitySignals& s) const {
+    if (s.sessionLocked || s.displayOff || s.overlayHidden) {
+        return VisibilityState::Suspended;
+    }
+    if (s.fullscreenApp || s.occluded) {
+        return (m_config.heartbeatFps > 0.0f)
+            ? VisibilityState::Heartbeat : VisibilityState::Suspended;
+    }
+    return VisibilityState::Visible;
+}
+
+void VisibilityMonitor::Transition(VisibilityState next, uint64_t /*nowUs*/) {
+    DMME_LOG_INFO("Visibility: {} -> {} (locked={} displayOff={} hidden={} fullscreen={} occluded={})",
+                  VisibilityStateName(m_state), VisibilityStateName(next),
+                  m_signals.sessionLocked, m_signals.displayOff,
+                  m_signals.overlayHidden, m_signals.fullscreenApp,
+                  m_signals.occluded);
+
+    if (next == VisibilityState::Visible && m_state != VisibilityState::Visible) {
+        // One fresh frame right now, regardless of pacing
+        m_resumeFramePending = true;
+    }
+
+    m_state          = next;
+    m_pendingState   = next;
+    m_pendingSinceUs = 0;
+
+    if (next != VisibilityState::Visible) {
+        // First heartbeat fires immediately so the layered window
+        // holds a current image while hidden
+        m_lastFrameUs = 0;
+    }
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "VisibilitySignalSource.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace dmme {
+namespace core {
+namespace runtime {
+
+// ------------------------------------------------------------------
+// Visibility states
+// ------------------------------------------------------------------
+
+enum class VisibilityState : uint8_t {
+    Visible   = 0,   // render at the normal (governor) rate
+    Heartbeat = 1,   // covered by a fullscreen app: render rarely
+    Suspended = 2    // locked / display off / hidden: no rendering
+};
+
+inline const char* VisibilityStateName(VisibilityState state) {
+    switch (state) {
+        case VisibilityState::Visible:   return "Visible";
+        case VisibilityState::Heartbeat: return "Heartbeat";
+        case VisibilityState::Suspended: return "Suspended";
+        default:                         return "Unknown";
+    }
+}
+
+struct VisibilityMonitorConfig {
+    // Render rate while covered by a fullscreen app. 0 = suspend
+    // entirely instead of heartbeating.
+    float    heartbeatFps    = 1.0f;
+
+    // Main loop rate while not rendering (message pump + polling).
+    // Also bounds how quickly a resume is noticed.
+    float    hiddenLoopFps   = 10.0f;
+
+    // How often the signal source is sampled
+    uint64_t pollIntervalUs  = 100000;    // 100 ms
+
+    // Hidden signals must persist this long before rendering stops,
+    // so alt-tabbing through a fullscreen window does not flicker.
+    // Becoming visible is never debounced.
+    uint64_t hideDebounceUs  = 500000;    // 500 ms
+};
+
+// VisibilityMonitor stops the mascot from rendering, reading back and
+// presenting when nobody can see it: session locked, display off,
+// overlay hidden (Suspended), or a fullscreen game/video on top
+// (Heartbeat -- a trickle of frames keeps animation state and the
+// layered window current).
+//
+// On the transition back to Visible the monitor requests exactly one
+// immediate frame (ShouldRenderFrame returns true right away) so the
+// first thing the user sees is fresh, not a stale pre-lock image.
+// IsResumeFramePending stays true until that frame is presented, so
+// the loop can skip pacing and partial readback for it.
+//
+// Like PowerGovernor, it takes its inputs from an interface and is
+// driven by the main loop; a ScriptedVisibilitySignalSource can drive
+// it deterministically.
+//
+// Usage:
+//   VisibilityMonitor visibility(CreatePlatformVisibilitySignalSource(hwnd));
+//   // per loop iteration:
+//   if (visibility.Update(now)) {
+//       pacer.SetTargetFps(visibility.GetLoopFps(policy.targetFps));
+//       if (visibility.IsResumeFramePending()) pacer.Reset();
+//   }
+//   if (visibility.ShouldRenderFrame(now)) {
+//       ...render, readback, present...
+//       visibility.NotifyFrameRendered(now);
+//   }
+
+class VisibilityMonitor {
+public:
+    explicit VisibilityMonitor(std::unique_ptr<IVisibilitySignalSource> source,
+                               const VisibilityMonitorConfig& config = {});
+    ~VisibilityMonitor() = default;
+
+    VisibilityMonitor(const VisibilityMonitor&) = delete;
+    VisibilityMonitor& operator=(const VisibilityMonitor&) = delete;
+
+    // Sample signals (at most once per poll interval) and advance the
+    // state machine. Returns true if the state changed.
+    bool Update(uint64_t nowUs);
+
+    // Should the loop render/readback/present this iteration?
+    // Iterations answered "no" are counted as skipped frames.
+    bool ShouldRenderFrame(uint64_t nowUs);
+
+    // Tell the monitor a frame was presented (resets heartbeat timer,
+    // clears a pending resume frame).
+    void NotifyFrameRendered(uint64_t nowUs);
+
+    // Loop rate for the current state; visibleFps is returned when
+    // Visible (normally the governor's target).
+    float GetLoopFps(float visibleFps) const;
+
+    // --- Queries ---
+    VisibilityState          GetState() const;
+    bool                     IsVisible() const;
+    bool                     IsResumeFramePending() const;
+    const VisibilitySignals& GetLastSignals() const;
+    uint64_t                 GetSuspendedFrameCount() const;  // frames skipped
+
+private:
+    VisibilityState Classify(const VisibilitySignals& s) const;
+    void            Transition(VisibilityState next, uint64_t nowUs);
+
+    std::unique_ptr<IVisibilitySignalSource> m_source;
+    VisibilityMonitorConfig m_config;
+
+    VisibilitySignals m_signals;
+    VisibilityState   m_state           = VisibilityState::Visible;
+    VisibilityState   m_pendingState    = VisibilityState::Visible;
+    uint64_t          m_pendingSinceUs  = 0;
+    uint64_t          m_lastPollUs      = 0;
+    bool              m_polledOnce      = false;
+
+    uint64_t          m_lastFrameUs     = 0;
+    bool              m_resumeFramePending = false;
+    uint64_t          m_skippedFrames   = 0;
+};
+
+} // namespace runtime
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include "VisibilitySignalSource.h"
+#include "utils/Logger.h"
+
+#if defined(_WIN32)
+#include <Windows.h>
+#include <shellapi.h>
+#endif
+
+namespace dmme {
+namespace core {
+namespace runtime {
+
+// ===================================================================
+// ScriptedVisibilitySignalSource
+// ===================================================================
+
+void ScriptedVisibilitySignalSource::AddStep(uint64_t offsetUs,
+                                             const VisibilitySignals& signals) {
+    if (!m_steps.empty() && offsetUs < m_steps.back().offsetUs) {
+        DMME_LOG_WARN("ScriptedVisibilitySignalSource: step at {} us out of order, ignored",
+                      offsetUs);
+        return;
+    }
+    m_steps.push_back({offsetUs, signals});
+}
+
+bool ScriptedVisibilitySignalSource::Poll(uint64_t nowUs, VisibilitySignals& out) {
+    if (m_steps.empty()) {
+        return false;
+    }
+
+    if (!m_started) {
+        m_startUs = nowUs;
+        m_started = true;
+    }
+
+    const uint64_t offset = nowUs - m_startUs;
+
+    size_t index = 0;
+    for (size_t i = 0; i < m_steps.size(); ++i) {
+        if (m_steps[i].offsetUs <= offset) {
+            index = i;
+        } else {
+            break;
+        }
+    }
+
+    out = m_steps[index].signals;
+    return true;
+}
+
+// ===================================================================
+// Win32 Visibility Signal Source
+// ===================================================================
+
+#if defined(_WIN32)
+
+class Win32VisibilitySignalSource final : public IVisibilitySignalSource {
+public:
+    explicit Win32VisibilitySignalSource(HWND overlay) : m_overlay(overlay) {}
+
+    bool Poll(uint64_t /*nowUs*/, VisibilitySignals& out) override {
+        out = {};
+
+        // --- Session lock ---
+        // While the lock screen or a secure desktop (UAC) is up, the
+        // input desktop is not "Default" or cannot be opened at all.
+        HDESK desk = OpenInputDesktop(0, FALSE, DESKTOP_READOBJECTS);
+        if (!desk) {
+            out.sessionLocked = true;
+        } else {
+            wchar_t name[64] = {};
+            DWORD needed = 0;
+            if (GetUserObjectInformationW(desk, UOI_NAME, name, sizeof(name), &needed)) {
+                out.sessionLocked = (_wcsicmp(name, L"Default") != 0);
+            }
+            CloseDesktop(desk);
+        }
+
+        // --- Fullscreen applications ---
+        // QUNS_BUSY covers borderless fullscreen windows (browsers,
+        // video players); D3D_FULL_SCREEN covers exclusive mode games.
+        QUERY_USER_NOTIFICATION_STATE state{};
+        if (SUCCEEDED(SHQueryUserNotificationState(&state))) {
+            out.fullscreenApp = (state == QUNS_BUSY ||
+                                 state == QUNS_RUNNING_D3D_FULL_SCREEN ||
+                                 state == QUNS_PRESENTATION_MODE);
+        }
+
+        // Our own window can trip QUNS_BUSY only if it spans the
+        // monitor; never treat the mascot as the fullscreen app.
+        if (out.fullscreenApp && m_overlay && GetForegroundWindow() == m_overlay) {
+            out.fullscreenApp = false;
+        }
+
+        // --- Overlay window state ---
+        if (m_overlay) {
+            out.overlayHidden = !IsWindowVisible(m_overlay) || IsIconic(m_overlay);
+        }
+
+        return true;
+    }
+
+private:
+    HWND m_overlay = nullptr;
+};
+
+std::unique_ptr<IVisibilitySignalSource> CreatePlatformVisibilitySignalSource(HWND overlay) {
+    return std::make_unique<Win32VisibilitySignalSource>(overlay);
+}
+
+#else
+
+// Non-Windows builds have no desktop to observe; always visible.
+class NullVisibilitySignalSource final : public IVisibilitySignalSource {
+public:
+    bool Poll(uint64_t /*nowUs*/, VisibilitySignals& out) override {
+        out = {};
+        return true;
+    }
+};
+
+std::unique_ptr<IVisibilitySignalSource> CreatePlatformVisibilitySignalSource(HWND /*overlay*/) {
+    return std::make_unique<NullVisibilitySignalSource>();
+}
+
+#endif
+
+} // namespace runtime
+} // namespace core
+} // namespace dmme
\ No newline at end of file
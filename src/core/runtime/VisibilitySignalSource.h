@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Forward declare Windows handle type without including Windows.h
+struct HWND__;
+typedef HWND__* HWND;
+
+namespace dmme {
+namespace core {
+namespace runtime {
+
+// ------------------------------------------------------------------
+// Raw visibility signals (sampled by an IVisibilitySignalSource)
+// ------------------------------------------------------------------
+
+struct VisibilitySignals {
+    bool sessionLocked  = false;  // lock screen, secure desktop (UAC)
+    bool displayOff     = false;  // monitor powered down
+    bool overlayHidden  = false;  // our window hidden or minimized
+    bool fullscreenApp  = false;  // fullscreen game / video / presentation
+    bool occluded       = false;  // compositor reports overlay fully covered
+};
+
+// ------------------------------------------------------------------
+// IVisibilitySignalSource -- where the VisibilityMonitor gets inputs
+//
+// The Win32 source polls the input desktop, the shell notification
+// state and the overlay window. The scripted source plays back a
+// fixed timeline so the state machine can be driven headlessly.
+// ------------------------------------------------------------------
+
+class IVisibilitySignalSource {
+public:
+    virtual ~IVisibilitySignalSource() = default;
+
+    // Sample current signals. nowUs is the utils::MonotonicMicros()
+    // clock. Returns false if unavailable (monitor keeps its state).
+    virtual bool Poll(uint64_t nowUs, VisibilitySignals& out) = 0;
+};
+
+// ------------------------------------------------------------------
+// ScriptedVisibilitySignalSource -- timeline of signal snapshots
+// ------------------------------------------------------------------
+
+class ScriptedVisibilitySignalSource final : public IVisibilitySignalSource {
+public:
+    // Append a step taking effect offsetUs after the first Poll.
+    // Steps must be added in increasing offset order.
+    void AddStep(uint64_t offsetUs, const VisibilitySignals& signals);
+
+    bool Poll(uint64_t nowUs, VisibilitySignals& out) override;
+
+private:
+    struct Step {
+        uint64_t          offsetUs = 0;
+        VisibilitySignals signals;
+    };
+
+    std::vector<Step> m_steps;
+    uint64_t          m_startUs = 0;
+    bool              m_started = false;
+};
+
+// ------------------------------------------------------------------
+// Platform source (Win32 on Windows, always-visible elsewhere)
+// overlay: the mascot window, used for hidden/minimized checks and to
+// exclude ourselves from fullscreen detection. May be null.
+// ------------------------------------------------------------------
+
+std::unique_ptr<IVisibilitySignalSource> CreatePlatformVisibilitySignalSource(HWND overlay);
+
+} // namespace runtime
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -1,7 +1,6 @@
 #include "OpacityController.h"
 #include "utils/Logger.h"
 
-#include <algorithm>
 #include <cmath>
 
 namespace dmme {
@@ -12,26 +11,33 @@ namespace window {
 // Construction
 // ===================================================================
 
-OpacityController::OpacityController()
-    : m_currentOpacity(1.0f)
-    , m_targetOpacity(1.0f)
-    , m_fadeSpeed(0.0f)
-    , m_fading(false) {
+OpacityController::OpacityController(animation::TweenEngine& engine)
+    : m_engine(engine)
+    , m_channel(engine.CreateChannel(1.0f)) {
+    // Registered once; the engine invokes it in place for each event
+    m_engine.SetCompletionCallback(m_channel, [this](const animation::TweenEvent& event) {
+        if (!event.sequenceDone) {
+            return;
+        }
+        DMME_LOG_DEBUG("Fade completed: opacity={:.3f}", event.value);
+        if (m_fadeCompleteCallback) {
+            m_fadeCompleteCallback(event.value);
+        }
+    });
     DMME_LOG_DEBUG("OpacityController created (opacity=1.0)");
 }
 
+OpacityController::~OpacityController() {
+    m_engine.DestroyChannel(m_channel);
+}
+
 // ===================================================================
 // Immediate Set
 // ===================================================================
 
 void OpacityController::SetOpacity(float value) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-
     float clamped = Clamp01(value);
-    m_currentOpacity = clamped;
-    m_targetOpacity  = clamped;
-    m_fadeSpeed       = 0.0f;
-    m_fading          = false;
+    m_engine.SetValue(m_channel, clamped);
 
     DMME_LOG_DEBUG("Opacity set immediately to {:.3f}", clamped);
 }
@@ -40,37 +46,27 @@ void OpacityController::SetOpacity(float value) {
 // Animated Transitions
 // ===================================================================
 
-void OpacityController::FadeTo(float target, float durationSeconds) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-
+void OpacityController::FadeTo(float target, float durationSeconds, animation::Ease ease) {
     float clampedTarget = Clamp01(target);
 
     if (durationSeconds <= 0.0f) {
         // Zero or negative duration: apply immediately
-        m_currentOpacity = clampedTarget;
-        m_targetOpacity  = clampedTarget;
-        m_fadeSpeed       = 0.0f;
-        m_fading          = false;
+        m_engine.SetValue(m_channel, clampedTarget);
         DMME_LOG_DEBUG("FadeTo instant (duration<=0): opacity={:.3f}", clampedTarget);
         return;
     }
 
-    float diff = clampedTarget - m_currentOpacity;
-    if (std::fabs(diff) < 0.001f) {
+    const float current = m_engine.GetValue(m_channel);
+    if (std::fabs(clampedTarget - current) < 0.001f) {
         // Already at target, nothing to do
-        m_currentOpacity = clampedTarget;
-        m_targetOpacity  = clampedTarget;
-        m_fadeSpeed       = 0.0f;
-        m_fading          = false;
+        m_engine.SetValue(m_channel, clampedTarget);
         return;
     }
 
-    m_targetOpacity = clampedTarget;
-    m_fadeSpeed     = diff / durationSeconds;  // can be negative for fade-out
-    m_fading        = true;
+    m_engine.TweenTo(m_channel, clampedTarget, durationSeconds, ease);
 
-    DMME_LOG_DEBUG("FadeTo started: {:.3f} -> {:.3f} over {:.2f}s (speed={:.4f}/s)",
-                   m_currentOpacity, clampedTarget, durationSeconds, m_fadeSpeed);
+    DMME_LOG_DEBUG("FadeTo started: {:.3f} -> {:.3f} over {:.2f}s ({})",
+                   current, clampedTarget, durationSeconds, animation::EaseName(ease));
 }
 
 void OpacityController::FadeIn(float durationSeconds) {
@@ -81,85 +77,29 @@ void OpacityController::FadeOut(float durationSeconds) {
     FadeTo(0.0f, durationSeconds);
 }
 
-// ===================================================================
-// Frame Update
-// ===================================================================
-
-void OpacityController::Update(float deltaSeconds) {
-    FadeCompleteCallback completeCb;
-
-    {
-        std::lock_guard<std::mutex> lock(m_mutex);
-
-        if (!m_fading) {
-            return;
-        }
-
-        if (deltaSeconds <= 0.0f) {
-            return;
-        }
-
-        m_currentOpacity += m_fadeSpeed * deltaSeconds;
-
-        // Check if we reached or passed the target
-        bool reached = false;
-        if (m_fadeSpeed > 0.0f) {
-            // Fading in (increasing)
-            if (m_currentOpacity >= m_targetOpacity) {
-                m_currentOpacity = m_targetOpacity;
-                reached = true;
-            }
-        } else {
-            // Fading out (decreasing)
-            if (m_currentOpacity <= m_targetOpacity) {
-                m_currentOpacity = m_targetOpacity;
-                reached = true;
-            }
-        }
-
-        // Safety clamp
-        m_currentOpacity = Clamp01(m_currentOpacity);
-
-        if (reached) {
-            m_fading    = false;
-            m_fadeSpeed = 0.0f;
-            DMME_LOG_DEBUG("Fade completed: opacity={:.3f}", m_currentOpacity);
-
-            if (m_fadeCompleteCallback) {
-                completeCb = m_fadeCompleteCallback;
-            }
-        }
-    }
-
-    // Fire callback outside lock to prevent deadlocks
-    if (completeCb) {
-        completeCb(m_currentOpacity);
-    }
-}
-
 // ===================================================================
 // Queries
 // ===================================================================
 
 float OpacityController::GetCurrentOpacity() const {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    return m_currentOpacity;
+    // Overshooting curves (OutBack) may leave [0, 1] mid-fade
+    return Clamp01(m_engine.GetValue(m_channel));
 }
 
 uint8_t OpacityController::GetCurrentAlpha() const {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    float clamped = Clamp01(m_currentOpacity);
-    return static_cast<uint8_t>(clamped * 255.0f + 0.5f);
+    return static_cast<uint8_t>(GetCurrentOpacity() * 255.0f + 0.5f);
 }
 
 float OpacityController::GetTargetOpacity() const {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    return m_targetOpacity;
+    return m_engine.GetFinalValue(m_channel);
 }
 
 bool OpacityController::IsFading() const {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    return m_fading;
+    return m_engine.IsAnimating(m_channel);
+}
+
+animation::TweenChannel OpacityController::GetChannel() const {
+    return m_channel;
 }
 
 // ===================================================================
@@ -167,7 +107,6 @@ bool OpacityController::IsFading() const {
 // ===================================================================
 
 void OpacityController::SetFadeCompleteCallback(FadeCompleteCallback cb) {
-    std::lock_guard<std::mutex> lock(m_mutex);
     m_fadeCompleteCallback = std::move(cb);
 }
 
@@ -175,7 +114,7 @@ void OpacityController::SetFadeCompleteCallback(FadeCompleteCallback cb) {
 // Internal
 // ===================================================================
 
-float OpacityController::Clamp01(float v) const {
+float OpacityController::Clamp01(float v) {
     if (v < 0.0f) return 0.0f;
     if (v > 1.0f) return 1.0f;
     return v;
@@ -1,9 +1,9 @@
 #pragma once
 
+#include "core/animation/TweenEngine.h"
+
 #include <cstdint>
 #include <functional>
-#include <mutex>
-#include <atomic>
 
 namespace dmme {
 namespace core {
@@ -11,24 +11,27 @@ namespace window {
 
 // OpacityController manages global window opacity with smooth fade
 // transitions. It does NOT directly call Win32 APIs. Instead, it
-// computes the current alpha value each frame, and the owner
+// exposes the current alpha value each frame, and the owner
 // (TransparentWindow) reads that value and applies it.
 //
-// This separation means OpacityController is testable without a
-// real window, and can be reused in any context that needs a
-// smooth 0-255 alpha ramp.
+// It is a thin handle over one TweenEngine channel: fades are ordinary
+// tweens, advanced by the engine's batched Update together with every
+// other animated property, and completion is reported through the
+// engine's deferred event list. The handle holds no lock; use it on
+// the thread that updates the engine.
 //
 // Usage:
-//   controller.SetTargetOpacity(0.0f);   // start fade-out
+//   OpacityController controller(tweens);
+//   controller.FadeTo(0.0f, 0.5f);           // start fade-out
 //   // each frame:
-//   controller.Update(deltaTimeSeconds);
-//   uint8_t alpha = controller.GetCurrentAlpha();
-//   window.SetGlobalAlpha(alpha);
+//   tweens.Update(deltaTimeSeconds);
+//   tweens.DispatchEvents();
+//   window.SetGlobalAlpha(controller.GetCurrentAlpha());
 
 class OpacityController {
 public:
-    OpacityController();
-    ~OpacityController() = default;
+    explicit OpacityController(animation::TweenEngine& engine);
+    ~OpacityController();
 
     // Non-copyable
     OpacityController(const OpacityController&) = delete;
@@ -45,7 +48,8 @@ public:
     // Begin a smooth transition to the target opacity.
     // target: 0.0 to 1.0
     // durationSeconds: how long the transition takes (> 0)
-    void FadeTo(float target, float durationSeconds);
+    void FadeTo(float target, float durationSeconds,
+                animation::Ease ease = animation::Ease::Linear);
 
     // Convenience: fade to fully visible
     void FadeIn(float durationSeconds);
@@ -53,12 +57,6 @@ public:
     // Convenience: fade to fully invisible
     void FadeOut(float durationSeconds);
 
-    // --- Frame Update ---
-
-    // Call once per frame. Advances any active fade transition.
-    // deltaSeconds: time since last frame (e.g., 0.016 for 60fps)
-    void Update(float deltaSeconds);
-
     // --- Queries ---
 
     // Current opacity as float [0.0, 1.0]
@@ -73,22 +71,22 @@ public:
     // Is a fade transition currently in progress?
     bool IsFading() const;
 
+    // Underlying channel, for sequencing fades with Then()
+    animation::TweenChannel GetChannel() const;
+
     // --- Callback ---
 
-    // Called when a fade transition completes.
+    // Called from TweenEngine::DispatchEvents when a fade (including
+    // any queued follow-up segments) completes.
     using FadeCompleteCallback = std::function<void(float finalOpacity)>;
     void SetFadeCompleteCallback(FadeCompleteCallback cb);
 
 private:
-    float Clamp01(float v) const;
-
-    float m_currentOpacity   = 1.0f;
-    float m_targetOpacity    = 1.0f;
-    float m_fadeSpeed        = 0.0f;   // units per second
-    bool  m_fading           = false;
+    static float Clamp01(float v);
 
-    FadeCompleteCallback m_fadeCompleteCallback;
-    mutable std::mutex   m_mutex;
+    animation::TweenEngine& m_engine;
+    animation::TweenChannel m_channel;
+    FadeCompleteCallback    m_fadeCompleteCallback;
 };
 
 } // namespace window
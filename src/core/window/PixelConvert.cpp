@@ -0,0 +1,75 @@
+#include "PixelConvert.h"
+#include "PixelFormat.h"
+
+#include <cstddef>
+
+namespace dmme {
+namespace core {
+namespace window {
+
+namespace {
+
+// One RGBA (straight) pixel -> BGRA (premultiplied)
+inline void ConvertPixel(const uint8_t* in, uint8_t* out) {
+    const uint8_t a = in[3];
+
+    if (a == 255) {
+        // Fully opaque: no multiplication needed, just swizzle
+        out[0] = in[2];
+        out[1] = in[1];
+        out[2] = in[0];
+        out[3] = 255;
+    } else if (a == 0) {
+        // Fully transparent: zero everything
+        out[0] = 0;
+        out[1] = 0;
+        out[2] = 0;
+        out[3] = 0;
+    } else {
+        // Premultiply: channel * alpha / 255
+        // Using (channel * alpha + 127) / 255 for better rounding
+        out[0] = static_cast<uint8_t>((in[2] * a + 127) / 255);
+        out[1] = static_cast<uint8_t>((in[1] * a + 127) / 255);
+        out[2] = static_cast<uint8_t>((in[0] * a + 127) / 255);
+        out[3] = a;
+    }
+}
+
+} // anonymous namespace
+
+// ===================================================================
+// Same Size
+// ===================================================================
+
+void ConvertRGBAToBGRAPremul(const uint8_t* src, int w, int h, int srcStride,
+                             uint8_t* dst) {
+    // Same result as ConvertPixel, through the vectorised kernel
+    ConvertPixels(PixelFormat::RGBA8_UNORM, src, static_cast<size_t>(srcStride),
+                  PixelFormat::BGRA8_UNORM_PREMUL, dst, 0, w, h);
+}
+
+// ===================================================================
+// Scaled (nearest neighbour)
+// ===================================================================
+
+void ConvertRGBAToBGRAPremulScaled(const uint8_t* src, int srcW, int srcH, int srcStride,
+                                   uint8_t* dst, int dstW, int dstH) {
+    const uint32_t stepX = (static_cast<uint32_t>(srcW) << 16) / static_cast<uint32_t>(dstW);
+
+    for (int y = 0; y < dstH; ++y) {
+        const int sy = static_cast<int>(static_cast<int64_t>(y) * srcH / dstH);
+        const uint8_t* srcRow = src + static_cast<size_t>(sy) * srcStride;
+        uint8_t*       out    = dst + static_cast<size_t>(y) * dstW * 4;
+
+        uint32_t fx = stepX >> 1;  // sample pixel centres
+        for (int x = 0; x < dstW; ++x) {
+            ConvertPixel(srcRow + static_cast<size_t>(fx >> 16) * 4, out);
+            out += 4;
+            fx  += stepX;
+        }
+    }
+}
+
+} // namespace window
+} // namespace core
+} // namespace dmme
\ No newline at end of file
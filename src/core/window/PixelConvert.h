@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+namespace dmme {
+namespace core {
+namespace window {
+
+// Renderer -> layered window pixel conversion.
+//
+// The renderer produces RGBA8 with straight alpha; UpdateLayeredWindow
+// wants BGRA8 with premultiplied alpha. These are the conversions
+// TransparentWindow runs on every frame. They are platform-neutral so
+// the exact bytes a window would present can be produced (and compared
+// against golden images) without a window.
+//
+// Premultiply rounding: (c * a + 127) / 255. Fully opaque pixels are
+// only swizzled and fully transparent pixels become all-zero.
+//
+// Source rows are srcStride bytes apart (>= width * 4); the
+// destination is tightly packed.
+
+// Same-size conversion, w x h
+void ConvertRGBAToBGRAPremul(const uint8_t* src, int w, int h, int srcStride,
+                             uint8_t* dst);
+
+// Nearest-neighbour upscale from srcW x srcH to dstW x dstH with the
+// same conversion. Source columns are stepped in 16.16 fixed point.
+void ConvertRGBAToBGRAPremulScaled(const uint8_t* src, int srcW, int srcH, int srcStride,
+                                   uint8_t* dst, int dstW, int dstH);
+
+} // namespace window
+} // namespace core
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,399 @@
+#include "PixelFormat.h"
+#include "utils/Simd.h"
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace dmme {
+namespace core {
+namespace window {
+
+namespace {
+
+// ===================================================================
+// Encoding helpers
+// ===================================================================
+
+// sRGB decode table and exact encode thresholds: the encoded value of
+// x is the number of thresholds at or below it, found from a coarse
+// guess by stepping up (at most a few steps, near black)
+constexpr uint32_t kSrgbCoarse = 4096;
+
+struct SrgbTables {
+    float   decode[256];
+    float   threshold[256];             // decode((i + 0.5) / 255); [255] = above 1
+    uint8_t coarse[kSrgbCoarse + 1];    // encoded value of i / kSrgbCoarse
+};
+
+double SrgbToLinear(double c) {
+    return c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+}
+
+const SrgbTables& GetSrgbTables() {
+    static const SrgbTables tables = [] {
+        SrgbTables t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            t.decode[i]    = static_cast<float>(SrgbToLinear(i / 255.0));
+            t.threshold[i] = i < 255 ? static_cast<float>(SrgbToLinear((i + 0.5) / 255.0)) : 2.0f;
+        }
+        uint32_t value = 0;
+        for (uint32_t k = 0; k <= kSrgbCoarse; ++k) {
+            const float x = static_cast<float>(k) / kSrgbCoarse;
+            while (x >= t.threshold[value]) {
+                ++value;
+            }
+            t.coarse[k] = static_cast<uint8_t>(value);
+        }
+        return t;
+    }();
+    return tables;
+}
+
+inline uint8_t EncodeUnorm(float v) {
+    if (!(v > 0.0f)) {
+        return 0;       // also NaN
+    }
+    if (v >= 1.0f) {
+        return 255;
+    }
+    return static_cast<uint8_t>(v * 255.0f + 0.5f);
+}
+
+inline uint8_t EncodeSrgb(const SrgbTables& t, float v) {
+    if (!(v > 0.0f)) {
+        return 0;
+    }
+    if (v >= 1.0f) {
+        return 255;
+    }
+    uint32_t i = t.coarse[static_cast<uint32_t>(v * kSrgbCoarse)];
+    while (v >= t.threshold[i]) {
+        ++i;
+    }
+    return static_cast<uint8_t>(i);
+}
+
+// ===================================================================
+// Generic path (through linear float)
+// ===================================================================
+
+// Linear RGBA in the format's alpha mode
+template <PixelFormat F>
+inline void LoadPixel(const SrgbTables& t, const uint8_t* p, float c[4]) {
+    if constexpr (IsHalfFloat(F)) {
+        uint16_t h[4];
+        std::memcpy(h, p, sizeof(h));
+        for (int i = 0; i < 4; ++i) {
+            c[i] = HalfToFloat(h[i]);
+        }
+    } else {
+        for (int i = 0; i < 3; ++i) {
+            c[i] = IsSrgb(F) ? t.decode[p[i]] : p[i] * (1.0f / 255.0f);
+        }
+        c[3] = p[3] * (1.0f / 255.0f);
+    }
+    if constexpr (IsBgra(F)) {
+        std::swap(c[0], c[2]);
+    }
+}
+
+template <PixelFormat F>
+inline void StorePixel(const SrgbTables& t, float c[4], uint8_t* p) {
+    if constexpr (IsBgra(F)) {
+        std::swap(c[0], c[2]);
+    }
+    if constexpr (IsHalfFloat(F)) {
+        uint16_t h[4];
+        for (int i = 0; i < 4; ++i) {
+            h[i] = FloatToHalf(c[i]);
+        }
+        std::memcpy(p, h, sizeof(h));
+    } else {
+        for (int i = 0; i < 3; ++i) {
+            p[i] = IsSrgb(F) ? EncodeSrgb(t, c[i]) : EncodeUnorm(c[i]);
+        }
+        p[3] = EncodeUnorm(c[3]);
+    }
+}
+
+template <PixelFormat S, PixelFormat D>
+void ConvertGeneric(const uint8_t* src, uint8_t* dst, size_t count) {
+    const SrgbTables& t = GetSrgbTables();
+    for (size_t i = 0; i < count; ++i) {
+        float c[4];
+        LoadPixel<S>(t, src + i * GetPixelSize(S), c);
+        if constexpr (!IsPremultiplied(S) && IsPremultiplied(D)) {
+            c[0] *= c[3];
+            c[1] *= c[3];
+            c[2] *= c[3];
+        } else if constexpr (IsPremultiplied(S) && !IsPremultiplied(D)) {
+            if (c[3] != 0.0f) {
+                c[0] /= c[3];
+                c[1] /= c[3];
+                c[2] /= c[3];
+            } else {
+                c[0] = c[1] = c[2] = 0.0f;
+            }
+        }
+        StorePixel<D>(t, c, dst + i * GetPixelSize(D));
+    }
+}
+
+// ===================================================================
+// 8-bit kernels
+// ===================================================================
+
+#if defined(DMME_SIMD_SSE2)
+// Swap lanes 0 and 2 of each 4 x 16-bit pixel
+inline __m128i SwapRedBlueU16(__m128i p) {
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(p, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+}
+
+// Two pixels widened to 16 bits: colour * alpha / 255, alpha kept
+inline __m128i PremultiplyU16(__m128i p, __m128i alphaMask) {
+    const __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(p, _MM_SHUFFLE(3, 3, 3, 3)),
+                                          _MM_SHUFFLE(3, 3, 3, 3));
+    const __m128i c = utils::Div255RoundU16(_mm_mullo_epi16(p, a));
+    return _mm_or_si128(_mm_and_si128(alphaMask, p), _mm_andnot_si128(alphaMask, c));
+}
+#endif
+
+// RGBA <-> BGRA, nothing else changes (8-bit)
+void SwapRedBlue8(const uint8_t* src, uint8_t* dst, size_t count) {
+    size_t i = 0;
+#if defined(DMME_SIMD_SSE2)
+    const __m128i greenAlpha = _mm_set1_epi32(static_cast<int>(0xFF00FF00u));
+    const __m128i redBlue    = _mm_set1_epi32(0x00FF00FF);
+    for (; i + 4 <= count; i += 4) {
+        const __m128i p  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        const __m128i rb = _mm_and_si128(p, redBlue);
+        const __m128i out = _mm_or_si128(_mm_and_si128(p, greenAlpha),
+                                         _mm_or_si128(_mm_srli_epi32(rb, 16), _mm_slli_epi32(rb, 16)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), out);
+    }
+#endif
+    for (; i < count; ++i) {
+        const uint8_t* in  = src + i * 4;
+        uint8_t*       out = dst + i * 4;
+        out[0] = in[2];
+        out[1] = in[1];
+        out[2] = in[0];
+        out[3] = in[3];
+    }
+}
+
+// RGBA <-> BGRA for half floats
+void SwapRedBlue16(const uint8_t* src, uint8_t* dst, size_t count) {
+    size_t i = 0;
+#if defined(DMME_SIMD_SSE2)
+    for (; i + 2 <= count; i += 2) {
+        const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 8), SwapRedBlueU16(p));
+    }
+#endif
+    for (; i < count; ++i) {
+        uint16_t h[4];
+        std::memcpy(h, src + i * 8, sizeof(h));
+        std::swap(h[0], h[2]);
+        std::memcpy(dst + i * 8, h, sizeof(h));
+    }
+}
+
+// Straight -> premultiplied, linear 8-bit: (c * a + 127) / 255
+template <bool Swap>
+void Premultiply8(const uint8_t* src, uint8_t* dst, size_t count) {
+    size_t i = 0;
+#if defined(DMME_SIMD_SSE2)
+    const __m128i zero      = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    for (; i + 4 <= count; i += 4) {
+        const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        __m128i lo = PremultiplyU16(_mm_unpacklo_epi8(p, zero), alphaMask);
+        __m128i hi = PremultiplyU16(_mm_unpackhi_epi8(p, zero), alphaMask);
+        if constexpr (Swap) {
+            lo = SwapRedBlueU16(lo);
+            hi = SwapRedBlueU16(hi);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_packus_epi16(lo, hi));
+    }
+#endif
+    for (; i < count; ++i) {
+        const uint8_t* in  = src + i * 4;
+        uint8_t*       out = dst + i * 4;
+        const uint32_t a = in[3];
+        const uint8_t r = static_cast<uint8_t>(utils::Div255Round(in[0] * a));
+        const uint8_t g = static_cast<uint8_t>(utils::Div255Round(in[1] * a));
+        const uint8_t b = static_cast<uint8_t>(utils::Div255Round(in[2] * a));
+        out[0] = Swap ? b : r;
+        out[1] = g;
+        out[2] = Swap ? r : b;
+        out[3] = static_cast<uint8_t>(a);
+    }
+}
+
+// Premultiplied -> straight, linear 8-bit: round(c * 255 / a)
+template <bool Swap>
+void Unpremultiply8(const uint8_t* src, uint8_t* dst, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t* in  = src + i * 4;
+        uint8_t*       out = dst + i * 4;
+        const uint32_t a = in[3];
+        uint8_t c[3] = {0, 0, 0};
+        if (a != 0) {
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t v = (in[k] * 255u + a / 2) / a;
+                c[k] = static_cast<uint8_t>(v < 255u ? v : 255u);
+            }
+        }
+        out[0] = Swap ? c[2] : c[0];
+        out[1] = c[1];
+        out[2] = Swap ? c[0] : c[2];
+        out[3] = static_cast<uint8_t>(a);
+    }
+}
+
+// ===================================================================
+// Kernel selection
+// ===================================================================
+
+template <PixelFormat S, PixelFormat D>
+void ConvertKernel(const uint8_t* src, uint8_t* dst, size_t count) {
+    constexpr bool swap       = IsBgra(S) != IsBgra(D);
+    constexpr bool eightBit   = !IsHalfFloat(S) && !IsHalfFloat(D);
+    constexpr bool bothLinear = !IsSrgb(S) && !IsSrgb(D);
+    constexpr bool sameAlpha  = IsPremultiplied(S) == IsPremultiplied(D);
+
+    if constexpr (S == D) {
+        std::memcpy(dst, src, count * GetPixelSize(S));
+    } else if constexpr (eightBit && sameAlpha && IsSrgb(S) == IsSrgb(D)) {
+        SwapRedBlue8(src, dst, count);
+    } else if constexpr (IsHalfFloat(S) && IsHalfFloat(D) && sameAlpha) {
+        SwapRedBlue16(src, dst, count);
+    } else if constexpr (eightBit && bothLinear && IsPremultiplied(D)) {
+        Premultiply8<swap>(src, dst, count);
+    } else if constexpr (eightBit && bothLinear) {
+        Unpremultiply8<swap>(src, dst, count);
+    } else {
+        ConvertGeneric<S, D>(src, dst, count);
+    }
+}
+
+template <size_t... I>
+constexpr std::array<PixelConvertFn, sizeof...(I)> MakeConverterTable(std::index_sequence<I...>) {
+    return {{&ConvertKernel<static_cast<PixelFormat>(I / kPixelFormatCount),
+                            static_cast<PixelFormat>(I % kPixelFormatCount)>...}};
+}
+
+constexpr auto kConverters = MakeConverterTable(std::make_index_sequence<kPixelFormatCount * kPixelFormatCount>());
+
+constexpr const char* kFormatNames[kPixelFormatCount] = {
+    "RGBA8_UNORM", "RGBA8_UNORM_PREMUL", "BGRA8_UNORM", "BGRA8_UNORM_PREMUL",
+    "RGBA8_SRGB",  "RGBA8_SRGB_PREMUL",  "BGRA8_SRGB",  "BGRA8_SRGB_PREMUL",
+    "RGBA16_FLOAT", "RGBA16_FLOAT_PREMUL", "BGRA16_FLOAT", "BGRA16_FLOAT_PREMUL",
+};
+
+} // anonymous namespace
+
+// ===================================================================
+// Public API
+// ===================================================================
+
+const char* GetPixelFormatName(PixelFormat f) {
+    return f < PixelFormat::Count ? kFormatNames[static_cast<size_t>(f)] : "Unknown";
+}
+
+PixelConvertFn GetPixelConverter(PixelFormat src, PixelFormat dst) {
+    if (src >= PixelFormat::Count || dst >= PixelFormat::Count) {
+        return nullptr;
+    }
+    return kConverters[static_cast<size_t>(src) * kPixelFormatCount + static_cast<size_t>(dst)];
+}
+
+void ConvertPixels(PixelFormat srcFormat, const uint8_t* src, size_t srcStride,
+                   PixelFormat dstFormat, uint8_t* dst, size_t dstStride,
+                   int width, int height) {
+    const PixelConvertFn convert = GetPixelConverter(srcFormat, dstFormat);
+    if (!convert || width <= 0 || height <= 0) {
+        return;
+    }
+    const size_t w = static_cast<size_t>(width);
+    if (srcStride == 0) srcStride = w * GetPixelSize(srcFormat);
+    if (dstStride == 0) dstStride = w * GetPixelSize(dstFormat);
+    for (int y = 0; y < height; ++y) {
+        convert(src + static_cast<size_t>(y) * srcStride, dst + static_cast<size_t>(y) * dstStride, w);
+    }
+}
+
+// ===================================================================
+// Half floats
+// ===================================================================
+
+float HalfToFloat(uint16_t half) {
+    const uint32_t sign     = static_cast<uint32_t>(half & 0x8000u) << 16;
+    uint32_t       exponent = (half >> 10) & 0x1Fu;
+    uint32_t       mantissa = half & 0x3FFu;
+    uint32_t       bits;
+
+    if (exponent == 0x1F) {
+        bits = sign | 0x7F800000u | (mantissa << 13);          // inf / NaN
+    } else if (exponent != 0) {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    } else if (mantissa == 0) {
+        bits = sign;
+    } else {
+        // Subnormal: normalise into a float exponent
+        exponent = 113;
+        while ((mantissa & 0x400u) == 0) {
+            mantissa <<= 1;
+            --exponent;
+        }
+        bits = sign | (exponent << 23) | ((mantissa & 0x3FFu) << 13);
+    }
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+uint16_t FloatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint32_t sign = (bits >> 16) & 0x8000u;
+    const uint32_t abs  = bits & 0x7FFFFFFFu;
+
+    if (abs >= 0x7F800000u) {
+        return static_cast<uint16_t>(sign | 0x7C00u | (abs > 0x7F800000u ? 0x200u : 0u));
+    }
+    if (abs >= 0x477FF000u) {
+        return static_cast<uint16_t>(sign | 0x7C00u);          // 65520 and up round to inf
+    }
+
+    if (abs < 0x38800000u) {
+        // Below the smallest normal: count 2^-24 units, nearest even
+        const uint32_t shift = 126 - (abs >> 23);
+        if (shift > 24) {
+            return static_cast<uint16_t>(sign);
+        }
+        const uint32_t mantissa = (abs & 0x7FFFFFu) | 0x800000u;
+        uint32_t       h        = mantissa >> shift;
+        const uint32_t rest     = mantissa & ((1u << shift) - 1);
+        const uint32_t halfway  = 1u << (shift - 1);
+        if (rest > halfway || (rest == halfway && (h & 1u))) {
+            ++h;
+        }
+        return static_cast<uint16_t>(sign | h);
+    }
+
+    uint32_t       h    = ((abs >> 23) - 112) << 10 | ((abs >> 13) & 0x3FFu);
+    const uint32_t rest = abs & 0x1FFFu;
+    if (rest > 0x1000u || (rest == 0x1000u && (h & 1u))) {
+        ++h;        // may carry into the exponent, which is still correct
+    }
+    return static_cast<uint16_t>(sign | h);
+}
+
+} // namespace window
+} // namespace core
+} // namespace dmme
\ No newline at end of file
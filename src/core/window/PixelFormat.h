@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dmme {
+namespace core {
+namespace window {
+
+// ------------------------------------------------------------------
+// Formats
+// ------------------------------------------------------------------
+
+// CPU-side pixel layouts, each a combination of channel order, alpha
+// mode (straight or premultiplied), storage (8-bit unorm or half
+// float) and, for 8-bit storage, transfer (linear or sRGB). Half-float
+// formats are always linear.
+enum class PixelFormat : uint8_t {
+    RGBA8_UNORM = 0,
+    RGBA8_UNORM_PREMUL,
+    BGRA8_UNORM,
+    BGRA8_UNORM_PREMUL,         // layered windows (UpdateLayeredWindow)
+    RGBA8_SRGB,
+    RGBA8_SRGB_PREMUL,
+    BGRA8_SRGB,
+    BGRA8_SRGB_PREMUL,
+    RGBA16_FLOAT,
+    RGBA16_FLOAT_PREMUL,
+    BGRA16_FLOAT,
+    BGRA16_FLOAT_PREMUL,
+    Count
+};
+
+constexpr size_t kPixelFormatCount = static_cast<size_t>(PixelFormat::Count);
+
+constexpr bool IsHalfFloat(PixelFormat f) { return f >= PixelFormat::RGBA16_FLOAT && f < PixelFormat::Count; }
+constexpr bool IsSrgb(PixelFormat f)      { return f >= PixelFormat::RGBA8_SRGB && f <= PixelFormat::BGRA8_SRGB_PREMUL; }
+constexpr bool IsBgra(PixelFormat f)      { return (static_cast<uint32_t>(f) & 2u) != 0; }
+constexpr bool IsPremultiplied(PixelFormat f) { return (static_cast<uint32_t>(f) & 1u) != 0; }
+
+constexpr size_t GetPixelSize(PixelFormat f) { return IsHalfFloat(f) ? 8 : 4; }
+
+const char* GetPixelFormatName(PixelFormat f);
+
+// ------------------------------------------------------------------
+// Conversion
+// ------------------------------------------------------------------
+
+// Pixel conversion between any two formats.
+//
+// Every source / destination pair has its own kernel, generated from
+// one template at compile time, and the dispatch table below is the
+// only runtime branch. A pair resolves to the cheapest kernel that is
+// exact for it:
+//   - same format: copy
+//   - same alpha mode and transfer, same storage: red/blue swap (SSE2)
+//   - 8-bit linear straight -> premultiplied: multiply (SSE2), with
+//     the swap folded in
+//   - 8-bit linear premultiplied -> straight: integer divide
+//   - everything else: per pixel through linear float (sRGB by table,
+//     half floats by bit manipulation)
+//
+// Results are defined as: decode to linear light, convert the alpha
+// mode there (premultiply c * a, unpremultiply c / a, 0 where a is 0),
+// encode with round-to-nearest. 8-bit encoding clamps to [0, 1] (NaN
+// becomes 0); half encoding rounds to nearest even and does not clamp.
+// Premultiplying 8-bit linear values is therefore
+// (c * a + 127) / 255, as the layered-window path always did.
+
+// Converts count pixels; src and dst must not overlap
+using PixelConvertFn = void (*)(const uint8_t* src, uint8_t* dst, size_t count);
+
+PixelConvertFn GetPixelConverter(PixelFormat src, PixelFormat dst);
+
+// Rows are srcStride / dstStride bytes apart (0 = tightly packed)
+void ConvertPixels(PixelFormat srcFormat, const uint8_t* src, size_t srcStride,
+                   PixelFormat dstFormat, uint8_t* dst, size_t dstStride,
+                   int width, int height);
+
+// IEEE 754 binary16 <-> binary32 (round to nearest even)
+float    HalfToFloat(uint16_t half);
+uint16_t FloatToHalf(float value);
+
+} // namespace window
+} // namespace core
+} // namespace dmme
\ No newline at end of file
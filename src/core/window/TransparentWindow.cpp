@@ -1,6 +1,9 @@
 #include "TransparentWindow.h"
 #include "ClickThrough.h"
+#include "PixelConvert.h"
 #include "utils/Logger.h"
+#include "utils/Clock.h"
+#include "core/memory/AllocationTracker.h"
 
 #include <Windows.h>
 #include <dwmapi.h>
@@ -115,6 +118,7 @@ bool TransparentWindow::IsInitialized() const {
 // ===================================================================
 
 bool TransparentWindow::ProcessMessages() {
+    memory::AllocationScope allocScope(memory::AllocSubsystem::Window);
     MSG msg{};
     while (PeekMessageW(&msg, nullptr, 0, 0, PM_REMOVE)) {
         if (msg.message == WM_QUIT) {
@@ -131,7 +135,9 @@ bool TransparentWindow::ProcessMessages() {
 // Frame Update
 // ===================================================================
 
-bool TransparentWindow::UpdateFrame(const uint8_t* rgbaPixels, int w, int h) {
+bool TransparentWindow::UpdateFrame(const uint8_t* rgbaPixels, int w, int h,
+                                    int strideBytes) {
+    memory::AllocationScope allocScope(memory::AllocSubsystem::Window);
     if (!m_initialized || !m_hwnd) {
         DMME_LOG_ERROR("UpdateFrame called on uninitialized window");
         return false;
@@ -147,6 +153,13 @@ bool TransparentWindow::UpdateFrame(const uint8_t* rgbaPixels, int w, int h) {
         return false;
     }
 
+    if (strideBytes == 0) {
+        strideBytes = w * 4;
+    } else if (strideBytes < w * 4) {
+        DMME_LOG_ERROR("UpdateFrame stride {} is smaller than a {}-pixel row", strideBytes, w);
+        return false;
+    }
+
     // Reallocate back buffer if size changed
     if (w != m_bufW || h != m_bufH) {
         DMME_LOG_INFO("Back buffer resize: {}x{} -> {}x{}", m_bufW, m_bufH, w, h);
@@ -160,14 +173,84 @@ bool TransparentWindow::UpdateFrame(const uint8_t* rgbaPixels, int w, int h) {
 
     {
         std::lock_guard<std::mutex> lock(m_bufferMutex);
-        ConvertRGBAToBGRAPremul(rgbaPixels, w, h);
+        ConvertRGBAToBGRAPremul(rgbaPixels, w, h, strideBytes, m_pixels);
+    }
+
+    FinishFrameUpdate();
+    return true;
+}
+
+bool TransparentWindow::UpdateFrameScaled(const uint8_t* rgbaPixels, int srcW, int srcH,
+                                          int strideBytes) {
+    memory::AllocationScope allocScope(memory::AllocSubsystem::Window);
+    if (!m_initialized || !m_hwnd) {
+        DMME_LOG_ERROR("UpdateFrameScaled called on uninitialized window");
+        return false;
+    }
+
+    if (!rgbaPixels) {
+        DMME_LOG_ERROR("UpdateFrameScaled received null pixel pointer");
+        return false;
+    }
+
+    if (srcW <= 0 || srcH <= 0) {
+        DMME_LOG_ERROR("UpdateFrameScaled received invalid dimensions {}x{}", srcW, srcH);
+        return false;
+    }
+
+    if (strideBytes == 0) {
+        strideBytes = srcW * 4;
+    } else if (strideBytes < srcW * 4) {
+        DMME_LOG_ERROR("UpdateFrameScaled stride {} is smaller than a {}-pixel row",
+                       strideBytes, srcW);
+        return false;
+    }
+
+    // Same size: no scaling needed
+    if (srcW == m_width && srcH == m_height) {
+        return UpdateFrame(rgbaPixels, srcW, srcH, strideBytes);
+    }
+
+    // Back buffer always tracks the window size here
+    if (m_width != m_bufW || m_height != m_bufH) {
+        DMME_LOG_INFO("Back buffer resize: {}x{} -> {}x{}", m_bufW, m_bufH, m_width, m_height);
+        FreeBackBuffer();
+        if (!AllocateBackBuffer(m_width, m_height)) {
+            return false;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_bufferMutex);
+        ConvertRGBAToBGRAPremulScaled(rgbaPixels, srcW, srcH, strideBytes,
+                                      m_pixels, m_bufW, m_bufH);
+    }
+
+    FinishFrameUpdate();
+    return true;
+}
+
+void TransparentWindow::FinishFrameUpdate() {
+    m_lastPresentTiming.convertDoneUs = utils::MonotonicMicros();
+
+    if (m_overlayCallback) {
+        std::lock_guard<std::mutex> lock(m_bufferMutex);
+        m_overlayCallback(m_pixels, m_bufW, m_bufH);
     }
 
     // Update ClickThrough with current buffer state
     m_clickThrough->UpdateBuffer(m_pixels, m_bufW, m_bufH);
 
     ApplyLayeredUpdate();
-    return true;
+    m_lastPresentTiming.presentDoneUs = utils::MonotonicMicros();
+}
+
+PresentTiming TransparentWindow::GetLastPresentTiming() const {
+    return m_lastPresentTiming;
+}
+
+uint64_t TransparentWindow::GetPresentCount() const {
+    return m_presentCount;
 }
 
 // ===================================================================
@@ -321,6 +404,10 @@ void TransparentWindow::SetCloseCallback(CloseCallback cb) {
     m_closeCallback = std::move(cb);
 }
 
+void TransparentWindow::SetFrameOverlayCallback(FrameOverlayCallback cb) {
+    m_overlayCallback = std::move(cb);
+}
+
 // ===================================================================
 // Static Window Procedure (routes to instance)
 // ===================================================================
@@ -380,6 +467,7 @@ LRESULT TransparentWindow::InstanceWndProc(UINT msg, WPARAM wp, LPARAM lp) {
             evt.screenY = screenPt.y;
             evt.isDown  = true;
             evt.isMove  = false;
+            evt.timestampUs = utils::MonotonicMicros();
             if (msg == WM_LBUTTONDOWN) evt.button = MouseButton::Left;
             else if (msg == WM_RBUTTONDOWN) evt.button = MouseButton::Right;
             else evt.button = MouseButton::Middle;
@@ -401,6 +489,7 @@ LRESULT TransparentWindow::InstanceWndProc(UINT msg, WPARAM wp, LPARAM lp) {
             evt.screenY = screenPt.y;
             evt.isDown  = false;
             evt.isMove  = false;
+            evt.timestampUs = utils::MonotonicMicros();
             if (msg == WM_LBUTTONUP) evt.button = MouseButton::Left;
             else if (msg == WM_RBUTTONUP) evt.button = MouseButton::Right;
             else evt.button = MouseButton::Middle;
@@ -421,6 +510,7 @@ LRESULT TransparentWindow::InstanceWndProc(UINT msg, WPARAM wp, LPARAM lp) {
             evt.button  = MouseButton::None;
             evt.isDown  = false;
             evt.isMove  = true;
+            evt.timestampUs = utils::MonotonicMicros();
             m_mouseCallback(evt);
         }
         return 0;
@@ -593,6 +683,7 @@ bool TransparentWindow::AllocateBackBuffer(int w, int h) {
     m_pixels     = static_cast<uint8_t*>(bits);
     m_bufW       = w;
     m_bufH       = h;
+    m_backBufferMemory.Set(static_cast<uint64_t>(w) * h * 4);
 
     // Clear buffer to fully transparent black
     std::memset(m_pixels, 0, static_cast<size_t>(w) * h * 4);
@@ -622,56 +713,7 @@ void TransparentWindow::FreeBackBuffer() {
     m_pixels = nullptr;
     m_bufW   = 0;
     m_bufH   = 0;
-}
-
-// ===================================================================
-// Internal: Convert RGBA to BGRA Premultiplied
-// ===================================================================
-
-void TransparentWindow::ConvertRGBAToBGRAPremul(const uint8_t* src, int w, int h) {
-    // src: RGBA (non-premultiplied) from renderer
-    // dst: m_pixels (BGRA premultiplied) for UpdateLayeredWindow
-    //
-    // For each pixel:
-    //   dst.B = src.B * src.A / 255
-    //   dst.G = src.G * src.A / 255
-    //   dst.R = src.R * src.A / 255
-    //   dst.A = src.A
-
-    const int totalPixels = w * h;
-    const uint8_t* in  = src;
-    uint8_t*       out = m_pixels;
-
-    for (int i = 0; i < totalPixels; ++i) {
-        const uint8_t r = in[0];
-        const uint8_t g = in[1];
-        const uint8_t b = in[2];
-        const uint8_t a = in[3];
-
-        if (a == 255) {
-            // Fully opaque: no multiplication needed, just swizzle
-            out[0] = b;
-            out[1] = g;
-            out[2] = r;
-            out[3] = 255;
-        } else if (a == 0) {
-            // Fully transparent: zero everything
-            out[0] = 0;
-            out[1] = 0;
-            out[2] = 0;
-            out[3] = 0;
-        } else {
-            // Premultiply: channel * alpha / 255
-            // Using (channel * alpha + 127) / 255 for better rounding
-            out[0] = static_cast<uint8_t>((b * a + 127) / 255);
-            out[1] = static_cast<uint8_t>((g * a + 127) / 255);
-            out[2] = static_cast<uint8_t>((r * a + 127) / 255);
-            out[3] = a;
-        }
-
-        in  += 4;
-        out += 4;
-    }
+    m_backBufferMemory.Reset();
 }
 
 // ===================================================================
@@ -707,7 +749,9 @@ void TransparentWindow::ApplyLayeredUpdate() {
 
     if (!result) {
         DMME_LOG_ERROR("UpdateLayeredWindow failed: {}", FormatWin32Error(GetLastError()));
+        return;
     }
+    m_presentCount++;
 }
 
 // ===================================================================
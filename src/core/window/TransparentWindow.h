@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "WindowTypes.h"
+#include "core/memory/MemoryAccountant.h"
 
 namespace dmme {
 namespace core {
@@ -36,11 +37,30 @@ public:
 
     // ----- Frame Update -----
     // Accepts RGBA (non-premultiplied) pixel data from the renderer.
-    // Converts internally to BGRA premultiplied and pushes to the
-    // layered window via UpdateLayeredWindow.
+    // Converts internally to BGRA premultiplied (see PixelConvert.h)
+    // and pushes to the layered window via UpdateLayeredWindow.
     // width/height must match current window dimensions or the
     // internal buffer will be reallocated.
-    bool UpdateFrame(const uint8_t* rgbaPixels, int width, int height);
+    // strideBytes is the source row pitch; 0 means tightly packed
+    // (width * 4). A larger stride lets a sub-rect of a bigger image
+    // (e.g. one character in a shared atlas) be passed without a copy.
+    bool UpdateFrame(const uint8_t* rgbaPixels, int width, int height,
+                     int strideBytes = 0);
+
+    // Like UpdateFrame, but the source may be smaller than the window
+    // (reduced render scale). The source is upscaled (nearest
+    // neighbour) into the current back buffer during conversion
+    // instead of resizing the window to the source.
+    bool UpdateFrameScaled(const uint8_t* rgbaPixels, int srcWidth, int srcHeight,
+                           int strideBytes = 0);
+
+    // Monotonic timestamps of the last UpdateFrame's conversion and
+    // present, for input-to-photon latency tracking.
+    PresentTiming GetLastPresentTiming() const;
+
+    // Number of successful UpdateLayeredWindow calls so far (frame
+    // presents plus re-presents from SetPosition / SetGlobalAlpha).
+    uint64_t GetPresentCount() const;
 
     // ----- Position -----
     void  SetPosition(int x, int y);
@@ -82,6 +102,11 @@ public:
     void SetResizeCallback(ResizeCallback cb);
     void SetCloseCallback(CloseCallback cb);
 
+    // Draw into the back buffer after conversion, before present.
+    // Overlay pixels are part of the frame, so they also take part
+    // in click-through hit testing.
+    void SetFrameOverlayCallback(FrameOverlayCallback cb);
+
 private:
     // Win32 window proc routing
     static LRESULT CALLBACK StaticWndProc(HWND hwnd, UINT msg,
@@ -96,8 +121,8 @@ private:
     void ApplyLayeredUpdate();
     void EnableDPIAwareness();
 
-    // Pixel conversion: RGBA -> BGRA premultiplied alpha
-    void ConvertRGBAToBGRAPremul(const uint8_t* src, int w, int h);
+    // Shared tail of UpdateFrame / UpdateFrameScaled
+    void FinishFrameUpdate();
 
     // Win32 error formatting
     static std::string FormatWin32Error(DWORD code);
@@ -115,6 +140,7 @@ private:
     uint8_t* m_pixels      = nullptr;
     int      m_bufW        = 0;
     int      m_bufH        = 0;
+    memory::TrackedMemory m_backBufferMemory{memory::MemoryCategory::WindowSurface};
 
     // ----- State -----
     int      m_posX        = 0;
@@ -126,6 +152,8 @@ private:
     bool     m_topmost     = true;
     bool     m_visible     = false;
     bool     m_initialized = false;
+    PresentTiming m_lastPresentTiming;
+    uint64_t m_presentCount = 0;
 
     // ----- Sub-component -----
     std::unique_ptr<ClickThrough> m_clickThrough;
@@ -134,6 +162,7 @@ private:
     MouseEventCallback m_mouseCallback;
     ResizeCallback     m_resizeCallback;
     CloseCallback      m_closeCallback;
+    FrameOverlayCallback m_overlayCallback;
 
     // ----- Thread Safety -----
     mutable std::mutex m_bufferMutex;
@@ -85,6 +85,16 @@ struct MouseEvent {
     MouseButton button   = MouseButton::None;
     bool        isDown   = false;
     bool        isMove   = false;
+    uint64_t    timestampUs = 0; // utils::MonotonicMicros() when received
+};
+
+// ------------------------------------------------------------------
+// Present timing (stamped by TransparentWindow::UpdateFrame)
+// ------------------------------------------------------------------
+
+struct PresentTiming {
+    uint64_t convertDoneUs = 0;  // RGBA -> BGRA conversion finished
+    uint64_t presentDoneUs = 0;  // UpdateLayeredWindow returned
 };
 
 // ------------------------------------------------------------------
@@ -95,6 +105,10 @@ using MouseEventCallback  = std::function<void(const MouseEvent&)>;
 using ResizeCallback      = std::function<void(int width, int height)>;
 using CloseCallback       = std::function<void()>;
 
+// Called with the converted BGRA premultiplied back buffer right
+// before it is presented (debug overlays such as the perf HUD).
+using FrameOverlayCallback = std::function<void(uint8_t* bgra, int width, int height)>;
+
 } // namespace window
 } // namespace core
 } // namespace dmme
\ No newline at end of file
@@ -1,11 +1,24 @@
 #include "utils/Logger.h"
 #include "core/window/TransparentWindow.h"
 #include "core/window/OpacityController.h"
+#include "core/animation/TweenEngine.h"
 #include "core/window/MultiMonitor.h"
 #include "core/window/WindowTypes.h"
 #include "core/renderer/RenderPipeline.h"
 #include "core/renderer/RenderTypes.h"
 #include "core/renderer/drivers/DX11Driver.h"
+#include "core/renderer/drivers/OpenGLDriver.h"
+#include "core/renderer/ProceduralFace.h"
+#include "core/jobs/JobSystem.h"
+#include "core/profiling/FrameLatencyTracker.h"
+#include "core/profiling/PerfHud.h"
+#include "core/profiling/MetricsEndpoint.h"
+#include "core/runtime/FramePacer.h"
+#include "core/runtime/PowerGovernor.h"
+#include "core/runtime/VisibilityMonitor.h"
+#include "core/memory/FrameAllocationGuard.h"
+#include "core/memory/MemoryAccountant.h"
+#include "utils/Clock.h"
 
 #include <Windows.h>
 #include <d3d11.h>
@@ -13,10 +26,17 @@
 #include <wrl/client.h>
 #include <chrono>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 
 using namespace dmme::core::window;
 using namespace dmme::core::renderer;
+using namespace dmme::core::profiling;
+using namespace dmme::core::runtime;
+using namespace dmme::core::memory;
+using namespace dmme::core::animation;
+using namespace dmme::core::jobs;
 using namespace dmme::utils;
 using Microsoft::WRL::ComPtr;
 
@@ -30,8 +50,10 @@ using Microsoft::WRL::ComPtr;
 //
 // Manages DX11 shaders for drawing a procedural mascot face.
 // Adapts shader model target based on GPU feature level.
-// Handles initialization failure gracefully -- tries once, if fails
-// falls back to clear-color-only mode permanently.
+// On the software driver the same face is shaded on the CPU
+// (ProceduralFaceRasterizer). Handles initialization failure
+// gracefully -- tries once, if fails falls back to clear-color-only
+// mode permanently.
 // ===================================================================
 
 class TestContentRenderer {
@@ -39,9 +61,12 @@ public:
     enum class State {
         Uninitialized,
         Ready,
+        Software,  // software driver: CPU port of the face shader
         Failed     // permanent failure -- do not retry
     };
 
+    explicit TestContentRenderer(JobSystem* jobs) : m_cpuFace(jobs) {}
+
     State GetState() const { return m_state; }
 
     bool Initialize(IGraphicsDriver* driver) {
@@ -49,6 +74,12 @@ public:
             return m_state == State::Ready;
         }
 
+        if (driver && driver->GetAPI() == GraphicsAPI::OpenGL) {
+            DMME_LOG_INFO("TestContentRenderer: software driver, shading the face on the CPU");
+            m_state = State::Software;
+            return true;
+        }
+
         if (!driver || driver->GetAPI() != GraphicsAPI::DX11) {
             DMME_LOG_WARN("TestContentRenderer: not DX11, using clear-color fallback");
             m_state = State::Failed;
@@ -320,6 +351,14 @@ public:
     }
 
     void Draw(IGraphicsDriver* driver, int width, int height, float elapsed) {
+        if (m_state == State::Software) {
+            auto* software = static_cast<OpenGLDriver*>(driver);
+            m_cpuFace.Draw(software->GetTargetPixels(),
+                           software->GetTargetWidth(), software->GetTargetHeight(),
+                           software->GetTargetWidth() * 4, elapsed);
+            return;
+        }
+
         if (m_state != State::Ready) {
             // Fallback: time-varying clear color
             DrawFallback(driver, elapsed);
@@ -386,6 +425,7 @@ private:
     }
 
     State m_state = State::Uninitialized;
+    ProceduralFaceRasterizer   m_cpuFace;
     ComPtr<ID3D11VertexShader> m_vs;
     ComPtr<ID3D11PixelShader>  m_ps;
     ComPtr<ID3D11Buffer>       m_cbuffer;
@@ -443,9 +483,22 @@ int WINAPI wWinMain(HINSTANCE /*hInstance*/, HINSTANCE /*hPrevInstance*/,
     winCfg.initialOpacity = 255;
 
     TransparentWindow window;
+    FrameLatencyTracker latencyTracker;
+    PerfHud hud;
 
-    window.SetMouseEventCallback([](const MouseEvent& evt) {
+    // DMME_HUD=1 shows the performance HUD from startup
+    char hudEnv[8] = {};
+    if (GetEnvironmentVariableA("DMME_HUD", hudEnv, sizeof(hudEnv)) > 0 && hudEnv[0] != '0') {
+        hud.SetEnabled(true);
+    }
+
+    window.SetMouseEventCallback([&latencyTracker, &hud](const MouseEvent& evt) {
+        // Every event (including drag moves) counts toward latency
+        latencyTracker.RecordInput(evt.timestampUs);
         if (evt.isMove) return;
+        if (evt.button == MouseButton::Middle && evt.isDown) {
+            hud.Toggle();
+        }
         const char* btn = "None";
         if (evt.button == MouseButton::Left) btn = "Left";
         else if (evt.button == MouseButton::Right) btn = "Right";
@@ -459,6 +512,10 @@ int WINAPI wWinMain(HINSTANCE /*hInstance*/, HINSTANCE /*hPrevInstance*/,
         PostQuitMessage(0);
     });
 
+    window.SetFrameOverlayCallback([&hud](uint8_t* bgra, int w, int h) {
+        hud.Draw(bgra, w, h);
+    });
+
     if (!window.Initialize(winCfg)) {
         DMME_LOG_CRITICAL("Failed to initialize window");
         Logger::Shutdown();
@@ -503,25 +560,71 @@ int WINAPI wWinMain(HINSTANCE /*hInstance*/, HINSTANCE /*hPrevInstance*/,
                   caps.maxMSAASamples, caps.supportsCompute,
                   caps.shaderModel);
 
+    hud.SetDriverName(pipeline.GetDriver()->GetDriverName());
+
+    // DMME_METRICS=1 serves live telemetry on \\.\pipe\dmme-metrics
+    MetricsEndpoint metrics;
+    MetricsSnapshot metricsSnapshot;
+    std::snprintf(metricsSnapshot.driverName, sizeof(metricsSnapshot.driverName), "%s",
+                  pipeline.GetDriver()->GetDriverName().c_str());
+    std::snprintf(metricsSnapshot.adapterName, sizeof(metricsSnapshot.adapterName), "%s",
+                  adapterDesc.c_str());
+
+    char metricsEnv[8] = {};
+    if (GetEnvironmentVariableA("DMME_METRICS", metricsEnv, sizeof(metricsEnv)) > 0 &&
+        metricsEnv[0] != '0' && !metrics.Start()) {
+        DMME_LOG_WARN("Metrics endpoint unavailable, continuing without it");
+    }
+
     // ---------------------------------------------------------------
     // Step 5: Initialize Test Content Renderer
     // ---------------------------------------------------------------
-    TestContentRenderer testRenderer;
+    JobSystem jobs;
+    TestContentRenderer testRenderer(&jobs);
     testRenderer.Initialize(pipeline.GetDriver());
 
     if (testRenderer.GetState() == TestContentRenderer::State::Ready) {
         DMME_LOG_INFO("GPU shader rendering active");
+    } else if (testRenderer.GetState() == TestContentRenderer::State::Software) {
+        DMME_LOG_INFO("CPU face rendering active ({} job threads)", jobs.GetConcurrency());
     } else {
         DMME_LOG_WARN("GPU shader rendering failed, using clear-color fallback");
     }
 
     // ---------------------------------------------------------------
-    // Step 6: Setup Opacity Controller
+    // Step 6: Setup Tween Engine + Opacity Controller
     // ---------------------------------------------------------------
-    OpacityController opacityCtrl;
+    TweenEngine tweens;
+    OpacityController opacityCtrl(tweens);
     opacityCtrl.SetOpacity(0.0f);
     opacityCtrl.FadeIn(1.5f);
 
+    // ---------------------------------------------------------------
+    // Step 6: Setup Frame Pacing, Power Governor, Visibility Monitor
+    // ---------------------------------------------------------------
+    FramePacer        pacer;
+    PowerGovernor     governor(CreatePlatformPowerSignalSource());
+    VisibilityMonitor visibility(CreatePlatformVisibilitySignalSource(window.GetHWND()));
+    pacer.SetTargetFps(governor.GetPolicy().targetFps);
+
+    // Steady-state frames must not allocate (DMME_ALLOC_TRACKING builds).
+    // DMME_ALLOC_GUARD=fatal aborts on the first violation for bench runs.
+    FrameAllocationGuardConfig allocGuardCfg;
+    char allocGuardEnv[8] = {};
+    if (GetEnvironmentVariableA("DMME_ALLOC_GUARD", allocGuardEnv, sizeof(allocGuardEnv)) > 0) {
+        allocGuardCfg.failOnAllocation = (std::strcmp(allocGuardEnv, "fatal") == 0);
+    }
+    FrameAllocationGuard allocGuard(allocGuardCfg);
+
+    // DMME_CACHE_BUDGET_MB=<n> caps trimmable caches (the software
+    // driver's decoded BC tile cache); over budget, their trim handlers
+    // run at the end of the frame.
+    char cacheBudgetEnv[16] = {};
+    if (GetEnvironmentVariableA("DMME_CACHE_BUDGET_MB", cacheBudgetEnv, sizeof(cacheBudgetEnv)) > 0) {
+        const uint64_t budgetMb = std::strtoull(cacheBudgetEnv, nullptr, 10);
+        MemoryAccountant::SetBudget(MemoryCategory::Cache, budgetMb * 1024 * 1024);
+    }
+
     // ---------------------------------------------------------------
     // Step 6: Main Loop
     // ---------------------------------------------------------------
@@ -532,6 +635,9 @@ int WINAPI wWinMain(HINSTANCE /*hInstance*/, HINSTANCE /*hPrevInstance*/,
     auto lastStatsLog = startTime;
     bool running = true;
     uint64_t frameCount = 0;
+    uint64_t lastPresentUs    = 0;
+    uint64_t lastPresentCount = window.GetPresentCount();
+    PixelRegion lastFaceBounds;
 
     while (running) {
         // -- Timing --
@@ -546,12 +652,42 @@ int WINAPI wWinMain(HINSTANCE /*hInstance*/, HINSTANCE /*hPrevInstance*/,
             break;
         }
 
-        // -- Update Opacity --
-        opacityCtrl.Update(deltaTime);
+        // -- Power Policy (frame rate, render scale) --
+        if (governor.Update(MonotonicMicros())) {
+            const PowerPolicy& policy = governor.GetPolicy();
+            pacer.SetTargetFps(visibility.GetLoopFps(policy.targetFps));
+            pipeline.SetRenderScale(policy.resolutionScale);
+            allocGuard.ResetWarmup();  // surface reallocated
+        }
+
+        // -- Visibility (suspend / heartbeat when nobody can see us) --
+        if (visibility.Update(MonotonicMicros())) {
+            pacer.SetTargetFps(visibility.GetLoopFps(governor.GetPolicy().targetFps));
+            if (visibility.IsResumeFramePending()) {
+                pacer.Reset();  // resume frame goes out immediately
+            }
+        }
+
+        if (!visibility.ShouldRenderFrame(MonotonicMicros())) {
+            pacer.WaitForNextFrame();
+            continue;
+        }
+
+        allocGuard.BeginFrame();
+
+        // -- Frame ID (claims inputs received by ProcessMessages) --
+        const uint64_t frameStartUs = MonotonicMicros();
+        const uint64_t frameId = latencyTracker.BeginFrame(frameStartUs);
+
+        // -- Update Tweens (opacity and other animated properties) --
+        tweens.Update(deltaTime);
+        tweens.DispatchEvents();
         window.SetGlobalAlpha(opacityCtrl.GetCurrentAlpha());
+        const uint64_t updateDoneUs = MonotonicMicros();
+        latencyTracker.MarkStage(frameId, FrameStage::Update, updateDoneUs);
 
         // -- Render Frame --
-        if (pipeline.BeginFrame()) {
+        if (pipeline.BeginFrame(frameId)) {
             testRenderer.Draw(
                 pipeline.GetDriver(),
                 pipeline.GetSurface()->GetWidth(),
@@ -560,44 +696,159 @@ int WINAPI wWinMain(HINSTANCE /*hInstance*/, HINSTANCE /*hPrevInstance*/,
             );
 
             pipeline.EndFrame();
-
-            // Readback and push to window
-            const PixelReadback* pixels = pipeline.ReadbackFrame();
+            const uint64_t renderDoneUs = MonotonicMicros();
+            latencyTracker.MarkStage(frameId, FrameStage::Render, renderDoneUs);
+
+            // Readback and push to window. Only the face changes, so when
+            // the face is drawn, read back its bounds plus last frame's
+            // (which must be refreshed to transparent). The first frame
+            // after a suspension is read back whole.
+            const PixelReadback* pixels = nullptr;
+            if (!visibility.IsResumeFramePending() &&
+                (testRenderer.GetState() == TestContentRenderer::State::Ready ||
+                 testRenderer.GetState() == TestContentRenderer::State::Software)) {
+                const PixelRegion faceBounds = ProceduralFaceRasterizer::ComputeBounds(
+                    pipeline.GetSurface()->GetWidth(), pipeline.GetSurface()->GetHeight(), elapsed);
+                const PixelRegion readbackRegion = UnionRegion(faceBounds, lastFaceBounds);
+                lastFaceBounds = faceBounds;
+                pixels = pipeline.ReadbackFrame(&readbackRegion, 1);
+            } else {
+                pixels = pipeline.ReadbackFrame();
+            }
             if (pixels && pixels->IsValid()) {
-                window.UpdateFrame(pixels->data.data(),
-                                   pixels->width, pixels->height);
+                const uint64_t readbackDoneUs = MonotonicMicros();
+                latencyTracker.MarkStage(pixels->frameId, FrameStage::Readback,
+                                         readbackDoneUs);
+                if (window.UpdateFrameScaled(pixels->data.data(),
+                                             pixels->width, pixels->height)) {
+                    PresentTiming pt = window.GetLastPresentTiming();
+                    latencyTracker.MarkStage(pixels->frameId, FrameStage::Convert,
+                                             pt.convertDoneUs);
+                    latencyTracker.MarkStage(pixels->frameId, FrameStage::Present,
+                                             pt.presentDoneUs);
+                    visibility.NotifyFrameRendered(pt.presentDoneUs);
+
+                    // -- Performance HUD (drawn into the next frame) --
+                    AllocationScope profilingScope(AllocSubsystem::Profiling);
+                    const FrameStats stats = pipeline.GetFrameStats();
+                    const Size winSize = window.GetSize();
+                    const uint64_t presents = window.GetPresentCount();
+
+                    HudFrameData hudData;
+                    hudData.frameTimeMs = lastPresentUs
+                        ? MicrosToMs(pt.presentDoneUs - lastPresentUs) : 0.0f;
+                    hudData.cpuTimeMs = stats.frameTimeMs;
+                    hudData.gpuTimeMs = stats.gpuTimeMs;
+                    hudData.stageMs[static_cast<size_t>(FrameStage::Update)]   = MicrosToMs(updateDoneUs - frameStartUs);
+                    hudData.stageMs[static_cast<size_t>(FrameStage::Render)]   = MicrosToMs(renderDoneUs - updateDoneUs);
+                    hudData.stageMs[static_cast<size_t>(FrameStage::Readback)] = MicrosToMs(readbackDoneUs - renderDoneUs);
+                    hudData.stageMs[static_cast<size_t>(FrameStage::Convert)]  = MicrosToMs(pt.convertDoneUs - readbackDoneUs);
+                    hudData.stageMs[static_cast<size_t>(FrameStage::Present)]  = MicrosToMs(pt.presentDoneUs - pt.convertDoneUs);
+                    hudData.presentsPerFrame = static_cast<float>(presents - lastPresentCount);
+                    hudData.surfaceWidth  = pixels->width;
+                    hudData.surfaceHeight = pixels->height;
+                    hudData.cpuMemoryBytes = stats.trackedCpuBytes;
+                    hudData.gpuMemoryBytes = stats.vramUsedBytes;
+                    hud.PushFrame(hudData);
+
+                    // -- Metrics endpoint (wait-free publish) --
+                    if (metrics.IsRunning()) {
+                        metricsSnapshot.timestampUs       = pt.presentDoneUs;
+                        metricsSnapshot.frameNumber       = stats.frameNumber;
+                        metricsSnapshot.frameTimeMs       = stats.frameTimeMs;
+                        metricsSnapshot.gpuTimeMs         = stats.gpuTimeMs;
+                        metricsSnapshot.drawCalls         = stats.drawCalls;
+                        metricsSnapshot.trianglesRendered = stats.trianglesRendered;
+                        metricsSnapshot.vramUsedBytes     = stats.vramUsedBytes;
+                        metricsSnapshot.presentCount      = presents;
+                        metricsSnapshot.surfaceWidth      = pixels->width;
+                        metricsSnapshot.surfaceHeight     = pixels->height;
+                        metricsSnapshot.renderScale       = pipeline.GetRenderScale();
+                        metricsSnapshot.targetFps         = pacer.GetTargetFps();
+                        metricsSnapshot.readbackBytes     = stats.readbackBytes;
+                        metricsSnapshot.backBufferBytes   =
+                            static_cast<uint64_t>(winSize.width) * winSize.height * 4;
+                        metricsSnapshot.memory            = MemoryAccountant::GetReport();
+                        const UploadStats uploads = pipeline.GetDriver()->GetUploadStats();
+                        metricsSnapshot.uploadBytes        = stats.uploadBytes;
+                        metricsSnapshot.uploadBudgetBytes  = uploads.budgetBytes;
+                        metricsSnapshot.uploadPendingBytes = uploads.pendingBytes;
+                        metrics.Publish(metricsSnapshot);
+                    }
+
+                    lastPresentUs    = pt.presentDoneUs;
+                    lastPresentCount = presents;
+                }
             }
         }
 
-        // -- Periodic Stats Logging (every 5 seconds) --
+        allocGuard.EndFrame();
+        MemoryAccountant::EnforceBudgets();
+
+        // -- Periodic Stats Logging (every 5 seconds, outside the guard) --
         float timeSinceStats = std::chrono::duration<float>(now - lastStatsLog).count();
         if (timeSinceStats >= 5.0f) {
             auto stats = pipeline.GetFrameStats();
             float avgFps = (frameCount > 0)
                 ? (static_cast<float>(frameCount) / elapsed) : 0.0f;
-            DMME_LOG_INFO("Frame #{}: cpu={:.2f}ms gpu={:.2f}ms avgFPS={:.1f}",
+            DMME_LOG_INFO("Frame #{}: cpu={:.2f}ms gpu={:.2f}ms avgFPS={:.1f} power={} ({:.0f}fps x{:.2f})",
                           stats.frameNumber, stats.frameTimeMs,
-                          stats.gpuTimeMs, avgFps);
+                          stats.gpuTimeMs, avgFps,
+                          PowerTierName(governor.GetTier()),
+                          pacer.GetTargetFps(), pipeline.GetRenderScale());
+
+            if constexpr (AllocationTracker::IsEnabled()) {
+                DMME_LOG_INFO("  heap: pipeline={} allocs ({} B), last frame={} allocs, steady-state violations={}",
+                              stats.heapAllocations, stats.heapAllocBytes,
+                              allocGuard.GetLastFrame().allocations,
+                              allocGuard.GetViolationCount());
+            }
+
+            const MemoryReport memReport = MemoryAccountant::GetReport();
+            DMME_LOG_INFO("  memory: cpu={:.1f}MB gpu={:.1f}MB",
+                          static_cast<double>(memReport.cpuBytes) / (1024.0 * 1024.0),
+                          static_cast<double>(memReport.gpuBytes) / (1024.0 * 1024.0));
+            const UploadStats uploads = pipeline.GetDriver()->GetUploadStats();
+            if (uploads.totalBytes > 0) {
+                DMME_LOG_INFO("  uploads: last frame={} B (budget {} B), pending={} B in {}, total={} B, ring stalls={}",
+                              uploads.frameBytes, uploads.budgetBytes, uploads.pendingBytes,
+                              uploads.pendingUploads, uploads.totalBytes, uploads.ringStalls);
+            }
+            for (size_t i = 0; i < kMemoryCategoryCount; ++i) {
+                const MemoryCategoryUsage& mu = memReport.categories[i];
+                if (mu.peakBytes == 0) {
+                    continue;
+                }
+                DMME_LOG_DEBUG("    {}: {} B (peak {} B, budget {} B)",
+                               MemoryCategoryName(static_cast<MemoryCategory>(i)),
+                               mu.currentBytes, mu.peakBytes, mu.budgetBytes);
+            }
+
+            LatencyReport latency = latencyTracker.GetReport();
+            if (latency.framesWithInput > 0) {
+                for (size_t i = 0; i < kFrameStageCount; ++i) {
+                    const StageLatency& sl = latency.stages[i];
+                    DMME_LOG_INFO("  input->{}: p50={:.2f}ms p95={:.2f}ms p99={:.2f}ms max={:.2f}ms (n={})",
+                                  FrameStageName(static_cast<FrameStage>(i)),
+                                  sl.p50Ms, sl.p95Ms, sl.p99Ms, sl.maxMs, sl.samples);
+                }
+            }
+            metricsSnapshot.latency = latency;  // last 5 s window
+            latencyTracker.ResetHistograms();
             lastStatsLog = now;
         }
 
         frameCount++;
 
-        // -- Frame Rate Limit (~60fps) --
-        auto frameEnd = std::chrono::high_resolution_clock::now();
-        float frameMs = std::chrono::duration<float, std::milli>(frameEnd - now).count();
-        if (frameMs < 16.0f) {
-            DWORD sleepMs = static_cast<DWORD>(16.0f - frameMs);
-            if (sleepMs > 0 && sleepMs < 100) {
-                Sleep(sleepMs);
-            }
-        }
+        // -- Frame Rate Limit (governor target, 60fps on AC) --
+        pacer.WaitForNextFrame();
     }
 
     // ---------------------------------------------------------------
     // Step 7: Shutdown
     // ---------------------------------------------------------------
     DMME_LOG_INFO("Main loop exited, shutting down");
+    metrics.Stop();
     testRenderer.Shutdown();    pipeline.Shutdown();
     window.Shutdown();
 
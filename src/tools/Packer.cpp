@@ -0,0 +1,156 @@
+#include "core/assets/AssetPack.h"
+#include "core/jobs/JobSystem.h"
+#include "utils/Clock.h"
+#include "utils/Logger.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// ===================================================================
+// dmme_packer: builds an asset pack from a directory tree
+//
+//   dmme_packer <output.pak> <input directory> [options]
+//     --chunk-kib N     compression chunk size (default 64)
+//     --align N         alignment of stored entries (default 4096)
+//     --store a,b,...   extensions kept uncompressed (mapped in place)
+//     --compress-all    compress every other entry, even if it barely shrinks
+//     --jobs N          compression threads besides this one
+//
+// Entry names are paths relative to the input directory with '/'
+// separators.
+// ===================================================================
+
+using namespace dmme::core::assets;
+using namespace dmme::core::jobs;
+namespace fs = std::filesystem;
+
+namespace {
+
+void PrintUsage() {
+    std::fprintf(stderr,
+                 "usage: dmme_packer <output.pak> <input directory> [--chunk-kib N] [--align N]\n"
+                 "                   [--store ext,...] [--compress-all] [--jobs N]\n");
+}
+
+std::string Lower(std::string text) {
+    for (char& c : text) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return text;
+}
+
+std::vector<std::string> SplitList(const std::string& list) {
+    std::vector<std::string> items;
+    size_t start = 0;
+    while (start <= list.size()) {
+        const size_t end = std::min(list.find(',', start), list.size());
+        std::string item = Lower(list.substr(start, end - start));
+        if (!item.empty() && item[0] == '.') {
+            item.erase(0, 1);
+        }
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+        start = end + 1;
+    }
+    return items;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        PrintUsage();
+        return 2;
+    }
+    dmme::utils::Logger::Initialize("dmme_packer", "logs");
+
+    const std::string output = argv[1];
+    const fs::path    input  = fs::u8path(argv[2]);
+    uint32_t chunkKiB    = kPackDefaultChunkSize / 1024;
+    uint32_t alignment   = kPackDefaultAlignment;
+    int      workers     = -1;
+    bool     compressAll = false;
+    std::vector<std::string> storeExtensions;
+
+    for (int i = 3; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--chunk-kib" && hasValue) {
+            chunkKiB = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--align" && hasValue) {
+            alignment = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--store" && hasValue) {
+            storeExtensions = SplitList(argv[++i]);
+        } else if (arg == "--jobs" && hasValue) {
+            workers = std::atoi(argv[++i]);
+        } else if (arg == "--compress-all") {
+            compressAll = true;
+        } else {
+            PrintUsage();
+            return 2;
+        }
+    }
+
+    std::error_code ec;
+    if (!fs::is_directory(input, ec)) {
+        std::fprintf(stderr, "dmme_packer: '%s' is not a directory\n", argv[2]);
+        return 1;
+    }
+
+    // Sorted walk, so the same tree always produces the same pack
+    std::vector<fs::path> files;
+    for (fs::recursive_directory_iterator it(input, ec), end; !ec && it != end; it.increment(ec)) {
+        if (it->is_regular_file(ec)) {
+            files.push_back(it->path());
+        }
+    }
+    if (ec) {
+        std::fprintf(stderr, "dmme_packer: cannot walk '%s': %s\n", argv[2], ec.message().c_str());
+        return 1;
+    }
+    std::sort(files.begin(), files.end());
+
+    const uint64_t start = dmme::utils::MonotonicMicros();
+    AssetPackWriter writer(chunkKiB * 1024, alignment);
+    for (const fs::path& file : files) {
+        std::ifstream stream(file, std::ios::binary);
+        const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(stream)),
+                                         std::istreambuf_iterator<char>());
+        if (!stream.good() && !stream.eof()) {
+            std::fprintf(stderr, "dmme_packer: cannot read '%s'\n", file.u8string().c_str());
+            return 1;
+        }
+
+        const std::string extension = Lower(file.extension().u8string());
+        const bool store = !extension.empty() &&
+                           std::find(storeExtensions.begin(), storeExtensions.end(),
+                                     extension.substr(1)) != storeExtensions.end();
+        const PackStoreMode mode = store ? PackStoreMode::Store
+                                 : compressAll ? PackStoreMode::Compress
+                                 : PackStoreMode::Auto;
+        writer.Add(file.lexically_relative(input).generic_u8string(), bytes.data(), bytes.size(), mode);
+    }
+
+    JobSystem jobs(workers);
+    if (!writer.Write(output, &jobs)) {
+        return 1;
+    }
+
+    const float seconds = dmme::utils::MicrosToMs(dmme::utils::MonotonicMicros() - start) / 1000.0f;
+    const double raw    = static_cast<double>(writer.GetRawBytes());
+    const double packed = static_cast<double>(writer.GetPackBytes());
+    std::printf("%s: %zu files, %.1f MiB -> %.1f MiB (%.1f%%) in %.2f s\n", output.c_str(),
+                writer.GetEntryCount(), raw / 1048576.0, packed / 1048576.0,
+                raw > 0.0 ? 100.0 * packed / raw : 100.0, seconds);
+    dmme::utils::Logger::Shutdown();
+    return 0;
+}
\ No newline at end of file
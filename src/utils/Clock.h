@@ -0,0 +1,27 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace dmme {
+namespace utils {
+
+// Monotonic microsecond timestamps shared by every subsystem that
+// stamps events (input, frame stages, presents). All stamps come from
+// the same steady clock so they can be subtracted across subsystems.
+//
+// high_resolution_clock is not guaranteed to be monotonic on every
+// standard library, so steady_clock is used explicitly.
+
+inline uint64_t MonotonicMicros() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+inline float MicrosToMs(uint64_t micros) {
+    return static_cast<float>(micros) / 1000.0f;
+}
+
+} // namespace utils
+} // namespace dmme
\ No newline at end of file
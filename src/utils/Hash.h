@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace dmme {
+namespace utils {
+
+// 64-bit content hash (the XXH64 algorithm): four independent 8-byte
+// lanes, so hashing runs at memory speed rather than a byte per
+// multiply like FNV. Used to key derived data on source bytes and to
+// checksum cache files; not a cryptographic hash.
+//
+// Reads are little-endian, which every target this engine ships on is.
+
+namespace detail {
+
+constexpr uint64_t kHashPrime1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t kHashPrime2 = 0xC2B2AE3D27D4EB4Full;
+constexpr uint64_t kHashPrime3 = 0x165667B19E3779F9ull;
+constexpr uint64_t kHashPrime4 = 0x85EBCA77C2B2AE63ull;
+constexpr uint64_t kHashPrime5 = 0x27D4EB2F165667C5ull;
+
+inline uint64_t Rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+inline uint64_t Read64(const uint8_t* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint32_t Read32(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint64_t HashRound(uint64_t acc, uint64_t input) {
+    acc += input * kHashPrime2;
+    acc  = Rotl64(acc, 31);
+    return acc * kHashPrime1;
+}
+
+inline uint64_t HashMerge(uint64_t acc, uint64_t lane) {
+    acc ^= HashRound(0, lane);
+    return acc * kHashPrime1 + kHashPrime4;
+}
+
+} // namespace detail
+
+inline uint64_t HashBytes64(const void* data, size_t size, uint64_t seed = 0) {
+    using namespace detail;
+    const uint8_t* p   = static_cast<const uint8_t*>(data);
+    const uint8_t* end = p + size;
+    uint64_t h;
+
+    if (size >= 32) {
+        uint64_t v1 = seed + kHashPrime1 + kHashPrime2;
+        uint64_t v2 = seed + kHashPrime2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - kHashPrime1;
+        const uint8_t* limit = end - 32;
+        do {
+            v1 = HashRound(v1, Read64(p));
+            v2 = HashRound(v2, Read64(p + 8));
+            v3 = HashRound(v3, Read64(p + 16));
+            v4 = HashRound(v4, Read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+        h = Rotl64(v1, 1) + Rotl64(v2, 7) + Rotl64(v3, 12) + Rotl64(v4, 18);
+        h = HashMerge(h, v1);
+        h = HashMerge(h, v2);
+        h = HashMerge(h, v3);
+        h = HashMerge(h, v4);
+    } else {
+        h = seed + kHashPrime5;
+    }
+
+    h += static_cast<uint64_t>(size);
+    for (; p + 8 <= end; p += 8) {
+        h ^= HashRound(0, Read64(p));
+        h  = Rotl64(h, 27) * kHashPrime1 + kHashPrime4;
+    }
+    if (p + 4 <= end) {
+        h ^= static_cast<uint64_t>(Read32(p)) * kHashPrime1;
+        h  = Rotl64(h, 23) * kHashPrime2 + kHashPrime3;
+        p += 4;
+    }
+    for (; p < end; ++p) {
+        h ^= static_cast<uint64_t>(*p) * kHashPrime5;
+        h  = Rotl64(h, 11) * kHashPrime1;
+    }
+
+    h ^= h >> 33;
+    h *= kHashPrime2;
+    h ^= h >> 29;
+    h *= kHashPrime3;
+    h ^= h >> 32;
+    return h;
+}
+
+} // namespace utils
+} // namespace dmme
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+// Compile-time SIMD selection shared by the CPU-side kernels.
+//
+// DMME_SIMD_SSE2 is defined on every x64 build (SSE2 is part of the
+// x64 baseline) and on x86 builds compiled with /arch:SSE2 or -msse2.
+// Kernels provide a scalar path for everything else.
+
+#if defined(_M_X64) || defined(__x86_64__) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define DMME_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#include <cstdint>
+
+namespace dmme {
+namespace utils {
+
+// Exact x / 255 for x in [0, 65535], rounded to nearest:
+//   (x + 128 + ((x + 128) >> 8)) >> 8
+inline uint32_t Div255Round(uint32_t x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+#if defined(DMME_SIMD_SSE2)
+// Same rounding on eight 16-bit lanes.
+inline __m128i Div255RoundU16(__m128i x) {
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+#endif
+
+} // namespace utils
+} // namespace dmme
\ No newline at end of file
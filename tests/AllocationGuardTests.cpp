@@ -0,0 +1,234 @@
+// Steady-state frames must not touch the heap. The suite links the
+// dmme_alloc_hooks operator new replacements itself, so every
+// render-thread allocation is counted in any build configuration.
+//
+// Warm frames run the main loop's per-frame work on the software
+// driver (tweens, latency stamps, render, region readback, present,
+// HUD, metrics publish) under a guard that aborts on any allocation.
+
+#include "TestHarness.h"
+#include "HeadlessPresenter.h"
+
+#include "core/animation/TweenEngine.h"
+#include "core/jobs/JobSystem.h"
+#include "core/memory/FrameAllocationGuard.h"
+#include "core/memory/MemoryAccountant.h"
+#include "core/profiling/FrameLatencyTracker.h"
+#include "core/profiling/MetricsEndpoint.h"
+#include "core/profiling/PerfHud.h"
+#include "core/renderer/ProceduralFace.h"
+#include "core/renderer/RenderPipeline.h"
+#include "core/renderer/drivers/OpenGLDriver.h"
+#include "utils/Clock.h"
+
+#include <csignal>
+#include <cstdlib>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace dmme;
+using namespace dmme::core;
+using namespace dmme::core::memory;
+using dmme::utils::MonotonicMicros;
+
+namespace {
+
+constexpr int kSize = 128;
+
+// Keeps an allocation observable so the compiler cannot elide it
+char* volatile g_sink = nullptr;
+
+void AllocateOnce() {
+    g_sink = new char[64];
+    delete[] g_sink;
+}
+
+// The main loop's per-frame work on the headless path
+class SteadyStateLoop {
+public:
+    SteadyStateLoop()
+        : m_face(&m_jobs)
+        , m_window(kSize, kSize) {
+        renderer::RenderConfig config;
+        config.preferredAPI = renderer::GraphicsAPI::OpenGL;
+        config.targetWidth  = kSize;
+        config.targetHeight = kSize;
+        m_ready = m_pipeline.Initialize(nullptr, config) &&
+                  m_pipeline.GetActiveAPI() == renderer::GraphicsAPI::OpenGL;
+
+        m_tweens.Reserve(4, 4);
+        m_alpha = m_tweens.CreateChannel(0.0f);
+        m_tweens.TweenTo(m_alpha, 1.0f, 60.0f);
+
+        m_hud.SetEnabled(true);
+        m_hud.SetDriverName(m_pipeline.GetDriver()->GetDriverName());
+        m_window.SetFrameOverlayCallback([this](uint8_t* bgra, int w, int h) {
+            m_hud.Draw(bgra, w, h);
+        });
+    }
+
+    bool IsReady() const { return m_ready; }
+
+    bool Frame(float elapsed) {
+        const uint64_t frameId = m_latency.BeginFrame(MonotonicMicros());
+        m_tweens.Update(1.0f / 60.0f);
+        m_tweens.DispatchEvents();
+        m_latency.MarkStage(frameId, profiling::FrameStage::Update, MonotonicMicros());
+
+        if (!m_pipeline.BeginFrame(frameId)) {
+            return false;
+        }
+        auto* driver = static_cast<renderer::OpenGLDriver*>(m_pipeline.GetDriver());
+        const int width  = driver->GetTargetWidth();
+        const int height = driver->GetTargetHeight();
+        m_face.Draw(driver->GetTargetPixels(), width, height, width * 4, elapsed);
+        if (!m_pipeline.EndFrame()) {
+            return false;
+        }
+        m_latency.MarkStage(frameId, profiling::FrameStage::Render, MonotonicMicros());
+
+        const renderer::PixelRegion bounds =
+            renderer::ProceduralFaceRasterizer::ComputeBounds(width, height, elapsed);
+        const renderer::PixelRegion region = renderer::UnionRegion(bounds, m_lastBounds);
+        m_lastBounds = bounds;
+        const renderer::PixelReadback* pixels = m_pipeline.ReadbackFrame(&region, 1);
+        if (!pixels || !pixels->IsValid() || !m_window.Present(*pixels)) {
+            return false;
+        }
+        const window::PresentTiming pt = m_window.GetLastPresentTiming();
+        m_latency.MarkStage(pixels->frameId, profiling::FrameStage::Present, pt.presentDoneUs);
+
+        const renderer::FrameStats stats = m_pipeline.GetFrameStats();
+        profiling::HudFrameData hudData;
+        hudData.cpuTimeMs     = stats.frameTimeMs;
+        hudData.surfaceWidth  = pixels->width;
+        hudData.surfaceHeight = pixels->height;
+        m_hud.PushFrame(hudData);
+
+        m_snapshot.frameNumber   = stats.frameNumber;
+        m_snapshot.readbackBytes = stats.readbackBytes;
+        m_snapshot.memory        = MemoryAccountant::GetReport();
+        m_metrics.Publish(m_snapshot);
+        return true;
+    }
+
+private:
+    jobs::JobSystem                    m_jobs;
+    renderer::RenderPipeline           m_pipeline;
+    renderer::ProceduralFaceRasterizer m_face;
+    test::HeadlessPresenter            m_window;
+    animation::TweenEngine             m_tweens;
+    animation::TweenChannel            m_alpha;
+    profiling::FrameLatencyTracker     m_latency;
+    profiling::PerfHud                 m_hud;
+    profiling::MetricsEndpoint         m_metrics;     // published to, never started
+    profiling::MetricsSnapshot         m_snapshot;
+    renderer::PixelRegion              m_lastBounds;
+    bool                               m_ready = false;
+};
+
+} // anonymous namespace
+
+// ===================================================================
+// Steady state
+// ===================================================================
+
+DMME_TEST(TrackingIsLive) {
+    const uint64_t before = AllocationTracker::GetThreadCounters().allocations;
+    AllocateOnce();
+    DMME_CHECK(AllocationTracker::GetThreadCounters().allocations == before + 1);
+}
+
+// Any allocation after warm-up aborts the process, failing the test
+DMME_TEST(WarmFramesDoNotAllocate) {
+    // Setup allocates (surface, readback buffers, job workers), which
+    // shows the hooks see the pipeline at all
+    const uint64_t beforeSetup = AllocationTracker::GetThreadCounters().allocations;
+    SteadyStateLoop loop;
+    DMME_CHECK(loop.IsReady());
+    DMME_CHECK(AllocationTracker::GetThreadCounters().allocations > beforeSetup);
+
+    FrameAllocationGuardConfig config;
+    config.warmupFrames     = 30;
+    config.failOnAllocation = true;
+    FrameAllocationGuard guard(config);
+
+    for (int frame = 0; frame < 240; ++frame) {
+        guard.BeginFrame();
+        DMME_CHECK(loop.Frame(frame / 60.0f));
+        guard.EndFrame();
+    }
+
+    DMME_CHECK(guard.IsSteadyState());
+    DMME_CHECK(guard.GetViolationCount() == 0);
+    DMME_CHECK(guard.GetLastFrame().allocations == 0);
+}
+
+// ===================================================================
+// Violations
+// ===================================================================
+
+DMME_TEST(AllocatingFrameIsCounted) {
+    FrameAllocationGuardConfig config;
+    config.warmupFrames = 2;
+    FrameAllocationGuard guard(config);
+
+    for (int frame = 0; frame < 4; ++frame) {
+        guard.BeginFrame();
+        if (frame == 0) {
+            AllocateOnce();   // warm-up frames may allocate
+        }
+        guard.EndFrame();
+    }
+    DMME_CHECK(guard.IsSteadyState());
+    DMME_CHECK(guard.GetViolationCount() == 0);
+
+    guard.BeginFrame();
+    {
+        AllocationScope scope(AllocSubsystem::Renderer);
+        AllocateOnce();
+    }
+    const AllocationCounters& frame = guard.EndFrame();
+    DMME_CHECK(guard.GetViolationCount() == 1);
+    DMME_CHECK(frame.allocations == 1 && frame.frees == 1);
+    DMME_CHECK(frame.bytes == 64);
+    DMME_CHECK(frame.bySubsystem[static_cast<size_t>(AllocSubsystem::Renderer)] == 1);
+
+    // Only the offending frame is flagged
+    guard.BeginFrame();
+    guard.EndFrame();
+    DMME_CHECK(guard.GetViolationCount() == 1);
+
+    // After ResetWarmup the guard tolerates allocations again
+    guard.ResetWarmup();
+    guard.BeginFrame();
+    AllocateOnce();
+    guard.EndFrame();
+    DMME_CHECK(guard.GetViolationCount() == 1);
+}
+
+// failOnAllocation: the first steady-state allocation aborts (run in a
+// child process)
+DMME_TEST(AllocatingFrameAbortsWhenFatal) {
+    std::fflush(nullptr);
+    const pid_t child = fork();
+    if (child == 0) {
+        FrameAllocationGuardConfig config;
+        config.warmupFrames     = 0;
+        config.failOnAllocation = true;
+        FrameAllocationGuard guard(config);
+        guard.BeginFrame();
+        guard.EndFrame();
+        guard.BeginFrame();
+        AllocateOnce();
+        guard.EndFrame();
+        _exit(0);
+    }
+
+    int status = 0;
+    DMME_CHECK(child > 0 && waitpid(child, &status, 0) == child);
+    DMME_CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT);
+}
+
+DMME_TEST_MAIN()
\ No newline at end of file
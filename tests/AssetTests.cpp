@@ -0,0 +1,379 @@
+// AssetManager scheduling without a driver: a scripted asset type
+// whose loads can be held at a gate and whose Finalize burns a fixed
+// slice of time. Covers priority order, raising a queued request,
+// deduplication, cancellation in every state, the per-frame
+// finalisation budget and the queue latency stats.
+
+#include "TestHarness.h"
+
+#include "core/assets/AssetManager.h"
+#include "utils/Clock.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dmme;
+using namespace dmme::core::assets;
+using dmme::utils::MonotonicMicros;
+
+namespace {
+
+// Shared by every ScriptedAsset of a test. Paths starting with "held"
+// block in Load until Open (or cancellation); paths containing "bad"
+// fail to load.
+class LoadScript {
+public:
+    void Open() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_open = true;
+        }
+        m_changed.notify_all();
+    }
+
+    // Wait until a held load has started
+    bool WaitForHeld() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_changed.wait_for(lock, std::chrono::seconds(5), [this] { return m_held > 0; });
+    }
+
+    bool Load(const std::string& path, const std::atomic<bool>& cancelled) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_loaded.push_back(path);
+        if (path.rfind("held", 0) == 0) {
+            ++m_held;
+            m_changed.notify_all();
+            while (!m_open && !cancelled.load(std::memory_order_relaxed)) {
+                m_changed.wait_for(lock, std::chrono::milliseconds(1));
+            }
+        }
+        return path.find("bad") == std::string::npos;
+    }
+
+    void Finalized(const std::string& path) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_finalized.push_back(path);
+    }
+
+    std::vector<std::string> Loaded() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_loaded;
+    }
+
+    std::vector<std::string> Finalized() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_finalized;
+    }
+
+    uint32_t sliceUs = 0;           // Finalize busy time per slice
+    uint32_t slices  = 1;           // Finalize calls until Done
+
+private:
+    mutable std::mutex       m_mutex;
+    std::condition_variable  m_changed;
+    bool                     m_open = false;
+    uint32_t                 m_held = 0;
+    std::vector<std::string> m_loaded;
+    std::vector<std::string> m_finalized;
+};
+
+class ScriptedAsset : public IAsset {
+public:
+    explicit ScriptedAsset(LoadScript& script) : m_script(script) {}
+
+    bool Load(const std::string& path, const std::atomic<bool>& cancelled) override {
+        m_path = path;
+        return m_script.Load(path, cancelled);
+    }
+
+    FinalizeResult Finalize() override {
+        const uint64_t start = MonotonicMicros();
+        while (MonotonicMicros() - start < m_script.sliceUs) {
+        }
+        if (++m_slices < m_script.slices) {
+            return FinalizeResult::More;
+        }
+        m_script.Finalized(m_path);
+        return FinalizeResult::Done;
+    }
+
+private:
+    LoadScript& m_script;
+    std::string m_path;
+    uint32_t    m_slices = 0;
+};
+
+AssetManagerConfig OneWorker(float budgetMs = 2.0f) {
+    AssetManagerConfig config;
+    config.workerCount      = 1;
+    config.finalizeBudgetMs = budgetMs;
+    return config;
+}
+
+void Register(AssetManager& assets, LoadScript& script) {
+    assets.RegisterType("fake", [&script] { return std::make_unique<ScriptedAsset>(script); });
+}
+
+// Update until idle; false after five seconds
+bool Drain(AssetManager& assets, float budgetMs = -1.0f, uint32_t* updates = nullptr) {
+    const uint64_t deadline = MonotonicMicros() + 5'000'000;
+    while (!assets.IsIdle()) {
+        if (MonotonicMicros() > deadline) {
+            return false;
+        }
+        assets.Update(budgetMs);
+        if (updates) {
+            ++*updates;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    assets.Update(budgetMs);
+    return true;
+}
+
+} // anonymous namespace
+
+// ===================================================================
+// Priority
+// ===================================================================
+
+// With the only worker held, requests pile up and are then loaded
+// most urgent class first, in request order within a class
+DMME_TEST(LoadsMostUrgentFirst) {
+    LoadScript script;
+    AssetManager assets(OneWorker());
+    Register(assets, script);
+
+    const AssetHandle held = assets.Request("held.fake", AssetPriority::Background);
+    DMME_CHECK(script.WaitForHeld());
+    DMME_CHECK(assets.GetState(held) == AssetState::Loading);
+
+    assets.Request("warm1.fake", AssetPriority::Background);
+    assets.Request("next.fake", AssetPriority::Prefetch);
+    assets.Request("warm2.fake", AssetPriority::Background);
+    assets.Request("face.fake", AssetPriority::Visible);
+    assets.Request("body.fake", AssetPriority::Visible);
+    DMME_CHECK(assets.GetStats().queued == 5);
+
+    script.Open();
+    DMME_CHECK(Drain(assets));
+    const std::vector<std::string> expected = {"held.fake", "face.fake", "body.fake",
+                                               "next.fake", "warm1.fake", "warm2.fake"};
+    DMME_CHECK(script.Loaded() == expected);
+    DMME_CHECK(assets.GetStats().ready == 6);
+    DMME_CHECK(assets.GetStats().completed == 6);
+}
+
+// Asking again for a queued asset at a higher class moves it up; a
+// lower class never demotes it
+DMME_TEST(RequestRaisesPriority) {
+    LoadScript script;
+    AssetManager assets(OneWorker());
+    Register(assets, script);
+
+    assets.Request("held.fake", AssetPriority::Visible);
+    DMME_CHECK(script.WaitForHeld());
+    const AssetHandle late = assets.Request("late.fake", AssetPriority::Background);
+    assets.Request("soon.fake", AssetPriority::Prefetch);
+    DMME_CHECK(assets.Request("late.fake", AssetPriority::Visible) == late);
+    const AssetHandle soon = assets.Request("soon.fake", AssetPriority::Background);
+
+    script.Open();
+    DMME_CHECK(Drain(assets));
+    const std::vector<std::string> expected = {"held.fake", "late.fake", "soon.fake"};
+    DMME_CHECK(script.Loaded() == expected);
+    DMME_CHECK(assets.GetState(soon) == AssetState::Ready);
+    DMME_CHECK(assets.GetStats().deduplicated == 2);
+}
+
+// ===================================================================
+// Deduplication and cancellation
+// ===================================================================
+
+DMME_TEST(ConcurrentRequestsShareOneLoad) {
+    LoadScript script;
+    AssetManager assets(OneWorker());
+    Register(assets, script);
+
+    const AssetHandle a = assets.Request("model.fake", AssetPriority::Prefetch);
+    const AssetHandle b = assets.Request("model.fake", AssetPriority::Visible);
+    const AssetHandle c = assets.Request("model.fake", AssetPriority::Background);
+    DMME_CHECK(a != kInvalidAsset && a == b && b == c);
+    DMME_CHECK(Drain(assets));
+    DMME_CHECK(script.Loaded().size() == 1);
+    DMME_CHECK(assets.Get(a) != nullptr);
+
+    const AssetStats stats = assets.GetStats();
+    DMME_CHECK(stats.requests == 3);
+    DMME_CHECK(stats.deduplicated == 2);
+
+    // Three references: the asset stays until the last is released
+    assets.Release(a);
+    assets.Release(b);
+    DMME_CHECK(assets.GetState(a) == AssetState::Ready);
+    assets.Release(c);
+    DMME_CHECK(assets.GetState(a) == AssetState::Cancelled);
+    DMME_CHECK(assets.Get(a) == nullptr);
+
+    // A new request after the last release loads again
+    const AssetHandle again = assets.Request("model.fake", AssetPriority::Visible);
+    DMME_CHECK(again != a);
+    DMME_CHECK(Drain(assets));
+    DMME_CHECK(script.Loaded().size() == 2);
+}
+
+// Released while queued: never loaded. Released while loading: Load
+// sees its cancelled flag and the result is dropped. Released while
+// waiting for finalisation: never finalised.
+DMME_TEST(ReleaseCancelsInEveryState) {
+    LoadScript script;
+    AssetManager assets(OneWorker());
+    Register(assets, script);
+
+    const AssetHandle loading = assets.Request("held.fake", AssetPriority::Visible);
+    DMME_CHECK(script.WaitForHeld());
+    const AssetHandle queued = assets.Request("queued.fake", AssetPriority::Visible);
+
+    assets.Release(queued);
+    DMME_CHECK(assets.GetState(queued) == AssetState::Cancelled);
+    assets.Release(loading);     // the gate stays shut; only cancellation ends the load
+
+    const AssetHandle decoded = assets.Request("decoded.fake", AssetPriority::Visible);
+    const uint64_t deadline = MonotonicMicros() + 5'000'000;
+    while (assets.GetState(decoded) != AssetState::Finalizing && MonotonicMicros() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    DMME_CHECK(assets.GetState(decoded) == AssetState::Finalizing);
+    assets.Release(decoded);
+    DMME_CHECK(Drain(assets));
+
+    const std::vector<std::string> loaded = script.Loaded();
+    DMME_CHECK(std::find(loaded.begin(), loaded.end(), "queued.fake") == loaded.end());
+    DMME_CHECK(script.Finalized().empty());
+
+    const AssetStats stats = assets.GetStats();
+    DMME_CHECK(stats.cancelled == 3);
+    DMME_CHECK(stats.completed == 0);
+    DMME_CHECK(stats.ready == 0);
+}
+
+DMME_TEST(FailuresAndUnknownTypes) {
+    LoadScript script;
+    AssetManager assets(OneWorker());
+    Register(assets, script);
+
+    DMME_CHECK(assets.Request("texture.png", AssetPriority::Visible) == kInvalidAsset);
+    const AssetHandle bad = assets.Request("bad.fake", AssetPriority::Visible);
+    const AssetHandle good = assets.Request("GOOD.FAKE", AssetPriority::Visible);
+    DMME_CHECK(Drain(assets));
+    DMME_CHECK(assets.GetState(bad) == AssetState::Failed);
+    DMME_CHECK(assets.Get(bad) == nullptr);
+    DMME_CHECK(assets.GetState(good) == AssetState::Ready);
+    DMME_CHECK(assets.GetStats().failed == 1);
+}
+
+// ===================================================================
+// Finalisation budget
+// ===================================================================
+
+// A zero budget still finalises one slice per Update, most urgent
+// first
+DMME_TEST(TinyBudgetFinalisesOneSlicePerFrame) {
+    LoadScript script;
+    script.slices = 3;
+    AssetManager assets(OneWorker(0.0f));
+    Register(assets, script);
+
+    assets.Request("held.fake", AssetPriority::Background);
+    DMME_CHECK(script.WaitForHeld());
+    assets.Request("warm.fake", AssetPriority::Background);
+    assets.Request("face.fake", AssetPriority::Visible);
+    script.Open();
+
+    // Everything decoded before the first Update
+    const uint64_t deadline = MonotonicMicros() + 5'000'000;
+    while (assets.GetStats().finalizing < 3 && MonotonicMicros() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    DMME_CHECK(assets.GetStats().finalizing == 3);
+
+    uint32_t updates = 0;
+    while (!assets.IsIdle() && updates < 100) {
+        assets.Update();
+        DMME_CHECK(assets.GetStats().finalizeSteps == 1);
+        ++updates;
+    }
+    DMME_CHECK(updates == 9);
+    const std::vector<std::string> expected = {"face.fake", "held.fake", "warm.fake"};
+    DMME_CHECK(script.Finalized() == expected);
+}
+
+// 1 ms slices under a 3 ms budget: a burst of twelve assets is spread
+// over many frames, and no frame runs more than one slice past the
+// budget
+DMME_TEST(BudgetSpreadsFinalisation) {
+    LoadScript script;
+    script.sliceUs = 1'000;
+    script.slices  = 2;
+    constexpr float kBudgetMs = 3.0f;
+    AssetManager assets(OneWorker(kBudgetMs));
+    Register(assets, script);
+
+    for (int i = 0; i < 12; ++i) {
+        assets.Request("asset" + std::to_string(i) + ".fake", AssetPriority::Prefetch);
+    }
+    const uint64_t deadline = MonotonicMicros() + 5'000'000;
+    while (assets.GetStats().finalizing < 12 && MonotonicMicros() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    uint32_t updates = 0;
+    uint32_t maxSteps = 0;
+    while (!assets.IsIdle() && updates < 1000) {
+        assets.Update();
+        const AssetStats stats = assets.GetStats();
+        DMME_CHECK(stats.budgetMs == kBudgetMs);
+        maxSteps = std::max(maxSteps, stats.finalizeSteps);
+        ++updates;
+    }
+    // 24 slices at most three per frame (fewer if slices run long)
+    DMME_CHECK(assets.GetStats().completed == 12);
+    DMME_CHECK(maxSteps >= 1 && maxSteps <= 3);
+    DMME_CHECK(updates >= 8);
+}
+
+// ===================================================================
+// Stats
+// ===================================================================
+
+// Time spent queued is reported per class: the held worker makes the
+// background request wait at least as long as the hold
+DMME_TEST(QueueLatencyPerClass) {
+    LoadScript script;
+    AssetManager assets(OneWorker());
+    Register(assets, script);
+
+    assets.Request("held.fake", AssetPriority::Visible);
+    DMME_CHECK(script.WaitForHeld());
+    assets.Request("warm.fake", AssetPriority::Background);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    script.Open();
+    DMME_CHECK(Drain(assets));
+
+    const AssetStats stats = assets.GetStats();
+    const size_t background = static_cast<size_t>(AssetPriority::Background);
+    const size_t visible    = static_cast<size_t>(AssetPriority::Visible);
+    DMME_CHECK(stats.maxQueueMs[background] >= 19.0f);
+    DMME_CHECK(stats.meanQueueMs[background] == stats.maxQueueMs[background]);
+    DMME_CHECK(stats.maxQueueMs[visible] < stats.maxQueueMs[background]);
+    DMME_CHECK(stats.meanQueueMs[static_cast<size_t>(AssetPriority::Prefetch)] == 0.0f);
+    DMME_CHECK(stats.meanLoadMs >= stats.meanQueueMs[visible]);
+}
+
+DMME_TEST_MAIN()
\ No newline at end of file
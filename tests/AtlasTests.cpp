@@ -0,0 +1,339 @@
+// Multi-character atlas: AtlasPacker and CharacterScheduler under
+// churn (characters added, removed, resized, hidden and rescaled),
+// checking every frame that no two slots overlap, and one shared-atlas
+// frame through RenderPipeline on the software driver, fanned out into
+// per-character views.
+
+#include "TestHarness.h"
+
+#include "core/renderer/AtlasPacker.h"
+#include "core/renderer/CharacterScheduler.h"
+#include "core/renderer/RenderPipeline.h"
+#include "core/renderer/drivers/OpenGLDriver.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace dmme;
+using namespace dmme::core::renderer;
+
+namespace {
+
+bool Overlaps(const AtlasRect& a, const AtlasRect& b) {
+    return a.x < b.x + b.width && b.x < a.x + a.width &&
+           a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+bool Inside(const AtlasRect& r, int width, int height) {
+    return !r.IsEmpty() && r.x >= 0 && r.y >= 0 &&
+           r.x + r.width <= width && r.y + r.height <= height;
+}
+
+// Every pair of rects is disjoint and inside the atlas
+bool CheckDisjoint(const std::vector<AtlasRect>& rects, int width, int height) {
+    for (size_t i = 0; i < rects.size(); ++i) {
+        if (!Inside(rects[i], width, height)) {
+            return false;
+        }
+        for (size_t j = i + 1; j < rects.size(); ++j) {
+            if (Overlaps(rects[i], rects[j])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+struct LiveCharacter {
+    CharacterId id;
+    int         width;
+    int         height;
+    bool        visible;
+};
+
+} // anonymous namespace
+
+// ===================================================================
+// AtlasPacker
+// ===================================================================
+
+DMME_TEST(PackerChurnNeverOverlaps) {
+    AtlasPacker packer;
+    packer.Reset(512, 512);
+    std::mt19937 rng(1234);
+    std::vector<AtlasRect> live;
+
+    for (int step = 0; step < 5000; ++step) {
+        if (!live.empty() && (rng() % 100) < 45) {
+            const size_t victim = rng() % live.size();
+            packer.Free(live[victim]);
+            live[victim] = live.back();
+            live.pop_back();
+        } else {
+            AtlasRect rect;
+            const int w = 8 + static_cast<int>(rng() % 120);
+            const int h = 8 + static_cast<int>(rng() % 120);
+            if (packer.Allocate(w, h, rect)) {
+                DMME_CHECK(rect.width == w && rect.height >= h);
+                live.push_back(rect);
+            }
+        }
+        if (step == 2500) {
+            DMME_CHECK(packer.Grow(1024, 768));
+        }
+
+        uint64_t area = 0;
+        for (const AtlasRect& r : live) {
+            area += static_cast<uint64_t>(r.width) * r.height;
+        }
+        DMME_CHECK(packer.GetAllocationCount() == live.size());
+        DMME_CHECK(packer.GetAllocatedArea() == area);
+    }
+    DMME_CHECK(CheckDisjoint(live, packer.GetWidth(), packer.GetHeight()));
+
+    // Everything freed: the space is whole again
+    for (const AtlasRect& r : live) {
+        packer.Free(r);
+    }
+    AtlasRect whole;
+    DMME_CHECK(packer.GetUsedHeight() == 0);
+    DMME_CHECK(packer.Allocate(1024, 768, whole));
+}
+
+// ===================================================================
+// CharacterScheduler
+// ===================================================================
+
+DMME_TEST(SchedulerChurnNeverOverlaps) {
+    CharacterSchedulerConfig config;
+    config.initialAtlasSize         = 256;
+    config.maxAtlasSize             = 1024;
+    config.releaseHiddenAfterFrames = 10;
+    config.shrinkCheckFrames        = 30;
+    CharacterScheduler scheduler(config);
+
+    constexpr int kMaxSide = 160;
+    std::mt19937 rng(42);
+    std::vector<LiveCharacter> live;
+    std::vector<AtlasRect> rects;
+    uint64_t scheduledTotal = 0;
+
+    for (int frame = 0; frame < 2000; ++frame) {
+        // A few mutations per frame
+        for (int m = 0; m < 3; ++m) {
+            const uint32_t op = rng() % 100;
+            if (live.size() < 12 && (live.empty() || op < 20)) {
+                const int w = 32 + static_cast<int>(rng() % 129);
+                const int h = 32 + static_cast<int>(rng() % 129);
+                live.push_back({scheduler.AddCharacter(w, h), w, h, true});
+            } else if (op < 30) {
+                const size_t k = rng() % live.size();
+                scheduler.RemoveCharacter(live[k].id);
+                live[k] = live.back();
+                live.pop_back();
+            } else if (op < 60) {
+                LiveCharacter& c = live[rng() % live.size()];
+                c.width  = std::clamp(c.width  + static_cast<int>(rng() % 81) - 40, 16, kMaxSide);
+                c.height = std::clamp(c.height + static_cast<int>(rng() % 81) - 40, 16, kMaxSide);
+                scheduler.SetCharacterSize(c.id, c.width, c.height);
+            } else if (op < 75) {
+                LiveCharacter& c = live[rng() % live.size()];
+                c.visible = !c.visible;
+                scheduler.SetCharacterVisible(c.id, c.visible);
+            } else if (op < 78) {
+                scheduler.SetRenderScale((rng() % 2) ? 1.0f : 0.5f);
+            } else if (op < 79) {
+                scheduler.RequestRepack();
+            }
+        }
+
+        scheduler.BeginFrame();
+        const int atlasWidth  = scheduler.GetAtlasWidth();
+        const int atlasHeight = scheduler.GetAtlasHeight();
+        DMME_CHECK(atlasWidth <= config.maxAtlasSize && atlasHeight <= config.maxAtlasSize);
+
+        // Scheduled characters are visible, live, sized at the render
+        // scale, and their render areas are disjoint
+        rects.clear();
+        for (CharacterId id : scheduler.GetScheduled()) {
+            const auto it = std::find_if(live.begin(), live.end(),
+                                         [id](const LiveCharacter& c) { return c.id == id; });
+            DMME_CHECK(it != live.end() && it->visible);
+            const AtlasRect rect = scheduler.GetRenderRect(id);
+            const float scale = scheduler.GetRenderScale();
+            DMME_CHECK(rect.width  == std::max(1, static_cast<int>(it->width  * scale + 0.5f)));
+            DMME_CHECK(rect.height == std::max(1, static_cast<int>(it->height * scale + 0.5f)));
+            rects.push_back(rect);
+        }
+        DMME_CHECK(CheckDisjoint(rects, atlasWidth, atlasHeight));
+
+        // Everything visible got a slot: twelve characters of at most
+        // kMaxSide always fit the largest atlas once repacked
+        const CharacterSchedulerStats stats = scheduler.GetStats();
+        const size_t visible = static_cast<size_t>(
+            std::count_if(live.begin(), live.end(), [](const LiveCharacter& c) { return c.visible; }));
+        DMME_CHECK(stats.characters == live.size());
+        DMME_CHECK(stats.unplaced == 0);
+        DMME_CHECK(stats.scheduled == visible);
+        scheduledTotal += stats.scheduled;
+    }
+
+    // The churn exercised moves, growth and repacks, not just placement
+    const CharacterSchedulerStats stats = scheduler.GetStats();
+    DMME_CHECK(scheduledTotal > 2000);
+    DMME_CHECK(stats.slotMoves > 0);
+    DMME_CHECK(stats.atlasResizes > 0);
+    DMME_CHECK(stats.repacks > 0);
+}
+
+// Resizes inside the slot granularity do not move anything
+DMME_TEST(SmallResizesKeepSlots) {
+    CharacterScheduler scheduler;
+    const CharacterId a = scheduler.AddCharacter(200, 300);
+    const CharacterId b = scheduler.AddCharacter(150, 150);
+    DMME_CHECK(scheduler.BeginFrame());
+    const AtlasRect before = scheduler.GetRenderRect(a);
+
+    scheduler.SetCharacterSize(a, 210, 310);
+    DMME_CHECK(scheduler.BeginFrame());
+    const AtlasRect after = scheduler.GetRenderRect(a);
+    DMME_CHECK(after.x == before.x && after.y == before.y);
+    DMME_CHECK(after.width == 210 && after.height == 310);
+    DMME_CHECK(scheduler.GetStats().slotMoves == 0);
+
+    // Outgrowing the slot moves that character alone
+    const AtlasRect other = scheduler.GetRenderRect(b);
+    scheduler.SetCharacterSize(a, 400, 300);
+    DMME_CHECK(scheduler.BeginFrame());
+    DMME_CHECK(scheduler.GetStats().slotMoves == 1);
+    DMME_CHECK(scheduler.GetRenderRect(b).x == other.x && scheduler.GetRenderRect(b).y == other.y);
+    DMME_CHECK(!Overlaps(scheduler.GetRenderRect(a), scheduler.GetRenderRect(b)));
+}
+
+// Hidden characters keep their slot for a while, then give it back
+DMME_TEST(HiddenSlotsAreReleasedLate) {
+    CharacterSchedulerConfig config;
+    config.releaseHiddenAfterFrames = 5;
+    CharacterScheduler scheduler(config);
+    const CharacterId a = scheduler.AddCharacter(256, 256);
+    scheduler.BeginFrame();
+    const AtlasRect slot = scheduler.GetRenderRect(a);
+
+    scheduler.SetCharacterVisible(a, false);
+    for (int i = 0; i < 3; ++i) {
+        DMME_CHECK(!scheduler.BeginFrame());
+    }
+    scheduler.SetCharacterVisible(a, true);
+    scheduler.BeginFrame();
+    DMME_CHECK(scheduler.GetRenderRect(a).x == slot.x && scheduler.GetRenderRect(a).y == slot.y);
+    DMME_CHECK(scheduler.GetStats().occupancy > 0.0f);
+
+    scheduler.SetCharacterVisible(a, false);
+    for (int i = 0; i < 10; ++i) {
+        scheduler.BeginFrame();
+    }
+    DMME_CHECK(scheduler.GetStats().occupancy == 0.0f);
+}
+
+// A character too big for the largest atlas is skipped; the others stay
+DMME_TEST(OversizedCharacterDoesNotEvictOthers) {
+    CharacterSchedulerConfig config;
+    config.initialAtlasSize = 256;
+    config.maxAtlasSize     = 512;
+    CharacterScheduler scheduler(config);
+    const CharacterId a = scheduler.AddCharacter(200, 200);
+    const CharacterId b = scheduler.AddCharacter(200, 200);
+    DMME_CHECK(scheduler.BeginFrame());
+
+    const CharacterId huge = scheduler.AddCharacter(600, 600);
+    DMME_CHECK(scheduler.BeginFrame());
+    DMME_CHECK(scheduler.GetStats().unplaced == 1);
+    DMME_CHECK(scheduler.GetRenderRect(huge).IsEmpty());
+    DMME_CHECK(!scheduler.GetRenderRect(a).IsEmpty() && !scheduler.GetRenderRect(b).IsEmpty());
+
+    // Shrunk to fit, it is placed on the next frame
+    scheduler.SetCharacterSize(huge, 250, 250);
+    DMME_CHECK(scheduler.BeginFrame());
+    DMME_CHECK(scheduler.GetStats().unplaced == 0);
+    DMME_CHECK(CheckDisjoint({scheduler.GetRenderRect(a), scheduler.GetRenderRect(b),
+                              scheduler.GetRenderRect(huge)},
+                             scheduler.GetAtlasWidth(), scheduler.GetAtlasHeight()));
+}
+
+// ===================================================================
+// Shared atlas frame (software driver)
+// ===================================================================
+
+// Each character fills its viewport with its own colour; after one
+// readback, every view must show exactly that colour
+DMME_TEST(OneReadbackFansOutToViews) {
+    CharacterSchedulerConfig config;
+    config.initialAtlasSize = 256;
+    CharacterScheduler scheduler(config);
+    std::vector<CharacterId> ids;
+    for (int i = 0; i < 5; ++i) {
+        ids.push_back(scheduler.AddCharacter(60 + 20 * i, 100 - 10 * i));
+    }
+    DMME_CHECK(scheduler.BeginFrame());
+
+    RenderConfig renderConfig;
+    renderConfig.preferredAPI = GraphicsAPI::OpenGL;
+    renderConfig.targetWidth  = scheduler.GetAtlasWidth();
+    renderConfig.targetHeight = scheduler.GetAtlasHeight();
+    RenderPipeline pipeline;
+    DMME_CHECK(pipeline.Initialize(nullptr, renderConfig));
+    DMME_CHECK(pipeline.GetActiveAPI() == GraphicsAPI::OpenGL);
+
+    auto colourOf = [](CharacterId id) { return static_cast<uint8_t>(40 + 30 * id); };
+
+    for (uint64_t frameId = 1; frameId <= 2; ++frameId) {
+        DMME_CHECK(pipeline.BeginFrame(frameId));
+        auto* driver = static_cast<OpenGLDriver*>(pipeline.GetDriver());
+        uint8_t* target = driver->GetTargetPixels();
+        const int pitch = driver->GetTargetWidth() * 4;
+        for (CharacterId id : scheduler.GetScheduled()) {
+            driver->SetViewport(scheduler.GetViewport(id));
+            const AtlasRect r = scheduler.GetRenderRect(id);
+            for (int y = r.y; y < r.y + r.height; ++y) {
+                std::fill_n(target + static_cast<size_t>(y) * pitch + static_cast<size_t>(r.x) * 4,
+                            static_cast<size_t>(r.width) * 4, colourOf(id));
+            }
+        }
+        DMME_CHECK(pipeline.EndFrame());
+
+        const PixelReadback* atlas = pipeline.ReadbackFrame();
+        DMME_CHECK(atlas && atlas->IsValid());
+        const std::vector<CharacterView>& views = scheduler.ResolveViews(*atlas);
+        DMME_CHECK(views.size() == ids.size());
+        for (const CharacterView& view : views) {
+            DMME_CHECK(view.frameId == atlas->frameId);
+            bool uniform = true;
+            for (int y = 0; y < view.height; ++y) {
+                const uint8_t* row = view.pixels + static_cast<size_t>(y) * view.strideBytes;
+                uniform &= std::all_of(row, row + view.width * 4, [&](uint8_t v) {
+                    return v == colourOf(view.id);
+                });
+            }
+            DMME_CHECK(uniform);
+        }
+
+        // Growing a character may grow the atlas; the pipeline
+        // follows it before the next frame
+        scheduler.SetCharacterSize(ids[0], 240, 200);
+        scheduler.BeginFrame();
+        if (scheduler.GetAtlasWidth() != renderConfig.targetWidth ||
+            scheduler.GetAtlasHeight() != renderConfig.targetHeight) {
+            renderConfig.targetWidth  = scheduler.GetAtlasWidth();
+            renderConfig.targetHeight = scheduler.GetAtlasHeight();
+            DMME_CHECK(pipeline.Resize(renderConfig.targetWidth, renderConfig.targetHeight));
+        }
+    }
+
+    // A readback of the wrong size is refused
+    PixelReadback wrong;
+    wrong.Allocate(16, 16);
+    DMME_CHECK(scheduler.ResolveViews(wrong).empty());
+}
+
+DMME_TEST_MAIN()
\ No newline at end of file
@@ -0,0 +1,320 @@
+// Block-compressed texture decoding: BC1 / BC3 / BC7 blocks against
+// stored reference decodes, DecodeBlocks' layout of block rows, and
+// the software path's decoded-tile cache against a full decode.
+//
+// The BC7 references are Pillow's DDS decodes, which follow the
+// specification bit for bit, except reserved-mode blocks (zero, as
+// D3D requires). Pillow truncates BC1 / BC3 palette interpolation, so
+// those references come from a decoder rounding to nearest, as these
+// decoders document, checked against Pillow to within 1.
+
+#include "TestHarness.h"
+
+#include "core/renderer/BlockCompression.h"
+#include "core/renderer/DecodedTileCache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace dmme;
+using namespace dmme::core::renderer;
+
+namespace {
+
+// A block and its RGBA8 decode (rows of four texels), both hex
+struct ReferenceBlock {
+    const char* block;
+    const char* rgba;
+};
+
+// ===================================================================
+// Reference blocks
+// ===================================================================
+
+// Four colours (c0 > c1, six blocks), three colours plus transparent
+// black (c0 < c1) and equal endpoints (three each)
+constexpr ReferenceBlock kBC1Reference[] = {
+    {"73956f740abac483",
+     "89a391ff89a391ff94ae9cff94ae9cff89a391ff89a391ff7e9986ff89a391ff94ae9cff738e7bff94ae9cff7e9986ff7e9986ff94ae9cff94ae9cff89a391ff"},
+    {"abedacda79e8acad",
+     "de5563ffe9965dffe47560ffde5563ffefb65affe9965dffe9965dffe47560ffefb65affe47560ffe9965dffe9965dffde5563ffe47560ffe9965dffe9965dff"},
+    {"b1d2e1d85819e5b1",
+     "d6558cffda394affde1c08ffde1c08ffde1c08ffda394affde1c08ffd6558cffde1c08ffde1c08ffda394aff00000000de1c08ffd6558cff00000000da394aff"},
+    {"51ed51ed40467fb8",
+     "efaa8cffefaa8cffefaa8cffefaa8cffefaa8cffefaa8cffefaa8cffefaa8cff000000000000000000000000efaa8cffefaa8cffefaa8cff00000000efaa8cff"},
+    {"dcaa599ba97c4468",
+     "9c69ceffa75edfffa75edfffa75edfffad59e7ffa264d6ffa264d6ff9c69ceffad59e7ff9c69ceffad59e7ff9c69ceffad59e7ffa75edfffa75edfff9c69ceff"},
+    {"f98a076092ae76ec",
+     "7e3e9cff8c5dceff630039ff7e3e9cff7e3e9cff711f6bff7e3e9cff7e3e9cff7e3e9cff630039ff711f6bff630039ff8c5dceff711f6bff7e3e9cff711f6bff"},
+    {"2132ad32e0244d7e",
+     "314508ff314508ff314d3aff00000000314508ff31556bff314d3aff314508ff31556bff00000000314508ff31556bff314d3aff000000000000000031556bff"},
+    {"f598f59876044efe",
+     "9c1cadff9c1cadff000000009c1cadff9c1cadff9c1cadff9c1cadff9c1cadff9c1cadff000000009c1cadff9c1cadff9c1cadff000000000000000000000000"},
+    {"9db60f110e455231",
+     "7e97c8ff475ca2ffb5d3efffb5d3efff10207bff10207bffb5d3efff10207bff7e97c8ffb5d3efff10207bff10207bff10207bffb5d3efff475ca2ffb5d3efff"},
+    {"d0690e171ece4e5c",
+     "4d717eff2eaa79ff10e373ff6b3884ff4d717eff2eaa79ff6b3884ff2eaa79ff4d717eff2eaa79ff6b3884ff10e373ff6b3884ff2eaa79ff10e373ff10e373ff"},
+    {"1da685adf3774a4a",
+     "00000000a5c3efff000000000000000000000000adb229ff00000000adb229ffa9bb8cffa9bb8cffa5c3efffadb229ffa9bb8cffa9bb8cffa5c3efffadb229ff"},
+    {"90a890a83e60a1b2",
+     "ad1084ff0000000000000000ad1084ffad1084ffad1084ffad1084ffad1084ffad1084ffad1084ffad1084ffad1084ffad1084ffad1084ff00000000ad1084ff"}
+};
+
+// Eight alphas (a0 > a1) and six plus 0 / 255 (a0 <= a1); the last two
+// have colour endpoints in BC1 three-colour order, still four colours
+constexpr ReferenceBlock kBC3Reference[] = {
+    {"b401cb06f34dee52714b048628c6e1ea",
+     "4a6d8c815d8a68015d8a68814a6d8c815d8a68b484c321344a6d8c6771a6451b84c3214e4a6d8c015d8a680171a6451b5d8a68345d8a684e5d8a686771a6459a"},
+    {"8df98c7002fc458ebc512f5a42d06d7f",
+     "553ac3ce5234e7f95234e7a35a457b8d5234e7ff5234e7ce5a457b8d573f9f8d5a457bce573f9fff553ac3ff5a457ba3573f9fce573f9fce573f9fb85a457bce"},
+    {"b57dbf1f65425ded838376d4fb591848",
+     "bb8481859f7b4c85bb84818dbb848185d68eb57d9f7b4cadd68eb57dd68eb5a5847118ad9f7b4cb5d68eb5958471188d847118959f7b4cad847118a5d68eb585"},
+    {"626455048188da7ccd539dd65e699a13",
+     "7e979764aab5c362d6d3ef64d6d3ef62d6d3ef627e9797627e979762d6d3ef637e9797627e979764d6d3ef627e979764aab5c36452796b64d6d3efff52796b63"},
+    {"cf5e9021e790076680c8eb9c8f49cd31",
+     "ad6f3ccfad6f3cbfce10007ebd3f1ecf9c9e5abfbd3f1e7ece10005e9c9e5a6e9c9e5acfad6f3cbfce10007ead6f3caf9c9e5acfce10009fad6f3c5ece1000af"},
+    {"5a72fddf302487bec23ffb096d70ca54",
+     "083cde6d187c99ff29bb55ff083cdeff39fb106d39fb1072187c9968083cde7229bb556829bb556839fb1068187c996439fb105a083cde6d083cdeff083cde6d"},
+    {"a67bbd35da016fc6c6155afc5c272640",
+     "10ba318daf9a9f81ff8ad687ff8ad6a0af9a9f9aff8ad69460aa688710ba318760aa687bff8ad6a660aa689410ba318110ba318710ba319410ba317bff8ad687"},
+    {"36417c6d7f8c2ff7f1622567c91f58e6",
+     "63e7293d638b6bff635d8c3f63b94a0063b94a0063b94a0063e729ff635d8c3a635d8c3d638b6b4163e7290063e729ff638b6b3863e72900638b6b3f63b94aff"}
+};
+
+// Three blocks of each mode 0 - 7, then a reserved-mode block
+constexpr ReferenceBlock kBC7Reference[] = {
+    {"b73fdfcf379f03dc885ce0acd180ac7a",
+     "d6e700ffffbdefffcdcd50ff9443b9fff9c3cdffd6e700ffa2a25effb67988ffd6e700ffd6e700ffa2a25effb67988fff3c9acffe2db43fff7f742ffd7ac59ff"},
+    {"8f78ff375e23aff3a78b5773ba0aaefc",
+     "6751c3ff6751c3ffd96eabfff62d55ff5530cdffa1b6a7ffd96eabffec4271ffec93b9ffff9cdeffe3578dffd96eabffd0847fffd98992ffff1839ffd96eabff"},
+    {"b33564454e08281262d1cc3cc4532d90",
+     "d02e24ffb36e88ffbe5561ffad7b9cff182908ff1b300aff1d370dff214210ff182908ff1e3b0eff1b300aff1c340bffa10aafffb500b5ff8e15a9ff8e15a9ff"},
+    {"0ed50530bc78845ce457c12f559f8527",
+     "56f372ff5bb759ff5e8b46ff1448b3ff57e46cff5ca852ff0e3acbff236782ff5e8b46ff57e46cff1448b3ff072be2ff5bb759ff308554ff1c599aff001cf9ff"},
+    {"360ebe5f31452b992833b3e92edc601e",
+     "3ac766ff819676ff819676ff6aa670ffe3528bffcb6286ffb37381ff3ac766ff724248ff875a5dffdbbbb5ffefd3cbffb28c8aff724248ffb28c8affefd3cbff"},
+    {"1aca4b79b36dfda93428be136320ed5d",
+     "67d27eff67d27effbdd948ff69b91eff28cda5ff67d27eff69b91eff587112ff28cda5ff5d8816ff5d8816ff63a01aff7aff2aff6fd122ff63a01aff587112ff"},
+    {"9c237739d2b4473307a3847104d9b5fe",
+     "8c4ac6ff8c4ac6ff8c4ac6ffaa7b9bff9d369fff913373ffb0509dffa5398cff9d369fffb0509dff913373ff9434b3ffa5398cffce6bc6ffce6bc6ff9434b3ff"},
+    {"d467dc1d1fe72713880d580d372e22f4",
+     "9c7363ff8cf718ffc61031ff6732abffef63adffe976a0ffc61031ff6732abffde9c84ffde9c84ff98206dffc61031ff91cc31ff91cc31ff3942e7ff98206dff"},
+    {"84d574b3364fa0102778c46840d51f05",
+     "52f708ff738442ff6ab156ff805e4dff8467a9ff8f3658ff8467a9ff9c1063ff9c21f7ff9c1063ff52f708ff8f3658ff812c3cffad10a5ffad10a5ffad10a5ff"},
+    {"d86ceec2d57504563772398cdb847731",
+     "36ae1affef4773ffb26956ff738c37ffb26956ff36ae1aff36ae1affef4773ff57d531ff66ce47ff57d531ff66ce47ff85c173ff66ce47ff76c85dff85c173ff"},
+    {"98801a4cc30bf5f8a28fd83d653ec015",
+     "3459baff405ed0ff0cbef6ff991fb1ff1a508eff0cbef6ff6b53c8ff991fb1ff991fb1ff991fb1ff3a8adfff0cbef6ff3a8adfff3a8adfff991fb1ff991fb1ff"},
+    {"3826c68fa884ad90109b280bb25e290a",
+     "122488ff8b9d94ff4a1a45ff4a1a45ffc6d89affc6d89aff771f38ff771f38ff1e1450ff771f38ff8b9d94ff122488ff771f38ff771f38ff122488ff122488ff"},
+    {"704107ef2b1b33efb35caca94dfe0e92",
+     "0808b8f792a9c1c54c56c4df92a9bec5d6f7b8ad4c56bbdfd6f7bbadd6f7b8ad4c56c4df92a9c7c54c56bbdf4c56c7df92a9b2c5d6f7bead92a9bec50808bef7"},
+    {"509a41c7b6eac5daac1a2d2655cca962",
+     "b09c8b7ed687638489aab679b0958b7eb09c8b7e639cde738987b679b09c8b7e898eb679b0a38b7eb0798b7eb08e8b7eb09c8b7e6387de73d6aa63848995b679"},
+    {"f06fdf3349d8f55ce6d9e186d59c0aec",
+     "7bbd809cb4717b55a5857568a58580687bbd7b9ca5857568c25e7b44d04c8632b4717555a585866897987579c25e75447bbd869c7bbd759ca5857b68de397521"},
+    {"20fe9e1daf7cc69c0309e4d8a3289012",
+     "fded956dfded9531fded95aba5f09cabfded9531d2ee98abfded95abfded9531a5f09c31fded95317af19f6dd2ee98abfded95ab7af19f31a5f09c6d7af19f31"},
+    {"60dafbaf69155cb4801905bbf6379c4d",
+     "1e7eadb51e7eadb52d7eadb52d9b04ef2d7eadb51e9b04ef2d7eadb517913bdc17913bdc2d7eadb51e7eadb526913bdc1e8876c82d9b04ef178876c81e8876c8"},
+    {"60037e8752cb4e99fdc0a1fc942eba15",
+     "533482565928b3f95928b3f960348256603a6a06663a6a06602e9ba95328b3f9603a6a06603a6a066634825660348256592e9ba95928b3f95928b3f953348256"},
+    {"c05752aa500d0d9d2d49136c0229d658",
+     "746b692066915c137e5073286d7f62196a885f16629c581088327d32746b692066915c135fa5550d7e50732866915c13746b69208c2980357b5970257076651c"},
+    {"c02e337bfc52ba515d3d6de7dd852e52",
+     "ada481b1afa78db29e943ea6b3aba0b59e943ea6ada481b1aba278af9b9132a49e943ea69e943ea6afa78db2a89f6fae9b9132a4b5ada9b7b5ada9b7afa78db2"},
+    {"406b137c21cb9435037f7d166b00b1f7",
+     "abb7c291acc0c8949b2f656ba47c9a819d437371a47c9a81a585a083abb7c291a0567f76a585a083acc0c894acc0c894abb7c291a0567f76a47c9a819b2f656b"},
+    {"80a8abadca1f3d926c3627473c8ef436",
+     "86b75e6eaaf39a187eac746a698a619299da7970aafb9271698a619295d18740698a61927eac746aaafb9271aafb927195d187407eac746aaaf39a187596456d"},
+    {"80948e3e2601f912cec4e5b39632a86b",
+     "bc38427ba5252b6cf38271f3afc648dba5252b6cd349598a8e14145df38271f3d349598aa5252b6ca5252b6ca5252b6c8e14145da5252b6ca5252b6cbc38427b"},
+    {"807e9bc2b04e27acbddb2377bbfb95e6",
+     "6d6586b69aebaa381fa3efae8bbf9e619aebaa388bbf9e61349eefdf9aebaa381fa3efae1fa3efae1fa3efae8bbf9e612aa1efc71fa3efae2aa1efc79aebaa38"},
+    {"00e71a04b25b4de29ce1a925913dfe3c",
+     "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"}
+};
+
+// ===================================================================
+// Helpers
+// ===================================================================
+
+std::vector<uint8_t> FromHex(const char* hex) {
+    std::vector<uint8_t> bytes(std::strlen(hex) / 2);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<uint8_t>(std::stoi(std::string(hex + i * 2, 2), nullptr, 16));
+    }
+    return bytes;
+}
+
+using DecodeFn = void (*)(const uint8_t* block, uint8_t* out, size_t outStride);
+
+// Decodes every reference block through decode and through
+// DecodeBlocks; returns the number of blocks that differ
+template <size_t N>
+int CountMismatches(const ReferenceBlock (&references)[N], TextureFormat format, DecodeFn decode) {
+    int wrong = 0;
+    for (size_t i = 0; i < N; ++i) {
+        const std::vector<uint8_t> block    = FromHex(references[i].block);
+        const std::vector<uint8_t> expected = FromHex(references[i].rgba);
+        if (block.size() != GetBlockBytes(format) || expected.size() != 64) {
+            ++wrong;
+            continue;
+        }
+        uint8_t direct[64], batched[64];
+        decode(block.data(), direct, 16);
+        DecodeBlocks(format, block.data(), block.size(), 1, 1, batched, 16);
+        if (std::memcmp(direct, expected.data(), 64) != 0 || std::memcmp(batched, expected.data(), 64) != 0) {
+            std::fprintf(stderr, "block %zu (%s) decodes differently\n", i, references[i].block);
+            ++wrong;
+        }
+    }
+    return wrong;
+}
+
+// A width x height BC texture tiled with the reference blocks
+template <size_t N>
+std::vector<uint8_t> BuildTexture(const ReferenceBlock (&references)[N], int width, int height) {
+    std::vector<uint8_t> blocks;
+    const int count = (width / kBlockSize) * (height / kBlockSize);
+    for (int i = 0; i < count; ++i) {
+        const std::vector<uint8_t> block = FromHex(references[(i * 7) % N].block);
+        blocks.insert(blocks.end(), block.begin(), block.end());
+    }
+    return blocks;
+}
+
+} // anonymous namespace
+
+// ===================================================================
+// Reference decodes
+// ===================================================================
+
+DMME_TEST(BC1MatchesReference) {
+    DMME_CHECK(CountMismatches(kBC1Reference, TextureFormat::BC1_UNORM, DecodeBC1Block) == 0);
+}
+
+DMME_TEST(BC3MatchesReference) {
+    DMME_CHECK(CountMismatches(kBC3Reference, TextureFormat::BC3_UNORM, DecodeBC3Block) == 0);
+}
+
+DMME_TEST(BC7MatchesReference) {
+    DMME_CHECK(CountMismatches(kBC7Reference, TextureFormat::BC7_UNORM, DecodeBC7Block) == 0);
+}
+
+// ===================================================================
+// Layout
+// ===================================================================
+
+// Block rows blockPitch bytes apart land 4 texel rows apart in the
+// output; bytes past each output row are left alone
+DMME_TEST(DecodeBlocksLaysOutBlockRows) {
+    constexpr int kBlocksWide = 3, kBlocksHigh = 2;
+    constexpr size_t kBlockPitch = kBlocksWide * 16 + 16;
+    constexpr size_t kOutStride  = kBlocksWide * 16 + 12;
+    constexpr uint8_t kGuard = 0xCD;
+
+    std::vector<uint8_t> blocks(kBlockPitch * kBlocksHigh, 0);
+    for (int by = 0; by < kBlocksHigh; ++by) {
+        for (int bx = 0; bx < kBlocksWide; ++bx) {
+            const std::vector<uint8_t> block = FromHex(kBC7Reference[by * kBlocksWide + bx].block);
+            std::memcpy(&blocks[by * kBlockPitch + bx * 16], block.data(), 16);
+        }
+    }
+    std::vector<uint8_t> out(kOutStride * kBlocksHigh * kBlockSize, kGuard);
+    DMME_CHECK(DecodeBlocks(TextureFormat::BC7_UNORM, blocks.data(), kBlockPitch,
+                            kBlocksWide, kBlocksHigh, out.data(), kOutStride));
+
+    int wrong = 0;
+    for (int by = 0; by < kBlocksHigh; ++by) {
+        for (int bx = 0; bx < kBlocksWide; ++bx) {
+            const std::vector<uint8_t> expected = FromHex(kBC7Reference[by * kBlocksWide + bx].rgba);
+            for (int row = 0; row < kBlockSize; ++row) {
+                const uint8_t* texels = &out[(by * kBlockSize + row) * kOutStride + bx * 16];
+                wrong += std::memcmp(texels, &expected[row * 16], 16) != 0;
+            }
+        }
+    }
+    for (size_t row = 0; row < kBlocksHigh * kBlockSize; ++row) {
+        for (size_t i = kBlocksWide * 16; i < kOutStride; ++i) {
+            wrong += out[row * kOutStride + i] != kGuard;
+        }
+    }
+    DMME_CHECK(wrong == 0);
+
+    uint8_t unused[64];
+    DMME_CHECK(!DecodeBlocks(TextureFormat::RGBA8_UNORM, blocks.data(), kBlockPitch, 1, 1, unused, 16));
+}
+
+// ===================================================================
+// Decoded-tile cache
+// ===================================================================
+
+// Every tile of a texture with partial edge tiles matches a full
+// decode, within a two-tile budget; updates invalidate what they cover
+DMME_TEST(TileCacheMatchesFullDecode) {
+    constexpr int kWidth = 160, kHeight = 96;           // 3 x 2 tiles, edges partial
+    constexpr TextureHandle kTexture = 5;
+    const std::vector<uint8_t> blocks = BuildTexture(kBC3Reference, kWidth, kHeight);
+    const size_t blockPitch = (kWidth / kBlockSize) * GetBlockBytes(TextureFormat::BC3_UNORM);
+
+    std::vector<uint8_t> full(static_cast<size_t>(kWidth) * kHeight * 4);
+    DMME_CHECK(DecodeBlocks(TextureFormat::BC3_UNORM, blocks.data(), blockPitch,
+                            kWidth / kBlockSize, kHeight / kBlockSize, full.data(), kWidth * 4));
+
+    DecodedTileCache cache;
+    cache.SetBudget(2 * kDecodedTileBytes);
+
+    int wrong = 0;
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int ty = 0; ty < 2; ++ty) {
+            for (int tx = 0; tx < 3; ++tx) {
+                const uint8_t* tile = cache.GetTile(kTexture, TextureFormat::BC3_UNORM, blocks.data(),
+                                                    kWidth, kHeight, tx, ty);
+                if (!tile) {
+                    ++wrong;
+                    continue;
+                }
+                const int x0 = tx * kDecodedTileSize, y0 = ty * kDecodedTileSize;
+                const int w = std::min(kDecodedTileSize, kWidth - x0);
+                const int h = std::min(kDecodedTileSize, kHeight - y0);
+                for (int y = 0; y < h; ++y) {
+                    wrong += std::memcmp(tile + static_cast<size_t>(y) * kDecodedTileSize * 4,
+                                         &full[(static_cast<size_t>(y0 + y) * kWidth + x0) * 4],
+                                         static_cast<size_t>(w) * 4) != 0;
+                }
+            }
+        }
+    }
+    DMME_CHECK(wrong == 0);
+
+    DecodedTileStats stats = cache.GetStats();
+    DMME_CHECK(stats.capacityTiles == 2);
+    DMME_CHECK(stats.residentTiles <= stats.capacityTiles);
+    DMME_CHECK(stats.misses == 12);                     // six tiles cycled through two slots
+    DMME_CHECK(stats.evictions == 10);
+
+    // Outside the texture, or not block-compressed: no tile
+    DMME_CHECK(cache.GetTile(kTexture, TextureFormat::BC3_UNORM, blocks.data(), kWidth, kHeight, 3, 0) == nullptr);
+    DMME_CHECK(cache.GetTile(kTexture, TextureFormat::RGBA8_UNORM, blocks.data(), kWidth, kHeight, 0, 0) == nullptr);
+
+    // The last tile is resident; an update over it forces a decode
+    cache.ResetStats();
+    cache.GetTile(kTexture, TextureFormat::BC3_UNORM, blocks.data(), kWidth, kHeight, 2, 1);
+    DMME_CHECK(cache.GetStats().hits == 1);
+    PixelRegion region;
+    region.x      = 140;
+    region.y      = 80;
+    region.width  = 4;
+    region.height = 4;
+    cache.Invalidate(kTexture, region);
+    cache.GetTile(kTexture, TextureFormat::BC3_UNORM, blocks.data(), kWidth, kHeight, 2, 1);
+    stats = cache.GetStats();
+    DMME_CHECK(stats.hits == 1);
+    DMME_CHECK(stats.misses == 1);
+}
+
+DMME_TEST_MAIN()
\ No newline at end of file
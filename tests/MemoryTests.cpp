@@ -0,0 +1,169 @@
+// MemoryAccountant counting, budgets and trim handlers, with the
+// software driver's decoded tile cache as the trimmable Cache consumer
+// (what DMME_CACHE_BUDGET_MB caps in the engine).
+//
+// The accountant is process-wide; every check works on deltas or on
+// categories the case owns.
+
+#include "TestHarness.h"
+
+#include "core/memory/MemoryAccountant.h"
+#include "core/renderer/DecodedTileCache.h"
+
+#include <memory>
+#include <vector>
+
+using namespace dmme;
+using namespace dmme::core;
+using namespace dmme::core::memory;
+
+namespace {
+
+constexpr uint64_t kMiB = 1024 * 1024;
+
+uint64_t CacheBytes() {
+    return MemoryAccountant::GetUsage(MemoryCategory::Cache).currentBytes;
+}
+
+// A 512x512 BC1 texture: 128 x 128 blocks of 8 bytes, 8 x 8 tiles
+constexpr int kTextureSize = 512;
+constexpr int kTilesWide   = kTextureSize / renderer::kDecodedTileSize;
+
+std::vector<uint8_t> MakeBc1Blocks() {
+    return std::vector<uint8_t>(static_cast<size_t>(kTextureSize / 4) * (kTextureSize / 4) * 8,
+                                0x5A);
+}
+
+// Decode every tile of the texture once
+void TouchAllTiles(renderer::DecodedTileCache& cache, const std::vector<uint8_t>& blocks) {
+    for (int ty = 0; ty < kTilesWide; ++ty) {
+        for (int tx = 0; tx < kTilesWide; ++tx) {
+            cache.GetTile(1, renderer::TextureFormat::BC1_UNORM, blocks.data(),
+                          kTextureSize, kTextureSize, tx, ty);
+        }
+    }
+}
+
+} // anonymous namespace
+
+// ===================================================================
+// Counting
+// ===================================================================
+
+DMME_TEST(TrackedMemoryCountsCurrentAndPeak) {
+    const MemoryCategoryUsage before = MemoryAccountant::GetUsage(MemoryCategory::Staging);
+    {
+        TrackedMemory buffer(MemoryCategory::Staging);
+        buffer.Set(4 * kMiB);
+        buffer.Set(1 * kMiB);
+        const MemoryCategoryUsage usage = MemoryAccountant::GetUsage(MemoryCategory::Staging);
+        DMME_CHECK(usage.currentBytes == before.currentBytes + 1 * kMiB);
+        DMME_CHECK(usage.peakBytes >= before.currentBytes + 4 * kMiB);
+    }
+    DMME_CHECK(MemoryAccountant::GetUsage(MemoryCategory::Staging).currentBytes ==
+               before.currentBytes);
+}
+
+// ===================================================================
+// Budgets and trim handlers
+// ===================================================================
+
+DMME_TEST(EnforceBudgetsRunsHandlersUntilUnderBudget) {
+    TrackedMemory cache(MemoryCategory::Asset);
+    cache.Set(10 * kMiB);
+    const uint64_t base = MemoryAccountant::GetUsage(MemoryCategory::Asset).currentBytes -
+                          10 * kMiB;
+
+    size_t firstAsked = 0;
+    int    secondCalls = 0;
+    const auto first = MemoryAccountant::RegisterTrimHandler(MemoryCategory::Asset,
+        [&](size_t bytesOver) {
+            firstAsked = bytesOver;
+            cache.Set(cache.GetBytes() - 2 * kMiB);   // frees less than asked
+            return static_cast<size_t>(2 * kMiB);
+        });
+    const auto second = MemoryAccountant::RegisterTrimHandler(MemoryCategory::Asset,
+        [&](size_t bytesOver) {
+            ++secondCalls;
+            cache.Set(cache.GetBytes() - bytesOver);
+            return bytesOver;
+        });
+
+    // Under budget: nothing runs
+    MemoryAccountant::SetBudget(MemoryCategory::Asset, base + 16 * kMiB);
+    DMME_CHECK(MemoryAccountant::EnforceBudgets() == 0);
+    DMME_CHECK(firstAsked == 0 && secondCalls == 0);
+
+    // 6 MiB over: the first handler frees 2, the second the other 4
+    MemoryAccountant::SetBudget(MemoryCategory::Asset, base + 4 * kMiB);
+    DMME_CHECK(MemoryAccountant::EnforceBudgets() == 6 * kMiB);
+    DMME_CHECK(firstAsked == 6 * kMiB);
+    DMME_CHECK(secondCalls == 1);
+    DMME_CHECK(cache.GetBytes() == 4 * kMiB);
+
+    // Unregistered handlers are not called again
+    MemoryAccountant::UnregisterTrimHandler(first);
+    MemoryAccountant::UnregisterTrimHandler(second);
+    cache.Set(8 * kMiB);
+    DMME_CHECK(MemoryAccountant::EnforceBudgets() == 0);
+    DMME_CHECK(secondCalls == 1);
+    MemoryAccountant::SetBudget(MemoryCategory::Asset, 0);
+}
+
+// ===================================================================
+// Decoded tile cache as the Cache consumer
+// ===================================================================
+
+DMME_TEST(CacheBudgetTrimsDecodedTiles) {
+    const uint64_t base = CacheBytes();
+    const std::vector<uint8_t> blocks = MakeBc1Blocks();
+
+    renderer::DecodedTileCache cache;
+    TouchAllTiles(cache, blocks);
+    DMME_CHECK(cache.GetStats().residentTiles == 64);
+    DMME_CHECK(CacheBytes() == base + 64 * renderer::kDecodedTileBytes);
+
+    // Cap the category at 40 tiles' worth: the cache gives back the
+    // 24 least recently used
+    MemoryAccountant::SetBudget(MemoryCategory::Cache, base + 40 * renderer::kDecodedTileBytes);
+    DMME_CHECK(MemoryAccountant::EnforceBudgets() == 24 * renderer::kDecodedTileBytes);
+    DMME_CHECK(CacheBytes() == base + 40 * renderer::kDecodedTileBytes);
+
+    const renderer::DecodedTileStats stats = cache.GetStats();
+    DMME_CHECK(stats.residentTiles == 40);
+    DMME_CHECK(stats.capacityTiles == 40);
+    DMME_CHECK(stats.evictions == 24);
+
+    // The most recently used tiles survived
+    const uint64_t misses = stats.misses;
+    cache.GetTile(1, renderer::TextureFormat::BC1_UNORM, blocks.data(), kTextureSize,
+                  kTextureSize, kTilesWide - 1, kTilesWide - 1);
+    DMME_CHECK(cache.GetStats().misses == misses);
+
+    // The lowered capacity holds: touching everything again stays
+    // within budget instead of regrowing
+    TouchAllTiles(cache, blocks);
+    DMME_CHECK(CacheBytes() == base + 40 * renderer::kDecodedTileBytes);
+    DMME_CHECK(MemoryAccountant::EnforceBudgets() == 0);
+
+    MemoryAccountant::SetBudget(MemoryCategory::Cache, 0);
+}
+
+DMME_TEST(DestroyedCacheUnregistersTrimHandler) {
+    const uint64_t base = CacheBytes();
+    const std::vector<uint8_t> blocks = MakeBc1Blocks();
+
+    auto cache = std::make_unique<renderer::DecodedTileCache>();
+    TouchAllTiles(*cache, blocks);
+    cache.reset();
+    DMME_CHECK(CacheBytes() == base);
+
+    // Over budget with no cache left: nothing to call, nothing freed
+    TrackedMemory other(MemoryCategory::Cache);
+    other.Set(base + 1 * kMiB);
+    MemoryAccountant::SetBudget(MemoryCategory::Cache, 1);
+    DMME_CHECK(MemoryAccountant::EnforceBudgets() == 0);
+    MemoryAccountant::SetBudget(MemoryCategory::Cache, 0);
+}
+
+DMME_TEST_MAIN()
\ No newline at end of file
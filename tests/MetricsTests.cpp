@@ -0,0 +1,347 @@
+// MetricsEndpoint end to end over its Unix domain socket: a local
+// client sends requests and checks the JSON and binary replies against
+// what the "render thread" published, including while publishing runs
+// flat out on another thread.
+
+#include "TestHarness.h"
+
+#include "core/profiling/MetricsEndpoint.h"
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace dmme;
+using namespace dmme::core::profiling;
+
+namespace {
+
+std::string SocketPath() {
+    return "/tmp/dmme-metrics-test-" + std::to_string(getpid()) + ".sock";
+}
+
+MetricsEndpointConfig TestConfig() {
+    MetricsEndpointConfig config;
+    config.name = SocketPath();
+    return config;
+}
+
+bool PathExists(const std::string& path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0;
+}
+
+// A frame's worth of telemetry; every field derives from n so a torn
+// snapshot shows up as fields that disagree
+MetricsSnapshot MakeSnapshot(uint64_t n) {
+    MetricsSnapshot s;
+    s.timestampUs       = 1000 + n;
+    s.frameNumber       = n;
+    s.frameTimeMs       = 16.5f;
+    s.drawCalls         = static_cast<int32_t>(n % 1000);
+    s.presentCount      = n * 2;
+    s.surfaceWidth      = 512;
+    s.surfaceHeight     = 384;
+    s.readbackBytes     = n * 4;
+    s.uploadBytes       = n * 8;
+    std::snprintf(s.driverName, sizeof(s.driverName), "Software");
+    std::snprintf(s.adapterName, sizeof(s.adapterName), "Headless \"test\" adapter");
+    return s;
+}
+
+bool IsConsistent(const MetricsSnapshot& s) {
+    const uint64_t n = s.frameNumber;
+    return s.timestampUs == 1000 + n && s.drawCalls == static_cast<int32_t>(n % 1000) &&
+           s.presentCount == n * 2 && s.readbackBytes == n * 4 && s.uploadBytes == n * 8;
+}
+
+// Blocking client with a receive timeout so a broken endpoint fails
+// the test instead of hanging it
+class MetricsClient {
+public:
+    MetricsClient() = default;
+    ~MetricsClient() {
+        if (m_fd >= 0) {
+            close(m_fd);
+        }
+    }
+
+    MetricsClient(const MetricsClient&) = delete;
+    MetricsClient& operator=(const MetricsClient&) = delete;
+
+    bool Connect(const std::string& path) {
+        m_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (m_fd < 0) {
+            return false;
+        }
+        timeval timeout{2, 0};
+        setsockopt(m_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path.c_str());
+        return connect(m_fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0;
+    }
+
+    bool Send(const std::string& data) {
+        return send(m_fd, data.data(), data.size(), MSG_NOSIGNAL) ==
+               static_cast<ssize_t>(data.size());
+    }
+
+    bool ReadExactly(size_t size, std::string& out) {
+        out.clear();
+        while (out.size() < size) {
+            if (m_buffered.empty() && !Fill()) {
+                return false;
+            }
+            const size_t take = std::min(size - out.size(), m_buffered.size());
+            out.append(m_buffered, 0, take);
+            m_buffered.erase(0, take);
+        }
+        return true;
+    }
+
+    bool ReadLine(std::string& out) {
+        size_t newline;
+        while ((newline = m_buffered.find('\n')) == std::string::npos) {
+            if (!Fill()) {
+                return false;
+            }
+        }
+        out = m_buffered.substr(0, newline);
+        m_buffered.erase(0, newline + 1);
+        return true;
+    }
+
+    // Binary reply (header + snapshot); false on a JSON error reply
+    bool ReadSnapshot(MetricsBinaryHeader& header, MetricsSnapshot& snapshot) {
+        if (m_buffered.empty() && !Fill()) {
+            return false;
+        }
+        if (m_buffered[0] == '{') {
+            std::string error;
+            ReadLine(error);
+            return false;
+        }
+        std::string bytes;
+        if (!ReadExactly(sizeof(header) + sizeof(snapshot), bytes)) {
+            return false;
+        }
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        std::memcpy(&snapshot, bytes.data() + sizeof(header), sizeof(snapshot));
+        return true;
+    }
+
+    // True once the endpoint has closed the connection
+    bool IsClosedByPeer() {
+        char byte;
+        return recv(m_fd, &byte, 1, 0) == 0;
+    }
+
+private:
+    bool Fill() {
+        char buffer[4096];
+        const ssize_t n = recv(m_fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) {
+            return false;
+        }
+        m_buffered.append(buffer, static_cast<size_t>(n));
+        return true;
+    }
+
+    int         m_fd = -1;
+    std::string m_buffered;
+};
+
+} // anonymous namespace
+
+// ===================================================================
+// Round trips
+// ===================================================================
+
+DMME_TEST(JsonRoundTrip) {
+    MetricsEndpoint endpoint(TestConfig());
+    DMME_CHECK(endpoint.Start());
+    DMME_CHECK(endpoint.GetAddress() == SocketPath());
+    endpoint.Publish(MakeSnapshot(42));
+
+    MetricsClient client;
+    DMME_CHECK(client.Connect(endpoint.GetAddress()));
+    DMME_CHECK(client.Send("json\n"));
+    std::string line;
+    DMME_CHECK(client.ReadLine(line));
+
+    DMME_CHECK(line.front() == '{' && line.back() == '}');
+    DMME_CHECK(line.find("\"publishCount\":1,") != std::string::npos);
+    DMME_CHECK(line.find("\"number\":42,") != std::string::npos);
+    DMME_CHECK(line.find("\"width\":512,\"height\":384") != std::string::npos);
+    DMME_CHECK(line.find("\"readbackBytes\":168,") != std::string::npos);
+    DMME_CHECK(line.find("\"driver\":\"Software\"") != std::string::npos);
+    DMME_CHECK(line.find("\"adapter\":\"Headless \\\"test\\\" adapter\"") != std::string::npos);
+    DMME_CHECK(line == MetricsEndpoint::FormatJson([&] {
+        MetricsSnapshot latest;
+        endpoint.GetLatest(latest);
+        return latest;
+    }()));
+
+    endpoint.Stop();
+}
+
+DMME_TEST(BinaryRoundTrip) {
+    MetricsEndpoint endpoint(TestConfig());
+    DMME_CHECK(endpoint.Start());
+    endpoint.Publish(MakeSnapshot(7));
+    endpoint.Publish(MakeSnapshot(8));
+
+    MetricsClient client;
+    DMME_CHECK(client.Connect(endpoint.GetAddress()));
+    DMME_CHECK(client.Send("binary\n"));
+    MetricsBinaryHeader header;
+    MetricsSnapshot     snapshot;
+    DMME_CHECK(client.ReadSnapshot(header, snapshot));
+
+    DMME_CHECK(header.magic == kMetricsBinaryMagic);
+    DMME_CHECK(header.version == kMetricsBinaryVersion);
+    DMME_CHECK(header.payloadSize == sizeof(MetricsSnapshot));
+    DMME_CHECK(snapshot.publishCount == 2);
+    DMME_CHECK(snapshot.frameNumber == 8 && IsConsistent(snapshot));
+    DMME_CHECK(std::strcmp(snapshot.driverName, "Software") == 0);
+
+    endpoint.Stop();
+}
+
+// Several requests in one write are answered in order
+DMME_TEST(PipelinedRequests) {
+    MetricsEndpoint endpoint(TestConfig());
+    DMME_CHECK(endpoint.Start());
+    endpoint.Publish(MakeSnapshot(3));
+
+    MetricsClient client;
+    DMME_CHECK(client.Connect(endpoint.GetAddress()));
+    DMME_CHECK(client.Send("json\r\nbin\nfrobnicate\n"));
+
+    std::string line;
+    DMME_CHECK(client.ReadLine(line) && line.find("\"number\":3,") != std::string::npos);
+    MetricsBinaryHeader header;
+    MetricsSnapshot     snapshot;
+    DMME_CHECK(client.ReadSnapshot(header, snapshot) && snapshot.frameNumber == 3);
+    DMME_CHECK(client.ReadLine(line) && line == "{\"error\":\"unknown request\"}");
+    DMME_CHECK(endpoint.GetRequestCount() == 3);
+
+    endpoint.Stop();
+}
+
+// ===================================================================
+// Concurrency and lifecycle
+// ===================================================================
+
+// Publishing flat out while a client reads: every snapshot served is
+// one the writer published whole, and frame numbers never go back
+DMME_TEST(ServedSnapshotsAreNeverTorn) {
+    MetricsEndpoint endpoint(TestConfig());
+    DMME_CHECK(endpoint.Start());
+    endpoint.Publish(MakeSnapshot(0));
+
+    std::atomic<bool> done{false};
+    std::thread renderThread([&] {
+        for (uint64_t n = 1; !done.load(std::memory_order_relaxed); ++n) {
+            endpoint.Publish(MakeSnapshot(n));
+        }
+    });
+
+    MetricsClient client;
+    DMME_CHECK(client.Connect(endpoint.GetAddress()));
+    int served = 0;
+    uint64_t lastFrame = 0;
+    for (int i = 0; i < 500; ++i) {
+        DMME_CHECK(client.Send("binary\n"));
+        MetricsBinaryHeader header;
+        MetricsSnapshot     snapshot;
+        if (!client.ReadSnapshot(header, snapshot)) {
+            continue;   // "snapshot busy": the reader gave up, never the writer
+        }
+        ++served;
+        DMME_CHECK(IsConsistent(snapshot));
+        DMME_CHECK(snapshot.frameNumber >= lastFrame);
+        DMME_CHECK(snapshot.publishCount == snapshot.frameNumber + 1);
+        lastFrame = snapshot.frameNumber;
+    }
+    done = true;
+    renderThread.join();
+
+    DMME_CHECK(served > 0);
+    DMME_CHECK(lastFrame > 0);
+    endpoint.Stop();
+}
+
+DMME_TEST(OverlongRequestDropsClient) {
+    MetricsEndpoint endpoint(TestConfig());
+    DMME_CHECK(endpoint.Start());
+
+    MetricsClient client;
+    DMME_CHECK(client.Connect(endpoint.GetAddress()));
+    DMME_CHECK(client.Send(std::string(300, 'x')));
+    DMME_CHECK(client.IsClosedByPeer());
+
+    // The endpoint carries on serving the next client
+    MetricsClient next;
+    std::string line;
+    DMME_CHECK(next.Connect(endpoint.GetAddress()));
+    DMME_CHECK(next.Send("json\n") && next.ReadLine(line));
+
+    endpoint.Stop();
+}
+
+DMME_TEST(StopRemovesSocket) {
+    MetricsEndpoint endpoint(TestConfig());
+    DMME_CHECK(endpoint.Start());
+    DMME_CHECK(PathExists(SocketPath()));
+    endpoint.Stop();
+    DMME_CHECK(!endpoint.IsRunning());
+    DMME_CHECK(!PathExists(SocketPath()));
+
+    MetricsClient client;
+    DMME_CHECK(!client.Connect(SocketPath()));
+
+    // Restartable on the same path
+    DMME_CHECK(endpoint.Start());
+    endpoint.Stop();
+}
+
+// A second instance on a live path fails and leaves the first one
+// serving; a stale socket file is replaced. The socket is owner-only.
+DMME_TEST(SecondInstanceLeavesLiveSocketAlone) {
+    MetricsEndpoint first(TestConfig());
+    DMME_CHECK(first.Start());
+    struct stat st;
+    DMME_CHECK(stat(SocketPath().c_str(), &st) == 0 && (st.st_mode & 0777) == 0600);
+
+    MetricsEndpoint second(TestConfig());
+    DMME_CHECK(!second.Start());
+    MetricsClient client;
+    std::string line;
+    DMME_CHECK(client.Connect(first.GetAddress()));
+    DMME_CHECK(client.Send("json\n") && client.ReadLine(line));
+    first.Stop();
+
+    // Bound and closed without unlinking, as a crash leaves it
+    const int stale = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", SocketPath().c_str());
+    DMME_CHECK(bind(stale, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0);
+    close(stale);
+    DMME_CHECK(PathExists(SocketPath()));
+    DMME_CHECK(second.Start());
+    second.Stop();
+    DMME_CHECK(!PathExists(SocketPath()));
+}
+
+DMME_TEST_MAIN()
\ No newline at end of file
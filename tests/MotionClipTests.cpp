@@ -0,0 +1,118 @@
+// Motion clips' baked form: a built clip saved and loaded back samples
+// the same, and LoadBaked rejects blobs that would make the samplers
+// read out of bounds (empty tracks, curve start indices past the
+// samples or going backwards) instead of trusting them.
+
+#include "TestHarness.h"
+
+#include "core/animation/MotionClip.h"
+#include "core/animation/MotionSampler.h"
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace dmme;
+using namespace dmme::core::animation;
+
+namespace {
+
+constexpr size_t kTrackTableOffset = 5 * 4 + 4;    // counts, duration
+
+constexpr uint8_t kEasing[4][4] = {{40, 0, 87, 127}, {10, 30, 100, 90}, {20, 20, 107, 107}, {64, 0, 64, 127}};
+
+// Two bone tracks with eased keys and one morph track
+void BuildClip(MotionClip& clip) {
+    std::vector<VmdBoneKey> boneKeys;
+    for (uint32_t b = 0; b < 2; ++b) {
+        for (uint32_t f = 0; f <= 30; f += 10) {
+            VmdBoneKey key;
+            key.name           = "bone" + std::to_string(b);
+            key.frame          = f;
+            key.translation[1] = 0.1f * static_cast<float>(f + b);
+            std::memcpy(key.interpolation, kEasing, sizeof(kEasing));
+            boneKeys.push_back(key);
+        }
+    }
+    std::vector<VmdMorphKey> morphKeys;
+    for (uint32_t f = 0; f <= 30; f += 15) {
+        VmdMorphKey key;
+        key.name   = "smile";
+        key.frame  = f;
+        key.weight = static_cast<float>(f) / 30.0f;
+        morphKeys.push_back(key);
+    }
+    clip.Build(boneKeys, morphKeys);
+}
+
+void WriteU32(std::vector<uint8_t>& blob, size_t offset, uint32_t value) {
+    std::memcpy(&blob[offset], &value, sizeof(value));
+}
+
+} // anonymous namespace
+
+// ===================================================================
+// Baked form
+// ===================================================================
+
+DMME_TEST(BakedRoundTripSamplesTheSame) {
+    MotionClip built;
+    BuildClip(built);
+    std::vector<uint8_t> blob;
+    built.SaveBaked(blob);
+
+    MotionClip loaded;
+    DMME_CHECK(loaded.LoadBaked(blob.data(), blob.size()));
+    DMME_CHECK(loaded.GetBoneTrackCount() == 2);
+    DMME_CHECK(loaded.GetCurveCount() == built.GetCurveCount());
+
+    MotionSampler a, b;
+    a.Bind(&built);
+    b.Bind(&loaded);
+    MotionPose pa, pb;
+    pa.Resize(2, 1);
+    pb.Resize(2, 1);
+    int wrong = 0;
+    for (float frame = 0.0f; frame <= 32.0f; frame += 0.7f) {
+        a.Sample(frame, pa);
+        b.Sample(frame, pb);
+        wrong += pa.ty[0] != pb.ty[0] || pa.ty[1] != pb.ty[1] || pa.qw[1] != pb.qw[1] ||
+                 pa.morphWeights[0] != pb.morphWeights[0];
+    }
+    DMME_CHECK(wrong == 0);
+}
+
+DMME_TEST(LoadBakedRejectsMalformedBlobs) {
+    MotionClip built;
+    BuildClip(built);
+    std::vector<uint8_t> blob;
+    built.SaveBaked(blob);
+    const uint32_t boneKeys = built.GetBoneKeyCount();
+
+    // An empty track at the end of the key table: first key == count
+    std::vector<uint8_t> emptyTrack = blob;
+    WriteU32(emptyTrack, kTrackTableOffset, boneKeys);
+    WriteU32(emptyTrack, kTrackTableOffset + 4, 0);
+    MotionClip clip;
+    DMME_CHECK(!clip.LoadBaked(emptyTrack.data(), emptyTrack.size()));
+    DMME_CHECK(clip.GetBoneTrackCount() == 0);
+
+    // Curves are the blob's tail; damage the last one's start table
+    const size_t lastCurve = blob.size() - sizeof(BakedCurve);
+    const size_t start     = lastCurve + offsetof(BakedCurve, start);
+
+    std::vector<uint8_t> pastSamples = blob;
+    pastSamples[start + kCurveSamples - 1] = 255;
+    DMME_CHECK(!clip.LoadBaked(pastSamples.data(), pastSamples.size()));
+
+    std::vector<uint8_t> backwards = blob;
+    backwards[start] = backwards[start + kCurveSamples - 1];
+    DMME_CHECK(backwards[start] > backwards[start + 1]);
+    DMME_CHECK(!clip.LoadBaked(backwards.data(), backwards.size()));
+
+    // The undamaged blob still loads
+    DMME_CHECK(clip.LoadBaked(blob.data(), blob.size()));
+}
+
+DMME_TEST_MAIN()
\ No newline at end of file
@@ -0,0 +1,236 @@
+// LZ codec and asset packs: round trips over data shaped like real
+// assets, the compressor's capacity contract (a buffer of exactly the
+// compressed size is enough), damaged input, and a pack written,
+// reopened and read back entry by entry.
+
+#include "TestHarness.h"
+
+#include "core/assets/AssetPack.h"
+#include "core/assets/Lz.h"
+#include "core/jobs/JobSystem.h"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace dmme;
+using namespace dmme::core;
+using namespace dmme::core::assets;
+
+namespace {
+
+// Deterministic noise; incompressible
+std::vector<uint8_t> Noise(size_t size, uint32_t seed) {
+    std::vector<uint8_t> out(size);
+    uint32_t state = seed * 2654435761u + 1;
+    for (uint8_t& b : out) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        b = static_cast<uint8_t>(state);
+    }
+    return out;
+}
+
+// Repetitive records with a varying field, like vertex or key data
+std::vector<uint8_t> Records(size_t size) {
+    std::vector<uint8_t> out(size);
+    for (size_t i = 0; i < size; ++i) {
+        out[i] = (i % 32 < 24) ? static_cast<uint8_t>(i % 7) : static_cast<uint8_t>((i * 131) >> 5);
+    }
+    return out;
+}
+
+// Noise runs broken by long repeats: literal and match lengths both
+// cross the 15 and 255 length-byte boundaries
+std::vector<uint8_t> LongRuns(size_t size) {
+    std::vector<uint8_t> out = Noise(size, 7);
+    for (size_t i = 600; i + 900 < size; i += 1500) {
+        std::memcpy(&out[i], &out[i - 600], 300 + i % 400);
+    }
+    return out;
+}
+
+std::vector<std::vector<uint8_t>> Inputs() {
+    std::vector<std::vector<uint8_t>> inputs;
+    for (size_t size : {0u, 1u, 5u, 12u, 13u, 17u, 64u}) {
+        inputs.push_back(Records(size));
+    }
+    inputs.push_back(std::vector<uint8_t>(100'000, 0));
+    inputs.push_back(Records(65'536));
+    inputs.push_back(LongRuns(65'536));
+    inputs.push_back(Noise(4'096, 3));
+    return inputs;
+}
+
+std::vector<uint8_t> Compress(const std::vector<uint8_t>& input) {
+    std::vector<uint8_t> out(LzCompressBound(input.size()));
+    out.resize(LzCompress(input.data(), input.size(), out.data(), out.size()));
+    return out;
+}
+
+class TempPack {
+public:
+    TempPack() {
+        const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+        m_path = (std::filesystem::temp_directory_path() /
+                  ("dmme_pack_test_" + std::to_string(stamp) + ".pak")).string();
+    }
+    ~TempPack() {
+        std::error_code ec;
+        std::filesystem::remove(m_path, ec);
+    }
+    const std::string& Path() const { return m_path; }
+
+private:
+    std::string m_path;
+};
+
+} // anonymous namespace
+
+// ===================================================================
+// LZ codec
+// ===================================================================
+
+DMME_TEST(LzRoundTrips) {
+    for (const std::vector<uint8_t>& input : Inputs()) {
+        const std::vector<uint8_t> packed = Compress(input);
+        DMME_CHECK(!packed.empty());
+        std::vector<uint8_t> output(input.size(), 0xCD);
+        DMME_CHECK(LzDecompress(packed.data(), packed.size(), output.data(), output.size()));
+        DMME_CHECK(output == input);
+    }
+    // Repetitive data shrinks, noise grows by at most the bound
+    DMME_CHECK(Compress(Records(65'536)).size() < 65'536 / 2);
+    DMME_CHECK(Compress(Noise(4'096, 3)).size() <= LzCompressBound(4'096));
+}
+
+// The capacity check counts the bytes actually written: exactly the
+// compressed size succeeds with the same output, one byte less fails
+DMME_TEST(LzExactCapacity) {
+    for (const std::vector<uint8_t>& input : Inputs()) {
+        const std::vector<uint8_t> packed = Compress(input);
+        std::vector<uint8_t> exact(packed.size() + 16, 0xEE);
+        DMME_CHECK(LzCompress(input.data(), input.size(), exact.data(), packed.size()) == packed.size());
+        DMME_CHECK(std::memcmp(exact.data(), packed.data(), packed.size()) == 0);
+        DMME_CHECK(exact[packed.size()] == 0xEE);     // nothing past capacity
+
+        std::vector<uint8_t> shortBy1(packed.size());
+        DMME_CHECK(LzCompress(input.data(), input.size(), shortBy1.data(), packed.size() - 1) == 0);
+    }
+
+    // Capacity size - 1 keeps only chunks that shrink, without a
+    // bound-sized buffer
+    const std::vector<uint8_t> records = Records(4'096);
+    const std::vector<uint8_t> noise   = Noise(4'096, 5);
+    std::vector<uint8_t> out(4'095);
+    DMME_CHECK(LzCompress(records.data(), records.size(), out.data(), out.size()) > 0);
+    DMME_CHECK(LzCompress(noise.data(), noise.size(), out.data(), out.size()) == 0);
+}
+
+DMME_TEST(LzRejectsDamagedInput) {
+    const std::vector<uint8_t> input  = LongRuns(65'536);
+    const std::vector<uint8_t> packed = Compress(input);
+    std::vector<uint8_t> output(input.size());
+
+    // Truncated, wrong size, empty
+    DMME_CHECK(!LzDecompress(packed.data(), packed.size() / 2, output.data(), output.size()));
+    DMME_CHECK(!LzDecompress(packed.data(), packed.size(), output.data(), output.size() - 1));
+    DMME_CHECK(!LzDecompress(packed.data(), 0, output.data(), output.size()));
+
+    // A match reaching back before the start of the output
+    const uint8_t badOffset[] = {0x10, 'a', 0x10, 0x00, 0x00};
+    DMME_CHECK(!LzDecompress(badOffset, sizeof(badOffset), output.data(), 8));
+
+    // Every single-byte corruption either fails or stays in bounds
+    // (the output size is fixed, so a bad stream cannot overrun it)
+    std::vector<uint8_t> damaged = packed;
+    for (size_t i = 0; i < damaged.size(); i += 97) {
+        damaged[i] ^= 0x5A;
+        LzDecompress(damaged.data(), damaged.size(), output.data(), output.size());
+        damaged[i] ^= 0x5A;
+    }
+    DMME_CHECK(LzDecompress(damaged.data(), damaged.size(), output.data(), output.size()));
+    DMME_CHECK(output == input);
+}
+
+// ===================================================================
+// Packs
+// ===================================================================
+
+DMME_TEST(PackRoundTrip) {
+    const std::vector<uint8_t> model   = Records(300'000);
+    const std::vector<uint8_t> texture = Noise(100'000, 11);
+    const std::vector<uint8_t> motion  = LongRuns(150'000);
+    const std::vector<uint8_t> noise   = Noise(70'000, 13);
+    const std::vector<uint8_t> empty;
+
+    TempPack file;
+    AssetPackWriter writer;
+    writer.Add("models/mascot.pmx", model.data(), model.size());
+    writer.Add("textures/face.png", texture.data(), texture.size(), PackStoreMode::Store);
+    writer.Add("motions/idle.vmd", motion.data(), motion.size(), PackStoreMode::Compress);
+    writer.Add("misc/noise.bin", noise.data(), noise.size(), PackStoreMode::Compress);
+    writer.Add("misc/empty.txt", empty.data(), empty.size());
+    jobs::JobSystem jobs;
+    DMME_CHECK(writer.Write(file.Path(), &jobs));
+    DMME_CHECK(writer.GetPackBytes() < writer.GetRawBytes());
+
+    AssetPack pack;
+    DMME_CHECK(pack.Open(file.Path()));
+    DMME_CHECK(pack.GetEntryCount() == 5);
+    DMME_CHECK(pack.Find("models/missing.pmx") < 0);
+
+    const struct {
+        const char* name;
+        const std::vector<uint8_t>* data;
+    } expected[] = {{"models/mascot.pmx", &model}, {"textures/face.png", &texture},
+                    {"motions/idle.vmd", &motion}, {"misc/noise.bin", &noise},
+                    {"misc/empty.txt", &empty}};
+    for (const auto& e : expected) {
+        const int32_t entry = pack.Find(e.name);
+        DMME_CHECK(entry >= 0);
+        if (entry < 0) {
+            continue;
+        }
+        const PackEntryInfo info = pack.GetInfo(static_cast<uint32_t>(entry));
+        DMME_CHECK(info.size == e.data->size());
+        std::vector<uint8_t> out(info.size);
+        DMME_CHECK(pack.Read(static_cast<uint32_t>(entry), out.data(), &jobs));
+        DMME_CHECK(out == *e.data);
+        std::fill(out.begin(), out.end(), 0);
+        DMME_CHECK(pack.Read(static_cast<uint32_t>(entry), out.data(), nullptr));
+        DMME_CHECK(out == *e.data);
+    }
+
+    // Stored entries are aligned and usable in place; noise chunks that
+    // do not shrink are kept raw
+    const uint32_t face = static_cast<uint32_t>(pack.Find("textures/face.png"));
+    const uint8_t* inPlace = pack.GetStoredData(face);
+    DMME_CHECK(pack.GetInfo(face).stored);
+    DMME_CHECK(inPlace && reinterpret_cast<uintptr_t>(inPlace) % kPackDefaultAlignment == 0);
+    DMME_CHECK(inPlace && std::memcmp(inPlace, texture.data(), texture.size()) == 0);
+    const PackEntryInfo noiseInfo = pack.GetInfo(static_cast<uint32_t>(pack.Find("misc/noise.bin")));
+    DMME_CHECK(!noiseInfo.stored && noiseInfo.chunkCount == 2);
+    DMME_CHECK(noiseInfo.packedSize == noise.size());
+    const PackEntryInfo modelInfo = pack.GetInfo(static_cast<uint32_t>(pack.Find("models/mascot.pmx")));
+    DMME_CHECK(modelInfo.packedSize < model.size() / 2);
+
+    // All entries in one dispatch
+    std::vector<std::vector<uint8_t>> outputs;
+    std::vector<AssetPack::ReadRequest> requests;
+    for (const auto& e : expected) {
+        outputs.emplace_back(e.data->size());
+    }
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        requests.push_back({static_cast<uint32_t>(pack.Find(expected[i].name)), outputs[i].data()});
+    }
+    DMME_CHECK(pack.ReadMany(requests.data(), requests.size(), &jobs));
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        DMME_CHECK(outputs[i] == *expected[i].data);
+    }
+}
+
+DMME_TEST_MAIN()
\ No newline at end of file
@@ -0,0 +1,419 @@
+// Pixel conversion: every source / destination pair of the conversion
+// matrix against a double-precision reference of the documented rules
+// (decode to linear light, convert the alpha mode there, encode with
+// round-to-nearest). 8-bit sources are exhaustive over every (channel,
+// alpha) pair; half-float sources over every half value in each colour
+// channel with a spread of alphas, and every half value as alpha. Also
+// the half <-> float conversions, the kernels' tails and strides, and
+// the layered-window entry point.
+
+#include "TestHarness.h"
+
+#include "core/window/PixelConvert.h"
+#include "core/window/PixelFormat.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace dmme;
+using namespace dmme::core::window;
+
+namespace {
+
+// Alphas every half value is paired with: opaque, partial, zero, the
+// smallest subnormal and above one
+constexpr uint16_t kHalfAlphas[] = {0x3C00, 0x3800, 0x2E66, 0x0000, 0x0001, 0x4000};
+
+// Colours paired with every half value as alpha
+constexpr uint16_t kHalfAlphaSweepColour[] = {0x3800, 0x3C00, 0xB400};
+
+// Slack for rounding ties the kernels resolve in float
+constexpr double kRelativeSlack = 1e-5;
+
+PixelFormat FormatAt(size_t i) {
+    return static_cast<PixelFormat>(i);
+}
+
+// ===================================================================
+// Reference
+// ===================================================================
+
+double RefSrgbToLinear(double c) {
+    return c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+}
+
+// binary16 by its definition, independent of HalfToFloat
+double RefHalf(uint16_t h) {
+    const double sign     = (h & 0x8000u) ? -1.0 : 1.0;
+    const int    exponent = (h >> 10) & 0x1F;
+    const int    mantissa = h & 0x3FF;
+    if (exponent == 0x1F) {
+        return mantissa ? std::numeric_limits<double>::quiet_NaN()
+                        : sign * std::numeric_limits<double>::infinity();
+    }
+    if (exponent == 0) {
+        return sign * std::ldexp(mantissa, -24);
+    }
+    return sign * std::ldexp(1024 + mantissa, exponent - 25);
+}
+
+bool IsHalfNan(uint16_t h) {
+    return (h & 0x7C00u) == 0x7C00u && (h & 0x3FFu) != 0;
+}
+
+// Code k of an 8-bit channel covers linear values [bound[k], bound[k + 1])
+struct UnormBounds {
+    double linear[257];
+    double srgb[257];
+};
+
+const UnormBounds& GetBounds() {
+    static const UnormBounds bounds = [] {
+        UnormBounds b{};
+        for (int k = 1; k < 256; ++k) {
+            b.linear[k] = (k - 0.5) / 255.0;
+            b.srgb[k]   = RefSrgbToLinear((k - 0.5) / 255.0);
+        }
+        b.linear[0] = b.srgb[0] = -std::numeric_limits<double>::infinity();
+        b.linear[256] = b.srgb[256] = std::numeric_limits<double>::infinity();
+        return b;
+    }();
+    return bounds;
+}
+
+// Linear RGBA in the format's own alpha mode
+void RefDecode(PixelFormat f, const uint8_t* p, double c[4]) {
+    if (IsHalfFloat(f)) {
+        for (int i = 0; i < 4; ++i) {
+            uint16_t h;
+            std::memcpy(&h, p + i * 2, sizeof(h));
+            c[i] = RefHalf(h);
+        }
+    } else {
+        for (int i = 0; i < 3; ++i) {
+            c[i] = IsSrgb(f) ? RefSrgbToLinear(p[i] / 255.0) : p[i] / 255.0;
+        }
+        c[3] = p[3] / 255.0;
+    }
+    if (IsBgra(f)) {
+        std::swap(c[0], c[2]);
+    }
+}
+
+void RefConvertAlpha(PixelFormat s, PixelFormat d, double c[4]) {
+    if (!IsPremultiplied(s) && IsPremultiplied(d)) {
+        for (int i = 0; i < 3; ++i) c[i] *= c[3];
+    } else if (IsPremultiplied(s) && !IsPremultiplied(d)) {
+        for (int i = 0; i < 3; ++i) c[i] = c[3] != 0.0 ? c[i] / c[3] : 0.0;
+    }
+}
+
+bool SlackBelow(double x, double bound) {
+    return x >= bound - kRelativeSlack * std::fabs(bound) - 1e-9;
+}
+
+bool SlackAbove(double x, double bound) {
+    return x <= bound + kRelativeSlack * std::fabs(bound) + 1e-9;
+}
+
+// Whether stored channel value `got` is a correct encoding of x
+bool AcceptUnorm(uint8_t got, double x, bool srgb) {
+    if (std::isnan(x)) {
+        return got == 0;
+    }
+    const double* bound = srgb ? GetBounds().srgb : GetBounds().linear;
+    return SlackBelow(x, bound[got]) && SlackAbove(x, bound[got + 1]);
+}
+
+bool AcceptHalf(uint16_t got, double x) {
+    if (std::isnan(x)) {
+        return IsHalfNan(got);
+    }
+    const uint16_t expected = FloatToHalf(static_cast<float>(x));
+    if (got == expected) {
+        return true;
+    }
+    const double g = RefHalf(got), e = RefHalf(expected);
+    if (std::isinf(g) || std::isinf(e) || std::isnan(g)) {
+        return false;
+    }
+    // A tie, or a signed zero
+    return std::fabs(g - x) <= std::fabs(e - x) * (1.0 + kRelativeSlack) + 1e-12;
+}
+
+// Channel i (storage order) of a converted pixel against linear RGBA x
+bool AcceptPixel(PixelFormat d, const uint8_t* p, const double x[4], int& badChannel) {
+    for (int i = 0; i < 4; ++i) {
+        const int logical = (IsBgra(d) && i != 1 && i != 3) ? 2 - i : i;
+        bool ok;
+        if (IsHalfFloat(d)) {
+            uint16_t h;
+            std::memcpy(&h, p + i * 2, sizeof(h));
+            ok = AcceptHalf(h, x[logical]);
+        } else {
+            ok = AcceptUnorm(p[i], x[logical], IsSrgb(d) && i != 3);
+        }
+        if (!ok) {
+            badChannel = i;
+            return false;
+        }
+    }
+    return true;
+}
+
+// ===================================================================
+// Sources
+// ===================================================================
+
+// Pixel (c << 8 | a) holds c, 255 - c and c ^ 0xA5 in its colour
+// bytes and a in the alpha byte: every channel sees every value with
+// every alpha, and a red/blue mix-up shows
+std::vector<uint8_t> EightBitSource() {
+    std::vector<uint8_t> bytes(65536 * 4);
+    for (uint32_t c = 0; c < 256; ++c) {
+        for (uint32_t a = 0; a < 256; ++a) {
+            uint8_t* p = &bytes[((c << 8) | a) * 4];
+            p[0] = static_cast<uint8_t>(c);
+            p[1] = static_cast<uint8_t>(255 - c);
+            p[2] = static_cast<uint8_t>(c ^ 0xA5);
+            p[3] = static_cast<uint8_t>(a);
+        }
+    }
+    return bytes;
+}
+
+// Every half value in each colour channel (shifted per channel) with
+// each of kHalfAlphas, then every half value as alpha
+std::vector<uint8_t> HalfSource() {
+    std::vector<uint16_t> halves;
+    for (uint16_t alpha : kHalfAlphas) {
+        for (uint32_t v = 0; v < 65536; ++v) {
+            halves.push_back(static_cast<uint16_t>(v));
+            halves.push_back(static_cast<uint16_t>(v ^ 0x8000u));
+            halves.push_back(static_cast<uint16_t>(v + 0x1234u));
+            halves.push_back(alpha);
+        }
+    }
+    for (uint32_t v = 0; v < 65536; ++v) {
+        halves.insert(halves.end(), std::begin(kHalfAlphaSweepColour), std::end(kHalfAlphaSweepColour));
+        halves.push_back(static_cast<uint16_t>(v));
+    }
+    std::vector<uint8_t> bytes(halves.size() * 2);
+    std::memcpy(bytes.data(), halves.data(), bytes.size());
+    return bytes;
+}
+
+// Converts the whole source with every destination format and checks
+// each pixel; returns the number of pairs with a mismatch
+int CheckSource(PixelFormat s, const std::vector<uint8_t>& source) {
+    const size_t count = source.size() / GetPixelSize(s);
+    std::vector<double> linear(count * 4);
+    for (size_t i = 0; i < count; ++i) {
+        RefDecode(s, &source[i * GetPixelSize(s)], &linear[i * 4]);
+    }
+
+    int badPairs = 0;
+    std::vector<uint8_t> out;
+    for (size_t di = 0; di < kPixelFormatCount; ++di) {
+        const PixelFormat d = FormatAt(di);
+        const PixelConvertFn convert = GetPixelConverter(s, d);
+        if (!DMME_CHECK(convert != nullptr)) {
+            ++badPairs;
+            continue;
+        }
+        out.assign(count * GetPixelSize(d), 0);
+        convert(source.data(), out.data(), count);
+
+        size_t mismatches = 0;
+        for (size_t i = 0; i < count; ++i) {
+            double x[4];
+            std::memcpy(x, &linear[i * 4], sizeof(x));
+            RefConvertAlpha(s, d, x);
+            int channel = 0;
+            if (AcceptPixel(d, &out[i * GetPixelSize(d)], x, channel)) {
+                continue;
+            }
+            if (mismatches++ == 0) {
+                const int logical = (IsBgra(d) && channel != 1 && channel != 3) ? 2 - channel : channel;
+                std::fprintf(stderr, "%s -> %s: pixel %zu channel %d, reference %.9g\n",
+                             GetPixelFormatName(s), GetPixelFormatName(d), i, channel, x[logical]);
+            }
+        }
+        if (mismatches > 0) {
+            std::fprintf(stderr, "%s -> %s: %zu of %zu pixels wrong\n",
+                         GetPixelFormatName(s), GetPixelFormatName(d), mismatches, count);
+            ++badPairs;
+        }
+    }
+    return badPairs;
+}
+
+} // anonymous namespace
+
+// ===================================================================
+// Half floats
+// ===================================================================
+
+DMME_TEST(HalfToFloatEveryValue) {
+    int wrong = 0;
+    for (uint32_t v = 0; v < 65536; ++v) {
+        const uint16_t h = static_cast<uint16_t>(v);
+        const float f = HalfToFloat(h);
+        const double expected = RefHalf(h);
+        if (std::isnan(expected)) {
+            wrong += !std::isnan(f);
+            continue;
+        }
+        wrong += static_cast<double>(f) != expected || std::signbit(f) != std::signbit(expected);
+        wrong += FloatToHalf(f) != h;       // every half round-trips through float
+    }
+    DMME_CHECK(wrong == 0);
+}
+
+// Halfway between neighbouring halves rounds to the even one; a float
+// step either side picks the nearer
+DMME_TEST(FloatToHalfRoundsToNearestEven) {
+    int wrong = 0;
+    for (uint32_t v = 0; v < 0x7BFF; ++v) {
+        const uint16_t lo = static_cast<uint16_t>(v), hi = static_cast<uint16_t>(v + 1);
+        for (uint16_t sign : {uint16_t(0), uint16_t(0x8000)}) {
+            const float a = HalfToFloat(static_cast<uint16_t>(lo | sign));
+            const float b = HalfToFloat(static_cast<uint16_t>(hi | sign));
+            const float mid = 0.5f * (a + b);          // exact: halves have 11 bits
+            const uint16_t even = static_cast<uint16_t>(((lo & 1u) ? hi : lo) | sign);
+            wrong += FloatToHalf(mid) != even;
+            wrong += FloatToHalf(std::nextafter(mid, a)) != (lo | sign);
+            wrong += FloatToHalf(std::nextafter(mid, b)) != (hi | sign);
+        }
+    }
+    DMME_CHECK(wrong == 0);
+
+    // 65520 is halfway to the next exponent and rounds to infinity
+    DMME_CHECK(FloatToHalf(65519.99f) == 0x7BFF);
+    DMME_CHECK(FloatToHalf(65520.0f) == 0x7C00);
+    DMME_CHECK(FloatToHalf(-1e30f) == 0xFC00);
+    DMME_CHECK(FloatToHalf(std::numeric_limits<float>::infinity()) == 0x7C00);
+    DMME_CHECK(IsHalfNan(FloatToHalf(std::numeric_limits<float>::quiet_NaN())));
+    // Below half the smallest subnormal flushes to a signed zero
+    DMME_CHECK(FloatToHalf(std::ldexp(1.0f, -26)) == 0x0000);
+    DMME_CHECK(FloatToHalf(-std::ldexp(1.0f, -26)) == 0x8000);
+    DMME_CHECK(FloatToHalf(std::ldexp(1.5f, -25)) == 0x0001);
+}
+
+// ===================================================================
+// Conversion matrix
+// ===================================================================
+
+DMME_TEST(EightBitSourcesEveryPair) {
+    const std::vector<uint8_t> source = EightBitSource();
+    int badPairs = 0;
+    for (size_t si = 0; si < kPixelFormatCount; ++si) {
+        if (!IsHalfFloat(FormatAt(si))) {
+            badPairs += CheckSource(FormatAt(si), source);
+        }
+    }
+    DMME_CHECK(badPairs == 0);
+}
+
+DMME_TEST(HalfSourcesEveryPair) {
+    const std::vector<uint8_t> source = HalfSource();
+    int badPairs = 0;
+    for (size_t si = 0; si < kPixelFormatCount; ++si) {
+        if (IsHalfFloat(FormatAt(si))) {
+            badPairs += CheckSource(FormatAt(si), source);
+        }
+    }
+    DMME_CHECK(badPairs == 0);
+}
+
+// Short runs take the scalar tails of the SIMD kernels: the same bytes
+// as a long run, and nothing written past count
+DMME_TEST(TailsMatchAndStayInBounds) {
+    const std::vector<uint8_t> eightBit = EightBitSource();
+    const std::vector<uint8_t> half     = HalfSource();
+    constexpr size_t kLong = 64;
+    constexpr uint8_t kGuard = 0xCD;
+
+    int wrong = 0;
+    for (size_t si = 0; si < kPixelFormatCount; ++si) {
+        const PixelFormat s = FormatAt(si);
+        // Pixels from the middle of the sweep, where alpha varies
+        const uint8_t* src = (IsHalfFloat(s) ? half.data() : eightBit.data()) +
+                             1000 * GetPixelSize(s);
+        for (size_t di = 0; di < kPixelFormatCount; ++di) {
+            const PixelFormat d = FormatAt(di);
+            const size_t dstSize = GetPixelSize(d);
+            std::vector<uint8_t> full(kLong * dstSize);
+            GetPixelConverter(s, d)(src, full.data(), kLong);
+            for (size_t count = 0; count <= 9; ++count) {
+                std::vector<uint8_t> part((count + 2) * dstSize, kGuard);
+                GetPixelConverter(s, d)(src, part.data(), count);
+                wrong += std::memcmp(part.data(), full.data(), count * dstSize) != 0;
+                for (size_t i = count * dstSize; i < part.size(); ++i) {
+                    wrong += part[i] != kGuard;
+                }
+            }
+        }
+    }
+    DMME_CHECK(wrong == 0);
+}
+
+DMME_TEST(StridedRowsLeavePaddingAlone) {
+    constexpr int kWidth = 7, kHeight = 5;
+    constexpr size_t kSrcStride = kWidth * 4 + 12, kDstStride = kWidth * 8 + 24;
+    const std::vector<uint8_t> source = EightBitSource();
+    std::vector<uint8_t> dst(kDstStride * kHeight, 0xCD);
+
+    ConvertPixels(PixelFormat::RGBA8_SRGB, source.data(), kSrcStride,
+                  PixelFormat::BGRA16_FLOAT_PREMUL, dst.data(), kDstStride, kWidth, kHeight);
+
+    const PixelConvertFn convert = GetPixelConverter(PixelFormat::RGBA8_SRGB, PixelFormat::BGRA16_FLOAT_PREMUL);
+    int wrong = 0;
+    for (int y = 0; y < kHeight; ++y) {
+        uint8_t row[kWidth * 8];
+        convert(source.data() + y * kSrcStride, row, kWidth);
+        const uint8_t* out = dst.data() + y * kDstStride;
+        wrong += std::memcmp(out, row, sizeof(row)) != 0;
+        for (size_t i = sizeof(row); i < kDstStride; ++i) {
+            wrong += out[i] != 0xCD;
+        }
+    }
+    DMME_CHECK(wrong == 0);
+
+    // Out-of-range formats have no converter and convert nothing
+    DMME_CHECK(GetPixelConverter(PixelFormat::Count, PixelFormat::RGBA8_UNORM) == nullptr);
+    DMME_CHECK(std::strcmp(GetPixelFormatName(PixelFormat::Count), "Unknown") == 0);
+}
+
+// The layered-window conversion is the RGBA8 -> BGRA8 premultiplied
+// pair: opaque pixels only swizzled, transparent ones all zero
+DMME_TEST(LayeredWindowPathIsThePremultiplyPair) {
+    const std::vector<uint8_t> source = EightBitSource();
+    constexpr int kWidth = 256, kHeight = 256;
+    std::vector<uint8_t> viaWindow(source.size()), viaMatrix(source.size());
+
+    ConvertRGBAToBGRAPremul(source.data(), kWidth, kHeight, kWidth * 4, viaWindow.data());
+    GetPixelConverter(PixelFormat::RGBA8_UNORM, PixelFormat::BGRA8_UNORM_PREMUL)(
+        source.data(), viaMatrix.data(), source.size() / 4);
+    DMME_CHECK(viaWindow == viaMatrix);
+
+    int wrong = 0;
+    for (size_t i = 0; i < source.size(); i += 4) {
+        const uint8_t* in  = &source[i];
+        const uint8_t* out = &viaWindow[i];
+        if (in[3] == 255) {
+            wrong += out[0] != in[2] || out[1] != in[1] || out[2] != in[0] || out[3] != 255;
+        } else if (in[3] == 0) {
+            wrong += out[0] != 0 || out[1] != 0 || out[2] != 0 || out[3] != 0;
+        } else {
+            // (c * a + 127) / 255
+            wrong += out[0] != (in[2] * in[3] + 127) / 255;
+        }
+    }
+    DMME_CHECK(wrong == 0);
+}
+
+DMME_TEST_MAIN()
\ No newline at end of file
@@ -0,0 +1,239 @@
+// PowerGovernor tier selection, hysteresis and dwell, driven by a
+// ScriptedPowerSignalSource on a synthetic clock, and the detail level
+// reaching the spring solver.
+
+#include "TestHarness.h"
+
+#include "core/animation/SpringBones.h"
+#include "core/runtime/PowerGovernor.h"
+
+#include <memory>
+
+using namespace dmme;
+using namespace dmme::core::runtime;
+using dmme::core::animation::AnimationDetail;
+
+namespace {
+
+// The governor treats a zero timestamp as "unset"; start the clock later
+constexpr uint64_t kStartUs = 1'000'000;
+
+uint64_t AtSeconds(uint64_t seconds) {
+    return kStartUs + seconds * 1'000'000;
+}
+
+PowerSignals OnAc() {
+    return PowerSignals();
+}
+
+PowerSignals OnBattery(int percent = 80) {
+    PowerSignals s;
+    s.onBattery      = true;
+    s.batteryPercent = percent;
+    return s;
+}
+
+// One signal step per (second, signals) pair
+std::unique_ptr<IPowerSignalSource> Script(
+    std::initializer_list<std::pair<uint64_t, PowerSignals>> steps) {
+    auto source = std::make_unique<ScriptedPowerSignalSource>();
+    for (const auto& step : steps) {
+        source->AddStep(step.first * 1'000'000, step.second);
+    }
+    return source;
+}
+
+// Poll once a second over [from, to]; returns the first second at which
+// the policy changed, or UINT64_MAX
+uint64_t FirstChange(PowerGovernor& governor, uint64_t from, uint64_t to) {
+    for (uint64_t s = from; s <= to; ++s) {
+        if (governor.Update(AtSeconds(s))) {
+            return s;
+        }
+    }
+    return UINT64_MAX;
+}
+
+} // anonymous namespace
+
+// ===================================================================
+// Tier selection
+// ===================================================================
+
+DMME_TEST(FirstPollAdoptsTier) {
+    PowerGovernor governor(Script({{0, OnBattery()}}));
+    DMME_CHECK(governor.GetTier() == PowerTier::Performance);
+
+    DMME_CHECK(governor.Update(AtSeconds(0)));
+    DMME_CHECK(governor.GetTier() == PowerTier::Balanced);
+    DMME_CHECK(governor.GetPolicy().targetFps == 30.0f);
+    DMME_CHECK(governor.GetPolicy().animationDetail == AnimationDetail::Reduced);
+}
+
+DMME_TEST(PollsAtMostOncePerInterval) {
+    PowerGovernor governor(Script({{0, OnAc()}, {0, OnBattery()}}));
+    DMME_CHECK(governor.Update(AtSeconds(0)));
+    DMME_CHECK(governor.GetLastSignals().onBattery);
+
+    // Not sampled again inside the interval
+    DMME_CHECK(!governor.Update(AtSeconds(0) + 500'000));
+    DMME_CHECK(governor.GetLastSignals().userIdleMs == 0);
+    governor.Update(AtSeconds(1));
+    DMME_CHECK(governor.GetLastSignals().userIdleMs == 1000);
+}
+
+DMME_TEST(SaverWinsOverBalanced) {
+    PowerSignals saver = OnBattery();
+    saver.batterySaver = true;
+    PowerSignals thermal;
+    thermal.thermalThrottled = true;
+
+    PowerGovernor governor(Script({{0, saver}}));
+    governor.Update(AtSeconds(0));
+    DMME_CHECK(governor.GetTier() == PowerTier::Saver);
+    DMME_CHECK(governor.GetPolicy().resolutionScale == 0.75f);
+
+    PowerGovernor hot(Script({{0, thermal}}));
+    hot.Update(AtSeconds(0));
+    DMME_CHECK(hot.GetTier() == PowerTier::Saver);
+}
+
+// ===================================================================
+// Dwell: downgrades wait, upgrades don't
+// ===================================================================
+
+DMME_TEST(DowngradeWaitsForDwell) {
+    PowerGovernor governor(Script({{0, OnAc()}, {2, OnBattery()}}));
+    governor.Update(AtSeconds(0));
+    DMME_CHECK(governor.GetTier() == PowerTier::Performance);
+
+    // Unplugged at 2 s, applied once it has held for the 5 s dwell
+    DMME_CHECK(FirstChange(governor, 1, 20) == 7);
+    DMME_CHECK(governor.GetTier() == PowerTier::Balanced);
+}
+
+DMME_TEST(UpgradeIsImmediate) {
+    PowerGovernor governor(Script({{0, OnBattery()}, {1, OnAc()}}));
+    governor.Update(AtSeconds(0));
+    DMME_CHECK(governor.GetTier() == PowerTier::Balanced);
+
+    DMME_CHECK(FirstChange(governor, 1, 20) == 1);
+    DMME_CHECK(governor.GetTier() == PowerTier::Performance);
+}
+
+// A flapping signal restarts the dwell every time it flips back
+DMME_TEST(FlappingRestartsDwell) {
+    PowerGovernor governor(Script({
+        {0, OnAc()}, {2, OnBattery()}, {4, OnAc()}, {5, OnBattery()}}));
+    governor.Update(AtSeconds(0));
+
+    DMME_CHECK(FirstChange(governor, 1, 20) == 10);
+    DMME_CHECK(governor.GetTier() == PowerTier::Balanced);
+}
+
+// ===================================================================
+// Threshold hysteresis
+// ===================================================================
+
+DMME_TEST(IdleHysteresis) {
+    PowerSignals away;
+    away.userIdleMs = 30'000;      // between the exit and enter thresholds
+    PowerSignals back;             // fresh input
+
+    PowerGovernor governor(Script({{0, OnAc()}, {100, away}, {130, back}}));
+    governor.Update(AtSeconds(0));
+
+    // Idle time reaches 60 s at 60 s, plus the dwell
+    DMME_CHECK(FirstChange(governor, 1, 99) == 65);
+    DMME_CHECK(governor.GetTier() == PowerTier::Idle);
+    DMME_CHECK(governor.GetPolicy().animationDetail == AnimationDetail::Minimal);
+
+    // 30 s idle would not enter Idle, but does not leave it either
+    DMME_CHECK(FirstChange(governor, 100, 129) == UINT64_MAX);
+    DMME_CHECK(governor.GetTier() == PowerTier::Idle);
+
+    // Input: back to Performance on the next poll
+    DMME_CHECK(FirstChange(governor, 130, 140) == 130);
+    DMME_CHECK(governor.GetTier() == PowerTier::Performance);
+}
+
+DMME_TEST(LowBatteryHysteresis) {
+    PowerGovernor governor(Script({
+        {0, OnBattery(21)}, {10, OnBattery(20)}, {30, OnBattery(24)},
+        {40, OnBattery(25)}, {50, OnAc()}, {60, OnBattery(21)}}));
+    governor.Update(AtSeconds(0));
+    DMME_CHECK(governor.GetTier() == PowerTier::Balanced);
+
+    // Enters at <= 20 %
+    DMME_CHECK(FirstChange(governor, 1, 29) == 15);
+    DMME_CHECK(governor.GetTier() == PowerTier::Saver);
+
+    // Stays below 25 %, leaves at 25 %
+    DMME_CHECK(FirstChange(governor, 30, 39) == UINT64_MAX);
+    DMME_CHECK(FirstChange(governor, 40, 49) == 40);
+    DMME_CHECK(governor.GetTier() == PowerTier::Balanced);
+
+    // Plugging in clears the latch; 21 % on battery is Balanced again
+    DMME_CHECK(FirstChange(governor, 50, 59) == 50);
+    DMME_CHECK(FirstChange(governor, 60, 80) == 65);
+    DMME_CHECK(governor.GetTier() == PowerTier::Balanced);
+}
+
+// ===================================================================
+// Overrides
+// ===================================================================
+
+DMME_TEST(OverrideBypassesSignalsAndDwell) {
+    PowerGovernor governor(Script({{0, OnAc()}}));
+    governor.Update(AtSeconds(0));
+
+    governor.SetOverride(PowerTier::Saver);
+    DMME_CHECK(governor.Update(AtSeconds(0) + 1));
+    DMME_CHECK(governor.GetTier() == PowerTier::Saver);
+    DMME_CHECK(FirstChange(governor, 1, 20) == UINT64_MAX);
+
+    // Signal-driven tier comes back on the next Update, no dwell
+    governor.ClearOverride();
+    DMME_CHECK(governor.Update(AtSeconds(20) + 1));
+    DMME_CHECK(governor.GetTier() == PowerTier::Performance);
+}
+
+// ===================================================================
+// Detail level in the spring solver
+// ===================================================================
+
+DMME_TEST(DetailDrivesSpringIterations) {
+    using core::animation::SpringBoneSolver;
+
+    const float rest[9] = {0.0f, 0.0f, 0.0f, 0.0f, -0.1f, 0.0f, 0.0f, -0.2f, 0.0f};
+    core::animation::SpringChainDesc desc;
+    desc.jointCount    = 3;
+    desc.restPositions = rest;
+
+    SpringBoneSolver springs;
+    DMME_CHECK(springs.AddChain(desc) == 0);
+
+    springs.Update(1.0f / 60.0f);
+    DMME_CHECK(springs.GetStats().iterations == 4);
+
+    springs.SetDetail(AnimationDetail::Reduced);
+    springs.Update(1.0f / 60.0f);
+    DMME_CHECK(springs.GetStats().iterations == 2);
+    DMME_CHECK(springs.GetStats().substeps == 1);
+
+    // Minimal: no simulation, the joints sit on the animated pose
+    const float moved[9] = {1.0f, 0.0f, 0.0f, 1.0f, -0.1f, 0.0f, 1.0f, -0.2f, 0.0f};
+    springs.SetDetail(AnimationDetail::Minimal);
+    springs.SetTargets(0, moved);
+    springs.Update(1.0f / 60.0f);
+    DMME_CHECK(springs.GetStats().substeps == 0);
+    float tip[3];
+    springs.GetJoint(0, 2, tip);
+    DMME_CHECK(tip[0] == 1.0f && tip[1] == -0.2f);
+
+    springs.SetDetail(AnimationDetail::Full);
+    springs.Update(1.0f / 60.0f);
+    DMME_CHECK(springs.GetStats().iterations == 4);
+}
+
+DMME_TEST_MAIN()
\ No newline at end of file
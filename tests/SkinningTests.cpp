@@ -0,0 +1,326 @@
+// Skinner against a scalar double-precision reference: a mesh mixing
+// BDEF1 / BDEF2 / BDEF4 and SDEF vertices in shared blocks, skinned on
+// a posed skeleton inline and on a job system, and every weight type
+// moving rigidly when the skeleton is only translated.
+
+#include "TestHarness.h"
+
+#include "core/animation/Skinning.h"
+#include "core/jobs/JobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace dmme;
+using namespace dmme::core;
+using namespace dmme::core::animation;
+
+namespace {
+
+using PmxWeight = assets::PmxWeightType;
+
+constexpr uint32_t kVertices = 5000;        // more than one job chunk
+constexpr uint32_t kBones    = 24;
+
+// Attribute arrays behind a PmxVertexTable. Weight types cycle every
+// few vertices, so blocks mix linear and SDEF vertices.
+class MixedMesh {
+public:
+    MixedMesh()
+        : m_positions(kVertices * 3), m_normals(kVertices * 3), m_uvs(kVertices * 2),
+          m_bones(kVertices * 4, 0), m_weights(kVertices * 4, 0.0f), m_types(kVertices),
+          m_edges(kVertices, 1.0f), m_sdefC(kVertices * 3, 0.0f), m_sdefR0(kVertices * 3, 0.0f),
+          m_sdefR1(kVertices * 3, 0.0f) {
+        for (uint32_t v = 0; v < kVertices; ++v) {
+            const float f = static_cast<float>(v);
+            m_positions[v * 3 + 0] = std::sin(f * 0.013f);
+            m_positions[v * 3 + 1] = 0.0004f * f;
+            m_positions[v * 3 + 2] = std::cos(f * 0.017f);
+            m_normals[v * 3 + 0]   = std::cos(f * 0.013f);
+            m_normals[v * 3 + 1]   = 0.5f;
+            m_normals[v * 3 + 2]   = -std::sin(f * 0.017f);
+
+            const int32_t bone = static_cast<int32_t>((v / 37) % kBones);
+            const PmxWeight type = static_cast<PmxWeight>((v / 5) % 4);
+            m_types[v] = static_cast<uint8_t>(type);
+            int32_t* b = &m_bones[v * 4];
+            float*   w = &m_weights[v * 4];
+            switch (type) {
+                case PmxWeight::BDEF1:
+                    b[0] = bone;
+                    w[0] = 1.0f;
+                    break;
+                case PmxWeight::BDEF4:
+                    for (int k = 0; k < 4; ++k) b[k] = (bone + 3 * k) % kBones;
+                    w[0] = 0.1f; w[1] = 0.4f; w[2] = 0.2f; w[3] = 0.3f;
+                    break;
+                default: {
+                    b[0] = bone;
+                    b[1] = (bone + 1) % kBones;
+                    w[0] = 0.15f + 0.7f * static_cast<float>(v % 11) / 10.0f;
+                    w[1] = 1.0f - w[0];
+                    if (type == PmxWeight::SDEF) {
+                        // C between the two bones, R0 / R1 on either side
+                        float* c  = &m_sdefC[v * 3];
+                        float* r0 = &m_sdefR0[v * 3];
+                        float* r1 = &m_sdefR1[v * 3];
+                        c[0] = 0.1f;
+                        c[1] = m_positions[v * 3 + 1];
+                        c[2] = -0.05f;
+                        for (int i = 0; i < 3; ++i) {
+                            r0[i] = c[i] - 0.2f + 0.05f * static_cast<float>(i);
+                            r1[i] = c[i] + 0.3f - 0.1f * static_cast<float>(i);
+                        }
+                    }
+                    break;
+                }
+            }
+        }
+
+        m_table.count       = kVertices;
+        m_table.positions   = m_positions.data();
+        m_table.normals     = m_normals.data();
+        m_table.uvs         = m_uvs.data();
+        m_table.boneIndices = m_bones.data();
+        m_table.boneWeights = m_weights.data();
+        m_table.weightTypes = m_types.data();
+        m_table.edgeScales  = m_edges.data();
+        m_table.sdefC       = m_sdefC.data();
+        m_table.sdefR0      = m_sdefR0.data();
+        m_table.sdefR1      = m_sdefR1.data();
+    }
+
+    const assets::PmxVertexTable& Table() const { return m_table; }
+
+private:
+    std::vector<float>   m_positions, m_normals, m_uvs;
+    std::vector<int32_t> m_bones;
+    std::vector<float>   m_weights;
+    std::vector<uint8_t> m_types;
+    std::vector<float>   m_edges;
+    std::vector<float>   m_sdefC, m_sdefR0, m_sdefR1;
+    assets::PmxVertexTable m_table;
+};
+
+// One bone's pose, kept so the reference can rebuild it in double
+struct Pose {
+    float rotation[4];
+    float position[3];
+    float rest[3];
+};
+
+// Every bone turned about its own axis by up to ~0.9 rad and moved
+std::vector<Pose> PosedSkeleton() {
+    std::vector<Pose> poses(kBones);
+    for (uint32_t b = 0; b < kBones; ++b) {
+        Pose& pose = poses[b];
+        const double axis[3] = {std::sin(b * 1.3), std::cos(b * 0.7), 0.5 + 0.1 * b};
+        const double length = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+        const double half = 0.02 * b;
+        for (int i = 0; i < 3; ++i) {
+            pose.rotation[i] = static_cast<float>(axis[i] / length * std::sin(half));
+        }
+        pose.rotation[3] = static_cast<float>(std::cos(half));
+        pose.rest[0] = 0.0f;
+        pose.rest[1] = 0.1f * static_cast<float>(b);
+        pose.rest[2] = 0.0f;
+        pose.position[0] = 0.03f * static_cast<float>(b % 5);
+        pose.position[1] = pose.rest[1] + 0.02f;
+        pose.position[2] = -0.01f * static_cast<float>(b % 3);
+    }
+    return poses;
+}
+
+void Apply(const std::vector<Pose>& poses, SkinningPalette& palette) {
+    palette.Resize(static_cast<uint32_t>(poses.size()));
+    for (uint32_t b = 0; b < poses.size(); ++b) {
+        palette.SetBone(b, poses[b].rotation, poses[b].position, poses[b].rest);
+    }
+}
+
+// ===================================================================
+// Double-precision reference
+// ===================================================================
+
+struct Matrix {
+    double r[3][3];     // r[row][column]
+    double t[3];
+};
+
+void Rotation(const double q[4], double r[3][3]) {
+    const double x = q[0], y = q[1], z = q[2], w = q[3];
+    r[0][0] = 1 - 2 * (y * y + z * z); r[0][1] = 2 * (x * y - z * w);     r[0][2] = 2 * (x * z + y * w);
+    r[1][0] = 2 * (x * y + z * w);     r[1][1] = 1 - 2 * (x * x + z * z); r[1][2] = 2 * (y * z - x * w);
+    r[2][0] = 2 * (x * z - y * w);     r[2][1] = 2 * (y * z + x * w);     r[2][2] = 1 - 2 * (x * x + y * y);
+}
+
+// x' = R (x - rest) + position
+Matrix BoneMatrix(const Pose& pose) {
+    Matrix m;
+    const double q[4] = {pose.rotation[0], pose.rotation[1], pose.rotation[2], pose.rotation[3]};
+    Rotation(q, m.r);
+    for (int i = 0; i < 3; ++i) {
+        m.t[i] = pose.position[i];
+        for (int j = 0; j < 3; ++j) {
+            m.t[i] -= m.r[i][j] * pose.rest[j];
+        }
+    }
+    return m;
+}
+
+void Transform(const double r[3][3], const double* t, const double p[3], double out[3]) {
+    for (int i = 0; i < 3; ++i) {
+        out[i] = r[i][0] * p[0] + r[i][1] * p[1] + r[i][2] * p[2] + (t ? t[i] : 0.0);
+    }
+}
+
+void Normalise(double v[3]) {
+    const double length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    for (int i = 0; i < 3; ++i) v[i] /= length;
+}
+
+// Weighted matrix blend, weights normalised
+void ReferenceLinear(const std::vector<Matrix>& bones, const int32_t* b, const float* w,
+                     const double p[3], const double n[3], double position[3], double normal[3]) {
+    double total = 0.0;
+    for (int k = 0; k < 4; ++k) total += w[k];
+    Matrix blend = {};
+    for (int k = 0; k < 4; ++k) {
+        const double wk = w[k] / total;
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) blend.r[i][j] += bones[b[k]].r[i][j] * wk;
+            blend.t[i] += bones[b[k]].t[i] * wk;
+        }
+    }
+    Transform(blend.r, blend.t, p, position);
+    Transform(blend.r, nullptr, n, normal);
+    Normalise(normal);
+}
+
+// Spherical deform: rotate about C by the nlerp of the two bone
+// rotations, translate by the blended motion of the corrected centres
+void ReferenceSdef(const std::vector<Pose>& poses, const std::vector<Matrix>& bones,
+                   const int32_t* b, const float* w, const float* c, const float* r0,
+                   const float* r1, const double p[3], const double n[3], double position[3],
+                   double normal[3]) {
+    const double w0 = w[0], w1 = 1.0 - w0;
+    const float* q0 = poses[b[0]].rotation;
+    const float* q1 = poses[b[1]].rotation;
+    double dot = 0.0;
+    for (int i = 0; i < 4; ++i) dot += static_cast<double>(q0[i]) * q1[i];
+    double q[4], length = 0.0;
+    for (int i = 0; i < 4; ++i) {
+        q[i] = q0[i] * w0 + q1[i] * (dot < 0.0 ? -w1 : w1);
+        length += q[i] * q[i];
+    }
+    for (double& f : q) f /= std::sqrt(length);
+    double r[3][3];
+    Rotation(q, r);
+
+    double cr0[3], cr1[3];
+    for (int i = 0; i < 3; ++i) {
+        const double rw = r0[i] * w0 + r1[i] * w1;
+        cr0[i] = (c[i] + (static_cast<double>(c[i]) + r0[i] - rw)) * 0.5;
+        cr1[i] = (c[i] + (static_cast<double>(c[i]) + r1[i] - rw)) * 0.5;
+    }
+    double m0[3], m1[3];
+    Transform(bones[b[0]].r, bones[b[0]].t, cr0, m0);
+    Transform(bones[b[1]].r, bones[b[1]].t, cr1, m1);
+
+    const double d[3] = {p[0] - c[0], p[1] - c[1], p[2] - c[2]};
+    Transform(r, nullptr, d, position);
+    for (int i = 0; i < 3; ++i) position[i] += m0[i] * w0 + m1[i] * w1;
+    Transform(r, nullptr, n, normal);
+    Normalise(normal);
+}
+
+// Largest position / normal error of out against the reference
+double ReferenceError(const assets::PmxVertexTable& t, const std::vector<Pose>& poses,
+                      const std::vector<SkinnedVertex>& out) {
+    std::vector<Matrix> bones;
+    for (const Pose& pose : poses) bones.push_back(BoneMatrix(pose));
+
+    double worst = 0.0;
+    for (uint32_t v = 0; v < t.count; ++v) {
+        const double p[3] = {t.positions[v * 3], t.positions[v * 3 + 1], t.positions[v * 3 + 2]};
+        const double n[3] = {t.normals[v * 3], t.normals[v * 3 + 1], t.normals[v * 3 + 2]};
+        double position[3], normal[3];
+        if (t.weightTypes[v] == static_cast<uint8_t>(PmxWeight::SDEF)) {
+            ReferenceSdef(poses, bones, t.boneIndices + v * 4, t.boneWeights + v * 4,
+                          t.sdefC + v * 3, t.sdefR0 + v * 3, t.sdefR1 + v * 3, p, n, position, normal);
+        } else {
+            ReferenceLinear(bones, t.boneIndices + v * 4, t.boneWeights + v * 4, p, n,
+                            position, normal);
+        }
+        for (int i = 0; i < 3; ++i) {
+            worst = std::max(worst, std::fabs(out[v].position[i] - position[i]));
+            worst = std::max(worst, std::fabs(out[v].normal[i] - normal[i]));
+        }
+    }
+    return worst;
+}
+
+} // anonymous namespace
+
+// ===================================================================
+// Reference
+// ===================================================================
+
+DMME_TEST(MatchesDoubleReference) {
+    const MixedMesh mesh;
+    Skinner skinner;
+    DMME_CHECK(skinner.Init(mesh.Table(), kBones));
+    DMME_CHECK(skinner.GetSdefCount() == kVertices / 4);
+
+    const std::vector<Pose> poses = PosedSkeleton();
+    SkinningPalette palette;
+    Apply(poses, palette);
+
+    std::vector<SkinnedVertex> out(kVertices);
+    skinner.Skin(palette, out.data());
+    DMME_CHECK(ReferenceError(mesh.Table(), poses, out) < 2e-5);
+
+    // Chunks on the job system write the same vertices
+    jobs::JobSystem jobs(2);
+    std::vector<SkinnedVertex> threaded(kVertices);
+    skinner.Skin(palette, threaded.data(), &jobs);
+    DMME_CHECK(std::memcmp(threaded.data(), out.data(), kVertices * sizeof(SkinnedVertex)) == 0);
+}
+
+// A skeleton moved without turning carries every vertex, SDEF
+// included, by the same offset with its normal unchanged
+DMME_TEST(PureTranslationIsRigid) {
+    const MixedMesh mesh;
+    Skinner skinner;
+    DMME_CHECK(skinner.Init(mesh.Table(), kBones));
+
+    constexpr float kOffset[3] = {0.25f, -1.5f, 0.75f};
+    std::vector<Pose> poses = PosedSkeleton();
+    for (Pose& pose : poses) {
+        pose.rotation[0] = pose.rotation[1] = pose.rotation[2] = 0.0f;
+        pose.rotation[3] = 1.0f;
+        for (int i = 0; i < 3; ++i) pose.position[i] = pose.rest[i] + kOffset[i];
+    }
+    SkinningPalette palette;
+    Apply(poses, palette);
+
+    std::vector<SkinnedVertex> out(kVertices);
+    skinner.Skin(palette, out.data());
+
+    const assets::PmxVertexTable& t = mesh.Table();
+    double worst = 0.0;
+    for (uint32_t v = 0; v < kVertices; ++v) {
+        double length = 0.0;
+        for (int i = 0; i < 3; ++i) length += static_cast<double>(t.normals[v * 3 + i]) * t.normals[v * 3 + i];
+        length = std::sqrt(length);
+        for (int i = 0; i < 3; ++i) {
+            worst = std::max(worst, std::fabs(out[v].position[i] - (static_cast<double>(t.positions[v * 3 + i]) + kOffset[i])));
+            worst = std::max(worst, std::fabs(out[v].normal[i] - t.normals[v * 3 + i] / length));
+        }
+    }
+    DMME_CHECK(worst < 1e-5);
+}
+
+DMME_TEST_MAIN()
\ No newline at end of file
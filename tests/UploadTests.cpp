@@ -0,0 +1,336 @@
+// Texture uploads: the upload queue's tiling, per-frame budget and
+// ring reuse against a recording submit callback, then the software
+// driver's CreateTexture / UpdateTexture path through RenderPipeline.
+
+#include "TestHarness.h"
+
+#include "core/renderer/BlockCompression.h"
+#include "core/renderer/RenderPipeline.h"
+#include "core/renderer/TextureUploadQueue.h"
+#include "core/renderer/drivers/OpenGLDriver.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+using namespace dmme;
+using namespace dmme::core::renderer;
+
+namespace {
+
+constexpr uint64_t kSlotBytes = static_cast<uint64_t>(kUploadSlotSize) * kUploadSlotSize * 4;
+
+// Records every chunk; refuses submissions while busy is set
+struct RecordingSink {
+    std::vector<UploadChunk> chunks;
+    bool busy = false;
+
+    static bool Submit(void* context, const UploadChunk& chunk) {
+        auto* self = static_cast<RecordingSink*>(context);
+        if (self->busy) {
+            return false;
+        }
+        self->chunks.push_back(chunk);
+        return true;
+    }
+};
+
+std::vector<uint8_t> MakePattern(int width, int height) {
+    std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+    for (size_t i = 0; i < pixels.size(); ++i) {
+        pixels[i] = static_cast<uint8_t>((i * 131) >> 3);
+    }
+    return pixels;
+}
+
+PixelRegion Rect(int x, int y, int width, int height) {
+    PixelRegion r;
+    r.x      = x;
+    r.y      = y;
+    r.width  = width;
+    r.height = height;
+    return r;
+}
+
+} // anonymous namespace
+
+// ===================================================================
+// Upload queue
+// ===================================================================
+
+// Tiles are at most one slot, cover the rect exactly once and point at
+// the matching source texels
+DMME_TEST(TilesCoverRectOnce) {
+    const int width = 1300, height = 700;
+    const std::vector<uint8_t> src = MakePattern(width, height);
+    const int stride = width * 4;
+
+    TextureUploadQueue queue;
+    RecordingSink sink;
+    const UploadTicket ticket = queue.Enqueue(1, TextureFormat::RGBA8_UNORM,
+                                              Rect(40, 24, width, height), src.data(), stride);
+    DMME_CHECK(ticket != kInvalidUploadTicket);
+    DMME_CHECK(queue.GetStats().pendingBytes == static_cast<uint64_t>(width) * height * 4);
+
+    for (uint64_t frame = 1; frame <= 4; ++frame) {
+        queue.Pump(frame, &RecordingSink::Submit, &sink);
+    }
+
+    std::vector<uint8_t> covered(static_cast<size_t>(width) * height, 0);
+    for (const UploadChunk& c : sink.chunks) {
+        DMME_CHECK(c.rect.width <= kUploadSlotSize && c.rect.height <= kUploadSlotSize);
+        DMME_CHECK(c.strideBytes == stride);
+        const int lx = c.rect.x - 40, ly = c.rect.y - 24;
+        DMME_CHECK(c.pixels == src.data() + static_cast<size_t>(ly) * stride +
+                               static_cast<size_t>(lx) * 4);
+        for (int y = ly; y < ly + c.rect.height; ++y) {
+            for (int x = lx; x < lx + c.rect.width; ++x) {
+                ++covered[static_cast<size_t>(y) * width + x];
+            }
+        }
+    }
+    DMME_CHECK(sink.chunks.size() == 6);   // 3 columns x 2 bands
+    DMME_CHECK(std::all_of(covered.begin(), covered.end(), [](uint8_t n) { return n == 1; }));
+    DMME_CHECK(queue.GetStats().pendingBytes == 0);
+    DMME_CHECK(queue.GetStats().totalBytes == static_cast<uint64_t>(width) * height * 4);
+}
+
+// A 16 MiB page under a 4 MiB budget goes up four slots per frame
+DMME_TEST(BudgetSpreadsLargeUpload) {
+    const int size = 2048;
+    const std::vector<uint8_t> src = MakePattern(size, size);
+
+    TextureUploadQueue queue;
+    queue.SetBudget(4 * kSlotBytes);
+    RecordingSink sink;
+    const UploadTicket ticket = queue.Enqueue(1, TextureFormat::RGBA8_UNORM,
+                                              Rect(0, 0, size, size), src.data(), size * 4);
+
+    uint64_t frame = 0;
+    while (queue.GetStats().pendingBytes > 0 && frame < 100) {
+        queue.Pump(++frame, &RecordingSink::Submit, &sink);
+        const UploadStats stats = queue.GetStats();
+        DMME_CHECK(stats.frameBytes <= stats.budgetBytes);
+        DMME_CHECK(stats.frameBytes == 4 * kSlotBytes);
+        DMME_CHECK(!queue.IsComplete(ticket));
+    }
+    DMME_CHECK(frame == 4);
+    DMME_CHECK(sink.chunks.size() == 16);
+    DMME_CHECK(queue.GetStats().ringStalls == 0);
+
+    // Complete once the last tile's slot retires
+    queue.Pump(++frame, &RecordingSink::Submit, &sink);
+    DMME_CHECK(!queue.IsComplete(ticket));
+    queue.Pump(++frame, &RecordingSink::Submit, &sink);
+    DMME_CHECK(queue.IsComplete(ticket));
+    DMME_CHECK(queue.GetStats().completedUploads == 1);
+    DMME_CHECK(queue.GetStats().frameBytes == 0);
+}
+
+// A budget below one tile still moves one tile per frame
+DMME_TEST(TinyBudgetStillProgresses) {
+    const std::vector<uint8_t> src = MakePattern(1024, 512);
+    TextureUploadQueue queue;
+    queue.SetBudget(1024);
+    RecordingSink sink;
+    queue.Enqueue(1, TextureFormat::RGBA8_UNORM, Rect(0, 0, 1024, 512), src.data(), 1024 * 4);
+
+    queue.Pump(1, &RecordingSink::Submit, &sink);
+    DMME_CHECK(sink.chunks.size() == 1);
+    queue.Pump(2, &RecordingSink::Submit, &sink);
+    DMME_CHECK(sink.chunks.size() == 2);
+    DMME_CHECK(queue.GetStats().pendingBytes == 0);
+}
+
+// Unbudgeted, the ring is the limit: eight slots, each reused only
+// kUploadFramesInFlight frames after it was filled
+DMME_TEST(RingLimitsSlotsInFlight) {
+    const int size = 2048;   // 16 tiles
+    const std::vector<uint8_t> src = MakePattern(size, size);
+    TextureUploadQueue queue;
+    queue.SetBudget(0);
+    RecordingSink sink;
+    const UploadTicket ticket = queue.Enqueue(1, TextureFormat::RGBA8_UNORM,
+                                              Rect(0, 0, size, size), src.data(), size * 4);
+
+    queue.Pump(1, &RecordingSink::Submit, &sink);
+    DMME_CHECK(sink.chunks.size() == kUploadRingSlots);
+    DMME_CHECK(queue.GetStats().slotsInFlight == kUploadRingSlots);
+    DMME_CHECK(queue.GetStats().ringStalls == 1);
+    for (uint32_t i = 0; i < kUploadRingSlots; ++i) {
+        DMME_CHECK(sink.chunks[i].slot == i);
+    }
+
+    // Frame 2: every slot is still in flight
+    queue.Pump(2, &RecordingSink::Submit, &sink);
+    DMME_CHECK(sink.chunks.size() == kUploadRingSlots);
+    DMME_CHECK(queue.GetStats().frameBytes == 0);
+    DMME_CHECK(queue.GetStats().ringStalls == 2);
+
+    // Frame 3: the ring is reused from the start
+    queue.Pump(3, &RecordingSink::Submit, &sink);
+    DMME_CHECK(sink.chunks.size() == 2 * kUploadRingSlots);
+    DMME_CHECK(sink.chunks[kUploadRingSlots].slot == 0);
+    DMME_CHECK(queue.GetStats().pendingBytes == 0);
+
+    queue.Pump(5, &RecordingSink::Submit, &sink);
+    DMME_CHECK(queue.IsComplete(ticket));
+    DMME_CHECK(queue.GetStats().slotsInFlight == 0);
+}
+
+// A refused submit is retried with the same tile next frame
+DMME_TEST(RefusedSubmitRetries) {
+    const std::vector<uint8_t> src = MakePattern(512, 512);
+    TextureUploadQueue queue;
+    RecordingSink sink;
+    sink.busy = true;
+    const UploadTicket ticket = queue.Enqueue(3, TextureFormat::RGBA8_UNORM,
+                                              Rect(0, 0, 512, 512), src.data(), 512 * 4);
+
+    queue.Pump(1, &RecordingSink::Submit, &sink);
+    DMME_CHECK(sink.chunks.empty());
+    DMME_CHECK(queue.GetStats().ringStalls == 1);
+    DMME_CHECK(queue.GetStats().pendingBytes == kSlotBytes);
+
+    sink.busy = false;
+    queue.Pump(2, &RecordingSink::Submit, &sink);
+    DMME_CHECK(sink.chunks.size() == 1);
+    DMME_CHECK(sink.chunks[0].texture == 3 && sink.chunks[0].slot == 0);
+    queue.Pump(4, &RecordingSink::Submit, &sink);
+    DMME_CHECK(queue.IsComplete(ticket));
+}
+
+// Cancel drops what is left of a half-submitted update
+DMME_TEST(CancelDropsPendingBytes) {
+    const int size = 2048;
+    const std::vector<uint8_t> src = MakePattern(size, size);
+    TextureUploadQueue queue;
+    queue.SetBudget(3 * kSlotBytes);   // stops mid-band
+    RecordingSink sink;
+    const UploadTicket kept    = queue.Enqueue(1, TextureFormat::RGBA8_UNORM,
+                                               Rect(0, 0, 512, 512), src.data(), size * 4);
+    const UploadTicket dropped = queue.Enqueue(2, TextureFormat::RGBA8_UNORM,
+                                               Rect(0, 0, size, size), src.data(), size * 4);
+
+    queue.Pump(1, &RecordingSink::Submit, &sink);
+    DMME_CHECK(sink.chunks.size() == 3);
+    DMME_CHECK(queue.GetStats().pendingBytes == 14 * kSlotBytes);
+
+    queue.Cancel(2);
+    DMME_CHECK(queue.GetStats().pendingBytes == 0);
+    DMME_CHECK(queue.GetStats().pendingUploads == 0);
+    DMME_CHECK(queue.IsComplete(dropped));
+
+    queue.Pump(3, &RecordingSink::Submit, &sink);
+    DMME_CHECK(sink.chunks.size() == 3);
+    DMME_CHECK(queue.IsComplete(kept));
+}
+
+// BC tiles start on block boundaries of the block rows
+DMME_TEST(BlockCompressedTilesAddressBlocks) {
+    const int size = 1024;
+    const int blockStride = (size / kBlockSize) * 16;
+    std::vector<uint8_t> blocks(static_cast<size_t>(blockStride) * (size / kBlockSize));
+    TextureUploadQueue queue;
+    queue.SetBudget(0);
+    RecordingSink sink;
+    queue.Enqueue(1, TextureFormat::BC7_UNORM, Rect(0, 0, size, size), blocks.data(), blockStride);
+    DMME_CHECK(queue.GetStats().pendingBytes == blocks.size());
+
+    queue.Pump(1, &RecordingSink::Submit, &sink);
+    DMME_CHECK(sink.chunks.size() == 4);
+    for (const UploadChunk& c : sink.chunks) {
+        DMME_CHECK(c.pixels == blocks.data() +
+                               static_cast<size_t>(c.rect.y / kBlockSize) * blockStride +
+                               static_cast<size_t>(c.rect.x / kBlockSize) * 16);
+    }
+    DMME_CHECK(queue.GetStats().totalBytes == blocks.size());
+}
+
+DMME_TEST(RejectsInvalidUpdates) {
+    const std::vector<uint8_t> src = MakePattern(16, 16);
+    TextureUploadQueue queue;
+    DMME_CHECK(queue.Enqueue(kInvalidTexture, TextureFormat::RGBA8_UNORM, Rect(0, 0, 16, 16),
+                             src.data(), 64) == kInvalidUploadTicket);
+    DMME_CHECK(queue.Enqueue(1, TextureFormat::RGBA8_UNORM, Rect(0, 0, 16, 16),
+                             nullptr, 64) == kInvalidUploadTicket);
+    DMME_CHECK(queue.Enqueue(1, TextureFormat::RGBA8_UNORM, Rect(0, 0, 16, 16),
+                             src.data(), 32) == kInvalidUploadTicket);
+    DMME_CHECK(!queue.IsComplete(kInvalidUploadTicket));
+    DMME_CHECK(!queue.IsComplete(42));
+}
+
+// ===================================================================
+// Software driver
+// ===================================================================
+
+// An atlas page uploaded through the pipeline lands intact, spread
+// over frames within the budget
+DMME_TEST(DriverUploadLandsWithinBudget) {
+    RenderConfig config;
+    config.preferredAPI      = GraphicsAPI::OpenGL;
+    config.targetWidth       = 64;
+    config.targetHeight      = 64;
+    config.uploadBudgetBytes = 2 * kSlotBytes;
+    RenderPipeline pipeline;
+    DMME_CHECK(pipeline.Initialize(nullptr, config));
+    DMME_CHECK(pipeline.GetActiveAPI() == GraphicsAPI::OpenGL);
+    auto* driver = static_cast<OpenGLDriver*>(pipeline.GetDriver());
+
+    TextureDesc desc;
+    desc.width  = 1536;
+    desc.height = 1024;
+    const TextureHandle texture = driver->CreateTexture(desc);
+    DMME_CHECK(texture != kInvalidTexture);
+
+    const std::vector<uint8_t> page = MakePattern(desc.width, desc.height);
+    const UploadTicket ticket = driver->UpdateTexture(texture, Rect(0, 0, desc.width, desc.height),
+                                                      page.data(), desc.width * 4);
+    DMME_CHECK(ticket != kInvalidUploadTicket);
+
+    // Outside the texture, or a bad texture: rejected
+    DMME_CHECK(driver->UpdateTexture(texture, Rect(1024, 0, 1024, 16), page.data(),
+                                     desc.width * 4) == kInvalidUploadTicket);
+    DMME_CHECK(driver->UpdateTexture(texture + 7, Rect(0, 0, 16, 16), page.data(),
+                                     desc.width * 4) == kInvalidUploadTicket);
+
+    int frames = 0;
+    uint64_t uploaded = 0;
+    while (!driver->IsUploadComplete(ticket) && frames < 50) {
+        DMME_CHECK(pipeline.BeginFrame());
+        DMME_CHECK(pipeline.EndFrame());
+        const FrameStats stats = pipeline.GetFrameStats();
+        DMME_CHECK(stats.uploadBytes <= config.uploadBudgetBytes);
+        uploaded += stats.uploadBytes;
+        ++frames;
+    }
+    // Six tiles, two per frame, then two frames until the ring retires
+    DMME_CHECK(frames == 5);
+    DMME_CHECK(uploaded == page.size());
+    DMME_CHECK(std::memcmp(driver->GetTexturePixels(texture), page.data(), page.size()) == 0);
+
+    // A sub-rect update touches only its texels
+    const std::vector<uint8_t> patch(static_cast<size_t>(32) * 8 * 4, 0xEE);
+    const UploadTicket patchTicket = driver->UpdateTexture(texture, Rect(100, 200, 32, 8),
+                                                           patch.data(), 32 * 4);
+    while (!driver->IsUploadComplete(patchTicket) && frames < 60) {
+        DMME_CHECK(pipeline.BeginFrame());
+        DMME_CHECK(pipeline.EndFrame());
+        ++frames;
+    }
+    const uint8_t* texels = driver->GetTexturePixels(texture);
+    const size_t pitch = static_cast<size_t>(desc.width) * 4;
+    DMME_CHECK(texels[200 * pitch + 100 * 4] == 0xEE);
+    DMME_CHECK(texels[207 * pitch + 131 * 4 + 3] == 0xEE);
+    DMME_CHECK(texels[199 * pitch + 100 * 4] == page[199 * pitch + 100 * 4]);
+    DMME_CHECK(texels[200 * pitch + 132 * 4] == page[200 * pitch + 132 * 4]);
+
+    // Destroying a texture drops its queued upload
+    const UploadTicket orphan = driver->UpdateTexture(texture, Rect(0, 0, desc.width, desc.height),
+                                                      page.data(), desc.width * 4);
+    driver->DestroyTexture(texture);
+    DMME_CHECK(driver->IsUploadComplete(orphan));
+    DMME_CHECK(driver->GetUploadStats().pendingBytes == 0);
+}
+
+DMME_TEST_MAIN()
\ No newline at end of file
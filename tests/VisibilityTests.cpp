@@ -0,0 +1,173 @@
+// VisibilityMonitor state machine driven by a
+// ScriptedVisibilitySignalSource on a synthetic clock: the
+// Visible / Heartbeat / Suspended transitions, the hide debounce,
+// heartbeat gating and the single resume frame.
+
+#include "TestHarness.h"
+
+#include "core/runtime/VisibilityMonitor.h"
+
+#include <memory>
+
+using namespace dmme;
+using namespace dmme::core::runtime;
+
+namespace {
+
+// The monitor treats zero timestamps as "unset"; start the clock later
+constexpr uint64_t kStartUs = 1'000'000;
+constexpr uint64_t kPollMs  = 100;
+
+uint64_t AtMs(uint64_t ms) {
+    return kStartUs + ms * 1000;
+}
+
+VisibilitySignals Shown() {
+    return VisibilitySignals();
+}
+
+VisibilitySignals Fullscreen() {
+    VisibilitySignals s;
+    s.fullscreenApp = true;
+    return s;
+}
+
+VisibilitySignals Locked() {
+    VisibilitySignals s;
+    s.sessionLocked = true;
+    return s;
+}
+
+// One signal step per (ms, signals) pair
+std::unique_ptr<IVisibilitySignalSource> Script(
+    std::initializer_list<std::pair<uint64_t, VisibilitySignals>> steps) {
+    auto source = std::make_unique<ScriptedVisibilitySignalSource>();
+    for (const auto& step : steps) {
+        source->AddStep(step.first * 1000, step.second);
+    }
+    return source;
+}
+
+// Update once per poll interval over [from, to]; returns the first
+// time (ms) the state changed, or UINT64_MAX
+uint64_t FirstChange(VisibilityMonitor& monitor, uint64_t fromMs, uint64_t toMs) {
+    for (uint64_t ms = fromMs; ms <= toMs; ms += kPollMs) {
+        if (monitor.Update(AtMs(ms))) {
+            return ms;
+        }
+    }
+    return UINT64_MAX;
+}
+
+} // anonymous namespace
+
+// ===================================================================
+// Transitions and debounce
+// ===================================================================
+
+DMME_TEST(StartsVisible) {
+    VisibilityMonitor monitor(Script({{0, Shown()}}));
+    DMME_CHECK(!monitor.Update(AtMs(0)));
+    DMME_CHECK(monitor.IsVisible());
+    DMME_CHECK(!monitor.IsResumeFramePending());
+    DMME_CHECK(monitor.ShouldRenderFrame(AtMs(0)));
+    DMME_CHECK(monitor.GetLoopFps(60.0f) == 60.0f);
+}
+
+DMME_TEST(FullscreenEntersHeartbeatAfterDebounce) {
+    VisibilityMonitor monitor(Script({{0, Shown()}, {1000, Fullscreen()}}));
+    DMME_CHECK(FirstChange(monitor, 0, 3000) == 1500);
+    DMME_CHECK(monitor.GetState() == VisibilityState::Heartbeat);
+    DMME_CHECK(monitor.GetLoopFps(60.0f) == 10.0f);
+}
+
+// Alt-tabbing through a fullscreen window must not stop rendering
+DMME_TEST(ShortCoverIsDebounced) {
+    VisibilityMonitor monitor(Script({
+        {0, Shown()}, {1000, Fullscreen()}, {1400, Shown()}, {1600, Fullscreen()}}));
+    DMME_CHECK(FirstChange(monitor, 0, 2000) == UINT64_MAX);
+    DMME_CHECK(monitor.IsVisible());
+
+    // The second cover restarted the debounce at 1.6 s
+    DMME_CHECK(FirstChange(monitor, 2100, 3000) == 2100);
+    DMME_CHECK(monitor.GetState() == VisibilityState::Heartbeat);
+}
+
+DMME_TEST(LockSuspendsFromHeartbeat) {
+    VisibilityMonitor monitor(Script({{0, Fullscreen()}, {2000, Locked()}}));
+    DMME_CHECK(FirstChange(monitor, 0, 1900) == 500);
+    DMME_CHECK(monitor.GetState() == VisibilityState::Heartbeat);
+
+    // Deeper hiding is debounced too
+    DMME_CHECK(FirstChange(monitor, 2000, 4000) == 2500);
+    DMME_CHECK(monitor.GetState() == VisibilityState::Suspended);
+    DMME_CHECK(monitor.GetLoopFps(60.0f) == 10.0f);
+
+    const uint64_t skippedBefore = monitor.GetSuspendedFrameCount();
+    DMME_CHECK(!monitor.ShouldRenderFrame(AtMs(2600)));
+    DMME_CHECK(!monitor.ShouldRenderFrame(AtMs(9000)));
+    DMME_CHECK(monitor.GetSuspendedFrameCount() == skippedBefore + 2);
+}
+
+DMME_TEST(ZeroHeartbeatSuspends) {
+    VisibilityMonitorConfig config;
+    config.heartbeatFps = 0.0f;
+    VisibilityMonitor monitor(Script({{0, Fullscreen()}}), config);
+    DMME_CHECK(FirstChange(monitor, 0, 1000) == 500);
+    DMME_CHECK(monitor.GetState() == VisibilityState::Suspended);
+}
+
+// ===================================================================
+// Frame gating
+// ===================================================================
+
+DMME_TEST(HeartbeatRendersAtHeartbeatRate) {
+    VisibilityMonitor monitor(Script({{0, Fullscreen()}}));
+    DMME_CHECK(FirstChange(monitor, 0, 1000) == 500);
+
+    // The first heartbeat goes out at once, then one per second
+    DMME_CHECK(monitor.ShouldRenderFrame(AtMs(500)));
+    monitor.NotifyFrameRendered(AtMs(500));
+    DMME_CHECK(!monitor.ShouldRenderFrame(AtMs(600)));
+    DMME_CHECK(!monitor.ShouldRenderFrame(AtMs(1400)));
+    DMME_CHECK(monitor.ShouldRenderFrame(AtMs(1500)));
+    DMME_CHECK(monitor.GetSuspendedFrameCount() == 2);
+    DMME_CHECK(!monitor.IsResumeFramePending());
+}
+
+// ===================================================================
+// Resume
+// ===================================================================
+
+DMME_TEST(ResumeIsImmediateWithOneFrame) {
+    VisibilityMonitor monitor(Script({{0, Locked()}, {3000, Shown()}}));
+    DMME_CHECK(FirstChange(monitor, 0, 2900) == 500);
+    DMME_CHECK(monitor.GetState() == VisibilityState::Suspended);
+    DMME_CHECK(!monitor.IsResumeFramePending());
+
+    // Not debounced: visible on the first poll after the unlock
+    DMME_CHECK(FirstChange(monitor, 3000, 4000) == 3000);
+    DMME_CHECK(monitor.IsVisible());
+    DMME_CHECK(monitor.IsResumeFramePending());
+    DMME_CHECK(monitor.ShouldRenderFrame(AtMs(3000)));
+
+    // Pending until that frame is presented
+    DMME_CHECK(!monitor.Update(AtMs(3100)));
+    DMME_CHECK(monitor.IsResumeFramePending());
+    monitor.NotifyFrameRendered(AtMs(3010));
+    DMME_CHECK(!monitor.IsResumeFramePending());
+}
+
+// Unlocking straight into a fullscreen app is an upgrade to Heartbeat,
+// not a resume
+DMME_TEST(UnlockIntoFullscreenHeartbeats) {
+    VisibilityMonitor monitor(Script({{0, Locked()}, {2000, Fullscreen()}}));
+    DMME_CHECK(FirstChange(monitor, 0, 1900) == 500);
+
+    DMME_CHECK(FirstChange(monitor, 2000, 3000) == 2000);
+    DMME_CHECK(monitor.GetState() == VisibilityState::Heartbeat);
+    DMME_CHECK(!monitor.IsResumeFramePending());
+    DMME_CHECK(monitor.ShouldRenderFrame(AtMs(2000)));
+}
+
+DMME_TEST_MAIN()
\ No newline at end of file
@@ -0,0 +1,222 @@
+// Golden-image regression tests.
+//
+// Scripted frames go through RenderPipeline on the software driver,
+// are converted into a headless window back buffer (the bytes
+// UpdateLayeredWindow would receive) and compared against the TGA
+// references in references/. On failure the actual image and a diff
+// image are written next to the reference.
+//
+// DMME_GOLDEN_UPDATE=1 rewrites the references instead of comparing;
+// review the new images before committing them.
+
+#include "TestHarness.h"
+#include "HeadlessPresenter.h"
+
+#include "core/jobs/JobSystem.h"
+#include "core/renderer/GoldenImage.h"
+#include "core/renderer/ProceduralFace.h"
+#include "core/renderer/RenderPipeline.h"
+#include "core/renderer/drivers/OpenGLDriver.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace dmme;
+using namespace dmme::core::renderer;
+
+namespace {
+
+constexpr int kWindowSize = 96;
+
+// The face is shaded in float; other compilers may round a channel
+// differently by one
+constexpr int kTolerance = 1;
+
+GoldenMode GetGoldenMode() {
+    const char* update = std::getenv("DMME_GOLDEN_UPDATE");
+    return (update && update[0] != '0') ? GoldenMode::Update : GoldenMode::Compare;
+}
+
+void CheckGoldenFrame(const test::HeadlessPresenter& window, const char* name) {
+    const std::string path = std::string(DMME_GOLDEN_DIR) + "/" + name + ".tga";
+    const GoldenResult result = CheckGolden(window.GetBackBuffer(), path, kTolerance, 0,
+                                            GetGoldenMode());
+    if (!result.passed) {
+        std::fprintf(stderr, "golden %s: %s, %llu pixels off (max delta %d)\n", name,
+                     result.missing ? "reference missing" : "mismatch",
+                     static_cast<unsigned long long>(result.diff.mismatchedPixels),
+                     result.diff.maxChannelDelta);
+    }
+    DMME_CHECK(result.passed);
+}
+
+// One window's worth of pipeline, CPU face and back buffer
+class GoldenScene {
+public:
+    explicit GoldenScene(float renderScale = 1.0f, ClearColor clearColor = {})
+        : m_face(&m_jobs)
+        , m_window(kWindowSize, kWindowSize) {
+        RenderConfig config;
+        config.preferredAPI = GraphicsAPI::OpenGL;
+        config.targetWidth  = kWindowSize;
+        config.targetHeight = kWindowSize;
+        config.renderScale  = renderScale;
+        config.clearColor   = clearColor;
+        m_ready = m_pipeline.Initialize(nullptr, config) &&
+                  m_pipeline.GetActiveAPI() == GraphicsAPI::OpenGL;
+    }
+
+    bool IsReady() const { return m_ready; }
+
+    // Render, read back and present one frame. Region readback reads
+    // the face bounds plus last frame's, as the main loop does.
+    bool Frame(float elapsed, bool drawFace, bool regionReadback = false) {
+        if (!m_pipeline.BeginFrame()) {
+            return false;
+        }
+        OpenGLDriver* driver = GetDriver();
+        const int width  = driver->GetTargetWidth();
+        const int height = driver->GetTargetHeight();
+        if (drawFace) {
+            m_face.Draw(driver->GetTargetPixels(), width, height, width * 4, elapsed);
+        }
+        if (!m_pipeline.EndFrame()) {
+            return false;
+        }
+
+        const PixelReadback* pixels = nullptr;
+        if (regionReadback) {
+            const PixelRegion bounds = ProceduralFaceRasterizer::ComputeBounds(width, height, elapsed);
+            const PixelRegion region = UnionRegion(bounds, m_lastBounds);
+            m_lastBounds = bounds;
+            pixels = m_pipeline.ReadbackFrame(&region, 1);
+        } else {
+            pixels = m_pipeline.ReadbackFrame();
+        }
+        return pixels && m_window.Present(*pixels);
+    }
+
+    OpenGLDriver* GetDriver() const {
+        return static_cast<OpenGLDriver*>(m_pipeline.GetDriver());
+    }
+
+    RenderPipeline&          GetPipeline() { return m_pipeline; }
+    test::HeadlessPresenter& GetWindow()   { return m_window; }
+
+private:
+    core::jobs::JobSystem    m_jobs;
+    RenderPipeline           m_pipeline;
+    ProceduralFaceRasterizer m_face;
+    test::HeadlessPresenter  m_window;
+    PixelRegion              m_lastBounds;
+    bool                     m_ready = false;
+};
+
+} // anonymous namespace
+
+// ===================================================================
+// Conversion
+// ===================================================================
+
+// A translucent clear colour must be premultiplied exactly once
+DMME_TEST(ClearColorPremultipliedOnce) {
+    GoldenScene scene(1.0f, {0.8f, 0.4f, 0.2f, 0.5f});
+    DMME_CHECK(scene.IsReady());
+    DMME_CHECK(scene.Frame(0.0f, false));
+
+    // RGBA (204, 102, 51, 128) -> BGRA premultiplied (26, 51, 102, 128)
+    const uint8_t* px = scene.GetWindow().GetBackBuffer().pixels;
+    DMME_CHECK(px[0] == 26 && px[1] == 51 && px[2] == 102 && px[3] == 128);
+    CheckGoldenFrame(scene.GetWindow(), "clear_half_alpha");
+}
+
+// Every alpha and colour combination along two ramps, written straight
+// into the software target
+DMME_TEST(AlphaRamp) {
+    GoldenScene scene;
+    DMME_CHECK(scene.IsReady());
+    DMME_CHECK(scene.GetPipeline().BeginFrame());
+
+    OpenGLDriver* driver = scene.GetDriver();
+    uint8_t* target = driver->GetTargetPixels();
+    const int size = driver->GetTargetWidth();
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            uint8_t* px = target + (static_cast<size_t>(y) * size + x) * 4;
+            px[0] = static_cast<uint8_t>(x * 255 / (size - 1));
+            px[1] = static_cast<uint8_t>(y * 255 / (size - 1));
+            px[2] = static_cast<uint8_t>(255 - px[0]);
+            px[3] = static_cast<uint8_t>((x + y) * 255 / (2 * (size - 1)));
+        }
+    }
+
+    DMME_CHECK(scene.GetPipeline().EndFrame());
+    const PixelReadback* pixels = scene.GetPipeline().ReadbackFrame();
+    DMME_CHECK(pixels && scene.GetWindow().Present(*pixels));
+    CheckGoldenFrame(scene.GetWindow(), "alpha_ramp");
+}
+
+// ===================================================================
+// Procedural face (software driver)
+// ===================================================================
+
+DMME_TEST(FaceFrames) {
+    GoldenScene scene;
+    DMME_CHECK(scene.IsReady());
+
+    DMME_CHECK(scene.Frame(0.0f, true));
+    CheckGoldenFrame(scene.GetWindow(), "face_t0000");
+
+    for (int frame = 1; frame <= 30; ++frame) {
+        DMME_CHECK(scene.Frame(frame / 30.0f, true));
+    }
+    CheckGoldenFrame(scene.GetWindow(), "face_t1000");
+}
+
+// Region readback must present the same bytes as full readback
+DMME_TEST(FaceRegionReadback) {
+    GoldenScene scene;
+    DMME_CHECK(scene.IsReady());
+
+    for (int frame = 0; frame <= 30; ++frame) {
+        DMME_CHECK(scene.Frame(frame / 30.0f, true, true));
+    }
+    const FrameStats stats = scene.GetPipeline().GetFrameStats();
+    DMME_CHECK(stats.readbackBytes < static_cast<uint64_t>(kWindowSize) * kWindowSize * 4);
+    CheckGoldenFrame(scene.GetWindow(), "face_t1000");
+}
+
+// The SIMD, tiled face against the straight port of the shader
+DMME_TEST(FaceMatchesReference) {
+    core::jobs::JobSystem    jobs;
+    ProceduralFaceRasterizer face(&jobs);
+    std::vector<uint8_t> fast(static_cast<size_t>(kWindowSize) * kWindowSize * 4, 0);
+    std::vector<uint8_t> reference(fast.size(), 0);
+
+    for (float elapsed : {0.0f, 0.4f, 1.0f, 2.7f}) {
+        std::fill(fast.begin(), fast.end(), 0);
+        std::fill(reference.begin(), reference.end(), 0);
+        face.Draw(fast.data(), kWindowSize, kWindowSize, kWindowSize * 4, elapsed);
+        ProceduralFaceRasterizer::DrawReference(reference.data(), kWindowSize, kWindowSize,
+                                                kWindowSize * 4, elapsed);
+        const ImageDiff diff = CompareImages({fast.data(), kWindowSize, kWindowSize},
+                                             {reference.data(), kWindowSize, kWindowSize},
+                                             kTolerance);
+        DMME_CHECK(diff.mismatchedPixels == 0);
+    }
+}
+
+// Half-resolution surface, upscaled into the back buffer
+DMME_TEST(FaceHalfScale) {
+    GoldenScene scene(0.5f);
+    DMME_CHECK(scene.IsReady());
+    DMME_CHECK(scene.GetDriver()->GetTargetWidth() == kWindowSize / 2);
+
+    DMME_CHECK(scene.Frame(1.0f, true));
+    CheckGoldenFrame(scene.GetWindow(), "face_half_scale");
+}
+
+DMME_TEST_MAIN()
\ No newline at end of file
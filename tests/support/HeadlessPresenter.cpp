@@ -0,0 +1,60 @@
+#include "HeadlessPresenter.h"
+#include "core/window/PixelConvert.h"
+#include "core/window/PixelFormat.h"
+#include "utils/Clock.h"
+
+#include <utility>
+
+namespace dmme {
+namespace test {
+
+using namespace core;
+
+HeadlessPresenter::HeadlessPresenter(int width, int height)
+    : m_width(width)
+    , m_height(height)
+    , m_backBuffer(static_cast<size_t>(width) * height * 4, 0) {}
+
+bool HeadlessPresenter::Present(const renderer::PixelReadback& frame) {
+    if (!frame.IsValid()) {
+        return false;
+    }
+
+    if (frame.width == m_width && frame.height == m_height) {
+        window::ConvertPixels(window::PixelFormat::RGBA8_UNORM, frame.data.data(), 0,
+                              window::PixelFormat::BGRA8_UNORM_PREMUL, m_backBuffer.data(), 0,
+                              m_width, m_height);
+    } else {
+        window::ConvertRGBAToBGRAPremulScaled(frame.data.data(), frame.width, frame.height,
+                                              frame.width * 4, m_backBuffer.data(),
+                                              m_width, m_height);
+    }
+    m_timing.convertDoneUs = utils::MonotonicMicros();
+
+    if (m_overlay) {
+        m_overlay(m_backBuffer.data(), m_width, m_height);
+    }
+
+    m_timing.presentDoneUs = utils::MonotonicMicros();
+    ++m_presents;
+    return true;
+}
+
+void HeadlessPresenter::SetFrameOverlayCallback(window::FrameOverlayCallback cb) {
+    m_overlay = std::move(cb);
+}
+
+renderer::ImageView HeadlessPresenter::GetBackBuffer() const {
+    return {m_backBuffer.data(), m_width, m_height, 0, renderer::PixelOrder::BGRA};
+}
+
+window::PresentTiming HeadlessPresenter::GetLastPresentTiming() const {
+    return m_timing;
+}
+
+uint64_t HeadlessPresenter::GetPresentCount() const {
+    return m_presents;
+}
+
+} // namespace test
+} // namespace dmme
\ No newline at end of file
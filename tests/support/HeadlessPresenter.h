@@ -0,0 +1,56 @@
+#pragma once
+
+#include "core/renderer/GoldenImage.h"
+#include "core/renderer/RenderTypes.h"
+#include "core/window/WindowTypes.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace dmme {
+namespace test {
+
+// HeadlessPresenter stands in for TransparentWindow in headless runs.
+//
+// Present() does what UpdateFrameScaled does up to the
+// UpdateLayeredWindow call: convert the readback (straight RGBA) into
+// a BGRA premultiplied back buffer of the window size, upscaling when
+// the surface is smaller, run the overlay callback, and stamp the same
+// PresentTiming. The back buffer is therefore the exact bytes a window
+// would have put on screen.
+//
+// Usage:
+//   HeadlessPresenter window(400, 400);
+//   window.Present(*pipeline.ReadbackFrame());
+//   CheckGolden(window.GetBackBuffer(), "frame.tga", 0);
+
+class HeadlessPresenter {
+public:
+    HeadlessPresenter(int width, int height);
+    ~HeadlessPresenter() = default;
+
+    HeadlessPresenter(const HeadlessPresenter&) = delete;
+    HeadlessPresenter& operator=(const HeadlessPresenter&) = delete;
+
+    // Convert and "present" a frame. false for an invalid readback.
+    bool Present(const core::renderer::PixelReadback& frame);
+
+    void SetFrameOverlayCallback(core::window::FrameOverlayCallback cb);
+
+    core::renderer::ImageView    GetBackBuffer() const;
+    core::window::PresentTiming  GetLastPresentTiming() const;
+    uint64_t                     GetPresentCount() const;
+    int GetWidth() const  { return m_width; }
+    int GetHeight() const { return m_height; }
+
+private:
+    int                                 m_width  = 0;
+    int                                 m_height = 0;
+    std::vector<uint8_t>                m_backBuffer;   // BGRA premultiplied
+    core::window::FrameOverlayCallback  m_overlay;
+    core::window::PresentTiming         m_timing;
+    uint64_t                            m_presents = 0;
+};
+
+} // namespace test
+} // namespace dmme
\ No newline at end of file
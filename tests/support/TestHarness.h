@@ -0,0 +1,103 @@
+#pragma once
+
+#include "utils/Logger.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace dmme {
+namespace test {
+
+// Minimal harness for the headless tests; no framework dependency.
+//
+// Cases register themselves with DMME_TEST and run in registration
+// order. DMME_CHECK records a failure and carries on, so one run
+// reports every broken expectation. `<exe> <case>` runs one case (the
+// golden suite is registered with CTest case by case so cases run in
+// parallel), `<exe> --list` prints the cases. The exit code is 0 only
+// if every check passed. Engine errors go to stderr.
+//
+// Usage:
+//   DMME_TEST(UploadsRespectBudget) {
+//       DMME_CHECK(stats.frameBytes <= stats.budgetBytes);
+//   }
+//   DMME_TEST_MAIN()
+
+using TestFn = void (*)();
+
+struct TestCase {
+    const char* name;
+    TestFn      fn;
+};
+
+inline std::vector<TestCase>& Registry() {
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+inline int& FailureCount() {
+    static int failures = 0;
+    return failures;
+}
+
+struct TestRegistrar {
+    TestRegistrar(const char* name, TestFn fn) {
+        Registry().push_back({name, fn});
+    }
+};
+
+inline bool Check(bool ok, const char* expr, const char* file, int line) {
+    if (!ok) {
+        ++FailureCount();
+        std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+    }
+    return ok;
+}
+
+inline int RunTests(int argc, char** argv) {
+    const char* only = argc > 1 ? argv[1] : nullptr;
+    if (only && std::strcmp(only, "--list") == 0) {
+        for (const TestCase& tc : Registry()) {
+            std::printf("%s\n", tc.name);
+        }
+        return 0;
+    }
+
+    auto& logger = utils::Logger::Get();
+    if (!logger) {
+        logger = spdlog::stderr_color_mt("dmme-test");
+        logger->set_level(spdlog::level::err);
+    }
+
+    int run = 0;
+    for (const TestCase& tc : Registry()) {
+        if (only && std::strcmp(only, tc.name) != 0) {
+            continue;
+        }
+        const int before = FailureCount();
+        tc.fn();
+        std::printf("[%s] %s\n", FailureCount() == before ? "  OK  " : " FAIL ", tc.name);
+        std::fflush(stdout);
+        ++run;
+    }
+
+    if (run == 0) {
+        std::fprintf(stderr, "no test case named '%s'\n", only ? only : "");
+        return 1;
+    }
+    return FailureCount() == 0 ? 0 : 1;
+}
+
+} // namespace test
+} // namespace dmme
+
+#define DMME_TEST(name)                                                     \
+    static void name();                                                     \
+    static const ::dmme::test::TestRegistrar name##Registrar(#name, &name); \
+    static void name()
+
+#define DMME_TEST_MAIN() \
+    int main(int argc, char** argv) { return ::dmme::test::RunTests(argc, argv); }
+
+#define DMME_CHECK(expr) ::dmme::test::Check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
\ No newline at end of file